@@ -19,18 +19,13 @@ const std::string ACP::CLASS_NAME("ACP");
 ACP::ACP()
 	:
 	m_cipherMode(new Cipher::Symmetric::Block::Mode::CTR(Helper::BlockCipherFromName::GetInstance(Enumeration::BlockCiphers::AHX, Enumeration::Digests::SHA512, 38))),
-	m_hasRdrand(false),
-	m_hasTsc(false),
 	m_isAvailable(true)
 {
-	Scope();
 	Reset();
 }
 
 ACP::~ACP()
 {
-	m_hasTsc = false;
-	m_hasRdrand = false;
 	m_isAvailable = false;
 
 	if (m_cipherMode != nullptr)
@@ -56,6 +51,19 @@ const std::string ACP::Name()
 	return CLASS_NAME;
 }
 
+EntropyPool &ACP::Pool()
+{
+	// one pool per process, refreshed in the background and shared by every instance
+	static EntropyPool pool([]()
+	{
+		Common::CpuDetect detect;
+
+		return Collect(detect.RDTSCP(), detect.RDRAND());
+	});
+
+	return pool;
+}
+
 //~~~Public Functions~~~//
 
 void ACP::GetBytes(std::vector<byte> &Output)
@@ -97,12 +105,12 @@ uint ACP::Next()
 
 void ACP::Reset()
 {
-	std::vector<byte> key;
+	std::vector<byte> key(KEY_SIZE);
 
 	try
 	{
-		// collect entropy, filter, and compress
-		key = Collect();
+		// extract the key from the background entropy pool
+		Pool().Extract(key);
 	}
 	catch (std::exception &ex)
 	{
@@ -124,44 +132,44 @@ void ACP::Reset()
 
 //~~~Private Functions~~~//
 
-std::vector<byte> ACP::Collect()
+std::vector<byte> ACP::Collect(bool HasTsc, bool HasRdrand)
 {
 	const size_t KBLK = 72;
 
 	std::vector<byte> state(0);
 	std::vector<byte> buffer(KBLK);
-	ulong ts = Utility::SysUtils::TimeStamp(m_hasTsc);
+	ulong ts = Utility::SysUtils::TimeStamp(HasTsc);
 	// add the first timestamp
 	Utility::ArrayUtils::Append(ts, state);
 
 	// add system state
 	Utility::ArrayUtils::Append(MemoryInfo(), state);
-	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(m_hasTsc) - ts, state);
+	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(HasTsc) - ts, state);
 	Utility::ArrayUtils::Append(ProcessInfo(), state);
-	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(m_hasTsc) - ts, state);
+	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(HasTsc) - ts, state);
 	Utility::ArrayUtils::Append(SystemInfo(), state);
-	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(m_hasTsc) - ts, state);
-	Utility::ArrayUtils::Append(TimeInfo(), state);
+	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(HasTsc) - ts, state);
+	Utility::ArrayUtils::Append(TimeInfo(HasTsc), state);
 	// filter zeroes
 	Filter(state);
 
 	// add rdrand
-	if (m_hasRdrand)
+	if (HasRdrand)
 	{
 		RDP rpv;
 		rpv.GetBytes(buffer);
 		Utility::ArrayUtils::Append(buffer, state);
-		Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(m_hasTsc) - ts, state);
+		Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(HasTsc) - ts, state);
 	}
 
 #if defined(CEX_ACP_JITTER)
 	// add jitter
-	if (m_hasTsc)
+	if (HasTsc)
 	{
 		CJP jpv;
 		jpv.GetBytes(buffer);
 		Utility::ArrayUtils::Append(buffer, state);
-		Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(m_hasTsc) - ts, state);
+		Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(HasTsc) - ts, state);
 	}
 #endif
 
@@ -320,13 +328,6 @@ std::vector<byte> ACP::ProcessInfo()
 	return state;
 }
 
-void ACP::Scope()
-{
-	Common::CpuDetect detect;
-	m_hasRdrand = detect.RDRAND();
-	m_hasTsc = detect.RDTSCP();
-}
-
 std::vector<byte> ACP::SystemInfo()
 {
 	std::vector<byte> state(0);
@@ -376,11 +377,11 @@ std::vector<byte> ACP::SystemInfo()
 	return state;
 }
 
-std::vector<byte> ACP::TimeInfo()
+std::vector<byte> ACP::TimeInfo(bool HasTsc)
 {
 	std::vector<byte> state(0);
 
-	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(m_hasTsc), state);
+	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(HasTsc), state);
 	Utility::ArrayUtils::Append(Utility::SysUtils::TimeCurrentNS(), state);
 	Utility::ArrayUtils::Append(Utility::SysUtils::TimeSinceBoot(), state);
 
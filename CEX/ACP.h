@@ -2,6 +2,7 @@
 #define CEX_ACP_H
 
 #include "IProvider.h"
+#include "EntropyPool.h"
 #include "ICipherMode.h"
 
 NAMESPACE_PROVIDER
@@ -27,6 +28,10 @@ NAMESPACE_PROVIDER
 /// The 16 byte counter and the HKDF distribution code (personalization string) are then created with the system entropy provider. \n
 /// Output from the ACP provider is the product of encrypting the incrementing counter.
 /// </para>
+///
+/// <para>The system state collection runs on a low-priority background thread that keeps a process-wide Keccak-512 entropy pool fresh (see EntropyPool). \n
+/// Constructing or resetting an ACP extracts its cipher key from the pool and does not wait on a collection; only the first extraction in a process collects on the calling thread. \n
+/// The pool health and refresh latency counters are available through the Pool() accessor.</para>
 /// 
 /// <description>Guiding Publications::</description>
 /// <list type="number">
@@ -43,10 +48,9 @@ private:
 
 	static const std::string CLASS_NAME;
 	static const size_t DEF_STATECAP = 1024;
+	static const size_t KEY_SIZE = 64;
 
 	std::unique_ptr<Cipher::Symmetric::Block::Mode::ICipherMode> m_cipherMode;
-	bool m_hasTsc;
-	bool m_hasRdrand;
 	bool m_isAvailable;
 
 public:
@@ -90,6 +94,11 @@ public:
 	/// </summary>
 	const std::string Name() override;
 
+	/// <summary>
+	/// Read Only: The background entropy pool shared by all ACP instances; exposes the pool health and refresh latency counters
+	/// </summary>
+	static EntropyPool &Pool();
+
 	//~~~Public Functions~~~//
 
 	/// <summary>
@@ -141,14 +150,13 @@ public:
 
 private:
 
-	std::vector<byte> Collect();
-	std::vector<byte> Compress(std::vector<byte> &State);
-	void Filter(std::vector<byte> &State);
-	std::vector<byte> MemoryInfo();
-	std::vector<byte> ProcessInfo();
-	void Scope();
-	std::vector<byte> SystemInfo();
-	std::vector<byte> TimeInfo();
+	static std::vector<byte> Collect(bool HasTsc, bool HasRdrand);
+	static std::vector<byte> Compress(std::vector<byte> &State);
+	static void Filter(std::vector<byte> &State);
+	static std::vector<byte> MemoryInfo();
+	static std::vector<byte> ProcessInfo();
+	static std::vector<byte> SystemInfo();
+	static std::vector<byte> TimeInfo(bool HasTsc);
 };
 
 NAMESPACE_PROVIDEREND
@@ -4,6 +4,7 @@
 #	include "HKDF.h"
 #	include "IntUtils.h"
 #	include "MemUtils.h"
+#	include "SymmetricKeyView.h"
 #	include "UInt128.h"
 #endif
 
@@ -194,26 +195,77 @@ void AHX::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 	Encrypt128(Input, InOffset, Output, OutOffset);
 }
 
+void AHX::ExportSchedule(std::vector<byte> &Schedule)
+{
+	if (!m_isInitialized)
+	{
+		throw CryptoSymmetricCipherException("AHX:ExportSchedule", "The cipher has not been initialized!");
+	}
+
+	// header: cipher type, direction, rounds, reserved, and the input key size in bits (m_cprKeySize is the key length * 8), little endian
+	Schedule.resize(SCHEDULE_HEADER + (m_expKey.size() * sizeof(__m128i)));
+	Schedule[0] = static_cast<byte>(Enumeral());
+	Schedule[1] = m_isEncryption ? 1 : 0;
+	Schedule[2] = static_cast<byte>(m_rndCount);
+	Schedule[3] = 0;
+	Utility::IntUtils::Le32ToBytes(static_cast<uint>(m_cprKeySize), Schedule, 4);
+
+	for (size_t i = 0; i < m_expKey.size(); ++i)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&Schedule[SCHEDULE_HEADER + (i * sizeof(__m128i))]), m_expKey[i]);
+	}
+}
+
+void AHX::ImportSchedule(const std::vector<byte> &Schedule)
+{
+	if (Schedule.size() < SCHEDULE_HEADER || Schedule[0] != static_cast<byte>(Enumeral()))
+	{
+		throw CryptoSymmetricCipherException("AHX:ImportSchedule", "The key schedule was not exported by this cipher type!");
+	}
+
+	const size_t RNDCNT = Schedule[2];
+	const size_t KEYLEN = Schedule.size() - SCHEDULE_HEADER;
+
+	if (Schedule[1] > 1 || Schedule[3] != 0 || RNDCNT < MIN_ROUNDS || RNDCNT > MAX_ROUNDS || KEYLEN != (RNDCNT + 1) * sizeof(__m128i))
+	{
+		throw CryptoSymmetricCipherException("AHX:ImportSchedule", "The key schedule is malformed!");
+	}
+
+	m_expKey.resize(RNDCNT + 1);
+
+	for (size_t i = 0; i < m_expKey.size(); ++i)
+	{
+		m_expKey[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Schedule[SCHEDULE_HEADER + (i * sizeof(__m128i))]));
+	}
+
+	m_isEncryption = (Schedule[1] == 1);
+	m_cprKeySize = Utility::IntUtils::LeBytesTo32(Schedule, 4);
+	m_rndCount = RNDCNT;
+	m_isInitialized = true;
+}
+
 void AHX::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(m_legalKeySizes, KeyParams.Key().size()))
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (!SymmetricKeySize::Contains(m_legalKeySizes, kv.Key().size()))
 	{
 		throw CryptoSymmetricCipherException("AHX:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 	}
-	if (m_kdfEngineType != Enumeration::Digests::None && KeyParams.Info().size() > m_kdfInfoMax)
+	if (m_kdfEngineType != Enumeration::Digests::None && kv.Info().size() > m_kdfInfoMax)
 	{
 		throw CryptoSymmetricCipherException("AHX:Initialize", "Invalid info size! Info parameter must be no longer than DistributionCodeMax size.");
 	}
 
-	if (KeyParams.Info().size() > 0)
+	if (kv.Info().size() > 0)
 	{
-		m_kdfInfo = KeyParams.Info();
+		m_kdfInfo = kv.Info();
 	}
 
 	m_isEncryption = Encryption;
-	m_cprKeySize = KeyParams.Key().size() * 8;
+	m_cprKeySize = kv.Key().size() * 8;
 	// expand the key
-	ExpandKey(Encryption, KeyParams.Key());
+	ExpandKey(Encryption, kv.Key());
 	// ready to transform data
 	m_isInitialized = true;
 }
@@ -479,7 +531,7 @@ void AHX::StandardExpand(const std::vector<byte> &Key)
 	}
 }
 
-void AHX::ExpandRotBlock(std::vector<__m128i> &Key, __m128i* K1, __m128i* K2, __m128i KR, size_t Offset)
+void AHX::ExpandRotBlock(SecureVector<__m128i> &Key, __m128i* K1, __m128i* K2, __m128i KR, size_t Offset)
 {
 	// 192 bit key expansion method, -requires additional processing
 	__m128i key1 = *K1; 
@@ -511,7 +563,7 @@ void AHX::ExpandRotBlock(std::vector<__m128i> &Key, __m128i* K1, __m128i* K2, __
 	}
 }
 
-void AHX::ExpandRotBlock(std::vector<__m128i> &Key, const size_t Index, const size_t Offset)
+void AHX::ExpandRotBlock(SecureVector<__m128i> &Key, const size_t Index, const size_t Offset)
 {
 	// 128, 256, 512 bit key method
 	__m128i pkb = Key[Index - Offset];
@@ -522,7 +574,7 @@ void AHX::ExpandRotBlock(std::vector<__m128i> &Key, const size_t Index, const si
 	Key[Index] = _mm_xor_si128(pkb, Key[Index]);
 }
 
-void AHX::ExpandSubBlock(std::vector<__m128i> &Key, const size_t Index, const size_t Offset)
+void AHX::ExpandSubBlock(SecureVector<__m128i> &Key, const size_t Index, const size_t Offset)
 {
 	// used with 256 and 512 bit keys
 	__m128i pkb = Key[Index - Offset];
@@ -35,6 +35,7 @@
 #define CEX_AHX_H
 
 #include "IBlockCipher.h"
+#include "SecureVector.h"
 #if defined(__AVX__)
 #	include <wmmintrin.h>
 #endif
@@ -125,13 +126,14 @@ private:
 	static const size_t AES256_ROUNDS = 14;
 	static const size_t MAX_ROUNDS = 38;
 	static const size_t MIN_ROUNDS = 10;
+	static const size_t SCHEDULE_HEADER = 8;
 	// size of state buffer subtracted parallel size calculations
 	static const size_t STATE_PRECACHED = 2048;
 
 	size_t m_blockSize;
 	size_t m_cprKeySize;
 	bool m_destroyEngine;
-	std::vector<__m128i> m_expKey;
+	SecureVector<__m128i> m_expKey;
 	std::unique_ptr<IDigest> m_kdfEngine;
 	Digests m_kdfEngineType;
 	std::vector<byte> m_kdfInfo;
@@ -309,6 +311,27 @@ public:
 	/// <param name="OutOffset">Starting offset within the output array</param>
 	void EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
 
+	/// <summary>
+	/// Export the expanded key schedule of the initialized cipher.
+	/// <para>The schedule can be loaded into other instances of this cipher with <see cref="ImportSchedule(std::vector<byte>)"/>, so that several instances share a single key expansion.
+	/// The array holds the round keys in the clear, and should be cleared by the caller after use.</para>
+	/// </summary>
+	/// 
+	/// <param name="Schedule">The array receiving the key schedule; resized to the schedule length</param>
+	/// 
+	/// <exception cref="Exception::CryptoSymmetricCipherException">Thrown if the cipher has not been initialized</exception>
+	void ExportSchedule(std::vector<byte> &Schedule) override;
+
+	/// <summary>
+	/// Initialize the cipher with a key schedule created by <see cref="ExportSchedule(std::vector<byte>)"/>; the key is not expanded.
+	/// <para>The cipher takes the direction, rounds count and round keys of the exporting instance.</para>
+	/// </summary>
+	/// 
+	/// <param name="Schedule">The exported key schedule</param>
+	/// 
+	/// <exception cref="Exception::CryptoSymmetricCipherException">Thrown if the schedule was exported by another cipher type, or is malformed</exception>
+	void ImportSchedule(const std::vector<byte> &Schedule) override;
+
 	/// <summary>
 	/// Initialize the cipher
 	/// </summary>
@@ -389,9 +412,9 @@ private:
 	void Encrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
 	void Encrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
 	void ExpandKey(bool Encryption, const std::vector<byte> &Key);
-	void ExpandRotBlock(std::vector<__m128i> &Key, __m128i* K1, __m128i* K2, __m128i KR, size_t Offset);
-	void ExpandRotBlock(std::vector<__m128i> &Key, const size_t Index, const size_t Offset);
-	void ExpandSubBlock(std::vector<__m128i> &Key, const size_t Index, const size_t Offset);
+	void ExpandRotBlock(SecureVector<__m128i> &Key, __m128i* K1, __m128i* K2, __m128i KR, size_t Offset);
+	void ExpandRotBlock(SecureVector<__m128i> &Key, const size_t Index, const size_t Offset);
+	void ExpandSubBlock(SecureVector<__m128i> &Key, const size_t Index, const size_t Offset);
 	void LoadState(Digests DigestType);
 	void SecureExpand(const std::vector<byte> &Key);
 	void StandardExpand(const std::vector<byte> &Key);
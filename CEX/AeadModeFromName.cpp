@@ -1,5 +1,4 @@
 #include "AeadModeFromName.h"
-#include "BlockCipherFromName.h"
 #include "EAX.h"
 #include "GCM.h"
 #include "OCB.h"
@@ -46,43 +45,35 @@ IAeadMode* AeadModeFromName::GetInstance(AeadModes CipherType, IBlockCipher* Eng
 IAeadMode* AeadModeFromName::GetInstance(AeadModes CipherType, BlockCiphers EngineType)
 {
 	IAeadMode* aeadPtr;
-	IBlockCipher* cprPtr = BlockCipherFromName::GetInstance(EngineType);
 
 	try
 	{
+		// the enumeration constructors create the block cipher, and delete it with the mode
 		switch (CipherType)
 		{
 			case Enumeration::AeadModes::EAX:
 			{
-				aeadPtr = new Cipher::Symmetric::Block::Mode::EAX(cprPtr);
+				aeadPtr = new Cipher::Symmetric::Block::Mode::EAX(EngineType);
 				break;
 			}
 			case Enumeration::AeadModes::GCM:
 			{
-				aeadPtr = new Cipher::Symmetric::Block::Mode::GCM(cprPtr);
+				aeadPtr = new Cipher::Symmetric::Block::Mode::GCM(EngineType);
 				break;
 			}
 			case Enumeration::AeadModes::OCB:
 			{
-				aeadPtr = new Cipher::Symmetric::Block::Mode::OCB(cprPtr);
+				aeadPtr = new Cipher::Symmetric::Block::Mode::OCB(EngineType);
 				break;
 			}
 			default:
-			{		
-				if (cprPtr != nullptr)
-				{
-					delete cprPtr;
-				}
+			{
 				throw CryptoException("AeadModeFromName:GetInstance", "The AEAD cipher mode is not supported!");
 			}
 		}
 	}
 	catch (const std::exception &ex)
 	{
-		if (cprPtr != nullptr)
-		{
-			delete cprPtr;
-		}
 		throw CryptoException("AeadModeFromName:GetInstance", "The block cipher mode is unavailable!", std::string(ex.what()));
 	}
 
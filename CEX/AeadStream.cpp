@@ -0,0 +1,398 @@
+#include "AeadStream.h"
+#include "AeadModeFromName.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+#include "ParallelUtils.h"
+#include "SymmetricKey.h"
+#include "SymmetricKeyView.h"
+
+NAMESPACE_PROCESSING
+
+const std::string AeadStream::CLASS_NAME = "AeadStream";
+
+//~~~Constructor~~~//
+
+AeadStream::AeadStream(AeadModes ModeType, BlockCiphers CipherType, size_t SegmentSize)
+	:
+	m_aeadMode(ModeType != AeadModes::None ? ModeType :
+		throw CryptoProcessingException("AeadStream:CTor", "The AEAD mode can not be none!")),
+	m_aeadEngines(0),
+	m_cipherType(CipherType != BlockCiphers::None ? CipherType :
+		throw CryptoProcessingException("AeadStream:CTor", "The cipher type can not be none!")),
+	m_inpBuffer(0),
+	m_isDestroyed(false),
+	m_isEncryption(false),
+	m_isInitialized(false),
+	m_isParallel(false),
+	m_legalKeySizes(0),
+	m_nonceSize(ModeType == AeadModes::EAX ? 16 : 12),
+	m_outBuffer(0),
+	m_parallelDegree(Utility::ParallelUtils::ProcessorCount()),
+	m_segmentSize(SegmentSize >= MIN_SEGSIZE && SegmentSize <= MAX_SEGSIZE && SegmentSize % 16 == 0 ? SegmentSize :
+		throw CryptoProcessingException("AeadStream:CTor", "The segment size must be a multiple of 16, between MIN_SEGSIZE and MAX_SEGSIZE!")),
+	m_streamHeader(HEADER_SIZE)
+{
+	if (m_parallelDegree == 0)
+	{
+		m_parallelDegree = 1;
+	}
+
+	m_isParallel = (m_parallelDegree > 1);
+
+	// the first instance reports the key sizes, and is kept as the first worker
+	m_aeadEngines.push_back(std::unique_ptr<IAeadMode>(Helper::AeadModeFromName::GetInstance(m_aeadMode, m_cipherType)));
+	std::vector<SymmetricKeySize> keySizes = m_aeadEngines[0]->LegalKeySizes();
+	m_legalKeySizes.resize(keySizes.size());
+
+	for (size_t i = 0; i < m_legalKeySizes.size(); ++i)
+	{
+		m_legalKeySizes[i] = SymmetricKeySize(keySizes[i].KeySize(), NONCE_PREFIX, keySizes[i].InfoSize());
+	}
+}
+
+AeadStream::~AeadStream()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_isEncryption = false;
+		m_isInitialized = false;
+		m_isParallel = false;
+		m_nonceSize = 0;
+		m_parallelDegree = 0;
+		m_segmentSize = 0;
+
+		for (size_t i = 0; i < m_aeadEngines.size(); ++i)
+		{
+			m_aeadEngines[i].reset(nullptr);
+		}
+
+		m_aeadEngines.clear();
+		Utility::IntUtils::ClearVector(m_inpBuffer);
+		Utility::IntUtils::ClearVector(m_legalKeySizes);
+		Utility::IntUtils::ClearVector(m_outBuffer);
+		Utility::IntUtils::ClearVector(m_streamHeader);
+	}
+}
+
+//~~~Accessors~~~//
+
+bool &AeadStream::IsParallel()
+{
+	return m_isParallel;
+}
+
+const std::vector<SymmetricKeySize> AeadStream::LegalKeySizes()
+{
+	return m_legalKeySizes;
+}
+
+const size_t AeadStream::ParallelDegree()
+{
+	return m_parallelDegree;
+}
+
+const size_t AeadStream::SegmentSize()
+{
+	return m_segmentSize;
+}
+
+//~~~Public Functions~~~//
+
+ulong AeadStream::CalculateSize(ulong Length, size_t SegmentSize)
+{
+	const ulong SEGCNT = (Length == 0) ? 1 : (Length + SegmentSize - 1) / SegmentSize;
+
+	return HEADER_SIZE + Length + (SEGCNT * TAG_SIZE);
+}
+
+void AeadStream::Initialize(bool Encryption, ISymmetricKey &KeyParams)
+{
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), kv.Key().size()))
+	{
+		throw CryptoProcessingException("AeadStream:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
+	}
+	if (Encryption && kv.Nonce().size() != NONCE_PREFIX)
+	{
+		throw CryptoProcessingException("AeadStream:Initialize", "Encryption requires a nonce prefix of NONCE_PREFIX bytes!");
+	}
+	if (Encryption && kv.Nonce() == std::vector<byte>(NONCE_PREFIX, 0x00))
+	{
+		// the first segment nonce would be zeroised, which the EAX mode rejects
+		throw CryptoProcessingException("AeadStream:Initialize", "The nonce prefix can not be zeroised!");
+	}
+
+	// segment nonces have a final flag of 0 or 1, so this nonce is never loaded by a segment
+	const std::vector<byte> KEYNONCE(m_nonceSize, 0xFF);
+
+	try
+	{
+		while (m_aeadEngines.size() < m_parallelDegree)
+		{
+			m_aeadEngines.push_back(std::unique_ptr<IAeadMode>(Helper::AeadModeFromName::GetInstance(m_aeadMode, m_cipherType)));
+		}
+
+		m_aeadEngines.resize(m_parallelDegree);
+
+		for (size_t i = 0; i < m_aeadEngines.size(); ++i)
+		{
+			// segments are the unit of parallelism, each mode instance runs on a single thread
+			m_aeadEngines[i]->ParallelProfile().IsParallel() = false;
+			Key::Symmetric::SymmetricKey kp(kv.Key(), KEYNONCE, kv.Info());
+			m_aeadEngines[i]->Initialize(Encryption, kp);
+		}
+	}
+	catch (std::exception &ex)
+	{
+		throw CryptoProcessingException("AeadStream:Initialize", "The key could not be loaded, check the key size!", std::string(ex.what()));
+	}
+
+	m_inpBuffer.resize(m_parallelDegree * (m_segmentSize + TAG_SIZE));
+	m_outBuffer.resize(m_parallelDegree * (m_segmentSize + TAG_SIZE));
+
+	if (Encryption)
+	{
+		Utility::IntUtils::Le32ToBytes(STREAM_MAGIC, m_streamHeader, 0);
+		m_streamHeader[4] = FORMAT_VERSION;
+		m_streamHeader[5] = static_cast<byte>(m_aeadMode);
+		m_streamHeader[6] = static_cast<byte>(m_cipherType);
+		m_streamHeader[7] = static_cast<byte>(TAG_SIZE);
+		Utility::IntUtils::Le32ToBytes(static_cast<uint>(m_segmentSize), m_streamHeader, 8);
+		Utility::MemUtils::Copy(kv.Nonce(), 0, m_streamHeader, HEADER_SIZE - NONCE_PREFIX, NONCE_PREFIX);
+	}
+	else
+	{
+		Utility::MemUtils::Clear(m_streamHeader, 0, m_streamHeader.size());
+	}
+
+	m_isEncryption = Encryption;
+	m_isInitialized = true;
+}
+
+void AeadStream::ParallelMaxDegree(size_t Degree)
+{
+	if (Degree == 0)
+	{
+		throw CryptoProcessingException("AeadStream:ParallelMaxDegree", "The parallel degree can not be zero!");
+	}
+
+	m_parallelDegree = Degree;
+	m_isParallel = (Degree > 1);
+	m_isInitialized = false;
+}
+
+void AeadStream::Write(IByteStream* InStream, IByteStream* OutStream)
+{
+	CexAssert(InStream->CanRead(), "the Input stream is set to write only!");
+	CexAssert(OutStream->CanWrite(), "the Output stream is to read only!");
+
+	if (!m_isInitialized)
+	{
+		throw CryptoProcessingException("AeadStream:Write", "The processor must be initialized before each stream is written!");
+	}
+
+	// a segment nonce can be loaded only once per key, so every stream requires a new Initialize
+	m_isInitialized = false;
+
+	if (m_isEncryption)
+	{
+		Encrypt(InStream, OutStream);
+	}
+	else
+	{
+		Decrypt(InStream, OutStream);
+	}
+
+	if (OutStream->Position() != OutStream->Length())
+	{
+		OutStream->SetLength(OutStream->Position());
+	}
+}
+
+//~~~Private Functions~~~//
+
+void AeadStream::CalculateProgress(ulong Length, ulong Processed)
+{
+	if (Length != 0 && Length >= Processed)
+	{
+		ProgressPercent(static_cast<int>(100.0 * (static_cast<double>(Processed) / Length)));
+	}
+}
+
+void AeadStream::Decrypt(IByteStream* InStream, IByteStream* OutStream)
+{
+	const ulong INPLEN = InStream->Length() - InStream->Position();
+	const size_t SEGLEN = m_segmentSize + TAG_SIZE;
+	const size_t BATSZE = m_isParallel ? m_parallelDegree : 1;
+
+	if (INPLEN < HEADER_SIZE + TAG_SIZE)
+	{
+		throw CryptoProcessingException("AeadStream:Decrypt", "The stream is truncated!");
+	}
+
+	InStream->Read(m_streamHeader, 0, HEADER_SIZE);
+
+	if (Utility::IntUtils::LeBytesTo32(m_streamHeader, 0) != STREAM_MAGIC || m_streamHeader[4] != FORMAT_VERSION)
+	{
+		throw CryptoProcessingException("AeadStream:Decrypt", "The stream is not a segmented AEAD stream, or the format version is not supported!");
+	}
+	if (m_streamHeader[5] != static_cast<byte>(m_aeadMode) || m_streamHeader[6] != static_cast<byte>(m_cipherType) ||
+		m_streamHeader[7] != static_cast<byte>(TAG_SIZE) || Utility::IntUtils::LeBytesTo32(m_streamHeader, 8) != m_segmentSize)
+	{
+		throw CryptoProcessingException("AeadStream:Decrypt", "The stream header does not match the cipher configuration!");
+	}
+
+	const ulong CPTLEN = INPLEN - HEADER_SIZE;
+	const ulong SEGCNT = (CPTLEN + SEGLEN - 1) / SEGLEN;
+
+	// every segment carries a tag, a shorter remainder is not a segment
+	if (CPTLEN - ((SEGCNT - 1) * SEGLEN) < TAG_SIZE)
+	{
+		throw CryptoProcessingException("AeadStream:Decrypt", "The stream is truncated!");
+	}
+
+	ulong prcLen = 0;
+	ulong segIdx = 0;
+
+	while (segIdx != SEGCNT)
+	{
+		const size_t SEGBAT = static_cast<size_t>(Utility::IntUtils::Min<ulong>(BATSZE, SEGCNT - segIdx));
+		const size_t RDLEN = static_cast<size_t>(Utility::IntUtils::Min<ulong>(SEGBAT * SEGLEN, CPTLEN - prcLen));
+
+		if (InStream->Read(m_inpBuffer, 0, RDLEN) != RDLEN)
+		{
+			throw CryptoProcessingException("AeadStream:Decrypt", "The stream is truncated!");
+		}
+
+		const size_t OUTLEN = ProcessBatch(segIdx, SEGBAT, SEGCNT - 1, RDLEN);
+		OutStream->Write(m_outBuffer, 0, OUTLEN);
+		segIdx += SEGBAT;
+		prcLen += RDLEN;
+		CalculateProgress(CPTLEN, prcLen);
+	}
+}
+
+void AeadStream::Encrypt(IByteStream* InStream, IByteStream* OutStream)
+{
+	const ulong INPLEN = InStream->Length() - InStream->Position();
+	const ulong SEGCNT = (INPLEN == 0) ? 1 : (INPLEN + m_segmentSize - 1) / m_segmentSize;
+	const size_t BATSZE = m_isParallel ? m_parallelDegree : 1;
+
+	// the segment counter is 32 bits
+	if (SEGCNT > 0x100000000ULL)
+	{
+		throw CryptoProcessingException("AeadStream:Encrypt", "The stream exceeds the maximum number of segments!");
+	}
+
+	OutStream->Write(m_streamHeader, 0, HEADER_SIZE);
+
+	ulong prcLen = 0;
+	ulong segIdx = 0;
+
+	while (segIdx != SEGCNT)
+	{
+		const size_t SEGBAT = static_cast<size_t>(Utility::IntUtils::Min<ulong>(BATSZE, SEGCNT - segIdx));
+		const size_t RDLEN = static_cast<size_t>(Utility::IntUtils::Min<ulong>(SEGBAT * m_segmentSize, INPLEN - prcLen));
+
+		if (RDLEN != 0 && InStream->Read(m_inpBuffer, 0, RDLEN) != RDLEN)
+		{
+			throw CryptoProcessingException("AeadStream:Encrypt", "The input stream could not be read!");
+		}
+
+		const size_t OUTLEN = ProcessBatch(segIdx, SEGBAT, SEGCNT - 1, RDLEN);
+		OutStream->Write(m_outBuffer, 0, OUTLEN);
+		segIdx += SEGBAT;
+		prcLen += RDLEN;
+		CalculateProgress(INPLEN, prcLen);
+	}
+}
+
+size_t AeadStream::ProcessBatch(ulong SegmentIndex, size_t SegmentCount, ulong FinalIndex, size_t Length)
+{
+	const size_t INPSEG = m_isEncryption ? m_segmentSize : m_segmentSize + TAG_SIZE;
+	const size_t OUTSEG = m_isEncryption ? m_segmentSize + TAG_SIZE : m_segmentSize;
+	const size_t TAGLEN = m_isEncryption ? 0 : TAG_SIZE;
+	// 0: failed authentication, 1: processed, 2: the mode threw
+	std::vector<byte> segState(SegmentCount, 0);
+
+	auto prcSeg = [this, SegmentIndex, FinalIndex, Length, INPSEG, OUTSEG, TAGLEN, &segState](size_t Worker)
+	{
+		const size_t INPOFF = Worker * INPSEG;
+		const size_t SEGLEN = Utility::IntUtils::Min(INPSEG, Length - INPOFF) - TAGLEN;
+
+		// the parallel loop does not propagate exceptions, they are reported through the state
+		try
+		{
+			segState[Worker] = TransformSegment(Worker, SegmentIndex + Worker, SegmentIndex + Worker == FinalIndex, INPOFF, Worker * OUTSEG, SEGLEN) ? 1 : 0;
+		}
+		catch (std::exception&)
+		{
+			segState[Worker] = 2;
+		}
+	};
+
+	if (SegmentCount > 1)
+	{
+		Utility::ParallelUtils::ParallelFor(0, SegmentCount, prcSeg);
+	}
+	else
+	{
+		prcSeg(0);
+	}
+
+	for (size_t i = 0; i < SegmentCount; ++i)
+	{
+		if (segState[i] != 1)
+		{
+			// nothing from a batch that failed is released
+			Utility::MemUtils::Clear(m_outBuffer, 0, m_outBuffer.size());
+
+			if (segState[i] == 0)
+			{
+				throw CryptoAuthenticationFailure("AeadStream:ProcessBatch", "A segment failed authentication; the stream has been modified!");
+			}
+			else
+			{
+				throw CryptoProcessingException("AeadStream:ProcessBatch", "The segment could not be transformed!");
+			}
+		}
+	}
+
+	return m_isEncryption ? Length + (SegmentCount * TAG_SIZE) : Length - (SegmentCount * TAG_SIZE);
+}
+
+bool AeadStream::TransformSegment(size_t Worker, ulong Index, bool Final, size_t InOffset, size_t OutOffset, size_t Length)
+{
+	IAeadMode* eng = m_aeadEngines[Worker].get();
+	std::vector<byte> segNonce(m_nonceSize, 0x00);
+
+	// prefix || big endian segment counter || final flag
+	Utility::MemUtils::Copy(m_streamHeader, HEADER_SIZE - NONCE_PREFIX, segNonce, 0, NONCE_PREFIX);
+	Utility::IntUtils::Be32ToBytes(static_cast<uint>(Index), segNonce, NONCE_PREFIX);
+	segNonce[NONCE_PREFIX + 4] = Final ? 0x01 : 0x00;
+
+	// an empty key loads the nonce without recalculating the key schedule
+	Key::Symmetric::SymmetricKey kp(std::vector<byte>(0), segNonce);
+	eng->Initialize(m_isEncryption, kp);
+	eng->SetAssociatedData(m_streamHeader, 0, HEADER_SIZE);
+
+	if (Length != 0)
+	{
+		eng->Transform(m_inpBuffer, InOffset, m_outBuffer, OutOffset, Length);
+	}
+
+	if (m_isEncryption)
+	{
+		eng->Finalize(m_outBuffer, OutOffset + Length, TAG_SIZE);
+
+		return true;
+	}
+	else
+	{
+		return eng->Verify(m_inpBuffer, InOffset + Length, TAG_SIZE);
+	}
+}
+
+NAMESPACE_PROCESSINGEND
@@ -0,0 +1,285 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+// Implementation Details:
+// An implementation of a segmented streaming AEAD format, based on the STREAM construction.
+// Online Authenticated-Encryption and its Nonce-Reuse Misuse-Resistance: https://eprint.iacr.org/2015/189.pdf
+
+#ifndef CEX_AEADSTREAM_H
+#define CEX_AEADSTREAM_H
+
+#include "CexDomain.h"
+#include "AeadModes.h"
+#include "BlockCiphers.h"
+#include "CryptoAuthenticationFailure.h"
+#include "CryptoProcessingException.h"
+#include "Event.h"
+#include "IAeadMode.h"
+#include "IByteStream.h"
+#include "ISymmetricKey.h"
+#include "SymmetricKeySize.h"
+
+NAMESPACE_PROCESSING
+
+using Enumeration::AeadModes;
+using Enumeration::BlockCiphers;
+using Exception::CryptoAuthenticationFailure;
+using Exception::CryptoProcessingException;
+using Routing::Event;
+using Cipher::Symmetric::Block::Mode::IAeadMode;
+using IO::IByteStream;
+using Key::Symmetric::ISymmetricKey;
+using Key::Symmetric::SymmetricKeySize;
+
+/// <summary>
+/// A segmented streaming AEAD processor.
+/// <para>Encrypts a stream as a sequence of fixed size segments, each authenticated with its own nonce and tag, so a large file can be encrypted and verified on several cores,
+/// and a reader rejects modified data at the first bad segment, without buffering the whole stream.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Encrypting a file with AES-GCM in 64KB segments:</description>
+/// <code>
+/// // the nonce is the per-stream nonce prefix, and must be unique for each stream encrypted with a key
+/// SymmetricKey kp(key, prefix);
+/// FileStream* fIn = new FileStream("C://Tests//test.txt", FileStream::FileAccess::Read);
+/// FileStream* fOut = new FileStream("C://Tests//test.enc", FileStream::FileAccess::ReadWrite);
+///
+/// AeadStream as(AeadModes::GCM, BlockCiphers::Rijndael);
+/// as.Initialize(true, kp);
+/// as.Write(fIn, fOut);
+/// </code>
+/// </example>
+///
+/// <example>
+/// <description>Decrypting the file; the nonce prefix is read from the stream header:</description>
+/// <code>
+/// SymmetricKey kp(key);
+/// AeadStream as(AeadModes::GCM, BlockCiphers::Rijndael);
+/// as.Initialize(false, kp);
+///
+/// try
+/// {
+///		as.Write(fIn, fOut);
+/// }
+/// catch (const CryptoAuthenticationFailure&)
+/// {
+///		// the stream was modified or truncated; discard the output
+/// }
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description><B>Stream Format:</B></description>
+/// <para>The output begins with a HEADER_SIZE byte header: a four byte magic value, the format version, the AEAD mode, the block cipher, the tag size,
+/// the segment size as a 32bit little endian integer, and the NONCE_PREFIX byte nonce prefix. \n
+/// The header is followed by the segments; each is SegmentSize() bytes of cipher-text followed by a TAG_SIZE byte tag, and only the last segment can be shorter.
+/// An empty input produces a single, empty final segment.</para>
+///
+/// <description><B>Segment Nonces:</B></description>
+/// <para>The nonce of segment i is the prefix, followed by i as a 32bit big endian counter, followed by a flag byte set to 1 on the last segment and 0 on all others,
+/// and zero padded to the modes nonce size (12 bytes with GCM and OCB, 16 with EAX). The header is the associated data of every segment. \n
+/// A segment can not be moved or copied to another position, and the stream can not be truncated at a segment boundary, or extended, without failing authentication;
+/// any change to the header fails authentication of the first segment.</para>
+///
+/// <description><B>Implementation Notes:</B></description>
+/// <list type="bullet">
+/// <item><description>Segments are processed in batches of ParallelDegree() segments, one AEAD mode instance per thread; memory use is bounded to two batch buffers, independent of the stream length.</description></item>
+/// <item><description>Each mode instance is keyed once by Initialize; a segment only loads a new nonce, so the key schedule is not recalculated per segment.
+/// Because a segment nonce can be loaded only once per key, Initialize must be called before each stream is written.</description></item>
+/// <item><description>On decryption a batch is written to the output only when every segment in it has been verified; a failure throws CryptoAuthenticationFailure, and output written by earlier batches must be discarded by the caller.</description></item>
+/// <item><description>The nonce prefix must never repeat under the same key; a random prefix is safe for up to 2^32 streams per key.</description></item>
+/// <item><description>A stream can contain at most 2^32 segments.</description></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>Online Authenticated-Encryption and its Nonce-Reuse Misuse-Resistance: <a href="https://eprint.iacr.org/2015/189.pdf">STREAM</a>.</description></item>
+/// <item><description>NIST <a href="http://csrc.nist.gov/publications/nistpubs/800-38D/SP-800-38D.pdf">SP800-38D</a>.</description></item>
+/// </list>
+/// </remarks>
+class AeadStream
+{
+private:
+
+	static const std::string CLASS_NAME;
+	static const byte FORMAT_VERSION = 1;
+	static const uint STREAM_MAGIC = 0x45415843;
+
+	AeadModes m_aeadMode;
+	std::vector<std::unique_ptr<IAeadMode>> m_aeadEngines;
+	BlockCiphers m_cipherType;
+	std::vector<byte> m_inpBuffer;
+	bool m_isDestroyed;
+	bool m_isEncryption;
+	bool m_isInitialized;
+	bool m_isParallel;
+	std::vector<SymmetricKeySize> m_legalKeySizes;
+	size_t m_nonceSize;
+	std::vector<byte> m_outBuffer;
+	size_t m_parallelDegree;
+	size_t m_segmentSize;
+	std::vector<byte> m_streamHeader;
+
+public:
+
+	//~~~Constants~~~//
+
+	/// <summary>
+	/// The default segment size in bytes
+	/// </summary>
+	static const size_t DEF_SEGSIZE = 64 * 1024;
+
+	/// <summary>
+	/// The size of the stream header in bytes
+	/// </summary>
+	static const size_t HEADER_SIZE = 19;
+
+	/// <summary>
+	/// The largest legal segment size in bytes
+	/// </summary>
+	static const size_t MAX_SEGSIZE = 16 * 1024 * 1024;
+
+	/// <summary>
+	/// The smallest legal segment size in bytes
+	/// </summary>
+	static const size_t MIN_SEGSIZE = 1024;
+
+	/// <summary>
+	/// The size of the per-stream nonce prefix in bytes
+	/// </summary>
+	static const size_t NONCE_PREFIX = 7;
+
+	/// <summary>
+	/// The size of a segment tag in bytes
+	/// </summary>
+	static const size_t TAG_SIZE = 16;
+
+	/// <summary>
+	/// The Progress Percent event
+	/// </summary>
+	Event<int> ProgressPercent;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	AeadStream(const AeadStream&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	AeadStream& operator=(const AeadStream&) = delete;
+
+	/// <summary>
+	/// Initialize this class with the AEAD mode and block cipher enumeration names
+	/// </summary>
+	///
+	/// <param name="ModeType">The AEAD cipher mode enumeration name</param>
+	/// <param name="CipherType">The block cipher enumeration name</param>
+	/// <param name="SegmentSize">The plain-text size of a segment; must be a multiple of 16, between MIN_SEGSIZE and MAX_SEGSIZE</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the mode, cipher or segment size is invalid</exception>
+	explicit AeadStream(AeadModes ModeType = AeadModes::GCM, BlockCiphers CipherType = BlockCiphers::RHX, size_t SegmentSize = DEF_SEGSIZE);
+
+	/// <summary>
+	/// Destroy this class
+	/// </summary>
+	~AeadStream();
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read/Write: Process the segments of a batch on separate threads.
+	/// <para>This value is true if the host has more than one processor; if set to false, segments are processed one at a time.</para>
+	/// </summary>
+	bool &IsParallel();
+
+	/// <summary>
+	/// Read Only: The legal key sizes; the nonce size is the nonce prefix size required for encryption
+	/// </summary>
+	const std::vector<SymmetricKeySize> LegalKeySizes();
+
+	/// <summary>
+	/// Read Only: The number of segments processed in parallel, and the number of AEAD mode instances
+	/// </summary>
+	const size_t ParallelDegree();
+
+	/// <summary>
+	/// Read Only: The plain-text size of a segment in bytes
+	/// </summary>
+	const size_t SegmentSize();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Get the size of the encrypted stream for a plain-text length
+	/// </summary>
+	///
+	/// <param name="Length">The plain-text length in bytes</param>
+	/// <param name="SegmentSize">The segment size</param>
+	///
+	/// <returns>The cipher-text length, including the header and tags</returns>
+	static ulong CalculateSize(ulong Length, size_t SegmentSize = DEF_SEGSIZE);
+
+	/// <summary>
+	/// Initialize the processor with a key.
+	/// <para>For encryption the key nonce is the NONCE_PREFIX byte stream nonce prefix; for decryption the prefix is read from the stream header, and the nonce is ignored.</para>
+	/// </summary>
+	///
+	/// <param name="Encryption">The processor is initialized for encryption</param>
+	/// <param name="KeyParams">The ISymmetricKey containing the cipher key, and for encryption the nonce prefix</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if an invalid key or nonce prefix size is used, or the nonce prefix is zeroised</exception>
+	void Initialize(bool Encryption, ISymmetricKey &KeyParams);
+
+	/// <summary>
+	/// Set the number of segments processed in parallel.
+	/// <para>Each degree of parallelism holds an AEAD mode instance and a segment in each of two buffers. Changing the degree requires a new call to Initialize.</para>
+	/// </summary>
+	///
+	/// <param name="Degree">The number of threads; can not be zero</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the degree is zero</exception>
+	void ParallelMaxDegree(size_t Degree);
+
+	/// <summary>
+	/// Encrypt or decrypt a stream.
+	/// <para>Processes from the input streams position to its end. When using FileStreams the InStream must be initialized as Read, and the OutStream as ReadWrite.
+	/// Initialize(bool, ISymmetricKey) must be called before each stream is written.</para>
+	/// </summary>
+	///
+	/// <param name="InStream">The input stream containing the data to transform</param>
+	/// <param name="OutStream">The output stream that receives the transformed bytes</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if Write is called before Initialize, the stream header does not match this configuration, or the stream is truncated</exception>
+	/// <exception cref="Exception::CryptoAuthenticationFailure">Thrown on decryption if a segment fails authentication</exception>
+	void Write(IByteStream* InStream, IByteStream* OutStream);
+
+private:
+
+	void CalculateProgress(ulong Length, ulong Processed);
+	void Decrypt(IByteStream* InStream, IByteStream* OutStream);
+	void Encrypt(IByteStream* InStream, IByteStream* OutStream);
+	size_t ProcessBatch(ulong SegmentIndex, size_t SegmentCount, ulong FinalIndex, size_t Length);
+	bool TransformSegment(size_t Worker, ulong Index, bool Final, size_t InOffset, size_t OutOffset, size_t Length);
+};
+
+NAMESPACE_PROCESSINGEND
+#endif
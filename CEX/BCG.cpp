@@ -6,6 +6,8 @@
 #include "ParallelUtils.h"
 #include "ProviderFromName.h"
 #include "SymmetricKey.h"
+#include "Instrumentation.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_DRBG
 
@@ -29,6 +31,7 @@ BCG::BCG(BlockCiphers CipherType, Digests DigestType, Providers ProviderType)
 	m_kdfEngineType(DigestType),
 	m_kdfInfo(0),
 	m_legalKeySizes(m_blockCipher->LegalKeySizes()),
+	m_outputCounter(0),
 	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), false),
 	m_prdResistant(ProviderType != Providers::None),
 	m_providerSource(ProviderType != Providers::None ? Helper::ProviderFromName::GetInstance(ProviderType) : nullptr),
@@ -57,6 +60,7 @@ BCG::BCG(IBlockCipher* Cipher, IDigest* Digest, IProvider* Provider)
 	m_kdfEngineType(m_kdfEngine != nullptr ? m_kdfEngine->Enumeral() : Digests::None),
 	m_kdfInfo(0),
 	m_legalKeySizes(m_blockCipher->LegalKeySizes()),
+	m_outputCounter(0),
 	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), false),
 	m_prdResistant(Provider != nullptr),
 	m_providerSource(Provider),
@@ -79,6 +83,7 @@ BCG::~BCG()
 		m_isEncryption = false;
 		m_isInitialized = false;
 		m_kdfEngineType = Digests::None;
+		m_outputCounter = 0;
 		m_parallelProfile.Reset();
 		m_prdResistant = false;
 		m_providerType = Providers::None;
@@ -218,31 +223,51 @@ size_t BCG::Generate(std::vector<byte> &Output)
 
 size_t BCG::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Drbg, CLASS_NAME, Length);
+
 	CexAssert(m_isInitialized, "The generator must be initialized before use!");
 	CexAssert((Output.size() - Length) >= OutOffset, "Output buffer too small!");
-	CexAssert(Length <= ParallelBlockSize(), "The maximum request size has been exceeded!");
 
-	GenerateBlock(Output, OutOffset, Length);
+	if (Length > MAX_OUTPUT - m_outputCounter)
+	{
+		throw CryptoGeneratorException("BCG:Generate", "The maximum output size has been exceeded, re-initialize the generator!");
+	}
+
+	size_t prcLen = Length;
 
-	if (m_prdResistant)
+	while (prcLen != 0)
 	{
-		m_reseedCounter += Length;
+		// split the request at the reseed threshold, so the generator is re-keyed at the same position regardless of the request sizes
+		const size_t RMDSZE = m_prdResistant ? Utility::IntUtils::Min(prcLen, (m_reseedThreshold > m_reseedCounter) ? m_reseedThreshold - m_reseedCounter : 1) : prcLen;
 
-		if (m_reseedCounter >= m_reseedThreshold)
+		GenerateBlock(Output, OutOffset, RMDSZE);
+		m_outputCounter += RMDSZE;
+		OutOffset += RMDSZE;
+		prcLen -= RMDSZE;
+
+		if (m_prdResistant)
 		{
-			++m_reseedRequests;
+			m_reseedCounter += RMDSZE;
 
-			if (m_reseedRequests > MAX_RESEED)
+			if (m_reseedCounter >= m_reseedThreshold)
 			{
-				throw CryptoGeneratorException("BCG:Generate", "The maximum reseed requests can not be exceeded, re-initialize the generator!");
+				++m_reseedRequests;
+
+				if (m_reseedRequests > MAX_RESEED)
+				{
+					throw CryptoGeneratorException("BCG:Generate", "The maximum reseed requests can not be exceeded, re-initialize the generator!");
+				}
+
+				CEX_INSTRUMENT_RESEED();
+
+				m_reseedCounter = 0;
+				// use next block of state as seed material
+				std::vector<byte> state(m_kdfEngine->BlockSize());
+				GenerateBlock(state, 0, state.size());
+				// combine with salt from entropy provider, extract, and re-key
+				Derive(state);
+				m_outputCounter = 0;
 			}
-
-			m_reseedCounter = 0;
-			// use next block of state as seed material
-			std::vector<byte> state(m_kdfEngine->BlockSize());
-			GenerateBlock(state, 0, state.size());
-			// combine with salt from entropy provider, extract, and re-key
-			Derive(state);
 		}
 	}
 
@@ -251,20 +276,22 @@ size_t BCG::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length)
 
 void BCG::Initialize(ISymmetricKey &GenParam)
 {
-	if (GenParam.Nonce().size() != 0)
+	Key::Symmetric::SymmetricKeyView kv(GenParam);
+
+	if (kv.Nonce().size() != 0)
 	{
-		if (GenParam.Info().size() != 0)
+		if (kv.Info().size() != 0)
 		{
-			Initialize(GenParam.Key(), GenParam.Nonce(), GenParam.Info());
+			Initialize(kv.Key(), kv.Nonce(), kv.Info());
 		}
 		else
 		{
-			Initialize(GenParam.Key(), GenParam.Nonce());
+			Initialize(kv.Key(), kv.Nonce());
 		}
 	}
 	else
 	{
-		Initialize(GenParam.Key());
+		Initialize(kv.Key());
 	}
 }
 
@@ -289,6 +316,7 @@ void BCG::Initialize(const std::vector<byte> &Seed)
 	std::vector<byte> key(keyLen);
 	Utility::MemUtils::Copy(Seed, BLOCK_SIZE, key, 0, keyLen);
 	m_blockCipher->Initialize(true, Key::Symmetric::SymmetricKey(key));
+	m_outputCounter = 0;
 	m_isInitialized = true;
 }
 
@@ -361,6 +389,9 @@ void BCG::ParallelMaxDegree(size_t Degree)
 
 void BCG::Update(const std::vector<byte> &Seed)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Drbg, CLASS_NAME, Seed.size());
+	CEX_INSTRUMENT_RESEED();
+
 	if (Seed.size() != m_seedSize)
 	{
 		throw CryptoGeneratorException("BCG::Update", "Update seed size must be equal to seed size used to initialize the generator!");
@@ -396,35 +427,46 @@ void BCG::GenerateBlock(std::vector<byte> &Output, size_t OutOffset, size_t Leng
 	}
 	else
 	{
-		const size_t OUTSZE = Length;
-		const size_t CNKSZE = ParallelBlockSize() / m_parallelProfile.ParallelMaxDegree();
-		const size_t CTRLEN = (CNKSZE / BLOCK_SIZE);
+		CEX_INSTRUMENT_PARALLEL();
+
+		const size_t PRLDGR = m_parallelProfile.ParallelMaxDegree();
+		const size_t SEGALN = PRLDGR * BLOCK_SIZE;
+		// the largest segment processed by one parallel loop; bounds the thread counter offsets
+		const size_t SEGMAX = MAX_PRLALLOC - (MAX_PRLALLOC % SEGALN);
 		std::vector<byte> tmpCtr(m_ctrVector.size());
 
-		Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Output, OutOffset, &tmpCtr, CNKSZE, CTRLEN](size_t i)
+		// split the block aligned length across the threads, in segments of up to SEGMAX bytes
+		while (Length >= ParallelBlockSize())
 		{
-			// thread level counter
-			std::vector<byte> thdCtr(m_ctrVector.size());
-			// offset counter by chunk size / block size  
-			Utility::IntUtils::BeIncrease8(m_ctrVector, thdCtr, CTRLEN * i);
-			// generate random at output offset
-			this->Transform(Output, OutOffset + (i * CNKSZE), CNKSZE, thdCtr);
-			// store last counter
-			if (i == m_parallelProfile.ParallelMaxDegree() - 1)
+			const size_t SEGSZE = Utility::IntUtils::Min(Length - (Length % SEGALN), SEGMAX);
+			const size_t CNKSZE = SEGSZE / PRLDGR;
+			const size_t CTRLEN = CNKSZE / BLOCK_SIZE;
+
+			Utility::ParallelUtils::ParallelFor(0, PRLDGR, [this, &Output, OutOffset, &tmpCtr, CNKSZE, CTRLEN, PRLDGR](size_t i)
 			{
-				Utility::MemUtils::Copy(thdCtr, 0, tmpCtr, 0, tmpCtr.size());
-			}
-		});
+				// thread level counter
+				std::vector<byte> thdCtr(m_ctrVector.size());
+				// offset counter by chunk size / block size  
+				Utility::IntUtils::BeIncrease8(m_ctrVector, thdCtr, CTRLEN * i);
+				// generate random at output offset
+				this->Transform(Output, OutOffset + (i * CNKSZE), CNKSZE, thdCtr);
+				// store last counter
+				if (i == PRLDGR - 1)
+				{
+					Utility::MemUtils::Copy(thdCtr, 0, tmpCtr, 0, tmpCtr.size());
+				}
+			});
+
+			// copy last counter to class variable
+			Utility::MemUtils::Copy(tmpCtr, 0, m_ctrVector, 0, m_ctrVector.size());
+			OutOffset += SEGSZE;
+			Length -= SEGSZE;
+		}
 
-		// copy last counter to class variable
-		Utility::MemUtils::Copy(tmpCtr, 0, m_ctrVector, 0, m_ctrVector.size());
 		// last block processing
-		const size_t ALNSZE = CNKSZE * m_parallelProfile.ParallelMaxDegree();
-
-		if (ALNSZE < OUTSZE)
+		if (Length != 0)
 		{
-			const size_t FNLSZE = Length % ALNSZE;
-			Transform(Output, ALNSZE, FNLSZE, m_ctrVector);
+			Transform(Output, OutOffset, Length, m_ctrVector);
 		}
 	}
 }
@@ -443,38 +485,7 @@ void BCG::Transform(std::vector<byte> &Output, const size_t OutOffset, const siz
 		// stagger counters and process 8 blocks with avx
 		while (blkCtr != PBKALN)
 		{
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 0);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 16);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 32);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 48);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 64);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 80);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 96);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 112);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 128);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 144);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 160);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 176);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 192);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 208);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 224);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 240);
-			Utility::IntUtils::BeIncrement8(Counter);
+			Utility::IntUtils::BeIncrementBlocks8(Counter, ctrBlk, 0, 16);
 			m_blockCipher->Transform2048(ctrBlk, 0, Output, OutOffset + blkCtr);
 			blkCtr += AVX512BLK;
 		}
@@ -489,22 +500,7 @@ void BCG::Transform(std::vector<byte> &Output, const size_t OutOffset, const siz
 		// stagger counters and process 8 blocks with avx
 		while (blkCtr != PBKALN)
 		{
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 0);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 16);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 32);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 48);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 64);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 80);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 96);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 112);
-			Utility::IntUtils::BeIncrement8(Counter);
+			Utility::IntUtils::BeIncrementBlocks8(Counter, ctrBlk, 0, 8);
 			m_blockCipher->Transform1024(ctrBlk, 0, Output, OutOffset + blkCtr);
 			blkCtr += AVX2BLK;
 		}
@@ -519,14 +515,7 @@ void BCG::Transform(std::vector<byte> &Output, const size_t OutOffset, const siz
 		// 4 blocks with sse
 		while (blkCtr != PBKALN)
 		{
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 0);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 16);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 32);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 48);
-			Utility::IntUtils::BeIncrement8(Counter);
+			Utility::IntUtils::BeIncrementBlocks8(Counter, ctrBlk, 0, 4);
 			m_blockCipher->Transform512(ctrBlk, 0, Output, OutOffset + blkCtr);
 			blkCtr += AVXBLK;
 		}
@@ -105,7 +105,8 @@ using Common::ParallelOptions;
 /// <item><description>There are three LegalKeySizes, minimum, recommended, and maximum, with BCG, the middle value is the recommended seed length for best security; i.e. LegalKeySizes()[1].</description></item>
 /// <item><description>The Generate() methods can not be used until an Initialize() function has been called, and the generator is seeded.</description></item>
 /// <item><description>In a block cipher counter based generator, the encryption function can be both pipelined (SSE3-128 or AVX-256), and multi-threaded.</description></item>
-/// <item><description>If the system supports Parallel processing, IsParallel() is set to true; passing an output block of ParallelBlockSize() to the Generate function.</description></item>
+/// <item><description>If the system supports Parallel processing, IsParallel() is set to true; an output request of ParallelBlockSize() or larger is split across the processor cores.</description></item>
+/// <item><description>The Generate function accepts requests of any length; large requests are processed internally in segments, and are split at the ReseedThreshold() so that the generator is re-keyed at the same output position regardless of the request sizes.</description></item>
 /// <item><description>The ParallelThreadsMax() property is the thread count in the parallel loop (pre-configured automatically); this must be either 1 (IsParallel=false), or an even number no greater than the number of processer cores on the system.</description></item>
 /// <item><description>ParallelBlockSize() is calculated automatically based on the processor(s) L1 data cache size, this property can be user defined, and must be evenly divisible by ParallelMinimumSize().</description></item>
 /// <item><description>The ParallelBlockSize() can be changed through the ParallelProfile() property</description></item>
@@ -147,6 +148,7 @@ private:
 	Digests m_kdfEngineType;
 	std::vector<byte> m_kdfInfo;
 	std::vector<SymmetricKeySize> m_legalKeySizes;
+	ulong m_outputCounter;
 	ParallelOptions m_parallelProfile;
 	bool m_prdResistant;
 	std::unique_ptr<IProvider> m_providerSource;
@@ -244,7 +246,7 @@ public:
 	std::vector<SymmetricKeySize> LegalKeySizes() const override;
 
 	/// <summary>
-	/// Read Only: The maximum number of bytes that can be generated with a generator instance
+	/// Read Only: The maximum number of bytes that can be generated with a generator instance before it must be re-keyed
 	/// </summary>
 	const ulong MaxOutputSize() override;
 
@@ -312,6 +314,8 @@ public:
 	/// <param name="Length">The number of bytes to generate</param>
 	/// 
 	/// <returns>The number of bytes generated</returns>
+	///
+	/// <exception cref="Exception::CryptoGeneratorException">Thrown if the maximum output size or the maximum reseed count is exceeded</exception>
 	size_t Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length) override;
 
 	/// <summary>
@@ -0,0 +1,459 @@
+#include "BatchStream.h"
+#include "CTR.h"
+#include "DigestFromName.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+#include "ParallelUtils.h"
+#include "SymmetricKey.h"
+#include "SymmetricKeyView.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+
+NAMESPACE_PROCESSING
+
+using Utility::IntUtils;
+using Utility::MemUtils;
+
+const std::string BatchStream::CLASS_NAME = "BatchStream";
+
+/// <summary>
+/// The scheduling state of a stream in a batch
+/// </summary>
+struct BatchStream::BatchJob
+{
+	IByteStream* InStream;
+	IByteStream* OutStream;
+	std::unique_ptr<Key::Symmetric::SymmetricKey> KeyParams;
+	ulong Length;
+	ulong ReadLength;
+	ulong ReadSlice;
+	ulong WriteSlice;
+	std::atomic<bool> IsRead;
+	std::mutex JobMutex;
+	std::condition_variable WriteTurn;
+
+	BatchJob(IByteStream* Input, IByteStream* Output, Key::Symmetric::SymmetricKey* Key)
+		:
+		InStream(Input),
+		OutStream(Output),
+		KeyParams(Key),
+		Length(Input->Length() - Input->Position()),
+		ReadLength(0),
+		ReadSlice(0),
+		WriteSlice(0),
+		IsRead(Length == 0)
+	{
+	}
+};
+
+BatchStream::BatchStatistics::BatchStatistics()
+	:
+	Bytes(0),
+	BytesPerSecond(0),
+	Degree(0),
+	Milliseconds(0),
+	Streams(0)
+{
+}
+
+//~~~Constructor~~~//
+
+BatchStream::BatchStream(BlockCiphers CipherType, size_t BufferSize, size_t MaxMemory)
+	:
+	m_batchStatistics(),
+	m_bufferSize(BufferSize >= MIN_BUFFER && BufferSize % BLOCK_SIZE == 0 ? BufferSize :
+		throw CryptoProcessingException("BatchStream:CTor", "The buffer size must be a multiple of 16, and at least MIN_BUFFER!")),
+	m_cipherType(CipherType != BlockCiphers::None ? CipherType :
+		throw CryptoProcessingException("BatchStream:CTor", "The cipher type can not be none!")),
+	m_isParallel(false),
+	m_legalKeySizes(0),
+	m_maxMemory(MaxMemory >= 2 * BufferSize ? MaxMemory :
+		throw CryptoProcessingException("BatchStream:CTor", "The memory limit must be at least twice the buffer size!")),
+	m_parallelDegree(Utility::ParallelUtils::ProcessorCount()),
+	m_progressInterval(0),
+	m_progressMutex()
+{
+	if (m_parallelDegree == 0)
+	{
+		m_parallelDegree = 1;
+	}
+
+	m_isParallel = (m_parallelDegree > 1);
+
+	Cipher::Symmetric::Block::Mode::CTR cpr(m_cipherType);
+	m_legalKeySizes = cpr.LegalKeySizes();
+}
+
+BatchStream::~BatchStream()
+{
+	m_bufferSize = 0;
+	m_isParallel = false;
+	m_maxMemory = 0;
+	m_parallelDegree = 0;
+	IntUtils::ClearVector(m_legalKeySizes);
+}
+
+//~~~Accessors~~~//
+
+const size_t BatchStream::BufferSize()
+{
+	return m_bufferSize;
+}
+
+bool &BatchStream::IsParallel()
+{
+	return m_isParallel;
+}
+
+const std::vector<SymmetricKeySize> BatchStream::LegalKeySizes()
+{
+	return m_legalKeySizes;
+}
+
+const size_t BatchStream::MaxMemory()
+{
+	return m_maxMemory;
+}
+
+const size_t BatchStream::ParallelDegree()
+{
+	// each worker holds an input and an output buffer
+	return IntUtils::Min(m_parallelDegree, m_maxMemory / (2 * m_bufferSize));
+}
+
+const BatchStream::BatchStatistics BatchStream::Statistics()
+{
+	return m_batchStatistics;
+}
+
+//~~~Public Functions~~~//
+
+std::vector<std::vector<byte>> BatchStream::Compute(const std::vector<IByteStream*> &InStreams, Digests DigestType)
+{
+	if (DigestType == Digests::None)
+	{
+		throw CryptoProcessingException("BatchStream:Compute", "The digest type can not be none!");
+	}
+
+	ulong ttlLen = 0;
+	std::vector<std::pair<ulong, size_t>> order(InStreams.size());
+
+	for (size_t i = 0; i < InStreams.size(); ++i)
+	{
+		if (InStreams[i] == nullptr)
+		{
+			throw CryptoProcessingException("BatchStream:Compute", "The input streams can not be null!");
+		}
+
+		order[i] = std::make_pair(InStreams[i]->Length() - InStreams[i]->Position(), i);
+		ttlLen += order[i].first;
+	}
+
+	// longest first; a sequential digest can not be split, so the largest streams are started earliest
+	std::stable_sort(order.begin(), order.end(), [](const std::pair<ulong, size_t> &A, const std::pair<ulong, size_t> &B)
+	{
+		return A.first > B.first;
+	});
+
+	const size_t DEGREE = m_isParallel ? IntUtils::Min(ParallelDegree(), IntUtils::Max(InStreams.size(), static_cast<size_t>(1))) : 1;
+	const std::chrono::steady_clock::time_point START = std::chrono::steady_clock::now();
+	std::vector<std::vector<byte>> hashes(InStreams.size());
+	std::atomic<size_t> jobIdx(0);
+	std::atomic<ulong> prcLen(0);
+	std::atomic<bool> isAborted(false);
+	std::exception_ptr excPtr = nullptr;
+	std::mutex excMutex;
+	m_progressInterval = 0;
+
+	std::function<void(size_t)> prcStm = [this, &InStreams, DigestType, &order, &hashes, &jobIdx, &prcLen, &isAborted, &excPtr, &excMutex, ttlLen](size_t Worker)
+	{
+		try
+		{
+			std::unique_ptr<Digest::IDigest> dgt(Helper::DigestFromName::GetInstance(DigestType));
+			std::vector<byte> buf(m_bufferSize);
+
+			while (!isAborted)
+			{
+				const size_t JOBIDX = jobIdx++;
+
+				if (JOBIDX >= order.size())
+				{
+					break;
+				}
+
+				IByteStream* inp = InStreams[order[JOBIDX].second];
+				ulong rmdLen = order[JOBIDX].first;
+
+				while (rmdLen != 0 && !isAborted)
+				{
+					const size_t RDLEN = static_cast<size_t>(IntUtils::Min(static_cast<ulong>(m_bufferSize), rmdLen));
+
+					if (inp->Read(buf, 0, RDLEN) != RDLEN)
+					{
+						throw CryptoProcessingException("BatchStream:Compute", "The input stream is shorter than its length!");
+					}
+
+					dgt->Update(buf, 0, RDLEN);
+					rmdLen -= RDLEN;
+					CalculateProgress(ttlLen, prcLen += RDLEN);
+				}
+
+				std::vector<byte> hash(dgt->DigestSize());
+				dgt->Finalize(hash, 0);
+				hashes[order[JOBIDX].second] = hash;
+			}
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(excMutex);
+
+			if (excPtr == nullptr)
+			{
+				excPtr = std::current_exception();
+			}
+
+			isAborted = true;
+		}
+	};
+
+	if (DEGREE > 1)
+	{
+		Utility::ParallelUtils::ParallelFor(0, DEGREE, prcStm);
+	}
+	else
+	{
+		prcStm(0);
+	}
+
+	if (excPtr != nullptr)
+	{
+		std::rethrow_exception(excPtr);
+	}
+
+	const ulong ELPUSC = static_cast<ulong>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - START).count());
+	m_batchStatistics.Bytes = ttlLen;
+	m_batchStatistics.BytesPerSecond = (ELPUSC != 0) ? static_cast<ulong>((static_cast<double>(ttlLen) * 1000000.0) / ELPUSC) : 0;
+	m_batchStatistics.Degree = DEGREE;
+	m_batchStatistics.Milliseconds = ELPUSC / 1000;
+	m_batchStatistics.Streams = InStreams.size();
+
+	return hashes;
+}
+
+void BatchStream::ParallelMaxDegree(size_t Degree)
+{
+	if (Degree == 0)
+	{
+		throw CryptoProcessingException("BatchStream:ParallelMaxDegree", "The parallel degree can not be zero!");
+	}
+
+	m_parallelDegree = Degree;
+	m_isParallel = (Degree > 1);
+}
+
+void BatchStream::Write(const std::vector<IByteStream*> &InStreams, const std::vector<IByteStream*> &OutStreams, const std::vector<ISymmetricKey*> &Keys)
+{
+	if (InStreams.size() != OutStreams.size() || InStreams.size() != Keys.size())
+	{
+		throw CryptoProcessingException("BatchStream:Write", "There must be an output stream and a key for each input stream!");
+	}
+
+	ulong ttlLen = 0;
+	std::vector<std::unique_ptr<BatchJob>> jobs(0);
+
+	for (size_t i = 0; i < InStreams.size(); ++i)
+	{
+		if (InStreams[i] == nullptr || OutStreams[i] == nullptr || Keys[i] == nullptr)
+		{
+			throw CryptoProcessingException("BatchStream:Write", "The streams and keys can not be null!");
+		}
+
+		Key::Symmetric::SymmetricKeyView kv(*Keys[i]);
+
+		if (!SymmetricKeySize::Contains(m_legalKeySizes, kv.Key().size()) || kv.Nonce().size() != BLOCK_SIZE)
+		{
+			throw CryptoProcessingException("BatchStream:Write", "Invalid key or nonce size! Key must be one of the LegalKeySizes() in length, and the nonce 16 bytes.");
+		}
+
+		// the key is copied once on the calling thread; the workers never touch the callers key, which may not be thread safe (e.g. SymmetricSecureKey),
+		// and the copy is erased when the job is released
+		jobs.push_back(std::unique_ptr<BatchJob>(new BatchJob(InStreams[i], OutStreams[i], new Key::Symmetric::SymmetricKey(kv.Key(), kv.Nonce(), kv.Info()))));
+		ttlLen += jobs.back()->Length;
+	}
+
+	const size_t DEGREE = m_isParallel ? ParallelDegree() : 1;
+	const std::chrono::steady_clock::time_point START = std::chrono::steady_clock::now();
+	std::mutex schMutex;
+	size_t jobIdx = 0;
+	std::atomic<ulong> prcLen(0);
+	std::atomic<bool> isAborted(false);
+	std::exception_ptr excPtr = nullptr;
+	std::mutex excMutex;
+	m_progressInterval = 0;
+
+	std::function<void(size_t)> prcStm = [this, &jobs, &schMutex, &jobIdx, &prcLen, &isAborted, &excPtr, &excMutex, ttlLen](size_t Worker)
+	{
+		try
+		{
+			Cipher::Symmetric::Block::Mode::CTR cpr(m_cipherType);
+			std::vector<byte> inpBuf(m_bufferSize);
+			std::vector<byte> outBuf(m_bufferSize);
+			BatchJob* keyJob = nullptr;
+
+			// the workers supply the parallelism; a slice is processed by a single thread
+			cpr.ParallelProfile().IsParallel() = false;
+
+			while (!isAborted)
+			{
+				BatchJob* job = nullptr;
+
+				{
+					std::lock_guard<std::mutex> lock(schMutex);
+
+					while (jobIdx < jobs.size() && jobs[jobIdx]->IsRead)
+					{
+						++jobIdx;
+					}
+
+					if (jobIdx == jobs.size())
+					{
+						break;
+					}
+
+					job = jobs[jobIdx].get();
+				}
+
+				ulong sliceIdx = 0;
+				size_t sliceLen = 0;
+
+				{
+					// slices are read in order, so the input stream is never seeked
+					std::lock_guard<std::mutex> lock(job->JobMutex);
+
+					if (job->IsRead)
+					{
+						continue;
+					}
+
+					sliceIdx = job->ReadSlice;
+					sliceLen = static_cast<size_t>(IntUtils::Min(static_cast<ulong>(m_bufferSize), job->Length - job->ReadLength));
+
+					if (job->InStream->Read(inpBuf, 0, sliceLen) != sliceLen)
+					{
+						throw CryptoProcessingException("BatchStream:Write", "The input stream is shorter than its length!");
+					}
+
+					++job->ReadSlice;
+					job->ReadLength += sliceLen;
+					job->IsRead = (job->ReadLength == job->Length);
+				}
+
+				if (keyJob != job)
+				{
+					cpr.Initialize(true, *job->KeyParams);
+					keyJob = job;
+				}
+
+				LoadCounter(job->KeyParams->NonceRef(), sliceIdx * (m_bufferSize / BLOCK_SIZE), cpr.Nonce());
+				cpr.Transform(inpBuf, 0, outBuf, 0, sliceLen);
+
+				{
+					// slices are written in order, so the output stream is never seeked
+					std::unique_lock<std::mutex> lock(job->JobMutex);
+					job->WriteTurn.wait(lock, [job, sliceIdx, &isAborted]() { return job->WriteSlice == sliceIdx || isAborted; });
+
+					if (isAborted)
+					{
+						break;
+					}
+
+					job->OutStream->Write(outBuf, 0, sliceLen);
+					++job->WriteSlice;
+				}
+
+				job->WriteTurn.notify_all();
+				CalculateProgress(ttlLen, prcLen += sliceLen);
+			}
+
+			MemUtils::Clear(inpBuf, 0, inpBuf.size());
+		}
+		catch (...)
+		{
+			{
+				std::lock_guard<std::mutex> lock(excMutex);
+
+				if (excPtr == nullptr)
+				{
+					excPtr = std::current_exception();
+				}
+
+				isAborted = true;
+			}
+
+			// release the workers waiting for a slice this worker will not write
+			for (size_t i = 0; i < jobs.size(); ++i)
+			{
+				{
+					std::lock_guard<std::mutex> lock(jobs[i]->JobMutex);
+				}
+
+				jobs[i]->WriteTurn.notify_all();
+			}
+		}
+	};
+
+	if (DEGREE > 1)
+	{
+		Utility::ParallelUtils::ParallelFor(0, DEGREE, prcStm);
+	}
+	else
+	{
+		prcStm(0);
+	}
+
+	if (excPtr != nullptr)
+	{
+		std::rethrow_exception(excPtr);
+	}
+
+	const ulong ELPUSC = static_cast<ulong>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - START).count());
+	m_batchStatistics.Bytes = ttlLen;
+	m_batchStatistics.BytesPerSecond = (ELPUSC != 0) ? static_cast<ulong>((static_cast<double>(ttlLen) * 1000000.0) / ELPUSC) : 0;
+	m_batchStatistics.Degree = DEGREE;
+	m_batchStatistics.Milliseconds = ELPUSC / 1000;
+	m_batchStatistics.Streams = InStreams.size();
+}
+
+//~~~Private Functions~~~//
+
+void BatchStream::CalculateProgress(ulong Length, ulong Processed)
+{
+	if (Length != 0 && Length >= Processed)
+	{
+		const int PRCPCT = static_cast<int>(100.0 * (static_cast<double>(Processed) / Length));
+		std::lock_guard<std::mutex> lock(m_progressMutex);
+
+		// the workers report every slice; the event is raised once for each percent
+		if (PRCPCT > m_progressInterval)
+		{
+			m_progressInterval = PRCPCT;
+			ProgressPercent(PRCPCT);
+		}
+	}
+}
+
+void BatchStream::LoadCounter(const std::vector<byte> &Nonce, ulong Blocks, std::vector<byte> &Counter)
+{
+	// the initial counter plus the block offset of the slice, as a 128bit big endian integer
+	const ulong CTRLO = IntUtils::BeBytesTo64(Nonce, 8);
+	const ulong CTRHI = IntUtils::BeBytesTo64(Nonce, 0);
+	const ulong SUMLO = CTRLO + Blocks;
+
+	IntUtils::Be64ToBytes(CTRHI + ((SUMLO < CTRLO) ? 1 : 0), Counter, 0);
+	IntUtils::Be64ToBytes(SUMLO, Counter, 8);
+}
+
+NAMESPACE_PROCESSINGEND
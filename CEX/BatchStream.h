@@ -0,0 +1,280 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+// Implementation Details:
+// A batch processor that encrypts or hashes many streams concurrently, scheduling whole streams, and the slices of large streams, across a bounded set of worker threads.
+
+#ifndef CEX_BATCHSTREAM_H
+#define CEX_BATCHSTREAM_H
+
+#include "CexDomain.h"
+#include "BlockCiphers.h"
+#include "CryptoProcessingException.h"
+#include "Digests.h"
+#include "Event.h"
+#include "IByteStream.h"
+#include "ISymmetricKey.h"
+#include "SymmetricKeySize.h"
+#include <mutex>
+
+NAMESPACE_PROCESSING
+
+using Enumeration::BlockCiphers;
+using Exception::CryptoProcessingException;
+using Enumeration::Digests;
+using Routing::Event;
+using IO::IByteStream;
+using Key::Symmetric::ISymmetricKey;
+using Key::Symmetric::SymmetricKeySize;
+
+/// <summary>
+/// A concurrent multi-stream encryption and hashing processor.
+/// <para>Takes a list of streams and processes them on a fixed pool of worker threads, with a bounded amount of buffer memory.
+/// Small streams are processed whole, one per worker, and the slices of a large stream are shared between the workers, so the pool is kept busy by a batch of small files as well as by a single large one.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Encrypting a batch of files, each with its own key and nonce:</description>
+/// <code>
+/// std::vector&lt;IByteStream*&gt; inp;
+/// std::vector&lt;IByteStream*&gt; out;
+/// std::vector&lt;ISymmetricKey*&gt; keys;
+/// // ... one entry per file
+///
+/// BatchStream bs(BlockCiphers::Rijndael);
+/// bs.Write(inp, out, keys);
+/// BatchStream::BatchStatistics stats = bs.Statistics();
+/// </code>
+/// </example>
+///
+/// <example>
+/// <description>Hashing a batch of files:</description>
+/// <code>
+/// BatchStream bs;
+/// std::vector&lt;std::vector&lt;byte&gt;&gt; hashes = bs.Compute(inp, Digests::SHA256);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description><B>Encryption:</B></description>
+/// <para>Streams are encrypted with the block cipher in counter mode; the output of each stream is identical to a CTR mode instance initialized with the streams key and nonce,
+/// so encryption and decryption are the same operation. \n
+/// Workers take the streams in order; a worker reads the next BufferSize() slice of the current stream, and the next stream is started when every slice of the current one has been read.
+/// A slice is encrypted with the counter advanced to its offset, and the slices are written to the output stream in order, so neither stream needs to be seekable.
+/// A worker keeps the cipher keyed while it takes slices from the same stream.</para>
+///
+/// <description><B>Hashing:</B></description>
+/// <para>A sequential message digest can not be split without changing its output, so each stream is hashed whole by one worker.
+/// The streams are scheduled longest first, so a large stream is started early and overlaps the smaller ones.
+/// For a large stream that dominates a batch, use a tree hashing digest such as ParallelHash or Blake2 in parallel mode, through the DigestStream class.</para>
+///
+/// <description><B>Implementation Notes:</B></description>
+/// <list type="bullet">
+/// <item><description>Each worker holds an input and an output buffer of BufferSize() bytes; the number of workers is limited so that these buffers never exceed MaxMemory().</description></item>
+/// <item><description>Streams are processed from their current position to their end, and the output streams are written from their current position.</description></item>
+/// <item><description>The ProgressPercent event is raised from the worker threads.</description></item>
+/// <item><description>If a stream fails, the remaining work is abandoned, and the first exception is re-thrown to the caller; the output streams must then be discarded.</description></item>
+/// <item><description>The keys are copied on the calling thread before the workers start, and the copies are erased when the batch completes; a key that is not thread safe, such as a SymmetricSecureKey, can be used.</description></item>
+/// <item><description>A key and nonce must never be used for more than one stream.</description></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>NIST <a href="http://csrc.nist.gov/publications/nistpubs/800-38a/sp800-38a.pdf">SP800-38A</a>.</description></item>
+/// </list>
+/// </remarks>
+class BatchStream
+{
+public:
+
+	/// <summary>
+	/// The counters of the last completed batch
+	/// </summary>
+	struct BatchStatistics
+	{
+		/// <summary>
+		/// The number of bytes processed
+		/// </summary>
+		ulong Bytes;
+		/// <summary>
+		/// The aggregate throughput in bytes per second
+		/// </summary>
+		ulong BytesPerSecond;
+		/// <summary>
+		/// The number of worker threads used
+		/// </summary>
+		size_t Degree;
+		/// <summary>
+		/// The elapsed time in milliseconds
+		/// </summary>
+		ulong Milliseconds;
+		/// <summary>
+		/// The number of streams processed
+		/// </summary>
+		size_t Streams;
+
+		BatchStatistics();
+	};
+
+private:
+
+	struct BatchJob;
+
+	static const std::string CLASS_NAME;
+	static const size_t BLOCK_SIZE = 16;
+
+	BatchStatistics m_batchStatistics;
+	size_t m_bufferSize;
+	BlockCiphers m_cipherType;
+	bool m_isParallel;
+	std::vector<SymmetricKeySize> m_legalKeySizes;
+	size_t m_maxMemory;
+	size_t m_parallelDegree;
+	int m_progressInterval;
+	std::mutex m_progressMutex;
+
+public:
+
+	//~~~Constants~~~//
+
+	/// <summary>
+	/// The default size of a worker buffer in bytes
+	/// </summary>
+	static const size_t DEF_BUFFER = 256 * 1024;
+
+	/// <summary>
+	/// The default buffer memory limit in bytes
+	/// </summary>
+	static const size_t DEF_MEMORY = 64 * 1024 * 1024;
+
+	/// <summary>
+	/// The smallest legal worker buffer size in bytes
+	/// </summary>
+	static const size_t MIN_BUFFER = 1024;
+
+	/// <summary>
+	/// The Progress Percent event
+	/// </summary>
+	Event<int> ProgressPercent;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	BatchStream(const BatchStream&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	BatchStream& operator=(const BatchStream&) = delete;
+
+	/// <summary>
+	/// Initialize this class with the block cipher and memory parameters
+	/// </summary>
+	///
+	/// <param name="CipherType">The block cipher used in counter mode</param>
+	/// <param name="BufferSize">The size of a worker buffer, and of a slice of a large stream; must be a multiple of 16, and at least MIN_BUFFER</param>
+	/// <param name="MaxMemory">The limit on the combined size of the worker buffers; must be at least twice the buffer size</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the cipher, buffer size or memory limit is invalid</exception>
+	explicit BatchStream(BlockCiphers CipherType = BlockCiphers::RHX, size_t BufferSize = DEF_BUFFER, size_t MaxMemory = DEF_MEMORY);
+
+	/// <summary>
+	/// Destroy this class
+	/// </summary>
+	~BatchStream();
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The size of a worker buffer in bytes
+	/// </summary>
+	const size_t BufferSize();
+
+	/// <summary>
+	/// Read/Write: Process the streams on separate threads.
+	/// <para>This value is true if the host has more than one processor; if set to false, the streams are processed one at a time on the calling thread.</para>
+	/// </summary>
+	bool &IsParallel();
+
+	/// <summary>
+	/// Read Only: The legal key sizes; the nonce size is the initial counter size
+	/// </summary>
+	const std::vector<SymmetricKeySize> LegalKeySizes();
+
+	/// <summary>
+	/// Read Only: The limit on the combined size of the worker buffers in bytes
+	/// </summary>
+	const size_t MaxMemory();
+
+	/// <summary>
+	/// Read Only: The number of worker threads; the parallel degree, limited by the memory limit
+	/// </summary>
+	const size_t ParallelDegree();
+
+	/// <summary>
+	/// Read Only: The counters of the last completed batch
+	/// </summary>
+	const BatchStatistics Statistics();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Hash a batch of streams.
+	/// <para>Each stream is hashed from its position to its end; the hashes are returned in the order of the input streams.</para>
+	/// </summary>
+	///
+	/// <param name="InStreams">The streams to hash</param>
+	/// <param name="DigestType">The message digest</param>
+	///
+	/// <returns>The hash of each stream</returns>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if a stream is null, the digest type is invalid, or a stream is shorter than its length</exception>
+	std::vector<std::vector<byte>> Compute(const std::vector<IByteStream*> &InStreams, Digests DigestType);
+
+	/// <summary>
+	/// Set the maximum number of worker threads.
+	/// <para>The number of workers used is also limited by MaxMemory().</para>
+	/// </summary>
+	///
+	/// <param name="Degree">The number of threads; can not be zero</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the degree is zero</exception>
+	void ParallelMaxDegree(size_t Degree);
+
+	/// <summary>
+	/// Encrypt or decrypt a batch of streams.
+	/// <para>Each input stream is transformed from its position to its end, and written to the output stream with the same index.</para>
+	/// </summary>
+	///
+	/// <param name="InStreams">The input streams</param>
+	/// <param name="OutStreams">The output streams; one for each input stream</param>
+	/// <param name="Keys">The key and 16 byte initial counter of each stream</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the lists differ in size, a stream or key is null, a key is invalid, or a stream is shorter than its length</exception>
+	void Write(const std::vector<IByteStream*> &InStreams, const std::vector<IByteStream*> &OutStreams, const std::vector<ISymmetricKey*> &Keys);
+
+private:
+
+	void CalculateProgress(ulong Length, ulong Processed);
+	static void LoadCounter(const std::vector<byte> &Nonce, ulong Blocks, std::vector<byte> &Counter);
+};
+
+NAMESPACE_PROCESSINGEND
+#endif
@@ -82,6 +82,32 @@ private:
 		RH4 = T0;
 	}
 
+	template<typename T>
+	inline static void MixW32(T &A, T &B, T &C, T &D, const T &X, const T &Y)
+	{
+		A += B + X;
+		D = T::RotL32(D ^ A, 16);
+		C += D;
+		B = T::RotL32(B ^ C, 20);
+		A += B + Y;
+		D = T::RotL32(D ^ A, 24);
+		C += D;
+		B = T::RotL32(B ^ C, 25);
+	}
+
+	template<typename T>
+	inline static void MixW64(T &A, T &B, T &C, T &D, const T &X, const T &Y)
+	{
+		A += B + X;
+		D = T::RotL64(D ^ A, 32);
+		C += D;
+		B = T::RotL64(B ^ C, 40);
+		A += B + Y;
+		D = T::RotL64(D ^ A, 48);
+		C += D;
+		B = T::RotL64(B ^ C, 1);
+	}
+
 #endif
 
 public:
@@ -3844,6 +3870,359 @@ public:
 		Output.H[7] ^= R7 ^ R15;
 	}
 
+#endif
+
+#if defined(__AVX__)
+
+	/// <summary>
+	/// Compress one block in each of several leaves at once; the leaf states are transposed so that each SIMD lane holds one leaf.
+	/// <para>T is UInt128, UInt256 or UInt512, compressing 4, 8 or 16 leaves. The blocks are contiguous, leaf n reads the block at InOffset + (n * 64),
+	/// and updates Output[StateOffset + n]. The leaf counters must be incremented by the caller.</para>
+	/// </summary>
+	template <typename T, typename StateArray>
+	inline static void Compress512W(const std::vector<byte> &Input, size_t InOffset, StateArray &Output, size_t StateOffset, const std::vector<uint> &IV)
+	{
+		const size_t LNECNT = sizeof(T) / sizeof(uint);
+		const size_t BLKSZE = 64;
+		std::array<uint, 16 * 16> M;
+		std::array<uint, 12 * 16> S;
+
+		// transpose the message words and state; word w of every leaf is stored contiguously
+		for (size_t i = 0; i < LNECNT; ++i)
+		{
+			for (size_t j = 0; j < 16; ++j)
+			{
+				M[(j * LNECNT) + i] = Utility::IntUtils::LeBytesTo32(Input, InOffset + (i * BLKSZE) + (j * sizeof(uint)));
+			}
+
+			for (size_t j = 0; j < 8; ++j)
+			{
+				S[(j * LNECNT) + i] = Output[StateOffset + i].H[j];
+			}
+
+			S[(8 * LNECNT) + i] = Output[StateOffset + i].T[0];
+			S[(9 * LNECNT) + i] = Output[StateOffset + i].T[1];
+			S[(10 * LNECNT) + i] = Output[StateOffset + i].F[0];
+			S[(11 * LNECNT) + i] = Output[StateOffset + i].F[1];
+		}
+
+		T R[16];
+		T W[16];
+
+		for (size_t i = 0; i < 16; ++i)
+		{
+			W[i] = T(M, i * LNECNT);
+		}
+
+		for (size_t i = 0; i < 8; ++i)
+		{
+			R[i] = T(S, i * LNECNT);
+			R[i + 8] = T(IV[i]);
+		}
+
+		R[12] ^= T(S, 8 * LNECNT);
+		R[13] ^= T(S, 9 * LNECNT);
+		R[14] ^= T(S, 10 * LNECNT);
+		R[15] ^= T(S, 11 * LNECNT);
+
+		// round 0
+		MixW32(R[0], R[4], R[8], R[12], W[0], W[1]);
+		MixW32(R[1], R[5], R[9], R[13], W[2], W[3]);
+		MixW32(R[2], R[6], R[10], R[14], W[4], W[5]);
+		MixW32(R[3], R[7], R[11], R[15], W[6], W[7]);
+		MixW32(R[0], R[5], R[10], R[15], W[8], W[9]);
+		MixW32(R[1], R[6], R[11], R[12], W[10], W[11]);
+		MixW32(R[2], R[7], R[8], R[13], W[12], W[13]);
+		MixW32(R[3], R[4], R[9], R[14], W[14], W[15]);
+
+		// round 1
+		MixW32(R[0], R[4], R[8], R[12], W[14], W[10]);
+		MixW32(R[1], R[5], R[9], R[13], W[4], W[8]);
+		MixW32(R[2], R[6], R[10], R[14], W[9], W[15]);
+		MixW32(R[3], R[7], R[11], R[15], W[13], W[6]);
+		MixW32(R[0], R[5], R[10], R[15], W[1], W[12]);
+		MixW32(R[1], R[6], R[11], R[12], W[0], W[2]);
+		MixW32(R[2], R[7], R[8], R[13], W[11], W[7]);
+		MixW32(R[3], R[4], R[9], R[14], W[5], W[3]);
+
+		// round 2
+		MixW32(R[0], R[4], R[8], R[12], W[11], W[8]);
+		MixW32(R[1], R[5], R[9], R[13], W[12], W[0]);
+		MixW32(R[2], R[6], R[10], R[14], W[5], W[2]);
+		MixW32(R[3], R[7], R[11], R[15], W[15], W[13]);
+		MixW32(R[0], R[5], R[10], R[15], W[10], W[14]);
+		MixW32(R[1], R[6], R[11], R[12], W[3], W[6]);
+		MixW32(R[2], R[7], R[8], R[13], W[7], W[1]);
+		MixW32(R[3], R[4], R[9], R[14], W[9], W[4]);
+
+		// round 3
+		MixW32(R[0], R[4], R[8], R[12], W[7], W[9]);
+		MixW32(R[1], R[5], R[9], R[13], W[3], W[1]);
+		MixW32(R[2], R[6], R[10], R[14], W[13], W[12]);
+		MixW32(R[3], R[7], R[11], R[15], W[11], W[14]);
+		MixW32(R[0], R[5], R[10], R[15], W[2], W[6]);
+		MixW32(R[1], R[6], R[11], R[12], W[5], W[10]);
+		MixW32(R[2], R[7], R[8], R[13], W[4], W[0]);
+		MixW32(R[3], R[4], R[9], R[14], W[15], W[8]);
+
+		// round 4
+		MixW32(R[0], R[4], R[8], R[12], W[9], W[0]);
+		MixW32(R[1], R[5], R[9], R[13], W[5], W[7]);
+		MixW32(R[2], R[6], R[10], R[14], W[2], W[4]);
+		MixW32(R[3], R[7], R[11], R[15], W[10], W[15]);
+		MixW32(R[0], R[5], R[10], R[15], W[14], W[1]);
+		MixW32(R[1], R[6], R[11], R[12], W[11], W[12]);
+		MixW32(R[2], R[7], R[8], R[13], W[6], W[8]);
+		MixW32(R[3], R[4], R[9], R[14], W[3], W[13]);
+
+		// round 5
+		MixW32(R[0], R[4], R[8], R[12], W[2], W[12]);
+		MixW32(R[1], R[5], R[9], R[13], W[6], W[10]);
+		MixW32(R[2], R[6], R[10], R[14], W[0], W[11]);
+		MixW32(R[3], R[7], R[11], R[15], W[8], W[3]);
+		MixW32(R[0], R[5], R[10], R[15], W[4], W[13]);
+		MixW32(R[1], R[6], R[11], R[12], W[7], W[5]);
+		MixW32(R[2], R[7], R[8], R[13], W[15], W[14]);
+		MixW32(R[3], R[4], R[9], R[14], W[1], W[9]);
+
+		// round 6
+		MixW32(R[0], R[4], R[8], R[12], W[12], W[5]);
+		MixW32(R[1], R[5], R[9], R[13], W[1], W[15]);
+		MixW32(R[2], R[6], R[10], R[14], W[14], W[13]);
+		MixW32(R[3], R[7], R[11], R[15], W[4], W[10]);
+		MixW32(R[0], R[5], R[10], R[15], W[0], W[7]);
+		MixW32(R[1], R[6], R[11], R[12], W[6], W[3]);
+		MixW32(R[2], R[7], R[8], R[13], W[9], W[2]);
+		MixW32(R[3], R[4], R[9], R[14], W[8], W[11]);
+
+		// round 7
+		MixW32(R[0], R[4], R[8], R[12], W[13], W[11]);
+		MixW32(R[1], R[5], R[9], R[13], W[7], W[14]);
+		MixW32(R[2], R[6], R[10], R[14], W[12], W[1]);
+		MixW32(R[3], R[7], R[11], R[15], W[3], W[9]);
+		MixW32(R[0], R[5], R[10], R[15], W[5], W[0]);
+		MixW32(R[1], R[6], R[11], R[12], W[15], W[4]);
+		MixW32(R[2], R[7], R[8], R[13], W[8], W[6]);
+		MixW32(R[3], R[4], R[9], R[14], W[2], W[10]);
+
+		// round 8
+		MixW32(R[0], R[4], R[8], R[12], W[6], W[15]);
+		MixW32(R[1], R[5], R[9], R[13], W[14], W[9]);
+		MixW32(R[2], R[6], R[10], R[14], W[11], W[3]);
+		MixW32(R[3], R[7], R[11], R[15], W[0], W[8]);
+		MixW32(R[0], R[5], R[10], R[15], W[12], W[2]);
+		MixW32(R[1], R[6], R[11], R[12], W[13], W[7]);
+		MixW32(R[2], R[7], R[8], R[13], W[1], W[4]);
+		MixW32(R[3], R[4], R[9], R[14], W[10], W[5]);
+
+		// round 9
+		MixW32(R[0], R[4], R[8], R[12], W[10], W[2]);
+		MixW32(R[1], R[5], R[9], R[13], W[8], W[4]);
+		MixW32(R[2], R[6], R[10], R[14], W[7], W[6]);
+		MixW32(R[3], R[7], R[11], R[15], W[1], W[5]);
+		MixW32(R[0], R[5], R[10], R[15], W[15], W[11]);
+		MixW32(R[1], R[6], R[11], R[12], W[9], W[14]);
+		MixW32(R[2], R[7], R[8], R[13], W[3], W[12]);
+		MixW32(R[3], R[4], R[9], R[14], W[13], W[0]);
+
+		for (size_t i = 0; i < 8; ++i)
+		{
+			(T(S, i * LNECNT) ^ R[i] ^ R[i + 8]).Store(S, i * LNECNT);
+		}
+
+		for (size_t i = 0; i < LNECNT; ++i)
+		{
+			for (size_t j = 0; j < 8; ++j)
+			{
+				Output[StateOffset + i].H[j] = S[(j * LNECNT) + i];
+			}
+		}
+	}
+
+	/// <summary>
+	/// Compress one block in each of several leaves at once; the leaf states are transposed so that each SIMD lane holds one leaf.
+	/// <para>T is ULong256 or ULong512, compressing 4 or 8 leaves. The blocks are contiguous, leaf n reads the block at InOffset + (n * 128),
+	/// and updates Output[StateOffset + n]. The leaf counters must be incremented by the caller.</para>
+	/// </summary>
+	template <typename T, typename StateArray>
+	inline static void Compress1024W(const std::vector<byte> &Input, size_t InOffset, StateArray &Output, size_t StateOffset, const std::vector<ulong> &IV)
+	{
+		const size_t LNECNT = sizeof(T) / sizeof(ulong);
+		const size_t BLKSZE = 128;
+		std::array<ulong, 16 * 8> M;
+		std::array<ulong, 12 * 8> S;
+
+		for (size_t i = 0; i < LNECNT; ++i)
+		{
+			for (size_t j = 0; j < 16; ++j)
+			{
+				M[(j * LNECNT) + i] = Utility::IntUtils::LeBytesTo64(Input, InOffset + (i * BLKSZE) + (j * sizeof(ulong)));
+			}
+
+			for (size_t j = 0; j < 8; ++j)
+			{
+				S[(j * LNECNT) + i] = Output[StateOffset + i].H[j];
+			}
+
+			S[(8 * LNECNT) + i] = Output[StateOffset + i].T[0];
+			S[(9 * LNECNT) + i] = Output[StateOffset + i].T[1];
+			S[(10 * LNECNT) + i] = Output[StateOffset + i].F[0];
+			S[(11 * LNECNT) + i] = Output[StateOffset + i].F[1];
+		}
+
+		T R[16];
+		T W[16];
+
+		for (size_t i = 0; i < 16; ++i)
+		{
+			W[i] = T(M, i * LNECNT);
+		}
+
+		for (size_t i = 0; i < 8; ++i)
+		{
+			R[i] = T(S, i * LNECNT);
+			R[i + 8] = T(IV[i]);
+		}
+
+		R[12] ^= T(S, 8 * LNECNT);
+		R[13] ^= T(S, 9 * LNECNT);
+		R[14] ^= T(S, 10 * LNECNT);
+		R[15] ^= T(S, 11 * LNECNT);
+
+		// round 0
+		MixW64(R[0], R[4], R[8], R[12], W[0], W[1]);
+		MixW64(R[1], R[5], R[9], R[13], W[2], W[3]);
+		MixW64(R[2], R[6], R[10], R[14], W[4], W[5]);
+		MixW64(R[3], R[7], R[11], R[15], W[6], W[7]);
+		MixW64(R[0], R[5], R[10], R[15], W[8], W[9]);
+		MixW64(R[1], R[6], R[11], R[12], W[10], W[11]);
+		MixW64(R[2], R[7], R[8], R[13], W[12], W[13]);
+		MixW64(R[3], R[4], R[9], R[14], W[14], W[15]);
+
+		// round 1
+		MixW64(R[0], R[4], R[8], R[12], W[14], W[10]);
+		MixW64(R[1], R[5], R[9], R[13], W[4], W[8]);
+		MixW64(R[2], R[6], R[10], R[14], W[9], W[15]);
+		MixW64(R[3], R[7], R[11], R[15], W[13], W[6]);
+		MixW64(R[0], R[5], R[10], R[15], W[1], W[12]);
+		MixW64(R[1], R[6], R[11], R[12], W[0], W[2]);
+		MixW64(R[2], R[7], R[8], R[13], W[11], W[7]);
+		MixW64(R[3], R[4], R[9], R[14], W[5], W[3]);
+
+		// round 2
+		MixW64(R[0], R[4], R[8], R[12], W[11], W[8]);
+		MixW64(R[1], R[5], R[9], R[13], W[12], W[0]);
+		MixW64(R[2], R[6], R[10], R[14], W[5], W[2]);
+		MixW64(R[3], R[7], R[11], R[15], W[15], W[13]);
+		MixW64(R[0], R[5], R[10], R[15], W[10], W[14]);
+		MixW64(R[1], R[6], R[11], R[12], W[3], W[6]);
+		MixW64(R[2], R[7], R[8], R[13], W[7], W[1]);
+		MixW64(R[3], R[4], R[9], R[14], W[9], W[4]);
+
+		// round 3
+		MixW64(R[0], R[4], R[8], R[12], W[7], W[9]);
+		MixW64(R[1], R[5], R[9], R[13], W[3], W[1]);
+		MixW64(R[2], R[6], R[10], R[14], W[13], W[12]);
+		MixW64(R[3], R[7], R[11], R[15], W[11], W[14]);
+		MixW64(R[0], R[5], R[10], R[15], W[2], W[6]);
+		MixW64(R[1], R[6], R[11], R[12], W[5], W[10]);
+		MixW64(R[2], R[7], R[8], R[13], W[4], W[0]);
+		MixW64(R[3], R[4], R[9], R[14], W[15], W[8]);
+
+		// round 4
+		MixW64(R[0], R[4], R[8], R[12], W[9], W[0]);
+		MixW64(R[1], R[5], R[9], R[13], W[5], W[7]);
+		MixW64(R[2], R[6], R[10], R[14], W[2], W[4]);
+		MixW64(R[3], R[7], R[11], R[15], W[10], W[15]);
+		MixW64(R[0], R[5], R[10], R[15], W[14], W[1]);
+		MixW64(R[1], R[6], R[11], R[12], W[11], W[12]);
+		MixW64(R[2], R[7], R[8], R[13], W[6], W[8]);
+		MixW64(R[3], R[4], R[9], R[14], W[3], W[13]);
+
+		// round 5
+		MixW64(R[0], R[4], R[8], R[12], W[2], W[12]);
+		MixW64(R[1], R[5], R[9], R[13], W[6], W[10]);
+		MixW64(R[2], R[6], R[10], R[14], W[0], W[11]);
+		MixW64(R[3], R[7], R[11], R[15], W[8], W[3]);
+		MixW64(R[0], R[5], R[10], R[15], W[4], W[13]);
+		MixW64(R[1], R[6], R[11], R[12], W[7], W[5]);
+		MixW64(R[2], R[7], R[8], R[13], W[15], W[14]);
+		MixW64(R[3], R[4], R[9], R[14], W[1], W[9]);
+
+		// round 6
+		MixW64(R[0], R[4], R[8], R[12], W[12], W[5]);
+		MixW64(R[1], R[5], R[9], R[13], W[1], W[15]);
+		MixW64(R[2], R[6], R[10], R[14], W[14], W[13]);
+		MixW64(R[3], R[7], R[11], R[15], W[4], W[10]);
+		MixW64(R[0], R[5], R[10], R[15], W[0], W[7]);
+		MixW64(R[1], R[6], R[11], R[12], W[6], W[3]);
+		MixW64(R[2], R[7], R[8], R[13], W[9], W[2]);
+		MixW64(R[3], R[4], R[9], R[14], W[8], W[11]);
+
+		// round 7
+		MixW64(R[0], R[4], R[8], R[12], W[13], W[11]);
+		MixW64(R[1], R[5], R[9], R[13], W[7], W[14]);
+		MixW64(R[2], R[6], R[10], R[14], W[12], W[1]);
+		MixW64(R[3], R[7], R[11], R[15], W[3], W[9]);
+		MixW64(R[0], R[5], R[10], R[15], W[5], W[0]);
+		MixW64(R[1], R[6], R[11], R[12], W[15], W[4]);
+		MixW64(R[2], R[7], R[8], R[13], W[8], W[6]);
+		MixW64(R[3], R[4], R[9], R[14], W[2], W[10]);
+
+		// round 8
+		MixW64(R[0], R[4], R[8], R[12], W[6], W[15]);
+		MixW64(R[1], R[5], R[9], R[13], W[14], W[9]);
+		MixW64(R[2], R[6], R[10], R[14], W[11], W[3]);
+		MixW64(R[3], R[7], R[11], R[15], W[0], W[8]);
+		MixW64(R[0], R[5], R[10], R[15], W[12], W[2]);
+		MixW64(R[1], R[6], R[11], R[12], W[13], W[7]);
+		MixW64(R[2], R[7], R[8], R[13], W[1], W[4]);
+		MixW64(R[3], R[4], R[9], R[14], W[10], W[5]);
+
+		// round 9
+		MixW64(R[0], R[4], R[8], R[12], W[10], W[2]);
+		MixW64(R[1], R[5], R[9], R[13], W[8], W[4]);
+		MixW64(R[2], R[6], R[10], R[14], W[7], W[6]);
+		MixW64(R[3], R[7], R[11], R[15], W[1], W[5]);
+		MixW64(R[0], R[5], R[10], R[15], W[15], W[11]);
+		MixW64(R[1], R[6], R[11], R[12], W[9], W[14]);
+		MixW64(R[2], R[7], R[8], R[13], W[3], W[12]);
+		MixW64(R[3], R[4], R[9], R[14], W[13], W[0]);
+
+		// round 10
+		MixW64(R[0], R[4], R[8], R[12], W[0], W[1]);
+		MixW64(R[1], R[5], R[9], R[13], W[2], W[3]);
+		MixW64(R[2], R[6], R[10], R[14], W[4], W[5]);
+		MixW64(R[3], R[7], R[11], R[15], W[6], W[7]);
+		MixW64(R[0], R[5], R[10], R[15], W[8], W[9]);
+		MixW64(R[1], R[6], R[11], R[12], W[10], W[11]);
+		MixW64(R[2], R[7], R[8], R[13], W[12], W[13]);
+		MixW64(R[3], R[4], R[9], R[14], W[14], W[15]);
+
+		// round 11
+		MixW64(R[0], R[4], R[8], R[12], W[14], W[10]);
+		MixW64(R[1], R[5], R[9], R[13], W[4], W[8]);
+		MixW64(R[2], R[6], R[10], R[14], W[9], W[15]);
+		MixW64(R[3], R[7], R[11], R[15], W[13], W[6]);
+		MixW64(R[0], R[5], R[10], R[15], W[1], W[12]);
+		MixW64(R[1], R[6], R[11], R[12], W[0], W[2]);
+		MixW64(R[2], R[7], R[8], R[13], W[11], W[7]);
+		MixW64(R[3], R[4], R[9], R[14], W[5], W[3]);
+
+		for (size_t i = 0; i < 8; ++i)
+		{
+			(T(S, i * LNECNT) ^ R[i] ^ R[i + 8]).Store(S, i * LNECNT);
+		}
+
+		for (size_t i = 0; i < LNECNT; ++i)
+		{
+			for (size_t j = 0; j < 8; ++j)
+			{
+				Output[StateOffset + i].H[j] = S[(j * LNECNT) + i];
+			}
+		}
+	}
+
 #endif
 };
 
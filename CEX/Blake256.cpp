@@ -1,7 +1,18 @@
 #include "Blake256.h"
 #include "Blake2.h"
 #include "CpuDetect.h"
+#include "Instrumentation.h"
 #include "ParallelUtils.h"
+#include "SymmetricKeyView.h"
+#if defined(__AVX512__)
+#	include "UInt512.h"
+#endif
+#if defined(__AVX2__)
+#	include "UInt256.h"
+#endif
+#if defined(__AVX__)
+#	include "UInt128.h"
+#endif
 
 NAMESPACE_DIGEST
 
@@ -36,24 +47,17 @@ Blake256::Blake256(bool Parallel)
 	m_treeDestroy(true),
 	m_treeParams(Parallel ? BlakeParams(static_cast<byte>(DIGEST_SIZE), 2, DEF_PRLDEGREE, 0, static_cast<byte>(DIGEST_SIZE)) : BlakeParams(static_cast<byte>(DIGEST_SIZE), 1, 1, 0, 0))
 {
-	// TODO: implement parallel alternate for single core cpu
-	if (Parallel && !m_parallelProfile.IsParallel())
+	if (Parallel)
 	{
-		throw CryptoDigestException("Blake256::Ctor", "Cpu does not support parallel processing!");
-	}
-
-	if (m_parallelProfile.IsParallel())
-	{
-		m_parallelProfile.IsParallel() = Parallel;
-	}
-
-	if (m_parallelProfile.IsParallel())
-	{
-		// initialize the leaf nodes 
+		// the leaves are compressed together in simd lanes, so the tree mode does not depend on the processor count
+		m_parallelProfile.SetMaxDegree(m_treeParams.FanOut());
+		m_parallelProfile.IsParallel() = true;
+		// initialize the leaf nodes
 		Reset();
 	}
 	else
 	{
+		m_parallelProfile.IsParallel() = false;
 		LoadState(m_dgtState[0]);
 	}
 }
@@ -71,15 +75,7 @@ Blake256::Blake256(BlakeParams &Params)
 	m_treeDestroy(false),
 	m_treeParams(Params)
 {
-	if (m_treeParams.FanOut() > 1 && !m_parallelProfile.IsParallel())
-	{
-		throw CryptoDigestException("Blake256::Ctor", "Cpu does not support parallel processing!");
-	}
-
-	if (m_parallelProfile.IsParallel())
-	{
-		m_parallelProfile.IsParallel() = m_treeParams.FanOut() > 1;
-	}
+	m_parallelProfile.IsParallel() = m_treeParams.FanOut() > 1;
 
 	if (m_parallelProfile.IsParallel())
 	{
@@ -93,6 +89,7 @@ Blake256::Blake256(BlakeParams &Params)
 		}
 
 		m_leafSize = (Params.LeafLength() == 0) ? DEF_LEAFSIZE : Params.LeafLength();
+		m_parallelProfile.SetMaxDegree(m_treeParams.FanOut());
 		Reset();
 	}
 	else
@@ -187,6 +184,8 @@ void Blake256::Compute(const std::vector<byte> &Input, std::vector<byte> &Output
 
 size_t Blake256::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, 0);
+
 	if (m_parallelProfile.IsParallel())
 	{
 		std::vector<byte> hashCodes(m_treeParams.FanOut() * DIGEST_SIZE);
@@ -284,6 +283,8 @@ size_t Blake256::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 		Compress(m_msgBuffer, m_msgLength - BLOCK_SIZE, m_dgtState[0], BLOCK_SIZE);
 		// output the code
 		IntUtils::LeUL256ToBlock(m_dgtState[0].H, 0, Output, OutOffset);
+		// restore the leaf depth so the instance can be reused
+		m_treeParams.NodeDepth() = 0;
 	}
 	else
 	{
@@ -305,36 +306,38 @@ size_t Blake256::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 
 void Blake256::Initialize(Key::Symmetric::ISymmetricKey &MacKey)
 {
-	if (MacKey.Key().size() < 16 || MacKey.Key().size() > 32)
+	Key::Symmetric::SymmetricKeyView kv(MacKey);
+
+	if (kv.Key().size() < 16 || kv.Key().size() > 32)
 	{
 		throw CryptoDigestException("Blake256::Initialize", "Mac Key has invalid length!");
 	}
 
-	if (MacKey.Nonce().size() != 0)
+	if (kv.Nonce().size() != 0)
 	{
-		if (MacKey.Nonce().size() != 8)
+		if (kv.Nonce().size() != 8)
 		{
 			throw CryptoDigestException("Blake256::Initialize", "Salt has invalid length!");
 		}
 
-		m_treeConfig[4] = IntUtils::LeBytesTo32(MacKey.Nonce(), 0);
-		m_treeConfig[5] = IntUtils::LeBytesTo32(MacKey.Nonce(), 4);
+		m_treeConfig[4] = IntUtils::LeBytesTo32(kv.Nonce(), 0);
+		m_treeConfig[5] = IntUtils::LeBytesTo32(kv.Nonce(), 4);
 	}
 
-	if (MacKey.Info().size() != 0)
+	if (kv.Info().size() != 0)
 	{
-		if (MacKey.Info().size() != 8)
+		if (kv.Info().size() != 8)
 		{
 			throw CryptoDigestException("Blake256::Initialize", "Info has invalid length!");
 		}
 
-		m_treeConfig[6] = IntUtils::LeBytesTo32(MacKey.Info(), 0);
-		m_treeConfig[7] = IntUtils::LeBytesTo32(MacKey.Info(), 4);
+		m_treeConfig[6] = IntUtils::LeBytesTo32(kv.Info(), 0);
+		m_treeConfig[7] = IntUtils::LeBytesTo32(kv.Info(), 4);
 	}
 
 	std::vector<byte> mkey(BLOCK_SIZE, 0);
-	Utility::MemUtils::Copy(MacKey.Key(), 0, mkey, 0, IntUtils::Min(MacKey.Key().size(), mkey.size()));
-	m_treeParams.KeyLength() = static_cast<byte>(MacKey.Key().size());
+	Utility::MemUtils::Copy(kv.Key(), 0, mkey, 0, IntUtils::Min(kv.Key().size(), mkey.size()));
+	m_treeParams.KeyLength() = static_cast<byte>(kv.Key().size());
 
 	if (m_parallelProfile.IsParallel())
 	{
@@ -366,7 +369,7 @@ void Blake256::ParallelMaxDegree(size_t Degree)
 	m_dgtState.clear();
 	m_dgtState.resize(Degree);
 	m_msgBuffer.clear();
-	m_msgBuffer.resize(Degree * BLOCK_SIZE);
+	m_msgBuffer.resize(2 * Degree * BLOCK_SIZE);
 
 	if (Degree > 1 && m_parallelProfile.ProcessorCount() > 1)
 	{
@@ -412,10 +415,14 @@ void Blake256::Update(byte Input)
 
 void Blake256::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, Length);
+
 	if (Length != 0)
 	{
 		if (m_parallelProfile.IsParallel())
 		{
+			CEX_INSTRUMENT_PARALLEL();
+
 			size_t ttlLen = Length + m_msgLength;
 			const size_t PRLMIN = m_msgBuffer.size() + (m_parallelProfile.ParallelMinimumSize() - BLOCK_SIZE);
 
@@ -435,11 +442,7 @@ void Blake256::Update(const std::vector<byte> &Input, size_t InOffset, size_t Le
 				ttlLen -= m_msgBuffer.size();
 
 				// empty the entire message buffer
-				Utility::ParallelUtils::ParallelFor(0, m_treeParams.FanOut(), [this, &Input, InOffset](size_t i)
-				{
-					Compress(m_msgBuffer, i * BLOCK_SIZE, m_dgtState[i], BLOCK_SIZE);
-					Compress(m_msgBuffer, (i * BLOCK_SIZE) + (m_treeParams.FanOut() * BLOCK_SIZE), m_dgtState[i], BLOCK_SIZE);
-				});
+				ProcessLeaves(m_msgBuffer, 0, m_msgBuffer.size());
 
 				// loop in the remainder (no buffering)
 				if (Length > PRLMIN)
@@ -452,10 +455,7 @@ void Blake256::Update(const std::vector<byte> &Input, size_t InOffset, size_t Le
 					}
 
 					// process large blocks
-					Utility::ParallelUtils::ParallelFor(0, m_treeParams.FanOut(), [this, &Input, InOffset, prcLen](size_t i)
-					{
-						ProcessLeaf(Input, InOffset + (i * BLOCK_SIZE), m_dgtState[i], prcLen);
-					});
+					ProcessLeaves(Input, InOffset, prcLen);
 
 					Length -= prcLen;
 					InOffset += prcLen;
@@ -478,10 +478,7 @@ void Blake256::Update(const std::vector<byte> &Input, size_t InOffset, size_t Le
 				m_msgLength = m_msgBuffer.size();
 
 				// process first half of buffer
-				Utility::ParallelUtils::ParallelFor(0, m_treeParams.FanOut(), [this, &Input, InOffset](size_t i)
-				{
-					Compress(m_msgBuffer, i * BLOCK_SIZE, m_dgtState[i], BLOCK_SIZE);
-				});
+				ProcessLeaves(m_msgBuffer, 0, m_parallelProfile.ParallelMinimumSize());
 
 				// left rotate the buffer
 				m_msgLength -= m_parallelProfile.ParallelMinimumSize();
@@ -542,6 +539,43 @@ void Blake256::LoadState(Blake2sState &State)
 	Utility::MemUtils::XOR256(m_treeConfig, 0, State.H, 0);
 }
 
+template<typename T>
+size_t Blake256::ProcessLanes(const std::vector<byte> &Input, size_t InOffset, size_t Length, size_t LeafOffset)
+{
+	const size_t LNECNT = sizeof(T) / sizeof(uint);
+	// each group of leaves is transposed into the lanes of one register; the groups are spread across processor cores
+	const size_t GRPCNT = (m_treeParams.FanOut() - LeafOffset) / LNECNT;
+
+	auto prcGroup = [this, &Input, InOffset, Length, LeafOffset, LNECNT](size_t Group)
+	{
+		const size_t LEAFOFT = LeafOffset + (Group * LNECNT);
+
+		for (size_t i = 0; i < Length; i += m_parallelProfile.ParallelMinimumSize())
+		{
+			for (size_t j = 0; j < LNECNT; ++j)
+			{
+				IntUtils::LeIncreaseW(m_dgtState[LEAFOFT + j].T, m_dgtState[LEAFOFT + j].T, BLOCK_SIZE);
+			}
+
+			Blake2::Compress512W<T>(Input, InOffset + i + (LEAFOFT * BLOCK_SIZE), m_dgtState, LEAFOFT, m_cIV);
+		}
+	};
+
+	if (GRPCNT > 1 && m_parallelProfile.ProcessorCount() > 1)
+	{
+		Utility::ParallelUtils::ParallelFor(0, GRPCNT, prcGroup);
+	}
+	else
+	{
+		for (size_t i = 0; i < GRPCNT; ++i)
+		{
+			prcGroup(i);
+		}
+	}
+
+	return GRPCNT * LNECNT;
+}
+
 void Blake256::ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, Blake2sState &State, ulong Length)
 {
 	do
@@ -553,4 +587,43 @@ void Blake256::ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, Blak
 	while (Length > 0);
 }
 
+void Blake256::ProcessLeaves(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	// leaf n compresses block n of each set of FanOut blocks
+	const size_t LEAFCNT = m_treeParams.FanOut();
+	size_t leafCtr = 0;
+
+	// the leaves fill the widest registers first, the remainder is taken by the narrower registers
+#if defined(__AVX512__)
+	leafCtr += ProcessLanes<Numeric::UInt512>(Input, InOffset, Length, leafCtr);
+#endif
+#if defined(__AVX2__)
+	leafCtr += ProcessLanes<Numeric::UInt256>(Input, InOffset, Length, leafCtr);
+#endif
+#if defined(__AVX__)
+	leafCtr += ProcessLanes<Numeric::UInt128>(Input, InOffset, Length, leafCtr);
+#endif
+
+	// leaves that do not fill a register
+	if (leafCtr != LEAFCNT)
+	{
+		const size_t LEAFOFT = leafCtr;
+
+		if (LEAFCNT - LEAFOFT > 1 && m_parallelProfile.ProcessorCount() > 1)
+		{
+			Utility::ParallelUtils::ParallelFor(0, LEAFCNT - LEAFOFT, [this, &Input, InOffset, Length, LEAFOFT](size_t i)
+			{
+				ProcessLeaf(Input, InOffset + ((LEAFOFT + i) * BLOCK_SIZE), m_dgtState[LEAFOFT + i], Length);
+			});
+		}
+		else
+		{
+			for (size_t i = LEAFOFT; i < LEAFCNT; ++i)
+			{
+				ProcessLeaf(Input, InOffset + (i * BLOCK_SIZE), m_dgtState[i], Length);
+			}
+		}
+	}
+}
+
 NAMESPACE_DIGESTEND
@@ -0,0 +1,805 @@
+#include "Blake3.h"
+#include "Instrumentation.h"
+#include "MemUtils.h"
+#include "ParallelUtils.h"
+#include "SymmetricKeyView.h"
+#if defined(__AVX__)
+#	include "UInt128.h"
+#endif
+#if defined(__AVX2__)
+#	include "UInt256.h"
+#endif
+#if defined(__AVX512__)
+#	include "UInt512.h"
+#endif
+
+NAMESPACE_DIGEST
+
+using Utility::IntUtils;
+using Utility::MemUtils;
+
+const std::array<uint, 8> B3IV =
+{
+	0x6A09E667UL,
+	0xBB67AE85UL,
+	0x3C6EF372UL,
+	0xA54FF53AUL,
+	0x510E527FUL,
+	0x9B05688CUL,
+	0x1F83D9ABUL,
+	0x5BE0CD19UL
+};
+
+const std::string Blake3::CLASS_NAME("Blake3");
+
+//~~~Constructor~~~//
+
+Blake3::Blake3(bool Parallel)
+	:
+	m_chainState(B3IV),
+	m_chunkCounter(0),
+	m_chunkBlocks(0),
+	m_cvStack(MAX_DEPTH * DIGEST_SIZE),
+	m_dgtFlags(0),
+	m_isDestroyed(false),
+	m_keyState(B3IV),
+	m_msgBuffer(BLOCK_SIZE),
+	m_msgLength(0),
+	m_parallelProfile(CHUNK_SIZE, false, STATE_PRECACHED, false, DEF_PRLDEGREE),
+	m_stackLength(0)
+{
+	// the tree is the same in either mode, parallel only enables threading of large subtrees
+	m_parallelProfile.IsParallel() = Parallel && m_parallelProfile.ProcessorCount() > 1;
+}
+
+Blake3::~Blake3()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		IntUtils::ClearArray(m_chainState);
+		IntUtils::ClearArray(m_keyState);
+		IntUtils::ClearVector(m_cvStack);
+		IntUtils::ClearVector(m_msgBuffer);
+		m_chunkBlocks = 0;
+		m_chunkCounter = 0;
+		m_dgtFlags = 0;
+		m_msgLength = 0;
+		m_stackLength = 0;
+		m_parallelProfile.Reset();
+	}
+}
+
+//~~~Accessors~~~//
+
+size_t Blake3::BlockSize()
+{
+	return BLOCK_SIZE;
+}
+
+size_t Blake3::DigestSize()
+{
+	return DIGEST_SIZE;
+}
+
+const Digests Blake3::Enumeral()
+{
+	return Digests::Blake3;
+}
+
+const bool Blake3::IsParallel()
+{
+	return m_parallelProfile.IsParallel();
+}
+
+const std::string Blake3::Name()
+{
+	std::string txtName = "";
+
+	if (m_parallelProfile.IsParallel())
+	{
+		txtName = CLASS_NAME + "-P" + IntUtils::ToString(m_parallelProfile.ParallelMaxDegree());
+	}
+	else
+	{
+		txtName = CLASS_NAME;
+	}
+
+	return txtName;
+}
+
+const size_t Blake3::ParallelBlockSize()
+{
+	return m_parallelProfile.ParallelBlockSize();
+}
+
+ParallelOptions &Blake3::ParallelProfile()
+{
+	return m_parallelProfile;
+}
+
+//~~~Public Functions~~~//
+
+void Blake3::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	Update(Input, 0, Input.size());
+	Finalize(Output, 0);
+}
+
+size_t Blake3::Finalize(std::vector<byte> &Output, const size_t OutOffset)
+{
+	return Finalize(Output, OutOffset, DIGEST_SIZE);
+}
+
+size_t Blake3::Finalize(std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+{
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, 0);
+
+	if (Output.size() - OutOffset < Length)
+	{
+		throw CryptoDigestException("Blake3:Finalize", "The Output buffer is too short!");
+	}
+
+	OutputState state;
+
+	if (m_stackLength == 0)
+	{
+		// the message is a single chunk, which is the root
+		ChunkOutput(state);
+	}
+	else
+	{
+		size_t stkLen;
+
+		if (m_chunkBlocks != 0 || m_msgLength != 0)
+		{
+			stkLen = m_stackLength;
+			ChunkOutput(state);
+		}
+		else
+		{
+			// the message ended on a subtree boundary, the top two chaining values are the last parent
+			stkLen = m_stackLength - 2;
+			ParentOutput(m_cvStack, stkLen * DIGEST_SIZE, state);
+		}
+
+		std::vector<byte> blk(BLOCK_SIZE);
+		std::array<uint, 16> chn;
+
+		// fold the right edge of the tree into the root
+		while (stkLen != 0)
+		{
+			--stkLen;
+			Compress(state.Chain, state.Block, 0, state.Counter, state.Length, state.Flags, chn);
+			MemUtils::Copy(m_cvStack, stkLen * DIGEST_SIZE, blk, 0, DIGEST_SIZE);
+			IntUtils::LeUL256ToBlock(chn, 0, blk, DIGEST_SIZE);
+			ParentOutput(blk, 0, state);
+		}
+	}
+
+	RootOutput(state, Output, OutOffset, Length);
+	Reset();
+
+	return Length;
+}
+
+void Blake3::Initialize(ISymmetricKey &MacKey)
+{
+	Key::Symmetric::SymmetricKeyView kv(MacKey);
+
+	if (kv.Key().size() != KEY_SIZE)
+	{
+		throw CryptoDigestException("Blake3:Initialize", "Mac Key has invalid length!");
+	}
+
+	for (size_t i = 0; i < m_keyState.size(); ++i)
+	{
+		m_keyState[i] = IntUtils::LeBytesTo32(kv.Key(), i * sizeof(uint));
+	}
+
+	m_dgtFlags = KEYED_HASH;
+	Reset();
+}
+
+void Blake3::Initialize(const std::string &Context)
+{
+	std::vector<byte> ctx(Context.begin(), Context.end());
+	std::vector<byte> key(KEY_SIZE);
+
+	// the context string is hashed to the key used for the key material
+	m_keyState = B3IV;
+	m_dgtFlags = DERIVE_KEY_CONTEXT;
+	Reset();
+	Update(ctx, 0, ctx.size());
+	Finalize(key, 0, key.size());
+
+	for (size_t i = 0; i < m_keyState.size(); ++i)
+	{
+		m_keyState[i] = IntUtils::LeBytesTo32(key, i * sizeof(uint));
+	}
+
+	MemUtils::Clear(key, 0, key.size());
+	m_dgtFlags = DERIVE_KEY_MATERIAL;
+	Reset();
+}
+
+void Blake3::ParallelMaxDegree(size_t Degree)
+{
+	CexAssert(Degree != 0, "parallel degree can not be zero");
+	CexAssert(Degree % 2 == 0, "parallel degree must be an even number");
+	CexAssert(Degree <= m_parallelProfile.ProcessorCount(), "parallel degree can not exceed processor count");
+
+	m_parallelProfile.SetMaxDegree(Degree);
+}
+
+void Blake3::Reset()
+{
+	m_chainState = m_keyState;
+	m_chunkBlocks = 0;
+	m_chunkCounter = 0;
+	m_msgLength = 0;
+	m_stackLength = 0;
+	MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	MemUtils::Clear(m_cvStack, 0, m_cvStack.size());
+}
+
+void Blake3::Update(byte Input)
+{
+	std::vector<byte> inp(1, Input);
+	Update(inp, 0, 1);
+}
+
+void Blake3::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, Length);
+
+	CexAssert(Input.size() - InOffset >= Length, "The Output buffer is too short!");
+
+	if (Length == 0)
+	{
+		return;
+	}
+
+	const size_t CNKLEN = (m_chunkBlocks * BLOCK_SIZE) + m_msgLength;
+
+	if (CNKLEN != 0)
+	{
+		// finish the partial chunk
+		const size_t RMDSZE = IntUtils::Min(CHUNK_SIZE - CNKLEN, Length);
+		ChunkUpdate(Input, InOffset, RMDSZE);
+		InOffset += RMDSZE;
+		Length -= RMDSZE;
+
+		if (Length == 0)
+		{
+			return;
+		}
+
+		// the chunk is full and more input follows, so it is not the root
+		OutputState state;
+		std::array<uint, 16> chn;
+		std::vector<byte> cnkCv(DIGEST_SIZE);
+
+		ChunkOutput(state);
+		Compress(state.Chain, state.Block, 0, state.Counter, state.Length, state.Flags, chn);
+		IntUtils::LeUL256ToBlock(chn, 0, cnkCv, 0);
+		PushStack(cnkCv, 0, m_chunkCounter);
+		m_chainState = m_keyState;
+		m_chunkBlocks = 0;
+		m_msgLength = 0;
+		++m_chunkCounter;
+	}
+
+	if (Length > CHUNK_SIZE)
+	{
+		std::vector<byte> subCv(2 * DIGEST_SIZE);
+
+		// the last chunk is always buffered, because it may be the root
+		while (Length > CHUNK_SIZE)
+		{
+			// the largest power of two subtree that fits the input, and is aligned to the chunk counter
+			size_t cnkCnt = 1;
+
+			while ((cnkCnt * 2 * CHUNK_SIZE) <= Length && (cnkCnt * 2 * CHUNK_SIZE) <= MAX_SUBTREE)
+			{
+				cnkCnt *= 2;
+			}
+
+			while (((cnkCnt - 1) & m_chunkCounter) != 0)
+			{
+				cnkCnt /= 2;
+			}
+
+			if (cnkCnt == 1)
+			{
+				HashChunks(Input, InOffset, 1, m_chunkCounter, subCv, 0);
+				PushStack(subCv, 0, m_chunkCounter);
+			}
+			else
+			{
+				// the subtree is reduced to its two child chaining values
+				HashSubtree(Input, InOffset, cnkCnt, m_chunkCounter, subCv);
+				PushStack(subCv, 0, m_chunkCounter);
+				PushStack(subCv, DIGEST_SIZE, m_chunkCounter + (cnkCnt / 2));
+			}
+
+			m_chunkCounter += cnkCnt;
+			InOffset += cnkCnt * CHUNK_SIZE;
+			Length -= cnkCnt * CHUNK_SIZE;
+		}
+	}
+
+	if (Length != 0)
+	{
+		ChunkUpdate(Input, InOffset, Length);
+		MergeStack(m_chunkCounter);
+	}
+}
+
+//~~~Private Functions~~~//
+
+void Blake3::ChunkOutput(OutputState &State)
+{
+	State.Chain = m_chainState;
+	MemUtils::Copy(m_msgBuffer, 0, State.Block, 0, m_msgLength);
+	MemUtils::Clear(State.Block, m_msgLength, BLOCK_SIZE - m_msgLength);
+	State.Counter = m_chunkCounter;
+	State.Length = static_cast<uint>(m_msgLength);
+	State.Flags = m_dgtFlags | CHUNK_END | (m_chunkBlocks == 0 ? CHUNK_START : 0);
+}
+
+void Blake3::ChunkUpdate(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	std::array<uint, 16> chn;
+
+	while (Length != 0)
+	{
+		if (m_msgLength == BLOCK_SIZE)
+		{
+			// a full block is only compressed once more input arrives, the last block of a chunk is flagged
+			Compress(m_chainState, m_msgBuffer, 0, m_chunkCounter, BLOCK_SIZE, m_dgtFlags | (m_chunkBlocks == 0 ? CHUNK_START : 0), chn);
+			MemUtils::Copy(chn, 0, m_chainState, 0, DIGEST_SIZE);
+			++m_chunkBlocks;
+			m_msgLength = 0;
+		}
+
+		const size_t RMDSZE = IntUtils::Min(BLOCK_SIZE - m_msgLength, Length);
+		MemUtils::Copy(Input, InOffset, m_msgBuffer, m_msgLength, RMDSZE);
+		m_msgLength += RMDSZE;
+		InOffset += RMDSZE;
+		Length -= RMDSZE;
+	}
+}
+
+void Blake3::Compress(const std::array<uint, 8> &Chain, const std::vector<byte> &Input, size_t InOffset, ulong Counter, uint Length, uint Flags, std::array<uint, 16> &Output)
+{
+	std::array<uint, 16> R;
+	std::array<uint, 16> W;
+
+	IntUtils::LeBytesToUL512(Input, InOffset, W, 0);
+
+	R[0] = Chain[0];
+	R[1] = Chain[1];
+	R[2] = Chain[2];
+	R[3] = Chain[3];
+	R[4] = Chain[4];
+	R[5] = Chain[5];
+	R[6] = Chain[6];
+	R[7] = Chain[7];
+	R[8] = B3IV[0];
+	R[9] = B3IV[1];
+	R[10] = B3IV[2];
+	R[11] = B3IV[3];
+	R[12] = static_cast<uint>(Counter);
+	R[13] = static_cast<uint>(Counter >> 32);
+	R[14] = Length;
+	R[15] = Flags;
+
+	// round 0
+	Mix(R[0], R[4], R[8], R[12], W[0], W[1]);
+	Mix(R[1], R[5], R[9], R[13], W[2], W[3]);
+	Mix(R[2], R[6], R[10], R[14], W[4], W[5]);
+	Mix(R[3], R[7], R[11], R[15], W[6], W[7]);
+	Mix(R[0], R[5], R[10], R[15], W[8], W[9]);
+	Mix(R[1], R[6], R[11], R[12], W[10], W[11]);
+	Mix(R[2], R[7], R[8], R[13], W[12], W[13]);
+	Mix(R[3], R[4], R[9], R[14], W[14], W[15]);
+
+	// round 1
+	Mix(R[0], R[4], R[8], R[12], W[2], W[6]);
+	Mix(R[1], R[5], R[9], R[13], W[3], W[10]);
+	Mix(R[2], R[6], R[10], R[14], W[7], W[0]);
+	Mix(R[3], R[7], R[11], R[15], W[4], W[13]);
+	Mix(R[0], R[5], R[10], R[15], W[1], W[11]);
+	Mix(R[1], R[6], R[11], R[12], W[12], W[5]);
+	Mix(R[2], R[7], R[8], R[13], W[9], W[14]);
+	Mix(R[3], R[4], R[9], R[14], W[15], W[8]);
+
+	// round 2
+	Mix(R[0], R[4], R[8], R[12], W[3], W[4]);
+	Mix(R[1], R[5], R[9], R[13], W[10], W[12]);
+	Mix(R[2], R[6], R[10], R[14], W[13], W[2]);
+	Mix(R[3], R[7], R[11], R[15], W[7], W[14]);
+	Mix(R[0], R[5], R[10], R[15], W[6], W[5]);
+	Mix(R[1], R[6], R[11], R[12], W[9], W[0]);
+	Mix(R[2], R[7], R[8], R[13], W[11], W[15]);
+	Mix(R[3], R[4], R[9], R[14], W[8], W[1]);
+
+	// round 3
+	Mix(R[0], R[4], R[8], R[12], W[10], W[7]);
+	Mix(R[1], R[5], R[9], R[13], W[12], W[9]);
+	Mix(R[2], R[6], R[10], R[14], W[14], W[3]);
+	Mix(R[3], R[7], R[11], R[15], W[13], W[15]);
+	Mix(R[0], R[5], R[10], R[15], W[4], W[0]);
+	Mix(R[1], R[6], R[11], R[12], W[11], W[2]);
+	Mix(R[2], R[7], R[8], R[13], W[5], W[8]);
+	Mix(R[3], R[4], R[9], R[14], W[1], W[6]);
+
+	// round 4
+	Mix(R[0], R[4], R[8], R[12], W[12], W[13]);
+	Mix(R[1], R[5], R[9], R[13], W[9], W[11]);
+	Mix(R[2], R[6], R[10], R[14], W[15], W[10]);
+	Mix(R[3], R[7], R[11], R[15], W[14], W[8]);
+	Mix(R[0], R[5], R[10], R[15], W[7], W[2]);
+	Mix(R[1], R[6], R[11], R[12], W[5], W[3]);
+	Mix(R[2], R[7], R[8], R[13], W[0], W[1]);
+	Mix(R[3], R[4], R[9], R[14], W[6], W[4]);
+
+	// round 5
+	Mix(R[0], R[4], R[8], R[12], W[9], W[14]);
+	Mix(R[1], R[5], R[9], R[13], W[11], W[5]);
+	Mix(R[2], R[6], R[10], R[14], W[8], W[12]);
+	Mix(R[3], R[7], R[11], R[15], W[15], W[1]);
+	Mix(R[0], R[5], R[10], R[15], W[13], W[3]);
+	Mix(R[1], R[6], R[11], R[12], W[0], W[10]);
+	Mix(R[2], R[7], R[8], R[13], W[2], W[6]);
+	Mix(R[3], R[4], R[9], R[14], W[4], W[7]);
+
+	// round 6
+	Mix(R[0], R[4], R[8], R[12], W[11], W[15]);
+	Mix(R[1], R[5], R[9], R[13], W[5], W[0]);
+	Mix(R[2], R[6], R[10], R[14], W[1], W[9]);
+	Mix(R[3], R[7], R[11], R[15], W[8], W[6]);
+	Mix(R[0], R[5], R[10], R[15], W[14], W[10]);
+	Mix(R[1], R[6], R[11], R[12], W[2], W[12]);
+	Mix(R[2], R[7], R[8], R[13], W[3], W[4]);
+	Mix(R[3], R[4], R[9], R[14], W[7], W[13]);
+
+	// the first half is the chaining value, the full state is the extended output
+	for (size_t i = 0; i < 8; ++i)
+	{
+		Output[i] = R[i] ^ R[i + 8];
+		Output[i + 8] = R[i + 8] ^ Chain[i];
+	}
+}
+
+#if defined(__AVX__)
+template <typename T>
+void Blake3::CompressW(const std::vector<byte> &Input, size_t InOffset, size_t BlockCount, const std::array<uint, 8> &Key, ulong Counter, bool Increment, uint Flags, uint FlagStart, uint FlagEnd, std::vector<byte> &Output, size_t OutOffset)
+{
+	const size_t LNECNT = sizeof(T) / sizeof(uint);
+	const size_t INPSZE = BlockCount * BLOCK_SIZE;
+	std::array<uint, 2 * 16 * 16> M;
+	std::array<uint, 2 * 16> C;
+	T H[8];
+	T R[16];
+	T W[16];
+
+	for (size_t i = 0; i < LNECNT; ++i)
+	{
+		const ulong CTR = Counter + (Increment ? i : 0);
+		C[i] = static_cast<uint>(CTR);
+		C[LNECNT + i] = static_cast<uint>(CTR >> 32);
+	}
+
+	const T CTRL(C, 0);
+	const T CTRH(C, LNECNT);
+
+	for (size_t i = 0; i < 8; ++i)
+	{
+		H[i] = T(Key[i]);
+	}
+
+	// each group of four words of an input is copied to the 128 bit lane and row where the in-lane transpose puts word w of every input in W[w];
+	// the next block is staged while the current one is compressed, so the loads do not stall on the copies
+	auto stgBlk = [&Input, InOffset, INPSZE, LNECNT, &M](size_t Block)
+	{
+		const size_t STGOFT = (Block % 2) * 16 * LNECNT;
+
+		for (size_t j = 0; j < LNECNT; ++j)
+		{
+			const size_t BLKOFT = InOffset + (j * INPSZE) + (Block * BLOCK_SIZE);
+			const size_t LNEOFT = STGOFT + ((j % 4) * LNECNT) + ((j / 4) * 4);
+
+			for (size_t k = 0; k < 4; ++k)
+			{
+				MemUtils::Copy(Input, BLKOFT + (k * 16), M, (k * 4 * LNECNT) + LNEOFT, 16);
+			}
+		}
+	};
+
+	stgBlk(0);
+
+	for (size_t i = 0; i < BlockCount; ++i)
+	{
+		const uint FLGBLK = Flags | (i == 0 ? FlagStart : 0) | (i == BlockCount - 1 ? FlagEnd : 0);
+		const size_t STGOFT = (i % 2) * 16 * LNECNT;
+
+		for (size_t j = 0; j < 16; j += 4)
+		{
+			W[j] = T(M, STGOFT + (j * LNECNT));
+			W[j + 1] = T(M, STGOFT + ((j + 1) * LNECNT));
+			W[j + 2] = T(M, STGOFT + ((j + 2) * LNECNT));
+			W[j + 3] = T(M, STGOFT + ((j + 3) * LNECNT));
+			T::Transpose(W[j], W[j + 1], W[j + 2], W[j + 3]);
+		}
+
+		if (i + 1 != BlockCount)
+		{
+			stgBlk(i + 1);
+		}
+
+		for (size_t j = 0; j < 8; ++j)
+		{
+			R[j] = H[j];
+		}
+
+		R[8] = T(B3IV[0]);
+		R[9] = T(B3IV[1]);
+		R[10] = T(B3IV[2]);
+		R[11] = T(B3IV[3]);
+		R[12] = CTRL;
+		R[13] = CTRH;
+		R[14] = T(static_cast<uint>(BLOCK_SIZE));
+		R[15] = T(FLGBLK);
+
+		// round 0
+		MixW32(R[0], R[4], R[8], R[12], W[0], W[1]);
+		MixW32(R[1], R[5], R[9], R[13], W[2], W[3]);
+		MixW32(R[2], R[6], R[10], R[14], W[4], W[5]);
+		MixW32(R[3], R[7], R[11], R[15], W[6], W[7]);
+		MixW32(R[0], R[5], R[10], R[15], W[8], W[9]);
+		MixW32(R[1], R[6], R[11], R[12], W[10], W[11]);
+		MixW32(R[2], R[7], R[8], R[13], W[12], W[13]);
+		MixW32(R[3], R[4], R[9], R[14], W[14], W[15]);
+
+		// round 1
+		MixW32(R[0], R[4], R[8], R[12], W[2], W[6]);
+		MixW32(R[1], R[5], R[9], R[13], W[3], W[10]);
+		MixW32(R[2], R[6], R[10], R[14], W[7], W[0]);
+		MixW32(R[3], R[7], R[11], R[15], W[4], W[13]);
+		MixW32(R[0], R[5], R[10], R[15], W[1], W[11]);
+		MixW32(R[1], R[6], R[11], R[12], W[12], W[5]);
+		MixW32(R[2], R[7], R[8], R[13], W[9], W[14]);
+		MixW32(R[3], R[4], R[9], R[14], W[15], W[8]);
+
+		// round 2
+		MixW32(R[0], R[4], R[8], R[12], W[3], W[4]);
+		MixW32(R[1], R[5], R[9], R[13], W[10], W[12]);
+		MixW32(R[2], R[6], R[10], R[14], W[13], W[2]);
+		MixW32(R[3], R[7], R[11], R[15], W[7], W[14]);
+		MixW32(R[0], R[5], R[10], R[15], W[6], W[5]);
+		MixW32(R[1], R[6], R[11], R[12], W[9], W[0]);
+		MixW32(R[2], R[7], R[8], R[13], W[11], W[15]);
+		MixW32(R[3], R[4], R[9], R[14], W[8], W[1]);
+
+		// round 3
+		MixW32(R[0], R[4], R[8], R[12], W[10], W[7]);
+		MixW32(R[1], R[5], R[9], R[13], W[12], W[9]);
+		MixW32(R[2], R[6], R[10], R[14], W[14], W[3]);
+		MixW32(R[3], R[7], R[11], R[15], W[13], W[15]);
+		MixW32(R[0], R[5], R[10], R[15], W[4], W[0]);
+		MixW32(R[1], R[6], R[11], R[12], W[11], W[2]);
+		MixW32(R[2], R[7], R[8], R[13], W[5], W[8]);
+		MixW32(R[3], R[4], R[9], R[14], W[1], W[6]);
+
+		// round 4
+		MixW32(R[0], R[4], R[8], R[12], W[12], W[13]);
+		MixW32(R[1], R[5], R[9], R[13], W[9], W[11]);
+		MixW32(R[2], R[6], R[10], R[14], W[15], W[10]);
+		MixW32(R[3], R[7], R[11], R[15], W[14], W[8]);
+		MixW32(R[0], R[5], R[10], R[15], W[7], W[2]);
+		MixW32(R[1], R[6], R[11], R[12], W[5], W[3]);
+		MixW32(R[2], R[7], R[8], R[13], W[0], W[1]);
+		MixW32(R[3], R[4], R[9], R[14], W[6], W[4]);
+
+		// round 5
+		MixW32(R[0], R[4], R[8], R[12], W[9], W[14]);
+		MixW32(R[1], R[5], R[9], R[13], W[11], W[5]);
+		MixW32(R[2], R[6], R[10], R[14], W[8], W[12]);
+		MixW32(R[3], R[7], R[11], R[15], W[15], W[1]);
+		MixW32(R[0], R[5], R[10], R[15], W[13], W[3]);
+		MixW32(R[1], R[6], R[11], R[12], W[0], W[10]);
+		MixW32(R[2], R[7], R[8], R[13], W[2], W[6]);
+		MixW32(R[3], R[4], R[9], R[14], W[4], W[7]);
+
+		// round 6
+		MixW32(R[0], R[4], R[8], R[12], W[11], W[15]);
+		MixW32(R[1], R[5], R[9], R[13], W[5], W[0]);
+		MixW32(R[2], R[6], R[10], R[14], W[1], W[9]);
+		MixW32(R[3], R[7], R[11], R[15], W[8], W[6]);
+		MixW32(R[0], R[5], R[10], R[15], W[14], W[10]);
+		MixW32(R[1], R[6], R[11], R[12], W[2], W[12]);
+		MixW32(R[2], R[7], R[8], R[13], W[3], W[4]);
+		MixW32(R[3], R[4], R[9], R[14], W[7], W[13]);
+
+		for (size_t j = 0; j < 8; ++j)
+		{
+			H[j] = R[j] ^ R[j + 8];
+		}
+	}
+
+	// store the chaining values back in input order
+	for (size_t i = 0; i < 8; ++i)
+	{
+		H[i].Store(M, i * LNECNT);
+	}
+
+	for (size_t i = 0; i < LNECNT; ++i)
+	{
+		for (size_t j = 0; j < 8; ++j)
+		{
+			IntUtils::Le32ToBytes(M[(j * LNECNT) + i], Output, OutOffset + (i * DIGEST_SIZE) + (j * sizeof(uint)));
+		}
+	}
+}
+#endif
+
+void Blake3::HashChunks(const std::vector<byte> &Input, size_t InOffset, size_t ChunkCount, ulong Counter, std::vector<byte> &Output, size_t OutOffset)
+{
+	const size_t PRLDGR = m_parallelProfile.ParallelMaxDegree();
+
+	if (m_parallelProfile.IsParallel() && ChunkCount * CHUNK_SIZE >= m_parallelProfile.ParallelMinimumSize() && ChunkCount >= PRLDGR)
+	{
+		CEX_INSTRUMENT_PARALLEL();
+
+		// each thread hashes a contiguous range of chunks
+		const size_t CNKCNT = ChunkCount / PRLDGR;
+
+		Utility::ParallelUtils::ParallelFor(0, PRLDGR, [this, &Input, InOffset, ChunkCount, Counter, &Output, OutOffset, CNKCNT, PRLDGR](size_t i)
+		{
+			const size_t THDCNT = (i == PRLDGR - 1) ? ChunkCount - (i * CNKCNT) : CNKCNT;
+			HashMany(Input, InOffset + (i * CNKCNT * CHUNK_SIZE), CHUNK_SIZE / BLOCK_SIZE, THDCNT, Counter + (i * CNKCNT), true, m_dgtFlags, CHUNK_START, CHUNK_END, Output, OutOffset + (i * CNKCNT * DIGEST_SIZE));
+		});
+	}
+	else
+	{
+		HashMany(Input, InOffset, CHUNK_SIZE / BLOCK_SIZE, ChunkCount, Counter, true, m_dgtFlags, CHUNK_START, CHUNK_END, Output, OutOffset);
+	}
+}
+
+void Blake3::HashMany(const std::vector<byte> &Input, size_t InOffset, size_t BlockCount, size_t Count, ulong Counter, bool Increment, uint Flags, uint FlagStart, uint FlagEnd, std::vector<byte> &Output, size_t OutOffset)
+{
+	const size_t INPSZE = BlockCount * BLOCK_SIZE;
+
+#if defined(__AVX512__)
+	while (Count >= 16)
+	{
+		CompressW<Numeric::UInt512>(Input, InOffset, BlockCount, m_keyState, Counter, Increment, Flags, FlagStart, FlagEnd, Output, OutOffset);
+		InOffset += 16 * INPSZE;
+		OutOffset += 16 * DIGEST_SIZE;
+		Counter += Increment ? 16 : 0;
+		Count -= 16;
+	}
+#endif
+#if defined(__AVX2__)
+	while (Count >= 8)
+	{
+		CompressW<Numeric::UInt256>(Input, InOffset, BlockCount, m_keyState, Counter, Increment, Flags, FlagStart, FlagEnd, Output, OutOffset);
+		InOffset += 8 * INPSZE;
+		OutOffset += 8 * DIGEST_SIZE;
+		Counter += Increment ? 8 : 0;
+		Count -= 8;
+	}
+#endif
+#if defined(__AVX__)
+	while (Count >= 4)
+	{
+		CompressW<Numeric::UInt128>(Input, InOffset, BlockCount, m_keyState, Counter, Increment, Flags, FlagStart, FlagEnd, Output, OutOffset);
+		InOffset += 4 * INPSZE;
+		OutOffset += 4 * DIGEST_SIZE;
+		Counter += Increment ? 4 : 0;
+		Count -= 4;
+	}
+#endif
+
+	std::array<uint, 8> chn;
+	std::array<uint, 16> otp;
+
+	while (Count != 0)
+	{
+		chn = m_keyState;
+
+		for (size_t i = 0; i < BlockCount; ++i)
+		{
+			const uint FLGBLK = Flags | (i == 0 ? FlagStart : 0) | (i == BlockCount - 1 ? FlagEnd : 0);
+			Compress(chn, Input, InOffset + (i * BLOCK_SIZE), Counter, BLOCK_SIZE, FLGBLK, otp);
+			MemUtils::Copy(otp, 0, chn, 0, DIGEST_SIZE);
+		}
+
+		IntUtils::LeUL256ToBlock(chn, 0, Output, OutOffset);
+		InOffset += INPSZE;
+		OutOffset += DIGEST_SIZE;
+		Counter += Increment ? 1 : 0;
+		--Count;
+	}
+}
+
+void Blake3::HashSubtree(const std::vector<byte> &Input, size_t InOffset, size_t ChunkCount, ulong Counter, std::vector<byte> &Output)
+{
+	std::vector<byte> cvs(ChunkCount * DIGEST_SIZE);
+	size_t cvsCnt = ChunkCount;
+
+	HashChunks(Input, InOffset, ChunkCount, Counter, cvs, 0);
+
+	// each level of parents is compressed in lanes, and written over the level below it
+	while (cvsCnt > 2)
+	{
+		HashMany(cvs, 0, 1, cvsCnt / 2, 0, false, m_dgtFlags | PARENT, 0, 0, cvs, 0);
+		cvsCnt /= 2;
+	}
+
+	MemUtils::Copy(cvs, 0, Output, 0, 2 * DIGEST_SIZE);
+}
+
+void Blake3::MergeStack(ulong ChunkCount)
+{
+	// the stack holds one chaining value for each set bit in the chunk count
+	size_t bitCnt = 0;
+	std::array<uint, 16> chn;
+
+	while (ChunkCount != 0)
+	{
+		bitCnt += static_cast<size_t>(ChunkCount & 1);
+		ChunkCount >>= 1;
+	}
+
+	while (m_stackLength > bitCnt)
+	{
+		const size_t STKOFT = (m_stackLength - 2) * DIGEST_SIZE;
+		Compress(m_keyState, m_cvStack, STKOFT, 0, BLOCK_SIZE, m_dgtFlags | PARENT, chn);
+		IntUtils::LeUL256ToBlock(chn, 0, m_cvStack, STKOFT);
+		MemUtils::Clear(m_cvStack, STKOFT + DIGEST_SIZE, DIGEST_SIZE);
+		--m_stackLength;
+	}
+}
+
+void Blake3::ParentOutput(const std::vector<byte> &Input, size_t InOffset, OutputState &State)
+{
+	State.Chain = m_keyState;
+	MemUtils::Copy(Input, InOffset, State.Block, 0, BLOCK_SIZE);
+	State.Counter = 0;
+	State.Length = static_cast<uint>(BLOCK_SIZE);
+	State.Flags = m_dgtFlags | PARENT;
+}
+
+void Blake3::PushStack(const std::vector<byte> &Chain, size_t ChainOffset, ulong ChunkCount)
+{
+	// merging is deferred until the next chaining value arrives, so the last one can still become the root
+	MergeStack(ChunkCount);
+	MemUtils::Copy(Chain, ChainOffset, m_cvStack, m_stackLength * DIGEST_SIZE, DIGEST_SIZE);
+	++m_stackLength;
+}
+
+void Blake3::RootOutput(OutputState &State, std::vector<byte> &Output, size_t OutOffset, size_t Length)
+{
+	std::array<uint, 16> otp;
+	std::vector<byte> blk(BLOCK_SIZE);
+	ulong ctr = 0;
+
+	// the extended output is the full state of the root compression, with the counter as the output block index
+	while (Length != 0)
+	{
+		const size_t RMDSZE = IntUtils::Min(BLOCK_SIZE, Length);
+		Compress(State.Chain, State.Block, 0, ctr, State.Length, State.Flags | ROOT, otp);
+		IntUtils::LeToBlock(otp, 0, blk, 0, BLOCK_SIZE);
+		MemUtils::Copy(blk, 0, Output, OutOffset, RMDSZE);
+		OutOffset += RMDSZE;
+		Length -= RMDSZE;
+		++ctr;
+	}
+
+	MemUtils::Clear(blk, 0, blk.size());
+}
+
+NAMESPACE_DIGESTEND
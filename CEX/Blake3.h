@@ -0,0 +1,342 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Principal Algorithms:
+// An implementation of BLAKE3, designed by Jack O'Connor, Jean-Philippe Aumasson, Samuel Neves, and Zooko Wilcox-O'Hearn.
+// BLAKE3 specification <a href="https://github.com/BLAKE3-team/BLAKE3-specs/blob/master/blake3.pdf">BLAKE3: one function, fast everywhere</a>.
+//
+// Implementation Details:
+// An implementation of the BLAKE3 digest with a 256 bit default output size, and an extendable output function.
+// Based on the BLAKE3 reference implementation and the C implementation by the BLAKE3 team.
+// BLAKE3: https://github.com/BLAKE3-team/BLAKE3
+//
+// Contact: develop@vtdev.com
+
+#ifndef CEX_BLAKE3_H
+#define CEX_BLAKE3_H
+
+#include "IDigest.h"
+#include "IntUtils.h"
+#include "ISymmetricKey.h"
+
+NAMESPACE_DIGEST
+
+using Key::Symmetric::ISymmetricKey;
+
+/// <summary>
+/// An implementation of the BLAKE3 digest with a 256 bit default output size, and an extendable output function
+/// </summary>
+///
+/// <example>
+/// <description>Example using the Compute method:</description>
+/// <code>
+/// Blake3 dgt;
+/// std:vector&lt;byte&gt; hash(dgt.DigestSize(), 0);
+/// // compute a hash
+/// dgt.Compute(input, hash);
+/// </code>
+/// </example>
+///
+/// <example>
+/// <description>Example of a keyed hash with an extended output:</description>
+/// <code>
+/// Blake3 dgt;
+/// SymmetricKey kp(key);
+/// std:vector&lt;byte&gt; code(128, 0);
+/// dgt.Initialize(kp);
+/// dgt.Update(input, 0, input.size());
+/// dgt.Finalize(code, 0, code.size());
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The message is split into 1024 byte chunks, which form the leaves of a binary Merkle tree; the tree grows with the message, so there is no fixed fan-out or leaf count.</description></item>
+/// <item><description>Unlike Blake2SP, the output does not depend on the parallel settings; sequential and parallel instances produce the same digest.</description></item>
+/// <item><description>Whole chunks are compressed 4, 8, or 16 at a time in the lanes of the UInt128, UInt256, or UInt512 wrappers, depending on the instruction set the library is compiled with.</description></item>
+/// <item><description>In parallel mode, a subtree passed to the Update function that is at least ParallelMinimumSize() bytes is split across ParallelMaxDegree() threads.</description></item>
+/// <item><description>The keyed mode is selected with Initialize(ISymmetricKey), the key must be 32 bytes; the key derivation mode is selected with Initialize(std::string).</description></item>
+/// <item><description>Digest output size is 32 bytes, (256 bits); the Finalize(std::vector&lt;byte&gt;, size_t, size_t) overload returns an output of any length.</description></item>
+/// <item><description>The Finalize methods reset the message state, but keep the key and mode set by Initialize.</description></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>BLAKE3 on <a href="https://github.com/BLAKE3-team/BLAKE3">Github</a>.</description></item>
+/// <item><description>BLAKE3 specification <a href="https://github.com/BLAKE3-team/BLAKE3-specs/blob/master/blake3.pdf">BLAKE3: one function, fast everywhere</a>.</description></item>
+/// <item><description>Blake2 whitepaper <a href="https://blake2.net/blake2.pdf">BLAKE2: simpler, smaller, fast as MD5</a>.</description></item>
+/// </list>
+/// </remarks>
+class Blake3 final : public IDigest
+{
+private:
+
+	static const size_t BLOCK_SIZE = 64;
+	static const size_t CHUNK_SIZE = 1024;
+	static const std::string CLASS_NAME;
+	static const size_t DEF_PRLDEGREE = 8;
+	static const size_t DIGEST_SIZE = 32;
+	static const size_t KEY_SIZE = 32;
+	// the height of a tree with 2^64 bytes of message
+	static const size_t MAX_DEPTH = 54;
+	// the largest subtree hashed in a single pass, bounds the size of the chaining value buffer
+	static const size_t MAX_SUBTREE = 16777216;
+	// size of reserved state buffer subtracted from parallel size calculations
+	static const size_t STATE_PRECACHED = 2048;
+
+	static const uint CHUNK_START = 1;
+	static const uint CHUNK_END = 2;
+	static const uint PARENT = 4;
+	static const uint ROOT = 8;
+	static const uint KEYED_HASH = 16;
+	static const uint DERIVE_KEY_CONTEXT = 32;
+	static const uint DERIVE_KEY_MATERIAL = 64;
+
+	struct OutputState
+	{
+		std::array<uint, 8> Chain;
+		std::vector<byte> Block;
+		ulong Counter;
+		uint Flags;
+		uint Length;
+
+		OutputState()
+			:
+			Block(BLOCK_SIZE),
+			Counter(0),
+			Flags(0),
+			Length(0)
+		{
+			std::memset(&Chain[0], 0, Chain.size() * sizeof(uint));
+		}
+	};
+
+	std::array<uint, 8> m_chainState;
+	ulong m_chunkCounter;
+	size_t m_chunkBlocks;
+	std::vector<byte> m_cvStack;
+	uint m_dgtFlags;
+	bool m_isDestroyed;
+	std::array<uint, 8> m_keyState;
+	std::vector<byte> m_msgBuffer;
+	size_t m_msgLength;
+	ParallelOptions m_parallelProfile;
+	size_t m_stackLength;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	Blake3(const Blake3&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	Blake3& operator=(const Blake3&) = delete;
+
+	/// <summary>
+	/// Initialize the digest
+	/// </summary>
+	///
+	/// <param name="Parallel">Setting the Parallel flag to true, enables multi-threaded subtree hashing; the digest output is the same in either mode.</param>
+	explicit Blake3(bool Parallel = false);
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~Blake3() override;
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The Digests internal blocksize in bytes
+	/// </summary>
+	size_t BlockSize() override;
+
+	/// <summary>
+	/// Read Only: Size of returned digest in bytes
+	/// </summary>
+	size_t DigestSize() override;
+
+	/// <summary>
+	/// Read Only: The digests type name
+	/// </summary>
+	const Digests Enumeral() override;
+
+	/// <summary>
+	/// Read Only: Processor parallelization availability.
+	/// <para>Indicates whether parallel processing is available on this system.
+	/// If parallel capable, input data array passed to the Update function must be ParallelMinimumSize in bytes to trigger parallelization.</para>
+	/// </summary>
+	const bool IsParallel() override;
+
+	/// <summary>
+	/// Read Only: The digests class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Read Only: Parallel block size; the byte-size of the input data array passed to the Update function that triggers parallel processing.
+	/// <para>This value can be changed through the ParallelProfile class.</para>
+	/// </summary>
+	const size_t ParallelBlockSize() override;
+
+	/// <summary>
+	/// Read/Write: Contains parallel settings and SIMD capability flags in a ParallelOptions structure.
+	/// <para>The maximum number of threads allocated when using multi-threaded processing can be set with the ParallelMaxDegree(size_t) function.</para>
+	/// </summary>
+	ParallelOptions &ParallelProfile() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Process the message data and return the Hash value
+	/// </summary>
+	///
+	/// <param name="Input">The message input data</param>
+	/// <param name="Output">The hash value output array</param>
+	void Compute(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Perform final processing and return the 32 byte hash value
+	/// </summary>
+	///
+	/// <param name="Output">The Hash output value array</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	///
+	/// <returns>Size of Hash value</returns>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the output buffer is too short</exception>
+	size_t Finalize(std::vector<byte> &Output, const size_t OutOffset) override;
+
+	/// <summary>
+	/// Perform final processing and return an extended output of any length
+	/// </summary>
+	///
+	/// <param name="Output">The output array</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	/// <param name="Length">The number of bytes to write</param>
+	///
+	/// <returns>The number of bytes written</returns>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the output buffer is too short</exception>
+	size_t Finalize(std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
+
+	/// <summary>
+	/// Initialize the digest in the keyed hashing mode, as a MAC code generator
+	/// </summary>
+	///
+	/// <param name="MacKey">The input key parameters; the Key must be 32 bytes, the Nonce and Info parameters are not used</param>
+	///
+	/// <exception cref="Exception::CryptoDigestException">Thrown if an invalid key size is used</exception>
+	void Initialize(ISymmetricKey &MacKey);
+
+	/// <summary>
+	/// Initialize the digest in the key derivation mode.
+	/// <para>The context string should be hardcoded, globally unique, and application specific; the key material is then added with the Update function.</para>
+	/// </summary>
+	///
+	/// <param name="Context">The key derivation context string</param>
+	void Initialize(const std::string &Context);
+
+	/// <summary>
+	/// Set the number of threads allocated when using multi-threaded subtree hashing.
+	/// <para>Thread count must be an even number, and not exceed the number of processor cores.
+	/// The thread count does not change the digest output.</para>
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	void ParallelMaxDegree(size_t Degree) override;
+
+	/// <summary>
+	/// Reset the message state; the key and mode are retained
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Update the message digest with a single byte
+	/// </summary>
+	///
+	/// <param name="Input">Input message byte</param>
+	void Update(byte Input) override;
+
+	/// <summary>
+	/// Update the message buffer
+	/// </summary>
+	///
+	/// <remarks>
+	/// <para>For best performance, use input lengths that are a multiple of the 1024 byte chunk size;
+	/// whole chunks are compressed in SIMD lanes, and large inputs are hashed as subtrees without passing through the message buffer.</para>
+	/// </remarks>
+	///
+	/// <param name="Input">The Input message data</param>
+	/// <param name="InOffset">The starting offset within the Input array</param>
+	/// <param name="Length">The amount of data to process in bytes</param>
+	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
+
+private:
+
+	inline static void Mix(uint &A, uint &B, uint &C, uint &D, uint X, uint Y)
+	{
+		A += B + X;
+		D = Utility::IntUtils::RotR32(D ^ A, 16);
+		C += D;
+		B = Utility::IntUtils::RotR32(B ^ C, 12);
+		A += B + Y;
+		D = Utility::IntUtils::RotR32(D ^ A, 8);
+		C += D;
+		B = Utility::IntUtils::RotR32(B ^ C, 7);
+	}
+
+#if defined(__AVX__)
+	template<typename T>
+	inline static void MixW32(T &A, T &B, T &C, T &D, const T &X, const T &Y)
+	{
+		A += B + X;
+		D = T::RotL32(D ^ A, 16);
+		C += D;
+		B = T::RotL32(B ^ C, 20);
+		A += B + Y;
+		D = T::RotL32(D ^ A, 24);
+		C += D;
+		B = T::RotL32(B ^ C, 25);
+	}
+
+	template <typename T>
+	static void CompressW(const std::vector<byte> &Input, size_t InOffset, size_t BlockCount, const std::array<uint, 8> &Key, ulong Counter, bool Increment, uint Flags, uint FlagStart, uint FlagEnd, std::vector<byte> &Output, size_t OutOffset);
+#endif
+
+	void ChunkOutput(OutputState &State);
+	void ChunkUpdate(const std::vector<byte> &Input, size_t InOffset, size_t Length);
+	static void Compress(const std::array<uint, 8> &Chain, const std::vector<byte> &Input, size_t InOffset, ulong Counter, uint Length, uint Flags, std::array<uint, 16> &Output);
+	void HashChunks(const std::vector<byte> &Input, size_t InOffset, size_t ChunkCount, ulong Counter, std::vector<byte> &Output, size_t OutOffset);
+	void HashMany(const std::vector<byte> &Input, size_t InOffset, size_t BlockCount, size_t Count, ulong Counter, bool Increment, uint Flags, uint FlagStart, uint FlagEnd, std::vector<byte> &Output, size_t OutOffset);
+	void HashSubtree(const std::vector<byte> &Input, size_t InOffset, size_t ChunkCount, ulong Counter, std::vector<byte> &Output);
+	void MergeStack(ulong ChunkCount);
+	void ParentOutput(const std::vector<byte> &Input, size_t InOffset, OutputState &State);
+	void PushStack(const std::vector<byte> &Chain, size_t ChainOffset, ulong ChunkCount);
+	void RootOutput(OutputState &State, std::vector<byte> &Output, size_t OutOffset, size_t Length);
+};
+
+NAMESPACE_DIGESTEND
+#endif
@@ -1,7 +1,15 @@
 #include "Blake512.h"
 #include "Blake2.h"
 #include "CpuDetect.h"
+#include "Instrumentation.h"
 #include "ParallelUtils.h"
+#include "SymmetricKeyView.h"
+#if defined(__AVX512__)
+#	include "ULong512.h"
+#endif
+#if defined(__AVX2__)
+#	include "ULong256.h"
+#endif
 
 NAMESPACE_DIGEST
 
@@ -36,25 +44,17 @@ Blake512::Blake512(bool Parallel)
 	m_treeDestroy(true),
 	m_treeParams(Parallel ? BlakeParams(static_cast<byte>(DIGEST_SIZE), 2, DEF_PRLDEGREE, 0, static_cast<byte>(DIGEST_SIZE)) : BlakeParams(static_cast<byte>(DIGEST_SIZE), 1, 1, 0, 0))
 {
-	// TODO: implement parallel alternate for single core cpu
-	if (Parallel && !m_parallelProfile.IsParallel())
+	if (Parallel)
 	{
-		throw CryptoDigestException("Blake512::Ctor", "Cpu does not support parallel processing!");
-	}
-
-	if (m_parallelProfile.IsParallel())
-	{
-		m_parallelProfile.IsParallel() = Parallel;
-	}
-
-	if (m_parallelProfile.IsParallel())
-	{
-		m_parallelProfile.IsParallel() = Parallel;
+		// the leaves are compressed together in simd lanes, so the tree mode does not depend on the processor count
+		m_parallelProfile.SetMaxDegree(m_treeParams.FanOut());
+		m_parallelProfile.IsParallel() = true;
 		// initialize the leaf nodes
 		Reset();
 	}
 	else
 	{
+		m_parallelProfile.IsParallel() = false;
 		LoadState(m_dgtState[0]);
 	}
 }
@@ -72,15 +72,7 @@ Blake512::Blake512(BlakeParams &Params)
 	m_treeDestroy(false),
 	m_treeParams(Params)
 {
-	if (m_treeParams.FanOut() > 1 && !m_parallelProfile.IsParallel())
-	{
-		throw CryptoDigestException("Blake512::Ctor", "Cpu does not support parallel processing!");
-	}
-
-	if (m_parallelProfile.IsParallel())
-	{
-		m_parallelProfile.IsParallel() = m_treeParams.FanOut() > 1;
-	}
+	m_parallelProfile.IsParallel() = m_treeParams.FanOut() > 1;
 
 	if (m_parallelProfile.IsParallel())
 	{
@@ -95,6 +87,7 @@ Blake512::Blake512(BlakeParams &Params)
 
 		m_leafSize = Params.LeafLength() == 0 ? DEF_LEAFSIZE : Params.LeafLength();
 		// initialize leafs
+		m_parallelProfile.SetMaxDegree(m_treeParams.FanOut());
 		Reset();
 	}
 	else
@@ -189,6 +182,8 @@ void Blake512::Compute(const std::vector<byte> &Input, std::vector<byte> &Output
 
 size_t Blake512::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, 0);
+
 	if (m_parallelProfile.IsParallel())
 	{
 		std::vector<byte> hashCodes(m_treeParams.FanOut() * DIGEST_SIZE);
@@ -286,7 +281,9 @@ size_t Blake512::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 		// last compression
 		Compress(m_msgBuffer, m_msgLength - BLOCK_SIZE, m_dgtState[0], BLOCK_SIZE);
 		// output the code
-		IntUtils::LeULL512ToBlock(m_dgtState[0].H, 0, Output, 0);
+		IntUtils::LeULL512ToBlock(m_dgtState[0].H, 0, Output, OutOffset);
+		// restore the leaf depth so the instance can be reused
+		m_treeParams.NodeDepth() = 0;
 	}
 	else
 	{
@@ -308,36 +305,38 @@ size_t Blake512::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 
 void Blake512::Initialize(Key::Symmetric::ISymmetricKey &MacKey)
 {
-	if (MacKey.Key().size() < 32 || MacKey.Key().size() > 64)
+	Key::Symmetric::SymmetricKeyView kv(MacKey);
+
+	if (kv.Key().size() < 32 || kv.Key().size() > 64)
 	{
 		throw Exception::CryptoDigestException("Blake512::Initialize", "Mac Key has invalid length!");
 	}
 
-	if (MacKey.Nonce().size() != 0)
+	if (kv.Nonce().size() != 0)
 	{
-		if (MacKey.Nonce().size() != 16)
+		if (kv.Nonce().size() != 16)
 		{
 			throw Exception::CryptoDigestException("Blake512::Initialize", "Salt has invalid length!");
 		}
 
-		m_treeConfig[4] = IntUtils::LeBytesTo64(MacKey.Nonce(), 0);
-		m_treeConfig[5] = IntUtils::LeBytesTo64(MacKey.Nonce(), 8);
+		m_treeConfig[4] = IntUtils::LeBytesTo64(kv.Nonce(), 0);
+		m_treeConfig[5] = IntUtils::LeBytesTo64(kv.Nonce(), 8);
 	}
 
-	if (MacKey.Info().size() != 0)
+	if (kv.Info().size() != 0)
 	{
-		if (MacKey.Info().size() != 16)
+		if (kv.Info().size() != 16)
 		{
 			throw Exception::CryptoDigestException("Blake512::Initialize", "Info has invalid length!");
 		}
 
-		m_treeConfig[6] = IntUtils::LeBytesTo64(MacKey.Info(), 0);
-		m_treeConfig[7] = IntUtils::LeBytesTo64(MacKey.Info(), 8);
+		m_treeConfig[6] = IntUtils::LeBytesTo64(kv.Info(), 0);
+		m_treeConfig[7] = IntUtils::LeBytesTo64(kv.Info(), 8);
 	}
 
 	std::vector<byte> mkey(BLOCK_SIZE, 0);
-	Utility::MemUtils::Copy(MacKey.Key(), 0, mkey, 0, IntUtils::Min(MacKey.Key().size(), mkey.size()));
-	m_treeParams.KeyLength() = static_cast<byte>(MacKey.Key().size());
+	Utility::MemUtils::Copy(kv.Key(), 0, mkey, 0, IntUtils::Min(kv.Key().size(), mkey.size()));
+	m_treeParams.KeyLength() = static_cast<byte>(kv.Key().size());
 
 	if (m_parallelProfile.IsParallel())
 	{
@@ -409,10 +408,14 @@ void Blake512::Update(byte Input)
 
 void Blake512::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, Length);
+
 	if (Length != 0)
 	{
 		if (m_parallelProfile.IsParallel())
 		{
+			CEX_INSTRUMENT_PARALLEL();
+
 			size_t ttlLen = Length + m_msgLength;
 			const size_t PRLMIN = m_msgBuffer.size() + (m_parallelProfile.ParallelMinimumSize() - BLOCK_SIZE);
 
@@ -432,11 +435,7 @@ void Blake512::Update(const std::vector<byte> &Input, size_t InOffset, size_t Le
 				ttlLen -= m_msgBuffer.size();
 
 				// empty the message buffer
-				Utility::ParallelUtils::ParallelFor(0, m_treeParams.FanOut(), [this, &Input, InOffset](size_t i)
-				{
-					Compress(m_msgBuffer, i * BLOCK_SIZE, m_dgtState[i], BLOCK_SIZE);
-					Compress(m_msgBuffer, (i * BLOCK_SIZE) + (m_treeParams.FanOut() * BLOCK_SIZE), m_dgtState[i], BLOCK_SIZE);
-				});
+				ProcessLeaves(m_msgBuffer, 0, m_msgBuffer.size());
 
 				// loop in the remainder (no buffering)
 				if (Length > PRLMIN)
@@ -449,10 +448,7 @@ void Blake512::Update(const std::vector<byte> &Input, size_t InOffset, size_t Le
 					}
 
 					// process large blocks
-					Utility::ParallelUtils::ParallelFor(0, m_treeParams.FanOut(), [this, &Input, InOffset, prcLen](size_t i)
-					{
-						ProcessLeaf(Input, InOffset + (i * BLOCK_SIZE), m_dgtState[i], prcLen);
-					});
+					ProcessLeaves(Input, InOffset, prcLen);
 
 					Length -= prcLen;
 					InOffset += prcLen;
@@ -475,10 +471,7 @@ void Blake512::Update(const std::vector<byte> &Input, size_t InOffset, size_t Le
 				m_msgLength = m_msgBuffer.size();
 
 				// process first half of buffer
-				Utility::ParallelUtils::ParallelFor(0, m_treeParams.FanOut(), [this, &Input, InOffset](size_t i)
-				{
-					Compress(m_msgBuffer, i * BLOCK_SIZE, m_dgtState[i], BLOCK_SIZE);
-				});
+				ProcessLeaves(m_msgBuffer, 0, m_parallelProfile.ParallelMinimumSize());
 
 				// left rotate the buffer
 				m_msgLength -= m_parallelProfile.ParallelMinimumSize();
@@ -537,6 +530,43 @@ void Blake512::LoadState(Blake2bState &State)
 	Utility::MemUtils::XOR512(m_treeConfig, 0, State.H, 0);
 }
 
+template<typename T>
+size_t Blake512::ProcessLanes(const std::vector<byte> &Input, size_t InOffset, size_t Length, size_t LeafOffset)
+{
+	const size_t LNECNT = sizeof(T) / sizeof(ulong);
+	// each group of leaves is transposed into the lanes of one register; the groups are spread across processor cores
+	const size_t GRPCNT = (m_treeParams.FanOut() - LeafOffset) / LNECNT;
+
+	auto prcGroup = [this, &Input, InOffset, Length, LeafOffset, LNECNT](size_t Group)
+	{
+		const size_t LEAFOFT = LeafOffset + (Group * LNECNT);
+
+		for (size_t i = 0; i < Length; i += m_parallelProfile.ParallelMinimumSize())
+		{
+			for (size_t j = 0; j < LNECNT; ++j)
+			{
+				IntUtils::LeIncreaseW(m_dgtState[LEAFOFT + j].T, m_dgtState[LEAFOFT + j].T, BLOCK_SIZE);
+			}
+
+			Blake2::Compress1024W<T>(Input, InOffset + i + (LEAFOFT * BLOCK_SIZE), m_dgtState, LEAFOFT, m_cIV);
+		}
+	};
+
+	if (GRPCNT > 1 && m_parallelProfile.ProcessorCount() > 1)
+	{
+		Utility::ParallelUtils::ParallelFor(0, GRPCNT, prcGroup);
+	}
+	else
+	{
+		for (size_t i = 0; i < GRPCNT; ++i)
+		{
+			prcGroup(i);
+		}
+	}
+
+	return GRPCNT * LNECNT;
+}
+
 void Blake512::ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, Blake2bState &State, ulong Length)
 {
 	do
@@ -548,4 +578,40 @@ void Blake512::ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, Blak
 	while (Length > 0);
 }
 
+void Blake512::ProcessLeaves(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	// leaf n compresses block n of each set of FanOut blocks
+	const size_t LEAFCNT = m_treeParams.FanOut();
+	size_t leafCtr = 0;
+
+	// the leaves fill the widest registers first, the remainder is taken by the narrower registers
+#if defined(__AVX512__)
+	leafCtr += ProcessLanes<Numeric::ULong512>(Input, InOffset, Length, leafCtr);
+#endif
+#if defined(__AVX2__)
+	leafCtr += ProcessLanes<Numeric::ULong256>(Input, InOffset, Length, leafCtr);
+#endif
+
+	// leaves that do not fill a register
+	if (leafCtr != LEAFCNT)
+	{
+		const size_t LEAFOFT = leafCtr;
+
+		if (LEAFCNT - LEAFOFT > 1 && m_parallelProfile.ProcessorCount() > 1)
+		{
+			Utility::ParallelUtils::ParallelFor(0, LEAFCNT - LEAFOFT, [this, &Input, InOffset, Length, LEAFOFT](size_t i)
+			{
+				ProcessLeaf(Input, InOffset + ((LEAFOFT + i) * BLOCK_SIZE), m_dgtState[LEAFOFT + i], Length);
+			});
+		}
+		else
+		{
+			for (size_t i = LEAFOFT; i < LEAFCNT; ++i)
+			{
+				ProcessLeaf(Input, InOffset + (i * BLOCK_SIZE), m_dgtState[i], Length);
+			}
+		}
+	}
+}
+
 NAMESPACE_DIGESTEND
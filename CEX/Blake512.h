@@ -313,7 +313,10 @@ private:
 
 	void Compress(const std::vector<byte> &Input, size_t InOffset, Blake2bState &State, size_t Length);
 	void LoadState(Blake2bState &State);
+	template<typename T>
+	size_t ProcessLanes(const std::vector<byte> &Input, size_t InOffset, size_t Length, size_t LeafOffset);
 	void ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, Blake2bState &State, ulong Length);
+	void ProcessLeaves(const std::vector<byte> &Input, size_t InOffset, size_t Length);
 };
 
 NAMESPACE_DIGESTEND
@@ -201,7 +201,7 @@ public:
 			Config[0] |= (static_cast<uint>(m_maxDepth) << 24);
 			Config[1] = m_leafSize;
 			Config[2] = m_nodeOffset;
-			Config[3] |= (static_cast<uint>(m_nodeDepth) << 16);
+			Config[3] = (static_cast<uint>(m_nodeDepth) << 16);
 			Config[3] |= (static_cast<uint>(m_innerLen) << 24);
 			Config[4] = m_reserved;
 
@@ -1,7 +1,9 @@
 #include "CBC.h"
 #include "BlockCipherFromName.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
 #include "ParallelUtils.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_MODE
 
@@ -22,6 +24,7 @@ CBC::CBC(BlockCiphers CipherType)
 	m_isLoaded(false),
 	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true)
 {
+	m_parallelProfile.Calibrate(Name());
 }
 
 CBC::CBC(IBlockCipher* Cipher)
@@ -37,6 +40,7 @@ CBC::CBC(IBlockCipher* Cipher)
 	m_isLoaded(false),
 	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true)
 {
+	m_parallelProfile.Calibrate(Name());
 }
 
 CBC::~CBC()
@@ -135,6 +139,62 @@ ParallelOptions &CBC::ParallelProfile()
 
 //~~~Public Functions~~~//
 
+void CBC::ChainBatch(const std::vector<byte> &Input, size_t InOffset, const size_t Stride, std::vector<byte> &Iv, const size_t Length, const size_t Count)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+	CexAssert(m_isEncryption, "The cipher mode must be initialized for encryption!");
+	CexAssert(Length % BLOCK_SIZE == 0, "The length must be evenly divisible by the block ciphers block-size!");
+	CexAssert(Iv.size() >= Count * BLOCK_SIZE, "The iv array must contain a vector for each message!");
+	CexAssert(Count == 0 || Input.size() - InOffset >= ((Count - 1) * Stride) + Length, "The input array is too small!");
+
+	const size_t BLKCNT = Length / BLOCK_SIZE;
+	size_t lneCtr = 0;
+
+	while (lneCtr != Count)
+	{
+		const size_t LNECNT = LaneCount(Count - lneCtr);
+
+		for (size_t i = 0; i < BLKCNT; ++i)
+		{
+			EncryptLanes(Input, InOffset + (lneCtr * Stride) + (i * BLOCK_SIZE), Stride, Iv, lneCtr * BLOCK_SIZE, LNECNT);
+		}
+
+		lneCtr += LNECNT;
+	}
+}
+
+void CBC::EncryptBatch(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, std::vector<byte> &Iv, const size_t Length, const size_t Count)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+	CexAssert(m_isEncryption, "The cipher mode must be initialized for encryption!");
+	CexAssert(Length % BLOCK_SIZE == 0, "The length must be evenly divisible by the block ciphers block-size!");
+	CexAssert(Iv.size() >= Count * BLOCK_SIZE, "The iv array must contain a vector for each message!");
+	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Count * Length, "The data arrays are smaller than the batch size!");
+
+	const size_t BLKCNT = Length / BLOCK_SIZE;
+	size_t lneCtr = 0;
+
+	while (lneCtr != Count)
+	{
+		const size_t LNECNT = LaneCount(Count - lneCtr);
+
+		for (size_t i = 0; i < BLKCNT; ++i)
+		{
+			const size_t BLKOFT = (lneCtr * Length) + (i * BLOCK_SIZE);
+
+			// the chain vectors hold the new cipher-text block of each lane
+			EncryptLanes(Input, InOffset + BLKOFT, Length, Iv, lneCtr * BLOCK_SIZE, LNECNT);
+
+			for (size_t j = 0; j < LNECNT; ++j)
+			{
+				Utility::MemUtils::COPY128(Iv, (lneCtr + j) * BLOCK_SIZE, Output, OutOffset + BLKOFT + (j * Length));
+			}
+		}
+
+		lneCtr += LNECNT;
+	}
+}
+
 void CBC::DecryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output)
 {
 	Decrypt128(Input, 0, Output, 0);
@@ -157,11 +217,13 @@ void CBC::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 
 void CBC::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (KeyParams.Nonce().size() != BLOCK_SIZE)
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (kv.Nonce().size() != BLOCK_SIZE)
 	{
 		throw CryptoSymmetricCipherException("CBC:Initialize", "Requires 16 bytes of Nonce!");
 	}
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), kv.Key().size()))
 	{
 		throw CryptoSymmetricCipherException("CBC:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 	}
@@ -176,7 +238,7 @@ void CBC::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 
 	Scope();
 	m_blockCipher->Initialize(Encryption, KeyParams);
-	m_cbcVector = KeyParams.Nonce();
+	m_cbcVector = kv.Nonce();
 	m_isEncryption = Encryption;
 	m_isInitialized = true;
 }
@@ -192,6 +254,8 @@ void CBC::ParallelMaxDegree(size_t Degree)
 
 void CBC::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::CipherMode, CLASS_NAME, Length);
+
 	Process(Input, InOffset, Output, OutOffset, Length);
 }
 
@@ -368,6 +432,56 @@ void CBC::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	Utility::MemUtils::COPY128(Output, OutOffset, m_cbcVector, 0);
 }
 
+void CBC::EncryptLanes(const std::vector<byte> &Input, const size_t InOffset, const size_t Stride, std::vector<byte> &Iv, const size_t IvOffset, const size_t Lanes)
+{
+	// xor the next block of each message into its chain vector; the vectors are contiguous, so they are encrypted in place as one wide block
+	for (size_t i = 0; i < Lanes; ++i)
+	{
+		Utility::MemUtils::XOR128(Input, InOffset + (i * Stride), Iv, IvOffset + (i * BLOCK_SIZE));
+	}
+
+	switch (Lanes)
+	{
+		case 16:
+		{
+			m_blockCipher->Transform2048(Iv, IvOffset, Iv, IvOffset);
+			break;
+		}
+		case 8:
+		{
+			m_blockCipher->Transform1024(Iv, IvOffset, Iv, IvOffset);
+			break;
+		}
+		case 4:
+		{
+			m_blockCipher->Transform512(Iv, IvOffset, Iv, IvOffset);
+			break;
+		}
+		default:
+		{
+			m_blockCipher->EncryptBlock(Iv, IvOffset, Iv, IvOffset);
+		}
+	}
+}
+
+size_t CBC::LaneCount(size_t Count)
+{
+	// the widest interleave supported by the instruction set, then 4 lanes, then single blocks
+#if defined(__AVX512__)
+	if (Count >= 16)
+	{
+		return 16;
+	}
+#elif defined(__AVX2__)
+	if (Count >= 8)
+	{
+		return 8;
+	}
+#endif
+
+	return (Count >= 4) ? 4 : 1;
+}
+
 void CBC::Process(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
@@ -387,6 +501,8 @@ void CBC::Process(const std::vector<byte> &Input, const size_t InOffset, std::ve
 	{
 		if (m_parallelProfile.IsParallel() && Length >= m_parallelProfile.ParallelBlockSize())
 		{
+			CEX_INSTRUMENT_PARALLEL();
+
 			const size_t PRBCNT = Length / m_parallelProfile.ParallelBlockSize();
 
 			for (size_t i = 0; i < PRBCNT; ++i)
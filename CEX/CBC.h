@@ -77,6 +77,7 @@ NAMESPACE_MODE
 /// <item><description>The DecryptBlock, Decrypt512, Decrypt1024  EncryptBlock, Encrypt512, Encrypt1024 functions can be accessed through the class instance.</description></item>
 /// <item><description>The transformation methods can not be called until the Initialize(bool, ISymmetricKey) function has been called.</description></item>
 /// <item><description>In CBC mode, only the decryption function can be processed in parallel.</description></item>
+/// <item><description>Independent messages that share a key can be encrypted together with EncryptBatch, which interleaves one block from each of 4, 8 or 16 messages through the wide transforms.</description></item>
 /// <item><description>The ParallelThreadsMax() property is used as the thread count in the parallel loop; this must be an even number no greater than the number of processer cores on the system.</description></item>
 /// <item><description>Parallel processing is enabled on decryption by setting IsParallel() to true, and passing an input block of ParallelBlockSize() to the transform.</description></item>
 /// <item><description>ParallelBlockSize() is calculated automatically based on the processor(s) L1 data cache size, this property can be user defined, and must be evenly divisible by ParallelMinimumSize().</description></item>
@@ -215,6 +216,39 @@ public:
 
 	//~~~Public Functions~~~//
 
+	/// <summary>
+	/// Advance a set of independent CBC chains over their message blocks, without writing the cipher-text (exposed for CMAC).
+	/// <para>Each chain processes Length bytes from its own message; the messages begin at InOffset and are Stride bytes apart.
+	/// The chains are interleaved through the ciphers wide transforms, and the final chain value of each message is written back to the Iv array.
+	/// The mode must be initialized for encryption; the modes own initialization vector is not used or changed.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array containing the messages</param>
+	/// <param name="InOffset">Starting offset of the first message within the input array</param>
+	/// <param name="Stride">The distance in bytes between the start of each message</param>
+	/// <param name="Iv">The chaining vectors, Count * 16 bytes; contains the final chain value of each message on return</param>
+	/// <param name="Length">The number of bytes to process in each message; must be a multiple of the block size</param>
+	/// <param name="Count">The number of messages</param>
+	void ChainBatch(const std::vector<byte> &Input, size_t InOffset, const size_t Stride, std::vector<byte> &Iv, const size_t Length, const size_t Count);
+
+	/// <summary>
+	/// Encrypt a set of independent equal-length messages that share the key, each with its own initialization vector.
+	/// <para>The messages are stored contiguously, Length bytes apart, in both the input and output arrays.
+	/// Because CBC encryption is serial within a message, the messages are interleaved instead; one block from each of 4, 8 or 16 messages
+	/// is encrypted together through Transform512, Transform1024 or Transform2048, depending on the widest instruction set available.
+	/// The output is identical to encrypting each message separately with Transform.
+	/// The mode must be initialized for encryption; the modes own initialization vector is not used or changed.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of plain text messages</param>
+	/// <param name="InOffset">Starting offset of the first message within the input array</param>
+	/// <param name="Output">The output array of encrypted messages</param>
+	/// <param name="OutOffset">Starting offset of the first message within the output array</param>
+	/// <param name="Iv">The initialization vectors, Count * 16 bytes; contains the last cipher-text block of each message on return</param>
+	/// <param name="Length">The byte length of each message; must be a multiple of the block size</param>
+	/// <param name="Count">The number of messages</param>
+	void EncryptBatch(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, std::vector<byte> &Iv, const size_t Length, const size_t Count);
+
 	/// <summary>
 	/// Decrypt a single block of bytes.
 	/// <para>Decrypts one block of bytes beginning at a zero index.
@@ -300,6 +334,8 @@ private:
 	void DecryptParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
 	void DecryptSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, std::vector<byte> &Iv, const size_t BlockCount);
 	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
+	void EncryptLanes(const std::vector<byte> &Input, const size_t InOffset, const size_t Stride, std::vector<byte> &Iv, const size_t IvOffset, const size_t Lanes);
+	static size_t LaneCount(size_t Count);
 	void Process(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
 	void Scope();
 };
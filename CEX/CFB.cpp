@@ -1,7 +1,9 @@
 #include "CFB.h"
 #include "BlockCipherFromName.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
 #include "ParallelUtils.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_MODE
 
@@ -157,11 +159,13 @@ void CFB::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 
 void CFB::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (KeyParams.Nonce().size() < 1)
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (kv.Nonce().size() < 1)
 	{
 		throw CryptoSymmetricCipherException("CFB:Initialize", "Requires a minimum 1 byte of Nonce!");
 	}
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), kv.Key().size()))
 	{
 		throw CryptoSymmetricCipherException("CFB:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 	}
@@ -175,7 +179,7 @@ void CFB::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 	}
 
 	Scope();
-	std::vector<byte> iv = KeyParams.Nonce();
+	std::vector<byte> iv = kv.Nonce();
 	size_t diff = m_cfbVector.size() - iv.size();
 	Utility::MemUtils::Copy(iv, 0, m_cfbVector, diff, iv.size());
 	Utility::MemUtils::Clear(m_cfbVector, 0, diff);
@@ -195,6 +199,8 @@ void CFB::ParallelMaxDegree(size_t Degree)
 
 void CFB::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::CipherMode, CLASS_NAME, Length);
+
 	Process(Input, InOffset, Output, OutOffset, Length);
 }
 
@@ -322,6 +328,8 @@ void CFB::Process(const std::vector<byte> &Input, const size_t InOffset, std::ve
 	{
 		if (m_parallelProfile.IsParallel() && Length >= m_parallelProfile.ParallelBlockSize())
 		{
+			CEX_INSTRUMENT_PARALLEL();
+
 			const size_t PRBCNT = Length / m_parallelProfile.ParallelBlockSize();
 
 			for (size_t i = 0; i < PRBCNT; ++i)
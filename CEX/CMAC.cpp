@@ -1,8 +1,10 @@
 #include "CMAC.h"
 #include "CBC.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
 #include "ISO7816.h"
 #include "SymmetricKey.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_MAC
 
@@ -138,8 +140,57 @@ void CMAC::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
 	Finalize(Output, 0);
 }
 
+void CMAC::ComputeBatch(const std::vector<byte> &Input, size_t InOffset, size_t Length, size_t Count, std::vector<byte> &Output, size_t OutOffset)
+{
+	CexAssert(m_isInitialized, "The Mac is not initialized");
+	CexAssert(Input.size() - InOffset >= Count * Length, "The Input buffer is too short");
+	CexAssert(Output.size() - OutOffset >= Count * m_macSize, "The Output buffer is too short");
+
+	// every block but the last is chained unmodified; the last block is padded and masked with a subkey
+	const size_t BLKCNT = (Length == 0) ? 1 : (Length + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	const size_t FNLOFT = (BLKCNT - 1) * BLOCK_SIZE;
+	const size_t FNLLEN = Length - FNLOFT;
+	Cipher::Symmetric::Block::Mode::CBC* cbc = static_cast<Cipher::Symmetric::Block::Mode::CBC*>(m_cipherMode.get());
+	Cipher::Symmetric::Block::Padding::ISO7816 pad;
+	std::vector<byte> chain(Count * BLOCK_SIZE, 0);
+	std::vector<byte> fnlBlk(Count * BLOCK_SIZE);
+	std::vector<byte> tmpBlk(BLOCK_SIZE);
+
+	cbc->ChainBatch(Input, InOffset, Length, chain, FNLOFT, Count);
+
+	for (size_t i = 0; i < Count; ++i)
+	{
+		Utility::MemUtils::Copy(Input, InOffset + (i * Length) + FNLOFT, tmpBlk, 0, FNLLEN);
+
+		if (FNLLEN != BLOCK_SIZE)
+		{
+			pad.AddPadding(tmpBlk, FNLLEN);
+			Utility::MemUtils::XorBlock(m_K2, 0, tmpBlk, 0, m_macSize);
+		}
+		else
+		{
+			Utility::MemUtils::XorBlock(m_K1, 0, tmpBlk, 0, m_macSize);
+		}
+
+		Utility::MemUtils::COPY128(tmpBlk, 0, fnlBlk, i * BLOCK_SIZE);
+	}
+
+	cbc->ChainBatch(fnlBlk, 0, BLOCK_SIZE, chain, BLOCK_SIZE, Count);
+
+	for (size_t i = 0; i < Count; ++i)
+	{
+		Utility::MemUtils::Copy(chain, i * BLOCK_SIZE, Output, OutOffset + (i * m_macSize), m_macSize);
+	}
+
+	Utility::MemUtils::Clear(chain, 0, chain.size());
+	Utility::MemUtils::Clear(fnlBlk, 0, fnlBlk.size());
+	Utility::MemUtils::Clear(tmpBlk, 0, tmpBlk.size());
+}
+
 size_t CMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Mac, CLASS_NAME, 0);
+
 	CexAssert(m_isInitialized, "The Mac is not initialized");
 	CexAssert((Output.size() - OutOffset) >= m_macSize, "The Output buffer is too short");
 
@@ -163,7 +214,9 @@ size_t CMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
 
 void CMAC::Initialize(ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(m_cipherMode->LegalKeySizes(), KeyParams.Key().size(), 0, 0))
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (!SymmetricKeySize::Contains(m_cipherMode->LegalKeySizes(), kv.Key().size(), 0, 0))
 	{
 		throw CryptoMacException("CMAC:Initialize", "Key size is too small; must be minimum key size!");
 	}
@@ -173,25 +226,25 @@ void CMAC::Initialize(ISymmetricKey &KeyParams)
 		Reset();
 	}
 
-	m_cipherKey = KeyParams.Key();
+	m_cipherKey = kv.Key();
 	std::vector<byte> tmpIv(m_cipherMode->BlockSize());
 	Key::Symmetric::SymmetricKey kp(m_cipherKey, tmpIv);
 	m_cipherMode->Initialize(true, kp);
 
-	if (KeyParams.Info().size() != 0 &&
+	if (kv.Info().size() != 0 &&
 		m_cipherType != BlockCiphers::Rijndael &&
 		m_cipherType != BlockCiphers::Serpent &&
 		m_cipherType != BlockCiphers::Twofish)
 	{
-		if (KeyParams.Info().size() <= m_cipherMode->Engine()->DistributionCodeMax())
+		if (kv.Info().size() <= m_cipherMode->Engine()->DistributionCodeMax())
 		{
-			m_cipherMode->Engine()->DistributionCode() = KeyParams.Info();
+			m_cipherMode->Engine()->DistributionCode() = kv.Info();
 		}
 		else
 		{
 			// info is too large; size to optimal max, ignore remainder
 			std::vector<byte> tmpInfo(m_cipherMode->Engine()->DistributionCodeMax());
-			Utility::MemUtils::Copy(KeyParams.Info(), 0, tmpInfo, 0, tmpInfo.size());
+			Utility::MemUtils::Copy(kv.Info(), 0, tmpInfo, 0, tmpInfo.size());
 			m_cipherMode->Engine()->DistributionCode() = tmpInfo;
 		}
 	}
@@ -199,8 +252,12 @@ void CMAC::Initialize(ISymmetricKey &KeyParams)
 	std::vector<byte> lu(m_cipherMode->BlockSize());
 	std::vector<byte> tmpz(m_cipherMode->BlockSize());
 	m_cipherMode->EncryptBlock(tmpz, 0, lu, 0);
-	m_K1 = GenerateSubkey(lu);
-	m_K2 = GenerateSubkey(m_K1);
+	// double the encrypted zero block in place, keeping only the secure copies of the subkeys
+	GenerateSubkey(lu);
+	m_K1.assign(lu.begin(), lu.end());
+	GenerateSubkey(lu);
+	m_K2.assign(lu.begin(), lu.end());
+	Utility::MemUtils::Clear(lu, 0, lu.size());
 	m_cipherMode->Initialize(true, kp);
 
 	m_isInitialized = true;
@@ -231,6 +288,8 @@ void CMAC::Update(byte Input)
 
 void CMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Mac, CLASS_NAME, Length);
+
 	CexAssert(m_isInitialized, "The Mac is not initialized");
 	CexAssert((InOffset + Length) <= Input.size(), "The Mac is not initialized");
 
@@ -269,24 +328,22 @@ void CMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length
 
 //~~~Private Functions~~~//
 
-std::vector<byte> CMAC::GenerateSubkey(std::vector<byte> &Input)
+void CMAC::GenerateSubkey(std::vector<byte> &Input)
 {
 	int fbit = (Input[0] & 0xFF) >> 7;
-	std::vector<byte> tmpKey(Input.size());
 
+	// each byte reads the next one before it is shifted, so the doubling can be done in place
 	for (size_t i = 0; i < Input.size() - 1; i++)
 	{
-		tmpKey[i] = static_cast<byte>((Input[i] << 1) + ((Input[i + 1] & 0xFF) >> 7));
+		Input[i] = static_cast<byte>((Input[i] << 1) + ((Input[i + 1] & 0xFF) >> 7));
 	}
 
-	tmpKey[Input.size() - 1] = static_cast<byte>(Input[Input.size() - 1] << 1);
+	Input[Input.size() - 1] = static_cast<byte>(Input[Input.size() - 1] << 1);
 
 	if (fbit == 1)
 	{
-		tmpKey[Input.size() - 1] ^= (Input.size() == m_cipherMode->BlockSize()) ? CT87 : CT1B;
+		Input[Input.size() - 1] ^= (Input.size() == m_cipherMode->BlockSize()) ? CT87 : CT1B;
 	}
-
-	return tmpKey;
 }
 
 void CMAC::Scope()
@@ -29,6 +29,7 @@
 #include "IMac.h"
 #include "BlockCiphers.h"
 #include "ICipherMode.h"
+#include "SecureVector.h"
 
 NAMESPACE_MAC
 
@@ -108,8 +109,8 @@ private:
 	bool m_destroyEngine;
 	bool m_isDestroyed;
 	bool m_isInitialized;
-	std::vector<byte> m_K1; 
-	std::vector<byte> m_K2;
+	SecureVector<byte> m_K1;
+	SecureVector<byte> m_K2;
 	std::vector<SymmetricKeySize> m_legalKeySizes;
 	size_t m_macSize;
 	std::vector<byte> m_msgBuffer;
@@ -205,6 +206,21 @@ public:
 	/// <param name="Output">The output Mac code array</param>
 	void Compute(const std::vector<byte> &Input, std::vector<byte> &Output) override;
 
+	/// <summary>
+	/// Compute the Mac codes of a set of independent equal-length messages under the loaded key.
+	/// <para>The messages are stored contiguously, Length bytes apart, and the codes are written to the output array MacSize() bytes apart.
+	/// The CBC chains of the messages are interleaved through the ciphers wide transforms, 4, 8 or 16 messages at a time.
+	/// Each code is identical to the code produced by Compute for that message alone; the state of a message being processed with Update is not affected.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The input array containing the messages</param>
+	/// <param name="InOffset">Starting offset of the first message within the input array</param>
+	/// <param name="Length">The byte length of each message</param>
+	/// <param name="Count">The number of messages</param>
+	/// <param name="Output">The output array receiving the Mac codes, Count * MacSize() bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	void ComputeBatch(const std::vector<byte> &Input, size_t InOffset, size_t Length, size_t Count, std::vector<byte> &Output, size_t OutOffset);
+
 	/// <summary>
 	/// Process the data and return a Mac code
 	/// <para>After calling this function the Mac code and buffer are zeroised, but key is still loaded.</para>
@@ -251,7 +267,7 @@ public:
 
 private:
 
-	std::vector<byte> GenerateSubkey(std::vector<byte> &Input);
+	void GenerateSubkey(std::vector<byte> &Input);
 	void Scope();
 };
 
@@ -1,9 +1,12 @@
 #include "CSG.h"
 #include "CpuDetect.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
 #include "ParallelUtils.h"
 #include "ProviderFromName.h"
 #include "SymmetricKey.h"
+#include "SymmetricKeyView.h"
+#include <algorithm>
 
 NAMESPACE_DRBG
 
@@ -33,6 +36,7 @@ CSG::CSG(ShakeModes ShakeMode, Providers ProviderType, bool Parallel)
 	m_isDestroyed(false),
 	m_isInitialized(false),
 	m_legalKeySizes(0),
+	m_outputCounter(0),
 	m_prdResistant(ProviderType != Providers::None),
 	m_providerSource(ProviderType == Providers::None ? nullptr : Helper::ProviderFromName::GetInstance(ProviderType)),
 	m_providerType(ProviderType),
@@ -67,6 +71,7 @@ CSG::CSG(ShakeModes ShakeMode, IProvider* Provider, bool Parallel)
 	m_isDestroyed(false),
 	m_isInitialized(false),
 	m_legalKeySizes(0),
+	m_outputCounter(0),
 	m_prdResistant(Provider != nullptr),
 	m_providerSource(Provider),
 	m_providerType(m_providerSource != nullptr ? m_providerSource->Enumeral() : Providers::None),
@@ -92,6 +97,7 @@ CSG::~CSG()
 		m_bufferIndex = 0;
 		m_distributionCodeMax = 0;
 		m_isInitialized = false;
+		m_outputCounter = 0;
 		m_prdResistant = false;
 		m_providerType = Providers::None;
 		m_reseedCounter = 0;
@@ -203,6 +209,8 @@ size_t CSG::Generate(std::vector<byte> &Output)
 
 size_t CSG::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Drbg, CLASS_NAME, Length);
+
 	CexAssert((Output.size() - Length) >= OutOffset, "Output buffer too small!");
 
 	if (!m_isInitialized)
@@ -210,23 +218,42 @@ size_t CSG::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length)
 		throw CryptoGeneratorException("CSG:Generate", "The generator has been reset, or was not initialized!");
 	}
 
-	Extract(Output, OutOffset, Length);
+	if (Length > MAX_OUTPUT - m_outputCounter)
+	{
+		throw CryptoGeneratorException("CSG:Generate", "The maximum output size has been exceeded, re-initialize the generator!");
+	}
+
+	size_t prcLen = Length;
 
-	if (m_prdResistant)
+	while (prcLen != 0)
 	{
-		m_reseedCounter += Length;
+		// split the request at the reseed threshold, so the generator is re-keyed at the same position regardless of the request sizes
+		const size_t RMDSZE = m_prdResistant ? IntUtils::Min(prcLen, (m_reseedThreshold > m_reseedCounter) ? m_reseedThreshold - m_reseedCounter : 1) : prcLen;
 
-		if (m_reseedCounter >= m_reseedThreshold)
+		Extract(Output, OutOffset, RMDSZE);
+		m_outputCounter += RMDSZE;
+		OutOffset += RMDSZE;
+		prcLen -= RMDSZE;
+
+		if (m_prdResistant)
 		{
-			++m_reseedRequests;
+			m_reseedCounter += RMDSZE;
 
-			if (m_reseedRequests > MAX_RESEED)
+			if (m_reseedCounter >= m_reseedThreshold)
 			{
-				throw CryptoGeneratorException("CSG:Generate", "The maximum reseed requests can not be exceeded, re-initialize the generator!");
-			}
+				++m_reseedRequests;
+
+				if (m_reseedRequests > MAX_RESEED)
+				{
+					throw CryptoGeneratorException("CSG:Generate", "The maximum reseed requests can not be exceeded, re-initialize the generator!");
+				}
 
-			Derive();
-			m_reseedCounter = 0;
+				CEX_INSTRUMENT_RESEED();
+
+				Derive();
+				m_outputCounter = 0;
+				m_reseedCounter = 0;
+			}
 		}
 	}
 
@@ -235,20 +262,22 @@ size_t CSG::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length)
 
 void CSG::Initialize(ISymmetricKey &GenParam)
 {
-	if (GenParam.Nonce().size() != 0)
+	Key::Symmetric::SymmetricKeyView kv(GenParam);
+
+	if (kv.Nonce().size() != 0)
 	{
-		if (GenParam.Info().size() != 0)
+		if (kv.Info().size() != 0)
 		{
-			Initialize(GenParam.Key(), GenParam.Nonce(), GenParam.Info());
+			Initialize(kv.Key(), kv.Nonce(), kv.Info());
 		}
 		else
 		{
-			Initialize(GenParam.Key(), GenParam.Nonce());
+			Initialize(kv.Key(), kv.Nonce());
 		}
 	}
 	else
 	{
-		Initialize(GenParam.Key());
+		Initialize(kv.Key());
 	}
 }
 
@@ -296,6 +325,7 @@ void CSG::Initialize(const std::vector<byte> &Seed)
 		Fill();
 	}
 
+	m_outputCounter = 0;
 	m_seedSize = Seed.size();
 	m_isInitialized = true;
 }
@@ -327,6 +357,9 @@ void CSG::Initialize(const std::vector<byte> &Seed, const std::vector<byte> &Non
 
 void CSG::Update(const std::vector<byte> &Seed)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Drbg, CLASS_NAME, Seed.size());
+	CEX_INSTRUMENT_RESEED();
+
 	// add new entropy equal to original key size to the state
 	for (size_t i = 0; i < m_drbgState.size(); ++i)
 	{
@@ -523,8 +556,12 @@ void CSG::Permute(std::array<ulong, STATE_SIZE> &State)
 	}
 }
 
-void CSG::PermuteW(std::vector<std::array<ulong, STATE_SIZE>> &State)
+void CSG::PermuteW(SecureVector<std::array<ulong, STATE_SIZE>> &State)
 {
+	// the wide generator output is defined with state i permuted in lane (n - 1 - i), the order of the original lane loading;
+	// the states are reversed to keep the output, and the cSHAKEW vectors, unchanged
+	std::reverse(State.begin(), State.end());
+
 	if (m_shakeMode != ShakeModes::SHAKE1024)
 	{
 #if defined(__AVX512__)
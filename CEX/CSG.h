@@ -30,6 +30,7 @@
 #include "Keccak.h"
 #include "SHAKE.h"
 #include "ShakeModes.h"
+#include "SecureVector.h"
 
 NAMESPACE_DRBG
 
@@ -64,7 +65,8 @@ using Enumeration::Providers;
 ///
 /// <para><EM>Generate</EM> \n
 /// The generate function employs a state counter, that will automatically trigger a re-seed of the cSHAKE instance after a user defined maximum threshold has been exceeded. \n
-/// Use the ReseedThreshold parameter to tune the auto re-seed interval.
+/// Use the ReseedThreshold parameter to tune the auto re-seed interval. \n
+/// Requests of any length are accepted; a request that crosses the ReseedThreshold is split at the threshold, so the generator is re-seeded at the same output position regardless of the request sizes.
 /// </para>
 ///
 /// <description><B>Predictive Resistance:</B></description>
@@ -116,10 +118,11 @@ private:
 	size_t m_distributionCodeMax;
 	byte m_domainCode;
 	std::vector<byte> m_drbgBuffer;
-	std::vector<std::array<ulong, STATE_SIZE>> m_drbgState;
+	SecureVector<std::array<ulong, STATE_SIZE>> m_drbgState;
 	bool m_isDestroyed;
 	bool m_isInitialized;
 	std::vector<SymmetricKeySize> m_legalKeySizes;
+	ulong m_outputCounter;
 	bool m_prdResistant;
 	std::unique_ptr<IProvider> m_providerSource;
 	Providers m_providerType;
@@ -206,7 +209,7 @@ public:
 	std::vector<SymmetricKeySize> LegalKeySizes() const override;
 
 	/// <summary>
-	/// Read Only: The maximum number of bytes that can be generated with a generator instance
+	/// Read Only: The maximum number of bytes that can be generated with a generator instance before it must be re-keyed
 	/// </summary>
 	const ulong MaxOutputSize() override;
 
@@ -252,7 +255,7 @@ public:
 	/// <returns>The number of bytes generated</returns>
 	/// 
 	/// <exception cref="Exception::CryptoGeneratorException">Thrown if the generator is not initialized, the output size is misaligned, 
-	/// the maximum request size is exceeded, or if the maximum reseed requests are exceeded</exception>
+	/// the maximum output size is exceeded, or if the maximum reseed requests are exceeded</exception>
 	size_t Generate(std::vector<byte> &Output) override;
 
 	/// <summary>
@@ -266,7 +269,7 @@ public:
 	/// <returns>The number of bytes generated</returns>
 	/// 
 	/// <exception cref="Exception::CryptoGeneratorException">Thrown if the generator is not initialized, the output size is misaligned, 
-	/// the maximum request size is exceeded, or if the maximum reseed requests are exceeded</exception>
+	/// the maximum output size is exceeded, or if the maximum reseed requests are exceeded</exception>
 	size_t Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length) override;
 
 	/// <summary>
@@ -361,7 +364,7 @@ private:
 	void FastAbsorb(const std::vector<byte> &Input, size_t InOffset, size_t Length, std::array<ulong, STATE_SIZE> &State);
 	void Fill();
 	void Permute(std::array<ulong, STATE_SIZE> &State);
-	void PermuteW(std::vector<std::array<ulong, STATE_SIZE>> &State);
+	void PermuteW(SecureVector<std::array<ulong, STATE_SIZE>> &State);
 	void Reset();
 	void Scope();
 };
@@ -1,22 +1,37 @@
 #include "CSP.h"
 #include "IntUtils.h"
+#include "MemUtils.h"
+#include <atomic>
 
 #if defined(CEX_OS_WINDOWS)
 #	include <Windows.h>
-#	pragma comment(lib, "advapi32.lib")
-	HCRYPTPROV m_hProvider = 0;
+#	include <bcrypt.h>
+#	pragma comment(lib, "bcrypt.lib")
+#	if !defined(NT_SUCCESS)
+#		define NT_SUCCESS(Status) (((NTSTATUS)(Status)) >= 0)
+#	endif
 #elif defined (CEX_OS_ANDROID)
 #	include <sys/types.h>
-#	include <thread>
-#elif defined (CEX_OS_POSIX)
+#	include <stdlib.h>
+#else
 #	include <sys/types.h>
 #	include <sys/stat.h>
 #	include <fcntl.h>
 #	include <unistd.h>
 #	include <errno.h>
+#	include <pthread.h>
+#	if defined(CEX_OS_LINUX)
+#		include <sys/syscall.h>
+#		if defined(SYS_getrandom)
+#			define CEX_HAS_GETRANDOM
+#		endif
+#	endif
 #	ifndef O_NOCTTY
 #		define O_NOCTTY 0
 #	endif
+#	ifndef O_CLOEXEC
+#		define O_CLOEXEC 0
+#	endif
 #	define CEX_SYSTEM_RNG_DEVICE "/dev/urandom"
 #endif
 
@@ -24,20 +39,52 @@ NAMESPACE_PROVIDER
 
 const std::string CSP::CLASS_NAME("CSP");
 
+#if !defined(CEX_OS_WINDOWS) && !defined(CEX_OS_ANDROID)
+// incremented in the child after a fork; a cache filled under another count is discarded
+static std::atomic<uint> ForkCount(0);
+
+static void OnFork()
+{
+	++ForkCount;
+}
+#endif
+
+struct CSP::EntropyCache
+{
+	std::vector<byte> Buffer;
+	size_t Position;
+	uint Generation;
+
+	EntropyCache()
+		:
+		Buffer(CACHE_SIZE),
+		Position(CACHE_SIZE),
+		Generation(0)
+	{
+	}
+
+	~EntropyCache()
+	{
+		Utility::MemUtils::Clear(Buffer, 0, Buffer.size());
+		Position = 0;
+		Generation = 0;
+	}
+};
+
 //~~~Accessors~~~//
 
 const Enumeration::Providers CSP::Enumeral()
 {
-	return Enumeration::Providers::CSP; 
+	return Enumeration::Providers::CSP;
 }
 
 const bool CSP::IsAvailable()
-{ 
-	return m_isAvailable; 
+{
+	return m_isAvailable;
 }
 
-const std::string CSP::Name() 
-{ 
+const std::string CSP::Name()
+{
 	return CLASS_NAME;
 }
 
@@ -45,7 +92,7 @@ const std::string CSP::Name()
 
 CSP::CSP()
 	:
-#if defined(CEX_OS_WINDOWS) || defined(CEX_OS_ANDROID) || defined(CEX_OS_POSIX)
+#if defined(CEX_OS_WINDOWS) || defined(CEX_OS_ANDROID) || defined(CEX_OS_APPLE) || defined(CEX_OS_LINUX) || defined(CEX_OS_UNIX) || defined(CEX_OS_POSIX)
 	m_isAvailable(true)
 #else
 	m_isAvailable(false)
@@ -62,70 +109,179 @@ CSP::~CSP()
 
 void CSP::GetBytes(std::vector<byte> &Output)
 {
+	GetBytes(Output, 0, Output.size());
+}
+
+void CSP::GetBytes(std::vector<byte> &Output, size_t Offset, size_t Length)
+{
+	CexAssert(Offset + Length <= Output.size(), "the array is too small to fulfill this request");
+
 	if (!m_isAvailable)
 	{
 		throw CryptoRandomException("CSP:GetBytes", "Random provider is not available!");
 	}
 
-	size_t prcLen = Output.size();
-	size_t prcOffset = 0;
+	if (Length >= CACHE_SIZE)
+	{
+		// large requests bypass the cache
+		Fill(Output.data() + Offset, Length);
+	}
+	else
+	{
+		EntropyCache &cache = ThreadCache();
 
-#if defined(CEX_OS_WINDOWS)
+		while (Length != 0)
+		{
+			if (cache.Position == CACHE_SIZE)
+			{
+				Fill(cache.Buffer.data(), CACHE_SIZE);
+				cache.Position = 0;
+			}
+
+			const size_t RMDSZE = Utility::IntUtils::Min(CACHE_SIZE - cache.Position, Length);
+			Utility::MemUtils::Copy(cache.Buffer, cache.Position, Output, Offset, RMDSZE);
+			// erase the bytes that have been handed out
+			Utility::MemUtils::Clear(cache.Buffer, cache.Position, RMDSZE);
+			cache.Position += RMDSZE;
+			Offset += RMDSZE;
+			Length -= RMDSZE;
+		}
+	}
+}
 
-	HCRYPTPROV hProvider = NULL;
-	if (!::CryptAcquireContextW(&hProvider, 0, 0, PROV_RSA_FULL, (CRYPT_VERIFYCONTEXT | CRYPT_SILENT)))
+std::vector<byte> CSP::GetBytes(size_t Length)
+{
+	std::vector<byte> data(Length);
+	GetBytes(data, 0, data.size());
+
+	return data;
+}
+
+uint CSP::Next()
+{
+	if (!m_isAvailable)
 	{
-		throw CryptoRandomException("CSP:GetBytes", "Call to CryptAcquireContext failed; random provider is not available!");
+		throw CryptoRandomException("CSP:Next", "Random provider is not available!");
 	}
 
-	if (hProvider != NULL)
+	EntropyCache &cache = ThreadCache();
+	uint rndNum = 0;
+
+	if (CACHE_SIZE - cache.Position < sizeof(uint))
 	{
-		BYTE* ptr = (BYTE*)&Output[0];
-		if (!::CryptGenRandom(hProvider, (DWORD)prcLen, ptr))
-		{
-			::CryptReleaseContext(hProvider, 0);
-			hProvider = NULL;
-			throw CryptoRandomException("CSP:GetBytes", "Call to CryptGenRandom failed; random provider is not available!");
-		}
+		Utility::MemUtils::Clear(cache.Buffer, cache.Position, CACHE_SIZE - cache.Position);
+		Fill(cache.Buffer.data(), CACHE_SIZE);
+		cache.Position = 0;
 	}
 
-	if (hProvider != NULL)
+	Utility::MemUtils::CopyToValue(cache.Buffer, cache.Position, rndNum, sizeof(uint));
+	Utility::MemUtils::Clear(cache.Buffer, cache.Position, sizeof(uint));
+	cache.Position += sizeof(uint);
+
+	return rndNum;
+}
+
+void CSP::Reset()
+{
+	EntropyCache &cache = ThreadCache();
+
+	Utility::MemUtils::Clear(cache.Buffer, 0, cache.Buffer.size());
+	cache.Position = CACHE_SIZE;
+}
+
+//~~~Private Functions~~~//
+
+void CSP::Fill(byte* Output, size_t Length)
+{
+#if defined(CEX_OS_WINDOWS)
+
+	// the system preferred rng requires no provider handle, so nothing is acquired or released per call
+	while (Length != 0)
 	{
-		CryptReleaseContext(hProvider, 0);
-		hProvider = NULL;
+		const ULONG RNDLEN = static_cast<ULONG>(Utility::IntUtils::Min(Length, static_cast<size_t>(ULONG_MAX)));
+
+		if (!NT_SUCCESS(::BCryptGenRandom(NULL, reinterpret_cast<PUCHAR>(Output), RNDLEN, BCRYPT_USE_SYSTEM_PREFERRED_RNG)))
+		{
+			throw CryptoRandomException("CSP:GetBytes", "Call to BCryptGenRandom failed; random provider is not available!");
+		}
+
+		Output += RNDLEN;
+		Length -= RNDLEN;
 	}
 
 #elif defined(CEX_OS_ANDROID)
 
-	try
+	::arc4random_buf(Output, Length);
+
+#else
+
+#	if defined(CEX_HAS_GETRANDOM)
+	// getrandom blocks only until the kernel pool is first seeded, and never afterwards
+	static std::atomic<bool> hasCall(true);
+
+	while (Length != 0 && hasCall)
 	{
-		do
+		long rndLen = ::syscall(SYS_getrandom, Output, Length, 0);
+
+		if (rndLen < 0)
 		{
-			size_t prcRmd = Utility::IntUtils::Min(sizeof(uint), prcLen);
-			uint rndNum = arc4random();
-			Utility::MemUtils::Copy(rndNum, Output, prcOffset, prcRmd);
-			prcOffset += prcRmd;
-			prcLen -= prcRmd;
-		} 
-		while (prcLen != 0)
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			else if (errno == ENOSYS)
+			{
+				// kernel predates getrandom, use the device
+				hasCall = false;
+				break;
+			}
+			else
+			{
+				throw CryptoRandomException("CSP:GetBytes", "System RNG getrandom call failed!");
+			}
+		}
+
+		Output += rndLen;
+		Length -= static_cast<size_t>(rndLen);
 	}
-	catch (std::exception&)
+
+	if (Length == 0)
 	{
-		throw CryptoRandomException("CSP:GetBytes", "Call to arc4random failed; random provider is not available!");
+		return;
 	}
+#	endif
 
-#else
+	// the device descriptor is opened once, and held for the lifetime of the process
+	struct RngDevice
+	{
+		int Handle;
 
-	int fdHandle = ::open(CEX_SYSTEM_RNG_DEVICE, O_RDONLY | O_NOCTTY);
+		RngDevice()
+			:
+			Handle(::open(CEX_SYSTEM_RNG_DEVICE, O_RDONLY | O_NOCTTY | O_CLOEXEC))
+		{
+		}
 
-	if (fdHandle <= 0)
+		~RngDevice()
+		{
+			if (Handle >= 0)
+			{
+				::close(Handle);
+				Handle = -1;
+			}
+		}
+	};
+
+	static RngDevice device;
+
+	if (device.Handle < 0)
 	{
 		throw CryptoRandomException("CSP:GetBytes", "System RNG failed to open RNG device!");
 	}
 
-	do
+	while (Length != 0)
 	{
-		int rndLen = ::read(fdHandle, &Output[prcOffset], prcLen);
+		ssize_t rndLen = ::read(device.Handle, Output, Length);
 
 		if (rndLen < 0)
 		{
@@ -143,49 +299,32 @@ void CSP::GetBytes(std::vector<byte> &Output)
 			throw CryptoRandomException("CSP:GetBytes", "System RNG EOF on device!");
 		}
 
-		prcOffset += rndLen;
-		prcLen -= rndLen;
-	}
-	while (prcLen != 0)
-
-	if (fdHandle > 0)
-	{
-		::close(fdHandle);
-		fdHandle = 0;
+		Output += rndLen;
+		Length -= static_cast<size_t>(rndLen);
 	}
 
 #endif
 }
 
-void CSP::GetBytes(std::vector<byte> &Output, size_t Offset, size_t Length)
+CSP::EntropyCache &CSP::ThreadCache()
 {
-	CexAssert(Offset + Length <= Output.size(), "the array is too small to fulfill this request");
-
-	std::vector<byte> rnd(Length);
-	GetBytes(rnd);
-	Utility::MemUtils::Copy(rnd, 0, Output, Offset, rnd.size());
-}
+	static thread_local EntropyCache cache;
 
-std::vector<byte> CSP::GetBytes(size_t Length)
-{
-	std::vector<byte> data(Length);
-	GetBytes(data);
+#if !defined(CEX_OS_WINDOWS) && !defined(CEX_OS_ANDROID)
+	// register the fork handler once per process
+	static const int FRKREG = ::pthread_atfork(nullptr, nullptr, &OnFork);
+	static_cast<void>(FRKREG);
 
-	return data;
-}
-
-uint CSP::Next()
-{
-	uint rndNum = 0;
-	std::vector<byte> rndData(sizeof(uint));
-	GetBytes(rndData);
-	Utility::MemUtils::CopyToValue(rndData, 0, rndNum, sizeof(uint));
-
-	return rndNum;
-}
+	if (cache.Generation != ForkCount)
+	{
+		// the cache was inherited from the parent process; discard it
+		Utility::MemUtils::Clear(cache.Buffer, 0, cache.Buffer.size());
+		cache.Position = CACHE_SIZE;
+		cache.Generation = ForkCount;
+	}
+#endif
 
-void CSP::Reset()
-{
+	return cache;
 }
 
 NAMESPACE_PROVIDEREND
@@ -19,8 +19,14 @@ NAMESPACE_PROVIDER
 /// </example>
 /// 
 /// <remarks>
-/// <para>On a windows system, the RNGCryptoServiceProvider CryptGenRandom() function is used to generate output. 
-/// On Android, the arc4random() function is used. All other systems (Linux, Unix), use dev/random.</para>
+/// <para>On a windows system, the system preferred BCryptGenRandom() generator is used to generate output. 
+/// On Android, the arc4random_buf() function is used. On Linux the getrandom() system call is used when the kernel supports it, 
+/// all other systems (Unix, or a Linux kernel without getrandom), read from dev/urandom through a descriptor that is opened once and held for the lifetime of the process.</para>
+///
+/// <para>Requests smaller than the cache size are served from a per-thread entropy cache that is refilled in bulk from the system generator. 
+/// The cache is thread local, so no locking is required, bytes are erased from the cache as they are handed out, and the remainder is erased when the thread exits or Reset() is called. 
+/// On posix systems, a fork() invalidates the cache in the child process, so parent and child never share buffered output. 
+/// Requests of the cache size or larger are written directly to the output by the system generator.</para>
 ///
 /// <description>Guiding Publications::</description>
 /// <list type="number">
@@ -35,6 +41,9 @@ class CSP final : public IProvider
 private:
 
 	static const std::string CLASS_NAME;
+	static const size_t CACHE_SIZE = 4096;
+
+	struct EntropyCache;
 
 	bool m_isAvailable;
 
@@ -122,9 +131,14 @@ public:
 	uint Next() override;
 
 	/// <summary>
-	/// Reset the internal state
+	/// Reset the internal state; erases the calling threads entropy cache
 	/// </summary>
 	void Reset() override;
+
+private:
+
+	static void Fill(byte* Output, size_t Length);
+	static EntropyCache &ThreadCache();
 };
 
 NAMESPACE_PROVIDEREND
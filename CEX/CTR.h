@@ -29,6 +29,7 @@
 #define CEX_CTR_H
 
 #include "ICipherMode.h"
+#include "CTRT.h"
 
 NAMESPACE_MODE
 
@@ -87,6 +88,7 @@ NAMESPACE_MODE
 /// <item><description>A cipher mode constructor can either be initialized with a block cipher instance, or using the block ciphers enumeration name.</description></item>
 /// <item><description>A block cipher instance created using the enumeration constructor, is automatically deleted when the class is destroyed.</description></item>
 /// <item><description>The Transform functions are virtual, and can be accessed from an ICipherMode instance.</description></item>
+/// <item><description>The mode is a thin adapter over CTRT&lt;IBlockCipher&gt;; use CTRT with a final cipher type (ex. CTRT&lt;AHX&gt;) to bind the engine at compile time.</description></item>
 /// <item><description>The EncryptBlock function can only be accessed through the class instance.</description></item>
 /// <item><description>The transformation methods can not be called until the Initialize(bool, ISymmetricKey) function has been called.</description></item>
 /// <item><description>If the system supports Parallel processing, and IsParallel() is set to true; passing an input block of ParallelBlockSize() to the transform will be auto parallelized.</description></item>
@@ -108,17 +110,12 @@ class CTR final : public ICipherMode
 private:
 
 	static const size_t BLOCK_SIZE = 16;
-	static const std::string CLASS_NAME;
 
 	std::unique_ptr<IBlockCipher> m_blockCipher;
 	BlockCiphers m_cipherType;
-	std::vector<byte> m_ctrVector;
+	CTRT<IBlockCipher> m_ctrMode;
 	bool m_destroyEngine;
 	bool m_isDestroyed;
-	bool m_isEncryption;
-	bool m_isInitialized;
-	bool m_isLoaded;
-	ParallelOptions m_parallelProfile;
 
 public:
 
@@ -212,9 +209,12 @@ public:
 	const std::string Name() override;
 
 	/// <summary>
-	/// Read Only: The CBC initialization vector (exposed for CMAC)
+	/// Read/Write: The counter; the next Transform encrypts this value as its first key stream block, and increments it for each block.
+	/// <para>Writing the counter moves the key stream without re-keying the cipher: the GCM and EAX modes load each new nonce this way,
+	/// and the stream processors set the counter of a block offset. The vector must remain BlockSize() bytes in length, 
+	/// and a counter value must never be used twice with the same key.</para>
 	/// </summary>
-	const std::vector<byte> &Nonce() { return m_ctrVector; }
+	std::vector<byte> &Nonce() { return m_ctrMode.Nonce(); }
 
 	/// <summary>
 	/// Read Only: Parallel block size; the byte-size of the input/output data arrays passed to a transform that trigger parallel processing.
@@ -307,13 +307,6 @@ public:
 	/// <param name="Length">The number of bytes to transform</param>
 	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
 
-private:
-
-	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Generate(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter);
-	void Scope();
-	void ProcessParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
-	void ProcessSequential(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
 };
 
 NAMESPACE_MODEEND
@@ -0,0 +1,452 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// A compile-time composed integer Counter Mode (CTR) template.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_CTRT_H
+#define CEX_CTRT_H
+
+#include "ICipherMode.h"
+#include "Instrumentation.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+#include "ParallelUtils.h"
+#include "SymmetricKeyView.h"
+
+NAMESPACE_MODE
+
+/// <summary>
+/// A Big-Endian integer Counter Mode composed at compile time with its block cipher engine
+/// </summary>
+///
+/// <example>
+/// <description>Encrypting with an AES-NI engine bound to the mode:</description>
+/// <code>
+/// AHX engine;
+/// CTRT&lt;AHX&gt; cipher(&amp;engine);
+/// // initialize for encryption
+/// cipher.Initialize(true, SymmetricKey(Key, Nonce));
+/// // encrypt a length of bytes
+/// cipher.Transform(Input, 0, Output, 0, Input.size());
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <para>The template holds the complete CTR implementation; the CTR class is a thin ICipherMode adapter over CTRT&lt;IBlockCipher&gt;. \n
+/// When T is a final cipher class (AHX, RHX, SHX, THX), every call into the engine is bound statically,
+/// so the compiler can inline the ciphers Transform512/1024/2048 kernels into the counter loop, removing the virtual dispatch and the call boundary on every block.
+/// Output is identical to the CTR class for the same cipher, key and counter.</para>
+///
+/// <list type="bullet">
+/// <item><description>The engine is not owned by the template, and must outlive it.</description></item>
+/// <item><description>T must expose the IBlockCipher member functions used by the mode; any IBlockCipher derived class qualifies.</description></item>
+/// <item><description>Parallel processing and the ParallelProfile() behave exactly as in the CTR class.</description></item>
+/// </list>
+/// </remarks>
+template<typename T>
+class CTRT final
+{
+private:
+
+	static const size_t BLOCK_SIZE = 16;
+	static const std::string CLASS_NAME;
+
+	T* m_blockCipher;
+	std::vector<byte> m_ctrBlock;
+	std::vector<byte> m_ctrVector;
+	bool m_isEncryption;
+	bool m_isInitialized;
+	ParallelOptions m_parallelProfile;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	CTRT(const CTRT&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	CTRT& operator=(const CTRT&) = delete;
+
+	/// <summary>
+	/// Default constructor: default is restricted, this function has been deleted
+	/// </summary>
+	CTRT() = delete;
+
+	/// <summary>
+	/// Initialize the Cipher Mode using a block cipher instance
+	/// </summary>
+	///
+	/// <param name="Cipher">The uninitialized block cipher instance; can not be null, and is not deleted by this class</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if a null block cipher is used</exception>
+	explicit CTRT(T* Cipher)
+		:
+		m_blockCipher(Cipher != nullptr ? Cipher :
+			throw CryptoCipherModeException("CTR:CTor", "The Cipher can not be null!")),
+		m_ctrBlock(16 * BLOCK_SIZE),
+		m_ctrVector(BLOCK_SIZE),
+		m_isEncryption(false),
+		m_isInitialized(false),
+		m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true)
+	{
+		m_parallelProfile.Calibrate(Name());
+	}
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~CTRT()
+	{
+		m_blockCipher = nullptr;
+		m_isEncryption = false;
+		m_isInitialized = false;
+		m_parallelProfile.Reset();
+
+		Utility::IntUtils::ClearVector(m_ctrBlock);
+		Utility::IntUtils::ClearVector(m_ctrVector);
+	}
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: Block size of internal cipher in bytes
+	/// </summary>
+	const size_t BlockSize() { return BLOCK_SIZE; }
+
+	/// <summary>
+	/// Read Only: The underlying Block Cipher instance
+	/// </summary>
+	T* Engine() { return m_blockCipher; }
+
+	/// <summary>
+	/// Read Only: True if initialized for encryption, False for decryption
+	/// </summary>
+	const bool IsEncryption() { return m_isEncryption; }
+
+	/// <summary>
+	/// Read Only: The Block Cipher is ready to transform data
+	/// </summary>
+	const bool IsInitialized() { return m_isInitialized; }
+
+	/// <summary>
+	/// Read Only: Processor parallelization availability
+	/// </summary>
+	const bool IsParallel() { return m_parallelProfile.IsParallel(); }
+
+	/// <summary>
+	/// Read Only: Array of allowed cipher input key byte-sizes
+	/// </summary>
+	const std::vector<SymmetricKeySize> &LegalKeySizes() { return m_blockCipher->LegalKeySizes(); }
+
+	/// <summary>
+	/// Read Only: The cipher modes class name
+	/// </summary>
+	const std::string Name() { return CLASS_NAME + "-" + m_blockCipher->Name(); }
+
+	/// <summary>
+	/// Read/Write: The counter; the next Transform encrypts this value as its first key stream block, and increments it for each block.
+	/// <para>Writing the counter moves the key stream without re-keying the cipher: the GCM and EAX modes load each new nonce this way,
+	/// and the stream processors set the counter of a block offset. The vector must remain BlockSize() bytes in length, 
+	/// and a counter value must never be used twice with the same key.</para>
+	/// </summary>
+	std::vector<byte> &Nonce() { return m_ctrVector; }
+
+	/// <summary>
+	/// Read Only: Parallel block size; the byte-size of the input/output data arrays passed to a transform that trigger parallel processing
+	/// </summary>
+	const size_t ParallelBlockSize() { return m_parallelProfile.ParallelBlockSize(); }
+
+	/// <summary>
+	/// Read/Write: Parallel and SIMD capability flags and sizes
+	/// </summary>
+	ParallelOptions &ParallelProfile() { return m_parallelProfile; }
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Encrypt or decrypt a single block of bytes using offset parameters.
+	/// <para>Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of bytes</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of transformed bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	void EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+	{
+		CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+		CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
+
+		m_blockCipher->EncryptBlock(m_ctrVector, 0, Output, OutOffset);
+		Utility::IntUtils::BeIncrement8(m_ctrVector);
+		Utility::MemUtils::XOR128(Input, InOffset, Output, OutOffset);
+	}
+
+	/// <summary>
+	/// Initialize the Cipher instance
+	/// </summary>
+	///
+	/// <param name="Encryption">True if cipher is used for encryption, False to decrypt</param>
+	/// <param name="KeyParams">SymmetricKey containing the encryption Key and Initialization Vector</param>
+	///
+	/// <exception cref="CryptoSymmetricCipherException">Thrown if an invalid key or nonce size, or parallel block size is used</exception>
+	void Initialize(bool Encryption, ISymmetricKey &KeyParams)
+	{
+		Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+		if (!SymmetricKeySize::Contains(LegalKeySizes(), kv.Key().size(), kv.Nonce().size()))
+		{
+			throw CryptoSymmetricCipherException("CTR:Initialize", "Invalid key or nonce size! Key and nonce must be one of the LegalKeySizes() members in length.");
+		}
+		if (m_parallelProfile.IsParallel() && m_parallelProfile.ParallelBlockSize() < m_parallelProfile.ParallelMinimumSize() || m_parallelProfile.ParallelBlockSize() > m_parallelProfile.ParallelMaximumSize())
+		{
+			throw CryptoSymmetricCipherException("CTR:Initialize", "The parallel block size is out of bounds!");
+		}
+		if (m_parallelProfile.IsParallel() && m_parallelProfile.ParallelBlockSize() % m_parallelProfile.ParallelMinimumSize() != 0)
+		{
+			throw CryptoSymmetricCipherException("CTR:Initialize", "The parallel block size must be evenly aligned to the ParallelMinimumSize!");
+		}
+
+		Scope();
+		m_blockCipher->Initialize(true, KeyParams);
+		m_ctrVector = kv.Nonce();
+		m_isEncryption = Encryption;
+		m_isInitialized = true;
+	}
+
+	/// <summary>
+	/// Set the maximum number of threads allocated when using multi-threaded processing
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	void ParallelMaxDegree(size_t Degree)
+	{
+		CexAssert(Degree != 0, "parallel degree can not be zero");
+		CexAssert(Degree % 2 == 0, "parallel degree must be an even number");
+		CexAssert(Degree <= m_parallelProfile.ProcessorCount(), "parallel degree can not exceed processor count");
+
+		m_parallelProfile.SetMaxDegree(Degree);
+	}
+
+	/// <summary>
+	/// Transform a length of bytes with offset parameters.
+	/// <para>If IsParallel() is set to true, and the length is at least ParallelBlockSize(), the transform is run in parallel processing mode.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of bytes to transform</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of transformed bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+	{
+		CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::CipherMode, CLASS_NAME, Length);
+
+		CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+		CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the the block-size!");
+
+		const size_t PRLBLK = m_parallelProfile.ParallelBlockSize();
+
+		if (m_parallelProfile.IsParallel() && Length >= PRLBLK)
+		{
+			CEX_INSTRUMENT_PARALLEL();
+
+			const size_t BLKCNT = Length / PRLBLK;
+
+			for (size_t i = 0; i < BLKCNT; ++i)
+			{
+				ProcessParallel(Input, InOffset + (i * PRLBLK), Output, OutOffset + (i * PRLBLK), PRLBLK);
+			}
+
+			const size_t RMDSZE = Length - (PRLBLK * BLKCNT);
+
+			if (RMDSZE != 0)
+			{
+				const size_t BLKOFT = (PRLBLK * BLKCNT);
+				ProcessSequential(Input, InOffset + BLKOFT, Output, OutOffset + BLKOFT, RMDSZE);
+			}
+		}
+		else
+		{
+			ProcessSequential(Input, InOffset, Output, OutOffset, Length);
+		}
+	}
+
+private:
+
+	void Generate(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter, std::vector<byte> &Block)
+	{
+		// Block is the counter staging scratch; at least 16 cipher blocks, owned by the caller so the hot path never allocates
+		size_t blkCtr = 0;
+
+#if defined(__AVX512__)
+		const size_t AVX512BLK = 16 * BLOCK_SIZE;
+		if (Length >= AVX512BLK)
+		{
+			CEX_INSTRUMENT_SIMD(512);
+
+			const size_t PBKALN = Length - (Length % AVX512BLK);
+
+			// stagger counters and process 16 blocks with avx512
+			while (blkCtr != PBKALN)
+			{
+				Utility::IntUtils::BeIncrementBlocks8(Counter, Block, 0, 16);
+				m_blockCipher->Transform2048(Block, 0, Output, OutOffset + blkCtr);
+				blkCtr += AVX512BLK;
+			}
+		}
+#elif defined(__AVX2__)
+		const size_t AVX2BLK = 8 * BLOCK_SIZE;
+		if (Length >= AVX2BLK)
+		{
+			CEX_INSTRUMENT_SIMD(256);
+
+			const size_t PBKALN = Length - (Length % AVX2BLK);
+
+			// stagger counters and process 8 blocks with avx2
+			while (blkCtr != PBKALN)
+			{
+				Utility::IntUtils::BeIncrementBlocks8(Counter, Block, 0, 8);
+				m_blockCipher->Transform1024(Block, 0, Output, OutOffset + blkCtr);
+				blkCtr += AVX2BLK;
+			}
+		}
+#elif defined(__AVX__)
+		const size_t AVXBLK = 4 * BLOCK_SIZE;
+		if (Length >= AVXBLK)
+		{
+			CEX_INSTRUMENT_SIMD(128);
+
+			const size_t PBKALN = Length - (Length % AVXBLK);
+
+			// 4 blocks with avx
+			while (blkCtr != PBKALN)
+			{
+				Utility::IntUtils::BeIncrementBlocks8(Counter, Block, 0, 4);
+				m_blockCipher->Transform512(Block, 0, Output, OutOffset + blkCtr);
+				blkCtr += AVXBLK;
+			}
+		}
+#endif
+
+		const size_t BLKALN = Length - (Length % BLOCK_SIZE);
+		while (blkCtr != BLKALN)
+		{
+			m_blockCipher->EncryptBlock(Counter, 0, Output, OutOffset + blkCtr);
+			Utility::IntUtils::BeIncrement8(Counter);
+			blkCtr += BLOCK_SIZE;
+		}
+
+		if (blkCtr != Length)
+		{
+			m_blockCipher->EncryptBlock(Counter, 0, Block, 0);
+			const size_t FNLSZE = Length % BLOCK_SIZE;
+			Utility::MemUtils::Copy(Block, 0, Output, OutOffset + (Length - FNLSZE), FNLSZE);
+			Utility::IntUtils::BeIncrement8(Counter);
+		}
+	}
+
+	void ProcessParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+	{
+		const size_t OUTSZE = Output.size() - OutOffset < Length ? Output.size() - OutOffset : Length;
+		const size_t CNKSZE = m_parallelProfile.ParallelBlockSize() / m_parallelProfile.ParallelMaxDegree();
+		const size_t CTRLEN = (CNKSZE / BLOCK_SIZE);
+		std::vector<byte> tmpCtr(m_ctrVector.size());
+
+		Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Input, InOffset, &Output, OutOffset, &tmpCtr, CNKSZE, CTRLEN](size_t i)
+		{
+			// thread level counter
+			std::vector<byte> thdCtr(m_ctrVector.size());
+			// thread level counter staging block; the class scratch buffer can not be shared across threads
+			std::vector<byte> thdBlk(m_ctrBlock.size());
+			// offset counter by chunk size / block size
+			Utility::IntUtils::BeIncrease8(m_ctrVector, thdCtr, CTRLEN * i);
+			// generate random at output offset
+			this->Generate(Output, OutOffset + (i * CNKSZE), CNKSZE, thdCtr, thdBlk);
+			// xor with input at offsets
+			Utility::MemUtils::XorBlock(Input, InOffset + (i * CNKSZE), Output, OutOffset + (i * CNKSZE), CNKSZE);
+
+			// store last counter
+			if (i == m_parallelProfile.ParallelMaxDegree() - 1)
+			{
+				Utility::MemUtils::COPY128(thdCtr, 0, tmpCtr, 0);
+			}
+		});
+
+		// copy last counter to class variable
+		Utility::MemUtils::COPY128(tmpCtr, 0, m_ctrVector, 0);
+
+		// last block processing
+		const size_t ALNSZE = CNKSZE * m_parallelProfile.ParallelMaxDegree();
+		if (ALNSZE < OUTSZE)
+		{
+			const size_t FNLSZE = (Output.size() - OutOffset) % ALNSZE;
+			Generate(Output, ALNSZE, FNLSZE, m_ctrVector, m_ctrBlock);
+
+			for (size_t i = ALNSZE; i < OUTSZE; i++)
+			{
+				Output[i] ^= Input[i];
+			}
+		}
+	}
+
+	void ProcessSequential(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+	{
+		// generate random
+		Generate(Output, OutOffset, Length, m_ctrVector, m_ctrBlock);
+		// get block aligned
+		size_t ALNSZE = Length - (Length % BLOCK_SIZE);
+
+		if (ALNSZE != 0)
+		{
+			Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, ALNSZE);
+		}
+
+		// get the remaining bytes
+		if (ALNSZE != Length)
+		{
+			for (size_t i = ALNSZE; i < Length; ++i)
+			{
+				Output[i + OutOffset] ^= Input[i + InOffset];
+			}
+		}
+	}
+
+	void Scope()
+	{
+		if (!m_parallelProfile.IsDefault())
+		{
+			m_parallelProfile.Calculate();
+		}
+	}
+};
+
+template<typename T>
+const std::string CTRT<T>::CLASS_NAME("CTR");
+
+NAMESPACE_MODEEND
+#endif
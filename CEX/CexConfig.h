@@ -382,6 +382,12 @@ inline static void CexAssert(bool Condition, const T Message)
 // enabling this value will add cpu jitter to the ACP entropy collector (slightly stronger, but much slower)
 //#define CEX_ACP_JITTER
 
+// enables the io_uring read-ahead and write-behind path in the DirectStream class (linux only, requires linking to liburing)
+//#define CEX_HAS_IOURING
+
+// enables the call, byte and cycle counters at the cipher mode, digest, MAC, DRBG and asymmetric cipher boundaries, and on the internal phases of the asymmetric ciphers, read through the Instrumentation class (adds two timer calls to every instrumented call and phase step)
+//#define CEX_INSTRUMENTATION
+
 // AVX512 Capabilities Check
 // TODO: future expansion (if you can test it, I'll add it)
 // links: 
@@ -1,5 +1,6 @@
 #include "ChaCha20.h"
 #include "ChaCha.h"
+#include "SymmetricKeyView.h"
 #if defined(__AVX2__)
 #	include "UInt256.h"
 #elif defined(__AVX__)
@@ -28,6 +29,7 @@ ChaCha20::ChaCha20(size_t Rounds)
 	m_wrkState(14, 0)
 {
 	Scope();
+	m_parallelProfile.Calibrate(Name());
 }
 
 ChaCha20::~ChaCha20()
@@ -107,14 +109,16 @@ const size_t ChaCha20::Rounds()
 
 void ChaCha20::Initialize(ISymmetricKey &KeyParams)
 {
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
 	// recheck params
 	Scope();
 
-	if (KeyParams.Nonce().size() != 8)
+	if (kv.Nonce().size() != 8)
 	{
 		throw CryptoSymmetricCipherException("ChaCha20:Initialize", "Requires exactly 8 bytes of Nonce!");
 	}
-	if (KeyParams.Key().size() != 16 && KeyParams.Key().size() != 32)
+	if (kv.Key().size() != 16 && kv.Key().size() != 32)
 	{
 		throw CryptoSymmetricCipherException("ChaCha20:Initialize", "Key must be 16 or 32 bytes!");
 	}
@@ -127,14 +131,14 @@ void ChaCha20::Initialize(ISymmetricKey &KeyParams)
 		throw CryptoSymmetricCipherException("ChaCha20:Initialize", "The parallel block size must be evenly aligned to the ParallelMinimumSize!");
 	}
 
-	if (KeyParams.Info().size() != 0)
+	if (kv.Info().size() != 0)
 	{
 		// custom code
-		Utility::MemUtils::Copy(KeyParams.Info(), 0, m_dstCode, 0, (KeyParams.Info().size() > m_dstCode.size()) ? m_dstCode.size() : KeyParams.Info().size());
+		Utility::MemUtils::Copy(kv.Info(), 0, m_dstCode, 0, (kv.Info().size() > m_dstCode.size()) ? m_dstCode.size() : kv.Info().size());
 	}
 	else
 	{
-		if (KeyParams.Key().size() == 32)
+		if (kv.Key().size() == 32)
 		{
 			m_dstCode.assign(SIGMA_INFO.begin(), SIGMA_INFO.end());
 		}
@@ -145,7 +149,7 @@ void ChaCha20::Initialize(ISymmetricKey &KeyParams)
 	}
 
 	Reset();
-	Expand(KeyParams.Key(), KeyParams.Nonce());
+	Expand(kv.Key(), kv.Nonce());
 	m_isInitialized = true;
 }
 
@@ -377,7 +381,7 @@ void ChaCha20::Process(const std::vector<byte> &Input, const size_t InOffset, st
 {
 	const size_t PRCSZE = (Length >= Input.size() - InOffset) && Length >= Output.size() - OutOffset ? IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) : Length;
 
-	if (!m_parallelProfile.IsParallel() || PRCSZE < m_parallelProfile.ParallelMinimumSize())
+	if (!m_parallelProfile.IsParallel() || PRCSZE < m_parallelProfile.ParallelBlockSize())
 	{
 		// generate random
 		Generate(Output, OutOffset, m_ctrVector, PRCSZE);
@@ -3,6 +3,7 @@
 #include "CipherModeFromName.h"
 #include "PaddingFromName.h"
 #include "StreamCipherFromName.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_PROCESSING
 
@@ -200,7 +201,9 @@ ParallelOptions &CipherStream::ParallelProfile()
 
 void CipherStream::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), kv.Key().size()))
 	{
 		throw CryptoProcessingException("CipherStream:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 	}
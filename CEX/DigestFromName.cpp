@@ -1,9 +1,12 @@
 #include "DigestFromName.h"
 #include "Blake512.h"
 #include "Blake256.h"
+#include "Blake3.h"
+#include "KangarooTwelve.h"
 #include "Keccak256.h"
 #include "Keccak512.h"
 #include "Keccak1024.h"
+#include "ParallelHash.h"
 #include "SHA256.h"
 #include "SHA512.h"
 #include "Skein256.h"
@@ -30,6 +33,16 @@ IDigest* DigestFromName::GetInstance(Digests DigestType, bool Parallel)
 				dgtPtr = new Digest::Blake512(Parallel);
 				break;
 			}
+			case Digests::Blake3:
+			{
+				dgtPtr = new Digest::Blake3(Parallel);
+				break;
+			}
+			case Digests::KangarooTwelve:
+			{
+				dgtPtr = new Digest::KangarooTwelve(Parallel);
+				break;
+			}
 			case Digests::Keccak256:
 			{
 				dgtPtr = new Digest::Keccak256(Parallel);
@@ -45,6 +58,16 @@ IDigest* DigestFromName::GetInstance(Digests DigestType, bool Parallel)
 				dgtPtr = new Digest::Keccak1024(Parallel);
 				break;
 			}
+			case Digests::ParallelHash128:
+			{
+				dgtPtr = new Digest::ParallelHash(Enumeration::ShakeModes::SHAKE128, Parallel);
+				break;
+			}
+			case Digests::ParallelHash256:
+			{
+				dgtPtr = new Digest::ParallelHash(Enumeration::ShakeModes::SHAKE256, Parallel);
+				break;
+			}
 			case Digests::SHA256:
 			{
 				dgtPtr = new Digest::SHA256(Parallel);
@@ -96,6 +119,7 @@ size_t DigestFromName::GetBlockSize(Digests DigestType)
 			break;
 		}
 		case Digests::Blake256:
+		case Digests::Blake3:
 		case Digests::SHA256:
 		case Digests::Skein512:
 		{
@@ -110,10 +134,17 @@ size_t DigestFromName::GetBlockSize(Digests DigestType)
 			break;
 		}
 		case Digests::Keccak256:
+		case Digests::ParallelHash256:
 		{
 			blkSize = 136;
 			break;
 		}
+		case Digests::KangarooTwelve:
+		case Digests::ParallelHash128:
+		{
+			blkSize = 168;
+			break;
+		}
 		case Digests::Keccak512:
 		case Digests::Keccak1024:
 		{
@@ -141,7 +172,10 @@ size_t DigestFromName::GetDigestSize(Digests DigestType)
 	switch (DigestType)
 	{
 		case Digests::Blake256:
+		case Digests::Blake3:
+		case Digests::KangarooTwelve:
 		case Digests::Keccak256:
+		case Digests::ParallelHash128:
 		case Digests::SHA256:
 		case Digests::Skein256:
 		{
@@ -150,6 +184,7 @@ size_t DigestFromName::GetDigestSize(Digests DigestType)
 		}
 		case Digests::Blake512:
 		case Digests::Keccak512:
+		case Digests::ParallelHash256:
 		case Digests::SHA512:
 		case Digests::Skein512:
 		{
@@ -184,9 +219,13 @@ size_t DigestFromName::GetPaddingSize(Digests DigestType)
 	{
 		case Digests::Blake256:
 		case Digests::Blake512:
+		case Digests::Blake3:
+		case Digests::KangarooTwelve:
 		case Digests::Keccak256:
 		case Digests::Keccak512:
 		case Digests::Keccak1024:
+		case Digests::ParallelHash128:
+		case Digests::ParallelHash256:
 		case Digests::Skein256:
 		case Digests::Skein512:
 		case Digests::Skein1024:
@@ -69,7 +69,23 @@ enum class Digests : byte
 	/// <summary>
 	/// The Skein digest with a 1024 bit return size
 	/// </summary>
-	Skein1024 = 14
+	Skein1024 = 14,
+	/// <summary>
+	/// The BLAKE3 digest with a 256 bit default return size
+	/// </summary>
+	Blake3 = 15,
+	/// <summary>
+	/// The KangarooTwelve (KT128) digest with a 256 bit default return size
+	/// </summary>
+	KangarooTwelve = 16,
+	/// <summary>
+	/// The SP800-185 ParallelHash128 digest with a 256 bit default return size
+	/// </summary>
+	ParallelHash128 = 17,
+	/// <summary>
+	/// The SP800-185 ParallelHash256 digest with a 512 bit default return size
+	/// </summary>
+	ParallelHash256 = 18
 };
 
 NAMESPACE_ENUMERATIONEND
@@ -0,0 +1,614 @@
+#include "DirectStream.h"
+#include "IntUtils.h"
+#include <cstring>
+
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+#	include <errno.h>
+#	include <fcntl.h>
+#	include <stdlib.h>
+#	include <sys/stat.h>
+#	include <sys/types.h>
+#	include <unistd.h>
+#	if defined(O_DIRECT)
+#		define CEX_DIRECT_FLAG O_DIRECT
+#	else
+#		define CEX_DIRECT_FLAG 0
+#	endif
+#endif
+
+NAMESPACE_IO
+
+const std::string DirectStream::CLASS_NAME("DirectStream");
+
+//~~~Constructor~~~//
+
+DirectStream::DirectStream(const std::string &FileName, FileAccess Access, size_t BufferSize)
+	:
+	m_bufferIndex(0),
+	m_bufferLength(0),
+	m_bufferOffset(0),
+	m_bufferData{ { nullptr, nullptr } },
+	m_bufferSize(BufferSize < SECTOR_SIZE ? SECTOR_SIZE : BufferSize + ((SECTOR_SIZE - (BufferSize % SECTOR_SIZE)) % SECTOR_SIZE)),
+	m_fileAccess(Access),
+	m_fileHandle(-1),
+	m_fileLength(0),
+	m_fileName(FileName),
+	m_filePosition(0),
+	m_isDestroyed(false),
+	m_isDirect(true),
+	m_isPending(false),
+	m_pendingLength(0),
+	m_pendingOffset(0)
+#if defined(CEX_HAS_IOURING) && defined(CEX_OS_LINUX)
+	, m_ioRing(),
+	m_hasRing(false)
+#endif
+{
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	const int OPNFLG = (Access == FileAccess::Read) ? O_RDONLY : O_WRONLY | O_CREAT | O_TRUNC;
+
+	m_fileHandle = ::open(m_fileName.c_str(), OPNFLG | CEX_DIRECT_FLAG, 0644);
+
+	if (m_fileHandle < 0 && errno == EINVAL)
+	{
+		// the file system does not support unbuffered access, fall back to buffered io
+		m_isDirect = false;
+		m_fileHandle = ::open(m_fileName.c_str(), OPNFLG, 0644);
+	}
+
+	if (m_fileHandle < 0)
+	{
+		throw CryptoProcessingException("DirectStream:CTor", "The file could not be opened!");
+	}
+
+	struct stat fst;
+
+	if (::fstat(m_fileHandle, &fst) != 0)
+	{
+		::close(m_fileHandle);
+		m_fileHandle = -1;
+		throw CryptoProcessingException("DirectStream:CTor", "The file size could not be read!");
+	}
+
+	m_fileLength = static_cast<ulong>(fst.st_size);
+
+	for (size_t i = 0; i < m_bufferData.size(); ++i)
+	{
+		void* ptr = nullptr;
+
+		if (::posix_memalign(&ptr, SECTOR_SIZE, m_bufferSize) != 0)
+		{
+			Destroy();
+			throw CryptoProcessingException("DirectStream:CTor", "The aligned buffers could not be allocated!");
+		}
+
+		m_bufferData[i] = static_cast<byte*>(ptr);
+	}
+
+#	if defined(CEX_HAS_IOURING) && defined(CEX_OS_LINUX)
+	// without a ring (old kernel, seccomp) all transfers are synchronous
+	m_hasRing = (::io_uring_queue_init(4, &m_ioRing, 0) == 0);
+#	endif
+#else
+	throw CryptoProcessingException("DirectStream:CTor", "Direct file access is not supported on this platform!");
+#endif
+}
+
+DirectStream::~DirectStream()
+{
+	try
+	{
+		Destroy();
+	}
+	catch (CryptoProcessingException&)
+	{
+		// a destructor can not report the failure; call Close to check the final write
+	}
+}
+
+//~~~Accessors~~~//
+
+const DirectStream::FileAccess DirectStream::Access()
+{
+	return m_fileAccess;
+}
+
+const bool DirectStream::CanRead()
+{
+	return m_fileAccess == FileAccess::Read;
+}
+
+const bool DirectStream::CanSeek()
+{
+	return m_fileAccess == FileAccess::Read;
+}
+
+const bool DirectStream::CanWrite()
+{
+	return m_fileAccess == FileAccess::Write;
+}
+
+const StreamModes DirectStream::Enumeral()
+{
+	return StreamModes::DirectStream;
+}
+
+std::string DirectStream::FileName()
+{
+	return m_fileName;
+}
+
+const bool DirectStream::IsDirect()
+{
+	return m_isDirect;
+}
+
+const ulong DirectStream::Length()
+{
+	return m_fileLength;
+}
+
+const std::string DirectStream::Name()
+{
+	return CLASS_NAME;
+}
+
+const ulong DirectStream::Position()
+{
+	return m_filePosition;
+}
+
+//~~~Public Functions~~~//
+
+void DirectStream::Close()
+{
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	if (m_fileHandle >= 0)
+	{
+		std::string errMsg;
+
+		try
+		{
+			WaitPending();
+
+			if (m_fileAccess == FileAccess::Write && m_bufferLength != 0)
+			{
+				// unbuffered writes must be sector sized; pad the tail, then trim the file to its logical length
+				const size_t PADLEN = (SECTOR_SIZE - (m_bufferLength % SECTOR_SIZE)) % SECTOR_SIZE;
+				std::memset(m_bufferData[m_bufferIndex] + m_bufferLength, 0, PADLEN);
+				WriteAt(m_bufferData[m_bufferIndex], m_bufferLength + PADLEN, m_bufferOffset);
+			}
+
+			if (m_fileAccess == FileAccess::Write && ::ftruncate(m_fileHandle, static_cast<off_t>(m_fileLength)) != 0)
+			{
+				errMsg = "The file could not be trimmed to its length!";
+			}
+		}
+		catch (CryptoProcessingException &ex)
+		{
+			// the handle is released before the failure is reported
+			errMsg = ex.Message();
+		}
+
+#	if defined(CEX_HAS_IOURING) && defined(CEX_OS_LINUX)
+		if (m_hasRing)
+		{
+			::io_uring_queue_exit(&m_ioRing);
+			m_hasRing = false;
+		}
+#	endif
+
+		::close(m_fileHandle);
+		m_fileHandle = -1;
+		m_bufferLength = 0;
+		m_bufferOffset = 0;
+		m_filePosition = 0;
+
+		if (!errMsg.empty())
+		{
+			throw CryptoProcessingException("DirectStream:Close", errMsg);
+		}
+	}
+#endif
+
+	m_bufferLength = 0;
+	m_bufferOffset = 0;
+	m_filePosition = 0;
+}
+
+void DirectStream::CopyTo(IByteStream* Destination)
+{
+	CexAssert(m_fileAccess == FileAccess::Read, "File is write only");
+	CexAssert(m_fileLength != 0, "stream is too short");
+
+	std::vector<byte> buffer(m_bufferSize);
+	size_t prcRead = 0;
+
+	Destination->Seek(0, IO::SeekOrigin::Begin);
+	m_filePosition = 0;
+
+	do
+	{
+		prcRead = Read(buffer, 0, buffer.size());
+
+		if (prcRead != 0)
+		{
+			Destination->Write(buffer, 0, prcRead);
+		}
+	}
+	while (prcRead != 0);
+}
+
+void DirectStream::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		std::string errMsg;
+
+		m_isDestroyed = true;
+
+		try
+		{
+			Close();
+		}
+		catch (CryptoProcessingException &ex)
+		{
+			// the buffers are released before the failure is reported
+			errMsg = ex.Message();
+		}
+
+		for (size_t i = 0; i < m_bufferData.size(); ++i)
+		{
+			if (m_bufferData[i] != nullptr)
+			{
+				std::memset(m_bufferData[i], 0, m_bufferSize);
+				::free(m_bufferData[i]);
+				m_bufferData[i] = nullptr;
+			}
+		}
+
+		m_fileLength = 0;
+
+		if (!errMsg.empty())
+		{
+			throw CryptoProcessingException("DirectStream:Destroy", errMsg);
+		}
+	}
+}
+
+size_t DirectStream::Read(std::vector<byte> &Output, size_t Offset, size_t Length)
+{
+	CexAssert(m_fileAccess == FileAccess::Read, "File is write only");
+	CexAssert(Offset + Length <= Output.size(), "the output array is too small");
+
+	if (Length > m_fileLength - m_filePosition)
+	{
+		Length = static_cast<size_t>(m_fileLength - m_filePosition);
+	}
+
+	size_t prcLen = 0;
+
+	while (prcLen != Length)
+	{
+		if (m_filePosition < m_bufferOffset || m_filePosition >= m_bufferOffset + m_bufferLength)
+		{
+			FillBuffer(m_filePosition);
+
+			if (m_filePosition >= m_bufferOffset + m_bufferLength)
+			{
+				// the file was truncated by another process
+				break;
+			}
+		}
+
+		const size_t BUFPOS = static_cast<size_t>(m_filePosition - m_bufferOffset);
+		const size_t RMDLEN = Utility::IntUtils::Min(Length - prcLen, m_bufferLength - BUFPOS);
+		std::memcpy(&Output[Offset + prcLen], m_bufferData[m_bufferIndex] + BUFPOS, RMDLEN);
+		prcLen += RMDLEN;
+		m_filePosition += RMDLEN;
+	}
+
+	return prcLen;
+}
+
+byte DirectStream::ReadByte()
+{
+	CexAssert(m_fileLength - m_filePosition >= 1, "Reached end of file");
+
+	std::vector<byte> tmp(1);
+	Read(tmp, 0, 1);
+
+	return tmp[0];
+}
+
+void DirectStream::Reset()
+{
+	if (m_fileAccess == FileAccess::Read)
+	{
+		m_filePosition = 0;
+	}
+	else
+	{
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+		WaitPending();
+
+		if (::ftruncate(m_fileHandle, 0) != 0)
+		{
+			throw CryptoProcessingException("DirectStream:Reset", "The file could not be truncated!");
+		}
+#endif
+		m_bufferLength = 0;
+		m_bufferOffset = 0;
+		m_fileLength = 0;
+		m_filePosition = 0;
+	}
+}
+
+void DirectStream::Seek(ulong Offset, SeekOrigin Origin)
+{
+	ulong pos;
+
+	if (Origin == SeekOrigin::Begin)
+	{
+		pos = Offset;
+	}
+	else if (Origin == SeekOrigin::End)
+	{
+		pos = m_fileLength - Offset;
+	}
+	else
+	{
+		pos = m_filePosition + Offset;
+	}
+
+	CexAssert(m_fileAccess == FileAccess::Read || pos == m_filePosition, "a write stream can not seek");
+	CexAssert(pos <= m_fileLength, "the position exceeds the stream length");
+
+	m_filePosition = pos;
+}
+
+void DirectStream::SetLength(ulong Length)
+{
+	CexAssert(m_fileAccess == FileAccess::Write, "File is read only");
+
+	if (Length > m_fileLength)
+	{
+		std::vector<byte> tmp(static_cast<size_t>(Utility::IntUtils::Min(Length - m_fileLength, static_cast<ulong>(m_bufferSize))));
+
+		while (m_fileLength != Length)
+		{
+			Write(tmp, 0, static_cast<size_t>(Utility::IntUtils::Min(Length - m_fileLength, static_cast<ulong>(tmp.size()))));
+		}
+	}
+	else if (Length < m_fileLength)
+	{
+		CexAssert(Length >= m_bufferOffset, "a write stream can only be shortened within the current buffer");
+
+		m_bufferLength = static_cast<size_t>(Length - m_bufferOffset);
+		m_fileLength = Length;
+		m_filePosition = Length;
+	}
+}
+
+void DirectStream::Write(const std::vector<byte> &Input, size_t Offset, size_t Length)
+{
+	CexAssert(m_fileAccess == FileAccess::Write, "File is read only");
+	CexAssert(Offset + Length <= Input.size(), "Input stream length exceeded");
+
+	size_t prcLen = 0;
+
+	while (prcLen != Length)
+	{
+		const size_t RMDLEN = Utility::IntUtils::Min(Length - prcLen, m_bufferSize - m_bufferLength);
+		std::memcpy(m_bufferData[m_bufferIndex] + m_bufferLength, &Input[Offset + prcLen], RMDLEN);
+		m_bufferLength += RMDLEN;
+		prcLen += RMDLEN;
+
+		if (m_bufferLength == m_bufferSize)
+		{
+			FlushBuffer();
+		}
+	}
+
+	m_filePosition += Length;
+	m_fileLength = m_filePosition;
+}
+
+void DirectStream::WriteByte(byte Value)
+{
+	std::vector<byte> tmp(1, Value);
+	Write(tmp, 0, 1);
+}
+
+//~~~Private Functions~~~//
+
+void DirectStream::FillBuffer(ulong Position)
+{
+	const ulong ALNPOS = Position - (Position % SECTOR_SIZE);
+	bool isFilled = false;
+
+	if (m_isPending)
+	{
+		const size_t PRFLEN = WaitPending();
+
+		if (m_pendingOffset == ALNPOS)
+		{
+			// the read-ahead buffer covers the position
+			m_bufferIndex ^= 1;
+			m_bufferLength = PRFLEN;
+			m_bufferOffset = ALNPOS;
+			isFilled = true;
+		}
+	}
+
+	if (!isFilled)
+	{
+		m_bufferLength = ReadAt(m_bufferData[m_bufferIndex], m_bufferSize, ALNPOS);
+		m_bufferOffset = ALNPOS;
+	}
+
+#if defined(CEX_HAS_IOURING) && defined(CEX_OS_LINUX)
+	if (m_hasRing && m_bufferLength == m_bufferSize && m_bufferOffset + m_bufferSize < m_fileLength)
+	{
+		Submit(m_bufferData[m_bufferIndex ^ 1], m_bufferSize, m_bufferOffset + m_bufferSize, false);
+	}
+#endif
+}
+
+void DirectStream::FlushBuffer()
+{
+	// the other buffer must be on disk before it is reused
+	WaitPending();
+	Submit(m_bufferData[m_bufferIndex], m_bufferLength, m_bufferOffset, true);
+	m_bufferIndex ^= 1;
+	m_bufferOffset += m_bufferLength;
+	m_bufferLength = 0;
+}
+
+size_t DirectStream::ReadAt(byte* Output, size_t Length, ulong Offset)
+{
+	size_t prcLen = 0;
+
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	// an unbuffered read past a short (end of file) transfer would be unaligned
+	while (prcLen != Length && Offset + prcLen < m_fileLength)
+	{
+		const ssize_t RDLEN = ::pread(m_fileHandle, Output + prcLen, Length - prcLen, static_cast<off_t>(Offset + prcLen));
+
+		if (RDLEN < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			throw CryptoProcessingException("DirectStream:ReadAt", "The file read failed!");
+		}
+		else if (RDLEN == 0)
+		{
+			break;
+		}
+
+		prcLen += static_cast<size_t>(RDLEN);
+	}
+#endif
+
+	return prcLen;
+}
+
+void DirectStream::Submit(byte* Buffer, size_t Length, ulong Offset, bool Write)
+{
+	m_pendingOffset = Offset;
+
+#if defined(CEX_HAS_IOURING) && defined(CEX_OS_LINUX)
+	if (m_hasRing)
+	{
+		struct io_uring_sqe* sqe = ::io_uring_get_sqe(&m_ioRing);
+
+		if (Write)
+		{
+			::io_uring_prep_write(sqe, m_fileHandle, Buffer, static_cast<uint>(Length), static_cast<ulong>(Offset));
+		}
+		else
+		{
+			::io_uring_prep_read(sqe, m_fileHandle, Buffer, static_cast<uint>(Length), static_cast<ulong>(Offset));
+		}
+
+		::io_uring_sqe_set_data(sqe, Buffer);
+
+		if (::io_uring_submit(&m_ioRing) < 0)
+		{
+			throw CryptoProcessingException("DirectStream:Submit", "The io request could not be queued!");
+		}
+
+		m_isPending = true;
+		m_pendingLength = Length;
+
+		return;
+	}
+#endif
+
+	if (Write)
+	{
+		WriteAt(Buffer, Length, Offset);
+		m_pendingLength = Length;
+	}
+	else
+	{
+		m_pendingLength = ReadAt(Buffer, Length, Offset);
+	}
+}
+
+size_t DirectStream::WaitPending()
+{
+	if (!m_isPending)
+	{
+		return 0;
+	}
+
+	m_isPending = false;
+
+#if defined(CEX_HAS_IOURING) && defined(CEX_OS_LINUX)
+	struct io_uring_cqe* cqe = nullptr;
+
+	if (::io_uring_wait_cqe(&m_ioRing, &cqe) < 0 || cqe == nullptr)
+	{
+		throw CryptoProcessingException("DirectStream:WaitPending", "The io request could not be completed!");
+	}
+
+	const int RESLEN = cqe->res;
+	byte* buf = static_cast<byte*>(::io_uring_cqe_get_data(cqe));
+	::io_uring_cqe_seen(&m_ioRing, cqe);
+
+	if (RESLEN < 0)
+	{
+		throw CryptoProcessingException("DirectStream:WaitPending", "The io request failed!");
+	}
+
+	size_t prcLen = static_cast<size_t>(RESLEN);
+
+	if (prcLen != m_pendingLength)
+	{
+		// complete a short transfer synchronously
+		if (m_fileAccess == FileAccess::Write)
+		{
+			WriteAt(buf + prcLen, m_pendingLength - prcLen, m_pendingOffset + prcLen);
+			prcLen = m_pendingLength;
+		}
+		else
+		{
+			prcLen += ReadAt(buf + prcLen, m_pendingLength - prcLen, m_pendingOffset + prcLen);
+		}
+	}
+
+	return prcLen;
+#else
+	return m_pendingLength;
+#endif
+}
+
+void DirectStream::WriteAt(const byte* Input, size_t Length, ulong Offset)
+{
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	size_t prcLen = 0;
+
+	while (prcLen != Length)
+	{
+		const ssize_t WRTLEN = ::pwrite(m_fileHandle, Input + prcLen, Length - prcLen, static_cast<off_t>(Offset + prcLen));
+
+		if (WRTLEN < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			throw CryptoProcessingException("DirectStream:WriteAt", "The file write failed!");
+		}
+
+		prcLen += static_cast<size_t>(WRTLEN);
+	}
+#endif
+}
+
+NAMESPACE_IOEND
@@ -0,0 +1,254 @@
+#ifndef CEX_DIRECTSTREAM_H
+#define CEX_DIRECTSTREAM_H
+
+#include "IByteStream.h"
+
+#if defined(CEX_HAS_IOURING) && defined(CEX_OS_LINUX)
+#	include <liburing.h>
+#endif
+
+NAMESPACE_IO
+
+/// <summary>
+/// An unbuffered (direct I/O) file streaming container.
+/// <para>Reads and writes a file through sector aligned buffers, bypassing the operating system page cache.
+/// When the library is compiled with CEX_HAS_IOURING, the next buffer is read ahead (or the previous buffer written behind) asynchronously through io_uring, otherwise pread and pwrite are used.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Example of encrypting a file with direct streams:</description>
+/// <code>
+/// DirectStream inp(InputFile, DirectStream::FileAccess::Read);
+/// DirectStream out(OutputFile, DirectStream::FileAccess::Write);
+/// CipherStream cs(BlockCiphers::AHX, 22, CipherModes::CTR, PaddingModes::None);
+/// cs.Initialize(true, kp);
+/// cs.Write(&amp;inp, &amp;out);
+/// out.Close();
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <para>The stream is strictly sequential for writing; a write stream can not seek, and the final partial sector is padded for the unbuffered write and then truncated to the logical length when the stream is closed.
+/// Read streams are seekable, a seek inside the current buffer does not touch the disk.
+/// If the file system does not accept the O_DIRECT flag (tmpfs for example), the file is opened in buffered mode and the IsDirect() accessor returns false.</para>
+/// <para>This class is currently implemented on Linux/Posix systems only, the constructor throws on unsupported platforms.</para>
+/// </remarks>
+class DirectStream final : public IByteStream
+{
+public:
+
+	//~~~Enums~~~//
+
+	/// <summary>
+	/// File access type flags
+	/// </summary>
+	enum class FileAccess : int
+	{
+		Read = 1,
+		Write = 2
+	};
+
+private:
+
+	static const size_t BUFFER_SIZE = 1024 * 1024;
+	static const std::string CLASS_NAME;
+	static const size_t SECTOR_SIZE = 4096;
+
+	size_t m_bufferIndex;
+	size_t m_bufferLength;
+	ulong m_bufferOffset;
+	std::array<byte*, 2> m_bufferData;
+	size_t m_bufferSize;
+	FileAccess m_fileAccess;
+	int m_fileHandle;
+	ulong m_fileLength;
+	std::string m_fileName;
+	ulong m_filePosition;
+	bool m_isDestroyed;
+	bool m_isDirect;
+	bool m_isPending;
+	size_t m_pendingLength;
+	ulong m_pendingOffset;
+#if defined(CEX_HAS_IOURING) && defined(CEX_OS_LINUX)
+	struct io_uring m_ioRing;
+	bool m_hasRing;
+#endif
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	DirectStream(const DirectStream&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	DirectStream& operator=(const DirectStream&) = delete;
+
+	/// <summary>
+	/// Default constructor: default is restricted, this function has been deleted
+	/// </summary>
+	DirectStream() = delete;
+
+	/// <summary>
+	/// Constructor: instantiate this class with a file name and options
+	/// </summary>
+	///
+	/// <param name="FileName">The full path and name of the file</param>
+	/// <param name="Access">The level of access requested; Write creates or truncates the file</param>
+	/// <param name="BufferSize">The size of each of the two aligned transfer buffers; rounded up to a multiple of the sector size</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the file could not be opened or the buffers could not be allocated</exception>
+	explicit DirectStream(const std::string &FileName, FileAccess Access = FileAccess::Read, size_t BufferSize = BUFFER_SIZE);
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~DirectStream() override;
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The file read and write file access flags
+	/// </summary>
+	const FileAccess Access();
+
+	/// <summary>
+	/// Read Only: The stream can be read
+	/// </summary>
+	const bool CanRead() override;
+
+	/// <summary>
+	/// Read Only: The stream is seekable; only read streams can seek
+	/// </summary>
+	const bool CanSeek() override;
+
+	/// <summary>
+	/// Read Only: The stream can be written to
+	/// </summary>
+	const bool CanWrite() override;
+
+	/// <summary>
+	/// Read Only: The stream container type
+	/// </summary>
+	const StreamModes Enumeral() override;
+
+	/// <summary>
+	/// Read Only: The file name and path
+	/// </summary>
+	std::string FileName();
+
+	/// <summary>
+	/// Read Only: The file was opened for unbuffered access
+	/// </summary>
+	const bool IsDirect();
+
+	/// <summary>
+	/// Read Only: The stream length
+	/// </summary>
+	const ulong Length() override;
+
+	/// <summary>
+	/// Read Only: The streams class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Read Only: The streams current position
+	/// </summary>
+	const ulong Position() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Write any buffered data, trim the file to its logical length, and close the file
+	/// </summary>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the final write or the trim fails; the file handle is released either way</exception>
+	void Close() override;
+
+	/// <summary>
+	/// Copy this stream to another stream
+	/// </summary>
+	///
+	/// <param name="Destination">The destination stream</param>
+	void CopyTo(IByteStream* Destination) override;
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if closing the file fails; the finalizer suppresses the error</exception>
+	void Destroy() override;
+
+	/// <summary>
+	/// Copies a portion of the stream into an output buffer
+	/// </summary>
+	///
+	/// <param name="Output">The output array receiving the bytes</param>
+	/// <param name="Offset">Offset within the output array at which to begin</param>
+	/// <param name="Length">The number of bytes to read</param>
+	///
+	/// <returns>The number of bytes read</returns>
+	size_t Read(std::vector<byte> &Output, size_t Offset, size_t Length) override;
+
+	/// <summary>
+	/// Read a single byte from the stream
+	/// </summary>
+	///
+	/// <returns>The read byte value</returns>
+	byte ReadByte() override;
+
+	/// <summary>
+	/// Reset the stream; a read stream is set to position zero, a write stream is truncated
+	/// </summary>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the write stream can not be truncated</exception>
+	void Reset() override;
+
+	/// <summary>
+	/// Seek to a position within the stream; read streams only
+	/// </summary>
+	///
+	/// <param name="Offset">The offset position</param>
+	/// <param name="Origin">The starting point</param>
+	void Seek(ulong Offset, SeekOrigin Origin) override;
+
+	/// <summary>
+	/// Set the length of a write stream; the length can only be reduced to a position within the current buffer
+	/// </summary>
+	///
+	/// <param name="Length">The desired length</param>
+	void SetLength(ulong Length) override;
+
+	/// <summary>
+	/// Writes an input buffer to the stream
+	/// </summary>
+	///
+	/// <param name="Input">The input array to write to the stream</param>
+	/// <param name="Offset">Offset within the input array at which to begin</param>
+	/// <param name="Length">The number of bytes to write</param>
+	void Write(const std::vector<byte> &Input, size_t Offset, size_t Length) override;
+
+	/// <summary>
+	/// Write a single byte from the stream
+	/// </summary>
+	///
+	/// <param name="Value">The byte value to write</param>
+	void WriteByte(byte Value) override;
+
+private:
+
+	void FillBuffer(ulong Position);
+	void FlushBuffer();
+	size_t ReadAt(byte* Output, size_t Length, ulong Offset);
+	void Submit(byte* Buffer, size_t Length, ulong Offset, bool Write);
+	size_t WaitPending();
+	void WriteAt(const byte* Input, size_t Length, ulong Offset);
+};
+
+NAMESPACE_IOEND
+#endif
@@ -357,6 +357,7 @@ NAMESPACE_ROOT
 		class IByteStream {};
 		class MemoryStream {};
 		class SecureStream {};
+		class SeekableCipherStream {};
 		enum class SeekOrigin {};
 		class StreamReader {};
 		class StreamWriter {};
@@ -467,6 +468,8 @@ NAMESPACE_ROOT
 	*  @brief Cryptographic Processing Namespace
 	*/
 	NAMESPACE_PROCESSING
+		class AeadStream {};
+		class BatchStream {};
 		class CipherDescription {};
 		class CipherStream {};
 		class DigestStream {};
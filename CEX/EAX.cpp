@@ -1,7 +1,9 @@
 #include "EAX.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
 #include "ParallelUtils.h"
 #include "SymmetricKey.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_MODE
 
@@ -18,7 +20,6 @@ EAX::EAX(BlockCiphers CipherType)
 	m_aadPreserve(false),
 	m_autoIncrement(false),
 	m_blockSize(m_cipherMode->BlockSize()),
-	m_cipherKey(0),
 	m_cipherType(CipherType),
 	m_destroyEngine(true),
 	m_eaxNonce(0),
@@ -33,7 +34,8 @@ EAX::EAX(BlockCiphers CipherType)
 	m_macSize(m_blockSize),
 	m_msgTag(m_blockSize),
 	m_parallelProfile(m_blockSize, m_cipherMode->ParallelProfile().IsParallel(), m_cipherMode->ParallelProfile().ParallelBlockSize(),
-		m_cipherMode->ParallelProfile().ParallelMaxDegree(), true, m_cipherMode->Engine()->StateCacheSize(), true)
+		m_cipherMode->ParallelProfile().ParallelMaxDegree(), true, m_cipherMode->Engine()->StateCacheSize(), true),
+	m_tagBlock(m_blockSize)
 {
 	Scope();
 }
@@ -47,7 +49,6 @@ EAX::EAX(IBlockCipher* Cipher)
 	m_aadPreserve(false),
 	m_autoIncrement(false),
 	m_blockSize(m_cipherMode->BlockSize()),
-	m_cipherKey(0),
 	m_cipherType(Cipher->Enumeral()),
 	m_destroyEngine(false),
 	m_eaxNonce(0),
@@ -62,7 +63,8 @@ EAX::EAX(IBlockCipher* Cipher)
 	m_macSize(m_blockSize),
 	m_msgTag(m_blockSize),
 	m_parallelProfile(m_blockSize, m_cipherMode->ParallelProfile().IsParallel(), m_cipherMode->ParallelProfile().ParallelBlockSize(),
-		m_cipherMode->ParallelProfile().ParallelMaxDegree(), true, m_cipherMode->Engine()->StateCacheSize(), true)
+		m_cipherMode->ParallelProfile().ParallelMaxDegree(), true, m_cipherMode->Engine()->StateCacheSize(), true),
+	m_tagBlock(m_blockSize)
 {
 	Scope();
 }
@@ -85,11 +87,11 @@ EAX::~EAX()
 		m_parallelProfile.Reset();
 
 		Utility::IntUtils::ClearVector(m_aadData);
-		Utility::IntUtils::ClearVector(m_cipherKey);
 		Utility::IntUtils::ClearVector(m_eaxNonce);
 		Utility::IntUtils::ClearVector(m_eaxVector);
 		Utility::IntUtils::ClearVector(m_legalKeySizes);
 		Utility::IntUtils::ClearVector(m_msgTag);
+		Utility::IntUtils::ClearVector(m_tagBlock);
 
 		if (m_macGenerator != nullptr)
 		{
@@ -223,6 +225,8 @@ void EAX::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 
 void EAX::Finalize(std::vector<byte> &Output, const size_t Offset, const size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::CipherMode, CLASS_NAME, 0);
+
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized");
 	CexAssert(Length >= MIN_TAGSIZE || Length <= BLOCK_SIZE, "The cipher mode has not been initialized");
 
@@ -232,12 +236,14 @@ void EAX::Finalize(std::vector<byte> &Output, const size_t Offset, const size_t
 
 void EAX::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
 	// recheck params
 	Scope();
 
-	if (KeyParams.Key().size() == 0)
+	if (kv.Key().size() == 0)
 	{
-		if (KeyParams.Nonce() == m_eaxVector)
+		if (kv.Nonce() == m_eaxVector)
 		{
 			throw CryptoSymmetricCipherException("EAX:Initialize", "The nonce can not be zeroised or repeating!");
 		}
@@ -248,14 +254,13 @@ void EAX::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 	}
 	else
 	{
-		if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+		if (!SymmetricKeySize::Contains(LegalKeySizes(), kv.Key().size()))
 		{
 			throw CryptoSymmetricCipherException("EAX:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 		}
-		m_cipherKey = KeyParams.Key();
 	}
 
-	if (KeyParams.Nonce().size() != m_cipherMode->BlockSize())
+	if (kv.Nonce().size() != m_cipherMode->BlockSize())
 	{
 		throw CryptoSymmetricCipherException("EAX:Initialize", "Requires a nonce equal in size to the ciphers block size!");
 	}
@@ -269,24 +274,27 @@ void EAX::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 	}
 
 	m_isEncryption = Encryption;
-	m_eaxNonce = KeyParams.Nonce();
-	Key::Symmetric::SymmetricKey kp(m_cipherKey);
-	m_macGenerator->Initialize(kp);
-
-	UpdateTag(0, m_eaxNonce);
-	m_macGenerator->Finalize(m_eaxVector, 0);
-	m_macGenerator->Initialize(kp);
+	m_eaxNonce = kv.Nonce();
 
-	// hx extended ciphers
-	if (KeyParams.Info().size() != 0 && m_cipherMode->Engine()->KdfEngine() != Digests::None)
+	if (kv.Key().size() != 0)
 	{
-		m_cipherMode->Initialize(Encryption, Key::Symmetric::SymmetricKey(m_cipherKey, m_eaxVector, KeyParams.Info()));
-	}
-	else
-	{
-		m_cipherMode->Initialize(Encryption, Key::Symmetric::SymmetricKey(m_cipherKey, m_eaxVector));
+		Key::Symmetric::SymmetricKey kp(kv.Key());
+		m_macGenerator->Initialize(kp);
+
+		// hx extended ciphers
+		if (kv.Info().size() != 0 && m_cipherMode->Engine()->KdfEngine() != Digests::None)
+		{
+			m_cipherMode->Initialize(Encryption, Key::Symmetric::SymmetricKey(kv.Key(), m_eaxVector, kv.Info()));
+		}
+		else
+		{
+			m_cipherMode->Initialize(Encryption, Key::Symmetric::SymmetricKey(kv.Key(), m_eaxVector));
+		}
 	}
 
+	// the mac and counter share the keyed cipher, a new nonce only recalculates the nonce tag and the counter
+	LoadNonce();
+
 	if (m_isFinalized)
 	{
 		Utility::MemUtils::Clear(m_msgTag, 0, m_msgTag.size());
@@ -319,6 +327,8 @@ void EAX::SetAssociatedData(const std::vector<byte> &Input, const size_t Offset,
 
 void EAX::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::CipherMode, CLASS_NAME, Length);
+
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the the block-size!");
 
@@ -364,8 +374,8 @@ void EAX::CalculateMac()
 	if (m_autoIncrement)
 	{
 		Utility::IntUtils::BeIncrement8(m_eaxNonce);
-		std::vector<byte> zero(0);
-		Initialize(m_isEncryption, Key::Symmetric::SymmetricKey(zero, m_eaxNonce));
+		LoadNonce();
+		m_isInitialized = true;
 
 		if (m_aadPreserve)
 		{
@@ -393,6 +403,13 @@ void EAX::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	m_macGenerator->Update(Input, InOffset, m_blockSize);
 }
 
+void EAX::LoadNonce()
+{
+	UpdateTag(0, m_eaxNonce);
+	m_macGenerator->Finalize(m_eaxVector, 0);
+	Utility::MemUtils::COPY128(m_eaxVector, 0, m_cipherMode->Nonce(), 0);
+}
+
 void EAX::Reset()
 {
 	if (!m_aadPreserve)
@@ -424,9 +441,9 @@ void EAX::Scope()
 
 void EAX::UpdateTag(byte Tag, const std::vector<byte> &Nonce)
 {
-	std::vector<byte> tmp(m_macSize);
-	tmp[tmp.size() - 1] = Tag;
-	m_macGenerator->Update(tmp, 0, tmp.size());
+	Utility::MemUtils::Clear(m_tagBlock, 0, m_tagBlock.size());
+	m_tagBlock[m_tagBlock.size() - 1] = Tag;
+	m_macGenerator->Update(m_tagBlock, 0, m_tagBlock.size());
 
 	if (Nonce.size() != 0)
 	{
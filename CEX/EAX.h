@@ -127,7 +127,6 @@ private:
 	bool m_aadPreserve;
 	bool m_autoIncrement;
 	size_t m_blockSize;
-	std::vector<byte> m_cipherKey;
 	BlockCiphers m_cipherType;
 	bool m_destroyEngine;
 	std::vector<byte> m_eaxNonce;
@@ -142,6 +141,7 @@ private:
 	size_t m_macSize;
 	std::vector<byte> m_msgTag;
 	ParallelOptions m_parallelProfile;
+	std::vector<byte> m_tagBlock;
 
 public:
 
@@ -349,7 +349,7 @@ public:
 	/// </summary>
 	/// 
 	/// <param name="Encryption">True if cipher is used for encryption, false to decrypt</param>
-	/// <param name="KeyParams">SymmetricKey containing the encryption Key and Nonce</param>
+	/// <param name="KeyParams">SymmetricKey containing the encryption Key and Nonce; an empty key loads a new nonce only</param>
 	/// 
 	/// <exception cref="CryptoCipherModeException">Thrown if a null or invalid Key/Nonce is used</exception>
 	void Initialize(bool Encryption, ISymmetricKey &KeyParams) override;
@@ -414,6 +414,7 @@ private:
 	void CalculateMac();
 	void Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
 	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
+	void LoadNonce();
 	void Reset();
 	void Scope();
 	void UpdateTag(byte Tag, const std::vector<byte> &Nonce);
@@ -1,7 +1,9 @@
 #include "ECB.h"
 #include "BlockCipherFromName.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
 #include "ParallelUtils.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_MODE
 
@@ -21,6 +23,7 @@ ECB::ECB(BlockCiphers CipherType)
 	m_isLoaded(false),
 	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true)
 {
+	m_parallelProfile.Calibrate(Name());
 }
 
 ECB::ECB(IBlockCipher* Cipher)
@@ -35,6 +38,7 @@ ECB::ECB(IBlockCipher* Cipher)
 	m_isLoaded(false),
 	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true)
 {
+	m_parallelProfile.Calibrate(Name());
 }
 
 ECB::~ECB()
@@ -148,7 +152,9 @@ void ECB::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 
 void ECB::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), kv.Key().size()))
 	{
 		throw CryptoSymmetricCipherException("ECB:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 	}
@@ -179,6 +185,8 @@ void ECB::ParallelMaxDegree(size_t Degree)
 
 void ECB::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::CipherMode, CLASS_NAME, Length);
+
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the length");
 	CexAssert(Length % m_blockCipher->BlockSize() == 0, "The length must be evenly divisible by the block size");
@@ -187,6 +195,8 @@ void ECB::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 
 	if (m_parallelProfile.IsParallel() && Length >= PRLBLK)
 	{
+		CEX_INSTRUMENT_PARALLEL();
+
 		const size_t BLKCNT = Length / PRLBLK;
 
 		for (size_t i = 0; i < BLKCNT; ++i)
@@ -17,7 +17,6 @@ const std::string ECP::CLASS_NAME("ECP");
 ECP::ECP()
 	:
 	m_cipherMode(new Cipher::Symmetric::Block::Mode::CTR(Helper::BlockCipherFromName::GetInstance(Enumeration::BlockCiphers::AHX, Enumeration::Digests::SHA512, 38))),
-	m_hasTsc(Utility::SysUtils::HasRdtsc()),
 #if defined(CEX_OS_WINDOWS) || defined(CEX_OS_POSIX)
 	m_isAvailable(true)
 #else
@@ -29,7 +28,6 @@ ECP::ECP()
 
 ECP::~ECP()
 {
-	m_hasTsc = false;
 	m_isAvailable = false;
 
 	if (m_cipherMode != nullptr)
@@ -55,6 +53,17 @@ const std::string ECP::Name()
 	return CLASS_NAME; 
 }
 
+EntropyPool &ECP::Pool()
+{
+	// one pool per process, refreshed in the background and shared by every instance
+	static EntropyPool pool([]()
+	{
+		return Collect(Utility::SysUtils::HasRdtsc());
+	});
+
+	return pool;
+}
+
 //~~~Public Functions~~~//
 
 void ECP::GetBytes(std::vector<byte> &Output)
@@ -95,12 +104,12 @@ uint ECP::Next()
 
 void ECP::Reset()
 {
-	std::vector<byte> key;
+	std::vector<byte> key(KEY_SIZE);
 
 	try
 	{
-		// collect entropy, filter, and compress
-		key = Collect();
+		// extract the key from the background entropy pool
+		Pool().Extract(key);
 	}
 	catch (std::exception &ex)
 	{
@@ -122,12 +131,12 @@ void ECP::Reset()
 
 //~~~Private Functions~~~//
 
-std::vector<byte> ECP::Collect()
+std::vector<byte> ECP::Collect(bool HasTsc)
 {
 	const size_t KEYSZE = 72;
 	std::vector<byte> state(0);
 	std::vector<byte> buffer(KEYSZE);
-	ulong ts = Utility::SysUtils::TimeStamp(m_hasTsc);
+	ulong ts = Utility::SysUtils::TimeStamp(HasTsc);
 
 	CSP pvd;
 	pvd.GetBytes(buffer);
@@ -137,21 +146,21 @@ std::vector<byte> ECP::Collect()
 	Utility::ArrayUtils::Append(ts, state);
 	// collect the entropy
 	Utility::ArrayUtils::Append(DriveInfo(), state);
-	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(m_hasTsc) - ts, state);
+	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(HasTsc) - ts, state);
 	Utility::ArrayUtils::Append(MemoryInfo(), state);
-	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(m_hasTsc) - ts, state);
+	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(HasTsc) - ts, state);
 	Utility::ArrayUtils::Append(NetworkInfo(), state);
-	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(m_hasTsc) - ts, state);
+	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(HasTsc) - ts, state);
 	Utility::ArrayUtils::Append(ProcessInfo(), state);
-	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(m_hasTsc) - ts, state);
+	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(HasTsc) - ts, state);
 	Utility::ArrayUtils::Append(ProcessorInfo(), state);
-	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(m_hasTsc) - ts, state);
+	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(HasTsc) - ts, state);
 	Utility::ArrayUtils::Append(SystemInfo(), state);
-	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(m_hasTsc) - ts, state);
-	Utility::ArrayUtils::Append(TimeInfo(), state);
-	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(m_hasTsc) - ts, state);
+	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(HasTsc) - ts, state);
+	Utility::ArrayUtils::Append(TimeInfo(HasTsc), state);
+	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(HasTsc) - ts, state);
 	Utility::ArrayUtils::Append(UserInfo(), state);
-	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(m_hasTsc) - ts, state);
+	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(HasTsc) - ts, state);
 
 	// filter zeroes
 	Filter(state);
@@ -454,11 +463,11 @@ std::vector<byte> ECP::SystemInfo()
 	return state;
 }
 
-std::vector<byte> ECP::TimeInfo()
+std::vector<byte> ECP::TimeInfo(bool HasTsc)
 {
 	std::vector<byte> state(0);
 
-	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(m_hasTsc), state);
+	Utility::ArrayUtils::Append(Utility::SysUtils::TimeStamp(HasTsc), state);
 	Utility::ArrayUtils::Append(Utility::SysUtils::TimeCurrentNS(), state);
 	Utility::ArrayUtils::Append(Utility::SysUtils::TimeSinceBoot(), state);
 
@@ -2,6 +2,7 @@
 #define CEX_ECP_H
 
 #include "IProvider.h"
+#include "EntropyPool.h"
 #include "ICipherMode.h"
 
 NAMESPACE_PROVIDER
@@ -30,6 +31,10 @@ using Cipher::Symmetric::Block::Mode::ICipherMode;
 /// The 16 byte counter and the HKDF distribution code (personalization string) are then created with the system entropy provider and used to initialize the cipher. \n
 /// Output from the ECP provider is the product of encrypting the incrementing counter.
 /// </para>
+///
+/// <para>The system state collection runs on a low-priority background thread that keeps a process-wide Keccak-512 entropy pool fresh (see EntropyPool). \n
+/// Constructing or resetting an ECP extracts its cipher key from the pool and does not wait on a collection; only the first extraction in a process collects on the calling thread. \n
+/// The pool health and refresh latency counters are available through the Pool() accessor.</para>
 /// 
 /// <description>Guiding Publications::</description>
 /// <list type="number">
@@ -46,9 +51,9 @@ private:
 
 	static const std::string CLASS_NAME;
 	static const size_t DEF_STATECAP = 1024;
+	static const size_t KEY_SIZE = 64;
 
 	std::unique_ptr<ICipherMode> m_cipherMode;
-	bool m_hasTsc;
 	bool m_isAvailable;
 
 public:
@@ -92,6 +97,11 @@ public:
 	/// </summary>
 	const std::string Name() override;
 
+	/// <summary>
+	/// Read Only: The background entropy pool shared by all ECP instances; exposes the pool health and refresh latency counters
+	/// </summary>
+	static EntropyPool &Pool();
+
 	//~~~Public Functions~~~//
 
 	/// <summary>
@@ -143,17 +153,17 @@ public:
 
 private:
 
-	std::vector<byte> Collect();
-	std::vector<byte> ECP::Compress(std::vector<byte> &State);
-	void Filter(std::vector<byte> &State);
-	std::vector<byte> DriveInfo();
-	std::vector<byte> MemoryInfo();
-	std::vector<byte> NetworkInfo();
-	std::vector<byte> ProcessInfo();
-	std::vector<byte> ProcessorInfo();
-	std::vector<byte> SystemInfo();
-	std::vector<byte> TimeInfo();
-	std::vector<byte> UserInfo();
+	static std::vector<byte> Collect(bool HasTsc);
+	static std::vector<byte> Compress(std::vector<byte> &State);
+	static void Filter(std::vector<byte> &State);
+	static std::vector<byte> DriveInfo();
+	static std::vector<byte> MemoryInfo();
+	static std::vector<byte> NetworkInfo();
+	static std::vector<byte> ProcessInfo();
+	static std::vector<byte> ProcessorInfo();
+	static std::vector<byte> SystemInfo();
+	static std::vector<byte> TimeInfo(bool HasTsc);
+	static std::vector<byte> UserInfo();
 };
 
 NAMESPACE_PROVIDEREND
@@ -0,0 +1,328 @@
+#include "EntropyPool.h"
+#include "CSP.h"
+#include "IntUtils.h"
+#include "Keccak512.h"
+#include "MemUtils.h"
+#include "SysUtils.h"
+#include <chrono>
+
+#if defined(CEX_OS_WINDOWS)
+#	include <Windows.h>
+#elif defined(CEX_OS_LINUX)
+#	include <sys/resource.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#endif
+#if !defined(CEX_OS_WINDOWS) && !defined(CEX_OS_ANDROID)
+#	include <algorithm>
+#	include <pthread.h>
+#endif
+
+NAMESPACE_PROVIDER
+
+#if !defined(CEX_OS_WINDOWS) && !defined(CEX_OS_ANDROID)
+// the live pools of the process; their locks are held across a fork, so that a child never inherits a lock owned by a thread it does not have
+static std::mutex &ForkLock()
+{
+	static std::mutex lock;
+	return lock;
+}
+
+static std::vector<EntropyPool*> &ForkPools()
+{
+	static std::vector<EntropyPool*> pools;
+	return pools;
+}
+#endif
+
+//~~~Constructor~~~//
+
+EntropyPool::EntropyPool(std::function<std::vector<byte>()> Collector, size_t RefreshInterval)
+	:
+	m_collector(Collector),
+	m_extractCount(0),
+	m_isSeeded(false),
+	m_lastRefresh(0),
+	m_poolLock(),
+	m_poolState(POOL_SIZE),
+	m_processId(0),
+	m_refreshCount(0),
+	m_refreshFailures(0),
+	m_refreshInterval(RefreshInterval != 0 ? RefreshInterval : DEF_REFRESH),
+	m_refreshLatency(0),
+	m_refreshLatencyMax(0),
+	m_refreshState(nullptr),
+	m_stopLock()
+{
+#if !defined(CEX_OS_WINDOWS) && !defined(CEX_OS_ANDROID)
+	// register the fork handlers once per process
+	static const int FRKREG = ::pthread_atfork(&ForkPrepare, &ForkParent, &ForkChild);
+	static_cast<void>(FRKREG);
+
+	std::lock_guard<std::mutex> lock(ForkLock());
+	ForkPools().push_back(this);
+#endif
+}
+
+EntropyPool::~EntropyPool()
+{
+	if (m_refreshState != nullptr)
+	{
+		// the thread is detached; the pool is released only after the thread reports that it no longer uses it
+		std::unique_lock<std::mutex> lock(m_refreshState->Lock);
+		m_refreshState->IsRunning = false;
+		m_refreshState->Signal.notify_all();
+		m_refreshState->Signal.wait(lock, [this]() { return m_refreshState->IsStopped; });
+	}
+
+	Utility::MemUtils::Clear(m_poolState, 0, m_poolState.size());
+	m_extractCount = 0;
+	m_isSeeded = false;
+
+#if !defined(CEX_OS_WINDOWS) && !defined(CEX_OS_ANDROID)
+	std::lock_guard<std::mutex> lock(ForkLock());
+	ForkPools().erase(std::remove(ForkPools().begin(), ForkPools().end(), this), ForkPools().end());
+#endif
+}
+
+//~~~Accessors~~~//
+
+const ulong EntropyPool::Age()
+{
+	const ulong LSTTME = m_lastRefresh;
+
+	return (LSTTME == 0) ? 0 : (Microseconds() - LSTTME) / 1000;
+}
+
+const bool EntropyPool::IsSeeded()
+{
+	return m_isSeeded;
+}
+
+const ulong EntropyPool::RefreshCount()
+{
+	return m_refreshCount;
+}
+
+const ulong EntropyPool::RefreshFailures()
+{
+	return m_refreshFailures;
+}
+
+const ulong EntropyPool::RefreshLatency()
+{
+	return m_refreshLatency;
+}
+
+const ulong EntropyPool::RefreshLatencyMax()
+{
+	return m_refreshLatencyMax;
+}
+
+//~~~Public Functions~~~//
+
+void EntropyPool::Extract(std::vector<byte> &Output)
+{
+	if (!m_isSeeded)
+	{
+		// the first request seeds the pool on the calling thread
+		if (!Refresh())
+		{
+			throw CryptoRandomException("EntropyPool:Extract", "Entropy collection has failed!");
+		}
+	}
+
+	// the refresh thread is started by the first extraction, and again in a forked child, which inherits the pool but not the thread
+	const uint PRCID = Utility::SysUtils::ProcessId();
+
+	if (m_processId != PRCID)
+	{
+		Start(PRCID);
+	}
+
+	Digest::Keccak512 dgt;
+	std::vector<byte> salt(SALT_SIZE);
+	std::vector<byte> blk(POOL_SIZE);
+	std::vector<byte> ctr(2 * sizeof(ulong));
+	size_t outLen = Output.size();
+	size_t outOffset = 0;
+	CSP pvd;
+
+	// a fresh salt, so that a pool duplicated by a fork still produces distinct output
+	pvd.GetBytes(salt);
+
+	while (outLen != 0)
+	{
+		const size_t RMDSZE = Utility::IntUtils::Min(POOL_SIZE, outLen);
+		Utility::IntUtils::Le64ToBytes(++m_extractCount, ctr, 0);
+		Utility::IntUtils::Le64ToBytes(Microseconds(), ctr, sizeof(ulong));
+
+		{
+			std::lock_guard<std::mutex> lock(m_poolLock);
+
+			// output block: H(pool || counter || time || salt || 0)
+			dgt.Update(m_poolState, 0, m_poolState.size());
+			dgt.Update(ctr, 0, ctr.size());
+			dgt.Update(salt, 0, salt.size());
+			dgt.Update(static_cast<byte>(0x00));
+			dgt.Finalize(blk, 0);
+
+			// ratchet the pool: H(pool || counter || 1)
+			dgt.Update(m_poolState, 0, m_poolState.size());
+			dgt.Update(ctr, 0, sizeof(ulong));
+			dgt.Update(static_cast<byte>(0x01));
+			dgt.Finalize(m_poolState, 0);
+		}
+
+		Utility::MemUtils::Copy(blk, 0, Output, outOffset, RMDSZE);
+		outOffset += RMDSZE;
+		outLen -= RMDSZE;
+	}
+
+	Utility::MemUtils::Clear(blk, 0, blk.size());
+	Utility::MemUtils::Clear(salt, 0, salt.size());
+}
+
+bool EntropyPool::Refresh()
+{
+	const ulong STRTME = Microseconds();
+	std::vector<byte> state;
+
+	try
+	{
+		// collection is the slow part, and runs without holding the pool lock
+		state = m_collector();
+	}
+	catch (std::exception&)
+	{
+		++m_refreshFailures;
+		return false;
+	}
+
+	Digest::Keccak512 dgt;
+
+	{
+		std::lock_guard<std::mutex> lock(m_poolLock);
+
+		// absorb: H(pool || collected state)
+		dgt.Update(m_poolState, 0, m_poolState.size());
+		dgt.Update(state, 0, state.size());
+		dgt.Finalize(m_poolState, 0);
+		m_isSeeded = true;
+	}
+
+	Utility::MemUtils::Clear(state, 0, state.size());
+
+	const ulong ENDTME = Microseconds();
+	const ulong LATNCY = ENDTME - STRTME;
+
+	m_refreshLatency = LATNCY;
+
+	ulong latMax = m_refreshLatencyMax;
+
+	// the extracting threads and the refresh thread can complete a refresh at the same time
+	while (LATNCY > latMax && !m_refreshLatencyMax.compare_exchange_weak(latMax, LATNCY))
+	{
+	}
+
+	m_lastRefresh = ENDTME;
+	++m_refreshCount;
+
+	return true;
+}
+
+//~~~Private Functions~~~//
+
+#if !defined(CEX_OS_WINDOWS) && !defined(CEX_OS_ANDROID)
+void EntropyPool::ForkChild()
+{
+	for (EntropyPool* pool : ForkPools())
+	{
+		// the inherited state belongs to the parents refresh thread, which does not exist in the child, and still holds its reference;
+		// releasing the childs reference never destroys it, and the next extraction starts a thread with a new state
+		pool->m_refreshState.reset();
+		pool->m_processId = 0;
+		pool->m_poolLock.unlock();
+		pool->m_stopLock.unlock();
+	}
+
+	ForkLock().unlock();
+}
+
+void EntropyPool::ForkParent()
+{
+	for (EntropyPool* pool : ForkPools())
+	{
+		pool->m_poolLock.unlock();
+		pool->m_stopLock.unlock();
+	}
+
+	ForkLock().unlock();
+}
+
+void EntropyPool::ForkPrepare()
+{
+	ForkLock().lock();
+
+	for (EntropyPool* pool : ForkPools())
+	{
+		pool->m_stopLock.lock();
+		pool->m_poolLock.lock();
+	}
+}
+#endif
+
+ulong EntropyPool::Microseconds()
+{
+	return static_cast<ulong>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void EntropyPool::RefreshLoop(std::shared_ptr<RefreshState> State)
+{
+	SetLowPriority();
+
+	const std::chrono::milliseconds INTRVL(m_refreshInterval);
+	std::unique_lock<std::mutex> lock(State->Lock);
+
+	while (State->IsRunning)
+	{
+		if (State->Signal.wait_for(lock, INTRVL, [&State]() { return !State->IsRunning; }))
+		{
+			break;
+		}
+
+		lock.unlock();
+		Refresh();
+		lock.lock();
+	}
+
+	// the pool can be destroyed as soon as this is seen; only the shared state is used after it
+	State->IsStopped = true;
+	State->Signal.notify_all();
+}
+
+void EntropyPool::SetLowPriority()
+{
+#if defined(CEX_OS_WINDOWS)
+	::SetThreadPriority(::GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#elif defined(CEX_OS_LINUX)
+	// the nice value of a linux thread is set through its thread id
+	::setpriority(PRIO_PROCESS, static_cast<id_t>(::syscall(SYS_gettid)), 19);
+#endif
+}
+
+void EntropyPool::Start(uint ProcessId)
+{
+	std::lock_guard<std::mutex> lock(m_stopLock);
+
+	if (m_processId == ProcessId)
+	{
+		return;
+	}
+
+	m_refreshState = std::make_shared<RefreshState>();
+	std::thread(&EntropyPool::RefreshLoop, this, m_refreshState).detach();
+	m_processId = ProcessId;
+}
+
+NAMESPACE_PROVIDEREND
@@ -0,0 +1,178 @@
+#ifndef CEX_ENTROPYPOOL_H
+#define CEX_ENTROPYPOOL_H
+
+#include "CexDomain.h"
+#include "CryptoRandomException.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+NAMESPACE_PROVIDER
+
+using Exception::CryptoRandomException;
+
+/// <summary>
+/// A hashed entropy pool that is kept fresh by a low-priority background thread
+/// </summary>
+///
+/// <example>
+/// <description>Example of extracting a seed from a pool:</description>
+/// <code>
+/// EntropyPool pool([]() { return CollectSystemState(); });
+/// std:vector&lt;byte&gt; seed(64);
+/// pool.Extract(seed);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <para>The pool is a 64 byte Keccak-512 state. A background thread runs the collector function at the refresh interval, and absorbs its output into the pool outside of any caller's path. \n
+/// Extract requests never wait on a collection; each output block is the hash of the pool state, an extraction counter, a timestamp, and a salt from the system provider,
+/// after which the pool is ratcheted forward with a one-way hash so that a later compromise of the pool state does not reveal earlier output. \n
+/// Only the first extraction from an unseeded pool runs the collector on the calling thread; the background thread is started at the same time. \n
+/// The process id is recorded when the thread is started; in a child created with fork, which inherits the pool but not the thread, the next extraction starts a new refresh thread. \n
+/// The refresh thread is detached, and shares its stop flag and signal with the pool through a separately allocated state; the destructor waits for the thread to report that it has stopped.
+/// The child of a fork drops its reference to the inherited state, which is still held by the parents thread, and never touches that state again.
+/// The pool locks are held while a process forks, so the child always inherits them unlocked and the pool state consistent.</para>
+///
+/// <para>The health accessors (RefreshCount, RefreshFailures, RefreshLatency, RefreshLatencyMax, and Age) are lock-free reads of counters maintained by the refresh thread.</para>
+/// </remarks>
+class EntropyPool
+{
+private:
+
+	static const size_t POOL_SIZE = 64;
+	static const size_t SALT_SIZE = 16;
+	static const size_t DEF_REFRESH = 1000;
+
+	struct RefreshState
+	{
+		bool IsRunning;
+		bool IsStopped;
+		std::mutex Lock;
+		std::condition_variable Signal;
+
+		RefreshState()
+			:
+			IsRunning(true),
+			IsStopped(false),
+			Lock(),
+			Signal()
+		{
+		}
+	};
+
+	std::function<std::vector<byte>()> m_collector;
+	std::atomic<ulong> m_extractCount;
+	std::atomic<bool> m_isSeeded;
+	std::atomic<ulong> m_lastRefresh;
+	std::mutex m_poolLock;
+	std::vector<byte> m_poolState;
+	std::atomic<uint> m_processId;
+	std::atomic<ulong> m_refreshCount;
+	std::atomic<ulong> m_refreshFailures;
+	size_t m_refreshInterval;
+	std::atomic<ulong> m_refreshLatency;
+	std::atomic<ulong> m_refreshLatencyMax;
+	std::shared_ptr<RefreshState> m_refreshState;
+	std::mutex m_stopLock;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	EntropyPool(const EntropyPool&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	EntropyPool& operator=(const EntropyPool&) = delete;
+
+	/// <summary>
+	/// Default constructor: default is restricted, this function has been deleted
+	/// </summary>
+	EntropyPool() = delete;
+
+	/// <summary>
+	/// Constructor: instantiate this class
+	/// </summary>
+	///
+	/// <param name="Collector">The entropy collection function run by the refresh thread</param>
+	/// <param name="RefreshInterval">The interval between pool refreshes in milliseconds</param>
+	explicit EntropyPool(std::function<std::vector<byte>()> Collector, size_t RefreshInterval = DEF_REFRESH);
+
+	/// <summary>
+	/// Destructor: stops the refresh thread and erases the pool state
+	/// </summary>
+	~EntropyPool();
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The time in milliseconds since the pool was last refreshed
+	/// </summary>
+	const ulong Age();
+
+	/// <summary>
+	/// Read Only: The pool has been seeded by at least one collection
+	/// </summary>
+	const bool IsSeeded();
+
+	/// <summary>
+	/// Read Only: The number of completed pool refreshes
+	/// </summary>
+	const ulong RefreshCount();
+
+	/// <summary>
+	/// Read Only: The number of collections that failed with an exception
+	/// </summary>
+	const ulong RefreshFailures();
+
+	/// <summary>
+	/// Read Only: The duration of the last collection and absorb in microseconds
+	/// </summary>
+	const ulong RefreshLatency();
+
+	/// <summary>
+	/// Read Only: The longest collection and absorb duration in microseconds
+	/// </summary>
+	const ulong RefreshLatencyMax();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Fill a buffer with seed material from the pool
+	/// </summary>
+	///
+	/// <param name="Output">The output array to fill</param>
+	///
+	/// <exception cref="Exception::CryptoRandomException">Thrown if the pool could not be seeded</exception>
+	void Extract(std::vector<byte> &Output);
+
+	/// <summary>
+	/// Run a collection on the calling thread and absorb it into the pool
+	/// </summary>
+	///
+	/// <returns>Returns true if the collection succeeded</returns>
+	bool Refresh();
+
+private:
+
+#if !defined(CEX_OS_WINDOWS) && !defined(CEX_OS_ANDROID)
+	static void ForkChild();
+	static void ForkParent();
+	static void ForkPrepare();
+#endif
+	static ulong Microseconds();
+	void RefreshLoop(std::shared_ptr<RefreshState> State);
+	static void SetLowPriority();
+	void Start(uint ProcessId);
+};
+
+NAMESPACE_PROVIDEREND
+#endif
@@ -1,5 +1,6 @@
 #include "FFTM12T62.h"
 #include "IAeadMode.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
 #include "McElieceUtils.h"
 #include "SymmetricKey.h"
@@ -1082,6 +1083,8 @@ void FFTM12T62::SyndromeAdjust(std::array<std::array<ulong, M>, 2> &Output)
 
 void FFTM12T62::GenE(std::vector<byte> &E, std::unique_ptr<IPrng> &Random)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::NoiseSampling);
+
 	size_t i;
 	size_t j;
 	size_t eq;
@@ -1274,6 +1277,8 @@ bool FFTM12T62::IrrGen(std::array<ushort, T + 1> &Output, std::vector<ushort> &F
 
 void FFTM12T62::SkGen(std::vector<byte> &PrivateKey, std::unique_ptr<Prng::IPrng> &Random)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::NoiseSampling);
+
 	size_t i;
 	std::array<ushort, T + 1> irr;
 	std::vector<ushort> f(T);
@@ -1317,6 +1322,8 @@ void FFTM12T62::SkGen(std::vector<byte> &PrivateKey, std::unique_ptr<Prng::IPrng
 
 bool FFTM12T62::PkGen(std::vector<byte> &PublicKey, const std::vector<byte> &PrivateKey)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::MatrixExpansion);
+
 	size_t c;
 	size_t i;
 	size_t j;
@@ -1476,6 +1483,8 @@ bool FFTM12T62::PkGen(std::vector<byte> &PublicKey, const std::vector<byte> &Pri
 
 void FFTM12T62::AdditiveFFT::Transform(std::array<std::array<ulong, M>, 64> &Output, std::array<ulong, M> &Input)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Transform);
+
 	RadixConversions(Input);
 	Butterflies(Output, Input);
 }
@@ -1635,6 +1644,8 @@ void FFTM12T62::AdditiveFFT::RadixConversions(std::array<ulong, M> &Output)
 
 void FFTM12T62::TransposedFFT::Transform(std::array<std::array<ulong, M>, 2> &Output, std::array<std::array<ulong, M>, 64> &Input)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Transform);
+
 	Butterflies(Output, Input);
 	RadixConversions(Output);
 }
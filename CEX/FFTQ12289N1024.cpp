@@ -434,12 +434,16 @@ void FFTQ12289N1024::Generate(std::vector<byte> &PublicKey, std::vector<ushort>
 
 void FFTQ12289N1024::DecodeA(std::array<ushort, N> &PubKey, std::vector<byte> &Seed, const std::vector<byte> &R)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Packing);
+
 	FromBytes(PubKey, R);
 	Utility::MemUtils::Copy(R, POLY_BYTES, Seed, 0, SEED_BYTES);
 }
 
 void FFTQ12289N1024::DecodeB(std::array<ushort, N> &B, std::array<ushort, N> &C, const std::vector<byte> &R)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Packing);
+
 	FromBytes(B, R);
 
 	for (size_t i = 0; i < N / 4; i++)
@@ -453,12 +457,16 @@ void FFTQ12289N1024::DecodeB(std::array<ushort, N> &B, std::array<ushort, N> &C,
 
 void FFTQ12289N1024::EncodeA(std::vector<byte> &R, const std::array<ushort, N> &PubKey, const std::vector<byte> &Seed)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Packing);
+
 	ToBytes(R, PubKey);
 	Utility::MemUtils::Copy(Seed, 0, R, POLY_BYTES, SEED_BYTES);
 }
 
 void FFTQ12289N1024::EncodeB(std::vector<byte> &R, const std::array<ushort, N> &B, const std::array<ushort, N> &C)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Packing);
+
 	ToBytes(R, B);
 
 	for (size_t i = 0; i < N / 4; i++)
@@ -480,6 +488,8 @@ void FFTQ12289N1024::FromBytes(std::array<ushort, N> &R, const std::vector<byte>
 
 void FFTQ12289N1024::PolyUniform(std::array<ushort, N> &A, const std::vector<byte> &Seed, bool Parallel)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::MatrixExpansion);
+
 	Drbg::BCG eng(Enumeration::BlockCiphers::Rijndael);
 	size_t bufLen = (2 * N) * sizeof(ushort);
 
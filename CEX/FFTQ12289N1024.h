@@ -21,6 +21,7 @@
 
 #include "CexDomain.h"
 #include "IPrng.h"
+#include "Instrumentation.h"
 #include "PolyMath.h"
 
 NAMESPACE_RINGLWE
@@ -202,6 +203,8 @@ private:
 	template <typename Array>
 	inline static void FwdNTT(Array &A)
 	{
+		CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Transform);
+
 		size_t dist;
 		size_t i;
 		size_t j;
@@ -240,6 +243,8 @@ private:
 	template <typename Array>
 	inline static void InvNTT(Array &R)
 	{
+		CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Transform);
+
 		size_t dist;
 		size_t i;
 		size_t j;
@@ -461,6 +466,8 @@ private:
 	template <typename ArrayA, typename ArrayB>
 	inline static void PolyGetNoise(ArrayA &R, ArrayB &Random)
 	{
+		CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::NoiseSampling);
+
 #if defined(__AVX512__)
 		GetNoise<Numeric::UInt512, ArrayA, ArrayB>(R, Random, Q);
 #elif defined(__AVX2__)
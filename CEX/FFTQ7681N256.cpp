@@ -1,4 +1,5 @@
 #include "FFTQ7681N256.h"
+#include "Instrumentation.h"
 #include "PolyMath.h"
 
 NAMESPACE_MODULELWE
@@ -219,6 +220,8 @@ void FFTQ7681N256::Generate(std::vector<byte> &PublicKey, std::vector<byte> &Pri
 
 void FFTQ7681N256::GenerateMatrix(std::vector<std::vector<std::array<ushort, N>>> &A, const std::vector<byte> &Seed, bool Transposed)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::MatrixExpansion);
+
 	byte i;
 	byte j;
 	ushort val;
@@ -275,6 +278,8 @@ void FFTQ7681N256::GenerateMatrix(std::vector<std::vector<std::array<ushort, N>>
 
 void FFTQ7681N256::GetNoise(std::array<ushort, N> &R, size_t Eta, std::unique_ptr<Prng::IPrng> &Rng)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::NoiseSampling);
+
 	std::vector<byte> buf((Eta * N) / 4);
 	Rng->GetBytes(buf);
 
@@ -283,6 +288,8 @@ void FFTQ7681N256::GetNoise(std::array<ushort, N> &R, size_t Eta, std::unique_pt
 
 void FFTQ7681N256::InvNTT(std::array<ushort, N> &P)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Transform);
+
 	// TODO: vectorize
 	ushort level;
 	ushort tmp;
@@ -329,6 +336,8 @@ void FFTQ7681N256::InvNTT(std::array<ushort, N> &P)
 
 void FFTQ7681N256::FwdNTT(std::array<ushort, N> &P)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Transform);
+
 	// TODO: vectorize
 	short level;
 	ushort start;
@@ -474,12 +483,16 @@ void FFTQ7681N256::Cbd(std::array<ushort, N> &R, const std::vector<byte> &Buffer
 
 void FFTQ7681N256::PackCiphertext(std::vector<byte> &R, const std::vector<std::array<ushort, N>> &B, const std::array<ushort, N> &V)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Packing);
+
 	PolyVecCompress(R, B);
 	PolyCompress(R, (B.size() * PUBPOLY_SIZE), V);
 }
 
 void FFTQ7681N256::PackPublicKey(std::vector<byte> &R, const std::vector<std::array<ushort, N>> &Pk, const std::vector<byte> &Seed)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Packing);
+
 	size_t i;
 
 	PolyVecCompress(R, 0, Pk);
@@ -492,6 +505,8 @@ void FFTQ7681N256::PackPublicKey(std::vector<byte> &R, const std::vector<std::ar
 
 void FFTQ7681N256::PackSecretKey(std::vector<byte> &R, const std::vector<std::array<ushort, N>> &Sk)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Packing);
+
 	PolyVecToBytes(R, Sk);
 }
 
@@ -809,6 +824,8 @@ void FFTQ7681N256::PolyVecToBytes(std::vector<byte> &R, const std::vector<std::a
 
 void FFTQ7681N256::UnpackCiphertext(std::vector<std::array<ushort, N>> &B, std::array<ushort, N> &V, const std::vector<byte> &C)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Packing);
+
 	PolyVecDecompress(B, C);
 	PolyDecompress(V, C, B.size() * PUBPOLY_SIZE);
 
@@ -816,6 +833,8 @@ void FFTQ7681N256::UnpackCiphertext(std::vector<std::array<ushort, N>> &B, std::
 
 void FFTQ7681N256::UnpackPublicKey(std::vector<std::array<ushort, N>> &Pk, std::vector<byte> &Seed, const std::vector<byte> &PackedPk)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Packing);
+
 	size_t i;
 
 	PolyVecDecompress(Pk, PackedPk);
@@ -828,6 +847,8 @@ void FFTQ7681N256::UnpackPublicKey(std::vector<std::array<ushort, N>> &Pk, std::
 
 void FFTQ7681N256::UnpackSecretKey(std::vector<std::array<ushort, N>> &Sk, const std::vector<byte> &PackedSk)
 {
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Packing);
+
 	PolyVecFrombytes(Sk, PackedSk);
 }
 
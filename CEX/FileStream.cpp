@@ -127,36 +127,20 @@ void FileStream::CopyTo(IByteStream* Destination)
 
 	Destination->Seek(0, IO::SeekOrigin::Begin);
 
-	if (m_fileSize > CHUNK_SIZE)
-	{
-		const size_t ALNSZE = m_fileSize - (m_fileSize % CHUNK_SIZE);
-		std::vector<byte> buffer(CHUNK_SIZE);
-		m_fileStream.seekg(0, std::ios::beg);
-
-		uint bteCtr = 0;
-
-		if (ALNSZE >= CHUNK_SIZE)
-		{
-			while (bteCtr != ALNSZE)
-			{
-				m_fileStream.read((char*)buffer.data(), CHUNK_SIZE);
-				Destination->Write(buffer, bteCtr, CHUNK_SIZE);
-				bteCtr += CHUNK_SIZE;
-			}
-		}
+	// copy through a single chunk sized buffer, regardless of the file size
+	std::vector<byte> buffer(CHUNK_SIZE);
+	ulong prcLen = 0;
+	m_fileStream.seekg(0, std::ios::beg);
 
-		if (ALNSZE != m_fileSize)
-		{
-			m_fileStream.read((char*)buffer.data(), m_fileSize - ALNSZE);
-			Destination->Write(buffer, ALNSZE, m_fileSize - ALNSZE);
-		}
-	}
-	else
+	while (prcLen != m_fileSize)
 	{
-		std::vector<byte> buffer(m_fileSize);
-		m_fileStream.seekg(0, std::ios::beg);
-		Destination->Write(buffer, 0, m_fileSize);
+		const size_t RMDSZE = static_cast<size_t>((m_fileSize - prcLen) < CHUNK_SIZE ? m_fileSize - prcLen : CHUNK_SIZE);
+		m_fileStream.read((char*)buffer.data(), RMDSZE);
+		Destination->Write(buffer, 0, RMDSZE);
+		prcLen += RMDSZE;
 	}
+
+	m_filePosition = m_fileSize;
 }
 
 void FileStream::Destroy()
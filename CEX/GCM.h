@@ -34,8 +34,7 @@
 #define CEX_GCM_H
 
 #include "IAeadMode.h"
-#include "CTR.h"
-#include "GHASH.h"
+#include "GCMT.h"
 
 NAMESPACE_MODE
 
@@ -113,6 +112,7 @@ NAMESPACE_MODE
 /// <list type="bullet">
 /// <item><description>GCM is an AEAD authenticated mode, additional data such as packet header information can be added to the authentication process.</description></item>
 /// <item><description>Additional data can be added using the SetAssociatedData(Input, Offset, Length) call.</description></item>
+/// <item><description>The mode is a thin adapter over GCMT&lt;IBlockCipher&gt;; use GCMT with a final cipher type (ex. GCMT&lt;AHX&gt;) to bind the engine at compile time.</description></item>
 /// <item><description>Calling the Finalize(Output, Offset, Length) function writes the MAC code to the output array in either encryption or decryption operation mode.</description></item>
 /// <item><description>The Verify(Input, Offset, Length) function can be used to compare the MAC code embedded with the cipher-text to the internal MAC code generated after a Decryption cycle.</description></item>
 /// <item><description>Encryption and decryption can both be pipelined (SSE3-128 or AVX-256), and multi-threaded.</description></item>
@@ -134,31 +134,12 @@ class GCM final : public IAeadMode
 private:
 
 	static const size_t BLOCK_SIZE = 16;
-	static const std::string CLASS_NAME;
-	static const size_t MAX_PRLALLOC = 100000000;
-	static const size_t MIN_TAGSIZE = 12;
-
-	std::vector<byte> m_aadData;
-	bool m_aadLoaded;
-	bool m_aadPreserve;
-	size_t m_aadSize;
-	bool m_autoIncrement;
-	std::vector<byte> m_checkSum;
-	std::unique_ptr<CTR> m_cipherMode;
+
+	std::unique_ptr<IBlockCipher> m_blockCipher;
 	BlockCiphers m_cipherType;
 	bool m_destroyEngine;
-	std::unique_ptr<Mac::GHASH> m_gcmHash;
-	std::vector<byte> m_gcmKey;
-	std::vector<byte> m_gcmNonce;
-	std::vector<byte> m_gcmVector;
+	GCMT<IBlockCipher> m_gcmMode;
 	bool m_isDestroyed;
-	bool m_isEncryption;
-	bool m_isFinalized;
-	bool m_isInitialized;
-	std::vector<SymmetricKeySize> m_legalKeySizes;
-	size_t m_msgSize;
-	std::vector<byte> m_msgTag;
-	ParallelOptions m_parallelProfile;
 
 public:
 
@@ -366,7 +347,7 @@ public:
 	/// </summary>
 	/// 
 	/// <param name="Encryption">True if cipher is used for encryption, false to decrypt</param>
-	/// <param name="KeyParams">SymmetricKey containing the encryption Key and Nonce</param>
+	/// <param name="KeyParams">SymmetricKey containing the encryption Key and Nonce; an empty key loads a new nonce only</param>
 	/// 
 	/// <exception cref="CryptoCipherModeException">Thrown if a null or invalid Key/Nonce is used</exception>
 	void Initialize(bool Encryption, ISymmetricKey &KeyParams) override;
@@ -426,13 +407,6 @@ public:
 	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not initialized for decryption</exception>
 	bool Verify(const std::vector<byte> &Input, const size_t Offset, const size_t Length) override;
 
-private:
-
-	void CalculateMac();
-	void Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Reset();
-	void Scope();
 };
 
 NAMESPACE_MODEEND
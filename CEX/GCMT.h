@@ -0,0 +1,550 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// A compile-time composed Galois/Counter authenticated mode (GCM) template.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_GCMT_H
+#define CEX_GCMT_H
+
+#include "IAeadMode.h"
+#include "CTRT.h"
+#include "GHASH.h"
+#include "SymmetricKey.h"
+
+NAMESPACE_MODE
+
+/// <summary>
+/// A Galois/Counter Authenticated Block Cipher Mode composed at compile time with its block cipher engine
+/// </summary>
+///
+/// <example>
+/// <description>Encrypting and authenticating with an AES-NI engine bound to the mode:</description>
+/// <code>
+/// AHX engine;
+/// GCMT&lt;AHX&gt; cipher(&amp;engine);
+/// // initialize for encryption
+/// cipher.Initialize(true, SymmetricKey(Key, Nonce));
+/// cipher.Transform(Input, 0, Output, 0, Input.size());
+/// // append the mac code to the output
+/// cipher.Finalize(Output, Input.size(), cipher.MaxTagSize());
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <para>The template holds the complete GCM implementation; the GCM class is a thin IAeadMode adapter over GCMT&lt;IBlockCipher&gt;. \n
+/// The counter stream is generated by a CTRT&lt;T&gt; member, so with a final cipher type the engines wide kernels are bound statically and can be inlined into the counter loop.
+/// Output and tags are identical to the GCM class for the same cipher, key, nonce and associated data.</para>
+///
+/// <list type="bullet">
+/// <item><description>The engine is not owned by the template, and must outlive it.</description></item>
+/// <item><description>A nonce-only key (empty key) reloads the counter without re-keying the cipher or the hash, as in the GCM class.</description></item>
+/// </list>
+/// </remarks>
+template<typename T>
+class GCMT final
+{
+private:
+
+	static const size_t BLOCK_SIZE = 16;
+	static const std::string CLASS_NAME;
+	static const size_t MIN_TAGSIZE = 12;
+
+	std::vector<byte> m_aadData;
+	bool m_aadLoaded;
+	bool m_aadPreserve;
+	size_t m_aadSize;
+	bool m_autoIncrement;
+	std::vector<byte> m_checkSum;
+	CTRT<T> m_cipherMode;
+	Mac::GHASH m_gcmHash;
+	std::vector<byte> m_gcmNonce;
+	std::vector<byte> m_gcmVector;
+	bool m_isEncryption;
+	bool m_isFinalized;
+	bool m_isInitialized;
+	std::vector<SymmetricKeySize> m_legalKeySizes;
+	size_t m_msgSize;
+	std::vector<byte> m_msgTag;
+	ParallelOptions m_parallelProfile;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	GCMT(const GCMT&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	GCMT& operator=(const GCMT&) = delete;
+
+	/// <summary>
+	/// Default constructor: default is restricted, this function has been deleted
+	/// </summary>
+	GCMT() = delete;
+
+	/// <summary>
+	/// Initialize the Cipher Mode using a block cipher instance
+	/// </summary>
+	///
+	/// <param name="Cipher">The uninitialized block cipher instance; can not be null, and is not deleted by this class</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if a null block cipher is used</exception>
+	explicit GCMT(T* Cipher)
+		:
+		m_aadData(0),
+		m_aadLoaded(false),
+		m_aadPreserve(false),
+		m_aadSize(0),
+		m_autoIncrement(false),
+		m_checkSum(BLOCK_SIZE),
+		m_cipherMode(Cipher != nullptr ? Cipher :
+			throw CryptoCipherModeException("GCM:CTor", "The Cipher can not be null!")),
+		m_gcmHash(),
+		m_gcmNonce(0),
+		m_gcmVector(BLOCK_SIZE),
+		m_isEncryption(false),
+		m_isFinalized(false),
+		m_isInitialized(false),
+		m_legalKeySizes(0),
+		m_msgSize(0),
+		m_msgTag(BLOCK_SIZE),
+		m_parallelProfile(BLOCK_SIZE, m_cipherMode.ParallelProfile().IsParallel(), m_cipherMode.ParallelProfile().ParallelBlockSize(),
+			m_cipherMode.ParallelProfile().ParallelMaxDegree(), true, m_cipherMode.Engine()->StateCacheSize(), true)
+	{
+		Scope();
+	}
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~GCMT()
+	{
+		m_aadLoaded = false;
+		m_aadPreserve = false;
+		m_aadSize = 0;
+		m_autoIncrement = false;
+		m_isEncryption = false;
+		m_isFinalized = false;
+		m_isInitialized = false;
+		m_msgSize = 0;
+		m_parallelProfile.Reset();
+		m_gcmHash.Reset();
+
+		Utility::IntUtils::ClearVector(m_aadData);
+		Utility::IntUtils::ClearVector(m_gcmNonce);
+		Utility::IntUtils::ClearVector(m_gcmVector);
+		Utility::IntUtils::ClearVector(m_legalKeySizes);
+		Utility::IntUtils::ClearVector(m_msgTag);
+		Utility::IntUtils::ClearVector(m_checkSum);
+	}
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read/Write: Enable auto-incrementing of the input nonce each time the Finalize method is called
+	/// </summary>
+	bool &AutoIncrement() { return m_autoIncrement; }
+
+	/// <summary>
+	/// Read Only: Block size of internal cipher in bytes
+	/// </summary>
+	const size_t BlockSize() { return BLOCK_SIZE; }
+
+	/// <summary>
+	/// Read Only: The underlying Block Cipher instance
+	/// </summary>
+	T* Engine() { return m_cipherMode.Engine(); }
+
+	/// <summary>
+	/// Read Only: True if initialized for encryption, False for decryption
+	/// </summary>
+	const bool IsEncryption() { return m_isEncryption; }
+
+	/// <summary>
+	/// Read Only: The Block Cipher is ready to transform data
+	/// </summary>
+	const bool IsInitialized() { return m_isInitialized; }
+
+	/// <summary>
+	/// Read Only: Processor parallelization availability
+	/// </summary>
+	const bool IsParallel() { return m_parallelProfile.IsParallel(); }
+
+	/// <summary>
+	/// Read Only: Array of allowed cipher input key byte-sizes
+	/// </summary>
+	const std::vector<SymmetricKeySize> &LegalKeySizes() { return m_legalKeySizes; }
+
+	/// <summary>
+	/// Read Only: Maximum size of the mac code in bytes
+	/// </summary>
+	const size_t MaxTagSize() { return BLOCK_SIZE; }
+
+	/// <summary>
+	/// Read Only: Minimum size of the mac code in bytes
+	/// </summary>
+	const size_t MinTagSize() { return MIN_TAGSIZE; }
+
+	/// <summary>
+	/// Read Only: The cipher modes class name
+	/// </summary>
+	const std::string Name() { return CLASS_NAME + "-" + m_cipherMode.Engine()->Name(); }
+
+	/// <summary>
+	/// Read Only: Parallel block size; the byte-size of the input/output data arrays passed to a transform that trigger parallel processing
+	/// </summary>
+	const size_t ParallelBlockSize() { return m_parallelProfile.ParallelBlockSize(); }
+
+	/// <summary>
+	/// Read/Write: Parallel and SIMD capability flags and sizes
+	/// </summary>
+	ParallelOptions &ParallelProfile() { return m_cipherMode.ParallelProfile(); }
+
+	/// <summary>
+	/// Read/Write: Persist the associated data across messages when AutoIncrement() is enabled
+	/// </summary>
+	bool &PreserveAD() { return m_aadPreserve; }
+
+	/// <summary>
+	/// Read Only: Returns the full finalized MAC code value array
+	/// </summary>
+	const std::vector<byte> Tag()
+	{
+		CexAssert(m_isFinalized, "The cipher mode has not been finalized");
+
+		return m_msgTag;
+	}
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Decrypt a block of bytes with offset parameters.
+	/// <para>Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of encrypted bytes</param>
+	/// <param name="InOffset">Starting offset within the Input array</param>
+	/// <param name="Output">The output array of decrypted bytes</param>
+	/// <param name="OutOffset">Starting offset within the Output array</param>
+	void DecryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+	{
+		CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+		CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
+
+		m_gcmHash.Update(Input, InOffset, m_checkSum, BLOCK_SIZE);
+		m_cipherMode.EncryptBlock(Input, InOffset, Output, OutOffset);
+		m_msgSize += BLOCK_SIZE;
+	}
+
+	/// <summary>
+	/// Encrypt a block of bytes using offset parameters.
+	/// <para>Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of plain text bytes</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of encrypted bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	void EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+	{
+		CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+		CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
+
+		m_cipherMode.EncryptBlock(Input, InOffset, Output, OutOffset);
+		m_gcmHash.Update(Input, InOffset, m_checkSum, BLOCK_SIZE);
+		m_msgSize += BLOCK_SIZE;
+	}
+
+	/// <summary>
+	/// Calculate the MAC code (Tag) and copy it to the Output array
+	/// </summary>
+	///
+	/// <param name="Output">The output array that receives the authentication code</param>
+	/// <param name="Offset">The starting offset within the output array</param>
+	/// <param name="Length">The number of MAC code bytes to write to the output array</param>
+	void Finalize(std::vector<byte> &Output, const size_t Offset, const size_t Length)
+	{
+		CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::CipherMode, CLASS_NAME, 0);
+
+		CexAssert(m_isInitialized, "The cipher mode has not been initialized");
+		CexAssert(Length >= MIN_TAGSIZE || Length <= BLOCK_SIZE, "The cipher mode has not been initialized");
+
+		CalculateMac();
+		Utility::MemUtils::Copy(m_msgTag, 0, Output, Offset, Length);
+	}
+
+	/// <summary>
+	/// Initialize the Cipher instance
+	/// </summary>
+	///
+	/// <param name="Encryption">True if cipher is used for encryption, False to decrypt</param>
+	/// <param name="KeyParams">SymmetricKey containing the encryption Key and Nonce; an empty key loads a new nonce only</param>
+	///
+	/// <exception cref="CryptoSymmetricCipherException">Thrown if an invalid key or nonce, or parallel block size is used</exception>
+	void Initialize(bool Encryption, ISymmetricKey &KeyParams)
+	{
+		Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+		Scope();
+
+		if (kv.Nonce().size() < 8)
+		{
+			throw CryptoSymmetricCipherException("GCM:Initialize", "Requires a nonce of minimum 10 bytes in length!");
+		}
+		if (IsParallel() && ParallelBlockSize() < m_parallelProfile.ParallelMinimumSize() || ParallelBlockSize() > m_parallelProfile.ParallelMaximumSize())
+		{
+			throw CryptoSymmetricCipherException("GCM:Initialize", "The parallel block size is out of bounds!");
+		}
+		if (IsParallel() && ParallelBlockSize() % m_parallelProfile.ParallelMinimumSize() != 0)
+		{
+			throw CryptoSymmetricCipherException("GCM:Initialize", "The parallel block size must be evenly aligned to the ParallelMinimumSize!");
+		}
+
+		if (kv.Key().size() == 0)
+		{
+			if (kv.Nonce() == m_gcmNonce)
+			{
+				throw CryptoSymmetricCipherException("GCM:Initialize", "The nonce can not be zeroised or repeating!");
+			}
+			if (!m_cipherMode.IsInitialized())
+			{
+				throw CryptoSymmetricCipherException("GCM:Initialize", "First initialization requires a key and nonce!");
+			}
+		}
+		else
+		{
+			if (!SymmetricKeySize::Contains(LegalKeySizes(), kv.Key().size()))
+			{
+				throw CryptoSymmetricCipherException("GCM:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
+			}
+
+			// key the cipher once, a new nonce only reloads the counter, and generate the hash key
+			const std::vector<byte> ZEROES(BLOCK_SIZE);
+			Key::Symmetric::SymmetricKey ctrKey(kv.Key(), ZEROES, kv.Info());
+			m_cipherMode.Initialize(true, ctrKey);
+			std::vector<byte> tmpH(BLOCK_SIZE);
+			m_cipherMode.Engine()->Transform(ZEROES, 0, tmpH, 0);
+
+			std::vector<ulong> gKey =
+			{
+				Utility::IntUtils::BeBytesTo64(tmpH, 0),
+				Utility::IntUtils::BeBytesTo64(tmpH, 8)
+			};
+
+			m_gcmHash.Initialize(gKey);
+		}
+
+		m_isEncryption = Encryption;
+		m_gcmNonce = kv.Nonce();
+		LoadNonce();
+
+		if (m_isFinalized)
+		{
+			Utility::MemUtils::Clear(m_msgTag, 0, m_msgTag.size());
+			m_isFinalized = false;
+		}
+
+		m_isInitialized = true;
+	}
+
+	/// <summary>
+	/// Set the maximum number of threads allocated when using multi-threaded processing
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	void ParallelMaxDegree(size_t Degree)
+	{
+		CexAssert(Degree != 0, "parallel degree can not be zero");
+		CexAssert(Degree % 2 == 0, "parallel degree must be an even number");
+		CexAssert(Degree <= m_parallelProfile.ProcessorCount(), "parallel degree can not exceed processor count");
+
+		m_parallelProfile.SetMaxDegree(Degree);
+	}
+
+	/// <summary>
+	/// Add additional data to the authentication generator; must be called after Initialize and before the first Transform
+	/// </summary>
+	///
+	/// <param name="Input">The input array of bytes</param>
+	/// <param name="Offset">Starting offset within the input array</param>
+	/// <param name="Length">The number of bytes to process</param>
+	void SetAssociatedData(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
+	{
+		CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+		CexAssert(!m_aadLoaded, "The associated data has already been set");
+
+		m_aadData.resize(Length);
+		Utility::MemUtils::Copy(Input, Offset, m_aadData, 0, Length);
+		m_gcmHash.ProcessSegment(Input, Offset, m_checkSum, Length);
+
+		m_aadSize = Length;
+		m_aadLoaded = true;
+	}
+
+	/// <summary>
+	/// Transform a length of bytes with offset parameters
+	/// </summary>
+	///
+	/// <param name="Input">The input array of bytes to transform</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of transformed bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+	{
+		CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::CipherMode, CLASS_NAME, Length);
+
+		CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+		CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the the block-size!");
+
+		if (m_isEncryption)
+		{
+			m_cipherMode.Transform(Input, InOffset, Output, OutOffset, Length);
+			m_gcmHash.Update(Output, OutOffset, m_checkSum, Length);
+		}
+		else
+		{
+			m_gcmHash.Update(Input, InOffset, m_checkSum, Length);
+			m_cipherMode.Transform(Input, InOffset, Output, OutOffset, Length);
+		}
+
+		m_msgSize += Length;
+	}
+
+	/// <summary>
+	/// Generate the internal MAC code and compare it with the tag contained in the Input array
+	/// </summary>
+	///
+	/// <param name="Input">The input array containing the expected authentication code</param>
+	/// <param name="Offset">The starting offset within the input array</param>
+	/// <param name="Length">The number of bytes to compare</param>
+	///
+	/// <returns>Returns false if the MAC code does not match</returns>
+	bool Verify(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
+	{
+		CexAssert(!m_isEncryption, "the cipher mode has not been initialized for decryption");
+		CexAssert(Length >= MIN_TAGSIZE || Length <= BLOCK_SIZE, "the length must be minimum of 12 and maximum of MAC code size");
+		CexAssert(!(!m_isInitialized && !m_isFinalized), "the cipher mode has not been initialized for decryption");
+
+		if (!m_isFinalized)
+		{
+			CalculateMac();
+		}
+
+		return Utility::IntUtils::Compare(m_msgTag, 0, Input, Offset, Length);
+	}
+
+private:
+
+	void CalculateMac()
+	{
+		m_gcmHash.FinalizeBlock(m_checkSum, m_aadSize, m_msgSize);
+		Utility::MemUtils::XorBlock(m_gcmVector, 0, m_checkSum, 0, BLOCK_SIZE);
+		Utility::MemUtils::COPY128(m_checkSum, 0, m_msgTag, 0);
+		Reset();
+
+		if (m_autoIncrement)
+		{
+			// the key schedule and hash key are retained, only the counter is reloaded
+			Utility::IntUtils::BeIncrement8(m_gcmNonce);
+			LoadNonce();
+			m_isInitialized = true;
+
+			if (m_aadPreserve)
+			{
+				m_gcmHash.ProcessSegment(m_aadData, 0, m_checkSum, m_aadData.size());
+			}
+		}
+
+		m_isFinalized = true;
+	}
+
+	void LoadNonce()
+	{
+		std::vector<byte> &ctr = m_cipherMode.Nonce();
+
+		// the pre-counter block; the nonce with a 32 bit counter of one, or the hash of longer nonces
+		if (m_gcmNonce.size() == 12)
+		{
+			Utility::MemUtils::Copy(m_gcmNonce, 0, ctr, 0, m_gcmNonce.size());
+			ctr[12] = 0;
+			ctr[13] = 0;
+			ctr[14] = 0;
+			ctr[15] = 1;
+		}
+		else
+		{
+			Utility::MemUtils::Clear(ctr, 0, BLOCK_SIZE);
+			m_gcmHash.ProcessSegment(m_gcmNonce, 0, ctr, m_gcmNonce.size());
+			m_gcmHash.FinalizeBlock(ctr, 0, m_gcmNonce.size());
+		}
+
+		// encrypt the pre-counter block for the tag, the message starts at the next counter
+		m_cipherMode.Engine()->EncryptBlock(ctr, 0, m_gcmVector, 0);
+		Utility::IntUtils::BeIncrement8(ctr);
+	}
+
+	void Reset()
+	{
+		if (!m_aadPreserve)
+		{
+			if (m_aadSize != 0)
+			{
+				Utility::MemUtils::Clear(m_aadData, 0, m_aadData.size());
+			}
+
+			m_aadLoaded = false;
+			m_aadSize = 0;
+		}
+
+		m_gcmHash.Reset();
+		m_isInitialized = false;
+		Utility::MemUtils::Clear(m_gcmVector, 0, m_gcmVector.size());
+		Utility::MemUtils::Clear(m_checkSum, 0, m_checkSum.size());
+		m_msgSize = 0;
+	}
+
+	void Scope()
+	{
+		std::vector<SymmetricKeySize> keySizes = m_cipherMode.LegalKeySizes();
+		m_legalKeySizes.resize(keySizes.size());
+
+		for (size_t i = 0; i < m_legalKeySizes.size(); i++)
+		{
+			m_legalKeySizes[i] = SymmetricKeySize(keySizes[i].KeySize(), keySizes[i].NonceSize(), keySizes[i].NonceSize());
+		}
+
+		if (!m_cipherMode.ParallelProfile().IsDefault())
+		{
+			m_cipherMode.ParallelProfile().Calculate(m_parallelProfile.IsParallel(), m_cipherMode.ParallelProfile().ParallelBlockSize(), m_cipherMode.ParallelProfile().ParallelMaxDegree());
+		}
+	}
+};
+
+template<typename T>
+const std::string GCMT<T>::CLASS_NAME("GCM");
+
+NAMESPACE_MODEEND
+#endif
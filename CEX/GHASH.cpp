@@ -48,10 +48,11 @@ void GHASH::FinalizeBlock(std::vector<byte> &Output, size_t AdSize, size_t TextS
 		ProcessSegment(m_msgBuffer, 0, Output, m_msgOffset);
 	}
 
-	std::vector<byte> fnlBlock(BLOCK_SIZE);
-	Utility::IntUtils::Be64ToBytes(8 * AdSize, fnlBlock, 0);
-	Utility::IntUtils::Be64ToBytes(8 * TextSize, fnlBlock, 8);
-	Utility::MemUtils::XOR128(fnlBlock, 0, Output, 0);
+	// the message tail has been absorbed, so the buffer holds the length block
+	Utility::IntUtils::Be64ToBytes(8 * AdSize, m_msgBuffer, 0);
+	Utility::IntUtils::Be64ToBytes(8 * TextSize, m_msgBuffer, 8);
+	Utility::MemUtils::XOR128(m_msgBuffer, 0, Output, 0);
+	m_msgOffset = 0;
 
 	GcmMultiply(Output);
 }
@@ -1,7 +1,9 @@
 #include "GMAC.h"
 #include "BlockCipherFromName.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
 #include "MemUtils.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_MAC
 
@@ -143,6 +145,8 @@ void GMAC::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
 
 size_t GMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Mac, CLASS_NAME, 0);
+
 	CexAssert(m_isInitialized, "The Mac is not initialized!");
 	CexAssert((Output.size() - OutOffset) >= BLOCK_SIZE, "The Input buffer is too short!");
 
@@ -156,11 +160,13 @@ size_t GMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
 
 void GMAC::Initialize(ISymmetricKey &KeyParams)
 {
-	if (KeyParams.Nonce().size() < TAG_MINLEN)
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (kv.Nonce().size() < TAG_MINLEN)
 	{
 		throw CryptoMacException("GMAC:Initialize", "The length must be minimum of 12, and maximum of MAC code size!");
 	}
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), kv.Key().size()))
 	{
 		throw CryptoMacException("GMAC:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 	}
@@ -170,7 +176,7 @@ void GMAC::Initialize(ISymmetricKey &KeyParams)
 		Reset();
 	}
 
-	if (KeyParams.Key().size() != 0)
+	if (kv.Key().size() != 0)
 	{
 		// key the cipher and generate H
 		m_blockCipher->Initialize(true, KeyParams);
@@ -188,7 +194,7 @@ void GMAC::Initialize(ISymmetricKey &KeyParams)
 	}
 
 	// initialize the nonce
-	m_gmacNonce = KeyParams.Nonce();
+	m_gmacNonce = kv.Nonce();
 
 	if (m_gmacNonce.size() == 12)
 	{
@@ -225,6 +231,8 @@ void GMAC::Update(byte Input)
 
 void GMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Mac, CLASS_NAME, Length);
+
 	CexAssert(m_isInitialized, "The Mac is not initialized!");
 	CexAssert((InOffset + Length) <= Input.size(), "The Input buffer is too short!");
 
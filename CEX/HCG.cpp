@@ -1,8 +1,10 @@
 #include "HCG.h"
 #include "DigestFromName.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
 #include "ProviderFromName.h"
 #include "SymmetricKey.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_DRBG
 
@@ -23,6 +25,7 @@ HCG::HCG(Digests DigestType, Providers ProviderType)
 	m_isDestroyed(false),
 	m_isInitialized(false),
 	m_legalKeySizes(0),
+	m_outputCounter(0),
 	m_prdResistant(ProviderType != Providers::None),
 	m_providerSource(ProviderType == Providers::None ? nullptr : Helper::ProviderFromName::GetInstance(ProviderType)),
 	m_providerType(ProviderType),
@@ -49,7 +52,8 @@ HCG::HCG(IDigest* Digest, IProvider* Provider)
 	m_isDestroyed(false),
 	m_isInitialized(false),
 	m_legalKeySizes(0),
-	m_prdResistant(m_providerSource != nullptr),
+	m_outputCounter(0),
+	m_prdResistant(Provider != nullptr),
 	m_providerSource(Provider),
 	m_providerType(m_providerSource != nullptr ? m_providerSource->Enumeral() : Providers::None),
 	m_reseedCounter(0),
@@ -70,6 +74,7 @@ HCG::~HCG()
 		m_digestType = Digests::None;
 		m_distributionCodeMax = 0;
 		m_isInitialized = false;
+		m_outputCounter = 0;
 		m_prdResistant = false;
 		m_providerType = Providers::None;
 		m_reseedCounter = 0;
@@ -174,31 +179,51 @@ size_t HCG::Generate(std::vector<byte> &Output)
 
 size_t HCG::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Drbg, CLASS_NAME, Length);
+
 	CexAssert(m_isInitialized, "The generator must be initialized before use!");
 	CexAssert((Output.size() - Length) >= OutOffset, "Output buffer too small!");
-	CexAssert(Length <= MAX_REQUEST, "The maximum request size is 32768 bytes!");
 
-	GenerateBlock(Output, OutOffset, Length);
+	if (Length > MAX_OUTPUT - m_outputCounter)
+	{
+		throw CryptoGeneratorException("HCG:Generate", "The maximum output size has been exceeded, re-initialize the generator!");
+	}
+
+	size_t prcLen = Length;
 
-	if (m_prdResistant)
+	while (prcLen != 0)
 	{
-		m_reseedCounter += Length;
+		// split the request at the reseed threshold, so the generator is re-keyed at the same position regardless of the request sizes
+		const size_t RMDSZE = m_prdResistant ? Utility::IntUtils::Min(prcLen, (m_reseedThreshold > m_reseedCounter) ? m_reseedThreshold - m_reseedCounter : 1) : prcLen;
 
-		if (m_reseedCounter >= m_reseedThreshold)
+		GenerateBlock(Output, OutOffset, RMDSZE);
+		m_outputCounter += RMDSZE;
+		OutOffset += RMDSZE;
+		prcLen -= RMDSZE;
+
+		if (m_prdResistant)
 		{
-			++m_reseedRequests;
+			m_reseedCounter += RMDSZE;
 
-			if (m_reseedRequests > MAX_RESEED)
+			if (m_reseedCounter >= m_reseedThreshold)
 			{
-				throw CryptoGeneratorException("HCG:Generate", "The maximum reseed requests can not be exceeded, re-initialize the generator!");
+				++m_reseedRequests;
+
+				if (m_reseedRequests > MAX_RESEED)
+				{
+					throw CryptoGeneratorException("HCG:Generate", "The maximum reseed requests can not be exceeded, re-initialize the generator!");
+				}
+
+				CEX_INSTRUMENT_RESEED();
+
+				m_reseedCounter = 0;
+				// use next block of state as seed material
+				std::vector<byte> state(m_hmacEngine.BlockSize());
+				Generate(state, 0, state.size());
+				// combine with salt from provider, extract, and re-key
+				Derive(state);
+				m_outputCounter = 0;
 			}
-
-			m_reseedCounter = 0;
-			// use next block of state as seed material
-			std::vector<byte> state(m_hmacEngine.BlockSize());
-			Generate(state, 0, state.size());
-			// combine with salt from provider, extract, and re-key
-			Derive(state);
 		}
 	}
 
@@ -207,20 +232,22 @@ size_t HCG::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length)
 
 void HCG::Initialize(ISymmetricKey &GenParam)
 {
-	if (GenParam.Nonce().size() != 0)
+	Key::Symmetric::SymmetricKeyView kv(GenParam);
+
+	if (kv.Nonce().size() != 0)
 	{
-		if (GenParam.Info().size() != 0)
+		if (kv.Info().size() != 0)
 		{
-			Initialize(GenParam.Key(), GenParam.Nonce(), GenParam.Info());
+			Initialize(kv.Key(), kv.Nonce(), kv.Info());
 		}
 		else
 		{
-			Initialize(GenParam.Key(), GenParam.Nonce());
+			Initialize(kv.Key(), kv.Nonce());
 		}
 	}
 	else
 	{
-		Initialize(GenParam.Key());
+		Initialize(kv.Key());
 	}
 }
 
@@ -237,6 +264,7 @@ void HCG::Initialize(const std::vector<byte> &Seed)
 	m_hmacEngine.Initialize(kp);
 	// add entropy and re-mix before first output call
 	Derive(m_hmacKey);
+	m_outputCounter = 0;
 
 	size_t secLen = Seed.size();
 	if (secLen < m_hmacEngine.MacSize())
@@ -288,6 +316,9 @@ void HCG::Initialize(const std::vector<byte> &Seed, const std::vector<byte> &Non
 
 void HCG::Update(const std::vector<byte> &Seed)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Drbg, CLASS_NAME, Seed.size());
+	CEX_INSTRUMENT_RESEED();
+
 	if (!SymmetricKeySize::Contains(LegalKeySizes(), Seed.size()))
 	{
 		throw CryptoGeneratorException("HCG:Update", "Seed size is invalid! Check LegalKeySizes for accepted values.");
@@ -104,6 +104,7 @@ using Enumeration::Providers;
 /// The pseudo-random state array is processed as seed material in the next iteration of the generation cycle, in a continuous transformation process. \n
 /// The state counter can be initialized by the Nonce parameter of the Initialize function to an 8 byte secret and random value, (this is strongly recommended). \n
 /// The reseed-requests counter is incremented by the number of bytes processed by a generation call, if this value exceeds the ReseedThreshold value (10 * the MAC output size by default),
+/// (requests of any length are accepted; a request that crosses the ReseedThreshold is split at the threshold),
 /// the generator transforms the state to an internal array, (not added to output), and uses that state, along with the reseed counter and entropy provider, to buid a new HMAC key. \n
 /// The HMAC is then re-keyed, the reseed-requests counter is reset, and a new initial state is generated by the entropy provider for the next generation cycle.
 /// </para>
@@ -174,6 +175,7 @@ private:
 	bool m_isDestroyed;
 	bool m_isInitialized;
 	std::vector<SymmetricKeySize> m_legalKeySizes;
+	ulong m_outputCounter;
 	bool m_prdResistant;
 	std::unique_ptr<IProvider> m_providerSource;
 	Providers m_providerType;
@@ -257,7 +259,7 @@ public:
 	std::vector<SymmetricKeySize> LegalKeySizes() const override;
 
 	/// <summary>
-	/// Read Only: The maximum number of bytes that can be generated with a generator instance
+	/// Read Only: The maximum number of bytes that can be generated with a generator instance before it must be re-keyed
 	/// </summary>
 	const ulong MaxOutputSize() override;
 
@@ -303,7 +305,7 @@ public:
 	/// <returns>The number of bytes generated</returns>
 	/// 
 	/// <exception cref="Exception::CryptoGeneratorException">Thrown if the generator is not initialized, the output size is misaligned, 
-	/// the maximum request size is exceeded, or if the maximum reseed requests are exceeded</exception>
+	/// the maximum output size is exceeded, or if the maximum reseed requests are exceeded</exception>
 	size_t Generate(std::vector<byte> &Output) override;
 
 	/// <summary>
@@ -317,7 +319,7 @@ public:
 	/// <returns>The number of bytes generated</returns>
 	/// 
 	/// <exception cref="Exception::CryptoGeneratorException">Thrown if the generator is not initialized, the output size is misaligned, 
-	/// the maximum request size is exceeded, or if the maximum reseed requests are exceeded</exception>
+	/// the maximum output size is exceeded, or if the maximum reseed requests are exceeded</exception>
 	size_t Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length) override;
 
 	/// <summary>
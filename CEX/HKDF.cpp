@@ -2,6 +2,7 @@
 #include "DigestFromName.h"
 #include "IntUtils.h"
 #include "SymmetricKey.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_KDF
 
@@ -158,20 +159,22 @@ size_t HKDF::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length
 
 void HKDF::Initialize(ISymmetricKey &GenParam)
 {
-	if (GenParam.Nonce().size() != 0)
+	Key::Symmetric::SymmetricKeyView kv(GenParam);
+
+	if (kv.Nonce().size() != 0)
 	{
-		if (GenParam.Info().size() != 0)
+		if (kv.Info().size() != 0)
 		{
-			Initialize(GenParam.Key(), GenParam.Nonce(), GenParam.Info());
+			Initialize(kv.Key(), kv.Nonce(), kv.Info());
 		}
 		else
 		{
-			Initialize(GenParam.Key(), GenParam.Nonce());
+			Initialize(kv.Key(), kv.Nonce());
 		}
 	}
 	else
 	{
-		Initialize(GenParam.Key());
+		Initialize(kv.Key());
 	}
 }
 
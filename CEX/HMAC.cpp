@@ -1,6 +1,8 @@
 #include "HMAC.h"
 #include "DigestFromName.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_MAC
 
@@ -17,6 +19,7 @@ HMAC::HMAC(Digests DigestType, bool Parallel)
 	m_isDestroyed(false),
 	m_isInitialized(false),
 	m_legalKeySizes(0),
+	m_msgCode(m_msgDigest->DigestSize()),
 	m_msgDigestType(DigestType),
 	m_outputPad(m_msgDigest->BlockSize())
 {
@@ -32,6 +35,7 @@ HMAC::HMAC(IDigest* Digest)
 	m_isDestroyed(false),
 	m_isInitialized(false),
 	m_legalKeySizes(0),
+	m_msgCode(m_msgDigest->DigestSize()),
 	m_msgDigestType(m_msgDigest->Enumeral()),
 	m_outputPad(m_msgDigest->BlockSize())
 {
@@ -48,6 +52,7 @@ HMAC::~HMAC()
 
 		Utility::IntUtils::ClearVector(m_inputPad);
 		Utility::IntUtils::ClearVector(m_legalKeySizes);
+		Utility::IntUtils::ClearVector(m_msgCode);
 		Utility::IntUtils::ClearVector(m_outputPad);
 
 		if (m_destroyEngine)
@@ -137,13 +142,15 @@ void HMAC::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
 
 size_t HMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Mac, CLASS_NAME, 0);
+
 	CexAssert(m_isInitialized, "The Mac is not initialized!");
 	CexAssert((Output.size() - OutOffset) >= m_msgDigest->DigestSize(), "The Output buffer is too short!");
 
-	std::vector<byte> tmpV(m_msgDigest->DigestSize(), 0);
-	m_msgDigest->Finalize(tmpV, 0);
+	// the inner hash is written to a member buffer, so finalizing does not allocate
+	m_msgDigest->Finalize(m_msgCode, 0);
 	m_msgDigest->Update(m_outputPad, 0, m_outputPad.size());
-	m_msgDigest->Update(tmpV, 0, tmpV.size());
+	m_msgDigest->Update(m_msgCode, 0, m_msgCode.size());
 
 	size_t msgLen = m_msgDigest->Finalize(Output, OutOffset);
 	m_msgDigest->Update(m_inputPad, 0, m_inputPad.size());
@@ -153,12 +160,14 @@ size_t HMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
 
 void HMAC::Initialize(ISymmetricKey &KeyParams)
 {
-	if (KeyParams.Key().size() == 0)
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (kv.Key().size() == 0)
 	{
 		throw CryptoMacException("HMAC:Initialize", "Key size is too small; should be a minimum of digest output size!");
 	}
 
-	size_t keyLen = KeyParams.Key().size();
+	size_t keyLen = kv.Key().size();
 
 	if (!m_isInitialized)
 	{
@@ -171,13 +180,13 @@ void HMAC::Initialize(ISymmetricKey &KeyParams)
 
 	if (keyLen > m_msgDigest->BlockSize())
 	{
-		m_msgDigest->Update(KeyParams.Key(), 0, KeyParams.Key().size());
+		m_msgDigest->Update(kv.Key(), 0, kv.Key().size());
 		m_msgDigest->Finalize(m_inputPad, 0);
 		keyLen = m_msgDigest->DigestSize();
 	}
 	else
 	{
-		Utility::MemUtils::Copy(KeyParams.Key(), 0, m_inputPad, 0, keyLen);
+		Utility::MemUtils::Copy(kv.Key(), 0, m_inputPad, 0, keyLen);
 	}
 
 	if (static_cast<int>(m_msgDigest->BlockSize()) - static_cast<int>(keyLen) > 0)
@@ -224,6 +233,8 @@ void HMAC::Update(byte Input)
 
 void HMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Mac, CLASS_NAME, Length);
+
 	CexAssert(m_isInitialized, "The Mac is not initialized!");
 	CexAssert((InOffset + Length) <= Input.size(), "The Input buffer is too short!");
 
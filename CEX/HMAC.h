@@ -98,6 +98,7 @@ private:
 	bool m_isInitialized;
 	std::vector<byte> m_inputPad;
 	std::vector<SymmetricKeySize> m_legalKeySizes;
+	std::vector<byte> m_msgCode;
 	Digests m_msgDigestType;
 	std::vector<byte> m_outputPad;
 
@@ -184,6 +184,30 @@ public:
 	/// <param name="OutOffset">Starting offset within the output array</param>
 	virtual void EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) = 0;
 
+	/// <summary>
+	/// Export the expanded key schedule of the initialized cipher.
+	/// <para>The schedule is an opaque array that can be loaded into another instance of the same cipher type, one that reports the same Enumeral() (an HKDF extended instance for an extended schedule), with <see cref="ImportSchedule(std::vector<byte>)"/>, 
+	/// so that several instances, e.g. one per worker thread, share a single key expansion.
+	/// The array begins with an 8 byte header; the cipher type, the direction, the rounds count, a reserved byte, and the size of the input key <c>in bits</c> 
+	/// (the key length in bytes multiplied by 8) as a little endian 32 bit integer, followed by the cipher specific round keys.
+	/// The array holds the round keys in the clear, and should be cleared by the caller after use.</para>
+	/// </summary>
+	/// 
+	/// <param name="Schedule">The array receiving the key schedule; resized to the schedule length</param>
+	/// 
+	/// <exception cref="Exception::CryptoSymmetricCipherException">Thrown if the cipher has not been initialized</exception>
+	virtual void ExportSchedule(std::vector<byte> &Schedule) = 0;
+
+	/// <summary>
+	/// Initialize the cipher with a key schedule created by <see cref="ExportSchedule(std::vector<byte>)"/>, without expanding a key.
+	/// <para>The cipher takes the direction, rounds count and round keys of the exporting instance.</para>
+	/// </summary>
+	/// 
+	/// <param name="Schedule">The exported key schedule</param>
+	/// 
+	/// <exception cref="Exception::CryptoSymmetricCipherException">Thrown if the schedule was exported by another cipher type, or is malformed</exception>
+	virtual void ImportSchedule(const std::vector<byte> &Schedule) = 0;
+
 	/// <summary>
 	/// Initialize the cipher
 	/// </summary>
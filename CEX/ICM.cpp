@@ -1,7 +1,9 @@
 #include "ICM.h"
 #include "BlockCipherFromName.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
 #include "ParallelUtils.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_MODE
 
@@ -22,6 +24,7 @@ ICM::ICM(BlockCiphers CipherType)
 	m_isLoaded(false),
 	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true)
 {
+	m_parallelProfile.Calibrate(Name());
 }
 
 ICM::ICM(IBlockCipher* Cipher)
@@ -37,6 +40,7 @@ ICM::ICM(IBlockCipher* Cipher)
 	m_isLoaded(false),
 	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true)
 {
+	m_parallelProfile.Calibrate(Name());
 }
 
 ICM::~ICM()
@@ -152,7 +156,9 @@ void ICM::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 
 void ICM::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size(), KeyParams.Nonce().size()))
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), kv.Key().size(), kv.Nonce().size()))
 	{
 		throw CryptoSymmetricCipherException("ICM:Initialize", "Invalid key or nonce size! Key and nonce must be one of the LegalKeySizes() members in length.");
 	}
@@ -167,7 +173,7 @@ void ICM::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 
 	Scope();
 	m_blockCipher->Initialize(true, KeyParams);
-	Utility::MemUtils::COPY128(KeyParams.Nonce(), 0, m_ctrVector, 0);
+	Utility::MemUtils::COPY128(kv.Nonce(), 0, m_ctrVector, 0);
 	m_isEncryption = Encryption;
 	m_isInitialized = true;
 }
@@ -183,6 +189,8 @@ void ICM::ParallelMaxDegree(size_t Degree)
 
 void ICM::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::CipherMode, CLASS_NAME, Length);
+
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the length!");
 
@@ -190,6 +198,8 @@ void ICM::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 
 	if (m_parallelProfile.IsParallel() && Length >= PRLBLK)
 	{
+		CEX_INSTRUMENT_PARALLEL();
+
 		const size_t BLKCNT = Length / PRLBLK;
 
 		for (size_t i = 0; i < BLKCNT; ++i)
@@ -238,44 +248,15 @@ void ICM::Generate(std::vector<byte> &Output, const size_t OutOffset, const size
 	const size_t AVX512BLK = 16 * BLOCK_SIZE;
 	if (Length >= AVX512BLK)
 	{
+		CEX_INSTRUMENT_SIMD(512);
+
 		const size_t PBKALN = Length - (Length % AVX512BLK);
 		std::vector<byte> ctrBlk(AVX512BLK);
 
 		// stagger counters and process 8 blocks with avx
 		while (blkCtr != PBKALN)
 		{
-			Convert(Counter, ctrBlk, 0);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 16);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 32);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 48);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 64);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 80);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 96);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 112);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 128);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 144);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 160);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 176);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 192);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 208);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 224);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 240);
-			Utility::IntUtils::LeIncrementW(Counter);
+			Utility::IntUtils::LeIncrementBlocksW(Counter, ctrBlk, 0, 16);
 			m_blockCipher->Transform2048(ctrBlk, 0, Output, OutOffset + blkCtr);
 			blkCtr += AVX512BLK;
 		}
@@ -284,28 +265,15 @@ void ICM::Generate(std::vector<byte> &Output, const size_t OutOffset, const size
 	const size_t AVX2BLK = 8 * BLOCK_SIZE;
 	if (Length >= AVX2BLK)
 	{
+		CEX_INSTRUMENT_SIMD(256);
+
 		const size_t PBKALN = Length - (Length % AVX2BLK);
 		std::vector<byte> ctrBlk(AVX2BLK);
 
 		// stagger counters and process 8 blocks with avx
 		while (blkCtr != PBKALN)
 		{
-			Convert(Counter, ctrBlk, 0);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 16);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 32);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 48);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 64);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 80);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 96);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 112);
-			Utility::IntUtils::LeIncrementW(Counter);
+			Utility::IntUtils::LeIncrementBlocksW(Counter, ctrBlk, 0, 8);
 			m_blockCipher->Transform1024(ctrBlk, 0, Output, OutOffset + blkCtr);
 			blkCtr += AVX2BLK;
 		}
@@ -314,20 +282,15 @@ void ICM::Generate(std::vector<byte> &Output, const size_t OutOffset, const size
 	const size_t AVXBLK = 4 * BLOCK_SIZE;
 	if (Length >= AVXBLK)
 	{
+		CEX_INSTRUMENT_SIMD(128);
+
 		const size_t PBKALN = Length - (Length % AVXBLK);
 		std::vector<byte> ctrBlk(AVXBLK);
 
 		// 4 blocks with sse
 		while (blkCtr != PBKALN)
 		{
-			Convert(Counter, ctrBlk, 0);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 16);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 32);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 48);
-			Utility::IntUtils::LeIncrementW(Counter);
+			Utility::IntUtils::LeIncrementBlocksW(Counter, ctrBlk, 0, 4);
 			m_blockCipher->Transform512(ctrBlk, 0, Output, OutOffset + blkCtr);
 			blkCtr += AVXBLK;
 		}
@@ -67,6 +67,21 @@ public:
 	/// </summary>
 	virtual const std::vector<byte> Info() = 0;
 
+	/// <summary>
+	/// Read Only: A reference to the personalization string; valid only while the key is unlocked
+	/// </summary>
+	virtual const std::vector<byte> &InfoRef() = 0;
+
+	/// <summary>
+	/// Read Only: A reference to the primary key; valid only while the key is unlocked
+	/// </summary>
+	virtual const std::vector<byte> &KeyRef() = 0;
+
+	/// <summary>
+	/// Read Only: A reference to the nonce or initialization vector; valid only while the key is unlocked
+	/// </summary>
+	virtual const std::vector<byte> &NonceRef() = 0;
+
 	//~~~Public Functions~~~//
 
 	/// <summary>
@@ -82,6 +97,17 @@ public:
 	/// 
 	/// <returns>Returns true if equal</returns>
 	virtual bool Equals(ISymmetricKey &Input) = 0;
+
+	/// <summary>
+	/// Release the key material exposed by the last matching call to <see cref="Unlock()"/>
+	/// </summary>
+	virtual void Lock() = 0;
+
+	/// <summary>
+	/// Expose the key material to the reference accessors until the matching call to <see cref="Lock()"/>.
+	/// <para>Calls can be nested, each Unlock must be balanced by a Lock; the SymmetricKeyView class does this within a scope.</para>
+	/// </summary>
+	virtual void Unlock() = 0;
 };
 
 NAMESPACE_SYMMETRICKEYEND
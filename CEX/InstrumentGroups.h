@@ -0,0 +1,41 @@
+#ifndef CEX_INSTRUMENTGROUPS_H
+#define CEX_INSTRUMENTGROUPS_H
+
+#include "CexDomain.h"
+
+NAMESPACE_ENUMERATION
+
+/// <summary>
+/// The interface boundaries counted by the Instrumentation class.
+/// <para>Each instrumented call site belongs to the group of the interface it implements.</para>
+/// </summary>
+enum class InstrumentGroups : byte
+{
+	/// <summary>
+	/// The Transform functions of the ICipherMode implementations
+	/// </summary>
+	CipherMode = 0,
+	/// <summary>
+	/// The Update and Finalize functions of the IDigest implementations
+	/// </summary>
+	Digest = 1,
+	/// <summary>
+	/// The Update and Finalize functions of the IMac implementations
+	/// </summary>
+	Mac = 2,
+	/// <summary>
+	/// The Generate and Update functions of the IDrbg implementations
+	/// </summary>
+	Drbg = 3,
+	/// <summary>
+	/// The key generation, encapsulation and decapsulation functions of the IAsymmetricCipher implementations
+	/// </summary>
+	Asymmetric = 4,
+	/// <summary>
+	/// The internal phases of the asymmetric ciphers marked with the CEX_INSTRUMENT_PHASE macro
+	/// </summary>
+	Phase = 5
+};
+
+NAMESPACE_ENUMERATIONEND
+#endif
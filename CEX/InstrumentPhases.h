@@ -0,0 +1,37 @@
+#ifndef CEX_INSTRUMENTPHASES_H
+#define CEX_INSTRUMENTPHASES_H
+
+#include "CexDomain.h"
+
+NAMESPACE_ENUMERATION
+
+/// <summary>
+/// The internal phases of the asymmetric ciphers timed by the Instrumentation class.
+/// <para>Each phase is counted as a call site of the Phase group, named by the phase.</para>
+/// </summary>
+enum class InstrumentPhases : byte
+{
+	/// <summary>
+	/// Expansion of the public matrix or uniform polynomial from a seed; the public key Gaussian elimination in McEliece
+	/// </summary>
+	MatrixExpansion = 0,
+	/// <summary>
+	/// The forward and inverse number theoretic transforms; the additive and transposed FFTs in McEliece
+	/// </summary>
+	Transform = 1,
+	/// <summary>
+	/// Sampling of the noise polynomials; the error vector and Goppa polynomial generation in McEliece
+	/// </summary>
+	NoiseSampling = 2,
+	/// <summary>
+	/// Encoding and decoding of the keys and ciphertext
+	/// </summary>
+	Packing = 3,
+	/// <summary>
+	/// Derivation of the shared secret
+	/// </summary>
+	Hashing = 4
+};
+
+NAMESPACE_ENUMERATIONEND
+#endif
@@ -0,0 +1,387 @@
+#include "Instrumentation.h"
+#include "SysUtils.h"
+#include <algorithm>
+
+NAMESPACE_COMMON
+
+using Utility::SysUtils;
+
+//~~~Counters~~~//
+
+struct Instrumentation::SiteCounters
+{
+	std::atomic<ulong> Calls;
+	std::atomic<ulong> Bytes;
+	std::atomic<ulong> Cycles;
+	std::atomic<ulong> ParallelCalls;
+	std::atomic<ulong> SimdWidth;
+	std::atomic<ulong> Reseeds;
+	std::atomic<ulong> Allocations;
+	std::atomic<ulong> AllocatedBytes;
+};
+
+// the counters of one thread; registered with the live list for its lifetime, and folded into the retired totals when the thread exits
+struct Instrumentation::ThreadCounters
+{
+	std::array<SiteCounters, MAX_SITES> Sites;
+
+	ThreadCounters();
+	~ThreadCounters();
+};
+
+std::vector<Instrumentation::SiteInfo> Instrumentation::m_siteInfo;
+std::mutex Instrumentation::m_siteLock;
+// the counts of the threads that have exited and the live thread blocks, guarded by m_threadLock
+std::array<Instrumentation::SiteRecord, Instrumentation::MAX_SITES> Instrumentation::m_retiredTotals;
+std::vector<Instrumentation::ThreadCounters*> Instrumentation::m_threadList;
+std::mutex Instrumentation::m_threadLock;
+// the innermost open call on this thread; a plain pointer, so reading it never constructs thread state
+static thread_local Instrumentation::CallScope* activeScope = nullptr;
+
+// the owning thread is the only writer, so a load and store replaces the locked read-modify-write
+static void Add(std::atomic<ulong> &Counter, ulong Value)
+{
+	Counter.store(Counter.load(std::memory_order_relaxed) + Value, std::memory_order_relaxed);
+}
+
+static void Clear(Instrumentation::SiteRecord &Record)
+{
+	Record.Calls = 0;
+	Record.Bytes = 0;
+	Record.Cycles = 0;
+	Record.ParallelCalls = 0;
+	Record.SimdWidth = 0;
+	Record.Reseeds = 0;
+	Record.Allocations = 0;
+	Record.AllocatedBytes = 0;
+}
+
+Instrumentation::ThreadCounters::ThreadCounters()
+{
+	for (size_t i = 0; i < MAX_SITES; ++i)
+	{
+		Sites[i].Calls.store(0, std::memory_order_relaxed);
+		Sites[i].Bytes.store(0, std::memory_order_relaxed);
+		Sites[i].Cycles.store(0, std::memory_order_relaxed);
+		Sites[i].ParallelCalls.store(0, std::memory_order_relaxed);
+		Sites[i].SimdWidth.store(0, std::memory_order_relaxed);
+		Sites[i].Reseeds.store(0, std::memory_order_relaxed);
+		Sites[i].Allocations.store(0, std::memory_order_relaxed);
+		Sites[i].AllocatedBytes.store(0, std::memory_order_relaxed);
+	}
+
+	std::lock_guard<std::mutex> lock(m_threadLock);
+	m_threadList.push_back(this);
+}
+
+Instrumentation::ThreadCounters::~ThreadCounters()
+{
+	std::lock_guard<std::mutex> lock(m_threadLock);
+
+	for (size_t i = 0; i < MAX_SITES; ++i)
+	{
+		SiteRecord &rec = m_retiredTotals[i];
+
+		rec.Calls += Sites[i].Calls.load(std::memory_order_relaxed);
+		rec.Bytes += Sites[i].Bytes.load(std::memory_order_relaxed);
+		rec.Cycles += Sites[i].Cycles.load(std::memory_order_relaxed);
+		rec.ParallelCalls += Sites[i].ParallelCalls.load(std::memory_order_relaxed);
+		rec.SimdWidth = std::max(rec.SimdWidth, Sites[i].SimdWidth.load(std::memory_order_relaxed));
+		rec.Reseeds += Sites[i].Reseeds.load(std::memory_order_relaxed);
+		rec.Allocations += Sites[i].Allocations.load(std::memory_order_relaxed);
+		rec.AllocatedBytes += Sites[i].AllocatedBytes.load(std::memory_order_relaxed);
+	}
+
+	m_threadList.erase(std::remove(m_threadList.begin(), m_threadList.end(), this), m_threadList.end());
+}
+
+Instrumentation::SiteRecord::SiteRecord()
+	:
+	Group(InstrumentGroups::CipherMode),
+	Name(""),
+	Function(""),
+	Calls(0),
+	Bytes(0),
+	Cycles(0),
+	ParallelCalls(0),
+	SimdWidth(0),
+	Reseeds(0),
+	Allocations(0),
+	AllocatedBytes(0)
+{
+}
+
+//~~~CallScope~~~//
+
+Instrumentation::CallScope::CallScope(size_t Site, ulong Bytes, bool IsPhase)
+	:
+	m_bytes(Bytes),
+	m_counters(nullptr),
+	m_isParallel(false),
+	m_isPhase(IsPhase),
+	m_parent(activeScope),
+	m_start(0)
+{
+	if (Site < MAX_SITES)
+	{
+		m_counters = &LocalCounters().Sites[Site];
+		activeScope = this;
+		m_start = SysUtils::CycleCount();
+	}
+}
+
+Instrumentation::CallScope::~CallScope()
+{
+	if (m_counters != nullptr)
+	{
+		const ulong ELPCYC = SysUtils::CycleCount() - m_start;
+
+		Add(m_counters->Cycles, ELPCYC);
+		Add(m_counters->Bytes, m_bytes);
+		Add(m_counters->Calls, 1);
+		Add(m_counters->ParallelCalls, m_isParallel ? 1 : 0);
+		activeScope = m_parent;
+
+		// an enclosing phase step resumes after this one, its start moves forward by the time spent here
+		if (m_isPhase && m_parent != nullptr && m_parent->m_isPhase)
+		{
+			m_parent->m_start += ELPCYC;
+		}
+	}
+}
+
+//~~~Public Functions~~~//
+
+bool Instrumentation::Enabled()
+{
+#if defined(CEX_INSTRUMENTATION)
+	return true;
+#else
+	return false;
+#endif
+}
+
+std::string Instrumentation::Export()
+{
+	const char* NAMES[] = { "calls", "bytes", "cycles", "parallel_calls", "reseeds", "allocations", "allocated_bytes", "simd_width_bits" };
+	const size_t CTRCNT = sizeof(NAMES) / sizeof(NAMES[0]);
+	std::vector<SiteRecord> recs = Snapshot();
+	std::string ret;
+
+	for (size_t i = 0; i < CTRCNT; ++i)
+	{
+		// the width is a level rather than a running total
+		const bool ISGAUG = (i == CTRCNT - 1);
+		const std::string MTRNME = std::string("cex_") + NAMES[i] + (ISGAUG ? "" : "_total");
+
+		ret += "# TYPE " + MTRNME + (ISGAUG ? " gauge\n" : " counter\n");
+
+		for (size_t j = 0; j < recs.size(); ++j)
+		{
+			const SiteRecord &rec = recs[j];
+			const ulong CTRVAL[] = { rec.Calls, rec.Bytes, rec.Cycles, rec.ParallelCalls, rec.Reseeds, rec.Allocations, rec.AllocatedBytes, rec.SimdWidth };
+
+			if (rec.Calls != 0)
+			{
+				ret += MTRNME + "{group=\"" + GroupName(rec.Group) + "\",primitive=\"" + rec.Name + "\",function=\"" + rec.Function + "\"} " + std::to_string(CTRVAL[i]) + "\n";
+			}
+		}
+	}
+
+	return ret;
+}
+
+std::string Instrumentation::GroupName(InstrumentGroups Group)
+{
+	std::string ret;
+
+	switch (Group)
+	{
+		case InstrumentGroups::CipherMode:
+			ret = "cipher_mode";
+			break;
+		case InstrumentGroups::Digest:
+			ret = "digest";
+			break;
+		case InstrumentGroups::Mac:
+			ret = "mac";
+			break;
+		case InstrumentGroups::Drbg:
+			ret = "drbg";
+			break;
+		case InstrumentGroups::Asymmetric:
+			ret = "asymmetric";
+			break;
+		default:
+			ret = "phase";
+			break;
+	}
+
+	return ret;
+}
+
+void Instrumentation::MarkParallel()
+{
+	if (activeScope != nullptr)
+	{
+		activeScope->m_isParallel = true;
+	}
+}
+
+void Instrumentation::MarkReseed()
+{
+	if (activeScope != nullptr)
+	{
+		Add(activeScope->m_counters->Reseeds, 1);
+	}
+}
+
+void Instrumentation::MarkSimd(ulong Width)
+{
+	if (activeScope != nullptr && activeScope->m_counters->SimdWidth.load(std::memory_order_relaxed) < Width)
+	{
+		activeScope->m_counters->SimdWidth.store(Width, std::memory_order_relaxed);
+	}
+}
+
+void Instrumentation::RecordAllocation(size_t Size)
+{
+	if (activeScope != nullptr)
+	{
+		Add(activeScope->m_counters->Allocations, 1);
+		Add(activeScope->m_counters->AllocatedBytes, Size);
+	}
+}
+
+std::string Instrumentation::PhaseName(InstrumentPhases Phase)
+{
+	std::string ret;
+
+	switch (Phase)
+	{
+		case InstrumentPhases::MatrixExpansion:
+			ret = "matrix";
+			break;
+		case InstrumentPhases::Transform:
+			ret = "ntt";
+			break;
+		case InstrumentPhases::NoiseSampling:
+			ret = "noise";
+			break;
+		case InstrumentPhases::Packing:
+			ret = "packing";
+			break;
+		default:
+			ret = "hashing";
+			break;
+	}
+
+	return ret;
+}
+
+size_t Instrumentation::Register(InstrumentGroups Group, const std::string &Name, const std::string &Function)
+{
+	std::lock_guard<std::mutex> lock(m_siteLock);
+	size_t idx;
+
+	// overloads of a function, and a site compiled into more than one unit, share their counters
+	for (idx = 0; idx < m_siteInfo.size(); ++idx)
+	{
+		if (m_siteInfo[idx].Group == Group && m_siteInfo[idx].Name == Name && m_siteInfo[idx].Function == Function)
+		{
+			break;
+		}
+	}
+
+	if (idx == m_siteInfo.size() && idx < MAX_SITES)
+	{
+		m_siteInfo.push_back(SiteInfo(Group, Name, Function));
+	}
+
+	return (idx < MAX_SITES) ? idx : MAX_SITES;
+}
+
+void Instrumentation::Reset()
+{
+	std::lock_guard<std::mutex> lock(m_threadLock);
+
+	for (size_t i = 0; i < MAX_SITES; ++i)
+	{
+		Clear(m_retiredTotals[i]);
+
+		for (size_t j = 0; j < m_threadList.size(); ++j)
+		{
+			SiteCounters &ctr = m_threadList[j]->Sites[i];
+
+			ctr.Calls.store(0, std::memory_order_relaxed);
+			ctr.Bytes.store(0, std::memory_order_relaxed);
+			ctr.Cycles.store(0, std::memory_order_relaxed);
+			ctr.ParallelCalls.store(0, std::memory_order_relaxed);
+			ctr.SimdWidth.store(0, std::memory_order_relaxed);
+			ctr.Reseeds.store(0, std::memory_order_relaxed);
+			ctr.Allocations.store(0, std::memory_order_relaxed);
+			ctr.AllocatedBytes.store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+std::vector<Instrumentation::SiteRecord> Instrumentation::Snapshot()
+{
+	std::vector<SiteRecord> ret;
+
+	{
+		std::lock_guard<std::mutex> lock(m_siteLock);
+
+		ret.resize(m_siteInfo.size());
+
+		for (size_t i = 0; i < m_siteInfo.size(); ++i)
+		{
+			ret[i].Group = m_siteInfo[i].Group;
+			ret[i].Name = m_siteInfo[i].Name;
+			ret[i].Function = m_siteInfo[i].Function;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(m_threadLock);
+
+	for (size_t i = 0; i < ret.size(); ++i)
+	{
+		SiteRecord &rec = ret[i];
+
+		rec.Calls = m_retiredTotals[i].Calls;
+		rec.Bytes = m_retiredTotals[i].Bytes;
+		rec.Cycles = m_retiredTotals[i].Cycles;
+		rec.ParallelCalls = m_retiredTotals[i].ParallelCalls;
+		rec.SimdWidth = m_retiredTotals[i].SimdWidth;
+		rec.Reseeds = m_retiredTotals[i].Reseeds;
+		rec.Allocations = m_retiredTotals[i].Allocations;
+		rec.AllocatedBytes = m_retiredTotals[i].AllocatedBytes;
+
+		for (size_t j = 0; j < m_threadList.size(); ++j)
+		{
+			const SiteCounters &ctr = m_threadList[j]->Sites[i];
+
+			rec.Calls += ctr.Calls.load(std::memory_order_relaxed);
+			rec.Bytes += ctr.Bytes.load(std::memory_order_relaxed);
+			rec.Cycles += ctr.Cycles.load(std::memory_order_relaxed);
+			rec.ParallelCalls += ctr.ParallelCalls.load(std::memory_order_relaxed);
+			rec.SimdWidth = std::max(rec.SimdWidth, ctr.SimdWidth.load(std::memory_order_relaxed));
+			rec.Reseeds += ctr.Reseeds.load(std::memory_order_relaxed);
+			rec.Allocations += ctr.Allocations.load(std::memory_order_relaxed);
+			rec.AllocatedBytes += ctr.AllocatedBytes.load(std::memory_order_relaxed);
+		}
+	}
+
+	return ret;
+}
+
+//~~~Private Functions~~~//
+
+Instrumentation::ThreadCounters &Instrumentation::LocalCounters()
+{
+	static thread_local ThreadCounters ctrs;
+
+	return ctrs;
+}
+
+NAMESPACE_COMMONEND
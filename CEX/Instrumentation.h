@@ -0,0 +1,299 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_INSTRUMENTATION_H
+#define CEX_INSTRUMENTATION_H
+
+#include "CexDomain.h"
+#include "InstrumentGroups.h"
+#include "InstrumentPhases.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+NAMESPACE_COMMON
+
+using Enumeration::InstrumentGroups;
+using Enumeration::InstrumentPhases;
+
+/// <summary>
+/// Call, byte and cycle counters at the public boundaries of the cipher modes, digests, MACs, DRBGs and asymmetric ciphers.
+/// <para>The implementations mark their entry points with the CEX_INSTRUMENT_CALL macro, which registers the call site once and times the call with the RDTSC counter.
+/// Inside a timed call, the code can record the path it took: CEX_INSTRUMENT_PARALLEL when the input is processed by the multi-threaded path, CEX_INSTRUMENT_SIMD with the vector width in bits,
+/// and CEX_INSTRUMENT_RESEED when a generator refreshes its state.
+/// The asymmetric ciphers also mark the steps of their internal phases, the matrix expansion, transforms, noise sampling, packing and hashing, with CEX_INSTRUMENT_PHASE; each step is a site of the Phase group, named by its phase.
+/// The macros are empty unless the library is built with CEX_INSTRUMENTATION defined in CexConfig.h, so an uninstrumented build carries no counting code.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Exporting the counters to a metrics scraper:</description>
+/// <code>
+/// std::string txt = Instrumentation::Export();
+/// // or, per call site
+/// std::vector&lt;Instrumentation::SiteRecord&gt; recs = Instrumentation::Snapshot();
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <para>Every thread owns a block of counters, indexed by call site, that only it writes; the counters are relaxed atomics updated with a load and a store, so a timed call takes no lock and issues no locked instruction.
+/// The thread registers its block the first time it enters a timed call, and folds its counts into the process totals when it exits.
+/// Snapshot sums the blocks of the live threads with the process totals; counts written during the snapshot may or may not be included.</para>
+/// <para>Calls are counted at each boundary they cross: an HMAC Finalize is counted for the HMAC, and the digest calls it makes are counted again for the digest. The cycles of a site include the nested calls.
+/// A phase step is the exception: a phase step nested directly in another excludes it from its own cycles, so the phases of an operation can be summed.
+/// The path marks and the allocation count apply to the innermost timed call of the thread; marks made on worker threads, outside any timed call, are ignored.</para>
+/// <para>The library does not replace the global allocator; an application that does can call RecordAllocation from its operator new to attribute heap allocations to the primitive that made them.</para>
+/// </remarks>
+class Instrumentation
+{
+private:
+
+	struct SiteCounters;
+	struct ThreadCounters;
+
+public:
+
+	/// <summary>
+	/// The maximum number of call sites; sites registered past this are not counted
+	/// </summary>
+	static const size_t MAX_SITES = 256;
+
+	/// <summary>
+	/// The counters of one call site, summed over all threads
+	/// </summary>
+	struct SiteRecord
+	{
+		/// <summary>
+		/// The interface boundary of the site
+		/// </summary>
+		InstrumentGroups Group;
+		/// <summary>
+		/// The class name of the primitive, or the phase name of a Phase site
+		/// </summary>
+		std::string Name;
+		/// <summary>
+		/// The function name
+		/// </summary>
+		std::string Function;
+		/// <summary>
+		/// The number of completed calls
+		/// </summary>
+		ulong Calls;
+		/// <summary>
+		/// The number of bytes processed by the calls: the input of Transform, Update and Decrypt, the output of Generate; Finalize adds none
+		/// </summary>
+		ulong Bytes;
+		/// <summary>
+		/// The RDTSC cycles spent in the calls
+		/// </summary>
+		ulong Cycles;
+		/// <summary>
+		/// The number of calls that took the multi-threaded path; the remainder ran sequentially
+		/// </summary>
+		ulong ParallelCalls;
+		/// <summary>
+		/// The widest SIMD path taken, in bits; zero if the site does not report a width
+		/// </summary>
+		ulong SimdWidth;
+		/// <summary>
+		/// The number of state refreshes made by a generator
+		/// </summary>
+		ulong Reseeds;
+		/// <summary>
+		/// The number of heap allocations reported through RecordAllocation
+		/// </summary>
+		ulong Allocations;
+		/// <summary>
+		/// The size of the reported heap allocations in bytes
+		/// </summary>
+		ulong AllocatedBytes;
+
+		SiteRecord();
+	};
+
+	/// <summary>
+	/// Times a call to an instrumented function; the counters of the site are updated when the scope ends
+	/// </summary>
+	class CallScope
+	{
+	private:
+
+		ulong m_bytes;
+		SiteCounters* m_counters;
+		bool m_isParallel;
+		bool m_isPhase;
+		CallScope* m_parent;
+		ulong m_start;
+
+	public:
+
+		CallScope(const CallScope&) = delete;
+		CallScope& operator=(const CallScope&) = delete;
+
+		/// <summary>
+		/// Start timing a call
+		/// </summary>
+		///
+		/// <param name="Site">The site index returned by Register</param>
+		/// <param name="Bytes">The number of bytes the call processes</param>
+		/// <param name="IsPhase">The scope is a phase step, and is excluded from the cycles of an enclosing phase step</param>
+		CallScope(size_t Site, ulong Bytes, bool IsPhase = false);
+
+		/// <summary>
+		/// Add the call to the counters of the site
+		/// </summary>
+		~CallScope();
+
+		friend class Instrumentation;
+	};
+
+private:
+
+	struct SiteInfo
+	{
+		InstrumentGroups Group;
+		std::string Name;
+		std::string Function;
+
+		SiteInfo(InstrumentGroups SiteGroup, const std::string &SiteName, const std::string &SiteFunction)
+			:
+			Group(SiteGroup),
+			Name(SiteName),
+			Function(SiteFunction)
+		{
+		}
+	};
+
+	static std::vector<SiteInfo> m_siteInfo;
+	static std::mutex m_siteLock;
+	static std::array<SiteRecord, MAX_SITES> m_retiredTotals;
+	static std::vector<ThreadCounters*> m_threadList;
+	static std::mutex m_threadLock;
+
+public:
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Get: The library was built with CEX_INSTRUMENTATION, and the instrumented functions update the counters
+	/// </summary>
+	static bool Enabled();
+
+	/// <summary>
+	/// Write the counters in the Prometheus text exposition format.
+	/// <para>Each counter is a metric named cex_[counter]_total, with the group, primitive and function of the site as labels, and the SIMD width is the cex_simd_width_bits gauge; sites that have not been called are omitted.</para>
+	/// </summary>
+	///
+	/// <returns>The metrics text</returns>
+	static std::string Export();
+
+	/// <summary>
+	/// Get the name of a group as used in the exported labels
+	/// </summary>
+	///
+	/// <param name="Group">The group</param>
+	///
+	/// <returns>The group name in lower case</returns>
+	static std::string GroupName(InstrumentGroups Group);
+
+	/// <summary>
+	/// Mark the innermost timed call of this thread as having taken the multi-threaded path; the call is counted once however often it is marked
+	/// </summary>
+	static void MarkParallel();
+
+	/// <summary>
+	/// Mark a state refresh of the generator in the innermost timed call of this thread
+	/// </summary>
+	static void MarkReseed();
+
+	/// <summary>
+	/// Record the SIMD width used by the innermost timed call of this thread
+	/// </summary>
+	///
+	/// <param name="Width">The vector width in bits</param>
+	static void MarkSimd(ulong Width);
+
+	/// <summary>
+	/// Get the name of a phase as used in the site name of a Phase site
+	/// </summary>
+	///
+	/// <param name="Phase">The phase</param>
+	///
+	/// <returns>The phase name in lower case</returns>
+	static std::string PhaseName(InstrumentPhases Phase);
+
+	/// <summary>
+	/// Add a heap allocation to the innermost timed call of this thread.
+	/// <para>Does not allocate, and can be called from a replacement operator new; an allocation made outside a timed call is ignored.</para>
+	/// </summary>
+	///
+	/// <param name="Size">The allocation size in bytes</param>
+	static void RecordAllocation(size_t Size);
+
+	/// <summary>
+	/// Add a call site and get its counter index; called once per site by the CEX_INSTRUMENT_CALL macro
+	/// </summary>
+	///
+	/// <param name="Group">The interface boundary of the site</param>
+	/// <param name="Name">The class name of the primitive</param>
+	/// <param name="Function">The function name</param>
+	///
+	/// <returns>The site index, or MAX_SITES if the site table is full</returns>
+	static size_t Register(InstrumentGroups Group, const std::string &Name, const std::string &Function);
+
+	/// <summary>
+	/// Set every counter to zero.
+	/// <para>Calls in progress on other threads while the counters are reset may be partly counted.</para>
+	/// </summary>
+	static void Reset();
+
+	/// <summary>
+	/// Get the counters of every registered call site
+	/// </summary>
+	///
+	/// <returns>One record per site, in registration order</returns>
+	static std::vector<SiteRecord> Snapshot();
+
+private:
+
+	static ThreadCounters &LocalCounters();
+};
+
+NAMESPACE_COMMONEND
+
+// times the enclosing function as a call of the named primitive; Bytes is the size of the input or output it processes
+// CEX_INSTRUMENT_PHASE times the enclosing scope as a step of an asymmetric cipher phase
+#if defined(CEX_INSTRUMENTATION)
+#	define CEX_INSTRUMENT_CALL(Group, Name, Bytes) \
+		static const size_t insSite = CEX::Common::Instrumentation::Register(Group, Name, __func__); \
+		CEX::Common::Instrumentation::CallScope insScope(insSite, static_cast<ulong>(Bytes))
+#	define CEX_INSTRUMENT_PARALLEL() CEX::Common::Instrumentation::MarkParallel()
+#	define CEX_INSTRUMENT_PHASE(PhaseType) \
+		static const size_t insPhsSite = CEX::Common::Instrumentation::Register(CEX::Enumeration::InstrumentGroups::Phase, CEX::Common::Instrumentation::PhaseName(PhaseType), __func__); \
+		CEX::Common::Instrumentation::CallScope insPhsScope(insPhsSite, 0, true)
+#	define CEX_INSTRUMENT_RESEED() CEX::Common::Instrumentation::MarkReseed()
+#	define CEX_INSTRUMENT_SIMD(Width) CEX::Common::Instrumentation::MarkSimd(Width)
+#else
+#	define CEX_INSTRUMENT_CALL(Group, Name, Bytes)
+#	define CEX_INSTRUMENT_PARALLEL()
+#	define CEX_INSTRUMENT_PHASE(PhaseType)
+#	define CEX_INSTRUMENT_RESEED()
+#	define CEX_INSTRUMENT_SIMD(Width)
+#endif
+
+#endif
@@ -116,8 +116,8 @@ public:
 	/// </summary>
 	///
 	/// <param name="Input">A byte vector array</param>
-	template <typename T>
-	inline static void ClearVector(std::vector<T> &Input)
+	template <typename T, typename Allocator>
+	inline static void ClearVector(std::vector<T, Allocator> &Input)
 	{
 		if (Input.size() != 0)
 		{
@@ -733,6 +733,46 @@ public:
 		}
 	}
 
+	/// <summary>
+	/// Writes a run of consecutive 128bit Big Endian counter blocks to an output array, and advances the counter by the number of blocks written.
+	/// <para>The counter is held in a SIMD register; each block is produced with a vector add, the carry is propagated from the low to the high 64bit word,
+	/// and the block is byte swapped with a shuffle. Used by the counter modes to stagger counters ahead of the wide Transform functions.</para>
+	/// </summary>
+	/// 
+	/// <param name="Counter">The 16 byte Big Endian counter array; advanced by BlockCount</param>
+	/// <param name="Output">The destination byte array</param>
+	/// <param name="OutOffset">The starting offset within the destination array</param>
+	/// <param name="BlockCount">The number of 16 byte counter blocks to write</param>
+	template<typename ArrayA, typename ArrayB>
+	inline static void BeIncrementBlocks8(ArrayA &Counter, ArrayB &Output, size_t OutOffset, size_t BlockCount)
+	{
+		CexAssert(Counter.size() == 16, "The counter must be 16 bytes");
+		CexAssert(Output.size() - OutOffset >= BlockCount * 16, "The output array is too small");
+
+#if defined(__AVX__)
+		const __m128i SWPMSK = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+		const __m128i CTRINC = _mm_set_epi64x(0, 1);
+		const __m128i ZERO = _mm_setzero_si128();
+		__m128i ctr = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&Counter[0])), SWPMSK);
+
+		for (size_t i = 0; i < BlockCount; ++i)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&Output[OutOffset + (i * 16)]), _mm_shuffle_epi8(ctr, SWPMSK));
+			ctr = _mm_add_epi64(ctr, CTRINC);
+			// a low word that wrapped to zero carries into the high word
+			ctr = _mm_sub_epi64(ctr, _mm_slli_si128(_mm_cmpeq_epi64(ctr, ZERO), 8));
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&Counter[0]), _mm_shuffle_epi8(ctr, SWPMSK));
+#else
+		for (size_t i = 0; i < BlockCount; ++i)
+		{
+			MemUtils::COPY128(Counter, 0, Output, OutOffset + (i * 16));
+			BeIncrement8(Counter);
+		}
+#endif
+	}
+
 	//~~~Little Endian~~~//
 
 	/// <summary>
@@ -1224,6 +1264,45 @@ public:
 		}
 	}
 
+	/// <summary>
+	/// Writes a run of consecutive 128bit Little Endian counter blocks to an output array, and advances the counter by the number of blocks written.
+	/// <para>The counter is held in a SIMD register; each block is produced with a vector add, and the carry is propagated from the low to the high 64bit word.
+	/// Used by the counter modes to stagger counters ahead of the wide Transform functions.</para>
+	/// </summary>
+	/// 
+	/// <param name="Counter">The counter array of two 64bit integers, low word first; advanced by BlockCount</param>
+	/// <param name="Output">The destination byte array</param>
+	/// <param name="OutOffset">The starting offset within the destination array</param>
+	/// <param name="BlockCount">The number of 16 byte counter blocks to write</param>
+	template<typename ArrayA, typename ArrayB>
+	inline static void LeIncrementBlocksW(ArrayA &Counter, ArrayB &Output, size_t OutOffset, size_t BlockCount)
+	{
+		CexAssert(sizeof(ArrayA::value_type) == sizeof(ulong), "Counter must be an array of 64bit integers");
+		CexAssert(Output.size() - OutOffset >= BlockCount * 16, "The output array is too small");
+
+#if defined(__AVX__)
+		const __m128i CTRINC = _mm_set_epi64x(0, 1);
+		const __m128i ZERO = _mm_setzero_si128();
+		__m128i ctr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Counter[0]));
+
+		for (size_t i = 0; i < BlockCount; ++i)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&Output[OutOffset + (i * 16)]), ctr);
+			ctr = _mm_add_epi64(ctr, CTRINC);
+			// a low word that wrapped to zero carries into the high word
+			ctr = _mm_sub_epi64(ctr, _mm_slli_si128(_mm_cmpeq_epi64(ctr, ZERO), 8));
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&Counter[0]), ctr);
+#else
+		for (size_t i = 0; i < BlockCount; ++i)
+		{
+			MemUtils::COPY128(Counter, 0, Output, OutOffset + (i * 16));
+			LeIncrementW(Counter);
+		}
+#endif
+	}
+
 	/// <summary>
 	/// Treats an integer array as a large Little Endian integer, incrementing the total value by a defined length.
 	/// <para>Uses only unsigned integer types; signed types are UB.</para>
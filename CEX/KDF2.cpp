@@ -1,6 +1,7 @@
 #include "KDF2.h"
 #include "DigestFromName.h"
 #include "IntUtils.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_KDF
 
@@ -135,20 +136,22 @@ size_t KDF2::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length
 
 void KDF2::Initialize(ISymmetricKey &GenParam)
 {
-	if (GenParam.Nonce().size() != 0)
+	Key::Symmetric::SymmetricKeyView kv(GenParam);
+
+	if (kv.Nonce().size() != 0)
 	{
-		if (GenParam.Info().size() != 0)
+		if (kv.Info().size() != 0)
 		{
-			Initialize(GenParam.Key(), GenParam.Nonce(), GenParam.Info());
+			Initialize(kv.Key(), kv.Nonce(), kv.Info());
 		}
 		else
 		{
-			Initialize(GenParam.Key(), GenParam.Nonce());
+			Initialize(kv.Key(), kv.Nonce());
 		}
 	}
 	else
 	{
-		Initialize(GenParam.Key());
+		Initialize(kv.Key());
 	}
 }
 
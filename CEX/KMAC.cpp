@@ -1,6 +1,8 @@
 #include "KMAC.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
 #include "Keccak.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_MAC
 
@@ -103,6 +105,8 @@ void KMAC::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
 
 size_t KMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Mac, CLASS_NAME, 0);
+
 	CexAssert(m_isInitialized, "The Mac is not initialized!");
 	CexAssert((Output.size() - OutOffset) >= m_macSize, "The Output buffer is too short!");
 
@@ -117,7 +121,7 @@ size_t KMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
 	}
 
 	outLen = Output.size() - OutOffset;
-	outBits = RightEncode(buf, 0, outLen * 8);
+	outBits = Digest::Keccak::RightEncode(buf, 0, outLen * 8);
 
 	for (i = 0; i < outBits; i++)
 	{
@@ -136,25 +140,27 @@ size_t KMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
 
 void KMAC::Initialize(ISymmetricKey &KeyParams)
 {
-	if (KeyParams.Key().size() == 0)
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (kv.Key().size() == 0)
 	{
 		throw CryptoMacException("KMAC:Initialize", "Key size is too small; should be a minimum of digest output size!");
 	}
 
-	size_t keyLen = KeyParams.Key().size();
+	size_t keyLen = kv.Key().size();
 
 	if (m_isInitialized)
 	{
 		Reset();
 	}
 
-	if (KeyParams.Info().size() > 0)
+	if (kv.Info().size() > 0)
 	{
-		m_distributionCode = KeyParams.Info();
+		m_distributionCode = kv.Info();
 	}
 
-	Customize(KeyParams.Nonce(), m_distributionCode);
-	LoadKey(KeyParams.Key());
+	Customize(kv.Nonce(), m_distributionCode);
+	LoadKey(kv.Key());
 
 	m_isInitialized = true;
 }
@@ -176,6 +182,8 @@ void KMAC::Update(byte Input)
 
 void KMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Mac, CLASS_NAME, Length);
+
 	CexAssert(m_isInitialized, "The Mac is not initialized!");
 	CexAssert((InOffset + Length) <= Input.size(), "The Input buffer is too short!");
 
@@ -221,108 +229,23 @@ void KMAC::Customize(const std::vector<byte> &Customization, const std::vector<b
 	CexAssert(!m_isInitialized, "the domain string must be set before initialization");
 	CexAssert(Customization.size() + Name.size() <= 196, "the input buffer is too large");
 
-	std::array<byte, BUFFER_SIZE> pad;
-	size_t i;
-	size_t offset;
-
-	offset = 0;
-	offset = LeftEncode(pad, 0, m_blockSize);
-	offset += LeftEncode(pad, offset, Name.size() * 8);
-
-	if (Name.size() != 0)
-	{
-		for (i = 0; i < Name.size(); i++)
-		{
-			if (offset == m_blockSize)
-			{
-				for (size_t i = 0; i < BUFFER_SIZE; i += 8)
-				{
-					m_kdfState[i / 8] = IntUtils::LeBytesTo64(pad, i);
-				}
-
-				Permute(m_kdfState);
-				offset = 0;
-			}
-
-			pad[offset] = Name[i];
-			++offset;
-		}
-	}
-
-	offset += LeftEncode(pad, offset, Customization.size() * 8);
+	std::vector<byte> pad(0);
 
-	if (Customization.size() != 0)
-	{
-		for (i = 0; i < Customization.size(); i++)
-		{
-			if (offset == m_blockSize)
-			{
-				for (size_t i = 0; i < BUFFER_SIZE; i += 8)
-				{
-					m_kdfState[i / 8] = IntUtils::LeBytesTo64(pad, i);
-				}
-
-				Permute(m_kdfState);
-				offset = 0;
-			}
-
-			pad[offset] = Customization[i];
-			++offset;
-		}
-	}
-
-	MemUtils::Clear(pad, offset, BUFFER_SIZE - offset);
-	offset = (offset % sizeof(ulong) == 0) ? offset : offset + (sizeof(ulong) - (offset % sizeof(ulong)));
-
-	for (size_t i = 0; i < offset; i += 8)
-	{
-		m_kdfState[i / 8] = IntUtils::LeBytesTo64(pad, i);
-	}
-
-	Permute(m_kdfState);
+	Digest::Keccak::EncodeString(Name, pad);
+	Digest::Keccak::EncodeString(Customization, pad);
+	Digest::Keccak::BytePad(pad, m_blockSize, m_kdfState, m_shakeMode == ShakeModes::SHAKE1024);
+	MemUtils::Clear(pad, 0, pad.size());
 }
 
 void KMAC::LoadKey(const std::vector<byte> &Key)
 {
 	CexAssert(!m_isInitialized, "the domain string must be set before initialization");
 
-	std::array<byte, BUFFER_SIZE> pad;
-	size_t i;
-	size_t offset;
-
-	offset = 0;
-	offset = LeftEncode(pad, 0, m_blockSize);
-	offset += LeftEncode(pad, offset, Key.size() * 8);
-
-	if (Key.size() != 0)
-	{
-		for (i = 0; i < Key.size(); i++)
-		{
-			if (offset == m_blockSize)
-			{
-				for (size_t i = 0; i < BUFFER_SIZE; i += 8)
-				{
-					m_kdfState[i / 8] = IntUtils::LeBytesTo64(pad, i);
-				}
-
-				Permute(m_kdfState);
-				offset = 0;
-			}
-
-			pad[offset] = Key[i];
-			++offset;
-		}
-	}
-
-	MemUtils::Clear(pad, offset, BUFFER_SIZE - offset);
-	offset = (offset % sizeof(ulong) == 0) ? offset : offset + (sizeof(ulong) - (offset % sizeof(ulong)));
-
-	for (size_t i = 0; i < offset; i += 8)
-	{
-		m_kdfState[i / 8] ^= IntUtils::LeBytesTo64(pad, i);
-	}
+	std::vector<byte> pad(0);
 
-	Permute(m_kdfState);
+	Digest::Keccak::EncodeString(Key, pad);
+	Digest::Keccak::BytePad(pad, m_blockSize, m_kdfState, m_shakeMode == ShakeModes::SHAKE1024);
+	MemUtils::Clear(pad, 0, pad.size());
 }
 
 void KMAC::Permute(std::array<ulong, 25> &State)
@@ -237,54 +237,6 @@ private:
 		}
 	}
 
-	template<typename Array>
-	static size_t LeftEncode(Array &Buffer, size_t Offset, size_t Value)
-	{
-		size_t i;
-		size_t n;
-		size_t v;
-
-		for (v = Value, n = 0; v && (n < sizeof(size_t)); ++n, v >>= 8);
-
-		if (n == 0)
-		{
-			n = 1;
-		}
-
-		for (i = 1; i <= n; ++i)
-		{
-			Buffer[Offset + i] = (uint8_t)(Value >> (8 * (n - i)));
-		}
-
-		Buffer[Offset] = (uint8_t)n;
-
-		return (n + 1);
-	}
-
-	template<typename Array>
-	size_t RightEncode(Array &Buffer, size_t Offset, size_t Value)
-	{
-		size_t i;
-		size_t n;
-		size_t v;
-
-		for (v = Value, n = 0; v && (n < sizeof(size_t)); ++n, v >>= 8);
-
-		if (n == 0)
-		{
-			n = 1;
-		}
-
-		for (i = 1; i <= n; ++i)
-		{
-			Buffer[Offset + (i - 1)] = (uint8_t)(Value >> (8 * (n - i)));
-		}
-
-		Buffer[Offset + n] = (uint8_t)n;
-
-		return n + 1;
-	}
-
 	void Customize(const std::vector<byte> &Customization, const std::vector<byte> &Name);
 	void LoadKey(const std::vector<byte> &Key);
 	void Permute(std::array<ulong, 25> &State);
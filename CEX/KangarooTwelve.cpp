@@ -0,0 +1,451 @@
+#include "KangarooTwelve.h"
+#include "Instrumentation.h"
+#include "IntUtils.h"
+#include "Keccak.h"
+#include "MemUtils.h"
+#include "ParallelUtils.h"
+
+NAMESPACE_DIGEST
+
+using Utility::IntUtils;
+using Utility::MemUtils;
+
+const std::string KangarooTwelve::CLASS_NAME("KangarooTwelve");
+
+//~~~Constructor~~~//
+
+KangarooTwelve::KangarooTwelve(bool Parallel)
+	:
+	m_custom(0),
+	m_finalState(),
+	m_isDestroyed(false),
+	m_isTree(false),
+	m_leafCount(0),
+	m_leafLength(0),
+	m_leafState(),
+	m_parallelProfile(CHUNK_SIZE, false, STATE_PRECACHED, false, DEF_PRLDEGREE)
+{
+	// the tree is the same in either mode, parallel only enables threading of large inputs
+	m_parallelProfile.IsParallel() = Parallel && m_parallelProfile.ProcessorCount() > 1;
+}
+
+KangarooTwelve::~KangarooTwelve()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_finalState.Reset();
+		m_leafState.Reset();
+		IntUtils::ClearVector(m_custom);
+		m_isTree = false;
+		m_leafCount = 0;
+		m_leafLength = 0;
+		m_parallelProfile.Reset();
+	}
+}
+
+//~~~Accessors~~~//
+
+size_t KangarooTwelve::BlockSize()
+{
+	return BLOCK_SIZE;
+}
+
+size_t KangarooTwelve::DigestSize()
+{
+	return DIGEST_SIZE;
+}
+
+const Digests KangarooTwelve::Enumeral()
+{
+	return Digests::KangarooTwelve;
+}
+
+const bool KangarooTwelve::IsParallel()
+{
+	return m_parallelProfile.IsParallel();
+}
+
+const std::string KangarooTwelve::Name()
+{
+	std::string txtName = "";
+
+	if (m_parallelProfile.IsParallel())
+	{
+		txtName = CLASS_NAME + "-P" + IntUtils::ToString(m_parallelProfile.ParallelMaxDegree());
+	}
+	else
+	{
+		txtName = CLASS_NAME;
+	}
+
+	return txtName;
+}
+
+const size_t KangarooTwelve::ParallelBlockSize()
+{
+	return m_parallelProfile.ParallelBlockSize();
+}
+
+ParallelOptions &KangarooTwelve::ParallelProfile()
+{
+	return m_parallelProfile;
+}
+
+//~~~Public Functions~~~//
+
+void KangarooTwelve::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	Update(Input, 0, Input.size());
+	Finalize(Output, 0);
+}
+
+size_t KangarooTwelve::Finalize(std::vector<byte> &Output, const size_t OutOffset)
+{
+	return Finalize(Output, OutOffset, DIGEST_SIZE);
+}
+
+size_t KangarooTwelve::Finalize(std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+{
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, 0);
+
+	if (Output.size() - OutOffset < Length)
+	{
+		throw CryptoDigestException("KangarooTwelve:Finalize", "The Output buffer is too short!");
+	}
+
+	// the customization string and its encoded length are the end of the message
+	std::vector<byte> sfx = LengthEncode(m_custom.size());
+	sfx.insert(sfx.begin(), m_custom.begin(), m_custom.end());
+	Update(sfx, 0, sfx.size());
+
+	if (!m_isTree)
+	{
+		// the message fits in the first chunk, the final node is the whole tree
+		AbsorbPad(SINGLE_DOMAIN, m_finalState);
+	}
+	else
+	{
+		if (m_leafLength != 0)
+		{
+			FinishLeaf();
+		}
+
+		std::vector<byte> enc = LengthEncode(m_leafCount);
+		enc.push_back(0xFF);
+		enc.push_back(0xFF);
+		Absorb(enc, 0, enc.size(), m_finalState);
+		AbsorbPad(TREE_DOMAIN, m_finalState);
+	}
+
+	Squeeze(m_finalState, Output, OutOffset, Length);
+	Reset();
+
+	return Length;
+}
+
+void KangarooTwelve::Initialize(const std::vector<byte> &Customization)
+{
+	m_custom = Customization;
+	Reset();
+}
+
+void KangarooTwelve::ParallelMaxDegree(size_t Degree)
+{
+	CexAssert(Degree != 0, "parallel degree can not be zero");
+	CexAssert(Degree % 2 == 0, "parallel degree must be an even number");
+	CexAssert(Degree <= m_parallelProfile.ProcessorCount(), "parallel degree can not exceed processor count");
+
+	m_parallelProfile.SetMaxDegree(Degree);
+}
+
+void KangarooTwelve::Reset()
+{
+	m_finalState.Reset();
+	m_leafState.Reset();
+	m_isTree = false;
+	m_leafCount = 0;
+	m_leafLength = 0;
+}
+
+void KangarooTwelve::Update(byte Input)
+{
+	std::vector<byte> inp(1, Input);
+	Update(inp, 0, 1);
+}
+
+void KangarooTwelve::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, Length);
+
+	CexAssert(Input.size() - InOffset >= Length, "The Output buffer is too short!");
+
+	while (Length != 0)
+	{
+		if (!m_isTree)
+		{
+			if (m_leafLength == CHUNK_SIZE)
+			{
+				// the first chunk is full and more input follows, so the message is a tree
+				const std::vector<byte> CHNMRK = { 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+				Absorb(CHNMRK, 0, CHNMRK.size(), m_finalState);
+				m_isTree = true;
+				m_leafLength = 0;
+			}
+			else
+			{
+				const size_t RMDSZE = IntUtils::Min(CHUNK_SIZE - m_leafLength, Length);
+				Absorb(Input, InOffset, RMDSZE, m_finalState);
+				m_leafLength += RMDSZE;
+				InOffset += RMDSZE;
+				Length -= RMDSZE;
+			}
+		}
+		else if (m_leafLength == 0 && Length >= CHUNK_SIZE)
+		{
+			// whole chunks are hashed from the input, and their chaining values are absorbed in order
+			const size_t LEFCNT = Length / CHUNK_SIZE;
+			std::vector<byte> cvs(LEFCNT * DIGEST_SIZE);
+
+			HashLeaves(Input, InOffset, LEFCNT, cvs, 0);
+			Absorb(cvs, 0, cvs.size(), m_finalState);
+			m_leafCount += LEFCNT;
+			InOffset += LEFCNT * CHUNK_SIZE;
+			Length -= LEFCNT * CHUNK_SIZE;
+		}
+		else
+		{
+			const size_t RMDSZE = IntUtils::Min(CHUNK_SIZE - m_leafLength, Length);
+			Absorb(Input, InOffset, RMDSZE, m_leafState);
+			m_leafLength += RMDSZE;
+			InOffset += RMDSZE;
+			Length -= RMDSZE;
+
+			if (m_leafLength == CHUNK_SIZE)
+			{
+				FinishLeaf();
+			}
+		}
+	}
+}
+
+//~~~Private Functions~~~//
+
+void KangarooTwelve::Absorb(const std::vector<byte> &Input, size_t InOffset, size_t Length, TurboState &State)
+{
+	while (Length != 0)
+	{
+		if (State.Position == 0 && Length >= BLOCK_SIZE)
+		{
+			// whole blocks are added a lane at a time
+			for (size_t i = 0; i < BLOCK_SIZE / sizeof(ulong); ++i)
+			{
+				State.H[i] ^= IntUtils::LeBytesTo64(Input, InOffset + (i * sizeof(ulong)));
+			}
+
+			Keccak::PermuteR12P1600(State.H);
+			InOffset += BLOCK_SIZE;
+			Length -= BLOCK_SIZE;
+		}
+		else
+		{
+			const size_t RMDSZE = IntUtils::Min(BLOCK_SIZE - State.Position, Length);
+
+			for (size_t i = 0; i < RMDSZE; ++i)
+			{
+				const size_t STAPOS = State.Position + i;
+				State.H[STAPOS / sizeof(ulong)] ^= static_cast<ulong>(Input[InOffset + i]) << (8 * (STAPOS % sizeof(ulong)));
+			}
+
+			State.Position += RMDSZE;
+			InOffset += RMDSZE;
+			Length -= RMDSZE;
+
+			if (State.Position == BLOCK_SIZE)
+			{
+				Keccak::PermuteR12P1600(State.H);
+				State.Position = 0;
+			}
+		}
+	}
+}
+
+void KangarooTwelve::AbsorbPad(byte Domain, TurboState &State)
+{
+	State.H[State.Position / sizeof(ulong)] ^= static_cast<ulong>(Domain) << (8 * (State.Position % sizeof(ulong)));
+	State.H[(BLOCK_SIZE / sizeof(ulong)) - 1] ^= 0x8000000000000000ULL;
+	Keccak::PermuteR12P1600(State.H);
+	State.Position = 0;
+}
+
+void KangarooTwelve::FinishLeaf()
+{
+	std::vector<byte> cv(DIGEST_SIZE);
+
+	AbsorbPad(CHAIN_DOMAIN, m_leafState);
+	Squeeze(m_leafState, cv, 0, DIGEST_SIZE);
+	Absorb(cv, 0, cv.size(), m_finalState);
+	m_leafState.Reset();
+	m_leafLength = 0;
+	++m_leafCount;
+}
+
+void KangarooTwelve::HashLeaves(const std::vector<byte> &Input, size_t InOffset, size_t LeafCount, std::vector<byte> &Output, size_t OutOffset)
+{
+	const size_t PRLDGR = m_parallelProfile.ParallelMaxDegree();
+
+	if (m_parallelProfile.IsParallel() && LeafCount * CHUNK_SIZE >= m_parallelProfile.ParallelMinimumSize() && LeafCount >= PRLDGR)
+	{
+		CEX_INSTRUMENT_PARALLEL();
+
+		// each thread hashes a contiguous range of chunks
+		const size_t LEFCNT = LeafCount / PRLDGR;
+
+		Utility::ParallelUtils::ParallelFor(0, PRLDGR, [&Input, InOffset, LeafCount, &Output, OutOffset, LEFCNT, PRLDGR](size_t i)
+		{
+			const size_t THDCNT = (i == PRLDGR - 1) ? LeafCount - (i * LEFCNT) : LEFCNT;
+			HashMany(Input, InOffset + (i * LEFCNT * CHUNK_SIZE), THDCNT, Output, OutOffset + (i * LEFCNT * DIGEST_SIZE));
+		});
+	}
+	else
+	{
+		HashMany(Input, InOffset, LeafCount, Output, OutOffset);
+	}
+}
+
+void KangarooTwelve::HashMany(const std::vector<byte> &Input, size_t InOffset, size_t LeafCount, std::vector<byte> &Output, size_t OutOffset)
+{
+	const size_t BLKCNT = CHUNK_SIZE / BLOCK_SIZE;
+	const size_t FNLSZE = CHUNK_SIZE - (BLKCNT * BLOCK_SIZE);
+
+#if defined(__AVX2__)
+#	if defined(__AVX512__)
+	const size_t LNECNT = 8;
+#	else
+	const size_t LNECNT = 4;
+#	endif
+
+	if (LeafCount >= LNECNT)
+	{
+		std::vector<std::array<ulong, STATE_SIZE>> wst(LNECNT);
+
+		// each lane of the wide permutation absorbs one chunk
+		while (LeafCount >= LNECNT)
+		{
+			for (size_t i = 0; i < LNECNT; ++i)
+			{
+				std::memset(&wst[i][0], 0, STATE_SIZE * sizeof(ulong));
+			}
+
+			for (size_t i = 0; i < BLKCNT; ++i)
+			{
+				for (size_t j = 0; j < LNECNT; ++j)
+				{
+					const size_t BLKOFT = InOffset + (j * CHUNK_SIZE) + (i * BLOCK_SIZE);
+
+					for (size_t k = 0; k < BLOCK_SIZE / sizeof(ulong); ++k)
+					{
+						wst[j][k] ^= IntUtils::LeBytesTo64(Input, BLKOFT + (k * sizeof(ulong)));
+					}
+				}
+
+				PermuteW(wst);
+			}
+
+			// the last partial block of each chunk, and the chaining value padding
+			for (size_t j = 0; j < LNECNT; ++j)
+			{
+				const size_t BLKOFT = InOffset + (j * CHUNK_SIZE) + (BLKCNT * BLOCK_SIZE);
+
+				for (size_t k = 0; k < FNLSZE / sizeof(ulong); ++k)
+				{
+					wst[j][k] ^= IntUtils::LeBytesTo64(Input, BLKOFT + (k * sizeof(ulong)));
+				}
+
+				wst[j][FNLSZE / sizeof(ulong)] ^= static_cast<ulong>(CHAIN_DOMAIN);
+				wst[j][(BLOCK_SIZE / sizeof(ulong)) - 1] ^= 0x8000000000000000ULL;
+			}
+
+			PermuteW(wst);
+
+			for (size_t j = 0; j < LNECNT; ++j)
+			{
+				for (size_t k = 0; k < DIGEST_SIZE / sizeof(ulong); ++k)
+				{
+					IntUtils::Le64ToBytes(wst[j][k], Output, OutOffset + (j * DIGEST_SIZE) + (k * sizeof(ulong)));
+				}
+			}
+
+			InOffset += LNECNT * CHUNK_SIZE;
+			OutOffset += LNECNT * DIGEST_SIZE;
+			LeafCount -= LNECNT;
+		}
+	}
+#endif
+
+	TurboState state;
+
+	while (LeafCount != 0)
+	{
+		state.Reset();
+		Absorb(Input, InOffset, CHUNK_SIZE, state);
+		AbsorbPad(CHAIN_DOMAIN, state);
+		Squeeze(state, Output, OutOffset, DIGEST_SIZE);
+		InOffset += CHUNK_SIZE;
+		OutOffset += DIGEST_SIZE;
+		--LeafCount;
+	}
+}
+
+std::vector<byte> KangarooTwelve::LengthEncode(ulong Value)
+{
+	// big endian with no leading zeros, followed by the byte count
+	std::vector<byte> enc;
+
+	while (Value != 0)
+	{
+		enc.insert(enc.begin(), static_cast<byte>(Value));
+		Value >>= 8;
+	}
+
+	enc.push_back(static_cast<byte>(enc.size()));
+
+	return enc;
+}
+
+#if defined(__AVX2__)
+void KangarooTwelve::PermuteW(std::vector<std::array<ulong, STATE_SIZE>> &State)
+{
+#	if defined(__AVX512__)
+	Keccak::PermuteR12P12800(State);
+#	else
+	Keccak::PermuteR12P6400(State);
+#	endif
+}
+#endif
+
+void KangarooTwelve::Squeeze(TurboState &State, std::vector<byte> &Output, size_t OutOffset, size_t Length)
+{
+	while (Length != 0)
+	{
+		if (State.Position == BLOCK_SIZE)
+		{
+			Keccak::PermuteR12P1600(State.H);
+			State.Position = 0;
+		}
+
+		const size_t RMDSZE = IntUtils::Min(BLOCK_SIZE - State.Position, Length);
+
+		for (size_t i = 0; i < RMDSZE; ++i)
+		{
+			const size_t STAPOS = State.Position + i;
+			Output[OutOffset + i] = static_cast<byte>(State.H[STAPOS / sizeof(ulong)] >> (8 * (STAPOS % sizeof(ulong))));
+		}
+
+		State.Position += RMDSZE;
+		OutOffset += RMDSZE;
+		Length -= RMDSZE;
+	}
+}
+
+NAMESPACE_DIGESTEND
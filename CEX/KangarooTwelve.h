@@ -0,0 +1,288 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Principal Algorithms:
+// An implementation of KangarooTwelve, designed by Guido Bertoni, Joan Daemen, Michael Peeters, Gilles Van Assche, Ronny Van Keer, and Benoit Viguier.
+// KangarooTwelve <a href="https://keccak.team/files/KangarooTwelve.pdf">KangarooTwelve: fast hashing based on Keccak-p</a>.
+//
+// Implementation Details:
+// An implementation of the KangarooTwelve (KT128) digest with a 256 bit default output size, and an extendable output function.
+// Based on RFC 9861 and the eXtended Keccak Code Package (XKCP).
+// RFC 9861: https://www.rfc-editor.org/rfc/rfc9861
+//
+// Contact: develop@vtdev.com
+
+#ifndef CEX_KANGAROOTWELVE_H
+#define CEX_KANGAROOTWELVE_H
+
+#include "IDigest.h"
+
+NAMESPACE_DIGEST
+
+/// <summary>
+/// An implementation of the KangarooTwelve (KT128) digest with a 256 bit default output size, and an extendable output function
+/// </summary>
+///
+/// <example>
+/// <description>Example using the Compute method:</description>
+/// <code>
+/// KangarooTwelve dgt;
+/// std:vector&lt;byte&gt; hash(dgt.DigestSize(), 0);
+/// // compute a hash
+/// dgt.Compute(input, hash);
+/// </code>
+/// </example>
+///
+/// <example>
+/// <description>Example of a customized hash with an extended output:</description>
+/// <code>
+/// KangarooTwelve dgt;
+/// std:vector&lt;byte&gt; code(128, 0);
+/// dgt.Initialize(custom);
+/// dgt.Update(input, 0, input.size());
+/// dgt.Finalize(code, 0, code.size());
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The sponge function is TurboSHAKE128; the Keccak-p[1600] permutation reduced to 12 rounds, with a 168 byte rate.</description></item>
+/// <item><description>The message is split into 8192 byte chunks; the first chunk is absorbed by the final node, and each following chunk is hashed to a 32 byte chaining value that is absorbed by the final node.</description></item>
+/// <item><description>A message (with its customization string) of 8192 bytes or less is a single TurboSHAKE128 call, so short messages do not pay for the tree.</description></item>
+/// <item><description>Whole chunks are hashed 4 or 8 at a time in the lanes of the ULong256 or ULong512 wrappers, depending on the instruction set the library is compiled with.</description></item>
+/// <item><description>In parallel mode, an input passed to the Update function that is at least ParallelMinimumSize() bytes is split across ParallelMaxDegree() threads.</description></item>
+/// <item><description>Unlike the Keccak tree modes, the output does not depend on the parallel settings; sequential and parallel instances produce the same digest.</description></item>
+/// <item><description>Digest output size is 32 bytes, (256 bits); the Finalize(std::vector&lt;byte&gt;, size_t, size_t) overload returns an output of any length.</description></item>
+/// <item><description>The Finalize methods reset the message state, but keep the customization string set by Initialize.</description></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>KangarooTwelve <a href="https://keccak.team/files/KangarooTwelve.pdf">KangarooTwelve: fast hashing based on Keccak-p</a>.</description></item>
+/// <item><description>RFC 9861 <a href="https://www.rfc-editor.org/rfc/rfc9861">KangarooTwelve and TurboSHAKE</a>.</description></item>
+/// <item><description>The eXtended Keccak Code Package on <a href="https://github.com/XKCP/XKCP">Github</a>.</description></item>
+/// </list>
+/// </remarks>
+class KangarooTwelve final : public IDigest
+{
+private:
+
+	static const size_t BLOCK_SIZE = 168;
+	static const size_t CHUNK_SIZE = 8192;
+	static const std::string CLASS_NAME;
+	static const size_t DEF_PRLDEGREE = 8;
+	static const size_t DIGEST_SIZE = 32;
+	// size of reserved state buffer subtracted from parallel size calculations
+	static const size_t STATE_PRECACHED = 2048;
+	static const size_t STATE_SIZE = 25;
+
+	static const byte CHAIN_DOMAIN = 0x0B;
+	static const byte SINGLE_DOMAIN = 0x07;
+	static const byte TREE_DOMAIN = 0x06;
+
+	struct TurboState
+	{
+		std::array<ulong, STATE_SIZE> H;
+		size_t Position;
+
+		TurboState()
+			:
+			Position(0)
+		{
+			Reset();
+		}
+
+		void Reset()
+		{
+			std::memset(&H[0], 0, H.size() * sizeof(ulong));
+			Position = 0;
+		}
+	};
+
+	std::vector<byte> m_custom;
+	TurboState m_finalState;
+	bool m_isDestroyed;
+	bool m_isTree;
+	ulong m_leafCount;
+	size_t m_leafLength;
+	TurboState m_leafState;
+	ParallelOptions m_parallelProfile;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	KangarooTwelve(const KangarooTwelve&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	KangarooTwelve& operator=(const KangarooTwelve&) = delete;
+
+	/// <summary>
+	/// Initialize the digest
+	/// </summary>
+	///
+	/// <param name="Parallel">Setting the Parallel flag to true, enables multi-threaded chunk hashing; the digest output is the same in either mode.</param>
+	explicit KangarooTwelve(bool Parallel = false);
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~KangarooTwelve() override;
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The Digests internal blocksize in bytes
+	/// </summary>
+	size_t BlockSize() override;
+
+	/// <summary>
+	/// Read Only: Size of returned digest in bytes
+	/// </summary>
+	size_t DigestSize() override;
+
+	/// <summary>
+	/// Read Only: The digests type name
+	/// </summary>
+	const Digests Enumeral() override;
+
+	/// <summary>
+	/// Read Only: Processor parallelization availability.
+	/// <para>Indicates whether parallel processing is available on this system.
+	/// If parallel capable, input data array passed to the Update function must be ParallelMinimumSize in bytes to trigger parallelization.</para>
+	/// </summary>
+	const bool IsParallel() override;
+
+	/// <summary>
+	/// Read Only: The digests class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Read Only: Parallel block size; the byte-size of the input data array passed to the Update function that triggers parallel processing.
+	/// <para>This value can be changed through the ParallelProfile class.</para>
+	/// </summary>
+	const size_t ParallelBlockSize() override;
+
+	/// <summary>
+	/// Read/Write: Contains parallel settings and SIMD capability flags in a ParallelOptions structure.
+	/// <para>The maximum number of threads allocated when using multi-threaded processing can be set with the ParallelMaxDegree(size_t) function.</para>
+	/// </summary>
+	ParallelOptions &ParallelProfile() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Process the message data and return the Hash value
+	/// </summary>
+	///
+	/// <param name="Input">The message input data</param>
+	/// <param name="Output">The hash value output array</param>
+	void Compute(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Perform final processing and return the 32 byte hash value
+	/// </summary>
+	///
+	/// <param name="Output">The Hash output value array</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	///
+	/// <returns>Size of Hash value</returns>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the output buffer is too short</exception>
+	size_t Finalize(std::vector<byte> &Output, const size_t OutOffset) override;
+
+	/// <summary>
+	/// Perform final processing and return an extended output of any length
+	/// </summary>
+	///
+	/// <param name="Output">The output array</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	/// <param name="Length">The number of bytes to write</param>
+	///
+	/// <returns>The number of bytes written</returns>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the output buffer is too short</exception>
+	size_t Finalize(std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
+
+	/// <summary>
+	/// Set the customization string, which is appended to every message.
+	/// <para>Different customization strings produce independent hash functions; an empty string restores the default function.</para>
+	/// </summary>
+	///
+	/// <param name="Customization">The customization string</param>
+	void Initialize(const std::vector<byte> &Customization);
+
+	/// <summary>
+	/// Set the number of threads allocated when using multi-threaded chunk hashing.
+	/// <para>Thread count must be an even number, and not exceed the number of processor cores.
+	/// The thread count does not change the digest output.</para>
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	void ParallelMaxDegree(size_t Degree) override;
+
+	/// <summary>
+	/// Reset the message state; the customization string is retained
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Update the message digest with a single byte
+	/// </summary>
+	///
+	/// <param name="Input">Input message byte</param>
+	void Update(byte Input) override;
+
+	/// <summary>
+	/// Update the message buffer
+	/// </summary>
+	///
+	/// <remarks>
+	/// <para>For best performance, use input lengths that are a multiple of the 8192 byte chunk size;
+	/// whole chunks are hashed in SIMD lanes directly from the input array.</para>
+	/// </remarks>
+	///
+	/// <param name="Input">The Input message data</param>
+	/// <param name="InOffset">The starting offset within the Input array</param>
+	/// <param name="Length">The amount of data to process in bytes</param>
+	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
+
+private:
+
+	static void Absorb(const std::vector<byte> &Input, size_t InOffset, size_t Length, TurboState &State);
+	static void AbsorbPad(byte Domain, TurboState &State);
+	void FinishLeaf();
+	void HashLeaves(const std::vector<byte> &Input, size_t InOffset, size_t LeafCount, std::vector<byte> &Output, size_t OutOffset);
+	static void HashMany(const std::vector<byte> &Input, size_t InOffset, size_t LeafCount, std::vector<byte> &Output, size_t OutOffset);
+	static std::vector<byte> LengthEncode(ulong Value);
+#if defined(__AVX2__)
+	static void PermuteW(std::vector<std::array<ulong, STATE_SIZE>> &State);
+#endif
+	static void Squeeze(TurboState &State, std::vector<byte> &Output, size_t OutOffset, size_t Length);
+};
+
+NAMESPACE_DIGESTEND
+#endif
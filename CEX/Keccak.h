@@ -43,7 +43,8 @@ using Utility::IntUtils;
 */
 
 /// <summary>
-/// Internal static class containing the 24 and 48 round Keccak permutation functions.
+/// Internal static class containing the 12, 24 and 48 round Keccak permutation functions.
+/// <para>The PermuteR12P1600 function is the 12 round Keccak-p[1600, 12] permutation used by TurboSHAKE and KangarooTwelve, it applies the last 12 rounds of the 24 round permutation.</para>
 /// <para>Note: The PermuteR48P1600 is an extended permutation function that uses 48 rounds, rather than the 24 rounds used by the SStateA3 implementation of Keccak.
 /// The additional 24 rounds constants were generated using the LFSR from the Keccak code package, with the additional 24 constants being
 /// the next in sequence generated by that LFSR.</para>
@@ -73,8 +74,123 @@ class Keccak
 
 public:
 
+	/// <summary>
+	/// Absorb bytepad(Input, Rate) from SP800-185; the left encoded rate, followed by the Input, zero padded to a multiple of the rate
+	/// </summary>
+	///
+	/// <param name="Input">The encoded strings, usually the output of one or more EncodeString calls</param>
+	/// <param name="Rate">The sponge rate in bytes</param>
+	/// <param name="State">The Keccak state</param>
+	/// <param name="Extended">Use the 48 round permutation</param>
+	inline static void BytePad(const std::vector<byte> &Input, size_t Rate, std::array<ulong, 25> &State, bool Extended)
+	{
+		std::vector<byte> pad(sizeof(ulong) + 1);
+
+		pad.resize(LeftEncode(pad, 0, Rate));
+		pad.insert(pad.end(), Input.begin(), Input.end());
+		pad.resize(((pad.size() + Rate - 1) / Rate) * Rate, 0);
+
+		for (size_t i = 0; i < pad.size(); i += Rate)
+		{
+			for (size_t j = 0; j < Rate / sizeof(ulong); ++j)
+			{
+				State[j] ^= IntUtils::LeBytesTo64(pad, i + (j * sizeof(ulong)));
+			}
+
+			if (Extended)
+			{
+				PermuteR48P1600(State);
+			}
+			else
+			{
+				PermuteR24P1600(State);
+			}
+		}
+	}
+
+	/// <summary>
+	/// Append encode_string(Input) from SP800-185; the left encoded bit length of the Input, followed by the Input
+	/// </summary>
+	///
+	/// <param name="Input">The string to encode</param>
+	/// <param name="Output">The array receiving the encoded string</param>
+	inline static void EncodeString(const std::vector<byte> &Input, std::vector<byte> &Output)
+	{
+		const size_t OTPOFT = Output.size();
+
+		Output.resize(OTPOFT + sizeof(ulong) + 1);
+		Output.resize(OTPOFT + LeftEncode(Output, OTPOFT, Input.size() * 8));
+		Output.insert(Output.end(), Input.begin(), Input.end());
+	}
+
+	/// <summary>
+	/// Write left_encode(Value) from SP800-185; the byte count of the value, followed by the big endian value bytes
+	/// </summary>
+	///
+	/// <param name="Buffer">The output array, must have at least 9 bytes available</param>
+	/// <param name="Offset">The starting offset within the output array</param>
+	/// <param name="Value">The value to encode</param>
+	///
+	/// <returns>The number of bytes written</returns>
 	template<typename Array>
-	inline static void PermuteR24P1600(Array &State)
+	inline static size_t LeftEncode(Array &Buffer, size_t Offset, ulong Value)
+	{
+		size_t i;
+		size_t n;
+		ulong v;
+
+		for (v = Value, n = 0; v && (n < sizeof(ulong)); ++n, v >>= 8);
+
+		if (n == 0)
+		{
+			n = 1;
+		}
+
+		for (i = 1; i <= n; ++i)
+		{
+			Buffer[Offset + i] = static_cast<byte>(Value >> (8 * (n - i)));
+		}
+
+		Buffer[Offset] = static_cast<byte>(n);
+
+		return (n + 1);
+	}
+
+	/// <summary>
+	/// Write right_encode(Value) from SP800-185; the big endian value bytes, followed by the byte count of the value
+	/// </summary>
+	///
+	/// <param name="Buffer">The output array, must have at least 9 bytes available</param>
+	/// <param name="Offset">The starting offset within the output array</param>
+	/// <param name="Value">The value to encode</param>
+	///
+	/// <returns>The number of bytes written</returns>
+	template<typename Array>
+	inline static size_t RightEncode(Array &Buffer, size_t Offset, ulong Value)
+	{
+		size_t i;
+		size_t n;
+		ulong v;
+
+		for (v = Value, n = 0; v && (n < sizeof(ulong)); ++n, v >>= 8);
+
+		if (n == 0)
+		{
+			n = 1;
+		}
+
+		for (i = 1; i <= n; ++i)
+		{
+			Buffer[Offset + (i - 1)] = static_cast<byte>(Value >> (8 * (n - i)));
+		}
+
+		Buffer[Offset + n] = static_cast<byte>(n);
+
+		return (n + 1);
+	}
+
+	template<typename Array>
+	inline static void PermuteR12P1600(Array &State)
 	{
 		uint64_t Aba = State[0];
 		uint64_t Abe = State[1];
@@ -124,7 +240,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		uint64_t Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x0000000000000001ULL;
+		Eba ^= 0x000000008000808BULL;
 		uint64_t Ebe = Ce ^ ((~Ci) & Co);
 		uint64_t Ebi = Ci ^ ((~Co) & Cu);
 		uint64_t Ebo = Co ^ ((~Cu) & Ca);
@@ -211,7 +327,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x0000000000008082ULL;
+		Aba ^= 0x800000000000008BULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -298,7 +414,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x800000000000808AULL;
+		Eba ^= 0x8000000000008089ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -385,7 +501,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000080008000ULL;
+		Aba ^= 0x8000000000008003ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -472,7 +588,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x000000000000808BULL;
+		Eba ^= 0x8000000000008002ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -559,7 +675,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x0000000080000001ULL;
+		Aba ^= 0x8000000000000080ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -646,7 +762,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000080008081ULL;
+		Eba ^= 0x000000000000800AULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -733,7 +849,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000000008009ULL;
+		Aba ^= 0x800000008000000AULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -820,7 +936,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x000000000000008AULL;
+		Eba ^= 0x8000000080008081ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -907,7 +1023,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x0000000000000088ULL;
+		Aba ^= 0x8000000000008080ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -994,7 +1110,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x0000000080008009ULL;
+		Eba ^= 0x0000000080000001ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -1081,7 +1197,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x000000008000000AULL;
+		Aba ^= 0x8000000080008008ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -1146,17 +1262,74 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 13
-		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
-		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
-		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
-		Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
-		Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-		Da = Cu ^ IntUtils::RotFL64(Ce, 1);
-		De = Ca ^ IntUtils::RotFL64(Ci, 1);
-		Di = Ce ^ IntUtils::RotFL64(Co, 1);
-		Do = Ci ^ IntUtils::RotFL64(Cu, 1);
-		Du = Co ^ IntUtils::RotFL64(Ca, 1);
+
+		State[0] = Aba;
+		State[1] = Abe;
+		State[2] = Abi;
+		State[3] = Abo;
+		State[4] = Abu;
+		State[5] = Aga;
+		State[6] = Age;
+		State[7] = Agi;
+		State[8] = Ago;
+		State[9] = Agu;
+		State[10] = Aka;
+		State[11] = Ake;
+		State[12] = Aki;
+		State[13] = Ako;
+		State[14] = Aku;
+		State[15] = Ama;
+		State[16] = Ame;
+		State[17] = Ami;
+		State[18] = Amo;
+		State[19] = Amu;
+		State[20] = Asa;
+		State[21] = Ase;
+		State[22] = Asi;
+		State[23] = Aso;
+		State[24] = Asu;
+	}
+
+	template<typename Array>
+	inline static void PermuteR24P1600(Array &State)
+	{
+		uint64_t Aba = State[0];
+		uint64_t Abe = State[1];
+		uint64_t Abi = State[2];
+		uint64_t Abo = State[3];
+		uint64_t Abu = State[4];
+		uint64_t Aga = State[5];
+		uint64_t Age = State[6];
+		uint64_t Agi = State[7];
+		uint64_t Ago = State[8];
+		uint64_t Agu = State[9];
+		uint64_t Aka = State[10];
+		uint64_t Ake = State[11];
+		uint64_t Aki = State[12];
+		uint64_t Ako = State[13];
+		uint64_t Aku = State[14];
+		uint64_t Ama = State[15];
+		uint64_t Ame = State[16];
+		uint64_t Ami = State[17];
+		uint64_t Amo = State[18];
+		uint64_t Amu = State[19];
+		uint64_t Asa = State[20];
+		uint64_t Ase = State[21];
+		uint64_t Asi = State[22];
+		uint64_t Aso = State[23];
+		uint64_t Asu = State[24];
+
+		// round 1
+		uint64_t Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+		uint64_t Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+		uint64_t Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+		uint64_t Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+		uint64_t Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+		uint64_t Da = Cu ^ IntUtils::RotFL64(Ce, 1);
+		uint64_t De = Ca ^ IntUtils::RotFL64(Ci, 1);
+		uint64_t Di = Ce ^ IntUtils::RotFL64(Co, 1);
+		uint64_t Do = Ci ^ IntUtils::RotFL64(Cu, 1);
+		uint64_t Du = Co ^ IntUtils::RotFL64(Ca, 1);
 		Aba ^= Da;
 		Ca = Aba;
 		Age ^= De;
@@ -1167,12 +1340,12 @@ public:
 		Co = IntUtils::RotFL64(Amo, 21);
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
-		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x000000008000808BULL;
-		Ebe = Ce ^ ((~Ci) & Co);
-		Ebi = Ci ^ ((~Co) & Cu);
-		Ebo = Co ^ ((~Cu) & Ca);
-		Ebu = Cu ^ ((~Ca) & Ce);
+		uint64_t Eba = Ca ^ ((~Ce) & Ci);
+		Eba ^= 0x0000000000000001ULL;
+		uint64_t Ebe = Ce ^ ((~Ci) & Co);
+		uint64_t Ebi = Ci ^ ((~Co) & Cu);
+		uint64_t Ebo = Co ^ ((~Cu) & Ca);
+		uint64_t Ebu = Cu ^ ((~Ca) & Ce);
 		Abo ^= Do;
 		Ca = IntUtils::RotFL64(Abo, 28);
 		Agu ^= Du;
@@ -1183,11 +1356,11 @@ public:
 		Co = IntUtils::RotFL64(Ame, 45);
 		Asi ^= Di;
 		Cu = IntUtils::RotFL64(Asi, 61);
-		Ega = Ca ^ ((~Ce) & Ci);
-		Ege = Ce ^ ((~Ci) & Co);
-		Egi = Ci ^ ((~Co) & Cu);
-		Ego = Co ^ ((~Cu) & Ca);
-		Egu = Cu ^ ((~Ca) & Ce);
+		uint64_t Ega = Ca ^ ((~Ce) & Ci);
+		uint64_t Ege = Ce ^ ((~Ci) & Co);
+		uint64_t Egi = Ci ^ ((~Co) & Cu);
+		uint64_t Ego = Co ^ ((~Cu) & Ca);
+		uint64_t Egu = Cu ^ ((~Ca) & Ce);
 		Abe ^= De;
 		Ca = IntUtils::RotFL64(Abe, 1);
 		Agi ^= Di;
@@ -1198,11 +1371,11 @@ public:
 		Co = IntUtils::RotFL64(Amu, 8);
 		Asa ^= Da;
 		Cu = IntUtils::RotFL64(Asa, 18);
-		Eka = Ca ^ ((~Ce) & Ci);
-		Eke = Ce ^ ((~Ci) & Co);
-		Eki = Ci ^ ((~Co) & Cu);
-		Eko = Co ^ ((~Cu) & Ca);
-		Eku = Cu ^ ((~Ca) & Ce);
+		uint64_t Eka = Ca ^ ((~Ce) & Ci);
+		uint64_t Eke = Ce ^ ((~Ci) & Co);
+		uint64_t Eki = Ci ^ ((~Co) & Cu);
+		uint64_t Eko = Co ^ ((~Cu) & Ca);
+		uint64_t Eku = Cu ^ ((~Ca) & Ce);
 		Abu ^= Du;
 		Ca = IntUtils::RotFL64(Abu, 27);
 		Aga ^= Da;
@@ -1213,11 +1386,11 @@ public:
 		Co = IntUtils::RotFL64(Ami, 15);
 		Aso ^= Do;
 		Cu = IntUtils::RotFL64(Aso, 56);
-		Ema = Ca ^ ((~Ce) & Ci);
-		Eme = Ce ^ ((~Ci) & Co);
-		Emi = Ci ^ ((~Co) & Cu);
-		Emo = Co ^ ((~Cu) & Ca);
-		Emu = Cu ^ ((~Ca) & Ce);
+		uint64_t Ema = Ca ^ ((~Ce) & Ci);
+		uint64_t Eme = Ce ^ ((~Ci) & Co);
+		uint64_t Emi = Ci ^ ((~Co) & Cu);
+		uint64_t Emo = Co ^ ((~Cu) & Ca);
+		uint64_t Emu = Cu ^ ((~Ca) & Ce);
 		Abi ^= Di;
 		Ca = IntUtils::RotFL64(Abi, 62);
 		Ago ^= Do;
@@ -1228,12 +1401,12 @@ public:
 		Co = IntUtils::RotFL64(Ama, 41);
 		Ase ^= De;
 		Cu = IntUtils::RotFL64(Ase, 2);
-		Esa = Ca ^ ((~Ce) & Ci);
-		Ese = Ce ^ ((~Ci) & Co);
-		Esi = Ci ^ ((~Co) & Cu);
-		Eso = Co ^ ((~Cu) & Ca);
-		Esu = Cu ^ ((~Ca) & Ce);
-		// round 14
+		uint64_t Esa = Ca ^ ((~Ce) & Ci);
+		uint64_t Ese = Ce ^ ((~Ci) & Co);
+		uint64_t Esi = Ci ^ ((~Co) & Cu);
+		uint64_t Eso = Co ^ ((~Cu) & Ca);
+		uint64_t Esu = Cu ^ ((~Ca) & Ce);
+		// round 2
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -1255,7 +1428,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x800000000000008BULL;
+		Aba ^= 0x0000000000008082ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -1320,7 +1493,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 15
+		// round 3
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -1342,7 +1515,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000000008089ULL;
+		Eba ^= 0x800000000000808AULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -1407,7 +1580,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 16
+		// round 4
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -1429,7 +1602,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000000008003ULL;
+		Aba ^= 0x8000000080008000ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -1494,7 +1667,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 17
+		// round 5
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -1516,7 +1689,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000000008002ULL;
+		Eba ^= 0x000000000000808BULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -1581,7 +1754,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 18
+		// round 6
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -1603,7 +1776,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000000000080ULL;
+		Aba ^= 0x0000000080000001ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -1668,7 +1841,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 19
+		// round 7
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -1690,7 +1863,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x000000000000800AULL;
+		Eba ^= 0x8000000080008081ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -1755,7 +1928,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 20
+		// round 8
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -1777,7 +1950,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x800000008000000AULL;
+		Aba ^= 0x8000000000008009ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -1842,7 +2015,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 21
+		// round 9
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -1864,7 +2037,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000080008081ULL;
+		Eba ^= 0x000000000000008AULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -1929,7 +2102,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 22
+		// round 10
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -1951,7 +2124,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000000008080ULL;
+		Aba ^= 0x0000000000000088ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -2016,7 +2189,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 23
+		// round 11
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -2038,7 +2211,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x0000000080000001ULL;
+		Eba ^= 0x0000000080008009ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -2103,7 +2276,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 24
+		// round 12
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -2125,7 +2298,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000080008008ULL;
+		Aba ^= 0x000000008000000AULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -2190,74 +2363,17 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-
-		State[0] = Aba;
-		State[1] = Abe;
-		State[2] = Abi;
-		State[3] = Abo;
-		State[4] = Abu;
-		State[5] = Aga;
-		State[6] = Age;
-		State[7] = Agi;
-		State[8] = Ago;
-		State[9] = Agu;
-		State[10] = Aka;
-		State[11] = Ake;
-		State[12] = Aki;
-		State[13] = Ako;
-		State[14] = Aku;
-		State[15] = Ama;
-		State[16] = Ame;
-		State[17] = Ami;
-		State[18] = Amo;
-		State[19] = Amu;
-		State[20] = Asa;
-		State[21] = Ase;
-		State[22] = Asi;
-		State[23] = Aso;
-		State[24] = Asu;
-	}
-
-	template<typename Array>
-	inline static void PermuteR48P1600(Array &State)
-	{
-		uint64_t Aba = State[0];
-		uint64_t Abe = State[1];
-		uint64_t Abi = State[2];
-		uint64_t Abo = State[3];
-		uint64_t Abu = State[4];
-		uint64_t Aga = State[5];
-		uint64_t Age = State[6];
-		uint64_t Agi = State[7];
-		uint64_t Ago = State[8];
-		uint64_t Agu = State[9];
-		uint64_t Aka = State[10];
-		uint64_t Ake = State[11];
-		uint64_t Aki = State[12];
-		uint64_t Ako = State[13];
-		uint64_t Aku = State[14];
-		uint64_t Ama = State[15];
-		uint64_t Ame = State[16];
-		uint64_t Ami = State[17];
-		uint64_t Amo = State[18];
-		uint64_t Amu = State[19];
-		uint64_t Asa = State[20];
-		uint64_t Ase = State[21];
-		uint64_t Asi = State[22];
-		uint64_t Aso = State[23];
-		uint64_t Asu = State[24];
-
-		// round 1
-		uint64_t Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
-		uint64_t Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
-		uint64_t Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
-		uint64_t Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
-		uint64_t Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-		uint64_t Da = Cu ^ IntUtils::RotFL64(Ce, 1);
-		uint64_t De = Ca ^ IntUtils::RotFL64(Ci, 1);
-		uint64_t Di = Ce ^ IntUtils::RotFL64(Co, 1);
-		uint64_t Do = Ci ^ IntUtils::RotFL64(Cu, 1);
-		uint64_t Du = Co ^ IntUtils::RotFL64(Ca, 1);
+		// round 13
+		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+		Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+		Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+		Da = Cu ^ IntUtils::RotFL64(Ce, 1);
+		De = Ca ^ IntUtils::RotFL64(Ci, 1);
+		Di = Ce ^ IntUtils::RotFL64(Co, 1);
+		Do = Ci ^ IntUtils::RotFL64(Cu, 1);
+		Du = Co ^ IntUtils::RotFL64(Ca, 1);
 		Aba ^= Da;
 		Ca = Aba;
 		Age ^= De;
@@ -2268,12 +2384,12 @@ public:
 		Co = IntUtils::RotFL64(Amo, 21);
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
-		uint64_t Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x0000000000000001ULL;
-		uint64_t Ebe = Ce ^ ((~Ci) & Co);
-		uint64_t Ebi = Ci ^ ((~Co) & Cu);
-		uint64_t Ebo = Co ^ ((~Cu) & Ca);
-		uint64_t Ebu = Cu ^ ((~Ca) & Ce);
+		Eba = Ca ^ ((~Ce) & Ci);
+		Eba ^= 0x000000008000808BULL;
+		Ebe = Ce ^ ((~Ci) & Co);
+		Ebi = Ci ^ ((~Co) & Cu);
+		Ebo = Co ^ ((~Cu) & Ca);
+		Ebu = Cu ^ ((~Ca) & Ce);
 		Abo ^= Do;
 		Ca = IntUtils::RotFL64(Abo, 28);
 		Agu ^= Du;
@@ -2284,11 +2400,11 @@ public:
 		Co = IntUtils::RotFL64(Ame, 45);
 		Asi ^= Di;
 		Cu = IntUtils::RotFL64(Asi, 61);
-		uint64_t Ega = Ca ^ ((~Ce) & Ci);
-		uint64_t Ege = Ce ^ ((~Ci) & Co);
-		uint64_t Egi = Ci ^ ((~Co) & Cu);
-		uint64_t Ego = Co ^ ((~Cu) & Ca);
-		uint64_t Egu = Cu ^ ((~Ca) & Ce);
+		Ega = Ca ^ ((~Ce) & Ci);
+		Ege = Ce ^ ((~Ci) & Co);
+		Egi = Ci ^ ((~Co) & Cu);
+		Ego = Co ^ ((~Cu) & Ca);
+		Egu = Cu ^ ((~Ca) & Ce);
 		Abe ^= De;
 		Ca = IntUtils::RotFL64(Abe, 1);
 		Agi ^= Di;
@@ -2299,11 +2415,11 @@ public:
 		Co = IntUtils::RotFL64(Amu, 8);
 		Asa ^= Da;
 		Cu = IntUtils::RotFL64(Asa, 18);
-		uint64_t Eka = Ca ^ ((~Ce) & Ci);
-		uint64_t Eke = Ce ^ ((~Ci) & Co);
-		uint64_t Eki = Ci ^ ((~Co) & Cu);
-		uint64_t Eko = Co ^ ((~Cu) & Ca);
-		uint64_t Eku = Cu ^ ((~Ca) & Ce);
+		Eka = Ca ^ ((~Ce) & Ci);
+		Eke = Ce ^ ((~Ci) & Co);
+		Eki = Ci ^ ((~Co) & Cu);
+		Eko = Co ^ ((~Cu) & Ca);
+		Eku = Cu ^ ((~Ca) & Ce);
 		Abu ^= Du;
 		Ca = IntUtils::RotFL64(Abu, 27);
 		Aga ^= Da;
@@ -2314,11 +2430,11 @@ public:
 		Co = IntUtils::RotFL64(Ami, 15);
 		Aso ^= Do;
 		Cu = IntUtils::RotFL64(Aso, 56);
-		uint64_t Ema = Ca ^ ((~Ce) & Ci);
-		uint64_t Eme = Ce ^ ((~Ci) & Co);
-		uint64_t Emi = Ci ^ ((~Co) & Cu);
-		uint64_t Emo = Co ^ ((~Cu) & Ca);
-		uint64_t Emu = Cu ^ ((~Ca) & Ce);
+		Ema = Ca ^ ((~Ce) & Ci);
+		Eme = Ce ^ ((~Ci) & Co);
+		Emi = Ci ^ ((~Co) & Cu);
+		Emo = Co ^ ((~Cu) & Ca);
+		Emu = Cu ^ ((~Ca) & Ce);
 		Abi ^= Di;
 		Ca = IntUtils::RotFL64(Abi, 62);
 		Ago ^= Do;
@@ -2329,12 +2445,12 @@ public:
 		Co = IntUtils::RotFL64(Ama, 41);
 		Ase ^= De;
 		Cu = IntUtils::RotFL64(Ase, 2);
-		uint64_t Esa = Ca ^ ((~Ce) & Ci);
-		uint64_t Ese = Ce ^ ((~Ci) & Co);
-		uint64_t Esi = Ci ^ ((~Co) & Cu);
-		uint64_t Eso = Co ^ ((~Cu) & Ca);
-		uint64_t Esu = Cu ^ ((~Ca) & Ce);
-		// round 2
+		Esa = Ca ^ ((~Ce) & Ci);
+		Ese = Ce ^ ((~Ci) & Co);
+		Esi = Ci ^ ((~Co) & Cu);
+		Eso = Co ^ ((~Cu) & Ca);
+		Esu = Cu ^ ((~Ca) & Ce);
+		// round 14
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -2356,7 +2472,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x0000000000008082ULL;
+		Aba ^= 0x800000000000008BULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -2421,7 +2537,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 3
+		// round 15
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -2443,7 +2559,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x800000000000808AULL;
+		Eba ^= 0x8000000000008089ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -2508,7 +2624,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 4
+		// round 16
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -2530,7 +2646,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000080008000ULL;
+		Aba ^= 0x8000000000008003ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -2595,7 +2711,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 5
+		// round 17
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -2617,7 +2733,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x000000000000808BULL;
+		Eba ^= 0x8000000000008002ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -2682,7 +2798,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 6
+		// round 18
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -2704,7 +2820,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x0000000080000001ULL;
+		Aba ^= 0x8000000000000080ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -2769,7 +2885,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 7
+		// round 19
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -2791,7 +2907,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000080008081ULL;
+		Eba ^= 0x000000000000800AULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -2856,7 +2972,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 8
+		// round 20
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -2878,7 +2994,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000000008009ULL;
+		Aba ^= 0x800000008000000AULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -2943,7 +3059,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 9
+		// round 21
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -2965,7 +3081,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x000000000000008AULL;
+		Eba ^= 0x8000000080008081ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -3030,7 +3146,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 10
+		// round 22
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -3052,7 +3168,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x0000000000000088ULL;
+		Aba ^= 0x8000000000008080ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -3117,7 +3233,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 11
+		// round 23
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -3139,7 +3255,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x0000000080008009ULL;
+		Eba ^= 0x0000000080000001ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -3204,7 +3320,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 12
+		// round 24
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -3226,7 +3342,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x000000008000000AULL;
+		Aba ^= 0x8000000080008008ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -3291,17 +3407,74 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 13
-		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
-		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
-		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
-		Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
-		Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-		Da = Cu ^ IntUtils::RotFL64(Ce, 1);
-		De = Ca ^ IntUtils::RotFL64(Ci, 1);
-		Di = Ce ^ IntUtils::RotFL64(Co, 1);
-		Do = Ci ^ IntUtils::RotFL64(Cu, 1);
-		Du = Co ^ IntUtils::RotFL64(Ca, 1);
+
+		State[0] = Aba;
+		State[1] = Abe;
+		State[2] = Abi;
+		State[3] = Abo;
+		State[4] = Abu;
+		State[5] = Aga;
+		State[6] = Age;
+		State[7] = Agi;
+		State[8] = Ago;
+		State[9] = Agu;
+		State[10] = Aka;
+		State[11] = Ake;
+		State[12] = Aki;
+		State[13] = Ako;
+		State[14] = Aku;
+		State[15] = Ama;
+		State[16] = Ame;
+		State[17] = Ami;
+		State[18] = Amo;
+		State[19] = Amu;
+		State[20] = Asa;
+		State[21] = Ase;
+		State[22] = Asi;
+		State[23] = Aso;
+		State[24] = Asu;
+	}
+
+	template<typename Array>
+	inline static void PermuteR48P1600(Array &State)
+	{
+		uint64_t Aba = State[0];
+		uint64_t Abe = State[1];
+		uint64_t Abi = State[2];
+		uint64_t Abo = State[3];
+		uint64_t Abu = State[4];
+		uint64_t Aga = State[5];
+		uint64_t Age = State[6];
+		uint64_t Agi = State[7];
+		uint64_t Ago = State[8];
+		uint64_t Agu = State[9];
+		uint64_t Aka = State[10];
+		uint64_t Ake = State[11];
+		uint64_t Aki = State[12];
+		uint64_t Ako = State[13];
+		uint64_t Aku = State[14];
+		uint64_t Ama = State[15];
+		uint64_t Ame = State[16];
+		uint64_t Ami = State[17];
+		uint64_t Amo = State[18];
+		uint64_t Amu = State[19];
+		uint64_t Asa = State[20];
+		uint64_t Ase = State[21];
+		uint64_t Asi = State[22];
+		uint64_t Aso = State[23];
+		uint64_t Asu = State[24];
+
+		// round 1
+		uint64_t Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+		uint64_t Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+		uint64_t Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+		uint64_t Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+		uint64_t Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+		uint64_t Da = Cu ^ IntUtils::RotFL64(Ce, 1);
+		uint64_t De = Ca ^ IntUtils::RotFL64(Ci, 1);
+		uint64_t Di = Ce ^ IntUtils::RotFL64(Co, 1);
+		uint64_t Do = Ci ^ IntUtils::RotFL64(Cu, 1);
+		uint64_t Du = Co ^ IntUtils::RotFL64(Ca, 1);
 		Aba ^= Da;
 		Ca = Aba;
 		Age ^= De;
@@ -3312,12 +3485,12 @@ public:
 		Co = IntUtils::RotFL64(Amo, 21);
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
-		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x000000008000808BULL;
-		Ebe = Ce ^ ((~Ci) & Co);
-		Ebi = Ci ^ ((~Co) & Cu);
-		Ebo = Co ^ ((~Cu) & Ca);
-		Ebu = Cu ^ ((~Ca) & Ce);
+		uint64_t Eba = Ca ^ ((~Ce) & Ci);
+		Eba ^= 0x0000000000000001ULL;
+		uint64_t Ebe = Ce ^ ((~Ci) & Co);
+		uint64_t Ebi = Ci ^ ((~Co) & Cu);
+		uint64_t Ebo = Co ^ ((~Cu) & Ca);
+		uint64_t Ebu = Cu ^ ((~Ca) & Ce);
 		Abo ^= Do;
 		Ca = IntUtils::RotFL64(Abo, 28);
 		Agu ^= Du;
@@ -3328,14 +3501,14 @@ public:
 		Co = IntUtils::RotFL64(Ame, 45);
 		Asi ^= Di;
 		Cu = IntUtils::RotFL64(Asi, 61);
-		Ega = Ca ^ ((~Ce) & Ci);
-		Ege = Ce ^ ((~Ci) & Co);
-		Egi = Ci ^ ((~Co) & Cu);
-		Ego = Co ^ ((~Cu) & Ca);
-		Egu = Cu ^ ((~Ca) & Ce);
-		Abe ^= De;
-		Ca = IntUtils::RotFL64(Abe, 1);
-		Agi ^= Di;
+		uint64_t Ega = Ca ^ ((~Ce) & Ci);
+		uint64_t Ege = Ce ^ ((~Ci) & Co);
+		uint64_t Egi = Ci ^ ((~Co) & Cu);
+		uint64_t Ego = Co ^ ((~Cu) & Ca);
+		uint64_t Egu = Cu ^ ((~Ca) & Ce);
+		Abe ^= De;
+		Ca = IntUtils::RotFL64(Abe, 1);
+		Agi ^= Di;
 		Ce = IntUtils::RotFL64(Agi, 6);
 		Ako ^= Do;
 		Ci = IntUtils::RotFL64(Ako, 25);
@@ -3343,11 +3516,11 @@ public:
 		Co = IntUtils::RotFL64(Amu, 8);
 		Asa ^= Da;
 		Cu = IntUtils::RotFL64(Asa, 18);
-		Eka = Ca ^ ((~Ce) & Ci);
-		Eke = Ce ^ ((~Ci) & Co);
-		Eki = Ci ^ ((~Co) & Cu);
-		Eko = Co ^ ((~Cu) & Ca);
-		Eku = Cu ^ ((~Ca) & Ce);
+		uint64_t Eka = Ca ^ ((~Ce) & Ci);
+		uint64_t Eke = Ce ^ ((~Ci) & Co);
+		uint64_t Eki = Ci ^ ((~Co) & Cu);
+		uint64_t Eko = Co ^ ((~Cu) & Ca);
+		uint64_t Eku = Cu ^ ((~Ca) & Ce);
 		Abu ^= Du;
 		Ca = IntUtils::RotFL64(Abu, 27);
 		Aga ^= Da;
@@ -3358,11 +3531,11 @@ public:
 		Co = IntUtils::RotFL64(Ami, 15);
 		Aso ^= Do;
 		Cu = IntUtils::RotFL64(Aso, 56);
-		Ema = Ca ^ ((~Ce) & Ci);
-		Eme = Ce ^ ((~Ci) & Co);
-		Emi = Ci ^ ((~Co) & Cu);
-		Emo = Co ^ ((~Cu) & Ca);
-		Emu = Cu ^ ((~Ca) & Ce);
+		uint64_t Ema = Ca ^ ((~Ce) & Ci);
+		uint64_t Eme = Ce ^ ((~Ci) & Co);
+		uint64_t Emi = Ci ^ ((~Co) & Cu);
+		uint64_t Emo = Co ^ ((~Cu) & Ca);
+		uint64_t Emu = Cu ^ ((~Ca) & Ce);
 		Abi ^= Di;
 		Ca = IntUtils::RotFL64(Abi, 62);
 		Ago ^= Do;
@@ -3373,12 +3546,12 @@ public:
 		Co = IntUtils::RotFL64(Ama, 41);
 		Ase ^= De;
 		Cu = IntUtils::RotFL64(Ase, 2);
-		Esa = Ca ^ ((~Ce) & Ci);
-		Ese = Ce ^ ((~Ci) & Co);
-		Esi = Ci ^ ((~Co) & Cu);
-		Eso = Co ^ ((~Cu) & Ca);
-		Esu = Cu ^ ((~Ca) & Ce);
-		// round 14
+		uint64_t Esa = Ca ^ ((~Ce) & Ci);
+		uint64_t Ese = Ce ^ ((~Ci) & Co);
+		uint64_t Esi = Ci ^ ((~Co) & Cu);
+		uint64_t Eso = Co ^ ((~Cu) & Ca);
+		uint64_t Esu = Cu ^ ((~Ca) & Ce);
+		// round 2
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -3400,7 +3573,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x800000000000008BULL;
+		Aba ^= 0x0000000000008082ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -3465,7 +3638,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 15
+		// round 3
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -3487,7 +3660,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000000008089ULL;
+		Eba ^= 0x800000000000808AULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -3552,7 +3725,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 16
+		// round 4
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -3574,7 +3747,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000000008003ULL;
+		Aba ^= 0x8000000080008000ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -3639,7 +3812,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 17
+		// round 5
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -3661,7 +3834,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000000008002ULL;
+		Eba ^= 0x000000000000808BULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -3726,7 +3899,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 18
+		// round 6
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -3748,7 +3921,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000000000080ULL;
+		Aba ^= 0x0000000080000001ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -3813,7 +3986,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 19
+		// round 7
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -3835,7 +4008,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x000000000000800AULL;
+		Eba ^= 0x8000000080008081ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -3900,7 +4073,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 20
+		// round 8
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -3922,7 +4095,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x800000008000000AULL;
+		Aba ^= 0x8000000000008009ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -3987,7 +4160,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 21
+		// round 9
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -4009,7 +4182,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000080008081ULL;
+		Eba ^= 0x000000000000008AULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -4074,7 +4247,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 22
+		// round 10
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -4096,7 +4269,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000000008080ULL;
+		Aba ^= 0x0000000000000088ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -4161,7 +4334,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 23
+		// round 11
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -4183,7 +4356,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x0000000080000001ULL;
+		Eba ^= 0x0000000080008009ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -4248,7 +4421,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 24
+		// round 12
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -4270,7 +4443,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000080008008ULL;
+		Aba ^= 0x000000008000000AULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -4335,7 +4508,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 25
+		// round 13
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -4357,7 +4530,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000080008082ULL;
+		Eba ^= 0x000000008000808BULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -4422,7 +4595,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 26
+		// round 14
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -4444,7 +4617,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x800000008000800AULL;
+		Aba ^= 0x800000000000008BULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -4509,7 +4682,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 27
+		// round 15
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -4531,7 +4704,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000000000003ULL;
+		Eba ^= 0x8000000000008089ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -4596,7 +4769,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 28
+		// round 16
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -4618,7 +4791,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000080000009ULL;
+		Aba ^= 0x8000000000008003ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -4683,7 +4856,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 29
+		// round 17
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -4705,7 +4878,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000000008082ULL;
+		Eba ^= 0x8000000000008002ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -4770,7 +4943,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 30
+		// round 18
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -4792,7 +4965,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x0000000000008009ULL;
+		Aba ^= 0x8000000000000080ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -4857,7 +5030,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 31
+		// round 19
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -4879,7 +5052,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000000000080ULL;
+		Eba ^= 0x000000000000800AULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -4944,7 +5117,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 32
+		// round 20
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -4966,7 +5139,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x0000000000008083ULL;
+		Aba ^= 0x800000008000000AULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -5031,7 +5204,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 33
+		// round 21
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -5053,7 +5226,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000000000081ULL;
+		Eba ^= 0x8000000080008081ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -5118,7 +5291,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 34
+		// round 22
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -5140,7 +5313,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x0000000000000001ULL;
+		Aba ^= 0x8000000000008080ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -5205,7 +5378,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 35
+		// round 23
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -5227,7 +5400,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x000000000000800BULL;
+		Eba ^= 0x0000000080000001ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -5292,7 +5465,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 36
+		// round 24
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -5314,7 +5487,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000080008001ULL;
+		Aba ^= 0x8000000080008008ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -5379,7 +5552,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 37
+		// round 25
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -5401,7 +5574,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x0000000000000080ULL;
+		Eba ^= 0x8000000080008082ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -5466,7 +5639,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 38
+		// round 26
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -5488,7 +5661,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000000008000ULL;
+		Aba ^= 0x800000008000800AULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -5553,7 +5726,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 39
+		// round 27
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -5575,7 +5748,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000080008001ULL;
+		Eba ^= 0x8000000000000003ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -5640,7 +5813,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 40
+		// round 28
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -5662,7 +5835,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x0000000000000009ULL;
+		Aba ^= 0x8000000080000009ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -5727,7 +5900,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 41
+		// round 29
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -5749,7 +5922,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x800000008000808BULL;
+		Eba ^= 0x8000000000008082ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -5814,7 +5987,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 42
+		// round 30
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -5836,7 +6009,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x0000000000000081ULL;
+		Aba ^= 0x0000000000008009ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -5901,7 +6074,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 43
+		// round 31
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -5923,7 +6096,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000000000082ULL;
+		Eba ^= 0x8000000000000080ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -5988,7 +6161,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 44
+		// round 32
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -6010,7 +6183,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x000000008000008BULL;
+		Aba ^= 0x0000000000008083ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -6075,7 +6248,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 45
+		// round 33
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -6097,7 +6270,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x8000000080008009ULL;
+		Eba ^= 0x8000000000000081ULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -6162,7 +6335,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 46
+		// round 34
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -6184,7 +6357,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x8000000080000000ULL;
+		Aba ^= 0x0000000000000001ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -6249,7 +6422,7 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-		// round 47
+		// round 35
 		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
 		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
 		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
@@ -6271,7 +6444,7 @@ public:
 		Asu ^= Du;
 		Cu = IntUtils::RotFL64(Asu, 14);
 		Eba = Ca ^ ((~Ce) & Ci);
-		Eba ^= 0x0000000080000080ULL;
+		Eba ^= 0x000000000000800BULL;
 		Ebe = Ce ^ ((~Ci) & Co);
 		Ebi = Ci ^ ((~Co) & Cu);
 		Ebo = Co ^ ((~Cu) & Ca);
@@ -6336,7 +6509,7 @@ public:
 		Esi = Ci ^ ((~Co) & Cu);
 		Eso = Co ^ ((~Cu) & Ca);
 		Esu = Cu ^ ((~Ca) & Ce);
-		// round 48
+		// round 36
 		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
 		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
 		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
@@ -6358,7 +6531,7 @@ public:
 		Esu ^= Du;
 		Cu = IntUtils::RotFL64(Esu, 14);
 		Aba = Ca ^ ((~Ce) & Ci);
-		Aba ^= 0x0000000080008003ULL;
+		Aba ^= 0x8000000080008001ULL;
 		Abe = Ce ^ ((~Ci) & Co);
 		Abi = Ci ^ ((~Co) & Cu);
 		Abo = Co ^ ((~Cu) & Ca);
@@ -6423,85 +6596,1695 @@ public:
 		Asi = Ci ^ ((~Co) & Cu);
 		Aso = Co ^ ((~Cu) & Ca);
 		Asu = Cu ^ ((~Ca) & Ce);
-
-		State[0] = Aba;
-		State[1] = Abe;
-		State[2] = Abi;
-		State[3] = Abo;
-		State[4] = Abu;
-		State[5] = Aga;
-		State[6] = Age;
-		State[7] = Agi;
-		State[8] = Ago;
-		State[9] = Agu;
-		State[10] = Aka;
-		State[11] = Ake;
-		State[12] = Aki;
-		State[13] = Ako;
-		State[14] = Aku;
-		State[15] = Ama;
-		State[16] = Ame;
-		State[17] = Ami;
-		State[18] = Amo;
-		State[19] = Amu;
-		State[20] = Asa;
-		State[21] = Ase;
-		State[22] = Asi;
-		State[23] = Aso;
-		State[24] = Asu;
-	}
-
-#if defined(__AVX512__)
-
-	template<typename Array>
-	inline static void PermuteR24P12800(std::vector<Array> &State)
-	{
-		ULong512 Aba(State[0][0], State[1][0], State[2][0], State[3][0], State[4][0], State[5][0], State[6][0], State[7][0]);
-		ULong512 Abe(State[0][1], State[1][1], State[2][1], State[3][1], State[4][1], State[5][1], State[6][1], State[7][1]);
-		ULong512 Abi(State[0][2], State[1][2], State[2][2], State[3][2], State[4][2], State[5][2], State[6][2], State[7][2]);
-		ULong512 Abo(State[0][3], State[1][3], State[2][3], State[3][3], State[4][3], State[5][3], State[6][3], State[7][3]);
-		ULong512 Abu(State[0][4], State[1][4], State[2][4], State[3][4], State[4][4], State[5][4], State[6][4], State[7][4]);
-		ULong512 Aga(State[0][5], State[1][5], State[2][5], State[3][5], State[4][5], State[5][5], State[6][5], State[7][5]);
-		ULong512 Age(State[0][6], State[1][6], State[2][6], State[3][6], State[4][6], State[5][6], State[6][6], State[7][6]);
-		ULong512 Agi(State[0][7], State[1][7], State[2][7], State[3][7], State[4][7], State[5][7], State[6][7], State[7][7]);
-		ULong512 Ago(State[0][8], State[1][8], State[2][8], State[3][8], State[4][8], State[5][8], State[6][8], State[7][8]);
-		ULong512 Agu(State[0][9], State[1][9], State[2][9], State[3][9], State[4][9], State[5][9], State[6][9], State[7][9]);
-		ULong512 Aka(State[0][10], State[1][10], State[2][10], State[3][10], State[4][10], State[5][10], State[6][10], State[7][10]);
-		ULong512 Ake(State[0][11], State[1][11], State[2][11], State[3][11], State[4][11], State[5][11], State[6][11], State[7][11]);
-		ULong512 Aki(State[0][12], State[1][12], State[2][12], State[3][12], State[4][12], State[5][12], State[6][12], State[7][12]);
-		ULong512 Ako(State[0][13], State[1][13], State[2][13], State[3][13], State[4][13], State[5][13], State[6][13], State[7][13]);
-		ULong512 Aku(State[0][14], State[1][14], State[2][14], State[3][14], State[4][14], State[5][14], State[6][14], State[7][14]);
-		ULong512 Ama(State[0][15], State[1][15], State[2][15], State[3][15], State[4][15], State[5][15], State[6][15], State[7][15]);
-		ULong512 Ame(State[0][16], State[1][16], State[2][16], State[3][16], State[4][16], State[5][16], State[6][16], State[7][16]);
-		ULong512 Ami(State[0][17], State[1][17], State[2][17], State[3][17], State[4][17], State[5][17], State[6][17], State[7][17]);
-		ULong512 Amo(State[0][18], State[1][18], State[2][18], State[3][18], State[4][18], State[5][18], State[6][18], State[7][18]);
-		ULong512 Amu(State[0][19], State[1][19], State[2][19], State[3][19], State[4][19], State[5][19], State[6][19], State[7][19]);
-		ULong512 Asa(State[0][20], State[1][20], State[2][20], State[3][20], State[4][20], State[5][20], State[6][20], State[7][20]);
-		ULong512 Ase(State[0][21], State[1][21], State[2][21], State[3][21], State[4][21], State[5][21], State[6][21], State[7][21]);
-		ULong512 Asi(State[0][22], State[1][22], State[2][22], State[3][22], State[4][22], State[5][22], State[6][22], State[7][22]);
-		ULong512 Aso(State[0][23], State[1][23], State[2][23], State[3][23], State[4][23], State[5][23], State[6][23], State[7][23]);
-		ULong512 Asu(State[0][24], State[1][24], State[2][24], State[3][24], State[4][24], State[5][24], State[6][24], State[7][24]);
-
-		const static std::array<ULong512, 24> RC24 =
-		{
-			ULong512(0x0000000000000001ULL), ULong512(0x0000000000008082ULL), ULong512(0x800000000000808AULL), ULong512(0x8000000080008000ULL),
-			ULong512(0x000000000000808BULL), ULong512(0x0000000080000001ULL), ULong512(0x8000000080008081ULL), ULong512(0x8000000000008009ULL),
-			ULong512(0x000000000000008AULL), ULong512(0x0000000000000088ULL), ULong512(0x0000000080008009ULL), ULong512(0x000000008000000AULL),
-			ULong512(0x000000008000808BULL), ULong512(0x800000000000008BULL), ULong512(0x8000000000008089ULL), ULong512(0x8000000000008003ULL),
-			ULong512(0x8000000000008002ULL), ULong512(0x8000000000000080ULL), ULong512(0x000000000000800AULL), ULong512(0x800000008000000AULL),
-			ULong512(0x8000000080008081ULL), ULong512(0x8000000000008080ULL), ULong512(0x0000000080000001ULL), ULong512(0x8000000080008008ULL)
-		};
-
-		ULong512 Ca;
-		ULong512 Ce;
-		ULong512 Ci;
-		ULong512 Co;
-		ULong512 Cu;
-		ULong512 Da;
-		ULong512 De;
-		ULong512 Di;
-		ULong512 Do;
-		ULong512 Du;
+		// round 37
+		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+		Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+		Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+		Da = Cu ^ IntUtils::RotFL64(Ce, 1);
+		De = Ca ^ IntUtils::RotFL64(Ci, 1);
+		Di = Ce ^ IntUtils::RotFL64(Co, 1);
+		Do = Ci ^ IntUtils::RotFL64(Cu, 1);
+		Du = Co ^ IntUtils::RotFL64(Ca, 1);
+		Aba ^= Da;
+		Ca = Aba;
+		Age ^= De;
+		Ce = IntUtils::RotFL64(Age, 44);
+		Aki ^= Di;
+		Ci = IntUtils::RotFL64(Aki, 43);
+		Amo ^= Do;
+		Co = IntUtils::RotFL64(Amo, 21);
+		Asu ^= Du;
+		Cu = IntUtils::RotFL64(Asu, 14);
+		Eba = Ca ^ ((~Ce) & Ci);
+		Eba ^= 0x0000000000000080ULL;
+		Ebe = Ce ^ ((~Ci) & Co);
+		Ebi = Ci ^ ((~Co) & Cu);
+		Ebo = Co ^ ((~Cu) & Ca);
+		Ebu = Cu ^ ((~Ca) & Ce);
+		Abo ^= Do;
+		Ca = IntUtils::RotFL64(Abo, 28);
+		Agu ^= Du;
+		Ce = IntUtils::RotFL64(Agu, 20);
+		Aka ^= Da;
+		Ci = IntUtils::RotFL64(Aka, 3);
+		Ame ^= De;
+		Co = IntUtils::RotFL64(Ame, 45);
+		Asi ^= Di;
+		Cu = IntUtils::RotFL64(Asi, 61);
+		Ega = Ca ^ ((~Ce) & Ci);
+		Ege = Ce ^ ((~Ci) & Co);
+		Egi = Ci ^ ((~Co) & Cu);
+		Ego = Co ^ ((~Cu) & Ca);
+		Egu = Cu ^ ((~Ca) & Ce);
+		Abe ^= De;
+		Ca = IntUtils::RotFL64(Abe, 1);
+		Agi ^= Di;
+		Ce = IntUtils::RotFL64(Agi, 6);
+		Ako ^= Do;
+		Ci = IntUtils::RotFL64(Ako, 25);
+		Amu ^= Du;
+		Co = IntUtils::RotFL64(Amu, 8);
+		Asa ^= Da;
+		Cu = IntUtils::RotFL64(Asa, 18);
+		Eka = Ca ^ ((~Ce) & Ci);
+		Eke = Ce ^ ((~Ci) & Co);
+		Eki = Ci ^ ((~Co) & Cu);
+		Eko = Co ^ ((~Cu) & Ca);
+		Eku = Cu ^ ((~Ca) & Ce);
+		Abu ^= Du;
+		Ca = IntUtils::RotFL64(Abu, 27);
+		Aga ^= Da;
+		Ce = IntUtils::RotFL64(Aga, 36);
+		Ake ^= De;
+		Ci = IntUtils::RotFL64(Ake, 10);
+		Ami ^= Di;
+		Co = IntUtils::RotFL64(Ami, 15);
+		Aso ^= Do;
+		Cu = IntUtils::RotFL64(Aso, 56);
+		Ema = Ca ^ ((~Ce) & Ci);
+		Eme = Ce ^ ((~Ci) & Co);
+		Emi = Ci ^ ((~Co) & Cu);
+		Emo = Co ^ ((~Cu) & Ca);
+		Emu = Cu ^ ((~Ca) & Ce);
+		Abi ^= Di;
+		Ca = IntUtils::RotFL64(Abi, 62);
+		Ago ^= Do;
+		Ce = IntUtils::RotFL64(Ago, 55);
+		Aku ^= Du;
+		Ci = IntUtils::RotFL64(Aku, 39);
+		Ama ^= Da;
+		Co = IntUtils::RotFL64(Ama, 41);
+		Ase ^= De;
+		Cu = IntUtils::RotFL64(Ase, 2);
+		Esa = Ca ^ ((~Ce) & Ci);
+		Ese = Ce ^ ((~Ci) & Co);
+		Esi = Ci ^ ((~Co) & Cu);
+		Eso = Co ^ ((~Cu) & Ca);
+		Esu = Cu ^ ((~Ca) & Ce);
+		// round 38
+		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
+		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
+		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
+		Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
+		Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
+		Da = Cu ^ IntUtils::RotFL64(Ce, 1);
+		De = Ca ^ IntUtils::RotFL64(Ci, 1);
+		Di = Ce ^ IntUtils::RotFL64(Co, 1);
+		Do = Ci ^ IntUtils::RotFL64(Cu, 1);
+		Du = Co ^ IntUtils::RotFL64(Ca, 1);
+		Eba ^= Da;
+		Ca = Eba;
+		Ege ^= De;
+		Ce = IntUtils::RotFL64(Ege, 44);
+		Eki ^= Di;
+		Ci = IntUtils::RotFL64(Eki, 43);
+		Emo ^= Do;
+		Co = IntUtils::RotFL64(Emo, 21);
+		Esu ^= Du;
+		Cu = IntUtils::RotFL64(Esu, 14);
+		Aba = Ca ^ ((~Ce) & Ci);
+		Aba ^= 0x8000000000008000ULL;
+		Abe = Ce ^ ((~Ci) & Co);
+		Abi = Ci ^ ((~Co) & Cu);
+		Abo = Co ^ ((~Cu) & Ca);
+		Abu = Cu ^ ((~Ca) & Ce);
+		Ebo ^= Do;
+		Ca = IntUtils::RotFL64(Ebo, 28);
+		Egu ^= Du;
+		Ce = IntUtils::RotFL64(Egu, 20);
+		Eka ^= Da;
+		Ci = IntUtils::RotFL64(Eka, 3);
+		Eme ^= De;
+		Co = IntUtils::RotFL64(Eme, 45);
+		Esi ^= Di;
+		Cu = IntUtils::RotFL64(Esi, 61);
+		Aga = Ca ^ ((~Ce) & Ci);
+		Age = Ce ^ ((~Ci) & Co);
+		Agi = Ci ^ ((~Co) & Cu);
+		Ago = Co ^ ((~Cu) & Ca);
+		Agu = Cu ^ ((~Ca) & Ce);
+		Ebe ^= De;
+		Ca = IntUtils::RotFL64(Ebe, 1);
+		Egi ^= Di;
+		Ce = IntUtils::RotFL64(Egi, 6);
+		Eko ^= Do;
+		Ci = IntUtils::RotFL64(Eko, 25);
+		Emu ^= Du;
+		Co = IntUtils::RotFL64(Emu, 8);
+		Esa ^= Da;
+		Cu = IntUtils::RotFL64(Esa, 18);
+		Aka = Ca ^ ((~Ce) & Ci);
+		Ake = Ce ^ ((~Ci) & Co);
+		Aki = Ci ^ ((~Co) & Cu);
+		Ako = Co ^ ((~Cu) & Ca);
+		Aku = Cu ^ ((~Ca) & Ce);
+		Ebu ^= Du;
+		Ca = IntUtils::RotFL64(Ebu, 27);
+		Ega ^= Da;
+		Ce = IntUtils::RotFL64(Ega, 36);
+		Eke ^= De;
+		Ci = IntUtils::RotFL64(Eke, 10);
+		Emi ^= Di;
+		Co = IntUtils::RotFL64(Emi, 15);
+		Eso ^= Do;
+		Cu = IntUtils::RotFL64(Eso, 56);
+		Ama = Ca ^ ((~Ce) & Ci);
+		Ame = Ce ^ ((~Ci) & Co);
+		Ami = Ci ^ ((~Co) & Cu);
+		Amo = Co ^ ((~Cu) & Ca);
+		Amu = Cu ^ ((~Ca) & Ce);
+		Ebi ^= Di;
+		Ca = IntUtils::RotFL64(Ebi, 62);
+		Ego ^= Do;
+		Ce = IntUtils::RotFL64(Ego, 55);
+		Eku ^= Du;
+		Ci = IntUtils::RotFL64(Eku, 39);
+		Ema ^= Da;
+		Co = IntUtils::RotFL64(Ema, 41);
+		Ese ^= De;
+		Cu = IntUtils::RotFL64(Ese, 2);
+		Asa = Ca ^ ((~Ce) & Ci);
+		Ase = Ce ^ ((~Ci) & Co);
+		Asi = Ci ^ ((~Co) & Cu);
+		Aso = Co ^ ((~Cu) & Ca);
+		Asu = Cu ^ ((~Ca) & Ce);
+		// round 39
+		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+		Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+		Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+		Da = Cu ^ IntUtils::RotFL64(Ce, 1);
+		De = Ca ^ IntUtils::RotFL64(Ci, 1);
+		Di = Ce ^ IntUtils::RotFL64(Co, 1);
+		Do = Ci ^ IntUtils::RotFL64(Cu, 1);
+		Du = Co ^ IntUtils::RotFL64(Ca, 1);
+		Aba ^= Da;
+		Ca = Aba;
+		Age ^= De;
+		Ce = IntUtils::RotFL64(Age, 44);
+		Aki ^= Di;
+		Ci = IntUtils::RotFL64(Aki, 43);
+		Amo ^= Do;
+		Co = IntUtils::RotFL64(Amo, 21);
+		Asu ^= Du;
+		Cu = IntUtils::RotFL64(Asu, 14);
+		Eba = Ca ^ ((~Ce) & Ci);
+		Eba ^= 0x8000000080008001ULL;
+		Ebe = Ce ^ ((~Ci) & Co);
+		Ebi = Ci ^ ((~Co) & Cu);
+		Ebo = Co ^ ((~Cu) & Ca);
+		Ebu = Cu ^ ((~Ca) & Ce);
+		Abo ^= Do;
+		Ca = IntUtils::RotFL64(Abo, 28);
+		Agu ^= Du;
+		Ce = IntUtils::RotFL64(Agu, 20);
+		Aka ^= Da;
+		Ci = IntUtils::RotFL64(Aka, 3);
+		Ame ^= De;
+		Co = IntUtils::RotFL64(Ame, 45);
+		Asi ^= Di;
+		Cu = IntUtils::RotFL64(Asi, 61);
+		Ega = Ca ^ ((~Ce) & Ci);
+		Ege = Ce ^ ((~Ci) & Co);
+		Egi = Ci ^ ((~Co) & Cu);
+		Ego = Co ^ ((~Cu) & Ca);
+		Egu = Cu ^ ((~Ca) & Ce);
+		Abe ^= De;
+		Ca = IntUtils::RotFL64(Abe, 1);
+		Agi ^= Di;
+		Ce = IntUtils::RotFL64(Agi, 6);
+		Ako ^= Do;
+		Ci = IntUtils::RotFL64(Ako, 25);
+		Amu ^= Du;
+		Co = IntUtils::RotFL64(Amu, 8);
+		Asa ^= Da;
+		Cu = IntUtils::RotFL64(Asa, 18);
+		Eka = Ca ^ ((~Ce) & Ci);
+		Eke = Ce ^ ((~Ci) & Co);
+		Eki = Ci ^ ((~Co) & Cu);
+		Eko = Co ^ ((~Cu) & Ca);
+		Eku = Cu ^ ((~Ca) & Ce);
+		Abu ^= Du;
+		Ca = IntUtils::RotFL64(Abu, 27);
+		Aga ^= Da;
+		Ce = IntUtils::RotFL64(Aga, 36);
+		Ake ^= De;
+		Ci = IntUtils::RotFL64(Ake, 10);
+		Ami ^= Di;
+		Co = IntUtils::RotFL64(Ami, 15);
+		Aso ^= Do;
+		Cu = IntUtils::RotFL64(Aso, 56);
+		Ema = Ca ^ ((~Ce) & Ci);
+		Eme = Ce ^ ((~Ci) & Co);
+		Emi = Ci ^ ((~Co) & Cu);
+		Emo = Co ^ ((~Cu) & Ca);
+		Emu = Cu ^ ((~Ca) & Ce);
+		Abi ^= Di;
+		Ca = IntUtils::RotFL64(Abi, 62);
+		Ago ^= Do;
+		Ce = IntUtils::RotFL64(Ago, 55);
+		Aku ^= Du;
+		Ci = IntUtils::RotFL64(Aku, 39);
+		Ama ^= Da;
+		Co = IntUtils::RotFL64(Ama, 41);
+		Ase ^= De;
+		Cu = IntUtils::RotFL64(Ase, 2);
+		Esa = Ca ^ ((~Ce) & Ci);
+		Ese = Ce ^ ((~Ci) & Co);
+		Esi = Ci ^ ((~Co) & Cu);
+		Eso = Co ^ ((~Cu) & Ca);
+		Esu = Cu ^ ((~Ca) & Ce);
+		// round 40
+		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
+		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
+		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
+		Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
+		Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
+		Da = Cu ^ IntUtils::RotFL64(Ce, 1);
+		De = Ca ^ IntUtils::RotFL64(Ci, 1);
+		Di = Ce ^ IntUtils::RotFL64(Co, 1);
+		Do = Ci ^ IntUtils::RotFL64(Cu, 1);
+		Du = Co ^ IntUtils::RotFL64(Ca, 1);
+		Eba ^= Da;
+		Ca = Eba;
+		Ege ^= De;
+		Ce = IntUtils::RotFL64(Ege, 44);
+		Eki ^= Di;
+		Ci = IntUtils::RotFL64(Eki, 43);
+		Emo ^= Do;
+		Co = IntUtils::RotFL64(Emo, 21);
+		Esu ^= Du;
+		Cu = IntUtils::RotFL64(Esu, 14);
+		Aba = Ca ^ ((~Ce) & Ci);
+		Aba ^= 0x0000000000000009ULL;
+		Abe = Ce ^ ((~Ci) & Co);
+		Abi = Ci ^ ((~Co) & Cu);
+		Abo = Co ^ ((~Cu) & Ca);
+		Abu = Cu ^ ((~Ca) & Ce);
+		Ebo ^= Do;
+		Ca = IntUtils::RotFL64(Ebo, 28);
+		Egu ^= Du;
+		Ce = IntUtils::RotFL64(Egu, 20);
+		Eka ^= Da;
+		Ci = IntUtils::RotFL64(Eka, 3);
+		Eme ^= De;
+		Co = IntUtils::RotFL64(Eme, 45);
+		Esi ^= Di;
+		Cu = IntUtils::RotFL64(Esi, 61);
+		Aga = Ca ^ ((~Ce) & Ci);
+		Age = Ce ^ ((~Ci) & Co);
+		Agi = Ci ^ ((~Co) & Cu);
+		Ago = Co ^ ((~Cu) & Ca);
+		Agu = Cu ^ ((~Ca) & Ce);
+		Ebe ^= De;
+		Ca = IntUtils::RotFL64(Ebe, 1);
+		Egi ^= Di;
+		Ce = IntUtils::RotFL64(Egi, 6);
+		Eko ^= Do;
+		Ci = IntUtils::RotFL64(Eko, 25);
+		Emu ^= Du;
+		Co = IntUtils::RotFL64(Emu, 8);
+		Esa ^= Da;
+		Cu = IntUtils::RotFL64(Esa, 18);
+		Aka = Ca ^ ((~Ce) & Ci);
+		Ake = Ce ^ ((~Ci) & Co);
+		Aki = Ci ^ ((~Co) & Cu);
+		Ako = Co ^ ((~Cu) & Ca);
+		Aku = Cu ^ ((~Ca) & Ce);
+		Ebu ^= Du;
+		Ca = IntUtils::RotFL64(Ebu, 27);
+		Ega ^= Da;
+		Ce = IntUtils::RotFL64(Ega, 36);
+		Eke ^= De;
+		Ci = IntUtils::RotFL64(Eke, 10);
+		Emi ^= Di;
+		Co = IntUtils::RotFL64(Emi, 15);
+		Eso ^= Do;
+		Cu = IntUtils::RotFL64(Eso, 56);
+		Ama = Ca ^ ((~Ce) & Ci);
+		Ame = Ce ^ ((~Ci) & Co);
+		Ami = Ci ^ ((~Co) & Cu);
+		Amo = Co ^ ((~Cu) & Ca);
+		Amu = Cu ^ ((~Ca) & Ce);
+		Ebi ^= Di;
+		Ca = IntUtils::RotFL64(Ebi, 62);
+		Ego ^= Do;
+		Ce = IntUtils::RotFL64(Ego, 55);
+		Eku ^= Du;
+		Ci = IntUtils::RotFL64(Eku, 39);
+		Ema ^= Da;
+		Co = IntUtils::RotFL64(Ema, 41);
+		Ese ^= De;
+		Cu = IntUtils::RotFL64(Ese, 2);
+		Asa = Ca ^ ((~Ce) & Ci);
+		Ase = Ce ^ ((~Ci) & Co);
+		Asi = Ci ^ ((~Co) & Cu);
+		Aso = Co ^ ((~Cu) & Ca);
+		Asu = Cu ^ ((~Ca) & Ce);
+		// round 41
+		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+		Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+		Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+		Da = Cu ^ IntUtils::RotFL64(Ce, 1);
+		De = Ca ^ IntUtils::RotFL64(Ci, 1);
+		Di = Ce ^ IntUtils::RotFL64(Co, 1);
+		Do = Ci ^ IntUtils::RotFL64(Cu, 1);
+		Du = Co ^ IntUtils::RotFL64(Ca, 1);
+		Aba ^= Da;
+		Ca = Aba;
+		Age ^= De;
+		Ce = IntUtils::RotFL64(Age, 44);
+		Aki ^= Di;
+		Ci = IntUtils::RotFL64(Aki, 43);
+		Amo ^= Do;
+		Co = IntUtils::RotFL64(Amo, 21);
+		Asu ^= Du;
+		Cu = IntUtils::RotFL64(Asu, 14);
+		Eba = Ca ^ ((~Ce) & Ci);
+		Eba ^= 0x800000008000808BULL;
+		Ebe = Ce ^ ((~Ci) & Co);
+		Ebi = Ci ^ ((~Co) & Cu);
+		Ebo = Co ^ ((~Cu) & Ca);
+		Ebu = Cu ^ ((~Ca) & Ce);
+		Abo ^= Do;
+		Ca = IntUtils::RotFL64(Abo, 28);
+		Agu ^= Du;
+		Ce = IntUtils::RotFL64(Agu, 20);
+		Aka ^= Da;
+		Ci = IntUtils::RotFL64(Aka, 3);
+		Ame ^= De;
+		Co = IntUtils::RotFL64(Ame, 45);
+		Asi ^= Di;
+		Cu = IntUtils::RotFL64(Asi, 61);
+		Ega = Ca ^ ((~Ce) & Ci);
+		Ege = Ce ^ ((~Ci) & Co);
+		Egi = Ci ^ ((~Co) & Cu);
+		Ego = Co ^ ((~Cu) & Ca);
+		Egu = Cu ^ ((~Ca) & Ce);
+		Abe ^= De;
+		Ca = IntUtils::RotFL64(Abe, 1);
+		Agi ^= Di;
+		Ce = IntUtils::RotFL64(Agi, 6);
+		Ako ^= Do;
+		Ci = IntUtils::RotFL64(Ako, 25);
+		Amu ^= Du;
+		Co = IntUtils::RotFL64(Amu, 8);
+		Asa ^= Da;
+		Cu = IntUtils::RotFL64(Asa, 18);
+		Eka = Ca ^ ((~Ce) & Ci);
+		Eke = Ce ^ ((~Ci) & Co);
+		Eki = Ci ^ ((~Co) & Cu);
+		Eko = Co ^ ((~Cu) & Ca);
+		Eku = Cu ^ ((~Ca) & Ce);
+		Abu ^= Du;
+		Ca = IntUtils::RotFL64(Abu, 27);
+		Aga ^= Da;
+		Ce = IntUtils::RotFL64(Aga, 36);
+		Ake ^= De;
+		Ci = IntUtils::RotFL64(Ake, 10);
+		Ami ^= Di;
+		Co = IntUtils::RotFL64(Ami, 15);
+		Aso ^= Do;
+		Cu = IntUtils::RotFL64(Aso, 56);
+		Ema = Ca ^ ((~Ce) & Ci);
+		Eme = Ce ^ ((~Ci) & Co);
+		Emi = Ci ^ ((~Co) & Cu);
+		Emo = Co ^ ((~Cu) & Ca);
+		Emu = Cu ^ ((~Ca) & Ce);
+		Abi ^= Di;
+		Ca = IntUtils::RotFL64(Abi, 62);
+		Ago ^= Do;
+		Ce = IntUtils::RotFL64(Ago, 55);
+		Aku ^= Du;
+		Ci = IntUtils::RotFL64(Aku, 39);
+		Ama ^= Da;
+		Co = IntUtils::RotFL64(Ama, 41);
+		Ase ^= De;
+		Cu = IntUtils::RotFL64(Ase, 2);
+		Esa = Ca ^ ((~Ce) & Ci);
+		Ese = Ce ^ ((~Ci) & Co);
+		Esi = Ci ^ ((~Co) & Cu);
+		Eso = Co ^ ((~Cu) & Ca);
+		Esu = Cu ^ ((~Ca) & Ce);
+		// round 42
+		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
+		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
+		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
+		Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
+		Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
+		Da = Cu ^ IntUtils::RotFL64(Ce, 1);
+		De = Ca ^ IntUtils::RotFL64(Ci, 1);
+		Di = Ce ^ IntUtils::RotFL64(Co, 1);
+		Do = Ci ^ IntUtils::RotFL64(Cu, 1);
+		Du = Co ^ IntUtils::RotFL64(Ca, 1);
+		Eba ^= Da;
+		Ca = Eba;
+		Ege ^= De;
+		Ce = IntUtils::RotFL64(Ege, 44);
+		Eki ^= Di;
+		Ci = IntUtils::RotFL64(Eki, 43);
+		Emo ^= Do;
+		Co = IntUtils::RotFL64(Emo, 21);
+		Esu ^= Du;
+		Cu = IntUtils::RotFL64(Esu, 14);
+		Aba = Ca ^ ((~Ce) & Ci);
+		Aba ^= 0x0000000000000081ULL;
+		Abe = Ce ^ ((~Ci) & Co);
+		Abi = Ci ^ ((~Co) & Cu);
+		Abo = Co ^ ((~Cu) & Ca);
+		Abu = Cu ^ ((~Ca) & Ce);
+		Ebo ^= Do;
+		Ca = IntUtils::RotFL64(Ebo, 28);
+		Egu ^= Du;
+		Ce = IntUtils::RotFL64(Egu, 20);
+		Eka ^= Da;
+		Ci = IntUtils::RotFL64(Eka, 3);
+		Eme ^= De;
+		Co = IntUtils::RotFL64(Eme, 45);
+		Esi ^= Di;
+		Cu = IntUtils::RotFL64(Esi, 61);
+		Aga = Ca ^ ((~Ce) & Ci);
+		Age = Ce ^ ((~Ci) & Co);
+		Agi = Ci ^ ((~Co) & Cu);
+		Ago = Co ^ ((~Cu) & Ca);
+		Agu = Cu ^ ((~Ca) & Ce);
+		Ebe ^= De;
+		Ca = IntUtils::RotFL64(Ebe, 1);
+		Egi ^= Di;
+		Ce = IntUtils::RotFL64(Egi, 6);
+		Eko ^= Do;
+		Ci = IntUtils::RotFL64(Eko, 25);
+		Emu ^= Du;
+		Co = IntUtils::RotFL64(Emu, 8);
+		Esa ^= Da;
+		Cu = IntUtils::RotFL64(Esa, 18);
+		Aka = Ca ^ ((~Ce) & Ci);
+		Ake = Ce ^ ((~Ci) & Co);
+		Aki = Ci ^ ((~Co) & Cu);
+		Ako = Co ^ ((~Cu) & Ca);
+		Aku = Cu ^ ((~Ca) & Ce);
+		Ebu ^= Du;
+		Ca = IntUtils::RotFL64(Ebu, 27);
+		Ega ^= Da;
+		Ce = IntUtils::RotFL64(Ega, 36);
+		Eke ^= De;
+		Ci = IntUtils::RotFL64(Eke, 10);
+		Emi ^= Di;
+		Co = IntUtils::RotFL64(Emi, 15);
+		Eso ^= Do;
+		Cu = IntUtils::RotFL64(Eso, 56);
+		Ama = Ca ^ ((~Ce) & Ci);
+		Ame = Ce ^ ((~Ci) & Co);
+		Ami = Ci ^ ((~Co) & Cu);
+		Amo = Co ^ ((~Cu) & Ca);
+		Amu = Cu ^ ((~Ca) & Ce);
+		Ebi ^= Di;
+		Ca = IntUtils::RotFL64(Ebi, 62);
+		Ego ^= Do;
+		Ce = IntUtils::RotFL64(Ego, 55);
+		Eku ^= Du;
+		Ci = IntUtils::RotFL64(Eku, 39);
+		Ema ^= Da;
+		Co = IntUtils::RotFL64(Ema, 41);
+		Ese ^= De;
+		Cu = IntUtils::RotFL64(Ese, 2);
+		Asa = Ca ^ ((~Ce) & Ci);
+		Ase = Ce ^ ((~Ci) & Co);
+		Asi = Ci ^ ((~Co) & Cu);
+		Aso = Co ^ ((~Cu) & Ca);
+		Asu = Cu ^ ((~Ca) & Ce);
+		// round 43
+		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+		Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+		Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+		Da = Cu ^ IntUtils::RotFL64(Ce, 1);
+		De = Ca ^ IntUtils::RotFL64(Ci, 1);
+		Di = Ce ^ IntUtils::RotFL64(Co, 1);
+		Do = Ci ^ IntUtils::RotFL64(Cu, 1);
+		Du = Co ^ IntUtils::RotFL64(Ca, 1);
+		Aba ^= Da;
+		Ca = Aba;
+		Age ^= De;
+		Ce = IntUtils::RotFL64(Age, 44);
+		Aki ^= Di;
+		Ci = IntUtils::RotFL64(Aki, 43);
+		Amo ^= Do;
+		Co = IntUtils::RotFL64(Amo, 21);
+		Asu ^= Du;
+		Cu = IntUtils::RotFL64(Asu, 14);
+		Eba = Ca ^ ((~Ce) & Ci);
+		Eba ^= 0x8000000000000082ULL;
+		Ebe = Ce ^ ((~Ci) & Co);
+		Ebi = Ci ^ ((~Co) & Cu);
+		Ebo = Co ^ ((~Cu) & Ca);
+		Ebu = Cu ^ ((~Ca) & Ce);
+		Abo ^= Do;
+		Ca = IntUtils::RotFL64(Abo, 28);
+		Agu ^= Du;
+		Ce = IntUtils::RotFL64(Agu, 20);
+		Aka ^= Da;
+		Ci = IntUtils::RotFL64(Aka, 3);
+		Ame ^= De;
+		Co = IntUtils::RotFL64(Ame, 45);
+		Asi ^= Di;
+		Cu = IntUtils::RotFL64(Asi, 61);
+		Ega = Ca ^ ((~Ce) & Ci);
+		Ege = Ce ^ ((~Ci) & Co);
+		Egi = Ci ^ ((~Co) & Cu);
+		Ego = Co ^ ((~Cu) & Ca);
+		Egu = Cu ^ ((~Ca) & Ce);
+		Abe ^= De;
+		Ca = IntUtils::RotFL64(Abe, 1);
+		Agi ^= Di;
+		Ce = IntUtils::RotFL64(Agi, 6);
+		Ako ^= Do;
+		Ci = IntUtils::RotFL64(Ako, 25);
+		Amu ^= Du;
+		Co = IntUtils::RotFL64(Amu, 8);
+		Asa ^= Da;
+		Cu = IntUtils::RotFL64(Asa, 18);
+		Eka = Ca ^ ((~Ce) & Ci);
+		Eke = Ce ^ ((~Ci) & Co);
+		Eki = Ci ^ ((~Co) & Cu);
+		Eko = Co ^ ((~Cu) & Ca);
+		Eku = Cu ^ ((~Ca) & Ce);
+		Abu ^= Du;
+		Ca = IntUtils::RotFL64(Abu, 27);
+		Aga ^= Da;
+		Ce = IntUtils::RotFL64(Aga, 36);
+		Ake ^= De;
+		Ci = IntUtils::RotFL64(Ake, 10);
+		Ami ^= Di;
+		Co = IntUtils::RotFL64(Ami, 15);
+		Aso ^= Do;
+		Cu = IntUtils::RotFL64(Aso, 56);
+		Ema = Ca ^ ((~Ce) & Ci);
+		Eme = Ce ^ ((~Ci) & Co);
+		Emi = Ci ^ ((~Co) & Cu);
+		Emo = Co ^ ((~Cu) & Ca);
+		Emu = Cu ^ ((~Ca) & Ce);
+		Abi ^= Di;
+		Ca = IntUtils::RotFL64(Abi, 62);
+		Ago ^= Do;
+		Ce = IntUtils::RotFL64(Ago, 55);
+		Aku ^= Du;
+		Ci = IntUtils::RotFL64(Aku, 39);
+		Ama ^= Da;
+		Co = IntUtils::RotFL64(Ama, 41);
+		Ase ^= De;
+		Cu = IntUtils::RotFL64(Ase, 2);
+		Esa = Ca ^ ((~Ce) & Ci);
+		Ese = Ce ^ ((~Ci) & Co);
+		Esi = Ci ^ ((~Co) & Cu);
+		Eso = Co ^ ((~Cu) & Ca);
+		Esu = Cu ^ ((~Ca) & Ce);
+		// round 44
+		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
+		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
+		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
+		Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
+		Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
+		Da = Cu ^ IntUtils::RotFL64(Ce, 1);
+		De = Ca ^ IntUtils::RotFL64(Ci, 1);
+		Di = Ce ^ IntUtils::RotFL64(Co, 1);
+		Do = Ci ^ IntUtils::RotFL64(Cu, 1);
+		Du = Co ^ IntUtils::RotFL64(Ca, 1);
+		Eba ^= Da;
+		Ca = Eba;
+		Ege ^= De;
+		Ce = IntUtils::RotFL64(Ege, 44);
+		Eki ^= Di;
+		Ci = IntUtils::RotFL64(Eki, 43);
+		Emo ^= Do;
+		Co = IntUtils::RotFL64(Emo, 21);
+		Esu ^= Du;
+		Cu = IntUtils::RotFL64(Esu, 14);
+		Aba = Ca ^ ((~Ce) & Ci);
+		Aba ^= 0x000000008000008BULL;
+		Abe = Ce ^ ((~Ci) & Co);
+		Abi = Ci ^ ((~Co) & Cu);
+		Abo = Co ^ ((~Cu) & Ca);
+		Abu = Cu ^ ((~Ca) & Ce);
+		Ebo ^= Do;
+		Ca = IntUtils::RotFL64(Ebo, 28);
+		Egu ^= Du;
+		Ce = IntUtils::RotFL64(Egu, 20);
+		Eka ^= Da;
+		Ci = IntUtils::RotFL64(Eka, 3);
+		Eme ^= De;
+		Co = IntUtils::RotFL64(Eme, 45);
+		Esi ^= Di;
+		Cu = IntUtils::RotFL64(Esi, 61);
+		Aga = Ca ^ ((~Ce) & Ci);
+		Age = Ce ^ ((~Ci) & Co);
+		Agi = Ci ^ ((~Co) & Cu);
+		Ago = Co ^ ((~Cu) & Ca);
+		Agu = Cu ^ ((~Ca) & Ce);
+		Ebe ^= De;
+		Ca = IntUtils::RotFL64(Ebe, 1);
+		Egi ^= Di;
+		Ce = IntUtils::RotFL64(Egi, 6);
+		Eko ^= Do;
+		Ci = IntUtils::RotFL64(Eko, 25);
+		Emu ^= Du;
+		Co = IntUtils::RotFL64(Emu, 8);
+		Esa ^= Da;
+		Cu = IntUtils::RotFL64(Esa, 18);
+		Aka = Ca ^ ((~Ce) & Ci);
+		Ake = Ce ^ ((~Ci) & Co);
+		Aki = Ci ^ ((~Co) & Cu);
+		Ako = Co ^ ((~Cu) & Ca);
+		Aku = Cu ^ ((~Ca) & Ce);
+		Ebu ^= Du;
+		Ca = IntUtils::RotFL64(Ebu, 27);
+		Ega ^= Da;
+		Ce = IntUtils::RotFL64(Ega, 36);
+		Eke ^= De;
+		Ci = IntUtils::RotFL64(Eke, 10);
+		Emi ^= Di;
+		Co = IntUtils::RotFL64(Emi, 15);
+		Eso ^= Do;
+		Cu = IntUtils::RotFL64(Eso, 56);
+		Ama = Ca ^ ((~Ce) & Ci);
+		Ame = Ce ^ ((~Ci) & Co);
+		Ami = Ci ^ ((~Co) & Cu);
+		Amo = Co ^ ((~Cu) & Ca);
+		Amu = Cu ^ ((~Ca) & Ce);
+		Ebi ^= Di;
+		Ca = IntUtils::RotFL64(Ebi, 62);
+		Ego ^= Do;
+		Ce = IntUtils::RotFL64(Ego, 55);
+		Eku ^= Du;
+		Ci = IntUtils::RotFL64(Eku, 39);
+		Ema ^= Da;
+		Co = IntUtils::RotFL64(Ema, 41);
+		Ese ^= De;
+		Cu = IntUtils::RotFL64(Ese, 2);
+		Asa = Ca ^ ((~Ce) & Ci);
+		Ase = Ce ^ ((~Ci) & Co);
+		Asi = Ci ^ ((~Co) & Cu);
+		Aso = Co ^ ((~Cu) & Ca);
+		Asu = Cu ^ ((~Ca) & Ce);
+		// round 45
+		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+		Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+		Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+		Da = Cu ^ IntUtils::RotFL64(Ce, 1);
+		De = Ca ^ IntUtils::RotFL64(Ci, 1);
+		Di = Ce ^ IntUtils::RotFL64(Co, 1);
+		Do = Ci ^ IntUtils::RotFL64(Cu, 1);
+		Du = Co ^ IntUtils::RotFL64(Ca, 1);
+		Aba ^= Da;
+		Ca = Aba;
+		Age ^= De;
+		Ce = IntUtils::RotFL64(Age, 44);
+		Aki ^= Di;
+		Ci = IntUtils::RotFL64(Aki, 43);
+		Amo ^= Do;
+		Co = IntUtils::RotFL64(Amo, 21);
+		Asu ^= Du;
+		Cu = IntUtils::RotFL64(Asu, 14);
+		Eba = Ca ^ ((~Ce) & Ci);
+		Eba ^= 0x8000000080008009ULL;
+		Ebe = Ce ^ ((~Ci) & Co);
+		Ebi = Ci ^ ((~Co) & Cu);
+		Ebo = Co ^ ((~Cu) & Ca);
+		Ebu = Cu ^ ((~Ca) & Ce);
+		Abo ^= Do;
+		Ca = IntUtils::RotFL64(Abo, 28);
+		Agu ^= Du;
+		Ce = IntUtils::RotFL64(Agu, 20);
+		Aka ^= Da;
+		Ci = IntUtils::RotFL64(Aka, 3);
+		Ame ^= De;
+		Co = IntUtils::RotFL64(Ame, 45);
+		Asi ^= Di;
+		Cu = IntUtils::RotFL64(Asi, 61);
+		Ega = Ca ^ ((~Ce) & Ci);
+		Ege = Ce ^ ((~Ci) & Co);
+		Egi = Ci ^ ((~Co) & Cu);
+		Ego = Co ^ ((~Cu) & Ca);
+		Egu = Cu ^ ((~Ca) & Ce);
+		Abe ^= De;
+		Ca = IntUtils::RotFL64(Abe, 1);
+		Agi ^= Di;
+		Ce = IntUtils::RotFL64(Agi, 6);
+		Ako ^= Do;
+		Ci = IntUtils::RotFL64(Ako, 25);
+		Amu ^= Du;
+		Co = IntUtils::RotFL64(Amu, 8);
+		Asa ^= Da;
+		Cu = IntUtils::RotFL64(Asa, 18);
+		Eka = Ca ^ ((~Ce) & Ci);
+		Eke = Ce ^ ((~Ci) & Co);
+		Eki = Ci ^ ((~Co) & Cu);
+		Eko = Co ^ ((~Cu) & Ca);
+		Eku = Cu ^ ((~Ca) & Ce);
+		Abu ^= Du;
+		Ca = IntUtils::RotFL64(Abu, 27);
+		Aga ^= Da;
+		Ce = IntUtils::RotFL64(Aga, 36);
+		Ake ^= De;
+		Ci = IntUtils::RotFL64(Ake, 10);
+		Ami ^= Di;
+		Co = IntUtils::RotFL64(Ami, 15);
+		Aso ^= Do;
+		Cu = IntUtils::RotFL64(Aso, 56);
+		Ema = Ca ^ ((~Ce) & Ci);
+		Eme = Ce ^ ((~Ci) & Co);
+		Emi = Ci ^ ((~Co) & Cu);
+		Emo = Co ^ ((~Cu) & Ca);
+		Emu = Cu ^ ((~Ca) & Ce);
+		Abi ^= Di;
+		Ca = IntUtils::RotFL64(Abi, 62);
+		Ago ^= Do;
+		Ce = IntUtils::RotFL64(Ago, 55);
+		Aku ^= Du;
+		Ci = IntUtils::RotFL64(Aku, 39);
+		Ama ^= Da;
+		Co = IntUtils::RotFL64(Ama, 41);
+		Ase ^= De;
+		Cu = IntUtils::RotFL64(Ase, 2);
+		Esa = Ca ^ ((~Ce) & Ci);
+		Ese = Ce ^ ((~Ci) & Co);
+		Esi = Ci ^ ((~Co) & Cu);
+		Eso = Co ^ ((~Cu) & Ca);
+		Esu = Cu ^ ((~Ca) & Ce);
+		// round 46
+		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
+		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
+		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
+		Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
+		Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
+		Da = Cu ^ IntUtils::RotFL64(Ce, 1);
+		De = Ca ^ IntUtils::RotFL64(Ci, 1);
+		Di = Ce ^ IntUtils::RotFL64(Co, 1);
+		Do = Ci ^ IntUtils::RotFL64(Cu, 1);
+		Du = Co ^ IntUtils::RotFL64(Ca, 1);
+		Eba ^= Da;
+		Ca = Eba;
+		Ege ^= De;
+		Ce = IntUtils::RotFL64(Ege, 44);
+		Eki ^= Di;
+		Ci = IntUtils::RotFL64(Eki, 43);
+		Emo ^= Do;
+		Co = IntUtils::RotFL64(Emo, 21);
+		Esu ^= Du;
+		Cu = IntUtils::RotFL64(Esu, 14);
+		Aba = Ca ^ ((~Ce) & Ci);
+		Aba ^= 0x8000000080000000ULL;
+		Abe = Ce ^ ((~Ci) & Co);
+		Abi = Ci ^ ((~Co) & Cu);
+		Abo = Co ^ ((~Cu) & Ca);
+		Abu = Cu ^ ((~Ca) & Ce);
+		Ebo ^= Do;
+		Ca = IntUtils::RotFL64(Ebo, 28);
+		Egu ^= Du;
+		Ce = IntUtils::RotFL64(Egu, 20);
+		Eka ^= Da;
+		Ci = IntUtils::RotFL64(Eka, 3);
+		Eme ^= De;
+		Co = IntUtils::RotFL64(Eme, 45);
+		Esi ^= Di;
+		Cu = IntUtils::RotFL64(Esi, 61);
+		Aga = Ca ^ ((~Ce) & Ci);
+		Age = Ce ^ ((~Ci) & Co);
+		Agi = Ci ^ ((~Co) & Cu);
+		Ago = Co ^ ((~Cu) & Ca);
+		Agu = Cu ^ ((~Ca) & Ce);
+		Ebe ^= De;
+		Ca = IntUtils::RotFL64(Ebe, 1);
+		Egi ^= Di;
+		Ce = IntUtils::RotFL64(Egi, 6);
+		Eko ^= Do;
+		Ci = IntUtils::RotFL64(Eko, 25);
+		Emu ^= Du;
+		Co = IntUtils::RotFL64(Emu, 8);
+		Esa ^= Da;
+		Cu = IntUtils::RotFL64(Esa, 18);
+		Aka = Ca ^ ((~Ce) & Ci);
+		Ake = Ce ^ ((~Ci) & Co);
+		Aki = Ci ^ ((~Co) & Cu);
+		Ako = Co ^ ((~Cu) & Ca);
+		Aku = Cu ^ ((~Ca) & Ce);
+		Ebu ^= Du;
+		Ca = IntUtils::RotFL64(Ebu, 27);
+		Ega ^= Da;
+		Ce = IntUtils::RotFL64(Ega, 36);
+		Eke ^= De;
+		Ci = IntUtils::RotFL64(Eke, 10);
+		Emi ^= Di;
+		Co = IntUtils::RotFL64(Emi, 15);
+		Eso ^= Do;
+		Cu = IntUtils::RotFL64(Eso, 56);
+		Ama = Ca ^ ((~Ce) & Ci);
+		Ame = Ce ^ ((~Ci) & Co);
+		Ami = Ci ^ ((~Co) & Cu);
+		Amo = Co ^ ((~Cu) & Ca);
+		Amu = Cu ^ ((~Ca) & Ce);
+		Ebi ^= Di;
+		Ca = IntUtils::RotFL64(Ebi, 62);
+		Ego ^= Do;
+		Ce = IntUtils::RotFL64(Ego, 55);
+		Eku ^= Du;
+		Ci = IntUtils::RotFL64(Eku, 39);
+		Ema ^= Da;
+		Co = IntUtils::RotFL64(Ema, 41);
+		Ese ^= De;
+		Cu = IntUtils::RotFL64(Ese, 2);
+		Asa = Ca ^ ((~Ce) & Ci);
+		Ase = Ce ^ ((~Ci) & Co);
+		Asi = Ci ^ ((~Co) & Cu);
+		Aso = Co ^ ((~Cu) & Ca);
+		Asu = Cu ^ ((~Ca) & Ce);
+		// round 47
+		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+		Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+		Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+		Da = Cu ^ IntUtils::RotFL64(Ce, 1);
+		De = Ca ^ IntUtils::RotFL64(Ci, 1);
+		Di = Ce ^ IntUtils::RotFL64(Co, 1);
+		Do = Ci ^ IntUtils::RotFL64(Cu, 1);
+		Du = Co ^ IntUtils::RotFL64(Ca, 1);
+		Aba ^= Da;
+		Ca = Aba;
+		Age ^= De;
+		Ce = IntUtils::RotFL64(Age, 44);
+		Aki ^= Di;
+		Ci = IntUtils::RotFL64(Aki, 43);
+		Amo ^= Do;
+		Co = IntUtils::RotFL64(Amo, 21);
+		Asu ^= Du;
+		Cu = IntUtils::RotFL64(Asu, 14);
+		Eba = Ca ^ ((~Ce) & Ci);
+		Eba ^= 0x0000000080000080ULL;
+		Ebe = Ce ^ ((~Ci) & Co);
+		Ebi = Ci ^ ((~Co) & Cu);
+		Ebo = Co ^ ((~Cu) & Ca);
+		Ebu = Cu ^ ((~Ca) & Ce);
+		Abo ^= Do;
+		Ca = IntUtils::RotFL64(Abo, 28);
+		Agu ^= Du;
+		Ce = IntUtils::RotFL64(Agu, 20);
+		Aka ^= Da;
+		Ci = IntUtils::RotFL64(Aka, 3);
+		Ame ^= De;
+		Co = IntUtils::RotFL64(Ame, 45);
+		Asi ^= Di;
+		Cu = IntUtils::RotFL64(Asi, 61);
+		Ega = Ca ^ ((~Ce) & Ci);
+		Ege = Ce ^ ((~Ci) & Co);
+		Egi = Ci ^ ((~Co) & Cu);
+		Ego = Co ^ ((~Cu) & Ca);
+		Egu = Cu ^ ((~Ca) & Ce);
+		Abe ^= De;
+		Ca = IntUtils::RotFL64(Abe, 1);
+		Agi ^= Di;
+		Ce = IntUtils::RotFL64(Agi, 6);
+		Ako ^= Do;
+		Ci = IntUtils::RotFL64(Ako, 25);
+		Amu ^= Du;
+		Co = IntUtils::RotFL64(Amu, 8);
+		Asa ^= Da;
+		Cu = IntUtils::RotFL64(Asa, 18);
+		Eka = Ca ^ ((~Ce) & Ci);
+		Eke = Ce ^ ((~Ci) & Co);
+		Eki = Ci ^ ((~Co) & Cu);
+		Eko = Co ^ ((~Cu) & Ca);
+		Eku = Cu ^ ((~Ca) & Ce);
+		Abu ^= Du;
+		Ca = IntUtils::RotFL64(Abu, 27);
+		Aga ^= Da;
+		Ce = IntUtils::RotFL64(Aga, 36);
+		Ake ^= De;
+		Ci = IntUtils::RotFL64(Ake, 10);
+		Ami ^= Di;
+		Co = IntUtils::RotFL64(Ami, 15);
+		Aso ^= Do;
+		Cu = IntUtils::RotFL64(Aso, 56);
+		Ema = Ca ^ ((~Ce) & Ci);
+		Eme = Ce ^ ((~Ci) & Co);
+		Emi = Ci ^ ((~Co) & Cu);
+		Emo = Co ^ ((~Cu) & Ca);
+		Emu = Cu ^ ((~Ca) & Ce);
+		Abi ^= Di;
+		Ca = IntUtils::RotFL64(Abi, 62);
+		Ago ^= Do;
+		Ce = IntUtils::RotFL64(Ago, 55);
+		Aku ^= Du;
+		Ci = IntUtils::RotFL64(Aku, 39);
+		Ama ^= Da;
+		Co = IntUtils::RotFL64(Ama, 41);
+		Ase ^= De;
+		Cu = IntUtils::RotFL64(Ase, 2);
+		Esa = Ca ^ ((~Ce) & Ci);
+		Ese = Ce ^ ((~Ci) & Co);
+		Esi = Ci ^ ((~Co) & Cu);
+		Eso = Co ^ ((~Cu) & Ca);
+		Esu = Cu ^ ((~Ca) & Ce);
+		// round 48
+		Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
+		Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
+		Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
+		Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
+		Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
+		Da = Cu ^ IntUtils::RotFL64(Ce, 1);
+		De = Ca ^ IntUtils::RotFL64(Ci, 1);
+		Di = Ce ^ IntUtils::RotFL64(Co, 1);
+		Do = Ci ^ IntUtils::RotFL64(Cu, 1);
+		Du = Co ^ IntUtils::RotFL64(Ca, 1);
+		Eba ^= Da;
+		Ca = Eba;
+		Ege ^= De;
+		Ce = IntUtils::RotFL64(Ege, 44);
+		Eki ^= Di;
+		Ci = IntUtils::RotFL64(Eki, 43);
+		Emo ^= Do;
+		Co = IntUtils::RotFL64(Emo, 21);
+		Esu ^= Du;
+		Cu = IntUtils::RotFL64(Esu, 14);
+		Aba = Ca ^ ((~Ce) & Ci);
+		Aba ^= 0x0000000080008003ULL;
+		Abe = Ce ^ ((~Ci) & Co);
+		Abi = Ci ^ ((~Co) & Cu);
+		Abo = Co ^ ((~Cu) & Ca);
+		Abu = Cu ^ ((~Ca) & Ce);
+		Ebo ^= Do;
+		Ca = IntUtils::RotFL64(Ebo, 28);
+		Egu ^= Du;
+		Ce = IntUtils::RotFL64(Egu, 20);
+		Eka ^= Da;
+		Ci = IntUtils::RotFL64(Eka, 3);
+		Eme ^= De;
+		Co = IntUtils::RotFL64(Eme, 45);
+		Esi ^= Di;
+		Cu = IntUtils::RotFL64(Esi, 61);
+		Aga = Ca ^ ((~Ce) & Ci);
+		Age = Ce ^ ((~Ci) & Co);
+		Agi = Ci ^ ((~Co) & Cu);
+		Ago = Co ^ ((~Cu) & Ca);
+		Agu = Cu ^ ((~Ca) & Ce);
+		Ebe ^= De;
+		Ca = IntUtils::RotFL64(Ebe, 1);
+		Egi ^= Di;
+		Ce = IntUtils::RotFL64(Egi, 6);
+		Eko ^= Do;
+		Ci = IntUtils::RotFL64(Eko, 25);
+		Emu ^= Du;
+		Co = IntUtils::RotFL64(Emu, 8);
+		Esa ^= Da;
+		Cu = IntUtils::RotFL64(Esa, 18);
+		Aka = Ca ^ ((~Ce) & Ci);
+		Ake = Ce ^ ((~Ci) & Co);
+		Aki = Ci ^ ((~Co) & Cu);
+		Ako = Co ^ ((~Cu) & Ca);
+		Aku = Cu ^ ((~Ca) & Ce);
+		Ebu ^= Du;
+		Ca = IntUtils::RotFL64(Ebu, 27);
+		Ega ^= Da;
+		Ce = IntUtils::RotFL64(Ega, 36);
+		Eke ^= De;
+		Ci = IntUtils::RotFL64(Eke, 10);
+		Emi ^= Di;
+		Co = IntUtils::RotFL64(Emi, 15);
+		Eso ^= Do;
+		Cu = IntUtils::RotFL64(Eso, 56);
+		Ama = Ca ^ ((~Ce) & Ci);
+		Ame = Ce ^ ((~Ci) & Co);
+		Ami = Ci ^ ((~Co) & Cu);
+		Amo = Co ^ ((~Cu) & Ca);
+		Amu = Cu ^ ((~Ca) & Ce);
+		Ebi ^= Di;
+		Ca = IntUtils::RotFL64(Ebi, 62);
+		Ego ^= Do;
+		Ce = IntUtils::RotFL64(Ego, 55);
+		Eku ^= Du;
+		Ci = IntUtils::RotFL64(Eku, 39);
+		Ema ^= Da;
+		Co = IntUtils::RotFL64(Ema, 41);
+		Ese ^= De;
+		Cu = IntUtils::RotFL64(Ese, 2);
+		Asa = Ca ^ ((~Ce) & Ci);
+		Ase = Ce ^ ((~Ci) & Co);
+		Asi = Ci ^ ((~Co) & Cu);
+		Aso = Co ^ ((~Cu) & Ca);
+		Asu = Cu ^ ((~Ca) & Ce);
+
+		State[0] = Aba;
+		State[1] = Abe;
+		State[2] = Abi;
+		State[3] = Abo;
+		State[4] = Abu;
+		State[5] = Aga;
+		State[6] = Age;
+		State[7] = Agi;
+		State[8] = Ago;
+		State[9] = Agu;
+		State[10] = Aka;
+		State[11] = Ake;
+		State[12] = Aki;
+		State[13] = Ako;
+		State[14] = Aku;
+		State[15] = Ama;
+		State[16] = Ame;
+		State[17] = Ami;
+		State[18] = Amo;
+		State[19] = Amu;
+		State[20] = Asa;
+		State[21] = Ase;
+		State[22] = Asi;
+		State[23] = Aso;
+		State[24] = Asu;
+	}
+
+#if defined(__AVX512__)
+
+	template<typename Array>
+	inline static void PermuteR12P12800(std::vector<Array> &State)
+	{
+		ULong512 Aba(State[0][0], State[1][0], State[2][0], State[3][0], State[4][0], State[5][0], State[6][0], State[7][0]);
+		ULong512 Abe(State[0][1], State[1][1], State[2][1], State[3][1], State[4][1], State[5][1], State[6][1], State[7][1]);
+		ULong512 Abi(State[0][2], State[1][2], State[2][2], State[3][2], State[4][2], State[5][2], State[6][2], State[7][2]);
+		ULong512 Abo(State[0][3], State[1][3], State[2][3], State[3][3], State[4][3], State[5][3], State[6][3], State[7][3]);
+		ULong512 Abu(State[0][4], State[1][4], State[2][4], State[3][4], State[4][4], State[5][4], State[6][4], State[7][4]);
+		ULong512 Aga(State[0][5], State[1][5], State[2][5], State[3][5], State[4][5], State[5][5], State[6][5], State[7][5]);
+		ULong512 Age(State[0][6], State[1][6], State[2][6], State[3][6], State[4][6], State[5][6], State[6][6], State[7][6]);
+		ULong512 Agi(State[0][7], State[1][7], State[2][7], State[3][7], State[4][7], State[5][7], State[6][7], State[7][7]);
+		ULong512 Ago(State[0][8], State[1][8], State[2][8], State[3][8], State[4][8], State[5][8], State[6][8], State[7][8]);
+		ULong512 Agu(State[0][9], State[1][9], State[2][9], State[3][9], State[4][9], State[5][9], State[6][9], State[7][9]);
+		ULong512 Aka(State[0][10], State[1][10], State[2][10], State[3][10], State[4][10], State[5][10], State[6][10], State[7][10]);
+		ULong512 Ake(State[0][11], State[1][11], State[2][11], State[3][11], State[4][11], State[5][11], State[6][11], State[7][11]);
+		ULong512 Aki(State[0][12], State[1][12], State[2][12], State[3][12], State[4][12], State[5][12], State[6][12], State[7][12]);
+		ULong512 Ako(State[0][13], State[1][13], State[2][13], State[3][13], State[4][13], State[5][13], State[6][13], State[7][13]);
+		ULong512 Aku(State[0][14], State[1][14], State[2][14], State[3][14], State[4][14], State[5][14], State[6][14], State[7][14]);
+		ULong512 Ama(State[0][15], State[1][15], State[2][15], State[3][15], State[4][15], State[5][15], State[6][15], State[7][15]);
+		ULong512 Ame(State[0][16], State[1][16], State[2][16], State[3][16], State[4][16], State[5][16], State[6][16], State[7][16]);
+		ULong512 Ami(State[0][17], State[1][17], State[2][17], State[3][17], State[4][17], State[5][17], State[6][17], State[7][17]);
+		ULong512 Amo(State[0][18], State[1][18], State[2][18], State[3][18], State[4][18], State[5][18], State[6][18], State[7][18]);
+		ULong512 Amu(State[0][19], State[1][19], State[2][19], State[3][19], State[4][19], State[5][19], State[6][19], State[7][19]);
+		ULong512 Asa(State[0][20], State[1][20], State[2][20], State[3][20], State[4][20], State[5][20], State[6][20], State[7][20]);
+		ULong512 Ase(State[0][21], State[1][21], State[2][21], State[3][21], State[4][21], State[5][21], State[6][21], State[7][21]);
+		ULong512 Asi(State[0][22], State[1][22], State[2][22], State[3][22], State[4][22], State[5][22], State[6][22], State[7][22]);
+		ULong512 Aso(State[0][23], State[1][23], State[2][23], State[3][23], State[4][23], State[5][23], State[6][23], State[7][23]);
+		ULong512 Asu(State[0][24], State[1][24], State[2][24], State[3][24], State[4][24], State[5][24], State[6][24], State[7][24]);
+
+		const static std::array<ULong512, 24> RC24 =
+		{
+			ULong512(0x0000000000000001ULL), ULong512(0x0000000000008082ULL), ULong512(0x800000000000808AULL), ULong512(0x8000000080008000ULL),
+			ULong512(0x000000000000808BULL), ULong512(0x0000000080000001ULL), ULong512(0x8000000080008081ULL), ULong512(0x8000000000008009ULL),
+			ULong512(0x000000000000008AULL), ULong512(0x0000000000000088ULL), ULong512(0x0000000080008009ULL), ULong512(0x000000008000000AULL),
+			ULong512(0x000000008000808BULL), ULong512(0x800000000000008BULL), ULong512(0x8000000000008089ULL), ULong512(0x8000000000008003ULL),
+			ULong512(0x8000000000008002ULL), ULong512(0x8000000000000080ULL), ULong512(0x000000000000800AULL), ULong512(0x800000008000000AULL),
+			ULong512(0x8000000080008081ULL), ULong512(0x8000000000008080ULL), ULong512(0x0000000080000001ULL), ULong512(0x8000000080008008ULL)
+		};
+
+		ULong512 Ca;
+		ULong512 Ce;
+		ULong512 Ci;
+		ULong512 Co;
+		ULong512 Cu;
+		ULong512 Da;
+		ULong512 De;
+		ULong512 Di;
+		ULong512 Do;
+		ULong512 Du;
+		ULong512 Eba;
+		ULong512 Ebe;
+		ULong512 Ebi;
+		ULong512 Ebo;
+		ULong512 Ebu;
+		ULong512 Ega;
+		ULong512 Ege;
+		ULong512 Egi;
+		ULong512 Ego;
+		ULong512 Egu;
+		ULong512 Eka;
+		ULong512 Eke;
+		ULong512 Eki;
+		ULong512 Eko;
+		ULong512 Eku;
+		ULong512 Ema;
+		ULong512 Eme;
+		ULong512 Emi;
+		ULong512 Emo;
+		ULong512 Emu;
+		ULong512 Esa;
+		ULong512 Ese;
+		ULong512 Esi;
+		ULong512 Eso;
+		ULong512 Esu;
+
+		for (size_t i = 12; i < 24; i += 2)
+		{
+			// round n
+			Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+			Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+			Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+			Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+			Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+			Da = Cu ^ ULong512::RotL64(Ce, 1);
+			De = Ca ^ ULong512::RotL64(Ci, 1);
+			Di = Ce ^ ULong512::RotL64(Co, 1);
+			Do = Ci ^ ULong512::RotL64(Cu, 1);
+			Du = Co ^ ULong512::RotL64(Ca, 1);
+			Aba ^= Da;
+			Ca = Aba;
+			Age ^= De;
+			Ce = ULong512::RotL64(Age, 44);
+			Aki ^= Di;
+			Ci = ULong512::RotL64(Aki, 43);
+			Amo ^= Do;
+			Co = ULong512::RotL64(Amo, 21);
+			Asu ^= Du;
+			Cu = ULong512::RotL64(Asu, 14);
+			Eba = Ca ^ ((~Ce) & Ci);
+			Eba ^= RC24[i];
+			Ebe = Ce ^ ((~Ci) & Co);
+			Ebi = Ci ^ ((~Co) & Cu);
+			Ebo = Co ^ ((~Cu) & Ca);
+			Ebu = Cu ^ ((~Ca) & Ce);
+			Abo ^= Do;
+			Ca = ULong512::RotL64(Abo, 28);
+			Agu ^= Du;
+			Ce = ULong512::RotL64(Agu, 20);
+			Aka ^= Da;
+			Ci = ULong512::RotL64(Aka, 3);
+			Ame ^= De;
+			Co = ULong512::RotL64(Ame, 45);
+			Asi ^= Di;
+			Cu = ULong512::RotL64(Asi, 61);
+			Ega = Ca ^ ((~Ce) & Ci);
+			Ege = Ce ^ ((~Ci) & Co);
+			Egi = Ci ^ ((~Co) & Cu);
+			Ego = Co ^ ((~Cu) & Ca);
+			Egu = Cu ^ ((~Ca) & Ce);
+			Abe ^= De;
+			Ca = ULong512::RotL64(Abe, 1);
+			Agi ^= Di;
+			Ce = ULong512::RotL64(Agi, 6);
+			Ako ^= Do;
+			Ci = ULong512::RotL64(Ako, 25);
+			Amu ^= Du;
+			Co = ULong512::RotL64(Amu, 8);
+			Asa ^= Da;
+			Cu = ULong512::RotL64(Asa, 18);
+			Eka = Ca ^ ((~Ce) & Ci);
+			Eke = Ce ^ ((~Ci) & Co);
+			Eki = Ci ^ ((~Co) & Cu);
+			Eko = Co ^ ((~Cu) & Ca);
+			Eku = Cu ^ ((~Ca) & Ce);
+			Abu ^= Du;
+			Ca = ULong512::RotL64(Abu, 27);
+			Aga ^= Da;
+			Ce = ULong512::RotL64(Aga, 36);
+			Ake ^= De;
+			Ci = ULong512::RotL64(Ake, 10);
+			Ami ^= Di;
+			Co = ULong512::RotL64(Ami, 15);
+			Aso ^= Do;
+			Cu = ULong512::RotL64(Aso, 56);
+			Ema = Ca ^ ((~Ce) & Ci);
+			Eme = Ce ^ ((~Ci) & Co);
+			Emi = Ci ^ ((~Co) & Cu);
+			Emo = Co ^ ((~Cu) & Ca);
+			Emu = Cu ^ ((~Ca) & Ce);
+			Abi ^= Di;
+			Ca = ULong512::RotL64(Abi, 62);
+			Ago ^= Do;
+			Ce = ULong512::RotL64(Ago, 55);
+			Aku ^= Du;
+			Ci = ULong512::RotL64(Aku, 39);
+			Ama ^= Da;
+			Co = ULong512::RotL64(Ama, 41);
+			Ase ^= De;
+			Cu = ULong512::RotL64(Ase, 2);
+			Esa = Ca ^ ((~Ce) & Ci);
+			Ese = Ce ^ ((~Ci) & Co);
+			Esi = Ci ^ ((~Co) & Cu);
+			Eso = Co ^ ((~Cu) & Ca);
+			Esu = Cu ^ ((~Ca) & Ce);
+			// round n + 1
+			Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
+			Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
+			Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
+			Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
+			Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
+			Da = Cu ^ ULong512::RotL64(Ce, 1);
+			De = Ca ^ ULong512::RotL64(Ci, 1);
+			Di = Ce ^ ULong512::RotL64(Co, 1);
+			Do = Ci ^ ULong512::RotL64(Cu, 1);
+			Du = Co ^ ULong512::RotL64(Ca, 1);
+			Eba ^= Da;
+			Ca = Eba;
+			Ege ^= De;
+			Ce = ULong512::RotL64(Ege, 44);
+			Eki ^= Di;
+			Ci = ULong512::RotL64(Eki, 43);
+			Emo ^= Do;
+			Co = ULong512::RotL64(Emo, 21);
+			Esu ^= Du;
+			Cu = ULong512::RotL64(Esu, 14);
+			Aba = Ca ^ ((~Ce) & Ci);
+			Aba ^= RC24[i + 1];
+			Abe = Ce ^ ((~Ci) & Co);
+			Abi = Ci ^ ((~Co) & Cu);
+			Abo = Co ^ ((~Cu) & Ca);
+			Abu = Cu ^ ((~Ca) & Ce);
+			Ebo ^= Do;
+			Ca = ULong512::RotL64(Ebo, 28);
+			Egu ^= Du;
+			Ce = ULong512::RotL64(Egu, 20);
+			Eka ^= Da;
+			Ci = ULong512::RotL64(Eka, 3);
+			Eme ^= De;
+			Co = ULong512::RotL64(Eme, 45);
+			Esi ^= Di;
+			Cu = ULong512::RotL64(Esi, 61);
+			Aga = Ca ^ ((~Ce) & Ci);
+			Age = Ce ^ ((~Ci) & Co);
+			Agi = Ci ^ ((~Co) & Cu);
+			Ago = Co ^ ((~Cu) & Ca);
+			Agu = Cu ^ ((~Ca) & Ce);
+			Ebe ^= De;
+			Ca = ULong512::RotL64(Ebe, 1);
+			Egi ^= Di;
+			Ce = ULong512::RotL64(Egi, 6);
+			Eko ^= Do;
+			Ci = ULong512::RotL64(Eko, 25);
+			Emu ^= Du;
+			Co = ULong512::RotL64(Emu, 8);
+			Esa ^= Da;
+			Cu = ULong512::RotL64(Esa, 18);
+			Aka = Ca ^ ((~Ce) & Ci);
+			Ake = Ce ^ ((~Ci) & Co);
+			Aki = Ci ^ ((~Co) & Cu);
+			Ako = Co ^ ((~Cu) & Ca);
+			Aku = Cu ^ ((~Ca) & Ce);
+			Ebu ^= Du;
+			Ca = ULong512::RotL64(Ebu, 27);
+			Ega ^= Da;
+			Ce = ULong512::RotL64(Ega, 36);
+			Eke ^= De;
+			Ci = ULong512::RotL64(Eke, 10);
+			Emi ^= Di;
+			Co = ULong512::RotL64(Emi, 15);
+			Eso ^= Do;
+			Cu = ULong512::RotL64(Eso, 56);
+			Ama = Ca ^ ((~Ce) & Ci);
+			Ame = Ce ^ ((~Ci) & Co);
+			Ami = Ci ^ ((~Co) & Cu);
+			Amo = Co ^ ((~Cu) & Ca);
+			Amu = Cu ^ ((~Ca) & Ce);
+			Ebi ^= Di;
+			Ca = ULong512::RotL64(Ebi, 62);
+			Ego ^= Do;
+			Ce = ULong512::RotL64(Ego, 55);
+			Eku ^= Du;
+			Ci = ULong512::RotL64(Eku, 39);
+			Ema ^= Da;
+			Co = ULong512::RotL64(Ema, 41);
+			Ese ^= De;
+			Cu = ULong512::RotL64(Ese, 2);
+			Asa = Ca ^ ((~Ce) & Ci);
+			Ase = Ce ^ ((~Ci) & Co);
+			Asi = Ci ^ ((~Co) & Cu);
+			Aso = Co ^ ((~Cu) & Ca);
+			Asu = Cu ^ ((~Ca) & Ce);
+		}
+
+		Aba.Store(State[0][0], State[1][0], State[2][0], State[3][0], State[4][0], State[5][0], State[6][0], State[7][0]);
+		Abe.Store(State[0][1], State[1][1], State[2][1], State[3][1], State[4][1], State[5][1], State[6][1], State[7][1]);
+		Abi.Store(State[0][2], State[1][2], State[2][2], State[3][2], State[4][2], State[5][2], State[6][2], State[7][2]);
+		Abo.Store(State[0][3], State[1][3], State[2][3], State[3][3], State[4][3], State[5][3], State[6][3], State[7][3]);
+		Abu.Store(State[0][4], State[1][4], State[2][4], State[3][4], State[4][4], State[5][4], State[6][4], State[7][4]);
+		Aga.Store(State[0][5], State[1][5], State[2][5], State[3][5], State[4][5], State[5][5], State[6][5], State[7][5]);
+		Age.Store(State[0][6], State[1][6], State[2][6], State[3][6], State[4][6], State[5][6], State[6][6], State[7][6]);
+		Agi.Store(State[0][7], State[1][7], State[2][7], State[3][7], State[4][7], State[5][7], State[6][7], State[7][7]);
+		Ago.Store(State[0][8], State[1][8], State[2][8], State[3][8], State[4][8], State[5][8], State[6][8], State[7][8]);
+		Agu.Store(State[0][9], State[1][9], State[2][9], State[3][9], State[4][9], State[5][9], State[6][9], State[7][9]);
+		Aka.Store(State[0][10], State[1][10], State[2][10], State[3][10], State[4][10], State[5][10], State[6][10], State[7][10]);
+		Ake.Store(State[0][11], State[1][11], State[2][11], State[3][11], State[4][11], State[5][11], State[6][11], State[7][11]);
+		Aki.Store(State[0][12], State[1][12], State[2][12], State[3][12], State[4][12], State[5][12], State[6][12], State[7][12]);
+		Ako.Store(State[0][13], State[1][13], State[2][13], State[3][13], State[4][13], State[5][13], State[6][13], State[7][13]);
+		Aku.Store(State[0][14], State[1][14], State[2][14], State[3][14], State[4][14], State[5][14], State[6][14], State[7][14]);
+		Ama.Store(State[0][15], State[1][15], State[2][15], State[3][15], State[4][15], State[5][15], State[6][15], State[7][15]);
+		Ame.Store(State[0][16], State[1][16], State[2][16], State[3][16], State[4][16], State[5][16], State[6][16], State[7][16]);
+		Ami.Store(State[0][17], State[1][17], State[2][17], State[3][17], State[4][17], State[5][17], State[6][17], State[7][17]);
+		Amo.Store(State[0][18], State[1][18], State[2][18], State[3][18], State[4][18], State[5][18], State[6][18], State[7][18]);
+		Amu.Store(State[0][19], State[1][19], State[2][19], State[3][19], State[4][19], State[5][19], State[6][19], State[7][19]);
+		Asa.Store(State[0][20], State[1][20], State[2][20], State[3][20], State[4][20], State[5][20], State[6][20], State[7][20]);
+		Ase.Store(State[0][21], State[1][21], State[2][21], State[3][21], State[4][21], State[5][21], State[6][21], State[7][21]);
+		Asi.Store(State[0][22], State[1][22], State[2][22], State[3][22], State[4][22], State[5][22], State[6][22], State[7][22]);
+		Aso.Store(State[0][23], State[1][23], State[2][23], State[3][23], State[4][23], State[5][23], State[6][23], State[7][23]);
+		Asu.Store(State[0][24], State[1][24], State[2][24], State[3][24], State[4][24], State[5][24], State[6][24], State[7][24]);
+	}
+
+	template<typename Array, typename Allocator>
+	inline static void PermuteR24P12800(std::vector<Array, Allocator> &State)
+	{
+		ULong512 Aba(State[0][0], State[1][0], State[2][0], State[3][0], State[4][0], State[5][0], State[6][0], State[7][0]);
+		ULong512 Abe(State[0][1], State[1][1], State[2][1], State[3][1], State[4][1], State[5][1], State[6][1], State[7][1]);
+		ULong512 Abi(State[0][2], State[1][2], State[2][2], State[3][2], State[4][2], State[5][2], State[6][2], State[7][2]);
+		ULong512 Abo(State[0][3], State[1][3], State[2][3], State[3][3], State[4][3], State[5][3], State[6][3], State[7][3]);
+		ULong512 Abu(State[0][4], State[1][4], State[2][4], State[3][4], State[4][4], State[5][4], State[6][4], State[7][4]);
+		ULong512 Aga(State[0][5], State[1][5], State[2][5], State[3][5], State[4][5], State[5][5], State[6][5], State[7][5]);
+		ULong512 Age(State[0][6], State[1][6], State[2][6], State[3][6], State[4][6], State[5][6], State[6][6], State[7][6]);
+		ULong512 Agi(State[0][7], State[1][7], State[2][7], State[3][7], State[4][7], State[5][7], State[6][7], State[7][7]);
+		ULong512 Ago(State[0][8], State[1][8], State[2][8], State[3][8], State[4][8], State[5][8], State[6][8], State[7][8]);
+		ULong512 Agu(State[0][9], State[1][9], State[2][9], State[3][9], State[4][9], State[5][9], State[6][9], State[7][9]);
+		ULong512 Aka(State[0][10], State[1][10], State[2][10], State[3][10], State[4][10], State[5][10], State[6][10], State[7][10]);
+		ULong512 Ake(State[0][11], State[1][11], State[2][11], State[3][11], State[4][11], State[5][11], State[6][11], State[7][11]);
+		ULong512 Aki(State[0][12], State[1][12], State[2][12], State[3][12], State[4][12], State[5][12], State[6][12], State[7][12]);
+		ULong512 Ako(State[0][13], State[1][13], State[2][13], State[3][13], State[4][13], State[5][13], State[6][13], State[7][13]);
+		ULong512 Aku(State[0][14], State[1][14], State[2][14], State[3][14], State[4][14], State[5][14], State[6][14], State[7][14]);
+		ULong512 Ama(State[0][15], State[1][15], State[2][15], State[3][15], State[4][15], State[5][15], State[6][15], State[7][15]);
+		ULong512 Ame(State[0][16], State[1][16], State[2][16], State[3][16], State[4][16], State[5][16], State[6][16], State[7][16]);
+		ULong512 Ami(State[0][17], State[1][17], State[2][17], State[3][17], State[4][17], State[5][17], State[6][17], State[7][17]);
+		ULong512 Amo(State[0][18], State[1][18], State[2][18], State[3][18], State[4][18], State[5][18], State[6][18], State[7][18]);
+		ULong512 Amu(State[0][19], State[1][19], State[2][19], State[3][19], State[4][19], State[5][19], State[6][19], State[7][19]);
+		ULong512 Asa(State[0][20], State[1][20], State[2][20], State[3][20], State[4][20], State[5][20], State[6][20], State[7][20]);
+		ULong512 Ase(State[0][21], State[1][21], State[2][21], State[3][21], State[4][21], State[5][21], State[6][21], State[7][21]);
+		ULong512 Asi(State[0][22], State[1][22], State[2][22], State[3][22], State[4][22], State[5][22], State[6][22], State[7][22]);
+		ULong512 Aso(State[0][23], State[1][23], State[2][23], State[3][23], State[4][23], State[5][23], State[6][23], State[7][23]);
+		ULong512 Asu(State[0][24], State[1][24], State[2][24], State[3][24], State[4][24], State[5][24], State[6][24], State[7][24]);
+
+		const static std::array<ULong512, 24> RC24 =
+		{
+			ULong512(0x0000000000000001ULL), ULong512(0x0000000000008082ULL), ULong512(0x800000000000808AULL), ULong512(0x8000000080008000ULL),
+			ULong512(0x000000000000808BULL), ULong512(0x0000000080000001ULL), ULong512(0x8000000080008081ULL), ULong512(0x8000000000008009ULL),
+			ULong512(0x000000000000008AULL), ULong512(0x0000000000000088ULL), ULong512(0x0000000080008009ULL), ULong512(0x000000008000000AULL),
+			ULong512(0x000000008000808BULL), ULong512(0x800000000000008BULL), ULong512(0x8000000000008089ULL), ULong512(0x8000000000008003ULL),
+			ULong512(0x8000000000008002ULL), ULong512(0x8000000000000080ULL), ULong512(0x000000000000800AULL), ULong512(0x800000008000000AULL),
+			ULong512(0x8000000080008081ULL), ULong512(0x8000000000008080ULL), ULong512(0x0000000080000001ULL), ULong512(0x8000000080008008ULL)
+		};
+
+		ULong512 Ca;
+		ULong512 Ce;
+		ULong512 Ci;
+		ULong512 Co;
+		ULong512 Cu;
+		ULong512 Da;
+		ULong512 De;
+		ULong512 Di;
+		ULong512 Do;
+		ULong512 Du;
+		ULong512 Eba;
+		ULong512 Ebe;
+		ULong512 Ebi;
+		ULong512 Ebo;
+		ULong512 Ebu;
+		ULong512 Ega;
+		ULong512 Ege;
+		ULong512 Egi;
+		ULong512 Ego;
+		ULong512 Egu;
+		ULong512 Eka;
+		ULong512 Eke;
+		ULong512 Eki;
+		ULong512 Eko;
+		ULong512 Eku;
+		ULong512 Ema;
+		ULong512 Eme;
+		ULong512 Emi;
+		ULong512 Emo;
+		ULong512 Emu;
+		ULong512 Esa;
+		ULong512 Ese;
+		ULong512 Esi;
+		ULong512 Eso;
+		ULong512 Esu;
+
+		for (size_t i = 0; i < 24; i += 2)
+		{
+			// round n
+			Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+			Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+			Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+			Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+			Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+			Da = Cu ^ ULong512::RotL64(Ce, 1);
+			De = Ca ^ ULong512::RotL64(Ci, 1);
+			Di = Ce ^ ULong512::RotL64(Co, 1);
+			Do = Ci ^ ULong512::RotL64(Cu, 1);
+			Du = Co ^ ULong512::RotL64(Ca, 1);
+			Aba ^= Da;
+			Ca = Aba;
+			Age ^= De;
+			Ce = ULong512::RotL64(Age, 44);
+			Aki ^= Di;
+			Ci = ULong512::RotL64(Aki, 43);
+			Amo ^= Do;
+			Co = ULong512::RotL64(Amo, 21);
+			Asu ^= Du;
+			Cu = ULong512::RotL64(Asu, 14);
+			Eba = Ca ^ ((~Ce) & Ci);
+			Eba ^= RC24[i];
+			Ebe = Ce ^ ((~Ci) & Co);
+			Ebi = Ci ^ ((~Co) & Cu);
+			Ebo = Co ^ ((~Cu) & Ca);
+			Ebu = Cu ^ ((~Ca) & Ce);
+			Abo ^= Do;
+			Ca = ULong512::RotL64(Abo, 28);
+			Agu ^= Du;
+			Ce = ULong512::RotL64(Agu, 20);
+			Aka ^= Da;
+			Ci = ULong512::RotL64(Aka, 3);
+			Ame ^= De;
+			Co = ULong512::RotL64(Ame, 45);
+			Asi ^= Di;
+			Cu = ULong512::RotL64(Asi, 61);
+			Ega = Ca ^ ((~Ce) & Ci);
+			Ege = Ce ^ ((~Ci) & Co);
+			Egi = Ci ^ ((~Co) & Cu);
+			Ego = Co ^ ((~Cu) & Ca);
+			Egu = Cu ^ ((~Ca) & Ce);
+			Abe ^= De;
+			Ca = ULong512::RotL64(Abe, 1);
+			Agi ^= Di;
+			Ce = ULong512::RotL64(Agi, 6);
+			Ako ^= Do;
+			Ci = ULong512::RotL64(Ako, 25);
+			Amu ^= Du;
+			Co = ULong512::RotL64(Amu, 8);
+			Asa ^= Da;
+			Cu = ULong512::RotL64(Asa, 18);
+			Eka = Ca ^ ((~Ce) & Ci);
+			Eke = Ce ^ ((~Ci) & Co);
+			Eki = Ci ^ ((~Co) & Cu);
+			Eko = Co ^ ((~Cu) & Ca);
+			Eku = Cu ^ ((~Ca) & Ce);
+			Abu ^= Du;
+			Ca = ULong512::RotL64(Abu, 27);
+			Aga ^= Da;
+			Ce = ULong512::RotL64(Aga, 36);
+			Ake ^= De;
+			Ci = ULong512::RotL64(Ake, 10);
+			Ami ^= Di;
+			Co = ULong512::RotL64(Ami, 15);
+			Aso ^= Do;
+			Cu = ULong512::RotL64(Aso, 56);
+			Ema = Ca ^ ((~Ce) & Ci);
+			Eme = Ce ^ ((~Ci) & Co);
+			Emi = Ci ^ ((~Co) & Cu);
+			Emo = Co ^ ((~Cu) & Ca);
+			Emu = Cu ^ ((~Ca) & Ce);
+			Abi ^= Di;
+			Ca = ULong512::RotL64(Abi, 62);
+			Ago ^= Do;
+			Ce = ULong512::RotL64(Ago, 55);
+			Aku ^= Du;
+			Ci = ULong512::RotL64(Aku, 39);
+			Ama ^= Da;
+			Co = ULong512::RotL64(Ama, 41);
+			Ase ^= De;
+			Cu = ULong512::RotL64(Ase, 2);
+			Esa = Ca ^ ((~Ce) & Ci);
+			Ese = Ce ^ ((~Ci) & Co);
+			Esi = Ci ^ ((~Co) & Cu);
+			Eso = Co ^ ((~Cu) & Ca);
+			Esu = Cu ^ ((~Ca) & Ce);
+			// round n + 1
+			Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
+			Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
+			Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
+			Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
+			Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
+			Da = Cu ^ ULong512::RotL64(Ce, 1);
+			De = Ca ^ ULong512::RotL64(Ci, 1);
+			Di = Ce ^ ULong512::RotL64(Co, 1);
+			Do = Ci ^ ULong512::RotL64(Cu, 1);
+			Du = Co ^ ULong512::RotL64(Ca, 1);
+			Eba ^= Da;
+			Ca = Eba;
+			Ege ^= De;
+			Ce = ULong512::RotL64(Ege, 44);
+			Eki ^= Di;
+			Ci = ULong512::RotL64(Eki, 43);
+			Emo ^= Do;
+			Co = ULong512::RotL64(Emo, 21);
+			Esu ^= Du;
+			Cu = ULong512::RotL64(Esu, 14);
+			Aba = Ca ^ ((~Ce) & Ci);
+			Aba ^= RC24[i + 1];
+			Abe = Ce ^ ((~Ci) & Co);
+			Abi = Ci ^ ((~Co) & Cu);
+			Abo = Co ^ ((~Cu) & Ca);
+			Abu = Cu ^ ((~Ca) & Ce);
+			Ebo ^= Do;
+			Ca = ULong512::RotL64(Ebo, 28);
+			Egu ^= Du;
+			Ce = ULong512::RotL64(Egu, 20);
+			Eka ^= Da;
+			Ci = ULong512::RotL64(Eka, 3);
+			Eme ^= De;
+			Co = ULong512::RotL64(Eme, 45);
+			Esi ^= Di;
+			Cu = ULong512::RotL64(Esi, 61);
+			Aga = Ca ^ ((~Ce) & Ci);
+			Age = Ce ^ ((~Ci) & Co);
+			Agi = Ci ^ ((~Co) & Cu);
+			Ago = Co ^ ((~Cu) & Ca);
+			Agu = Cu ^ ((~Ca) & Ce);
+			Ebe ^= De;
+			Ca = ULong512::RotL64(Ebe, 1);
+			Egi ^= Di;
+			Ce = ULong512::RotL64(Egi, 6);
+			Eko ^= Do;
+			Ci = ULong512::RotL64(Eko, 25);
+			Emu ^= Du;
+			Co = ULong512::RotL64(Emu, 8);
+			Esa ^= Da;
+			Cu = ULong512::RotL64(Esa, 18);
+			Aka = Ca ^ ((~Ce) & Ci);
+			Ake = Ce ^ ((~Ci) & Co);
+			Aki = Ci ^ ((~Co) & Cu);
+			Ako = Co ^ ((~Cu) & Ca);
+			Aku = Cu ^ ((~Ca) & Ce);
+			Ebu ^= Du;
+			Ca = ULong512::RotL64(Ebu, 27);
+			Ega ^= Da;
+			Ce = ULong512::RotL64(Ega, 36);
+			Eke ^= De;
+			Ci = ULong512::RotL64(Eke, 10);
+			Emi ^= Di;
+			Co = ULong512::RotL64(Emi, 15);
+			Eso ^= Do;
+			Cu = ULong512::RotL64(Eso, 56);
+			Ama = Ca ^ ((~Ce) & Ci);
+			Ame = Ce ^ ((~Ci) & Co);
+			Ami = Ci ^ ((~Co) & Cu);
+			Amo = Co ^ ((~Cu) & Ca);
+			Amu = Cu ^ ((~Ca) & Ce);
+			Ebi ^= Di;
+			Ca = ULong512::RotL64(Ebi, 62);
+			Ego ^= Do;
+			Ce = ULong512::RotL64(Ego, 55);
+			Eku ^= Du;
+			Ci = ULong512::RotL64(Eku, 39);
+			Ema ^= Da;
+			Co = ULong512::RotL64(Ema, 41);
+			Ese ^= De;
+			Cu = ULong512::RotL64(Ese, 2);
+			Asa = Ca ^ ((~Ce) & Ci);
+			Ase = Ce ^ ((~Ci) & Co);
+			Asi = Ci ^ ((~Co) & Cu);
+			Aso = Co ^ ((~Cu) & Ca);
+			Asu = Cu ^ ((~Ca) & Ce);
+		}
+
+		Aba.Store(State[0][0], State[1][0], State[2][0], State[3][0], State[4][0], State[5][0], State[6][0], State[7][0]);
+		Abe.Store(State[0][1], State[1][1], State[2][1], State[3][1], State[4][1], State[5][1], State[6][1], State[7][1]);
+		Abi.Store(State[0][2], State[1][2], State[2][2], State[3][2], State[4][2], State[5][2], State[6][2], State[7][2]);
+		Abo.Store(State[0][3], State[1][3], State[2][3], State[3][3], State[4][3], State[5][3], State[6][3], State[7][3]);
+		Abu.Store(State[0][4], State[1][4], State[2][4], State[3][4], State[4][4], State[5][4], State[6][4], State[7][4]);
+		Aga.Store(State[0][5], State[1][5], State[2][5], State[3][5], State[4][5], State[5][5], State[6][5], State[7][5]);
+		Age.Store(State[0][6], State[1][6], State[2][6], State[3][6], State[4][6], State[5][6], State[6][6], State[7][6]);
+		Agi.Store(State[0][7], State[1][7], State[2][7], State[3][7], State[4][7], State[5][7], State[6][7], State[7][7]);
+		Ago.Store(State[0][8], State[1][8], State[2][8], State[3][8], State[4][8], State[5][8], State[6][8], State[7][8]);
+		Agu.Store(State[0][9], State[1][9], State[2][9], State[3][9], State[4][9], State[5][9], State[6][9], State[7][9]);
+		Aka.Store(State[0][10], State[1][10], State[2][10], State[3][10], State[4][10], State[5][10], State[6][10], State[7][10]);
+		Ake.Store(State[0][11], State[1][11], State[2][11], State[3][11], State[4][11], State[5][11], State[6][11], State[7][11]);
+		Aki.Store(State[0][12], State[1][12], State[2][12], State[3][12], State[4][12], State[5][12], State[6][12], State[7][12]);
+		Ako.Store(State[0][13], State[1][13], State[2][13], State[3][13], State[4][13], State[5][13], State[6][13], State[7][13]);
+		Aku.Store(State[0][14], State[1][14], State[2][14], State[3][14], State[4][14], State[5][14], State[6][14], State[7][14]);
+		Ama.Store(State[0][15], State[1][15], State[2][15], State[3][15], State[4][15], State[5][15], State[6][15], State[7][15]);
+		Ame.Store(State[0][16], State[1][16], State[2][16], State[3][16], State[4][16], State[5][16], State[6][16], State[7][16]);
+		Ami.Store(State[0][17], State[1][17], State[2][17], State[3][17], State[4][17], State[5][17], State[6][17], State[7][17]);
+		Amo.Store(State[0][18], State[1][18], State[2][18], State[3][18], State[4][18], State[5][18], State[6][18], State[7][18]);
+		Amu.Store(State[0][19], State[1][19], State[2][19], State[3][19], State[4][19], State[5][19], State[6][19], State[7][19]);
+		Asa.Store(State[0][20], State[1][20], State[2][20], State[3][20], State[4][20], State[5][20], State[6][20], State[7][20]);
+		Ase.Store(State[0][21], State[1][21], State[2][21], State[3][21], State[4][21], State[5][21], State[6][21], State[7][21]);
+		Asi.Store(State[0][22], State[1][22], State[2][22], State[3][22], State[4][22], State[5][22], State[6][22], State[7][22]);
+		Aso.Store(State[0][23], State[1][23], State[2][23], State[3][23], State[4][23], State[5][23], State[6][23], State[7][23]);
+		Asu.Store(State[0][24], State[1][24], State[2][24], State[3][24], State[4][24], State[5][24], State[6][24], State[7][24]);
+	}
+
+	template<typename Array, typename Allocator>
+	inline static void PermuteR48P12800(std::vector<Array, Allocator> &State)
+	{
+		ULong512 Aba(State[0][0], State[1][0], State[2][0], State[3][0], State[4][0], State[5][0], State[6][0], State[7][0]);
+		ULong512 Abe(State[0][1], State[1][1], State[2][1], State[3][1], State[4][1], State[5][1], State[6][1], State[7][1]);
+		ULong512 Abi(State[0][2], State[1][2], State[2][2], State[3][2], State[4][2], State[5][2], State[6][2], State[7][2]);
+		ULong512 Abo(State[0][3], State[1][3], State[2][3], State[3][3], State[4][3], State[5][3], State[6][3], State[7][3]);
+		ULong512 Abu(State[0][4], State[1][4], State[2][4], State[3][4], State[4][4], State[5][4], State[6][4], State[7][4]);
+		ULong512 Aga(State[0][5], State[1][5], State[2][5], State[3][5], State[4][5], State[5][5], State[6][5], State[7][5]);
+		ULong512 Age(State[0][6], State[1][6], State[2][6], State[3][6], State[4][6], State[5][6], State[6][6], State[7][6]);
+		ULong512 Agi(State[0][7], State[1][7], State[2][7], State[3][7], State[4][7], State[5][7], State[6][7], State[7][7]);
+		ULong512 Ago(State[0][8], State[1][8], State[2][8], State[3][8], State[4][8], State[5][8], State[6][8], State[7][8]);
+		ULong512 Agu(State[0][9], State[1][9], State[2][9], State[3][9], State[4][9], State[5][9], State[6][9], State[7][9]);
+		ULong512 Aka(State[0][10], State[1][10], State[2][10], State[3][10], State[4][10], State[5][10], State[6][10], State[7][10]);
+		ULong512 Ake(State[0][11], State[1][11], State[2][11], State[3][11], State[4][11], State[5][11], State[6][11], State[7][11]);
+		ULong512 Aki(State[0][12], State[1][12], State[2][12], State[3][12], State[4][12], State[5][12], State[6][12], State[7][12]);
+		ULong512 Ako(State[0][13], State[1][13], State[2][13], State[3][13], State[4][13], State[5][13], State[6][13], State[7][13]);
+		ULong512 Aku(State[0][14], State[1][14], State[2][14], State[3][14], State[4][14], State[5][14], State[6][14], State[7][14]);
+		ULong512 Ama(State[0][15], State[1][15], State[2][15], State[3][15], State[4][15], State[5][15], State[6][15], State[7][15]);
+		ULong512 Ame(State[0][16], State[1][16], State[2][16], State[3][16], State[4][16], State[5][16], State[6][16], State[7][16]);
+		ULong512 Ami(State[0][17], State[1][17], State[2][17], State[3][17], State[4][17], State[5][17], State[6][17], State[7][17]);
+		ULong512 Amo(State[0][18], State[1][18], State[2][18], State[3][18], State[4][18], State[5][18], State[6][18], State[7][18]);
+		ULong512 Amu(State[0][19], State[1][19], State[2][19], State[3][19], State[4][19], State[5][19], State[6][19], State[7][19]);
+		ULong512 Asa(State[0][20], State[1][20], State[2][20], State[3][20], State[4][20], State[5][20], State[6][20], State[7][20]);
+		ULong512 Ase(State[0][21], State[1][21], State[2][21], State[3][21], State[4][21], State[5][21], State[6][21], State[7][21]);
+		ULong512 Asi(State[0][22], State[1][22], State[2][22], State[3][22], State[4][22], State[5][22], State[6][22], State[7][22]);
+		ULong512 Aso(State[0][23], State[1][23], State[2][23], State[3][23], State[4][23], State[5][23], State[6][23], State[7][23]);
+		ULong512 Asu(State[0][24], State[1][24], State[2][24], State[3][24], State[4][24], State[5][24], State[6][24], State[7][24]);
+
+		const static std::array<ULong512, 48> RC48 =
+		{
+			ULong512(0x0000000000000001ULL), ULong512(0x0000000000008082ULL), ULong512(0x800000000000808AULL), ULong512(0x8000000080008000ULL),
+			ULong512(0x000000000000808BULL), ULong512(0x0000000080000001ULL), ULong512(0x8000000080008081ULL), ULong512(0x8000000000008009ULL),
+			ULong512(0x000000000000008AULL), ULong512(0x0000000000000088ULL), ULong512(0x0000000080008009ULL), ULong512(0x000000008000000AULL),
+			ULong512(0x000000008000808BULL), ULong512(0x800000000000008BULL), ULong512(0x8000000000008089ULL), ULong512(0x8000000000008003ULL),
+			ULong512(0x8000000000008002ULL), ULong512(0x8000000000000080ULL), ULong512(0x000000000000800AULL), ULong512(0x800000008000000AULL),
+			ULong512(0x8000000080008081ULL), ULong512(0x8000000000008080ULL), ULong512(0x0000000080000001ULL), ULong512(0x8000000080008008ULL),
+			ULong512(0x8000000080008082ULL), ULong512(0x800000008000800AULL), ULong512(0x8000000000000003ULL), ULong512(0x8000000080000009ULL),
+			ULong512(0x8000000000008082ULL), ULong512(0x0000000000008009ULL), ULong512(0x8000000000000080ULL), ULong512(0x0000000000008083ULL),
+			ULong512(0x8000000000000081ULL), ULong512(0x0000000000000001ULL), ULong512(0x000000000000800BULL), ULong512(0x8000000080008001ULL),
+			ULong512(0x0000000000000080ULL), ULong512(0x8000000000008000ULL), ULong512(0x8000000080008001ULL), ULong512(0x0000000000000009ULL),
+			ULong512(0x800000008000808BULL), ULong512(0x0000000000000081ULL), ULong512(0x8000000000000082ULL), ULong512(0x000000008000008BULL),
+			ULong512(0x8000000080008009ULL), ULong512(0x8000000080000000ULL), ULong512(0x0000000080000080ULL), ULong512(0x0000000080008003ULL)
+		};
+
+		ULong512 Ca;
+		ULong512 Ce;
+		ULong512 Ci;
+		ULong512 Co;
+		ULong512 Cu;
+		ULong512 Da;
+		ULong512 De;
+		ULong512 Di;
+		ULong512 Do;
+		ULong512 Du;
 		ULong512 Eba;
 		ULong512 Ebe;
 		ULong512 Ebi;
@@ -6528,7 +8311,7 @@ public:
 		ULong512 Eso;
 		ULong512 Esu;
 
-		for (size_t i = 0; i < 24; i += 2)
+		for (size_t i = 0; i < 48; i += 2)
 		{
 			// round n
 			Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
@@ -6552,7 +8335,7 @@ public:
 			Asu ^= Du;
 			Cu = ULong512::RotL64(Asu, 14);
 			Eba = Ca ^ ((~Ce) & Ci);
-			Eba ^= RC24[i];
+			Eba ^= RC48[i];
 			Ebe = Ce ^ ((~Ci) & Co);
 			Ebi = Ci ^ ((~Co) & Cu);
 			Ebo = Co ^ ((~Cu) & Ca);
@@ -6639,7 +8422,7 @@ public:
 			Esu ^= Du;
 			Cu = ULong512::RotL64(Esu, 14);
 			Aba = Ca ^ ((~Ce) & Ci);
-			Aba ^= RC24[i + 1];
+			Aba ^= RC48[i + 1];
 			Abe = Ce ^ ((~Ci) & Co);
 			Abi = Ci ^ ((~Co) & Cu);
 			Abo = Co ^ ((~Cu) & Ca);
@@ -6733,88 +8516,85 @@ public:
 		Asu.Store(State[0][24], State[1][24], State[2][24], State[3][24], State[4][24], State[5][24], State[6][24], State[7][24]);
 	}
 
+
+#elif defined(__AVX2__)
+
 	template<typename Array>
-	inline static void PermuteR48P12800(std::vector<Array> &State)
+	inline static void PermuteR12P6400(std::vector<Array> &State)
 	{
-		ULong512 Aba(State[0][0], State[1][0], State[2][0], State[3][0], State[4][0], State[5][0], State[6][0], State[7][0]);
-		ULong512 Abe(State[0][1], State[1][1], State[2][1], State[3][1], State[4][1], State[5][1], State[6][1], State[7][1]);
-		ULong512 Abi(State[0][2], State[1][2], State[2][2], State[3][2], State[4][2], State[5][2], State[6][2], State[7][2]);
-		ULong512 Abo(State[0][3], State[1][3], State[2][3], State[3][3], State[4][3], State[5][3], State[6][3], State[7][3]);
-		ULong512 Abu(State[0][4], State[1][4], State[2][4], State[3][4], State[4][4], State[5][4], State[6][4], State[7][4]);
-		ULong512 Aga(State[0][5], State[1][5], State[2][5], State[3][5], State[4][5], State[5][5], State[6][5], State[7][5]);
-		ULong512 Age(State[0][6], State[1][6], State[2][6], State[3][6], State[4][6], State[5][6], State[6][6], State[7][6]);
-		ULong512 Agi(State[0][7], State[1][7], State[2][7], State[3][7], State[4][7], State[5][7], State[6][7], State[7][7]);
-		ULong512 Ago(State[0][8], State[1][8], State[2][8], State[3][8], State[4][8], State[5][8], State[6][8], State[7][8]);
-		ULong512 Agu(State[0][9], State[1][9], State[2][9], State[3][9], State[4][9], State[5][9], State[6][9], State[7][9]);
-		ULong512 Aka(State[0][10], State[1][10], State[2][10], State[3][10], State[4][10], State[5][10], State[6][10], State[7][10]);
-		ULong512 Ake(State[0][11], State[1][11], State[2][11], State[3][11], State[4][11], State[5][11], State[6][11], State[7][11]);
-		ULong512 Aki(State[0][12], State[1][12], State[2][12], State[3][12], State[4][12], State[5][12], State[6][12], State[7][12]);
-		ULong512 Ako(State[0][13], State[1][13], State[2][13], State[3][13], State[4][13], State[5][13], State[6][13], State[7][13]);
-		ULong512 Aku(State[0][14], State[1][14], State[2][14], State[3][14], State[4][14], State[5][14], State[6][14], State[7][14]);
-		ULong512 Ama(State[0][15], State[1][15], State[2][15], State[3][15], State[4][15], State[5][15], State[6][15], State[7][15]);
-		ULong512 Ame(State[0][16], State[1][16], State[2][16], State[3][16], State[4][16], State[5][16], State[6][16], State[7][16]);
-		ULong512 Ami(State[0][17], State[1][17], State[2][17], State[3][17], State[4][17], State[5][17], State[6][17], State[7][17]);
-		ULong512 Amo(State[0][18], State[1][18], State[2][18], State[3][18], State[4][18], State[5][18], State[6][18], State[7][18]);
-		ULong512 Amu(State[0][19], State[1][19], State[2][19], State[3][19], State[4][19], State[5][19], State[6][19], State[7][19]);
-		ULong512 Asa(State[0][20], State[1][20], State[2][20], State[3][20], State[4][20], State[5][20], State[6][20], State[7][20]);
-		ULong512 Ase(State[0][21], State[1][21], State[2][21], State[3][21], State[4][21], State[5][21], State[6][21], State[7][21]);
-		ULong512 Asi(State[0][22], State[1][22], State[2][22], State[3][22], State[4][22], State[5][22], State[6][22], State[7][22]);
-		ULong512 Aso(State[0][23], State[1][23], State[2][23], State[3][23], State[4][23], State[5][23], State[6][23], State[7][23]);
-		ULong512 Asu(State[0][24], State[1][24], State[2][24], State[3][24], State[4][24], State[5][24], State[6][24], State[7][24]);
-
-		const static std::array<ULong512, 48> RC48 =
-		{
-			ULong512(0x0000000000000001ULL), ULong512(0x0000000000008082ULL), ULong512(0x800000000000808AULL), ULong512(0x8000000080008000ULL),
-			ULong512(0x000000000000808BULL), ULong512(0x0000000080000001ULL), ULong512(0x8000000080008081ULL), ULong512(0x8000000000008009ULL),
-			ULong512(0x000000000000008AULL), ULong512(0x0000000000000088ULL), ULong512(0x0000000080008009ULL), ULong512(0x000000008000000AULL),
-			ULong512(0x000000008000808BULL), ULong512(0x800000000000008BULL), ULong512(0x8000000000008089ULL), ULong512(0x8000000000008003ULL),
-			ULong512(0x8000000000008002ULL), ULong512(0x8000000000000080ULL), ULong512(0x000000000000800AULL), ULong512(0x800000008000000AULL),
-			ULong512(0x8000000080008081ULL), ULong512(0x8000000000008080ULL), ULong512(0x0000000080000001ULL), ULong512(0x8000000080008008ULL),
-			ULong512(0x8000000080008082ULL), ULong512(0x800000008000800AULL), ULong512(0x8000000000000003ULL), ULong512(0x8000000080000009ULL),
-			ULong512(0x8000000000008082ULL), ULong512(0x0000000000008009ULL), ULong512(0x8000000000000080ULL), ULong512(0x0000000000008083ULL),
-			ULong512(0x8000000000000081ULL), ULong512(0x0000000000000001ULL), ULong512(0x000000000000800BULL), ULong512(0x8000000080008001ULL),
-			ULong512(0x0000000000000080ULL), ULong512(0x8000000000008000ULL), ULong512(0x8000000080008001ULL), ULong512(0x0000000000000009ULL),
-			ULong512(0x800000008000808BULL), ULong512(0x0000000000000081ULL), ULong512(0x8000000000000082ULL), ULong512(0x000000008000008BULL),
-			ULong512(0x8000000080008009ULL), ULong512(0x8000000080000000ULL), ULong512(0x0000000080000080ULL), ULong512(0x0000000080008003ULL)
+		ULong256 Aba(State[0][0], State[1][0], State[2][0], State[3][0]);
+		ULong256 Abe(State[0][1], State[1][1], State[2][1], State[3][1]);
+		ULong256 Abi(State[0][2], State[1][2], State[2][2], State[3][2]);
+		ULong256 Abo(State[0][3], State[1][3], State[2][3], State[3][3]);
+		ULong256 Abu(State[0][4], State[1][4], State[2][4], State[3][4]);
+		ULong256 Aga(State[0][5], State[1][5], State[2][5], State[3][5]);
+		ULong256 Age(State[0][6], State[1][6], State[2][6], State[3][6]);
+		ULong256 Agi(State[0][7], State[1][7], State[2][7], State[3][7]);
+		ULong256 Ago(State[0][8], State[1][8], State[2][8], State[3][8]);
+		ULong256 Agu(State[0][9], State[1][9], State[2][9], State[3][9]);
+		ULong256 Aka(State[0][10], State[1][10], State[2][10], State[3][10]);
+		ULong256 Ake(State[0][11], State[1][11], State[2][11], State[3][11]);
+		ULong256 Aki(State[0][12], State[1][12], State[2][12], State[3][12]);
+		ULong256 Ako(State[0][13], State[1][13], State[2][13], State[3][13]);
+		ULong256 Aku(State[0][14], State[1][14], State[2][14], State[3][14]);
+		ULong256 Ama(State[0][15], State[1][15], State[2][15], State[3][15]);
+		ULong256 Ame(State[0][16], State[1][16], State[2][16], State[3][16]);
+		ULong256 Ami(State[0][17], State[1][17], State[2][17], State[3][17]);
+		ULong256 Amo(State[0][18], State[1][18], State[2][18], State[3][18]);
+		ULong256 Amu(State[0][19], State[1][19], State[2][19], State[3][19]);
+		ULong256 Asa(State[0][20], State[1][20], State[2][20], State[3][20]);
+		ULong256 Ase(State[0][21], State[1][21], State[2][21], State[3][21]);
+		ULong256 Asi(State[0][22], State[1][22], State[2][22], State[3][22]);
+		ULong256 Aso(State[0][23], State[1][23], State[2][23], State[3][23]);
+		ULong256 Asu(State[0][24], State[1][24], State[2][24], State[3][24]);
+
+		const static std::array<ULong256, 24> RC24 =
+		{
+			ULong256(0x0000000000000001ULL), ULong256(0x0000000000008082ULL), ULong256(0x800000000000808AULL), ULong256(0x8000000080008000ULL),
+			ULong256(0x000000000000808BULL), ULong256(0x0000000080000001ULL), ULong256(0x8000000080008081ULL), ULong256(0x8000000000008009ULL),
+			ULong256(0x000000000000008AULL), ULong256(0x0000000000000088ULL), ULong256(0x0000000080008009ULL), ULong256(0x000000008000000AULL),
+			ULong256(0x000000008000808BULL), ULong256(0x800000000000008BULL), ULong256(0x8000000000008089ULL), ULong256(0x8000000000008003ULL),
+			ULong256(0x8000000000008002ULL), ULong256(0x8000000000000080ULL), ULong256(0x000000000000800AULL), ULong256(0x800000008000000AULL),
+			ULong256(0x8000000080008081ULL), ULong256(0x8000000000008080ULL), ULong256(0x0000000080000001ULL), ULong256(0x8000000080008008ULL)
 		};
 
-		ULong512 Ca;
-		ULong512 Ce;
-		ULong512 Ci;
-		ULong512 Co;
-		ULong512 Cu;
-		ULong512 Da;
-		ULong512 De;
-		ULong512 Di;
-		ULong512 Do;
-		ULong512 Du;
-		ULong512 Eba;
-		ULong512 Ebe;
-		ULong512 Ebi;
-		ULong512 Ebo;
-		ULong512 Ebu;
-		ULong512 Ega;
-		ULong512 Ege;
-		ULong512 Egi;
-		ULong512 Ego;
-		ULong512 Egu;
-		ULong512 Eka;
-		ULong512 Eke;
-		ULong512 Eki;
-		ULong512 Eko;
-		ULong512 Eku;
-		ULong512 Ema;
-		ULong512 Eme;
-		ULong512 Emi;
-		ULong512 Emo;
-		ULong512 Emu;
-		ULong512 Esa;
-		ULong512 Ese;
-		ULong512 Esi;
-		ULong512 Eso;
-		ULong512 Esu;
+		ULong256 Ca;
+		ULong256 Ce;
+		ULong256 Ci;
+		ULong256 Co;
+		ULong256 Cu;
+		ULong256 Da;
+		ULong256 De;
+		ULong256 Di;
+		ULong256 Do;
+		ULong256 Du;
+		ULong256 Eba;
+		ULong256 Ebe;
+		ULong256 Ebi;
+		ULong256 Ebo;
+		ULong256 Ebu;
+		ULong256 Ega;
+		ULong256 Ege;
+		ULong256 Egi;
+		ULong256 Ego;
+		ULong256 Egu;
+		ULong256 Eka;
+		ULong256 Eke;
+		ULong256 Eki;
+		ULong256 Eko;
+		ULong256 Eku;
+		ULong256 Ema;
+		ULong256 Eme;
+		ULong256 Emi;
+		ULong256 Emo;
+		ULong256 Emu;
+		ULong256 Esa;
+		ULong256 Ese;
+		ULong256 Esi;
+		ULong256 Eso;
+		ULong256 Esu;
 
-		for (size_t i = 0; i < 48; i += 2)
+		for (size_t i = 12; i < 24; i += 2) 
 		{
 			// round n
 			Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
@@ -6822,82 +8602,82 @@ public:
 			Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
 			Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
 			Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-			Da = Cu ^ ULong512::RotL64(Ce, 1);
-			De = Ca ^ ULong512::RotL64(Ci, 1);
-			Di = Ce ^ ULong512::RotL64(Co, 1);
-			Do = Ci ^ ULong512::RotL64(Cu, 1);
-			Du = Co ^ ULong512::RotL64(Ca, 1);
+			Da = Cu ^ ULong256::RotL64(Ce, 1);
+			De = Ca ^ ULong256::RotL64(Ci, 1);
+			Di = Ce ^ ULong256::RotL64(Co, 1);
+			Do = Ci ^ ULong256::RotL64(Cu, 1);
+			Du = Co ^ ULong256::RotL64(Ca, 1);
 			Aba ^= Da;
 			Ca = Aba;
 			Age ^= De;
-			Ce = ULong512::RotL64(Age, 44);
+			Ce = ULong256::RotL64(Age, 44);
 			Aki ^= Di;
-			Ci = ULong512::RotL64(Aki, 43);
+			Ci = ULong256::RotL64(Aki, 43);
 			Amo ^= Do;
-			Co = ULong512::RotL64(Amo, 21);
+			Co = ULong256::RotL64(Amo, 21);
 			Asu ^= Du;
-			Cu = ULong512::RotL64(Asu, 14);
+			Cu = ULong256::RotL64(Asu, 14);
 			Eba = Ca ^ ((~Ce) & Ci);
-			Eba ^= RC48[i];
+			Eba ^= RC24[i];
 			Ebe = Ce ^ ((~Ci) & Co);
 			Ebi = Ci ^ ((~Co) & Cu);
 			Ebo = Co ^ ((~Cu) & Ca);
 			Ebu = Cu ^ ((~Ca) & Ce);
 			Abo ^= Do;
-			Ca = ULong512::RotL64(Abo, 28);
+			Ca = ULong256::RotL64(Abo, 28);
 			Agu ^= Du;
-			Ce = ULong512::RotL64(Agu, 20);
+			Ce = ULong256::RotL64(Agu, 20);
 			Aka ^= Da;
-			Ci = ULong512::RotL64(Aka, 3);
+			Ci = ULong256::RotL64(Aka, 3);
 			Ame ^= De;
-			Co = ULong512::RotL64(Ame, 45);
+			Co = ULong256::RotL64(Ame, 45);
 			Asi ^= Di;
-			Cu = ULong512::RotL64(Asi, 61);
+			Cu = ULong256::RotL64(Asi, 61);
 			Ega = Ca ^ ((~Ce) & Ci);
 			Ege = Ce ^ ((~Ci) & Co);
 			Egi = Ci ^ ((~Co) & Cu);
 			Ego = Co ^ ((~Cu) & Ca);
 			Egu = Cu ^ ((~Ca) & Ce);
 			Abe ^= De;
-			Ca = ULong512::RotL64(Abe, 1);
+			Ca = ULong256::RotL64(Abe, 1);
 			Agi ^= Di;
-			Ce = ULong512::RotL64(Agi, 6);
+			Ce = ULong256::RotL64(Agi, 6);
 			Ako ^= Do;
-			Ci = ULong512::RotL64(Ako, 25);
+			Ci = ULong256::RotL64(Ako, 25);
 			Amu ^= Du;
-			Co = ULong512::RotL64(Amu, 8);
+			Co = ULong256::RotL64(Amu, 8);
 			Asa ^= Da;
-			Cu = ULong512::RotL64(Asa, 18);
+			Cu = ULong256::RotL64(Asa, 18);
 			Eka = Ca ^ ((~Ce) & Ci);
 			Eke = Ce ^ ((~Ci) & Co);
 			Eki = Ci ^ ((~Co) & Cu);
 			Eko = Co ^ ((~Cu) & Ca);
 			Eku = Cu ^ ((~Ca) & Ce);
 			Abu ^= Du;
-			Ca = ULong512::RotL64(Abu, 27);
+			Ca = ULong256::RotL64(Abu, 27);
 			Aga ^= Da;
-			Ce = ULong512::RotL64(Aga, 36);
+			Ce = ULong256::RotL64(Aga, 36);
 			Ake ^= De;
-			Ci = ULong512::RotL64(Ake, 10);
+			Ci = ULong256::RotL64(Ake, 10);
 			Ami ^= Di;
-			Co = ULong512::RotL64(Ami, 15);
+			Co = ULong256::RotL64(Ami, 15);
 			Aso ^= Do;
-			Cu = ULong512::RotL64(Aso, 56);
+			Cu = ULong256::RotL64(Aso, 56);
 			Ema = Ca ^ ((~Ce) & Ci);
 			Eme = Ce ^ ((~Ci) & Co);
 			Emi = Ci ^ ((~Co) & Cu);
 			Emo = Co ^ ((~Cu) & Ca);
 			Emu = Cu ^ ((~Ca) & Ce);
 			Abi ^= Di;
-			Ca = ULong512::RotL64(Abi, 62);
+			Ca = ULong256::RotL64(Abi, 62);
 			Ago ^= Do;
-			Ce = ULong512::RotL64(Ago, 55);
+			Ce = ULong256::RotL64(Ago, 55);
 			Aku ^= Du;
-			Ci = ULong512::RotL64(Aku, 39);
+			Ci = ULong256::RotL64(Aku, 39);
 			Ama ^= Da;
-			Co = ULong512::RotL64(Ama, 41);
+			Co = ULong256::RotL64(Ama, 41);
 			Ase ^= De;
-			Cu = ULong512::RotL64(Ase, 2);
+			Cu = ULong256::RotL64(Ase, 2);
 			Esa = Ca ^ ((~Ce) & Ci);
 			Ese = Ce ^ ((~Ci) & Co);
 			Esi = Ci ^ ((~Co) & Cu);
@@ -6909,82 +8689,82 @@ public:
 			Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
 			Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
 			Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
-			Da = Cu ^ ULong512::RotL64(Ce, 1);
-			De = Ca ^ ULong512::RotL64(Ci, 1);
-			Di = Ce ^ ULong512::RotL64(Co, 1);
-			Do = Ci ^ ULong512::RotL64(Cu, 1);
-			Du = Co ^ ULong512::RotL64(Ca, 1);
+			Da = Cu ^ ULong256::RotL64(Ce, 1);
+			De = Ca ^ ULong256::RotL64(Ci, 1);
+			Di = Ce ^ ULong256::RotL64(Co, 1);
+			Do = Ci ^ ULong256::RotL64(Cu, 1);
+			Du = Co ^ ULong256::RotL64(Ca, 1);
 			Eba ^= Da;
 			Ca = Eba;
 			Ege ^= De;
-			Ce = ULong512::RotL64(Ege, 44);
+			Ce = ULong256::RotL64(Ege, 44);
 			Eki ^= Di;
-			Ci = ULong512::RotL64(Eki, 43);
+			Ci = ULong256::RotL64(Eki, 43);
 			Emo ^= Do;
-			Co = ULong512::RotL64(Emo, 21);
+			Co = ULong256::RotL64(Emo, 21);
 			Esu ^= Du;
-			Cu = ULong512::RotL64(Esu, 14);
+			Cu = ULong256::RotL64(Esu, 14);
 			Aba = Ca ^ ((~Ce) & Ci);
-			Aba ^= RC48[i + 1];
+			Aba ^= RC24[i + 1];
 			Abe = Ce ^ ((~Ci) & Co);
 			Abi = Ci ^ ((~Co) & Cu);
 			Abo = Co ^ ((~Cu) & Ca);
 			Abu = Cu ^ ((~Ca) & Ce);
 			Ebo ^= Do;
-			Ca = ULong512::RotL64(Ebo, 28);
+			Ca = ULong256::RotL64(Ebo, 28);
 			Egu ^= Du;
-			Ce = ULong512::RotL64(Egu, 20);
+			Ce = ULong256::RotL64(Egu, 20);
 			Eka ^= Da;
-			Ci = ULong512::RotL64(Eka, 3);
+			Ci = ULong256::RotL64(Eka, 3);
 			Eme ^= De;
-			Co = ULong512::RotL64(Eme, 45);
+			Co = ULong256::RotL64(Eme, 45);
 			Esi ^= Di;
-			Cu = ULong512::RotL64(Esi, 61);
+			Cu = ULong256::RotL64(Esi, 61);
 			Aga = Ca ^ ((~Ce) & Ci);
 			Age = Ce ^ ((~Ci) & Co);
 			Agi = Ci ^ ((~Co) & Cu);
 			Ago = Co ^ ((~Cu) & Ca);
 			Agu = Cu ^ ((~Ca) & Ce);
 			Ebe ^= De;
-			Ca = ULong512::RotL64(Ebe, 1);
+			Ca = ULong256::RotL64(Ebe, 1);
 			Egi ^= Di;
-			Ce = ULong512::RotL64(Egi, 6);
+			Ce = ULong256::RotL64(Egi, 6);
 			Eko ^= Do;
-			Ci = ULong512::RotL64(Eko, 25);
+			Ci = ULong256::RotL64(Eko, 25);
 			Emu ^= Du;
-			Co = ULong512::RotL64(Emu, 8);
+			Co = ULong256::RotL64(Emu, 8);
 			Esa ^= Da;
-			Cu = ULong512::RotL64(Esa, 18);
+			Cu = ULong256::RotL64(Esa, 18);
 			Aka = Ca ^ ((~Ce) & Ci);
 			Ake = Ce ^ ((~Ci) & Co);
 			Aki = Ci ^ ((~Co) & Cu);
 			Ako = Co ^ ((~Cu) & Ca);
 			Aku = Cu ^ ((~Ca) & Ce);
 			Ebu ^= Du;
-			Ca = ULong512::RotL64(Ebu, 27);
+			Ca = ULong256::RotL64(Ebu, 27);
 			Ega ^= Da;
-			Ce = ULong512::RotL64(Ega, 36);
+			Ce = ULong256::RotL64(Ega, 36);
 			Eke ^= De;
-			Ci = ULong512::RotL64(Eke, 10);
+			Ci = ULong256::RotL64(Eke, 10);
 			Emi ^= Di;
-			Co = ULong512::RotL64(Emi, 15);
+			Co = ULong256::RotL64(Emi, 15);
 			Eso ^= Do;
-			Cu = ULong512::RotL64(Eso, 56);
+			Cu = ULong256::RotL64(Eso, 56);
 			Ama = Ca ^ ((~Ce) & Ci);
 			Ame = Ce ^ ((~Ci) & Co);
 			Ami = Ci ^ ((~Co) & Cu);
 			Amo = Co ^ ((~Cu) & Ca);
 			Amu = Cu ^ ((~Ca) & Ce);
 			Ebi ^= Di;
-			Ca = ULong512::RotL64(Ebi, 62);
+			Ca = ULong256::RotL64(Ebi, 62);
 			Ego ^= Do;
-			Ce = ULong512::RotL64(Ego, 55);
+			Ce = ULong256::RotL64(Ego, 55);
 			Eku ^= Du;
-			Ci = ULong512::RotL64(Eku, 39);
+			Ci = ULong256::RotL64(Eku, 39);
 			Ema ^= Da;
-			Co = ULong512::RotL64(Ema, 41);
+			Co = ULong256::RotL64(Ema, 41);
 			Ese ^= De;
-			Cu = ULong512::RotL64(Ese, 2);
+			Cu = ULong256::RotL64(Ese, 2);
 			Asa = Ca ^ ((~Ce) & Ci);
 			Ase = Ce ^ ((~Ci) & Co);
 			Asi = Ci ^ ((~Co) & Cu);
@@ -6992,38 +8772,35 @@ public:
 			Asu = Cu ^ ((~Ca) & Ce);
 		}
 
-		Aba.Store(State[0][0], State[1][0], State[2][0], State[3][0], State[4][0], State[5][0], State[6][0], State[7][0]);
-		Abe.Store(State[0][1], State[1][1], State[2][1], State[3][1], State[4][1], State[5][1], State[6][1], State[7][1]);
-		Abi.Store(State[0][2], State[1][2], State[2][2], State[3][2], State[4][2], State[5][2], State[6][2], State[7][2]);
-		Abo.Store(State[0][3], State[1][3], State[2][3], State[3][3], State[4][3], State[5][3], State[6][3], State[7][3]);
-		Abu.Store(State[0][4], State[1][4], State[2][4], State[3][4], State[4][4], State[5][4], State[6][4], State[7][4]);
-		Aga.Store(State[0][5], State[1][5], State[2][5], State[3][5], State[4][5], State[5][5], State[6][5], State[7][5]);
-		Age.Store(State[0][6], State[1][6], State[2][6], State[3][6], State[4][6], State[5][6], State[6][6], State[7][6]);
-		Agi.Store(State[0][7], State[1][7], State[2][7], State[3][7], State[4][7], State[5][7], State[6][7], State[7][7]);
-		Ago.Store(State[0][8], State[1][8], State[2][8], State[3][8], State[4][8], State[5][8], State[6][8], State[7][8]);
-		Agu.Store(State[0][9], State[1][9], State[2][9], State[3][9], State[4][9], State[5][9], State[6][9], State[7][9]);
-		Aka.Store(State[0][10], State[1][10], State[2][10], State[3][10], State[4][10], State[5][10], State[6][10], State[7][10]);
-		Ake.Store(State[0][11], State[1][11], State[2][11], State[3][11], State[4][11], State[5][11], State[6][11], State[7][11]);
-		Aki.Store(State[0][12], State[1][12], State[2][12], State[3][12], State[4][12], State[5][12], State[6][12], State[7][12]);
-		Ako.Store(State[0][13], State[1][13], State[2][13], State[3][13], State[4][13], State[5][13], State[6][13], State[7][13]);
-		Aku.Store(State[0][14], State[1][14], State[2][14], State[3][14], State[4][14], State[5][14], State[6][14], State[7][14]);
-		Ama.Store(State[0][15], State[1][15], State[2][15], State[3][15], State[4][15], State[5][15], State[6][15], State[7][15]);
-		Ame.Store(State[0][16], State[1][16], State[2][16], State[3][16], State[4][16], State[5][16], State[6][16], State[7][16]);
-		Ami.Store(State[0][17], State[1][17], State[2][17], State[3][17], State[4][17], State[5][17], State[6][17], State[7][17]);
-		Amo.Store(State[0][18], State[1][18], State[2][18], State[3][18], State[4][18], State[5][18], State[6][18], State[7][18]);
-		Amu.Store(State[0][19], State[1][19], State[2][19], State[3][19], State[4][19], State[5][19], State[6][19], State[7][19]);
-		Asa.Store(State[0][20], State[1][20], State[2][20], State[3][20], State[4][20], State[5][20], State[6][20], State[7][20]);
-		Ase.Store(State[0][21], State[1][21], State[2][21], State[3][21], State[4][21], State[5][21], State[6][21], State[7][21]);
-		Asi.Store(State[0][22], State[1][22], State[2][22], State[3][22], State[4][22], State[5][22], State[6][22], State[7][22]);
-		Aso.Store(State[0][23], State[1][23], State[2][23], State[3][23], State[4][23], State[5][23], State[6][23], State[7][23]);
-		Asu.Store(State[0][24], State[1][24], State[2][24], State[3][24], State[4][24], State[5][24], State[6][24], State[7][24]);
+		Aba.Store(State[0][0], State[1][0], State[2][0], State[3][0]);
+		Abe.Store(State[0][1], State[1][1], State[2][1], State[3][1]);
+		Abi.Store(State[0][2], State[1][2], State[2][2], State[3][2]);
+		Abo.Store(State[0][3], State[1][3], State[2][3], State[3][3]);
+		Abu.Store(State[0][4], State[1][4], State[2][4], State[3][4]);
+		Aga.Store(State[0][5], State[1][5], State[2][5], State[3][5]);
+		Age.Store(State[0][6], State[1][6], State[2][6], State[3][6]);
+		Agi.Store(State[0][7], State[1][7], State[2][7], State[3][7]);
+		Ago.Store(State[0][8], State[1][8], State[2][8], State[3][8]);
+		Agu.Store(State[0][9], State[1][9], State[2][9], State[3][9]);
+		Aka.Store(State[0][10], State[1][10], State[2][10], State[3][10]);
+		Ake.Store(State[0][11], State[1][11], State[2][11], State[3][11]);
+		Aki.Store(State[0][12], State[1][12], State[2][12], State[3][12]);
+		Ako.Store(State[0][13], State[1][13], State[2][13], State[3][13]);
+		Aku.Store(State[0][14], State[1][14], State[2][14], State[3][14]);
+		Ama.Store(State[0][15], State[1][15], State[2][15], State[3][15]);
+		Ame.Store(State[0][16], State[1][16], State[2][16], State[3][16]);
+		Ami.Store(State[0][17], State[1][17], State[2][17], State[3][17]);
+		Amo.Store(State[0][18], State[1][18], State[2][18], State[3][18]);
+		Amu.Store(State[0][19], State[1][19], State[2][19], State[3][19]);
+		Asa.Store(State[0][20], State[1][20], State[2][20], State[3][20]);
+		Ase.Store(State[0][21], State[1][21], State[2][21], State[3][21]);
+		Asi.Store(State[0][22], State[1][22], State[2][22], State[3][22]);
+		Aso.Store(State[0][23], State[1][23], State[2][23], State[3][23]);
+		Asu.Store(State[0][24], State[1][24], State[2][24], State[3][24]);
 	}
 
-
-#elif defined(__AVX2__)
-
-	template<typename Array>
-	inline static void PermuteR24P6400(std::vector<Array> &State)
+	template<typename Array, typename Allocator>
+	inline static void PermuteR24P6400(std::vector<Array, Allocator> &State)
 	{
 		ULong256 Aba(State[0][0], State[1][0], State[2][0], State[3][0]);
 		ULong256 Abe(State[0][1], State[1][1], State[2][1], State[3][1]);
@@ -7302,8 +9079,8 @@ public:
 		Asu.Store(State[0][24], State[1][24], State[2][24], State[3][24]);
 	}
 
-	template<typename Array>
-	inline static void PermuteR48P6400(std::vector<Array> &State)
+	template<typename Array, typename Allocator>
+	inline static void PermuteR48P6400(std::vector<Array, Allocator> &State)
 	{
 		ULong256 Aba(State[0][0], State[1][0], State[2][0], State[3][0]);
 		ULong256 Abe(State[0][1], State[1][1], State[2][1], State[3][1]);
@@ -1,4 +1,5 @@
 #include "Keccak1024.h"
+#include "Instrumentation.h"
 #include "Keccak.h"
 #include "ParallelUtils.h"
 
@@ -145,6 +146,8 @@ void Keccak1024::Compute(const std::vector<byte> &Input, std::vector<byte> &Outp
 
 size_t Keccak1024::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, 0);
+
 	const size_t OUTLEN = Output.size() - OutOffset;
 
 	if (m_parallelProfile.IsParallel())
@@ -275,12 +278,16 @@ void Keccak1024::Update(byte Input)
 
 void Keccak1024::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, Length);
+
 	CexAssert(Input.size() - InOffset >= Length, "The Output buffer is too short!");
 
 	if (Length != 0)
 	{
 		if (m_parallelProfile.IsParallel())
 		{
+			CEX_INSTRUMENT_PARALLEL();
+
 			if (m_msgLength != 0 && Length + m_msgLength >= m_msgBuffer.size())
 			{
 				// fill buffer
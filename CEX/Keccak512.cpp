@@ -1,4 +1,5 @@
 #include "Keccak512.h"
+#include "Instrumentation.h"
 #include "Keccak.h"
 #include "ParallelUtils.h"
 
@@ -145,6 +146,8 @@ void Keccak512::Compute(const std::vector<byte> &Input, std::vector<byte> &Outpu
 
 size_t Keccak512::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, 0);
+
 	CexAssert(Output.size() - OutOffset >= DIGEST_SIZE, "The Output buffer is too short!");
 
 	if (m_parallelProfile.IsParallel())
@@ -252,12 +255,16 @@ void Keccak512::Update(byte Input)
 
 void Keccak512::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, Length);
+
 	CexAssert(Input.size() - InOffset >= Length, "The Output buffer is too short!");
 
 	if (Length != 0)
 	{
 		if (m_parallelProfile.IsParallel())
 		{
+			CEX_INSTRUMENT_PARALLEL();
+
 			if (m_msgLength != 0 && Length + m_msgLength >= m_msgBuffer.size())
 			{
 				// fill buffer
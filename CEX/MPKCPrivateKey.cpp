@@ -72,7 +72,7 @@ std::vector<byte> MPKCPrivateKey::ToBytes()
 	std::vector<byte> s(sLen + 5);
 	s[0] = static_cast<byte>(m_mpkcParameters);
 	Utility::IntUtils::Le32ToBytes(sLen, s, 1);
-	Utility::MemUtils::Copy(s, 5, m_sCoeffs, 0, sLen);
+	Utility::MemUtils::Copy(m_sCoeffs, 0, s, 5, sLen);
 
 	return s;
 }
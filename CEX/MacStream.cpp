@@ -1,5 +1,6 @@
 #include "MacStream.h"
 #include "MacFromDescription.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_PROCESSING
 
@@ -66,7 +67,9 @@ std::vector<byte> MacStream::Compute(const std::vector<byte> &Input, size_t InOf
 
 void MacStream::Initialize(ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), kv.Key().size()))
 	{
 		throw CryptoProcessingException("CipherStream:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 	}
@@ -0,0 +1,350 @@
+#include "MappedStream.h"
+#include "IntUtils.h"
+#include <cstring>
+
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <sys/types.h>
+#	include <unistd.h>
+#endif
+
+NAMESPACE_IO
+
+const std::string MappedStream::CLASS_NAME("MappedStream");
+
+//~~~Constructor~~~//
+
+MappedStream::MappedStream(const std::string &FileName, FileAccess Access)
+	:
+	m_fileHandle(-1),
+	m_fileAccess(Access),
+	m_fileName(FileName),
+	m_isDestroyed(false),
+	m_mapData(nullptr),
+	m_mapSize(0),
+	m_streamLength(0),
+	m_streamPosition(0)
+{
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	int flags = (Access == FileAccess::Read) ? O_RDONLY : O_RDWR | O_CREAT;
+
+	if (Access == FileAccess::Write)
+	{
+		flags |= O_TRUNC;
+	}
+
+	m_fileHandle = ::open(m_fileName.c_str(), flags, 0644);
+
+	if (m_fileHandle < 0)
+	{
+		throw CryptoProcessingException("MappedStream:CTor", "The file could not be opened!");
+	}
+
+	struct stat fst;
+
+	if (::fstat(m_fileHandle, &fst) != 0)
+	{
+		::close(m_fileHandle);
+		m_fileHandle = -1;
+		throw CryptoProcessingException("MappedStream:CTor", "The file size could not be read!");
+	}
+
+	m_streamLength = static_cast<ulong>(fst.st_size);
+
+	try
+	{
+		Remap(m_streamLength);
+	}
+	catch (CryptoProcessingException&)
+	{
+		::close(m_fileHandle);
+		m_fileHandle = -1;
+		throw;
+	}
+#else
+	throw CryptoProcessingException("MappedStream:CTor", "Memory mapped files are not supported on this platform!");
+#endif
+}
+
+MappedStream::~MappedStream()
+{
+	try
+	{
+		Destroy();
+	}
+	catch (CryptoProcessingException&)
+	{
+		// a destructor can not report the failure; call Close to check the trim
+	}
+}
+
+//~~~Accessors~~~//
+
+const MappedStream::FileAccess MappedStream::Access()
+{
+	return m_fileAccess;
+}
+
+const bool MappedStream::CanRead()
+{
+	return m_fileAccess != FileAccess::Write;
+}
+
+const bool MappedStream::CanSeek()
+{
+	return true;
+}
+
+const bool MappedStream::CanWrite()
+{
+	return m_fileAccess != FileAccess::Read;
+}
+
+const StreamModes MappedStream::Enumeral()
+{
+	return StreamModes::MappedStream;
+}
+
+std::string MappedStream::FileName()
+{
+	return m_fileName;
+}
+
+const ulong MappedStream::Length()
+{
+	return m_streamLength;
+}
+
+const std::string MappedStream::Name()
+{
+	return CLASS_NAME;
+}
+
+const ulong MappedStream::Position()
+{
+	return m_streamPosition;
+}
+
+//~~~Public Functions~~~//
+
+void MappedStream::Close()
+{
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	if (m_fileHandle >= 0)
+	{
+		bool trmFail = false;
+
+		Flush();
+		Unmap();
+
+		if (m_fileAccess != FileAccess::Read)
+		{
+			// trim the growth reserve
+			trmFail = (::ftruncate(m_fileHandle, static_cast<off_t>(m_streamLength)) != 0);
+		}
+
+		::close(m_fileHandle);
+		m_fileHandle = -1;
+		m_streamLength = 0;
+		m_streamPosition = 0;
+
+		if (trmFail)
+		{
+			throw CryptoProcessingException("MappedStream:Close", "The file could not be trimmed to its length!");
+		}
+	}
+#endif
+
+	m_streamLength = 0;
+	m_streamPosition = 0;
+}
+
+void MappedStream::CopyTo(IByteStream* Destination)
+{
+	CexAssert(m_streamLength != 0, "stream is too short");
+
+	const size_t CPYSZE = GROW_SIZE;
+	std::vector<byte> buffer(CPYSZE);
+	ulong prcLen = 0;
+
+	Destination->Seek(0, IO::SeekOrigin::Begin);
+
+	while (prcLen != m_streamLength)
+	{
+		const size_t RMDSZE = static_cast<size_t>(Utility::IntUtils::Min(static_cast<ulong>(CPYSZE), m_streamLength - prcLen));
+		std::memcpy(buffer.data(), m_mapData + prcLen, RMDSZE);
+		Destination->Write(buffer, 0, RMDSZE);
+		prcLen += RMDSZE;
+	}
+}
+
+void MappedStream::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		Close();
+	}
+}
+
+void MappedStream::Flush()
+{
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	if (m_mapData != nullptr && m_fileAccess != FileAccess::Read)
+	{
+		::msync(m_mapData, static_cast<size_t>(m_mapSize), MS_SYNC);
+	}
+#endif
+}
+
+size_t MappedStream::Read(std::vector<byte> &Output, size_t Offset, size_t Length)
+{
+	CexAssert(Offset + Length <= Output.size(), "the output array is too small");
+
+	if (Length > m_streamLength - m_streamPosition)
+	{
+		Length = static_cast<size_t>(m_streamLength - m_streamPosition);
+	}
+
+	if (Length > 0)
+	{
+		std::memcpy(&Output[Offset], m_mapData + m_streamPosition, Length);
+		m_streamPosition += Length;
+	}
+
+	return Length;
+}
+
+byte MappedStream::ReadByte()
+{
+	CexAssert(m_streamLength - m_streamPosition >= 1, "Reached end of file");
+
+	byte data = m_mapData[m_streamPosition];
+	++m_streamPosition;
+
+	return data;
+}
+
+void MappedStream::Reset()
+{
+	m_streamPosition = 0;
+}
+
+void MappedStream::Seek(ulong Offset, SeekOrigin Origin)
+{
+	if (Origin == SeekOrigin::Begin)
+	{
+		m_streamPosition = Offset;
+	}
+	else if (Origin == SeekOrigin::End)
+	{
+		m_streamPosition = m_streamLength - Offset;
+	}
+	else
+	{
+		m_streamPosition += Offset;
+	}
+
+	CexAssert(m_streamPosition <= m_streamLength, "the position exceeds the stream length");
+}
+
+void MappedStream::SetLength(ulong Length)
+{
+	CexAssert(m_fileAccess != FileAccess::Read, "File is read only");
+
+	if (Length > m_mapSize || Length < m_streamLength)
+	{
+		Remap(Length);
+	}
+
+	m_streamLength = Length;
+
+	if (m_streamPosition > m_streamLength)
+	{
+		m_streamPosition = m_streamLength;
+	}
+}
+
+const byte* MappedStream::View(ulong Offset, size_t Length)
+{
+	CexAssert(Offset + Length <= m_streamLength, "the view exceeds the stream length");
+
+	return m_mapData + Offset;
+}
+
+void MappedStream::Write(const std::vector<byte> &Input, size_t Offset, size_t Length)
+{
+	CexAssert(m_fileAccess != FileAccess::Read, "File is read only");
+	CexAssert(Offset + Length <= Input.size(), "Input stream length exceeded");
+
+	const ulong TTLLEN = m_streamPosition + Length;
+
+	if (TTLLEN > m_mapSize)
+	{
+		// geometric growth keeps the number of remaps logarithmic in the file size
+		Remap(Utility::IntUtils::Max(TTLLEN, Utility::IntUtils::Max(m_mapSize * 2, static_cast<ulong>(GROW_SIZE))));
+	}
+
+	std::memcpy(m_mapData + m_streamPosition, &Input[Offset], Length);
+	m_streamPosition += Length;
+
+	if (m_streamPosition > m_streamLength)
+	{
+		m_streamLength = m_streamPosition;
+	}
+}
+
+void MappedStream::WriteByte(byte Value)
+{
+	std::vector<byte> tmp(1, Value);
+	Write(tmp, 0, 1);
+}
+
+//~~~Private Functions~~~//
+
+void MappedStream::Remap(ulong Size)
+{
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	Unmap();
+
+	if (m_fileAccess != FileAccess::Read)
+	{
+		if (::ftruncate(m_fileHandle, static_cast<off_t>(Size)) != 0)
+		{
+			throw CryptoProcessingException("MappedStream:Remap", "The file could not be resized!");
+		}
+	}
+
+	// a zero length file can not be mapped; the mapping is created on the first write
+	if (Size != 0)
+	{
+		const int PRTFLG = (m_fileAccess == FileAccess::Read) ? PROT_READ : PROT_READ | PROT_WRITE;
+		void* ptr = ::mmap(nullptr, static_cast<size_t>(Size), PRTFLG, MAP_SHARED, m_fileHandle, 0);
+
+		if (ptr == MAP_FAILED)
+		{
+			throw CryptoProcessingException("MappedStream:Remap", "The file could not be mapped!");
+		}
+
+		m_mapData = static_cast<byte*>(ptr);
+		m_mapSize = Size;
+		::madvise(m_mapData, static_cast<size_t>(m_mapSize), MADV_SEQUENTIAL);
+	}
+#endif
+}
+
+void MappedStream::Unmap()
+{
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	if (m_mapData != nullptr)
+	{
+		::munmap(m_mapData, static_cast<size_t>(m_mapSize));
+		m_mapData = nullptr;
+		m_mapSize = 0;
+	}
+#endif
+}
+
+NAMESPACE_IOEND
@@ -0,0 +1,236 @@
+#ifndef CEX_MAPPEDSTREAM_H
+#define CEX_MAPPEDSTREAM_H
+
+#include "IByteStream.h"
+
+NAMESPACE_IO
+
+/// <summary>
+/// A memory-mapped file streaming container.
+/// <para>Maps a file into the process address space and manipulates it through a streaming interface.
+/// Reads and writes are a single copy to or from the page cache, and the View function exposes a zero-copy pointer into the mapping.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Example of hashing a file through a mapped stream:</description>
+/// <code>
+/// MappedStream inp(FileName, MappedStream::FileAccess::Read);
+/// DigestStream dgt(Digests::SHA256);
+/// std::vector&lt;byte&gt; hash = dgt.Compute(&amp;inp);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <para>The file is opened and mapped once in the constructor; the mapping is shared with the page cache, so there is no intermediate stream buffer between the kernel and the callers array.
+/// Write access grows the mapping in geometric steps as data is appended, and the file is truncated to the logical stream length when the stream is closed.</para>
+/// <para>This class is currently implemented on Linux/Posix systems only, the constructor throws on unsupported platforms.</para>
+/// </remarks>
+class MappedStream final : public IByteStream
+{
+public:
+
+	//~~~Enums~~~//
+
+	/// <summary>
+	/// File access type flags
+	/// </summary>
+	enum class FileAccess : int
+	{
+		Read = 1,
+		ReadWrite = 2,
+		Write = 3
+	};
+
+private:
+
+	static const size_t GROW_SIZE = 1024 * 1024;
+	static const std::string CLASS_NAME;
+
+	int m_fileHandle;
+	FileAccess m_fileAccess;
+	std::string m_fileName;
+	bool m_isDestroyed;
+	byte* m_mapData;
+	ulong m_mapSize;
+	ulong m_streamLength;
+	ulong m_streamPosition;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	MappedStream(const MappedStream&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	MappedStream& operator=(const MappedStream&) = delete;
+
+	/// <summary>
+	/// Default constructor: default is restricted, this function has been deleted
+	/// </summary>
+	MappedStream() = delete;
+
+	/// <summary>
+	/// Constructor: instantiate this class with a file name and access mode
+	/// </summary>
+	///
+	/// <param name="FileName">The full path and name of the file</param>
+	/// <param name="Access">The level of access requested; Write creates or truncates the file</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the file could not be opened or mapped</exception>
+	explicit MappedStream(const std::string &FileName, FileAccess Access = FileAccess::Read);
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~MappedStream() override;
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The file read and write file access flags
+	/// </summary>
+	const FileAccess Access();
+
+	/// <summary>
+	/// Read Only: The stream can be read
+	/// </summary>
+	const bool CanRead() override;
+
+	/// <summary>
+	/// Read Only: The stream is seekable
+	/// </summary>
+	const bool CanSeek() override;
+
+	/// <summary>
+	/// Read Only: The stream can be written to
+	/// </summary>
+	const bool CanWrite() override;
+
+	/// <summary>
+	/// Read Only: The stream container type
+	/// </summary>
+	const StreamModes Enumeral() override;
+
+	/// <summary>
+	/// Read Only: The file name and path
+	/// </summary>
+	std::string FileName();
+
+	/// <summary>
+	/// Read Only: The stream length
+	/// </summary>
+	const ulong Length() override;
+
+	/// <summary>
+	/// Read Only: The streams class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Read Only: The streams current position
+	/// </summary>
+	const ulong Position() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Flush, unmap and close the file
+	/// </summary>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the file can not be trimmed to its length; the file handle is released either way</exception>
+	void Close() override;
+
+	/// <summary>
+	/// Copy this stream to another stream
+	/// </summary>
+	///
+	/// <param name="Destination">The destination stream</param>
+	void CopyTo(IByteStream* Destination) override;
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Write modified pages to disk
+	/// </summary>
+	void Flush();
+
+	/// <summary>
+	/// Copies a portion of the stream into an output buffer
+	/// </summary>
+	///
+	/// <param name="Output">The output array receiving the bytes</param>
+	/// <param name="Offset">Offset within the output array at which to begin</param>
+	/// <param name="Length">The number of bytes to read</param>
+	///
+	/// <returns>The number of bytes read</returns>
+	size_t Read(std::vector<byte> &Output, size_t Offset, size_t Length) override;
+
+	/// <summary>
+	/// Read a single byte from the stream
+	/// </summary>
+	///
+	/// <returns>The read byte value</returns>
+	byte ReadByte() override;
+
+	/// <summary>
+	/// Reset the stream position to zero
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Seek to a position within the stream
+	/// </summary>
+	///
+	/// <param name="Offset">The offset position</param>
+	/// <param name="Origin">The starting point</param>
+	void Seek(ulong Offset, SeekOrigin Origin) override;
+
+	/// <summary>
+	/// Set the length of the stream; resizes the file and the mapping
+	/// </summary>
+	///
+	/// <param name="Length">The desired length</param>
+	void SetLength(ulong Length) override;
+
+	/// <summary>
+	/// Get a zero-copy pointer to a region of the mapped file
+	/// </summary>
+	///
+	/// <param name="Offset">The offset within the file</param>
+	/// <param name="Length">The length of the region; must be within the stream length</param>
+	///
+	/// <returns>A pointer to the mapped region, valid until the stream is resized or closed</returns>
+	const byte* View(ulong Offset, size_t Length);
+
+	/// <summary>
+	/// Writes an input buffer to the stream
+	/// </summary>
+	///
+	/// <param name="Input">The input array to write to the stream</param>
+	/// <param name="Offset">Offset within the input array at which to begin</param>
+	/// <param name="Length">The number of bytes to write</param>
+	void Write(const std::vector<byte> &Input, size_t Offset, size_t Length) override;
+
+	/// <summary>
+	/// Write a single byte from the stream
+	/// </summary>
+	///
+	/// <param name="Value">The byte value to write</param>
+	void WriteByte(byte Value) override;
+
+private:
+
+	void Remap(ulong Size);
+	void Unmap();
+};
+
+NAMESPACE_IOEND
+#endif
@@ -1,6 +1,7 @@
 #include "McEliece.h"
 #include "FFTM12T62.h"
 #include "GCM.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
 #include "Keccak512.h"
 #include "PrngFromName.h"
@@ -115,6 +116,8 @@ const MPKCParams McEliece::Parameters()
 
 void McEliece::Decapsulate(const std::vector<byte> &CipherText, std::vector<byte> &SharedSecret)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Asymmetric, CLASS_NAME, CipherText.size());
+
 	CexAssert(m_isInitialized, "The cipher has not been initialized");
 
 	std::vector<byte> e(0);
@@ -135,6 +138,7 @@ void McEliece::Decapsulate(const std::vector<byte> &CipherText, std::vector<byte
 	}
 
 	// hash the message to create the shared secret
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Hashing);
 	Digest::Keccak512 dgt;
 	SharedSecret.resize(dgt.DigestSize());
 	dgt.Compute(e, SharedSecret);
@@ -142,6 +146,8 @@ void McEliece::Decapsulate(const std::vector<byte> &CipherText, std::vector<byte
 
 void McEliece::Encapsulate(std::vector<byte> &CipherText, std::vector<byte> &SharedSecret)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Asymmetric, CLASS_NAME, 0);
+
 	CexAssert(m_isInitialized, "The cipher has not been initialized");
 
 	std::vector<byte> e(0);
@@ -158,6 +164,7 @@ void McEliece::Encapsulate(std::vector<byte> &CipherText, std::vector<byte> &Sha
 	}
 
 	// hash the message to create the shared secret
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Hashing);
 	Digest::Keccak512 dgt;
 	SharedSecret.resize(dgt.DigestSize());
 	dgt.Compute(e, SharedSecret);
@@ -165,6 +172,8 @@ void McEliece::Encapsulate(std::vector<byte> &CipherText, std::vector<byte> &Sha
 
 std::vector<byte> McEliece::Decrypt(const std::vector<byte> &CipherText)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Asymmetric, CLASS_NAME, CipherText.size());
+
 	CexAssert(m_isInitialized, "The cipher has not been initialized");
 
 	std::vector<byte> msg(0);
@@ -186,6 +195,8 @@ std::vector<byte> McEliece::Decrypt(const std::vector<byte> &CipherText)
 
 std::vector<byte> McEliece::Encrypt(const std::vector<byte> &Message)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Asymmetric, CLASS_NAME, Message.size());
+
 	CexAssert(m_isInitialized, "The cipher has not been initialized");
 
 	std::vector<byte> cpt(0);
@@ -205,6 +216,8 @@ std::vector<byte> McEliece::Encrypt(const std::vector<byte> &Message)
 
 IAsymmetricKeyPair* McEliece::Generate()
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Asymmetric, CLASS_NAME, 0);
+
 	CexAssert(m_mpkcParameters != MPKCParams::None, "The parameter setting is invalid");
 
 	std::vector<byte> pka(0);
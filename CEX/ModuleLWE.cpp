@@ -2,6 +2,7 @@
 #include "BCR.h"
 #include "FFTQ7681N256.h"
 #include "GCM.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
 #include "Keccak512.h"
 #include "MemUtils.h"
@@ -125,6 +126,8 @@ const MLWEParams ModuleLWE::Parameters()
 
 void ModuleLWE::Decapsulate(const std::vector<byte> &CipherText, std::vector<byte> &SharedSecret)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Asymmetric, CLASS_NAME, CipherText.size());
+
 	CexAssert(m_isInitialized, "The cipher has not been initialized");
 
 	std::vector<byte> msg(FFTQ7681N256::SEED_SIZE);
@@ -132,6 +135,7 @@ void ModuleLWE::Decapsulate(const std::vector<byte> &CipherText, std::vector<byt
 	// encrypt the message and generate the ciphertext
 	FFTQ7681N256::Decrypt(msg, CipherText, m_privateKey->R(), k);
 	// hash the message to create the shared secret
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Hashing);
 	Digest::Keccak512 dgt;
 	SharedSecret.resize(dgt.DigestSize());
 	dgt.Compute(msg, SharedSecret);
@@ -139,6 +143,8 @@ void ModuleLWE::Decapsulate(const std::vector<byte> &CipherText, std::vector<byt
 
 void ModuleLWE::Encapsulate(std::vector<byte> &CipherText, std::vector<byte> &SharedSecret)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Asymmetric, CLASS_NAME, 0);
+
 	CexAssert(m_isInitialized, "The cipher has not been initialized");
 
 	uint k = (m_mlweParameters == MLWEParams::Q7681N256K3) ? 3 : (m_mlweParameters == MLWEParams::Q7681N256K4) ? 4 : 2;
@@ -148,6 +154,7 @@ void ModuleLWE::Encapsulate(std::vector<byte> &CipherText, std::vector<byte> &Sh
 	// encrypt thew message and generate the ciphertext
 	FFTQ7681N256::Encrypt(CipherText, msg, m_publicKey->P(), m_rndGenerator, static_cast<uint>(m_mlweParameters));
 	// hash the message to create the shared secret
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Hashing);
 	Digest::Keccak512 dgt;
 	SharedSecret.resize(dgt.DigestSize());
 	dgt.Compute(msg, SharedSecret);
@@ -155,6 +162,8 @@ void ModuleLWE::Encapsulate(std::vector<byte> &CipherText, std::vector<byte> &Sh
 
 std::vector<byte> ModuleLWE::Decrypt(const std::vector<byte> &CipherText)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Asymmetric, CLASS_NAME, CipherText.size());
+
 	CexAssert(m_isInitialized, "The cipher has not been initialized");
 
 	std::vector<byte> sec(FFTQ7681N256::SEED_SIZE);
@@ -174,6 +183,8 @@ std::vector<byte> ModuleLWE::Decrypt(const std::vector<byte> &CipherText)
 
 std::vector<byte> ModuleLWE::Encrypt(const std::vector<byte> &Message)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Asymmetric, CLASS_NAME, Message.size());
+
 	CexAssert(m_isInitialized, "The cipher has not been initialized");
 
 	uint k = (m_mlweParameters == MLWEParams::Q7681N256K3) ? 3 : (m_mlweParameters == MLWEParams::Q7681N256K4) ? 4 : 2;
@@ -190,6 +201,8 @@ std::vector<byte> ModuleLWE::Encrypt(const std::vector<byte> &Message)
 
 IAsymmetricKeyPair* ModuleLWE::Generate()
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Asymmetric, CLASS_NAME, 0);
+
 	CexAssert(m_mlweParameters != MLWEParams::None, "The parameter setting is invalid");
 
 	uint k = (m_mlweParameters == MLWEParams::Q7681N256K3) ? 3 : (m_mlweParameters == MLWEParams::Q7681N256K4) ? 4 : 2;
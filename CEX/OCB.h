@@ -34,6 +34,7 @@
 
 #include "IAeadMode.h"
 #include "ISymmetricKey.h"
+#include "OCBT.h"
 
 NAMESPACE_MODE
 
@@ -103,6 +104,7 @@ NAMESPACE_MODE
 /// <list type="bullet">
 /// <item><description>OCB is an AEAD authenticated mode, additional data such as packet header information can be added to the authentication process.</description></item>
 /// <item><description>Additional data can be added using the SetAssociatedData(Input, Offset, Length) call.</description></item>
+/// <item><description>The mode is a thin adapter over OCBT&lt;IBlockCipher&gt;; use OCBT with a final cipher type (ex. OCBT&lt;AHX&gt;) to bind the engines at compile time.</description></item>
 /// <item><description>Calling the Finalize(Output, Offset, Length) function writes the MAC code to the output array in either encryption or decryption operation mode.</description></item>
 /// <item><description>The Verify(Input, Offset, Length) function can be used to compare the MAC code embedded with the cipher-text to the internal MAC code generated after a Decryption cycle.</description></item>
 /// <item><description>Encryption and decryption can both be pipelined (SSE3-128 or AVX-256), and multi-threaded.</description></item>
@@ -124,40 +126,14 @@ class OCB final : public IAeadMode
 {
 private:
 
-	static const std::string CLASS_NAME;
 	static const size_t BLOCK_SIZE = 16;
-	static const size_t PREFETCH_HASH = 16 * 32;
-	static const size_t MAX_NONCESIZE = 15;
-	static const size_t MAX_TAGSIZE = 16;
-	static const size_t MIN_NONCESIZE = 12;
-	static const size_t MIN_TAGSIZE = 12;
-
-	std::vector<byte> m_aadData;
-	bool m_aadLoaded;
-	bool m_aadPreserve;
-	bool m_autoIncrement;
+
 	std::unique_ptr<IBlockCipher> m_blockCipher;
-	std::vector<byte> m_checkSum;
 	BlockCiphers m_cipherType;
 	bool m_destroyEngine;
 	std::unique_ptr<IBlockCipher> m_hashCipher;
-	std::vector<std::vector<byte>> m_hashList;
 	bool m_isDestroyed;
-	bool m_isFinalized;
-	bool m_isInitialized;
-	ulong m_mainBlockCount;
-	bool m_isEncryption;
-	std::vector<SymmetricKeySize> m_legalKeySizes;
-	std::vector<byte> m_listAsterisk;
-	std::vector<byte> m_listDollar;
-	std::vector<byte> m_mainOffset;
-	std::vector<byte> m_mainOffset0;
-	std::vector<byte> m_mainStretch;
-	std::vector<byte> m_msgTag;
-	std::vector<byte> m_ocbNonce;
-	std::vector<byte> m_ocbVector;
-	ParallelOptions m_parallelProfile;
-	std::vector<byte> m_topInput;
+	OCBT<IBlockCipher> m_ocbMode;
 
 public:
 
@@ -364,7 +340,7 @@ public:
 	/// </summary>
 	/// 
 	/// <param name="Encryption">True if cipher is used for encryption, false to decrypt</param>
-	/// <param name="KeyParams">SymmetricKey containing the encryption Key and Nonce</param>
+	/// <param name="KeyParams">SymmetricKey containing the encryption Key and Nonce; an empty key loads a new nonce only, and can not change the cipher direction</param>
 	/// 
 	/// <exception cref="CryptoCipherModeException">Thrown if a null or invalid Key/Nonce is used</exception>
 	void Initialize(bool Encryption, ISymmetricKey &KeyParams) override;
@@ -423,23 +399,6 @@ public:
 	///
 	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not initialized for decryption</exception>
 	bool Verify(const std::vector<byte> &Input, const size_t Offset, const size_t Length) override;
-
-private:
-
-	void CalculateMac();
-	void Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void DoubleBlock(const std::vector<byte> &Input, std::vector<byte> &Output);
-	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void ExtendBlock(std::vector<byte> &Output, size_t Position);
-	void GenerateOffsets(const std::vector<byte> &Nonce);
-	void GetLSub(size_t N, std::vector<byte> &LSub);
-	uint Ntz(ulong X);
-	void ParallelDecrypt(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t Length);
-	void ParallelEncrypt(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t Length);
-	void ProcessPartial(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, size_t Length);
-	void ProcessSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t Length);
-	void Reset();
-	void Scope();
 };
 
 NAMESPACE_MODEEND
@@ -0,0 +1,916 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// A compile-time composed Offset CodeBook authenticated mode (OCB) template.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_OCBT_H
+#define CEX_OCBT_H
+
+#include "IAeadMode.h"
+#include "Instrumentation.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+#include "ParallelUtils.h"
+#include "SymmetricKey.h"
+#include "SymmetricKeyView.h"
+
+NAMESPACE_MODE
+
+/// <summary>
+/// An Offset CodeBook Authenticated Block Cipher Mode composed at compile time with its block cipher engines
+/// </summary>
+///
+/// <example>
+/// <description>Encrypting and authenticating with AES-NI engines bound to the mode:</description>
+/// <code>
+/// AHX engine, hash;
+/// OCBT&lt;AHX&gt; cipher(&amp;engine, &amp;hash);
+/// // initialize for encryption
+/// cipher.Initialize(true, SymmetricKey(Key, Nonce));
+/// cipher.Transform(Input, 0, Output, 0, Input.size());
+/// // append the mac code to the output
+/// cipher.Finalize(Output, Input.size(), cipher.MaxTagSize());
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <para>The template holds the complete OCB implementation; the OCB class is a thin IAeadMode adapter over OCBT&lt;IBlockCipher&gt;. \n
+/// The message cipher and the hash cipher (used for the offsets, the partial block pad and the tag) are both of type T,
+/// so with a final cipher type the wide Transform512/1024/2048 kernels in the parallel segment loop are bound statically and can be inlined.
+/// Output and tags are identical to the OCB class for the same cipher, key, nonce and associated data.</para>
+///
+/// <list type="bullet">
+/// <item><description>Neither engine is owned by the template, both must outlive it, and they must be separate instances of the same cipher configuration.</description></item>
+/// <item><description>A nonce-only key (empty key) reloads the offsets without re-keying the ciphers, as in the OCB class.</description></item>
+/// </list>
+/// </remarks>
+template<typename T>
+class OCBT final
+{
+private:
+
+	static const std::string CLASS_NAME;
+	static const size_t BLOCK_SIZE = 16;
+	static const size_t PREFETCH_HASH = 16 * 32;
+	static const size_t MAX_NONCESIZE = 15;
+	static const size_t MAX_TAGSIZE = 16;
+	static const size_t MIN_NONCESIZE = 12;
+	static const size_t MIN_TAGSIZE = 12;
+
+	std::vector<byte> m_aadData;
+	bool m_aadLoaded;
+	bool m_aadPreserve;
+	bool m_autoIncrement;
+	T* m_blockCipher;
+	std::vector<byte> m_checkSum;
+	T* m_hashCipher;
+	std::vector<std::vector<byte>> m_hashList;
+	bool m_isEncryption;
+	bool m_isFinalized;
+	bool m_isInitialized;
+	std::vector<SymmetricKeySize> m_legalKeySizes;
+	std::vector<byte> m_listAsterisk;
+	std::vector<byte> m_listDollar;
+	ulong m_mainBlockCount;
+	std::vector<byte> m_mainOffset;
+	std::vector<byte> m_mainOffset0;
+	std::vector<byte> m_mainStretch;
+	std::vector<byte> m_msgTag;
+	std::vector<byte> m_ocbNonce;
+	std::vector<byte> m_ocbVector;
+	ParallelOptions m_parallelProfile;
+	std::vector<byte> m_topInput;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	OCBT(const OCBT&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	OCBT& operator=(const OCBT&) = delete;
+
+	/// <summary>
+	/// Default constructor: default is restricted, this function has been deleted
+	/// </summary>
+	OCBT() = delete;
+
+	/// <summary>
+	/// Initialize the Cipher Mode using a message and a hash block cipher instance
+	/// </summary>
+	///
+	/// <param name="Cipher">The uninitialized message block cipher instance; can not be null, and is not deleted by this class</param>
+	/// <param name="HashCipher">The uninitialized hash block cipher instance, of the same cipher as Cipher; can not be null, and is not deleted by this class</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if a null block cipher is used</exception>
+	OCBT(T* Cipher, T* HashCipher)
+		:
+		m_aadData(BLOCK_SIZE),
+		m_aadLoaded(false),
+		m_aadPreserve(false),
+		m_autoIncrement(false),
+		m_blockCipher(Cipher != nullptr ? Cipher :
+			throw CryptoCipherModeException("OCB:CTor", "The Cipher can not be null!")),
+		m_checkSum(BLOCK_SIZE),
+		m_hashCipher(HashCipher != nullptr && HashCipher != Cipher ? HashCipher :
+			throw CryptoCipherModeException("OCB:CTor", "The hash Cipher can not be null or the message Cipher!")),
+		m_hashList(0),
+		m_isEncryption(false),
+		m_isFinalized(false),
+		m_isInitialized(false),
+		m_legalKeySizes(0),
+		m_listAsterisk(BLOCK_SIZE),
+		m_listDollar(BLOCK_SIZE),
+		m_mainBlockCount(0),
+		m_mainOffset(BLOCK_SIZE),
+		m_mainOffset0(BLOCK_SIZE),
+		m_mainStretch(BLOCK_SIZE + (BLOCK_SIZE / 2)),
+		m_msgTag(BLOCK_SIZE),
+		m_ocbNonce(0),
+		m_ocbVector(0),
+		m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize() + PREFETCH_HASH, true),
+		m_topInput(0)
+	{
+		Scope();
+	}
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~OCBT()
+	{
+		m_aadLoaded = false;
+		m_aadPreserve = false;
+		m_autoIncrement = false;
+		m_blockCipher = nullptr;
+		m_hashCipher = nullptr;
+		m_isFinalized = false;
+		m_isEncryption = false;
+		m_isInitialized = false;
+		m_mainBlockCount = 0;
+		m_parallelProfile.Reset();
+
+		Utility::IntUtils::ClearVector(m_aadData);
+		Utility::IntUtils::ClearVector(m_checkSum);
+		Utility::IntUtils::ClearVector(m_hashList);
+		Utility::IntUtils::ClearVector(m_legalKeySizes);
+		Utility::IntUtils::ClearVector(m_listAsterisk);
+		Utility::IntUtils::ClearVector(m_listDollar);
+		Utility::IntUtils::ClearVector(m_mainOffset);
+		Utility::IntUtils::ClearVector(m_mainOffset0);
+		Utility::IntUtils::ClearVector(m_mainStretch);
+		Utility::IntUtils::ClearVector(m_msgTag);
+		Utility::IntUtils::ClearVector(m_ocbNonce);
+		Utility::IntUtils::ClearVector(m_ocbVector);
+		Utility::IntUtils::ClearVector(m_topInput);
+	}
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read/Write: Enable auto-incrementing of the input nonce each time the Finalize method is called
+	/// </summary>
+	bool &AutoIncrement() { return m_autoIncrement; }
+
+	/// <summary>
+	/// Read Only: Block size of internal cipher in bytes
+	/// </summary>
+	const size_t BlockSize() { return BLOCK_SIZE; }
+
+	/// <summary>
+	/// Read Only: The underlying message Block Cipher instance
+	/// </summary>
+	T* Engine() { return m_blockCipher; }
+
+	/// <summary>
+	/// Read Only: True if initialized for encryption, False for decryption
+	/// </summary>
+	const bool IsEncryption() { return m_isEncryption; }
+
+	/// <summary>
+	/// Read Only: The Block Cipher is ready to transform data
+	/// </summary>
+	const bool IsInitialized() { return m_isInitialized; }
+
+	/// <summary>
+	/// Read Only: Processor parallelization availability
+	/// </summary>
+	const bool IsParallel() { return m_parallelProfile.IsParallel(); }
+
+	/// <summary>
+	/// Read Only: Array of allowed cipher input key byte-sizes
+	/// </summary>
+	const std::vector<SymmetricKeySize> &LegalKeySizes() { return m_legalKeySizes; }
+
+	/// <summary>
+	/// Read Only: Maximum size of the mac code in bytes
+	/// </summary>
+	const size_t MaxTagSize() { return MAX_TAGSIZE; }
+
+	/// <summary>
+	/// Read Only: Minimum size of the mac code in bytes
+	/// </summary>
+	const size_t MinTagSize() { return MIN_TAGSIZE; }
+
+	/// <summary>
+	/// Read Only: The cipher modes class name
+	/// </summary>
+	const std::string Name() { return CLASS_NAME + "-" + m_blockCipher->Name(); }
+
+	/// <summary>
+	/// Read Only: Parallel block size; the byte-size of the input/output data arrays passed to a transform that trigger parallel processing
+	/// </summary>
+	const size_t ParallelBlockSize() { return m_parallelProfile.ParallelBlockSize(); }
+
+	/// <summary>
+	/// Read/Write: Parallel and SIMD capability flags and sizes
+	/// </summary>
+	ParallelOptions &ParallelProfile() { return m_parallelProfile; }
+
+	/// <summary>
+	/// Read/Write: Persist the associated data across messages when AutoIncrement() is enabled
+	/// </summary>
+	bool &PreserveAD() { return m_aadPreserve; }
+
+	/// <summary>
+	/// Read Only: Returns the full finalized MAC code value array
+	/// </summary>
+	const std::vector<byte> Tag()
+	{
+		CexAssert(m_isFinalized, "The cipher mode has not been finalized");
+
+		return m_msgTag;
+	}
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Decrypt a block of bytes with offset parameters.
+	/// <para>Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of encrypted bytes</param>
+	/// <param name="InOffset">Starting offset within the Input array</param>
+	/// <param name="Output">The output array of decrypted bytes</param>
+	/// <param name="OutOffset">Starting offset within the Output array</param>
+	void DecryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+	{
+		CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+		CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
+
+		Utility::MemUtils::COPY128(Input, InOffset, Output, OutOffset);
+		Utility::MemUtils::XorBlock(GetLSub(Ntz(++m_mainBlockCount)), 0, m_mainOffset, 0, BLOCK_SIZE);
+		Utility::MemUtils::XorBlock(m_mainOffset, 0, Output, OutOffset, BLOCK_SIZE);
+
+		m_blockCipher->Transform(Output, OutOffset, Output, OutOffset);
+		Utility::MemUtils::XorBlock(m_mainOffset, 0, Output, OutOffset, BLOCK_SIZE);
+		Utility::MemUtils::XorBlock(Output, OutOffset, m_checkSum, 0, BLOCK_SIZE);
+	}
+
+	/// <summary>
+	/// Encrypt a block of bytes using offset parameters.
+	/// <para>Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of plain text bytes</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of encrypted bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	void EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+	{
+		CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+		CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
+
+		Utility::MemUtils::COPY128(Input, InOffset, Output, OutOffset);
+		Utility::MemUtils::XorBlock(Output, OutOffset, m_checkSum, 0, BLOCK_SIZE);
+		Utility::MemUtils::XorBlock(GetLSub(Ntz(++m_mainBlockCount)), 0, m_mainOffset, 0, BLOCK_SIZE);
+		Utility::MemUtils::XorBlock(m_mainOffset, 0, Output, OutOffset, BLOCK_SIZE);
+
+		m_blockCipher->Transform(Output, OutOffset, Output, OutOffset);
+		Utility::MemUtils::XorBlock(m_mainOffset, 0, Output, OutOffset, BLOCK_SIZE);
+	}
+
+	/// <summary>
+	/// Calculate the MAC code (Tag) and copy it to the Output array
+	/// </summary>
+	///
+	/// <param name="Output">The output array that receives the authentication code</param>
+	/// <param name="Offset">The starting offset within the output array</param>
+	/// <param name="Length">The number of MAC code bytes to write to the output array</param>
+	void Finalize(std::vector<byte> &Output, const size_t Offset, const size_t Length)
+	{
+		CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::CipherMode, CLASS_NAME, 0);
+
+		CexAssert(m_isInitialized, "The cipher mode has not been initialized");
+		CexAssert(Length >= MIN_TAGSIZE || Length <= BLOCK_SIZE, "The cipher mode has not been initialized");
+
+		CalculateMac();
+		Utility::MemUtils::Copy(m_msgTag, 0, Output, Offset, Length);
+	}
+
+	/// <summary>
+	/// Initialize the Cipher instance
+	/// </summary>
+	///
+	/// <param name="Encryption">True if cipher is used for encryption, False to decrypt</param>
+	/// <param name="KeyParams">SymmetricKey containing the encryption Key and Nonce; an empty key loads a new nonce only, and can not change the cipher direction</param>
+	///
+	/// <exception cref="CryptoSymmetricCipherException">Thrown if an invalid key or nonce, or parallel block size is used</exception>
+	void Initialize(bool Encryption, ISymmetricKey &KeyParams)
+	{
+		Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+		Scope();
+
+		if (kv.Key().size() == 0)
+		{
+			if (kv.Nonce() == m_ocbVector)
+			{
+				throw CryptoSymmetricCipherException("OCB:Initialize", "The nonce can not be zeroised or reused!");
+			}
+			if (!m_blockCipher->IsInitialized())
+			{
+				throw CryptoSymmetricCipherException("OCB:Initialize", "First initialization requires a key and nonce!");
+			}
+			// the block cipher key schedule is expanded for one direction only
+			if (m_blockCipher->IsEncryption() != Encryption)
+			{
+				throw CryptoSymmetricCipherException("OCB:Initialize", "The cipher direction can only be changed with a key!");
+			}
+		}
+		else
+		{
+			if (!SymmetricKeySize::Contains(LegalKeySizes(), kv.Key().size()))
+			{
+				throw CryptoSymmetricCipherException("OCB:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
+			}
+
+			m_hashCipher->Initialize(true, KeyParams);
+			m_blockCipher->Initialize(Encryption, KeyParams);
+
+			// the L values and the nonce stretch depend only on the key, and are retained until the next key
+			Utility::MemUtils::Clear(m_listAsterisk, 0, m_listAsterisk.size());
+			m_hashCipher->Transform(m_listAsterisk, 0, m_listAsterisk, 0);
+			DoubleBlock(m_listAsterisk, m_listDollar);
+			std::vector<byte> hash(BLOCK_SIZE);
+			DoubleBlock(m_listDollar, hash);
+			m_hashList.clear();
+			m_hashList.reserve(PREFETCH_HASH);
+			m_hashList.push_back(hash);
+			m_topInput.clear();
+		}
+
+		if (kv.Nonce().size() > MAX_NONCESIZE || kv.Nonce().size() < MIN_NONCESIZE)
+		{
+			throw CryptoSymmetricCipherException("OCB:Initialize", "Requires a nonce of at least 12, and no longer than 15 bytes!");
+		}
+		if (m_parallelProfile.IsParallel() && m_parallelProfile.ParallelBlockSize() < m_parallelProfile.ParallelMinimumSize() || m_parallelProfile.ParallelBlockSize() > m_parallelProfile.ParallelMaximumSize())
+		{
+			throw CryptoSymmetricCipherException("OCB:Initialize", "The parallel block size is out of bounds!");
+		}
+		if (m_parallelProfile.IsParallel() && m_parallelProfile.ParallelBlockSize() % m_parallelProfile.ParallelMinimumSize() != 0)
+		{
+			throw CryptoSymmetricCipherException("OCB:Initialize", "The parallel block size must be evenly aligned to the ParallelMinimumSize!");
+		}
+
+		m_isEncryption = Encryption;
+		m_ocbNonce = kv.Nonce();
+		m_ocbVector = m_ocbNonce;
+		GenerateOffsets(m_ocbVector);
+
+		if (m_isFinalized)
+		{
+			Utility::MemUtils::Clear(m_msgTag, 0, m_msgTag.size());
+			m_isFinalized = false;
+		}
+
+		m_isInitialized = true;
+	}
+
+	/// <summary>
+	/// Set the maximum number of threads allocated when using multi-threaded processing
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	void ParallelMaxDegree(size_t Degree)
+	{
+		CexAssert(Degree != 0, "parallel degree can not be zero");
+		CexAssert(Degree % 2 == 0, "parallel degree must be an even number");
+		CexAssert(Degree <= m_parallelProfile.ProcessorCount(), "parallel degree can not exceed processor count");
+
+		m_parallelProfile.SetMaxDegree(Degree);
+	}
+
+	/// <summary>
+	/// Add additional data to the authentication generator; must be called after Initialize and before the first Transform
+	/// </summary>
+	///
+	/// <param name="Input">The input array of bytes</param>
+	/// <param name="Offset">Starting offset within the input array</param>
+	/// <param name="Length">The number of bytes to process</param>
+	void SetAssociatedData(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
+	{
+		CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+		CexAssert(!m_aadLoaded, "The associated data has already been set");
+
+		size_t blkCnt = 0;
+		size_t blkLen = Length;
+		size_t blkOff = Offset;
+		std::vector<byte> offsetHash(BLOCK_SIZE);
+
+		while (blkLen >= BLOCK_SIZE)
+		{
+			std::vector<byte> tmp(BLOCK_SIZE);
+			Utility::MemUtils::COPY128(Input, blkOff, tmp, 0);
+			Utility::MemUtils::XorBlock(GetLSub(Ntz(++blkCnt)), 0, offsetHash, 0, BLOCK_SIZE);
+			Utility::MemUtils::XorBlock(offsetHash, 0, tmp, 0, BLOCK_SIZE);
+
+			m_hashCipher->Transform(tmp, 0, tmp, 0);
+			Utility::MemUtils::XorBlock(tmp, 0, m_aadData, 0, BLOCK_SIZE);
+
+			blkOff += BLOCK_SIZE;
+			blkLen -= BLOCK_SIZE;
+		}
+
+		if (blkLen != 0)
+		{
+			std::vector<byte> tmp(BLOCK_SIZE);
+			Utility::MemUtils::Copy(Input, blkOff, tmp, 0, blkLen);
+			ExtendBlock(tmp, blkLen);
+
+			Utility::MemUtils::XorBlock(m_listAsterisk, 0, offsetHash, 0, BLOCK_SIZE);
+			Utility::MemUtils::XorBlock(offsetHash, 0, tmp, 0, BLOCK_SIZE);
+
+			m_hashCipher->Transform(tmp, 0, tmp, 0);
+			Utility::MemUtils::XorBlock(tmp, 0, m_aadData, 0, BLOCK_SIZE);
+		}
+
+		m_aadLoaded = true;
+	}
+
+	/// <summary>
+	/// Transform a length of bytes with offset parameters
+	/// </summary>
+	///
+	/// <param name="Input">The input array of bytes to transform</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of transformed bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+	{
+		CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::CipherMode, CLASS_NAME, Length);
+
+		CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+		CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the the block-size!");
+
+		if (m_parallelProfile.IsParallel() && Length >= m_parallelProfile.ParallelBlockSize())
+		{
+			CEX_INSTRUMENT_PARALLEL();
+
+			if (m_isEncryption)
+			{
+				ParallelEncrypt(Input, InOffset, Output, OutOffset, Length);
+			}
+			else
+			{
+				ParallelDecrypt(Input, InOffset, Output, OutOffset, Length);
+			}
+		}
+		else
+		{
+			const size_t BLKCNT = Length / BLOCK_SIZE;
+			if (m_isEncryption)
+			{
+				for (size_t i = 0; i < BLKCNT; ++i)
+				{
+					EncryptBlock(Input, InOffset + i * BLOCK_SIZE, Output, OutOffset + i * BLOCK_SIZE);
+				}
+			}
+			else
+			{
+				for (size_t i = 0; i < BLKCNT; ++i)
+				{
+					DecryptBlock(Input, InOffset + (i * BLOCK_SIZE), Output, OutOffset + (i * BLOCK_SIZE));
+				}
+			}
+
+			if (Length % BLOCK_SIZE != 0)
+			{
+				const size_t BLKOFF = (BLKCNT * BLOCK_SIZE);
+				ProcessPartial(Input, InOffset + BLKOFF, Output, OutOffset + BLKOFF, Length - BLKOFF);
+			}
+		}
+	}
+
+	/// <summary>
+	/// Generate the internal MAC code and compare it with the tag contained in the Input array
+	/// </summary>
+	///
+	/// <param name="Input">The input array containing the expected authentication code</param>
+	/// <param name="Offset">The starting offset within the input array</param>
+	/// <param name="Length">The number of bytes to compare</param>
+	///
+	/// <returns>Returns false if the MAC code does not match</returns>
+	bool Verify(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
+	{
+		CexAssert(!m_isEncryption, "the cipher mode has not been initialized for decryption");
+		CexAssert(Length >= MIN_TAGSIZE || Length <= BLOCK_SIZE, "the length must be minimum of 12 and maximum of MAC code size");
+		CexAssert(!(!m_isInitialized && !m_isFinalized), "the cipher mode has not been initialized for decryption");
+
+		if (!m_isFinalized)
+		{
+			CalculateMac();
+		}
+
+		return Utility::IntUtils::Compare(m_msgTag, 0, Input, Offset, Length);
+	}
+
+private:
+
+	void CalculateMac()
+	{
+		Utility::MemUtils::XOR128(m_mainOffset, 0, m_checkSum, 0);
+		Utility::MemUtils::XOR128(m_listDollar, 0, m_checkSum, 0);
+
+		m_hashCipher->Transform(m_checkSum, 0, m_checkSum, 0);
+
+		Utility::MemUtils::XOR128(m_aadData, 0, m_checkSum, 0);
+		Utility::MemUtils::COPY128(m_checkSum, 0, m_msgTag, 0);
+
+		Reset();
+
+		if (m_autoIncrement)
+		{
+			Utility::IntUtils::BeIncrement8(m_ocbNonce);
+			std::vector<byte> zero(0);
+			Key::Symmetric::SymmetricKey kp(zero, m_ocbNonce);
+			Initialize(m_isEncryption, kp);
+		}
+
+		m_isFinalized = true;
+	}
+
+	void DoubleBlock(const std::vector<byte> &Input, std::vector<byte> &Output)
+	{
+		uint carry = Utility::IntUtils::ShiftLeft(Input, Output);
+		uint x = (1 - carry) << 3;
+		byte n = (x == 0) ? 0x87 : static_cast<byte>(static_cast<ulong>(0x87) >> x);
+
+		Output[MAX_NONCESIZE] ^= n;
+	}
+
+	void ExtendBlock(std::vector<byte> &Output, size_t Position)
+	{
+		Output[Position] = 0x80;
+		++Position;
+
+		if (Position < BLOCK_SIZE)
+		{
+			Utility::MemUtils::Clear(Output, Position, Output.size() - Position);
+		}
+	}
+
+	void GenerateOffsets(const std::vector<byte> &Nonce)
+	{
+		std::vector<byte> tmpNonce(BLOCK_SIZE);
+		Utility::MemUtils::Copy(Nonce, 0, tmpNonce, BLOCK_SIZE - Nonce.size(), Nonce.size());
+		tmpNonce[0] = static_cast<byte>(tmpNonce.size() << 4);
+		tmpNonce[MAX_NONCESIZE - Nonce.size()] |= 1;
+		uint bottom = tmpNonce[MAX_NONCESIZE] & 0x3F;
+		tmpNonce[MAX_NONCESIZE] &= 0xC0;
+
+		// when used with incrementing nonces, the cipher is only applied once every 64 inits
+		if (tmpNonce != m_topInput)
+		{
+			std::vector<byte> kTop(BLOCK_SIZE);
+			m_topInput = tmpNonce;
+			m_hashCipher->Transform(m_topInput, 0, kTop, 0);
+			Utility::MemUtils::COPY128(kTop, 0, m_mainStretch, 0);
+
+			for (size_t i = 0; i < 8; ++i)
+			{
+				m_mainStretch[BLOCK_SIZE + i] = static_cast<byte>(kTop[i] ^ kTop[i + 1]);
+			}
+		}
+
+		const size_t BTMSZE = bottom % 8;
+		size_t btmLen = bottom / 8;
+
+		if (BTMSZE == 0)
+		{
+			Utility::MemUtils::COPY128(m_mainStretch, btmLen, m_mainOffset0, 0);
+		}
+		else
+		{
+			for (size_t i = 0; i < BLOCK_SIZE; ++i)
+			{
+				ulong b1 = m_mainStretch[btmLen];
+				++btmLen;
+				ulong b2 = m_mainStretch[btmLen];
+				m_mainOffset0[i] = static_cast<byte>((b1 << BTMSZE) | (b2 >> (8 - BTMSZE)));
+			}
+		}
+
+		Utility::MemUtils::COPY128(m_mainOffset0, 0, m_mainOffset, 0);
+	}
+
+	const std::vector<byte> &GetLSub(size_t N)
+	{
+		while (N >= m_hashList.size())
+		{
+			std::vector<byte> tmpL(BLOCK_SIZE);
+			DoubleBlock(m_hashList[m_hashList.size() - 1], tmpL);
+			m_hashList.push_back(tmpL);
+		}
+
+		return m_hashList[N];
+	}
+
+	uint Ntz(ulong X)
+	{
+		uint zCnt = 0;
+
+		while (!(X & 1))
+		{
+			X >>= 1;
+			++zCnt;
+		}
+
+		return zCnt;
+	}
+
+	void ParallelDecrypt(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t Length)
+	{
+		const size_t BLKCNT = Length / BLOCK_SIZE;
+		const size_t ALNLEN = Length - (Length % BLOCK_SIZE);
+		const size_t OUTOFF = OutOffset;
+
+		// copy data into working output
+		Utility::MemUtils::Copy(Input, InOffset, Output, OutOffset, ALNLEN);
+		// create the offset chain
+		std::vector<byte> offsetChain(ALNLEN);
+
+		for (size_t i = 0; i < BLKCNT; ++i)
+		{
+			Utility::MemUtils::XorBlock(GetLSub(Ntz(++m_mainBlockCount)), 0, m_mainOffset, 0, BLOCK_SIZE);
+			Utility::MemUtils::COPY128(m_mainOffset, 0, offsetChain, i * BLOCK_SIZE);
+		}
+
+		// parallel offsets
+		const size_t PRLSZE = m_parallelProfile.ParallelBlockSize();
+		const size_t CNKSZE = PRLSZE / m_parallelProfile.ParallelMaxDegree();
+		size_t chainPos = 0;
+
+		while (Length >= PRLSZE)
+		{
+			Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Output, OutOffset, &offsetChain, chainPos, CNKSZE](size_t i)
+			{
+				this->ProcessSegment(offsetChain, chainPos + (i * CNKSZE), Output, OutOffset + (i * CNKSZE), CNKSZE);
+			});
+
+			Length -= PRLSZE;
+			OutOffset += PRLSZE;
+			chainPos += PRLSZE;
+		}
+
+		if (Length != 0)
+		{
+			while (Length >= BLOCK_SIZE)
+			{
+				Utility::MemUtils::XorBlock(offsetChain, chainPos, Output, OutOffset, BLOCK_SIZE);
+				m_blockCipher->Transform(Output, OutOffset, Output, OutOffset);
+				Utility::MemUtils::XorBlock(offsetChain, chainPos, Output, OutOffset, BLOCK_SIZE);
+
+				Length -= BLOCK_SIZE;
+				OutOffset += BLOCK_SIZE;
+				chainPos += BLOCK_SIZE;
+			}
+
+			if (Length != 0)
+			{
+				ProcessPartial(Input, InOffset + ALNLEN, Output, OutOffset, Length);
+			}
+		}
+
+		// update the checksum
+		for (size_t i = 0; i < BLKCNT; ++i)
+		{
+			Utility::MemUtils::XorBlock(Output, OUTOFF + (i * BLOCK_SIZE), m_checkSum, 0, BLOCK_SIZE);
+		}
+	}
+
+	void ParallelEncrypt(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t Length)
+	{
+		const size_t BLKCNT = Length / BLOCK_SIZE;
+		const size_t ALNLEN = Length - (Length % BLOCK_SIZE);
+
+		// copy data into working output
+		Utility::MemUtils::Copy(Input, InOffset, Output, OutOffset, ALNLEN);
+
+		// pre-fold the checksum
+		for (size_t i = 0; i < BLKCNT; ++i)
+		{
+			Utility::MemUtils::XOR128(Output, OutOffset + (i * BLOCK_SIZE), m_checkSum, 0);
+		}
+
+		// create the offset chain
+		std::vector<byte> offsetChain(ALNLEN);
+
+		for (size_t i = 0; i < BLKCNT; ++i)
+		{
+			Utility::MemUtils::XOR128(GetLSub(Ntz(++m_mainBlockCount)), 0, m_mainOffset, 0);
+			Utility::MemUtils::COPY128(m_mainOffset, 0, offsetChain, i * BLOCK_SIZE);
+		}
+
+		// parallel offsets
+		const size_t PRLSZE = m_parallelProfile.ParallelBlockSize();
+		const size_t CNKSZE = PRLSZE / m_parallelProfile.ParallelMaxDegree();
+		size_t chainPos = 0;
+
+		while (Length >= PRLSZE)
+		{
+			Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Output, OutOffset, &offsetChain, chainPos, CNKSZE](size_t i)
+			{
+				this->ProcessSegment(offsetChain, chainPos + (i * CNKSZE), Output, OutOffset + (i * CNKSZE), CNKSZE);
+			});
+
+			Length -= PRLSZE;
+			OutOffset += PRLSZE;
+			chainPos += PRLSZE;
+		}
+
+		if (Length != 0)
+		{
+			while (Length >= BLOCK_SIZE)
+			{
+				Utility::MemUtils::XOR128(offsetChain, chainPos, Output, OutOffset);
+				m_blockCipher->Transform(Output, OutOffset, Output, OutOffset);
+				Utility::MemUtils::XOR128(offsetChain, chainPos, Output, OutOffset);
+
+				Length -= BLOCK_SIZE;
+				OutOffset += BLOCK_SIZE;
+				chainPos += BLOCK_SIZE;
+			}
+
+			if (Length != 0)
+			{
+				ProcessPartial(Input, InOffset + ALNLEN, Output, OutOffset, Length);
+			}
+		}
+	}
+
+	void ProcessPartial(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, size_t Length)
+	{
+		if (m_isEncryption)
+		{
+			Utility::MemUtils::Copy(Input, InOffset, Output, OutOffset, Length);
+			ExtendBlock(Output, OutOffset + Length);
+
+			Utility::MemUtils::XorBlock(Output, OutOffset, m_checkSum, 0, Length + 1);
+			Utility::MemUtils::XOR128(m_listAsterisk, 0, m_mainOffset, 0);
+
+			std::vector<byte> pad(BLOCK_SIZE);
+			m_hashCipher->Transform(m_mainOffset, 0, pad, 0);
+			Utility::MemUtils::XOR128(pad, 0, Output, OutOffset);
+		}
+		else
+		{
+			Utility::MemUtils::Copy(Input, InOffset, Output, OutOffset, Length);
+			Utility::MemUtils::XOR128(m_listAsterisk, 0, m_mainOffset, 0);
+
+			std::vector<byte> pad(BLOCK_SIZE);
+			m_hashCipher->Transform(m_mainOffset, 0, pad, 0);
+			Utility::MemUtils::XorBlock(pad, 0, Output, OutOffset, Length);
+
+			std::vector<byte> tmp(BLOCK_SIZE);
+			Utility::MemUtils::Copy(Output, OutOffset, tmp, 0, Length);
+			ExtendBlock(tmp, Length);
+			Utility::MemUtils::XOR128(tmp, 0, m_checkSum, 0);
+		}
+	}
+
+	void ProcessSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t Length)
+	{
+#if defined(__AVX512__)
+		const size_t AVX512BLK = 16 * BLOCK_SIZE;
+		if (Length >= AVX512BLK)
+		{
+			const size_t PBKALN = Length - (Length % AVX512BLK);
+			const size_t SUBBLK = PBKALN / AVX512BLK;
+
+			Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
+
+			for (size_t i = 0; i < SUBBLK; ++i)
+			{
+				m_blockCipher->Transform2048(Output, OutOffset + (i * AVX512BLK), Output, OutOffset + (i * AVX512BLK));
+			}
+
+			Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
+		}
+#elif defined(__AVX2__)
+		const size_t AVX2BLK = 8 * BLOCK_SIZE;
+		if (Length >= AVX2BLK)
+		{
+			const size_t PBKALN = Length - (Length % AVX2BLK);
+			const size_t SUBBLK = PBKALN / AVX2BLK;
+
+			Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
+
+			for (size_t i = 0; i < SUBBLK; ++i)
+			{
+				m_blockCipher->Transform1024(Output, OutOffset + (i * AVX2BLK), Output, OutOffset + (i * AVX2BLK));
+			}
+
+			Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
+		}
+#elif defined(__AVX__)
+		const size_t AVXBLK = 4 * BLOCK_SIZE;
+		if (Length >= AVXBLK)
+		{
+			const size_t PBKALN = Length - (Length % AVXBLK);
+			const size_t SUBBLK = PBKALN / AVXBLK;
+			Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
+
+			for (size_t i = 0; i < SUBBLK; ++i)
+			{
+				m_blockCipher->Transform512(Output, OutOffset + (i * AVXBLK), Output, OutOffset + (i * AVXBLK));
+			}
+
+			Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
+		}
+#else
+		const size_t PBKALN = Length - (Length % BLOCK_SIZE);
+		const size_t SUBBLK = PBKALN / BLOCK_SIZE;
+		Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
+
+		for (size_t i = 0; i < SUBBLK; ++i)
+		{
+			m_blockCipher->Transform(Output, OutOffset + (i * BLOCK_SIZE), Output, OutOffset + (i * BLOCK_SIZE));
+		}
+
+		Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
+#endif
+	}
+
+	void Reset()
+	{
+		if (!m_aadPreserve)
+		{
+			m_aadLoaded = false;
+			Utility::MemUtils::Clear(m_aadData, 0, m_aadData.size());
+		}
+
+		m_mainBlockCount = 0;
+		Utility::MemUtils::Clear(m_checkSum, 0, m_checkSum.size());
+		Utility::MemUtils::Clear(m_mainOffset, 0, m_mainOffset.size());
+		Utility::MemUtils::Clear(m_mainOffset0, 0, m_mainOffset0.size());
+		Utility::MemUtils::Clear(m_ocbVector, 0, m_ocbVector.size());
+		m_isInitialized = false;
+	}
+
+	void Scope()
+	{
+		std::vector<SymmetricKeySize> keySizes = m_blockCipher->LegalKeySizes();
+		m_legalKeySizes.resize(keySizes.size());
+
+		for (size_t i = 0; i < m_legalKeySizes.size(); ++i)
+		{
+			m_legalKeySizes[i] = SymmetricKeySize(keySizes[i].KeySize(), MAX_NONCESIZE, keySizes[i].NonceSize());
+		}
+
+		if (!m_parallelProfile.IsDefault())
+		{
+			m_parallelProfile.Calculate();
+		}
+	}
+};
+
+template<typename T>
+const std::string OCBT<T>::CLASS_NAME("OCB");
+
+NAMESPACE_MODEEND
+#endif
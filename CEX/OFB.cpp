@@ -1,6 +1,8 @@
 #include "OFB.h"
 #include "BlockCipherFromName.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_MODE
 
@@ -164,20 +166,22 @@ void OFB::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 
 void OFB::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (KeyParams.Nonce().size() < 1)
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (kv.Nonce().size() < 1)
 	{
 		throw CryptoSymmetricCipherException("OFB:Initialize", "Requires a minimum 1 bytes of Nonce!");
 	}
-	if (KeyParams.Nonce().size() > m_blockCipher->BlockSize())
+	if (kv.Nonce().size() > m_blockCipher->BlockSize())
 	{
 		throw CryptoSymmetricCipherException("OFB:Initialize", "Nonce can not be larger than the cipher block size!");
 	}
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), kv.Key().size()))
 	{
 		throw CryptoSymmetricCipherException("OFB:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() members in length.");
 	}
 
-	std::vector<byte> tmpIv = KeyParams.Nonce();
+	std::vector<byte> tmpIv = kv.Nonce();
 	m_blockCipher->Initialize(true, KeyParams);
 
 	if (tmpIv.size() < m_ofbVector.size())
@@ -201,6 +205,8 @@ void OFB::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 
 void OFB::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::CipherMode, CLASS_NAME, Length);
+
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= m_blockCipher->BlockSize(), "The data arrays are smaller than the the block-size!");
 	CexAssert(Length % m_blockCipher->BlockSize() == 0, "The length must be evenly divisible by the block ciphers block-size!");
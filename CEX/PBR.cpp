@@ -186,10 +186,17 @@ uint PBR::GetMinimumSeedSize(Digests RngEngine)
 	switch (RngEngine)
 	{
 		case Digests::Keccak256:
+		case Digests::ParallelHash256:
 		{
 			seedSize = 136;
 			break;
 		}
+		case Digests::KangarooTwelve:
+		case Digests::ParallelHash128:
+		{
+			seedSize = 168;
+			break;
+		}
 		case Digests::Keccak512:
 		case Digests::Keccak1024:
 		{
@@ -197,6 +204,7 @@ uint PBR::GetMinimumSeedSize(Digests RngEngine)
 			break;
 		}
 		case Digests::Blake256:
+		case Digests::Blake3:
 		case Digests::SHA256:
 		case Digests::Skein512:
 		{
@@ -0,0 +1,123 @@
+#include "ParallelCalibration.h"
+#include <fstream>
+#include <sstream>
+
+NAMESPACE_COMMON
+
+const std::string ParallelCalibration::DEF_PROFILE("cex-parallel.cfg");
+std::map<std::string, ParallelCalibration::CalibrationEntry> ParallelCalibration::m_calibrationTable;
+std::mutex ParallelCalibration::m_tableLock;
+
+//~~~Public Functions~~~//
+
+void ParallelCalibration::Clear()
+{
+	std::lock_guard<std::mutex> lock(m_tableLock);
+
+	m_calibrationTable.clear();
+}
+
+bool ParallelCalibration::Find(const std::string &Name, size_t &Threshold, size_t &MaxDegree)
+{
+	std::lock_guard<std::mutex> lock(m_tableLock);
+	bool ret = false;
+
+	std::map<std::string, CalibrationEntry>::const_iterator itr = m_calibrationTable.find(Name);
+
+	if (itr != m_calibrationTable.end())
+	{
+		Threshold = itr->second.Threshold;
+		MaxDegree = itr->second.MaxDegree;
+		ret = true;
+	}
+
+	return ret;
+}
+
+bool ParallelCalibration::Load(const std::string &Path)
+{
+	std::lock_guard<std::mutex> lock(m_tableLock);
+
+	return Read(Path);
+}
+
+bool ParallelCalibration::Save(const std::string &Path)
+{
+	std::lock_guard<std::mutex> lock(m_tableLock);
+	std::ofstream prf(Path.c_str(), std::ios::out | std::ios::trunc);
+	bool ret = false;
+
+	if (prf.is_open())
+	{
+		prf << "# CEX parallel calibration profile; name=threshold,degree" << std::endl;
+
+		for (std::map<std::string, CalibrationEntry>::const_iterator itr = m_calibrationTable.begin(); itr != m_calibrationTable.end(); ++itr)
+		{
+			prf << itr->first << "=" << itr->second.Threshold << "," << itr->second.MaxDegree << std::endl;
+		}
+
+		ret = prf.good();
+	}
+
+	return ret;
+}
+
+void ParallelCalibration::Store(const std::string &Name, size_t Threshold, size_t MaxDegree)
+{
+	std::lock_guard<std::mutex> lock(m_tableLock);
+
+	m_calibrationTable[Name] = CalibrationEntry(Threshold, MaxDegree);
+}
+
+//~~~Private Functions~~~//
+
+bool ParallelCalibration::Read(const std::string &Path)
+{
+	std::ifstream prf(Path.c_str());
+	bool ret = false;
+
+	if (prf.is_open())
+	{
+		std::map<std::string, CalibrationEntry> tmpT;
+		std::string line;
+
+		while (std::getline(prf, line))
+		{
+			if (line.size() != 0 && line[line.size() - 1] == '\r')
+			{
+				line.resize(line.size() - 1);
+			}
+
+			if (line.size() == 0 || line[0] == '#')
+			{
+				continue;
+			}
+
+			const size_t KEYPOS = line.find('=');
+			const size_t DGRPOS = line.find(',', KEYPOS);
+
+			// malformed lines are skipped, the rest of the profile is still applied
+			if (KEYPOS == std::string::npos || KEYPOS == 0 || DGRPOS == std::string::npos)
+			{
+				continue;
+			}
+
+			std::istringstream thrStm(line.substr(KEYPOS + 1, DGRPOS - KEYPOS - 1));
+			std::istringstream dgrStm(line.substr(DGRPOS + 1));
+			size_t thr = 0;
+			size_t dgr = 0;
+
+			if ((thrStm >> thr) && (dgrStm >> dgr))
+			{
+				tmpT[line.substr(0, KEYPOS)] = CalibrationEntry(thr, dgr);
+			}
+		}
+
+		m_calibrationTable = tmpT;
+		ret = true;
+	}
+
+	return ret;
+}
+
+NAMESPACE_COMMONEND
@@ -0,0 +1,140 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_PARALLELCALIBRATION_H
+#define CEX_PARALLELCALIBRATION_H
+
+#include "CexDomain.h"
+#include <map>
+#include <mutex>
+
+NAMESPACE_COMMON
+
+/// <summary>
+/// A process-wide table of measured parallel thresholds.
+/// <para>Each entry maps a primitive name, as returned by its Name() property before a key is set, to the smallest input size at which multi-threaded processing
+/// was measured to be faster than sequential processing, and the thread count with the highest throughput.
+/// The ParallelOptions class of a calibrated primitive applies these values in place of the cache-size estimate.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Storing and saving a measured threshold:</description>
+/// <code>
+/// ParallelCalibration::Store("CTR-AHX", 65536, 4);
+/// ParallelCalibration::Save(ParallelCalibration::DEF_PROFILE);
+/// </code>
+///
+/// <description>Applying a saved profile when the application starts:</description>
+/// <code>
+/// ParallelCalibration::Load("/etc/myapp/cex-parallel.cfg");
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <para>The table starts empty, and the library never reads a profile on its own; an application applies a profile by calling Load with its full path,
+/// before constructing the primitives that use it. Until then, every primitive keeps its default parallel profile.</para>
+/// <para>The profile is a text file with one entry per line, in the form name=threshold,degree; lines starting with # are comments.
+/// A threshold of zero records that parallel processing was slower at every measured size, and disables it for that primitive.
+/// The thresholds are written by the calibrate command of the test project.</para>
+/// </remarks>
+class ParallelCalibration
+{
+private:
+
+	struct CalibrationEntry
+	{
+		size_t MaxDegree;
+		size_t Threshold;
+
+		CalibrationEntry()
+			:
+			MaxDegree(0),
+			Threshold(0)
+		{
+		}
+
+		CalibrationEntry(size_t EntryThreshold, size_t EntryDegree)
+			:
+			MaxDegree(EntryDegree),
+			Threshold(EntryThreshold)
+		{
+		}
+	};
+
+	static std::map<std::string, CalibrationEntry> m_calibrationTable;
+	static std::mutex m_tableLock;
+
+public:
+
+	/// <summary>
+	/// The default calibration profile name, written by the calibrate command of the test project; it is only read when passed to Load
+	/// </summary>
+	static const std::string DEF_PROFILE;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Remove all entries
+	/// </summary>
+	static void Clear();
+
+	/// <summary>
+	/// Get the measured values for a primitive
+	/// </summary>
+	///
+	/// <param name="Name">The primitive name, before the primitive is keyed</param>
+	/// <param name="Threshold">Receives the smallest input size in bytes that is processed in parallel; zero if parallel processing is disabled</param>
+	/// <param name="MaxDegree">Receives the measured thread count</param>
+	///
+	/// <returns>Returns true if the table holds an entry for the primitive</returns>
+	static bool Find(const std::string &Name, size_t &Threshold, size_t &MaxDegree);
+
+	/// <summary>
+	/// Replace the table with the entries in a calibration profile
+	/// </summary>
+	///
+	/// <param name="Path">The full path to the profile</param>
+	///
+	/// <returns>Returns false if the profile could not be opened; the table is left unchanged</returns>
+	static bool Load(const std::string &Path);
+
+	/// <summary>
+	/// Write the table to a calibration profile
+	/// </summary>
+	///
+	/// <param name="Path">The full path to the profile; an existing file is replaced</param>
+	///
+	/// <returns>Returns false if the profile could not be written</returns>
+	static bool Save(const std::string &Path);
+
+	/// <summary>
+	/// Add or replace the entry for a primitive
+	/// </summary>
+	///
+	/// <param name="Name">The primitive name</param>
+	/// <param name="Threshold">The smallest input size in bytes that is processed in parallel; zero disables parallel processing</param>
+	/// <param name="MaxDegree">The thread count; zero keeps the default degree</param>
+	static void Store(const std::string &Name, size_t Threshold, size_t MaxDegree);
+
+private:
+
+	static bool Read(const std::string &Path);
+};
+
+NAMESPACE_COMMONEND
+#endif
@@ -0,0 +1,430 @@
+#include "ParallelHash.h"
+#include "Instrumentation.h"
+#include "IntUtils.h"
+#include "Keccak.h"
+#include "MemUtils.h"
+#include "ParallelUtils.h"
+
+NAMESPACE_DIGEST
+
+using Utility::IntUtils;
+using Utility::MemUtils;
+
+const std::string ParallelHash::CLASS_NAME("ParallelHash");
+
+//~~~Constructor~~~//
+
+ParallelHash::ParallelHash(ShakeModes ShakeMode, bool Parallel, size_t LeafSize)
+	:
+	m_blockSize((ShakeMode == ShakeModes::SHAKE128) ? 168 : 136),
+	m_custom(0),
+	m_digestSize((ShakeMode == ShakeModes::SHAKE128) ? 32 : 64),
+	m_finalState(),
+	m_isDestroyed(false),
+	m_leafCount(0),
+	m_leafLength(0),
+	m_leafSize(LeafSize != 0 ? LeafSize :
+		throw CryptoDigestException("ParallelHash:Ctor", "The leaf size can not be zero!")),
+	m_leafState(),
+	m_parallelProfile(m_leafSize, false, STATE_PRECACHED, false, DEF_PRLDEGREE),
+	m_shakeMode((ShakeMode == ShakeModes::SHAKE128 || ShakeMode == ShakeModes::SHAKE256) ? ShakeMode :
+		throw CryptoDigestException("ParallelHash:Ctor", "The SHAKE mode must be SHAKE128 or SHAKE256!"))
+{
+	// the tree is the same in either mode, parallel only enables threading of large inputs
+	m_parallelProfile.IsParallel() = Parallel && m_parallelProfile.ProcessorCount() > 1;
+	Reset();
+}
+
+ParallelHash::~ParallelHash()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_finalState.Reset();
+		m_leafState.Reset();
+		IntUtils::ClearVector(m_custom);
+		m_blockSize = 0;
+		m_digestSize = 0;
+		m_leafCount = 0;
+		m_leafLength = 0;
+		m_leafSize = 0;
+		m_shakeMode = ShakeModes::None;
+		m_parallelProfile.Reset();
+	}
+}
+
+//~~~Accessors~~~//
+
+size_t ParallelHash::BlockSize()
+{
+	return m_blockSize;
+}
+
+size_t ParallelHash::DigestSize()
+{
+	return m_digestSize;
+}
+
+const Digests ParallelHash::Enumeral()
+{
+	return (m_shakeMode == ShakeModes::SHAKE128) ? Digests::ParallelHash128 : Digests::ParallelHash256;
+}
+
+const bool ParallelHash::IsParallel()
+{
+	return m_parallelProfile.IsParallel();
+}
+
+const size_t ParallelHash::LeafSize()
+{
+	return m_leafSize;
+}
+
+const std::string ParallelHash::Name()
+{
+	std::string txtName = CLASS_NAME + ((m_shakeMode == ShakeModes::SHAKE128) ? "128" : "256");
+
+	if (m_parallelProfile.IsParallel())
+	{
+		txtName += "-P" + IntUtils::ToString(m_parallelProfile.ParallelMaxDegree());
+	}
+
+	return txtName;
+}
+
+const size_t ParallelHash::ParallelBlockSize()
+{
+	return m_parallelProfile.ParallelBlockSize();
+}
+
+ParallelOptions &ParallelHash::ParallelProfile()
+{
+	return m_parallelProfile;
+}
+
+const ShakeModes ParallelHash::ShakeMode()
+{
+	return m_shakeMode;
+}
+
+//~~~Public Functions~~~//
+
+void ParallelHash::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	Update(Input, 0, Input.size());
+	Finalize(Output, 0);
+}
+
+size_t ParallelHash::Finalize(std::vector<byte> &Output, const size_t OutOffset)
+{
+	return Finalize(Output, OutOffset, m_digestSize);
+}
+
+size_t ParallelHash::Finalize(std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+{
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, 0);
+
+	if (Output.size() - OutOffset < Length)
+	{
+		throw CryptoDigestException("ParallelHash:Finalize", "The Output buffer is too short!");
+	}
+
+	std::vector<byte> enc(2 * (sizeof(ulong) + 1));
+	size_t encLen;
+
+	if (m_leafLength != 0)
+	{
+		FinishLeaf();
+	}
+
+	// right_encode(n) || right_encode(L)
+	encLen = Keccak::RightEncode(enc, 0, m_leafCount);
+	encLen += Keccak::RightEncode(enc, encLen, static_cast<ulong>(Length) * 8);
+	Absorb(enc, 0, encLen, m_finalState);
+	AbsorbPad(ROOT_DOMAIN, m_finalState);
+	Squeeze(m_finalState, Output, OutOffset, Length);
+	Reset();
+
+	return Length;
+}
+
+void ParallelHash::Initialize(const std::vector<byte> &Customization)
+{
+	m_custom = Customization;
+	Reset();
+}
+
+void ParallelHash::ParallelMaxDegree(size_t Degree)
+{
+	CexAssert(Degree != 0, "parallel degree can not be zero");
+	CexAssert(Degree % 2 == 0, "parallel degree must be an even number");
+	CexAssert(Degree <= m_parallelProfile.ProcessorCount(), "parallel degree can not exceed processor count");
+
+	m_parallelProfile.SetMaxDegree(Degree);
+}
+
+void ParallelHash::Reset()
+{
+	const std::string FNCNME = "ParallelHash";
+	std::vector<byte> name(FNCNME.begin(), FNCNME.end());
+	std::vector<byte> pad(0);
+	std::vector<byte> enc(sizeof(ulong) + 1);
+
+	m_finalState.Reset();
+	m_leafState.Reset();
+	m_leafCount = 0;
+	m_leafLength = 0;
+
+	// the cSHAKE prefix, followed by left_encode(B)
+	Keccak::EncodeString(name, pad);
+	Keccak::EncodeString(m_custom, pad);
+	Keccak::BytePad(pad, m_blockSize, m_finalState.H, false);
+	Absorb(enc, 0, Keccak::LeftEncode(enc, 0, m_leafSize), m_finalState);
+}
+
+void ParallelHash::Update(byte Input)
+{
+	std::vector<byte> inp(1, Input);
+	Update(inp, 0, 1);
+}
+
+void ParallelHash::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, Length);
+
+	CexAssert(Input.size() - InOffset >= Length, "The Output buffer is too short!");
+
+	while (Length != 0)
+	{
+		if (m_leafLength == 0 && Length >= m_leafSize)
+		{
+			// whole leaves are hashed from the input, and their outputs are absorbed in order
+			const size_t LEFCNT = Length / m_leafSize;
+			std::vector<byte> cvs(LEFCNT * m_digestSize);
+
+			HashLeaves(Input, InOffset, LEFCNT, cvs, 0);
+			Absorb(cvs, 0, cvs.size(), m_finalState);
+			m_leafCount += LEFCNT;
+			InOffset += LEFCNT * m_leafSize;
+			Length -= LEFCNT * m_leafSize;
+		}
+		else
+		{
+			const size_t RMDSZE = IntUtils::Min(m_leafSize - m_leafLength, Length);
+			Absorb(Input, InOffset, RMDSZE, m_leafState);
+			m_leafLength += RMDSZE;
+			InOffset += RMDSZE;
+			Length -= RMDSZE;
+
+			if (m_leafLength == m_leafSize)
+			{
+				FinishLeaf();
+			}
+		}
+	}
+}
+
+//~~~Private Functions~~~//
+
+void ParallelHash::Absorb(const std::vector<byte> &Input, size_t InOffset, size_t Length, SpongeState &State)
+{
+	while (Length != 0)
+	{
+		if (State.Position == 0 && Length >= m_blockSize)
+		{
+			// whole blocks are added a lane at a time
+			for (size_t i = 0; i < m_blockSize / sizeof(ulong); ++i)
+			{
+				State.H[i] ^= IntUtils::LeBytesTo64(Input, InOffset + (i * sizeof(ulong)));
+			}
+
+			Keccak::PermuteR24P1600(State.H);
+			InOffset += m_blockSize;
+			Length -= m_blockSize;
+		}
+		else
+		{
+			const size_t RMDSZE = IntUtils::Min(m_blockSize - State.Position, Length);
+
+			for (size_t i = 0; i < RMDSZE; ++i)
+			{
+				const size_t STAPOS = State.Position + i;
+				State.H[STAPOS / sizeof(ulong)] ^= static_cast<ulong>(Input[InOffset + i]) << (8 * (STAPOS % sizeof(ulong)));
+			}
+
+			State.Position += RMDSZE;
+			InOffset += RMDSZE;
+			Length -= RMDSZE;
+
+			if (State.Position == m_blockSize)
+			{
+				Keccak::PermuteR24P1600(State.H);
+				State.Position = 0;
+			}
+		}
+	}
+}
+
+void ParallelHash::AbsorbPad(byte Domain, SpongeState &State)
+{
+	State.H[State.Position / sizeof(ulong)] ^= static_cast<ulong>(Domain) << (8 * (State.Position % sizeof(ulong)));
+	State.H[(m_blockSize / sizeof(ulong)) - 1] ^= 0x8000000000000000ULL;
+	Keccak::PermuteR24P1600(State.H);
+	State.Position = 0;
+}
+
+void ParallelHash::FinishLeaf()
+{
+	// the leaf output is twice the security strength, the same size as the default digest output
+	std::vector<byte> cv(m_digestSize);
+
+	AbsorbPad(LEAF_DOMAIN, m_leafState);
+	Squeeze(m_leafState, cv, 0, cv.size());
+	Absorb(cv, 0, cv.size(), m_finalState);
+	m_leafState.Reset();
+	m_leafLength = 0;
+	++m_leafCount;
+}
+
+void ParallelHash::HashLeaves(const std::vector<byte> &Input, size_t InOffset, size_t LeafCount, std::vector<byte> &Output, size_t OutOffset)
+{
+	const size_t PRLDGR = m_parallelProfile.ParallelMaxDegree();
+
+	if (m_parallelProfile.IsParallel() && LeafCount * m_leafSize >= m_parallelProfile.ParallelMinimumSize() && LeafCount >= PRLDGR)
+	{
+		CEX_INSTRUMENT_PARALLEL();
+
+		// each thread hashes a contiguous range of leaves
+		const size_t LEFCNT = LeafCount / PRLDGR;
+
+		Utility::ParallelUtils::ParallelFor(0, PRLDGR, [this, &Input, InOffset, LeafCount, &Output, OutOffset, LEFCNT, PRLDGR](size_t i)
+		{
+			const size_t THDCNT = (i == PRLDGR - 1) ? LeafCount - (i * LEFCNT) : LEFCNT;
+			HashMany(Input, InOffset + (i * LEFCNT * m_leafSize), THDCNT, Output, OutOffset + (i * LEFCNT * m_digestSize));
+		});
+	}
+	else
+	{
+		HashMany(Input, InOffset, LeafCount, Output, OutOffset);
+	}
+}
+
+void ParallelHash::HashMany(const std::vector<byte> &Input, size_t InOffset, size_t LeafCount, std::vector<byte> &Output, size_t OutOffset)
+{
+#if defined(__AVX2__)
+#	if defined(__AVX512__)
+	const size_t LNECNT = 8;
+#	else
+	const size_t LNECNT = 4;
+#	endif
+
+	if (LeafCount >= LNECNT)
+	{
+		const size_t BLKCNT = m_leafSize / m_blockSize;
+		const size_t FNLSZE = m_leafSize - (BLKCNT * m_blockSize);
+		std::vector<std::array<ulong, STATE_SIZE>> wst(LNECNT);
+
+		// each lane of the wide permutation absorbs one leaf
+		while (LeafCount >= LNECNT)
+		{
+			for (size_t i = 0; i < LNECNT; ++i)
+			{
+				std::memset(&wst[i][0], 0, STATE_SIZE * sizeof(ulong));
+			}
+
+			for (size_t i = 0; i < BLKCNT; ++i)
+			{
+				for (size_t j = 0; j < LNECNT; ++j)
+				{
+					const size_t BLKOFT = InOffset + (j * m_leafSize) + (i * m_blockSize);
+
+					for (size_t k = 0; k < m_blockSize / sizeof(ulong); ++k)
+					{
+						wst[j][k] ^= IntUtils::LeBytesTo64(Input, BLKOFT + (k * sizeof(ulong)));
+					}
+				}
+
+				PermuteW(wst);
+			}
+
+			// the last partial block of each leaf, and the SHAKE padding
+			for (size_t j = 0; j < LNECNT; ++j)
+			{
+				const size_t BLKOFT = InOffset + (j * m_leafSize) + (BLKCNT * m_blockSize);
+
+				for (size_t k = 0; k < FNLSZE; ++k)
+				{
+					wst[j][k / sizeof(ulong)] ^= static_cast<ulong>(Input[BLKOFT + k]) << (8 * (k % sizeof(ulong)));
+				}
+
+				wst[j][FNLSZE / sizeof(ulong)] ^= static_cast<ulong>(LEAF_DOMAIN) << (8 * (FNLSZE % sizeof(ulong)));
+				wst[j][(m_blockSize / sizeof(ulong)) - 1] ^= 0x8000000000000000ULL;
+			}
+
+			PermuteW(wst);
+
+			for (size_t j = 0; j < LNECNT; ++j)
+			{
+				for (size_t k = 0; k < m_digestSize / sizeof(ulong); ++k)
+				{
+					IntUtils::Le64ToBytes(wst[j][k], Output, OutOffset + (j * m_digestSize) + (k * sizeof(ulong)));
+				}
+			}
+
+			InOffset += LNECNT * m_leafSize;
+			OutOffset += LNECNT * m_digestSize;
+			LeafCount -= LNECNT;
+		}
+	}
+#endif
+
+	SpongeState state;
+
+	while (LeafCount != 0)
+	{
+		state.Reset();
+		Absorb(Input, InOffset, m_leafSize, state);
+		AbsorbPad(LEAF_DOMAIN, state);
+		Squeeze(state, Output, OutOffset, m_digestSize);
+		InOffset += m_leafSize;
+		OutOffset += m_digestSize;
+		--LeafCount;
+	}
+}
+
+#if defined(__AVX2__)
+void ParallelHash::PermuteW(std::vector<std::array<ulong, STATE_SIZE>> &State)
+{
+#	if defined(__AVX512__)
+	Keccak::PermuteR24P12800(State);
+#	else
+	Keccak::PermuteR24P6400(State);
+#	endif
+}
+#endif
+
+void ParallelHash::Squeeze(SpongeState &State, std::vector<byte> &Output, size_t OutOffset, size_t Length)
+{
+	while (Length != 0)
+	{
+		if (State.Position == m_blockSize)
+		{
+			Keccak::PermuteR24P1600(State.H);
+			State.Position = 0;
+		}
+
+		const size_t RMDSZE = IntUtils::Min(m_blockSize - State.Position, Length);
+
+		for (size_t i = 0; i < RMDSZE; ++i)
+		{
+			const size_t STAPOS = State.Position + i;
+			Output[OutOffset + i] = static_cast<byte>(State.H[STAPOS / sizeof(ulong)] >> (8 * (STAPOS % sizeof(ulong))));
+		}
+
+		State.Position += RMDSZE;
+		OutOffset += RMDSZE;
+		Length -= RMDSZE;
+	}
+}
+
+NAMESPACE_DIGESTEND
@@ -0,0 +1,283 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// An implementation of the SP800-185 ParallelHash function, using the cSHAKE128 and cSHAKE256 functions.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_PARALLELHASH_H
+#define CEX_PARALLELHASH_H
+
+#include "IDigest.h"
+#include "ShakeModes.h"
+
+NAMESPACE_DIGEST
+
+using Enumeration::ShakeModes;
+
+/// <summary>
+/// An implementation of the SP800-185 ParallelHash128 and ParallelHash256 functions
+/// </summary>
+///
+/// <example>
+/// <description>Example using the Compute method:</description>
+/// <code>
+/// ParallelHash dgt(ShakeModes::SHAKE128);
+/// std:vector&lt;byte&gt; hash(dgt.DigestSize(), 0);
+/// // compute a hash
+/// dgt.Compute(input, hash);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The message is split into leaves of LeafSize() bytes, (8192 by default); each leaf is hashed with SHAKE, and the leaf outputs are absorbed by a cSHAKE function with the function name "ParallelHash".</description></item>
+/// <item><description>The ShakeModes::SHAKE128 mode is ParallelHash128, with a 32 byte default output; the ShakeModes::SHAKE256 mode is ParallelHash256, with a 64 byte default output.</description></item>
+/// <item><description>Whole leaves are hashed 4 or 8 at a time in the lanes of the wide Keccak permutations, when the library is compiled with AVX2 or AVX512.</description></item>
+/// <item><description>In parallel mode, an input passed to the Update function that is at least ParallelMinimumSize() bytes is split across ParallelMaxDegree() threads.</description></item>
+/// <item><description>The output depends on the leaf size, but not on the parallel settings; sequential and parallel instances produce the same digest.</description></item>
+/// <item><description>The requested output length is part of the hash; the Finalize(std::vector&lt;byte&gt;, size_t, size_t) overload does not return a prefix of a longer output.</description></item>
+/// <item><description>The Finalize methods reset the message state, but keep the customization string set by Initialize.</description></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>Fips-202: The <a href="http://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf">SHA-3 Standard</a></description>.</item>
+/// <item><description>SP800-185: <a href="http://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-185.pdf">SHA-3 Derived Functions</a></description></item>
+/// </list>
+/// </remarks>
+class ParallelHash final : public IDigest
+{
+private:
+
+	static const std::string CLASS_NAME;
+	static const size_t DEF_LEAFSIZE = 8192;
+	static const size_t DEF_PRLDEGREE = 8;
+	static const byte LEAF_DOMAIN = 0x1F;
+	static const byte ROOT_DOMAIN = 0x04;
+	// size of reserved state buffer subtracted from parallel size calculations
+	static const size_t STATE_PRECACHED = 2048;
+	static const size_t STATE_SIZE = 25;
+
+	struct SpongeState
+	{
+		std::array<ulong, STATE_SIZE> H;
+		size_t Position;
+
+		SpongeState()
+			:
+			Position(0)
+		{
+			Reset();
+		}
+
+		void Reset()
+		{
+			std::memset(&H[0], 0, H.size() * sizeof(ulong));
+			Position = 0;
+		}
+	};
+
+	size_t m_blockSize;
+	std::vector<byte> m_custom;
+	size_t m_digestSize;
+	SpongeState m_finalState;
+	bool m_isDestroyed;
+	ulong m_leafCount;
+	size_t m_leafLength;
+	size_t m_leafSize;
+	SpongeState m_leafState;
+	ParallelOptions m_parallelProfile;
+	ShakeModes m_shakeMode;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	ParallelHash(const ParallelHash&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	ParallelHash& operator=(const ParallelHash&) = delete;
+
+	/// <summary>
+	/// Initialize the digest
+	/// </summary>
+	///
+	/// <param name="ShakeMode">The underlying SHAKE function; SHAKE128 for ParallelHash128, or SHAKE256 for ParallelHash256</param>
+	/// <param name="Parallel">Setting the Parallel flag to true, enables multi-threaded leaf hashing; the digest output is the same in either mode.</param>
+	/// <param name="LeafSize">The leaf size in bytes, the B parameter of ParallelHash; the default is 8192 bytes</param>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the SHAKE mode is not SHAKE128 or SHAKE256, or the leaf size is zero</exception>
+	explicit ParallelHash(ShakeModes ShakeMode = ShakeModes::SHAKE128, bool Parallel = false, size_t LeafSize = DEF_LEAFSIZE);
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~ParallelHash() override;
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The Digests internal blocksize in bytes
+	/// </summary>
+	size_t BlockSize() override;
+
+	/// <summary>
+	/// Read Only: Size of returned digest in bytes
+	/// </summary>
+	size_t DigestSize() override;
+
+	/// <summary>
+	/// Read Only: The digests type name
+	/// </summary>
+	const Digests Enumeral() override;
+
+	/// <summary>
+	/// Read Only: Processor parallelization availability.
+	/// <para>Indicates whether parallel processing is available on this system.
+	/// If parallel capable, input data array passed to the Update function must be ParallelMinimumSize in bytes to trigger parallelization.</para>
+	/// </summary>
+	const bool IsParallel() override;
+
+	/// <summary>
+	/// Read Only: The leaf size in bytes, the B parameter of ParallelHash
+	/// </summary>
+	const size_t LeafSize();
+
+	/// <summary>
+	/// Read Only: The digests class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Read Only: Parallel block size; the byte-size of the input data array passed to the Update function that triggers parallel processing.
+	/// <para>This value can be changed through the ParallelProfile class.</para>
+	/// </summary>
+	const size_t ParallelBlockSize() override;
+
+	/// <summary>
+	/// Read/Write: Contains parallel settings and SIMD capability flags in a ParallelOptions structure.
+	/// <para>The maximum number of threads allocated when using multi-threaded processing can be set with the ParallelMaxDegree(size_t) function.</para>
+	/// </summary>
+	ParallelOptions &ParallelProfile() override;
+
+	/// <summary>
+	/// Read Only: The underlying SHAKE function
+	/// </summary>
+	const ShakeModes ShakeMode();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Process the message data and return the Hash value
+	/// </summary>
+	///
+	/// <param name="Input">The message input data</param>
+	/// <param name="Output">The hash value output array</param>
+	void Compute(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Perform final processing and return the default size hash value
+	/// </summary>
+	///
+	/// <param name="Output">The Hash output value array</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	///
+	/// <returns>Size of Hash value</returns>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the output buffer is too short</exception>
+	size_t Finalize(std::vector<byte> &Output, const size_t OutOffset) override;
+
+	/// <summary>
+	/// Perform final processing and return a hash value of any length
+	/// </summary>
+	///
+	/// <param name="Output">The output array</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	/// <param name="Length">The number of bytes to write</param>
+	///
+	/// <returns>The number of bytes written</returns>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the output buffer is too short</exception>
+	size_t Finalize(std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
+
+	/// <summary>
+	/// Set the customization string, the S parameter of ParallelHash.
+	/// <para>Different customization strings produce independent hash functions; an empty string restores the default function.</para>
+	/// </summary>
+	///
+	/// <param name="Customization">The customization string</param>
+	void Initialize(const std::vector<byte> &Customization);
+
+	/// <summary>
+	/// Set the number of threads allocated when using multi-threaded leaf hashing.
+	/// <para>Thread count must be an even number, and not exceed the number of processor cores.
+	/// The thread count does not change the digest output.</para>
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	void ParallelMaxDegree(size_t Degree) override;
+
+	/// <summary>
+	/// Reset the message state; the customization string is retained
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Update the message digest with a single byte
+	/// </summary>
+	///
+	/// <param name="Input">Input message byte</param>
+	void Update(byte Input) override;
+
+	/// <summary>
+	/// Update the message buffer
+	/// </summary>
+	///
+	/// <remarks>
+	/// <para>For best performance, use input lengths that are a multiple of the leaf size;
+	/// whole leaves are hashed in SIMD lanes directly from the input array.</para>
+	/// </remarks>
+	///
+	/// <param name="Input">The Input message data</param>
+	/// <param name="InOffset">The starting offset within the Input array</param>
+	/// <param name="Length">The amount of data to process in bytes</param>
+	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
+
+private:
+
+	void Absorb(const std::vector<byte> &Input, size_t InOffset, size_t Length, SpongeState &State);
+	void AbsorbPad(byte Domain, SpongeState &State);
+	void FinishLeaf();
+	void HashLeaves(const std::vector<byte> &Input, size_t InOffset, size_t LeafCount, std::vector<byte> &Output, size_t OutOffset);
+	void HashMany(const std::vector<byte> &Input, size_t InOffset, size_t LeafCount, std::vector<byte> &Output, size_t OutOffset);
+#if defined(__AVX2__)
+	static void PermuteW(std::vector<std::array<ulong, STATE_SIZE>> &State);
+#endif
+	void Squeeze(SpongeState &State, std::vector<byte> &Output, size_t OutOffset, size_t Length);
+};
+
+NAMESPACE_DIGESTEND
+#endif
@@ -1,6 +1,7 @@
 #include "ParallelOptions.h"
 #include "CpuDetect.h"
 #include "CryptoProcessingException.h"
+#include "ParallelCalibration.h"
 
 NAMESPACE_COMMON
 
@@ -242,6 +243,39 @@ void ParallelOptions::Calculate(bool Parallel, size_t ParallelBlockSize, size_t
 	Calculate();
 }
 
+bool ParallelOptions::Calibrate(const std::string &Name)
+{
+	size_t prlDgr = 0;
+	size_t prlThr = 0;
+	bool ret = false;
+
+	if (m_processorCount > 1 && ParallelCalibration::Find(Name, prlThr, prlDgr))
+	{
+		// a measured degree is only used if this system has the cores to run it
+		if (prlDgr != 0 && prlDgr % 2 == 0 && prlDgr <= m_processorCount)
+		{
+			m_parallelMaxDegree = prlDgr;
+		}
+
+		if (prlThr == 0)
+		{
+			// parallel processing was slower at every measured size
+			m_isParallel = false;
+		}
+		else
+		{
+			m_isParallel = true;
+			m_parallelBlockSize = (prlThr > MAX_PRLALLOC) ? MAX_PRLALLOC : prlThr;
+		}
+
+		Calculate();
+		StoreDefaults();
+		ret = true;
+	}
+
+	return ret;
+}
+
 void ParallelOptions::Reset()
 {
 	m_autoInit = false;
@@ -13,6 +13,8 @@ using Enumeration::SimdProfiles;
 /// <summary>
 /// The ParallelOptions class.
 /// <para>Contains system available intrinsics options, and parallel processing information.</para>
+/// <para>The default ParallelBlockSize is estimated from the L1 data cache size; primitives that call Calibrate(std::string) with their name
+/// use the threshold and thread count measured for them instead, when the ParallelCalibration table holds an entry; the table is filled by the application, through ParallelCalibration::Load or Store.</para>
 /// </summary>
 /// 
 /// <example>
@@ -244,6 +246,17 @@ public:
 	/// <para>This must be an even positive number no greater than the number of processor cores.</para></param>
 	void Calculate(bool Parallel, size_t ParallelBlockSize, size_t MaxDegree);
 
+	/// <summary>
+	/// Apply the measured parallel threshold and thread count of a primitive, if the ParallelCalibration table holds an entry for it.
+	/// <para>The threshold replaces the cache-size estimate of ParallelBlockSize, aligned to ParallelMinimumSize; 
+	/// a threshold of zero disables parallel processing. The calibrated values become the defaults reported by IsDefault().</para>
+	/// </summary>
+	/// 
+	/// <param name="Name">The primitive name, as returned by its Name() property before it is keyed</param>
+	///
+	/// <returns>Returns true if a calibrated entry was applied</returns>
+	bool Calibrate(const std::string &Name);
+
 	/// <summary>
 	/// Reset all internal data to defaults
 	/// </summary>
@@ -1,6 +1,8 @@
 #include "Poly1305.h"
 #include "BlockCipherFromName.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_MAC
 
@@ -14,7 +16,9 @@ Poly1305::Poly1305(BlockCiphers CipherType)
 	:
 	m_autoClamp(true),
 	m_blockCipher(CipherType != BlockCiphers::None ? Helper::BlockCipherFromName::GetInstance(CipherType) : nullptr),
+	m_cprKey(BLOCK_SIZE),
 	m_destroyEngine(true),
+	m_isCipherKeyed(false),
 	m_isDestroyed(false),
 	m_isInitialized(false),
 	m_legalKeySizes{ SymmetricKeySize(KEY_SIZE, 0, 0), SymmetricKeySize(KEY_SIZE, BLOCK_SIZE, 0) },
@@ -33,7 +37,9 @@ Poly1305::Poly1305(IBlockCipher* Cipher)
 	m_autoClamp(true),
 	m_blockCipher(Cipher != nullptr ? Cipher : 
 		throw CryptoMacException("Poly1305:Ctor", "The block cipher instance can not be null!")),
+	m_cprKey(BLOCK_SIZE),
 	m_destroyEngine(false),
+	m_isCipherKeyed(false),
 	m_isDestroyed(false),
 	m_isInitialized(false),
 	m_legalKeySizes{ SymmetricKeySize(KEY_SIZE, 0, 0), SymmetricKeySize(KEY_SIZE, BLOCK_SIZE, 0) },
@@ -52,9 +58,11 @@ Poly1305::~Poly1305()
 	if (!m_isDestroyed)
 	{
 		m_isDestroyed = true;
+		m_isCipherKeyed = false;
 		m_isInitialized = false;
 		m_msgLength = 0;
 		m_macState.Reset();
+		Utility::IntUtils::ClearVector(m_cprKey);
 		Utility::IntUtils::ClearVector(m_legalKeySizes);
 		Utility::IntUtils::ClearVector(m_msgBuffer);
 
@@ -145,6 +153,8 @@ void Poly1305::Compute(const std::vector<byte> &Input, std::vector<byte> &Output
 
 size_t Poly1305::Finalize(std::vector<byte> &Output, size_t OutOffset)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Mac, CLASS_NAME, 0);
+
 	CexAssert(m_isInitialized, "The Mac is not initialized");
 	CexAssert((Output.size() - OutOffset) >= BLOCK_SIZE, "The Output buffer is too short");
 
@@ -210,11 +220,13 @@ size_t Poly1305::Finalize(std::vector<byte> &Output, size_t OutOffset)
 
 void Poly1305::Initialize(ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(m_legalKeySizes, KeyParams.Key().size(), KeyParams.Nonce().size(), 0))
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (!SymmetricKeySize::Contains(m_legalKeySizes, kv.Key().size(), kv.Nonce().size(), 0))
 	{
 		throw CryptoMacException("Poly1305:Initialize", "Key size is invalid; must be a legal key size!");
 	}
-	if (!m_autoClamp && m_blockCipher != nullptr && KeyParams.Nonce().size() == BLOCK_SIZE && !IsClamped(KeyParams.Key()))
+	if (!m_autoClamp && m_blockCipher != nullptr && kv.Nonce().size() == BLOCK_SIZE && !IsClamped(kv.Key()))
 	{
 		throw CryptoMacException("Poly1305:Initialize", "The key is invalid; must be clamped before initialized!");
 	}
@@ -224,20 +236,12 @@ void Poly1305::Initialize(ISymmetricKey &KeyParams)
 		Reset();
 	}
 
-	std::vector<byte> tmpR(BLOCK_SIZE);
-	std::memcpy(&tmpR[0], &KeyParams.Key()[0], BLOCK_SIZE);
-
-	// with the Poly1305-AES version, if the input key has not been pre-conditioned nd autoclamp is set, 
-	// clamp the R portion of the key automatically rather than throw an exception
-	if (m_autoClamp && m_blockCipher != nullptr && KeyParams.Nonce().size() == BLOCK_SIZE && !IsClamped(tmpR))
-	{
-		Clamp(tmpR);
-	}
-
-	uint t0 = IntUtils::LeBytesTo32(tmpR, 0);
-	uint t1 = IntUtils::LeBytesTo32(tmpR, 4);
-	uint t2 = IntUtils::LeBytesTo32(tmpR, 8);
-	uint t3 = IntUtils::LeBytesTo32(tmpR, 12);
+	// the R portion is read directly from the key; the limb masks below clamp it, so with the Poly1305-AES version
+	// a key that has not been pre-conditioned is clamped automatically when autoclamp is set, rather than throw an exception
+	uint t0 = IntUtils::LeBytesTo32(kv.Key(), 0);
+	uint t1 = IntUtils::LeBytesTo32(kv.Key(), 4);
+	uint t2 = IntUtils::LeBytesTo32(kv.Key(), 8);
+	uint t3 = IntUtils::LeBytesTo32(kv.Key(), 12);
 
 	// clamping
 	m_macState.R[0] = t0 & 0x03FFFFFFUL;
@@ -252,30 +256,35 @@ void Poly1305::Initialize(ISymmetricKey &KeyParams)
 	m_macState.S[2] = m_macState.R[3] * 5;
 	m_macState.S[3] = m_macState.R[4] * 5;
 
-	std::vector<byte> tmpK(0);
-	size_t kOff;
-
-	if (m_blockCipher != nullptr && KeyParams.Nonce().size() == BLOCK_SIZE)
+	if (m_blockCipher != nullptr && kv.Nonce().size() == BLOCK_SIZE)
 	{
-		// use encrypted nonce
-		tmpK.resize(BLOCK_SIZE);
-		kOff = 0;
-		std::vector<byte> cprK(BLOCK_SIZE);
-		std::memcpy(&cprK[0], &KeyParams.Key()[BLOCK_SIZE], BLOCK_SIZE);
-		m_blockCipher->Initialize(true, Key::Symmetric::SymmetricKey(cprK));
-		m_blockCipher->EncryptBlock(KeyParams.Nonce(), 0, tmpK, 0);
+		// use encrypted nonce; an owned cipher keeps its schedule, and is only re-keyed when the cipher key changes,
+		// a cipher passed to the constructor may have been keyed by the caller, and is always re-keyed
+		if (!m_isCipherKeyed || !m_destroyEngine || !Utility::MemUtils::Compare(m_cprKey, 0, kv.Key(), BLOCK_SIZE, BLOCK_SIZE))
+		{
+			std::memcpy(&m_cprKey[0], &kv.Key()[BLOCK_SIZE], BLOCK_SIZE);
+			m_blockCipher->Initialize(true, Key::Symmetric::SymmetricKey(m_cprKey));
+			m_isCipherKeyed = true;
+		}
+
+		// the cleared message buffer holds the encrypted nonce
+		m_blockCipher->EncryptBlock(kv.Nonce(), 0, m_msgBuffer, 0);
+
+		m_macState.K[0] = IntUtils::LeBytesTo32(m_msgBuffer, 0);
+		m_macState.K[1] = IntUtils::LeBytesTo32(m_msgBuffer, 4);
+		m_macState.K[2] = IntUtils::LeBytesTo32(m_msgBuffer, 8);
+		m_macState.K[3] = IntUtils::LeBytesTo32(m_msgBuffer, 12);
+		Utility::MemUtils::Clear(m_msgBuffer, 0, BLOCK_SIZE);
 	}
 	else
 	{
-		tmpK = KeyParams.Key();
-		kOff = BLOCK_SIZE;
+		// the one-time key is read in place, keying a message does not allocate
+		m_macState.K[0] = IntUtils::LeBytesTo32(kv.Key(), BLOCK_SIZE);
+		m_macState.K[1] = IntUtils::LeBytesTo32(kv.Key(), BLOCK_SIZE + 4);
+		m_macState.K[2] = IntUtils::LeBytesTo32(kv.Key(), BLOCK_SIZE + 8);
+		m_macState.K[3] = IntUtils::LeBytesTo32(kv.Key(), BLOCK_SIZE + 12);
 	}
 
-	m_macState.K[0] = IntUtils::LeBytesTo32(tmpK, kOff + 0);
-	m_macState.K[1] = IntUtils::LeBytesTo32(tmpK, kOff + 4);
-	m_macState.K[2] = IntUtils::LeBytesTo32(tmpK, kOff + 8);
-	m_macState.K[3] = IntUtils::LeBytesTo32(tmpK, kOff + 12);
-
 	m_isInitialized = true;
 }
 
@@ -312,6 +321,8 @@ void Poly1305::Update(byte Input)
 
 void Poly1305::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Mac, CLASS_NAME, Length);
+
 	CexAssert(m_isInitialized, "The Mac is not initialized");
 	CexAssert((InOffset + Length) <= Input.size(), "The Mac is not initialized");
 
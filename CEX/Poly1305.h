@@ -112,7 +112,9 @@ private:
 
 	bool m_autoClamp;
 	std::unique_ptr<IBlockCipher> m_blockCipher;
+	std::vector<byte> m_cprKey;
 	bool m_destroyEngine;
+	bool m_isCipherKeyed;
 	bool m_isDestroyed;
 	bool m_isInitialized;
 	std::vector<SymmetricKeySize> m_legalKeySizes;
@@ -3,6 +3,7 @@
 #include "DigestFromName.h"
 #include "HKDF.h"
 #include "IntUtils.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_BLOCK
 
@@ -186,26 +187,77 @@ void RHX::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 	Encrypt128(Input, InOffset, Output, OutOffset);
 }
 
+void RHX::ExportSchedule(std::vector<byte> &Schedule)
+{
+	if (!m_isInitialized)
+	{
+		throw CryptoSymmetricCipherException("RHX:ExportSchedule", "The cipher has not been initialized!");
+	}
+
+	// header: cipher type, direction, rounds, reserved, and the input key size in bits (m_cprKeySize is the key length * 8), little endian
+	Schedule.resize(SCHEDULE_HEADER + (m_expKey.size() * sizeof(uint)));
+	Schedule[0] = static_cast<byte>(Enumeral());
+	Schedule[1] = m_isEncryption ? 1 : 0;
+	Schedule[2] = static_cast<byte>(m_rndCount);
+	Schedule[3] = 0;
+	Utility::IntUtils::Le32ToBytes(static_cast<uint>(m_cprKeySize), Schedule, 4);
+
+	for (size_t i = 0; i < m_expKey.size(); ++i)
+	{
+		Utility::IntUtils::Le32ToBytes(m_expKey[i], Schedule, SCHEDULE_HEADER + (i * sizeof(uint)));
+	}
+}
+
+void RHX::ImportSchedule(const std::vector<byte> &Schedule)
+{
+	if (Schedule.size() < SCHEDULE_HEADER || Schedule[0] != static_cast<byte>(Enumeral()))
+	{
+		throw CryptoSymmetricCipherException("RHX:ImportSchedule", "The key schedule was not exported by this cipher type!");
+	}
+
+	const size_t RNDCNT = Schedule[2];
+	const size_t KEYLEN = Schedule.size() - SCHEDULE_HEADER;
+
+	if (Schedule[1] > 1 || Schedule[3] != 0 || RNDCNT < MIN_ROUNDS || RNDCNT > MAX_ROUNDS || KEYLEN != (BLOCK_SIZE * (RNDCNT + 1)))
+	{
+		throw CryptoSymmetricCipherException("RHX:ImportSchedule", "The key schedule is malformed!");
+	}
+
+	m_expKey.resize(KEYLEN / sizeof(uint));
+
+	for (size_t i = 0; i < m_expKey.size(); ++i)
+	{
+		m_expKey[i] = Utility::IntUtils::LeBytesTo32(Schedule, SCHEDULE_HEADER + (i * sizeof(uint)));
+	}
+
+	m_isEncryption = (Schedule[1] == 1);
+	m_cprKeySize = Utility::IntUtils::LeBytesTo32(Schedule, 4);
+	m_rndCount = RNDCNT;
+	m_isInitialized = true;
+}
+
 void RHX::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(m_legalKeySizes, KeyParams.Key().size()))
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (!SymmetricKeySize::Contains(m_legalKeySizes, kv.Key().size()))
 	{
 		throw CryptoSymmetricCipherException("RHX:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 	}
-	if (m_kdfEngineType != Enumeration::Digests::None && KeyParams.Info().size() > m_kdfInfoMax)
+	if (m_kdfEngineType != Enumeration::Digests::None && kv.Info().size() > m_kdfInfoMax)
 	{
 		throw CryptoSymmetricCipherException("RHX:Initialize", "Invalid info size! Info parameter must be no longer than DistributionCodeMax size.");
 	}
 
-	if (KeyParams.Info().size() > 0)
+	if (kv.Info().size() > 0)
 	{
-		m_kdfInfo = KeyParams.Info();
+		m_kdfInfo = kv.Info();
 	}
 
 	m_isEncryption = Encryption;
-	m_cprKeySize = KeyParams.Key().size() * 8;
+	m_cprKeySize = kv.Key().size() * 8;
 	// expand the key
-	ExpandKey(Encryption, KeyParams.Key());
+	ExpandKey(Encryption, kv.Key());
 
 #if defined(CEX_PREFETCH_RHX_TABLES)
 	Prefetch();
@@ -493,7 +545,7 @@ void RHX::StandardExpand(const std::vector<byte> &Key)
 	}
 }
 
-void RHX::ExpandRotBlock(std::vector<uint> &Key, size_t KeyIndex, size_t KeyOffset, size_t RconIndex)
+void RHX::ExpandRotBlock(SecureVector<uint> &Key, size_t KeyIndex, size_t KeyOffset, size_t RconIndex)
 {
 	size_t subKey = KeyIndex - KeyOffset;
 
@@ -509,7 +561,7 @@ void RHX::ExpandRotBlock(std::vector<uint> &Key, size_t KeyIndex, size_t KeyOffs
 	Key[KeyIndex] = Key[subKey] ^ Key[KeyIndex - 1];
 }
 
-void RHX::ExpandSubBlock(std::vector<uint> &Key, size_t KeyIndex, size_t KeyOffset)
+void RHX::ExpandSubBlock(SecureVector<uint> &Key, size_t KeyIndex, size_t KeyOffset)
 {
 	size_t subKey = KeyIndex - KeyOffset;
 
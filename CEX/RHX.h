@@ -35,6 +35,7 @@
 #define CEX_RHX_H
 
 #include "IBlockCipher.h"
+#include "SecureVector.h"
 
 NAMESPACE_BLOCK
 
@@ -121,12 +122,13 @@ private:
 	static const std::string DEF_DSTINFO;
 	static const size_t MAX_ROUNDS = 38;
 	static const size_t MIN_ROUNDS = 10;
+	static const size_t SCHEDULE_HEADER = 8;
 	// size of state buffer and lookup tables subtracted parallel size calculations
 	static const size_t STATE_PRECACHED = 5120;
 
 	size_t m_cprKeySize;
 	bool m_destroyEngine;
-	std::vector<uint> m_expKey;
+	SecureVector<uint> m_expKey;
 	std::vector<byte> m_kdfInfo;
 	bool m_isDestroyed;
 	bool m_isEncryption;
@@ -304,6 +306,27 @@ public:
 	/// <param name="OutOffset">Starting offset within the output array</param>
 	void EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
 
+	/// <summary>
+	/// Export the expanded key schedule of the initialized cipher.
+	/// <para>The schedule can be loaded into other instances of this cipher with <see cref="ImportSchedule(std::vector<byte>)"/>, so that several instances share a single key expansion.
+	/// The array holds the round keys in the clear, and should be cleared by the caller after use.</para>
+	/// </summary>
+	/// 
+	/// <param name="Schedule">The array receiving the key schedule; resized to the schedule length</param>
+	/// 
+	/// <exception cref="Exception::CryptoSymmetricCipherException">Thrown if the cipher has not been initialized</exception>
+	void ExportSchedule(std::vector<byte> &Schedule) override;
+
+	/// <summary>
+	/// Initialize the cipher with a key schedule created by <see cref="ExportSchedule(std::vector<byte>)"/>; the key is not expanded.
+	/// <para>The cipher takes the direction, rounds count and round keys of the exporting instance.</para>
+	/// </summary>
+	/// 
+	/// <param name="Schedule">The exported key schedule</param>
+	/// 
+	/// <exception cref="Exception::CryptoSymmetricCipherException">Thrown if the schedule was exported by another cipher type, or is malformed</exception>
+	void ImportSchedule(const std::vector<byte> &Schedule) override;
+
 	/// <summary>
 	/// Initialize the cipher
 	/// </summary>
@@ -384,8 +407,8 @@ private:
 	void Encrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
 	void Encrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
 	void ExpandKey(bool Encryption, const std::vector<byte> &Key);
-	void ExpandRotBlock(std::vector<uint> &Key, size_t KeyIndex, size_t KeyOffset, size_t RconIndex);
-	void ExpandSubBlock(std::vector<uint> &Key, size_t KeyIndex, size_t KeyOffset);
+	void ExpandRotBlock(SecureVector<uint> &Key, size_t KeyIndex, size_t KeyOffset, size_t RconIndex);
+	void ExpandSubBlock(SecureVector<uint> &Key, size_t KeyIndex, size_t KeyOffset);
 	void LoadState(Digests DigestType);
 	void Prefetch();
 	void SecureExpand(const std::vector<byte> &Key);
@@ -2,6 +2,7 @@
 #include "FFTQ12289N512.h"
 #include "FFTQ12289N1024.h"
 #include "GCM.h"
+#include "Instrumentation.h"
 #include "IntUtils.h"
 #include "Keccak512.h"
 #include "PrngFromName.h"
@@ -124,6 +125,8 @@ const RLWEParams RingLWE::Parameters()
 
 void RingLWE::Decapsulate(const std::vector<byte> &CipherText, std::vector<byte> &SharedSecret)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Asymmetric, CLASS_NAME, CipherText.size());
+
 	CexAssert(m_isInitialized, "The cipher has not been initialized");
 
 	std::vector<byte> secret(32);
@@ -148,6 +151,7 @@ void RingLWE::Decapsulate(const std::vector<byte> &CipherText, std::vector<byte>
 	}
 
 	// hash the message to create the shared secret
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Hashing);
 	Digest::Keccak512 dgt;
 	SharedSecret.resize(dgt.DigestSize());
 	dgt.Compute(secret, SharedSecret);
@@ -155,6 +159,8 @@ void RingLWE::Decapsulate(const std::vector<byte> &CipherText, std::vector<byte>
 
 void RingLWE::Encapsulate(std::vector<byte> &CipherText, std::vector<byte> &SharedSecret)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Asymmetric, CLASS_NAME, 0);
+
 	CexAssert(m_isInitialized, "The cipher has not been initialized");
 
 	std::vector<byte> secret(32);
@@ -183,6 +189,7 @@ void RingLWE::Encapsulate(std::vector<byte> &CipherText, std::vector<byte> &Shar
 	}
 
 	// hash the message to create the shared secret
+	CEX_INSTRUMENT_PHASE(Enumeration::InstrumentPhases::Hashing);
 	Digest::Keccak512 dgt;
 	SharedSecret.resize(dgt.DigestSize());
 	dgt.Compute(secret, SharedSecret);
@@ -190,6 +197,8 @@ void RingLWE::Encapsulate(std::vector<byte> &CipherText, std::vector<byte> &Shar
 
 std::vector<byte> RingLWE::Decrypt(const std::vector<byte> &CipherText)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Asymmetric, CLASS_NAME, CipherText.size());
+
 	CexAssert(m_isInitialized, "The cipher has not been initialized");
 	std::vector<byte> msg(0);
 
@@ -229,6 +238,8 @@ std::vector<byte> RingLWE::Decrypt(const std::vector<byte> &CipherText)
 
 std::vector<byte> RingLWE::Encrypt(const std::vector<byte> &Message)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Asymmetric, CLASS_NAME, Message.size());
+
 	CexAssert(m_isInitialized, "The cipher has not been initialized");
 
 	std::vector<byte> reply(0);
@@ -265,6 +276,8 @@ std::vector<byte> RingLWE::Encrypt(const std::vector<byte> &Message)
 
 IAsymmetricKeyPair* RingLWE::Generate()
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Asymmetric, CLASS_NAME, 0);
+
 	CexAssert(m_rlweParameters != RLWEParams::None, "The parameter setting is invalid");
 
 	std::vector<byte> pka(0);
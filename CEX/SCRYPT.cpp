@@ -5,6 +5,7 @@
 #include "PBKDF2.h"
 #include "ParallelUtils.h"
 #include "SymmetricKey.h"
+#include "SymmetricKeyView.h"
 
 NAMESPACE_KDF
 
@@ -146,25 +147,27 @@ size_t SCRYPT::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Leng
 
 void SCRYPT::Initialize(ISymmetricKey &GenParam)
 {
-	if (GenParam.Key().size() < MIN_PASSLEN)
+	Key::Symmetric::SymmetricKeyView kv(GenParam);
+
+	if (kv.Key().size() < MIN_PASSLEN)
 	{
 		throw CryptoKdfException("SCRYPT:Initialize", "Key size is too small; must be a minumum of 4 bytes!");
 	}
 
-	if (GenParam.Nonce().size() != 0)
+	if (kv.Nonce().size() != 0)
 	{
-		if (GenParam.Info().size() != 0)
+		if (kv.Info().size() != 0)
 		{
-			Initialize(GenParam.Key(), GenParam.Nonce(), GenParam.Info());
+			Initialize(kv.Key(), kv.Nonce(), kv.Info());
 		}
 		else
 		{
-			Initialize(GenParam.Key(), GenParam.Nonce());
+			Initialize(kv.Key(), kv.Nonce());
 		}
 	}
 	else
 	{
-		Initialize(GenParam.Key());
+		Initialize(kv.Key());
 	}
 }
 
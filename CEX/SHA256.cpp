@@ -2,6 +2,7 @@
 #include "SHA2.h"
 #include "IntUtils.h"
 #include "ParallelUtils.h"
+#include "Instrumentation.h"
 #if defined(__AVX__)
 #	include "Intrinsics.h"
 #endif
@@ -149,6 +150,8 @@ void SHA256::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
 
 size_t SHA256::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, 0);
+
 	CexAssert(Output.size() - OutOffset >= DIGEST_SIZE, "The Output buffer is too short!");
 
 	if (m_parallelProfile.IsParallel())
@@ -255,12 +258,16 @@ void SHA256::Update(byte Input)
 
 void SHA256::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, Length);
+
 	CexAssert(Input.size() - InOffset >= Length, "The Output buffer is too short!");
 
 	if (Length != 0)
 	{
 		if (m_parallelProfile.IsParallel())
 		{
+			CEX_INSTRUMENT_PARALLEL();
+
 			if (m_msgLength != 0 && Length + m_msgLength >= m_msgBuffer.size())
 			{
 				// fill buffer
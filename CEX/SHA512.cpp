@@ -2,6 +2,7 @@
 #include "SHA2.h"
 #include "IntUtils.h"
 #include "ParallelUtils.h"
+#include "Instrumentation.h"
 
 NAMESPACE_DIGEST
 
@@ -163,6 +164,8 @@ void SHA512::Destroy()
 
 size_t SHA512::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, 0);
+
 	CexAssert(Output.size() - OutOffset >= DIGEST_SIZE, "The Output buffer is too short!");
 
 	if (m_parallelProfile.IsParallel())
@@ -269,12 +272,16 @@ void SHA512::Update(byte Input)
 
 void SHA512::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
 {
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, Length);
+
 	CexAssert(Input.size() - InOffset >= Length, "The Output buffer is too short!");
 
 	if (Length != 0)
 	{
 		if (m_parallelProfile.IsParallel())
 		{
+			CEX_INSTRUMENT_PARALLEL();
+
 			if (m_msgLength != 0 && Length + m_msgLength >= m_msgBuffer.size())
 			{
 				// fill buffer
@@ -3,6 +3,7 @@
 #include "DigestFromName.h"
 #include "HKDF.h"
 #include "IntUtils.h"
+#include "SymmetricKeyView.h"
 #if defined(__AVX512__)
 #	include "UInt512.h"
 #elif defined(__AVX2__)
@@ -193,26 +194,77 @@ void SHX::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 	Encrypt128(Input, InOffset, Output, OutOffset);
 }
 
+void SHX::ExportSchedule(std::vector<byte> &Schedule)
+{
+	if (!m_isInitialized)
+	{
+		throw CryptoSymmetricCipherException("SHX:ExportSchedule", "The cipher has not been initialized!");
+	}
+
+	// header: cipher type, direction, rounds, reserved, and the input key size in bits (m_cprKeySize is the key length * 8), little endian
+	Schedule.resize(SCHEDULE_HEADER + (m_expKey.size() * sizeof(uint)));
+	Schedule[0] = static_cast<byte>(Enumeral());
+	Schedule[1] = m_isEncryption ? 1 : 0;
+	Schedule[2] = static_cast<byte>(m_rndCount);
+	Schedule[3] = 0;
+	Utility::IntUtils::Le32ToBytes(static_cast<uint>(m_cprKeySize), Schedule, 4);
+
+	for (size_t i = 0; i < m_expKey.size(); ++i)
+	{
+		Utility::IntUtils::Le32ToBytes(m_expKey[i], Schedule, SCHEDULE_HEADER + (i * sizeof(uint)));
+	}
+}
+
+void SHX::ImportSchedule(const std::vector<byte> &Schedule)
+{
+	if (Schedule.size() < SCHEDULE_HEADER || Schedule[0] != static_cast<byte>(Enumeral()))
+	{
+		throw CryptoSymmetricCipherException("SHX:ImportSchedule", "The key schedule was not exported by this cipher type!");
+	}
+
+	const size_t RNDCNT = Schedule[2];
+	const size_t KEYLEN = Schedule.size() - SCHEDULE_HEADER;
+
+	if (Schedule[1] > 1 || Schedule[3] != 0 || RNDCNT < MIN_ROUNDS || RNDCNT > MAX_ROUNDS || KEYLEN != (BLOCK_SIZE * (RNDCNT + 1)))
+	{
+		throw CryptoSymmetricCipherException("SHX:ImportSchedule", "The key schedule is malformed!");
+	}
+
+	m_expKey.resize(KEYLEN / sizeof(uint));
+
+	for (size_t i = 0; i < m_expKey.size(); ++i)
+	{
+		m_expKey[i] = Utility::IntUtils::LeBytesTo32(Schedule, SCHEDULE_HEADER + (i * sizeof(uint)));
+	}
+
+	m_isEncryption = (Schedule[1] == 1);
+	m_cprKeySize = Utility::IntUtils::LeBytesTo32(Schedule, 4);
+	m_rndCount = RNDCNT;
+	m_isInitialized = true;
+}
+
 void SHX::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(m_legalKeySizes, KeyParams.Key().size()))
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (!SymmetricKeySize::Contains(m_legalKeySizes, kv.Key().size()))
 	{
 		throw CryptoSymmetricCipherException("SHX:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 	}
-	if (m_kdfEngineType != Enumeration::Digests::None && KeyParams.Info().size() > m_kdfInfoMax)
+	if (m_kdfEngineType != Enumeration::Digests::None && kv.Info().size() > m_kdfInfoMax)
 	{
 		throw CryptoSymmetricCipherException("SHX:Initialize", "Invalid info size! Info parameter must be no longer than DistributionCodeMax size.");
 	}
 
-	if (KeyParams.Info().size() > 0)
+	if (kv.Info().size() > 0)
 	{
-		m_kdfInfo = KeyParams.Info();
+		m_kdfInfo = kv.Info();
 	}
 
 	m_isEncryption = Encryption;
-	m_cprKeySize = KeyParams.Key().size() * 8;
+	m_cprKeySize = kv.Key().size() * 8;
 	// expand the key
-	ExpandKey(KeyParams.Key());
+	ExpandKey(kv.Key());
 	// ready to transform data
 	m_isInitialized = true;
 }
@@ -362,7 +414,7 @@ void SHX::StandardExpand(const std::vector<byte> &Key)
 	}
 
 	// initialize the key
-	std::vector<uint> Wk(keySize, 0);
+	SecureVector<uint> Wk(keySize, 0);
 
 	if (padSize == 16)
 	{
@@ -549,7 +601,7 @@ void SHX::Decrypt1024(const std::vector<byte> &Input, const size_t InOffset, std
 void SHX::Decrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
 {
 #if defined(__AVX512__)
-	SHXDecryptW<Numeric::UInt512>(Input, InOffset, Output, OutOffset, m_expKey);
+	SHXDecrypt512(Input, InOffset, Output, OutOffset, m_expKey);
 #elif (!defined(__AVX512__)) && defined(__AVX2__)
 	SHXDecryptW<Numeric::UInt256>(Input, InOffset, Output, OutOffset, m_expKey);
 	SHXDecryptW<Numeric::UInt256>(Input, InOffset + 128, Output, OutOffset + 128, m_expKey);
@@ -697,7 +749,7 @@ void SHX::Encrypt1024(const std::vector<byte> &Input, const size_t InOffset, std
 void SHX::Encrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
 {
 #if defined(__AVX512__)
-	SHXEncryptW<Numeric::UInt512>(Input, InOffset, Output, OutOffset, m_expKey);
+	SHXEncrypt512(Input, InOffset, Output, OutOffset, m_expKey);
 #elif (!defined(__AVX512__)) && defined(__AVX2__)
 	SHXEncryptW<Numeric::UInt256>(Input, InOffset, Output, OutOffset, m_expKey);
 	SHXEncryptW<Numeric::UInt256>(Input, InOffset + 128, Output, OutOffset + 128, m_expKey);
@@ -39,6 +39,7 @@
 #define CEX_SHX_H
 
 #include "IBlockCipher.h"
+#include "SecureVector.h"
 
 NAMESPACE_BLOCK
 
@@ -126,12 +127,13 @@ private:
 	static const size_t MAX_ROUNDS = 64;
 	static const size_t MIN_ROUNDS = 32;
 	static const uint PHI = 0x9E3779B9UL;
+	static const size_t SCHEDULE_HEADER = 8;
 	// size of state buffer subtracted parallel size calculations
 	static const size_t STATE_PRECACHED = 2048;
 
 	size_t m_cprKeySize;
 	bool m_destroyEngine;
-	std::vector<uint> m_expKey;
+	SecureVector<uint> m_expKey;
 	std::unique_ptr<IDigest> m_kdfEngine;
 	Digests m_kdfEngineType;
 	std::vector<byte> m_kdfInfo;
@@ -304,6 +306,27 @@ public:
 	/// <param name="OutOffset">Starting offset within the output array</param>
 	void EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
 
+	/// <summary>
+	/// Export the expanded key schedule of the initialized cipher.
+	/// <para>The schedule can be loaded into other instances of this cipher with <see cref="ImportSchedule(std::vector<byte>)"/>, so that several instances share a single key expansion.
+	/// The array holds the round keys in the clear, and should be cleared by the caller after use.</para>
+	/// </summary>
+	/// 
+	/// <param name="Schedule">The array receiving the key schedule; resized to the schedule length</param>
+	/// 
+	/// <exception cref="Exception::CryptoSymmetricCipherException">Thrown if the cipher has not been initialized</exception>
+	void ExportSchedule(std::vector<byte> &Schedule) override;
+
+	/// <summary>
+	/// Initialize the cipher with a key schedule created by <see cref="ExportSchedule(std::vector<byte>)"/>; the key is not expanded.
+	/// <para>The cipher takes the direction, rounds count and round keys of the exporting instance.</para>
+	/// </summary>
+	/// 
+	/// <param name="Schedule">The exported key schedule</param>
+	/// 
+	/// <exception cref="Exception::CryptoSymmetricCipherException">Thrown if the schedule was exported by another cipher type, or is malformed</exception>
+	void ImportSchedule(const std::vector<byte> &Schedule) override;
+
 	/// <summary>
 	/// Initialize the cipher
 	/// </summary>
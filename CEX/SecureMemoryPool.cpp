@@ -0,0 +1,281 @@
+#include "SecureMemoryPool.h"
+#include <cstdlib>
+
+#if defined(CEX_OS_WINDOWS)
+#	include <Windows.h>
+#elif defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+
+NAMESPACE_COMMON
+
+//~~~Constructor~~~//
+
+SecureMemoryPool::PoolStatistics::PoolStatistics()
+	:
+	Arenas(0),
+	SlotsInUse(0),
+	LargeInUse(0),
+	LockedBytes(0),
+	UnlockedBytes(0)
+{
+}
+
+SecureMemoryPool::PoolState::PoolState()
+	:
+	Arenas(0),
+	FreeList(),
+	Lock(),
+	Counters()
+{
+	FreeList.fill(nullptr);
+}
+
+//~~~Public Functions~~~//
+
+void* SecureMemoryPool::Allocate(size_t Length)
+{
+	if (Length == 0)
+	{
+		Length = 1;
+	}
+
+	PoolState &state = State();
+
+	if (Length > MAX_SLOT)
+	{
+		bool locked;
+		void* ptr = MapGuarded(Length, locked);
+
+		if (ptr != nullptr)
+		{
+			std::lock_guard<std::mutex> lock(state.Lock);
+			++state.Counters.LargeInUse;
+		}
+
+		return ptr;
+	}
+
+	const size_t CLSIDX = ClassIndex(Length);
+	const size_t SLTSZE = MIN_SLOT << CLSIDX;
+	std::lock_guard<std::mutex> lock(state.Lock);
+
+	if (state.FreeList[CLSIDX] == nullptr)
+	{
+		// chunks are taken in address order, so only the newest arena can have room
+		if (state.Arenas.size() == 0 || state.Arenas.back().Next == state.Arenas.back().End)
+		{
+			bool locked;
+			byte* base = static_cast<byte*>(MapGuarded(ARENA_SIZE, locked));
+
+			if (base == nullptr)
+			{
+				return nullptr;
+			}
+
+			Arena arn = { base, base + ARENA_SIZE };
+			state.Arenas.push_back(arn);
+			++state.Counters.Arenas;
+
+			if (locked)
+			{
+				state.Counters.LockedBytes += ARENA_SIZE;
+			}
+			else
+			{
+				state.Counters.UnlockedBytes += ARENA_SIZE;
+			}
+		}
+
+		// split the next chunk into slots of this class; the lowest address is handed out first
+		byte* chunk = state.Arenas.back().Next;
+		state.Arenas.back().Next += CHUNK_SIZE;
+
+		for (size_t i = CHUNK_SIZE; i != 0; i -= SLTSZE)
+		{
+			void* slot = chunk + i - SLTSZE;
+			*static_cast<void**>(slot) = state.FreeList[CLSIDX];
+			state.FreeList[CLSIDX] = slot;
+		}
+	}
+
+	void* ptr = state.FreeList[CLSIDX];
+	state.FreeList[CLSIDX] = *static_cast<void**>(ptr);
+	// the rest of the slot was wiped when it was freed, clear the list link
+	*static_cast<void**>(ptr) = nullptr;
+	++state.Counters.SlotsInUse;
+
+	return ptr;
+}
+
+void SecureMemoryPool::Deallocate(void* Ptr, size_t Length)
+{
+	if (Ptr == nullptr)
+	{
+		return;
+	}
+
+	if (Length == 0)
+	{
+		Length = 1;
+	}
+
+	PoolState &state = State();
+
+	if (Length > MAX_SLOT)
+	{
+		Wipe(Ptr, Length);
+		UnmapGuarded(Ptr, Length);
+
+		std::lock_guard<std::mutex> lock(state.Lock);
+		--state.Counters.LargeInUse;
+
+		return;
+	}
+
+	const size_t CLSIDX = ClassIndex(Length);
+
+	// the slot still belongs to the caller, so it is wiped outside the lock
+	Wipe(Ptr, MIN_SLOT << CLSIDX);
+
+	std::lock_guard<std::mutex> lock(state.Lock);
+	*static_cast<void**>(Ptr) = state.FreeList[CLSIDX];
+	state.FreeList[CLSIDX] = Ptr;
+	--state.Counters.SlotsInUse;
+}
+
+bool SecureMemoryPool::IsProtected()
+{
+#if defined(CEX_OS_WINDOWS) || defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	return true;
+#else
+	return false;
+#endif
+}
+
+SecureMemoryPool::PoolStatistics SecureMemoryPool::Statistics()
+{
+	PoolState &state = State();
+	std::lock_guard<std::mutex> lock(state.Lock);
+
+	return state.Counters;
+}
+
+//~~~Private Functions~~~//
+
+size_t SecureMemoryPool::ClassIndex(size_t Length)
+{
+	size_t clsIdx = 0;
+	size_t sltSze = MIN_SLOT;
+
+	while (sltSze < Length)
+	{
+		sltSze <<= 1;
+		++clsIdx;
+	}
+
+	return clsIdx;
+}
+
+void* SecureMemoryPool::MapGuarded(size_t Length, bool &Locked)
+{
+	const size_t PAGSZE = PageSize();
+	const size_t MAPLEN = (Length + PAGSZE - 1) - ((Length + PAGSZE - 1) % PAGSZE);
+
+	Locked = false;
+
+#if defined(CEX_OS_WINDOWS)
+	byte* base = static_cast<byte*>(::VirtualAlloc(nullptr, MAPLEN + (2 * PAGSZE), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+
+	if (base == nullptr)
+	{
+		return nullptr;
+	}
+
+	DWORD prtFlg;
+	::VirtualProtect(base, PAGSZE, PAGE_NOACCESS, &prtFlg);
+	::VirtualProtect(base + PAGSZE + MAPLEN, PAGSZE, PAGE_NOACCESS, &prtFlg);
+	Locked = (::VirtualLock(base + PAGSZE, MAPLEN) != 0);
+
+	return base + PAGSZE;
+
+#elif defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	void* map = ::mmap(nullptr, MAPLEN + (2 * PAGSZE), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (map == MAP_FAILED)
+	{
+		return nullptr;
+	}
+
+	byte* base = static_cast<byte*>(map);
+	::mprotect(base, PAGSZE, PROT_NONE);
+	::mprotect(base + PAGSZE + MAPLEN, PAGSZE, PROT_NONE);
+	Locked = (::mlock(base + PAGSZE, MAPLEN) == 0);
+#	if defined(MADV_DONTDUMP)
+	// keep key material out of core dumps
+	::madvise(base + PAGSZE, MAPLEN, MADV_DONTDUMP);
+#	endif
+
+	return base + PAGSZE;
+
+#else
+	return std::calloc(MAPLEN, 1);
+#endif
+}
+
+size_t SecureMemoryPool::PageSize()
+{
+#if defined(CEX_OS_WINDOWS)
+	static const size_t PAGSZE = []()
+	{
+		SYSTEM_INFO inf;
+		::GetSystemInfo(&inf);
+
+		return static_cast<size_t>(inf.dwPageSize);
+	}();
+#elif defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	static const size_t PAGSZE = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#else
+	static const size_t PAGSZE = CHUNK_SIZE;
+#endif
+
+	return PAGSZE;
+}
+
+SecureMemoryPool::PoolState &SecureMemoryPool::State()
+{
+	// never destroyed, so containers released during static destruction can still return their memory
+	static PoolState* state = new PoolState();
+
+	return *state;
+}
+
+void SecureMemoryPool::UnmapGuarded(void* Ptr, size_t Length)
+{
+	const size_t PAGSZE = PageSize();
+	const size_t MAPLEN = (Length + PAGSZE - 1) - ((Length + PAGSZE - 1) % PAGSZE);
+
+#if defined(CEX_OS_WINDOWS)
+	::VirtualUnlock(Ptr, MAPLEN);
+	::VirtualFree(static_cast<byte*>(Ptr) - PAGSZE, 0, MEM_RELEASE);
+#elif defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	::munlock(Ptr, MAPLEN);
+	::munmap(static_cast<byte*>(Ptr) - PAGSZE, MAPLEN + (2 * PAGSZE));
+#else
+	std::free(Ptr);
+#endif
+}
+
+void SecureMemoryPool::Wipe(void* Ptr, size_t Length)
+{
+	// volatile stores can not be removed as dead writes
+	volatile byte* ptr = static_cast<volatile byte*>(Ptr);
+
+	for (size_t i = 0; i < Length; ++i)
+	{
+		ptr[i] = 0;
+	}
+}
+
+NAMESPACE_COMMONEND
@@ -0,0 +1,169 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_SECUREMEMORYPOOL_H
+#define CEX_SECUREMEMORYPOOL_H
+
+#include "CexDomain.h"
+#include <array>
+#include <mutex>
+#include <vector>
+
+NAMESPACE_COMMON
+
+/// <summary>
+/// A process wide pool of page-locked memory for key material.
+/// <para>Memory is mapped in arenas of ARENA_SIZE bytes, each bracketed by no-access guard pages, and locked into physical memory once when the arena is mapped, so it is never written to the swap file.
+/// Requests up to MAX_SLOT bytes are served from power of two size classes: an arena is carved into CHUNK_SIZE byte chunks, a chunk is split into the slots of one class, and freed slots are kept on a free list per class.
+/// Creating and destroying a key schedule is then a list pop and push under one lock, with no system call and no contention with the general heap.</para>
+/// <para>Larger requests are mapped individually with their own guard pages.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Key material is normally allocated through the SecureVector container:</description>
+/// <code>
+/// SecureVector&lt;uint&gt; key(60);
+/// // or directly
+/// void* ptr = SecureMemoryPool::Allocate(64);
+/// SecureMemoryPool::Deallocate(ptr, 64);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <para>A slot is wiped before it is returned to its free list, and a large mapping is wiped before it is unmapped; memory handed out by Allocate is always zeroed.
+/// Slots are aligned to their class size, so any type up to 64 byte alignment can be stored; large mappings are page aligned.</para>
+/// <para>If the operating system refuses to lock an arena, for example because the process has reached its locked memory limit (RLIMIT_MEMLOCK, or the working set minimum on Windows),
+/// the arena is still used, unlocked; Statistics reports the locked and unlocked sizes. On platforms without virtual memory support, the pool falls back to the heap, without locking or guard pages.</para>
+/// <para>Arenas are kept for the life of the process, so key material allocated during static destruction remains valid.</para>
+/// </remarks>
+class SecureMemoryPool
+{
+public:
+
+	/// <summary>
+	/// The pool usage counters
+	/// </summary>
+	struct PoolStatistics
+	{
+		/// <summary>
+		/// The number of mapped arenas
+		/// </summary>
+		size_t Arenas;
+		/// <summary>
+		/// The number of pooled slots currently allocated
+		/// </summary>
+		size_t SlotsInUse;
+		/// <summary>
+		/// The number of individually mapped large allocations currently allocated
+		/// </summary>
+		size_t LargeInUse;
+		/// <summary>
+		/// The number of arena bytes locked into physical memory
+		/// </summary>
+		size_t LockedBytes;
+		/// <summary>
+		/// The number of arena bytes the operating system refused to lock
+		/// </summary>
+		size_t UnlockedBytes;
+
+		PoolStatistics();
+	};
+
+	//~~~Constants~~~//
+
+	/// <summary>
+	/// The usable size of an arena in bytes, excluding the guard pages
+	/// </summary>
+	static const size_t ARENA_SIZE = 64 * 1024;
+
+	/// <summary>
+	/// The unit an arena is carved in for a size class
+	/// </summary>
+	static const size_t CHUNK_SIZE = 4096;
+
+	/// <summary>
+	/// The largest request served from a size class; larger requests are mapped individually
+	/// </summary>
+	static const size_t MAX_SLOT = 4096;
+
+	/// <summary>
+	/// The smallest size class
+	/// </summary>
+	static const size_t MIN_SLOT = 16;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Allocate a block of zeroed, page-locked memory
+	/// </summary>
+	///
+	/// <param name="Length">The number of bytes to allocate</param>
+	///
+	/// <returns>The block, or nullptr if the memory could not be mapped</returns>
+	static void* Allocate(size_t Length);
+
+	/// <summary>
+	/// Wipe a block and return it to the pool
+	/// </summary>
+	///
+	/// <param name="Ptr">The block returned by Allocate; a null pointer is ignored</param>
+	/// <param name="Length">The length passed to Allocate</param>
+	static void Deallocate(void* Ptr, size_t Length);
+
+	/// <summary>
+	/// Get: The operating system supports locked and guarded mappings; if false the pool allocates from the heap
+	/// </summary>
+	static bool IsProtected();
+
+	/// <summary>
+	/// Get the pool usage counters
+	/// </summary>
+	///
+	/// <returns>A copy of the counters</returns>
+	static PoolStatistics Statistics();
+
+private:
+
+	static const size_t CLASS_COUNT = 9;
+
+	struct Arena
+	{
+		byte* Next;
+		byte* End;
+	};
+
+	struct PoolState
+	{
+		std::vector<Arena> Arenas;
+		std::array<void*, CLASS_COUNT> FreeList;
+		std::mutex Lock;
+		PoolStatistics Counters;
+
+		PoolState();
+	};
+
+	static size_t ClassIndex(size_t Length);
+	static void* MapGuarded(size_t Length, bool &Locked);
+	static size_t PageSize();
+	static PoolState &State();
+	static void UnmapGuarded(void* Ptr, size_t Length);
+	static void Wipe(void* Ptr, size_t Length);
+};
+
+NAMESPACE_COMMONEND
+#endif
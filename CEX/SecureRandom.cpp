@@ -49,32 +49,23 @@ SecureRandom::~SecureRandom()
 
 void SecureRandom::Fill(std::vector<ushort> &Output, size_t Offset, size_t Elements)
 {
-	CexAssert(Output.size() - Offset <= Elements, "the output array is too short");
+	CexAssert(Output.size() - Offset >= Elements, "the output array is too short");
 
-	const size_t BUFLEN = Elements * sizeof(ushort);
-	std::vector<byte> buf(BUFLEN);
-	GetBytes(buf);
-	Utility::MemUtils::Copy(buf, 0, Output, Offset, BUFLEN);
+	Generate(reinterpret_cast<byte*>(Output.data() + Offset), Elements * sizeof(ushort));
 }
 
 void SecureRandom::Fill(std::vector<uint> &Output, size_t Offset, size_t Elements)
 {
-	CexAssert(Output.size() - Offset <= Elements, "the output array is too short");
+	CexAssert(Output.size() - Offset >= Elements, "the output array is too short");
 
-	const size_t BUFLEN = Elements * sizeof(uint);
-	std::vector<byte> buf(BUFLEN);
-	GetBytes(buf);
-	Utility::MemUtils::Copy(buf, 0, Output, Offset, BUFLEN);
+	Generate(reinterpret_cast<byte*>(Output.data() + Offset), Elements * sizeof(uint));
 }
 
 void SecureRandom::Fill(std::vector<ulong> &Output, size_t Offset, size_t Elements)
 {
-	CexAssert(Output.size() - Offset <= Elements, "the output array is too short");
+	CexAssert(Output.size() - Offset >= Elements, "the output array is too short");
 
-	const size_t BUFLEN = Elements * sizeof(ulong);
-	std::vector<byte> buf(BUFLEN);
-	GetBytes(buf);
-	Utility::MemUtils::Copy(buf, 0, Output, Offset, BUFLEN);
+	Generate(reinterpret_cast<byte*>(Output.data() + Offset), Elements * sizeof(ulong));
 }
 
 std::vector<byte> SecureRandom::GetBytes(size_t Length)
@@ -89,71 +80,44 @@ void SecureRandom::GetBytes(std::vector<byte> &Output, size_t Offset, size_t Len
 {
 	CexAssert(Offset + Length <= Output.size(), "the array is too small to fulfill this request");
 
-	std::vector<byte> rnd = GetBytes(Length);
-	Utility::MemUtils::Copy(rnd, 0, Output, Offset, Length);
+	Generate(Output.data() + Offset, Length);
 }
 
 void SecureRandom::GetBytes(std::vector<byte> &Output)
 {
 	CexAssert(Output.size() != 0, "buffer size must be at least 1 in length");
 
-	if (m_rndBuffer.size() - m_bufferIndex < Output.size())
-	{
-		size_t bufSize = m_rndBuffer.size() - m_bufferIndex;
-		// copy remaining bytes
-		if (bufSize != 0)
-		{
-			Utility::MemUtils::Copy(m_rndBuffer, m_bufferIndex, Output, 0, bufSize);
-		}
-
-		size_t rmd = Output.size() - bufSize;
-
-		while (rmd > 0)
-		{
-			// fill buffer
-			m_rngEngine->GetBytes(m_rndBuffer);
-
-			if (rmd > m_rndBuffer.size())
-			{
-				Utility::MemUtils::Copy(m_rndBuffer, 0, Output, bufSize, m_rndBuffer.size());
-				bufSize += m_rndBuffer.size();
-				rmd -= m_rndBuffer.size();
-			}
-			else
-			{
-				Utility::MemUtils::Copy(m_rndBuffer, 0, Output, bufSize, rmd);
-				m_bufferIndex = rmd;
-				rmd = 0;
-			}
-		}
-	}
-	else
-	{
-		Utility::MemUtils::Copy(m_rndBuffer, m_bufferIndex, Output, 0, Output.size());
-		m_bufferIndex += Output.size();
-	}
+	Generate(Output.data(), Output.size());
 }
 
 char SecureRandom::NextChar()
 {
-	return IO::BitConverter::ToChar(GetBytes(sizeof(char)), 0);
+	char x = 0;
+	Generate(reinterpret_cast<byte*>(&x), sizeof(char));
+
+	return x;
 }
 
 unsigned char SecureRandom::NextUChar()
 {
-	return IO::BitConverter::ToUChar(GetBytes(sizeof(unsigned char)), 0);
+	unsigned char x = 0;
+	Generate(reinterpret_cast<byte*>(&x), sizeof(unsigned char));
+
+	return x;
 }
 
 double SecureRandom::NextDouble()
 {
-	int sze = sizeof(double);
-	return IO::BitConverter::ToDouble(GetBytes(sizeof(double)), 0);
+	double x = 0;
+	Generate(reinterpret_cast<byte*>(&x), sizeof(double));
+
+	return x;
 }
 
 short SecureRandom::NextInt16()
 {
 	short x = 0;
-	Utility::MemUtils::CopyToValue(GetBytes(sizeof(short)), 0, x, sizeof(short));
+	Generate(reinterpret_cast<byte*>(&x), sizeof(short));
 
 	return x;
 }
@@ -208,7 +172,7 @@ short SecureRandom::NextInt16(short Maximum, short Minimum)
 ushort SecureRandom::NextUInt16()
 {
 	ushort x = 0;
-	Utility::MemUtils::CopyToValue(GetBytes(sizeof(ushort)), 0, x, sizeof(ushort));
+	Generate(reinterpret_cast<byte*>(&x), sizeof(ushort));
 
 	return x;
 }
@@ -263,7 +227,7 @@ ushort SecureRandom::NextUInt16(ushort Maximum, ushort Minimum)
 int SecureRandom::NextInt32()
 {
 	int x = 0;
-	Utility::MemUtils::CopyToValue(GetBytes(sizeof(int)), 0, x, sizeof(int));
+	Generate(reinterpret_cast<byte*>(&x), sizeof(int));
 
 	return x;
 }
@@ -318,7 +282,7 @@ int SecureRandom::NextInt32(int Maximum, int Minimum)
 uint SecureRandom::NextUInt32()
 {
 	uint x = 0;
-	Utility::MemUtils::CopyToValue(GetBytes(sizeof(uint)), 0, x, sizeof(uint));
+	Generate(reinterpret_cast<byte*>(&x), sizeof(uint));
 
 	return x;
 }
@@ -375,7 +339,7 @@ uint SecureRandom::NextUInt32(uint Maximum, uint Minimum)
 long SecureRandom::NextInt64()
 {
 	long x = 0;
-	Utility::MemUtils::CopyToValue(GetBytes(sizeof(long)), 0, x, sizeof(long));
+	Generate(reinterpret_cast<byte*>(&x), sizeof(long));
 
 	return x;
 }
@@ -430,7 +394,7 @@ long SecureRandom::NextInt64(long Maximum, long Minimum)
 ulong SecureRandom::NextUInt64()
 {
 	ulong x = 0;
-	Utility::MemUtils::CopyToValue(GetBytes(sizeof(ulong)), 0, x, sizeof(ulong));
+	Generate(reinterpret_cast<byte*>(&x), sizeof(ulong));
 
 	return x;
 }
@@ -488,4 +452,25 @@ void SecureRandom::Reset()
 	m_bufferIndex = 0;
 }
 
+//~~~Private Functions~~~//
+
+void SecureRandom::Generate(byte* Output, size_t Length)
+{
+	// copy straight out of the internal buffer, refilling it in place when drained
+	while (Length != 0)
+	{
+		if (m_bufferIndex == m_rndBuffer.size())
+		{
+			m_rngEngine->GetBytes(m_rndBuffer);
+			m_bufferIndex = 0;
+		}
+
+		const size_t CPYLEN = Utility::IntUtils::Min(m_rndBuffer.size() - m_bufferIndex, Length);
+		std::memcpy(Output, m_rndBuffer.data() + m_bufferIndex, CPYLEN);
+		m_bufferIndex += CPYLEN;
+		Output += CPYLEN;
+		Length -= CPYLEN;
+	}
+}
+
 NAMESPACE_PRNGEND
@@ -364,6 +364,10 @@ public:
 	/// Reset the generator instance
 	/// </summary>
 	void Reset();
+
+private:
+
+	void Generate(byte* Output, size_t Length);
 };
 
 NAMESPACE_PRNGEND
@@ -0,0 +1,120 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_SECUREVECTOR_H
+#define CEX_SECUREVECTOR_H
+
+#include "CexDomain.h"
+#include "SecureMemoryPool.h"
+#include <limits>
+#include <new>
+#include <vector>
+
+NAMESPACE_COMMON
+
+/// <summary>
+/// A standard library allocator that draws from the page-locked SecureMemoryPool.
+/// <para>Memory is zeroed when it is allocated and wiped when it is released, so a container using this allocator never leaves key material in the general heap or the swap file.</para>
+/// </summary>
+///
+/// <typeparam name="T">The element type; types up to 64 byte alignment are supported</typeparam>
+template <typename T>
+class SecureAllocator
+{
+public:
+
+	typedef T value_type;
+
+	/// <summary>
+	/// Constructor: instantiate this class
+	/// </summary>
+	SecureAllocator() noexcept
+	{
+	}
+
+	/// <summary>
+	/// Constructor: instantiate this class from an allocator of another element type
+	/// </summary>
+	template <typename U>
+	SecureAllocator(const SecureAllocator<U> &) noexcept
+	{
+	}
+
+	/// <summary>
+	/// Allocate storage for a number of elements
+	/// </summary>
+	///
+	/// <param name="Count">The number of elements</param>
+	///
+	/// <returns>The zeroed storage</returns>
+	///
+	/// <exception cref="std::bad_alloc">Thrown if the pool can not map the memory</exception>
+	T* allocate(size_t Count)
+	{
+		if (Count > std::numeric_limits<size_t>::max() / sizeof(T))
+		{
+			throw std::bad_alloc();
+		}
+
+		void* ptr = SecureMemoryPool::Allocate(Count * sizeof(T));
+
+		if (ptr == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+
+		return static_cast<T*>(ptr);
+	}
+
+	/// <summary>
+	/// Wipe and release storage
+	/// </summary>
+	///
+	/// <param name="Ptr">The storage returned by allocate</param>
+	/// <param name="Count">The number of elements passed to allocate</param>
+	void deallocate(T* Ptr, size_t Count) noexcept
+	{
+		SecureMemoryPool::Deallocate(Ptr, Count * sizeof(T));
+	}
+};
+
+template <typename T, typename U>
+inline bool operator==(const SecureAllocator<T> &, const SecureAllocator<U> &) noexcept
+{
+	// every instance draws from the same pool
+	return true;
+}
+
+template <typename T, typename U>
+inline bool operator!=(const SecureAllocator<T> &, const SecureAllocator<U> &) noexcept
+{
+	return false;
+}
+
+NAMESPACE_COMMONEND
+
+NAMESPACE_ROOT
+
+/// <summary>
+/// A vector whose storage is allocated from the page-locked SecureMemoryPool; used for key schedules and generator state
+/// </summary>
+template <typename T>
+using SecureVector = std::vector<T, Common::SecureAllocator<T>>;
+
+NAMESPACE_ROOTEND
+#endif
@@ -0,0 +1,444 @@
+#include "SeekableCipherStream.h"
+#include "ACP.h"
+#include "HKDF.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+#include "SymmetricKey.h"
+#include "SymmetricKeyView.h"
+
+NAMESPACE_IO
+
+using Utility::IntUtils;
+using Utility::MemUtils;
+
+const std::string SeekableCipherStream::CLASS_NAME("SeekableCipherStream");
+
+//~~~Constructor~~~//
+
+SeekableCipherStream::SeekableCipherStream(IByteStream* Container, ISymmetricKey &KeyParams)
+	:
+	m_chunkBuffer(0),
+	m_chunkIndex(0),
+	m_chunkLength(0),
+	m_chunkSize(0),
+	m_containerStream(Container != nullptr ? Container :
+		throw CryptoProcessingException("SeekableCipherStream:CTor", "The container stream can not be null!")),
+	m_cipherMode(nullptr),
+	m_dataOffset(0),
+	m_isDestroyed(false),
+	m_macGenerator(nullptr),
+	m_readBuffer(0),
+	m_streamLength(0),
+	m_streamPosition(0),
+	m_tagSize(0)
+{
+	if (!m_containerStream->CanSeek())
+	{
+		throw CryptoProcessingException("SeekableCipherStream:CTor", "The container stream must be seekable!");
+	}
+
+	std::vector<byte> hdr(HEADER_SIZE);
+	m_containerStream->Seek(0, SeekOrigin::Begin);
+
+	if (m_containerStream->Read(hdr, 0, hdr.size()) != hdr.size())
+	{
+		throw CryptoProcessingException("SeekableCipherStream:CTor", "The container header is truncated!");
+	}
+	if (IntUtils::LeBytesTo32(hdr, 0) != STREAM_MAGIC || hdr[4] != FORMAT_VERSION || (hdr[6] & ~FLAG_AUTHENTICATED) != 0 || hdr[7] != 0)
+	{
+		throw CryptoProcessingException("SeekableCipherStream:CTor", "The container header is invalid!");
+	}
+
+	m_chunkSize = IntUtils::LeBytesTo32(hdr, 8);
+
+	if (m_chunkSize < MIN_CHUNKSIZE || m_chunkSize > MAX_CHUNKSIZE || m_chunkSize % 16 != 0)
+	{
+		throw CryptoProcessingException("SeekableCipherStream:CTor", "The container chunk size is invalid!");
+	}
+
+	m_streamLength = IntUtils::LeBytesTo64(hdr, 12);
+	m_tagSize = (hdr[6] & FLAG_AUTHENTICATED) != 0 ? TAG_SIZE : 0;
+	m_dataOffset = HEADER_SIZE + m_tagSize;
+
+	if (m_tagSize != 0)
+	{
+		m_macGenerator.reset(new HMAC(Enumeration::Digests::SHA256));
+	}
+
+	// the header is authenticated before the cipher type it names is trusted
+	DeriveKeys(KeyParams, hdr, nullptr, m_macGenerator.get());
+
+	if (m_tagSize != 0)
+	{
+		std::vector<byte> code(TAG_SIZE);
+		std::vector<byte> tag(TAG_SIZE);
+
+		if (m_containerStream->Read(tag, 0, tag.size()) != tag.size())
+		{
+			throw CryptoProcessingException("SeekableCipherStream:CTor", "The container header is truncated!");
+		}
+
+		m_macGenerator->Update(hdr, 0, hdr.size());
+		m_macGenerator->Finalize(code, 0);
+
+		if (!IntUtils::Compare(code, 0, tag, 0, TAG_SIZE))
+		{
+			throw CryptoAuthenticationFailure("SeekableCipherStream:CTor", "The container header has failed authentication!");
+		}
+	}
+
+	m_cipherMode.reset(new CTR(static_cast<BlockCiphers>(hdr[5])));
+	DeriveKeys(KeyParams, hdr, m_cipherMode.get(), nullptr);
+	m_chunkBuffer.resize(m_chunkSize);
+	m_readBuffer.resize(m_chunkSize + m_tagSize);
+	// no chunk is cached
+	m_chunkIndex = ~0ULL;
+}
+
+SeekableCipherStream::~SeekableCipherStream()
+{
+	Destroy();
+}
+
+//~~~Accessors~~~//
+
+const bool SeekableCipherStream::CanRead()
+{
+	return true;
+}
+
+const bool SeekableCipherStream::CanSeek()
+{
+	return true;
+}
+
+const bool SeekableCipherStream::CanWrite()
+{
+	return false;
+}
+
+const size_t SeekableCipherStream::ChunkSize()
+{
+	return m_chunkSize;
+}
+
+const StreamModes SeekableCipherStream::Enumeral()
+{
+	return StreamModes::SeekableCipherStream;
+}
+
+const bool SeekableCipherStream::IsAuthenticated()
+{
+	return (m_tagSize != 0);
+}
+
+const ulong SeekableCipherStream::Length()
+{
+	return m_streamLength;
+}
+
+const std::string SeekableCipherStream::Name()
+{
+	return CLASS_NAME;
+}
+
+const ulong SeekableCipherStream::Position()
+{
+	return m_streamPosition;
+}
+
+//~~~Public Functions~~~//
+
+ulong SeekableCipherStream::CalculateSize(ulong Length, size_t ChunkSize, bool Authenticate)
+{
+	const ulong CHKCNT = (Length + ChunkSize - 1) / ChunkSize;
+	const size_t TAGLEN = Authenticate ? TAG_SIZE : 0;
+
+	return HEADER_SIZE + TAGLEN + Length + (CHKCNT * TAGLEN);
+}
+
+void SeekableCipherStream::Close()
+{
+	Destroy();
+}
+
+void SeekableCipherStream::CopyTo(IByteStream* Destination)
+{
+	std::vector<byte> otp(m_chunkSize);
+
+	while (m_streamPosition < m_streamLength)
+	{
+		const size_t OUTLEN = Read(otp, 0, otp.size());
+		Destination->Write(otp, 0, OUTLEN);
+	}
+}
+
+void SeekableCipherStream::Create(IByteStream* Input, IByteStream* Container, ISymmetricKey &KeyParams, BlockCiphers CipherType, size_t ChunkSize, bool Authenticate)
+{
+	if (Input == nullptr || Container == nullptr)
+	{
+		throw CryptoProcessingException("SeekableCipherStream:Create", "The streams can not be null!");
+	}
+	if (ChunkSize < MIN_CHUNKSIZE || ChunkSize > MAX_CHUNKSIZE || ChunkSize % 16 != 0)
+	{
+		throw CryptoProcessingException("SeekableCipherStream:Create", "The chunk size must be a multiple of 16, between MIN_CHUNKSIZE and MAX_CHUNKSIZE!");
+	}
+	if (CipherType == BlockCiphers::None)
+	{
+		throw CryptoProcessingException("SeekableCipherStream:Create", "The cipher type can not be none!");
+	}
+
+	const ulong INPLEN = Input->Length() - Input->Position();
+	const size_t TAGLEN = Authenticate ? TAG_SIZE : 0;
+	std::vector<byte> hdr(HEADER_SIZE);
+
+	IntUtils::Le32ToBytes(STREAM_MAGIC, hdr, 0);
+	hdr[4] = FORMAT_VERSION;
+	hdr[5] = static_cast<byte>(CipherType);
+	hdr[6] = Authenticate ? FLAG_AUTHENTICATED : 0;
+	hdr[7] = 0;
+	IntUtils::Le32ToBytes(static_cast<uint>(ChunkSize), hdr, 8);
+	IntUtils::Le64ToBytes(INPLEN, hdr, 12);
+
+	// a random salt gives every container its own cipher and mac keys
+	Provider::ACP rnd;
+	rnd.GetBytes(hdr, 20, SALT_SIZE);
+
+	CTR cpr(CipherType);
+	std::unique_ptr<HMAC> mac(Authenticate ? new HMAC(Enumeration::Digests::SHA256) : nullptr);
+	DeriveKeys(KeyParams, hdr, &cpr, mac.get());
+	Container->Write(hdr, 0, hdr.size());
+
+	std::vector<byte> inp(ChunkSize);
+	std::vector<byte> otp(ChunkSize + TAGLEN);
+
+	if (Authenticate)
+	{
+		mac->Update(hdr, 0, hdr.size());
+		mac->Finalize(otp, 0);
+		Container->Write(otp, 0, TAGLEN);
+	}
+
+	ulong idx = 0;
+	ulong prcLen = 0;
+
+	while (prcLen < INPLEN)
+	{
+		const size_t CHKLEN = static_cast<size_t>(IntUtils::Min(static_cast<ulong>(ChunkSize), INPLEN - prcLen));
+
+		if (Input->Read(inp, 0, CHKLEN) != CHKLEN)
+		{
+			throw CryptoProcessingException("SeekableCipherStream:Create", "The input stream is shorter than its length!");
+		}
+
+		LoadCounter(&cpr, idx, ChunkSize);
+		cpr.Transform(inp, 0, otp, 0, CHKLEN);
+
+		if (Authenticate)
+		{
+			TagChunk(mac.get(), idx, otp, CHKLEN, otp, CHKLEN);
+		}
+
+		Container->Write(otp, 0, CHKLEN + TAGLEN);
+		prcLen += CHKLEN;
+		++idx;
+	}
+
+	MemUtils::Clear(inp, 0, inp.size());
+}
+
+void SeekableCipherStream::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_chunkIndex = ~0ULL;
+		m_chunkLength = 0;
+		m_streamPosition = 0;
+
+		if (m_cipherMode != nullptr)
+		{
+			m_cipherMode.reset(nullptr);
+		}
+		if (m_macGenerator != nullptr)
+		{
+			m_macGenerator.reset(nullptr);
+		}
+
+		IntUtils::ClearVector(m_chunkBuffer);
+		IntUtils::ClearVector(m_readBuffer);
+	}
+}
+
+size_t SeekableCipherStream::Read(std::vector<byte> &Output, size_t Offset, size_t Length)
+{
+	CexAssert(Offset + Length <= Output.size(), "length is longer than the array size");
+
+	if (m_isDestroyed)
+	{
+		throw CryptoProcessingException("SeekableCipherStream:Read", "The stream has been closed!");
+	}
+	if (m_streamPosition >= m_streamLength)
+	{
+		return 0;
+	}
+	if (Length > m_streamLength - m_streamPosition)
+	{
+		Length = static_cast<size_t>(m_streamLength - m_streamPosition);
+	}
+
+	size_t prcLen = 0;
+
+	while (prcLen < Length)
+	{
+		const ulong CHKIDX = m_streamPosition / m_chunkSize;
+		const size_t CHKOFF = static_cast<size_t>(m_streamPosition % m_chunkSize);
+
+		if (CHKIDX != m_chunkIndex)
+		{
+			LoadChunk(CHKIDX);
+		}
+
+		const size_t CPYLEN = IntUtils::Min(m_chunkLength - CHKOFF, Length - prcLen);
+		MemUtils::Copy(m_chunkBuffer, CHKOFF, Output, Offset + prcLen, CPYLEN);
+		prcLen += CPYLEN;
+		m_streamPosition += CPYLEN;
+	}
+
+	return prcLen;
+}
+
+byte SeekableCipherStream::ReadByte()
+{
+	std::vector<byte> data(1);
+
+	if (Read(data, 0, 1) != 1)
+	{
+		throw CryptoProcessingException("SeekableCipherStream:ReadByte", "The stream position is at the end of the stream!");
+	}
+
+	return data[0];
+}
+
+void SeekableCipherStream::Reset()
+{
+	m_streamPosition = 0;
+}
+
+void SeekableCipherStream::Seek(ulong Offset, SeekOrigin Origin)
+{
+	if (Origin == SeekOrigin::Begin)
+	{
+		m_streamPosition = Offset;
+	}
+	else if (Origin == SeekOrigin::End)
+	{
+		m_streamPosition = m_streamLength - Offset;
+	}
+	else
+	{
+		m_streamPosition += Offset;
+	}
+}
+
+void SeekableCipherStream::SetLength(ulong Length)
+{
+	throw CryptoProcessingException("SeekableCipherStream:SetLength", "The stream is read only!");
+}
+
+void SeekableCipherStream::Write(const std::vector<byte> &Input, size_t Offset, size_t Length)
+{
+	throw CryptoProcessingException("SeekableCipherStream:Write", "The stream is read only!");
+}
+
+void SeekableCipherStream::WriteByte(byte Value)
+{
+	throw CryptoProcessingException("SeekableCipherStream:WriteByte", "The stream is read only!");
+}
+
+//~~~Private Functions~~~//
+
+void SeekableCipherStream::DeriveKeys(ISymmetricKey &KeyParams, const std::vector<byte> &Header, CTR* Cipher, HMAC* Mac)
+{
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (kv.Key().size() < MIN_KEYSIZE)
+	{
+		throw CryptoProcessingException("SeekableCipherStream:DeriveKeys", "The key must be at least MIN_KEYSIZE bytes!");
+	}
+
+	// the info string binds the keys to the container parameters
+	std::vector<byte> info(Header.begin(), Header.begin() + 20);
+	std::vector<byte> salt(Header.begin() + 20, Header.end());
+	std::vector<byte> key(kv.Key().begin(), kv.Key().end());
+	std::vector<byte> prk(CIPHER_KEY + 16 + TAG_SIZE);
+
+	Kdf::HKDF kdf(Enumeration::Digests::SHA256);
+	kdf.Initialize(key, salt, info);
+	kdf.Generate(prk, 0, prk.size());
+
+	if (Cipher != nullptr)
+	{
+		Key::Symmetric::SymmetricKey kp(std::vector<byte>(prk.begin(), prk.begin() + CIPHER_KEY), std::vector<byte>(prk.begin() + CIPHER_KEY, prk.begin() + CIPHER_KEY + 16));
+		// a chunk is processed by the calling thread; the ranges are random and usually short
+		Cipher->ParallelProfile().IsParallel() = false;
+		Cipher->Initialize(true, kp);
+	}
+	if (Mac != nullptr)
+	{
+		Key::Symmetric::SymmetricKey kp(std::vector<byte>(prk.begin() + CIPHER_KEY + 16, prk.end()));
+		Mac->Initialize(kp);
+	}
+
+	MemUtils::Clear(key, 0, key.size());
+	MemUtils::Clear(prk, 0, prk.size());
+}
+
+void SeekableCipherStream::LoadChunk(ulong Index)
+{
+	const ulong CHKOFF = m_dataOffset + (Index * (m_chunkSize + m_tagSize));
+	const size_t CHKLEN = static_cast<size_t>(IntUtils::Min(static_cast<ulong>(m_chunkSize), m_streamLength - (Index * m_chunkSize)));
+
+	// invalidate the cache first, so a failed chunk is never served by a later read
+	m_chunkIndex = ~0ULL;
+	m_containerStream->Seek(CHKOFF, SeekOrigin::Begin);
+
+	if (m_containerStream->Read(m_readBuffer, 0, CHKLEN + m_tagSize) != CHKLEN + m_tagSize)
+	{
+		throw CryptoProcessingException("SeekableCipherStream:LoadChunk", "The container is truncated!");
+	}
+
+	if (m_tagSize != 0)
+	{
+		std::vector<byte> code(TAG_SIZE);
+		TagChunk(m_macGenerator.get(), Index, m_readBuffer, CHKLEN, code, 0);
+
+		if (!IntUtils::Compare(code, 0, m_readBuffer, CHKLEN, TAG_SIZE))
+		{
+			throw CryptoAuthenticationFailure("SeekableCipherStream:LoadChunk", "The chunk has failed authentication!");
+		}
+	}
+
+	LoadCounter(m_cipherMode.get(), Index, m_chunkSize);
+	m_cipherMode->Transform(m_readBuffer, 0, m_chunkBuffer, 0, CHKLEN);
+	m_chunkLength = CHKLEN;
+	m_chunkIndex = Index;
+}
+
+void SeekableCipherStream::LoadCounter(CTR* Cipher, ulong Index, size_t ChunkSize)
+{
+	// the upper half of the counter is the derived nonce, the lower half the block index of the chunk
+	IntUtils::Be64ToBytes(Index * (ChunkSize / 16), Cipher->Nonce(), 8);
+}
+
+void SeekableCipherStream::TagChunk(HMAC* Mac, ulong Index, const std::vector<byte> &Input, size_t Length, std::vector<byte> &Output, size_t OutOffset)
+{
+	std::vector<byte> ctr(sizeof(ulong));
+
+	IntUtils::Be64ToBytes(Index, ctr, 0);
+	Mac->Update(ctr, 0, ctr.size());
+	Mac->Update(Input, 0, Length);
+	Mac->Finalize(Output, OutOffset);
+}
+
+NAMESPACE_IOEND
@@ -0,0 +1,360 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+// Implementation Details:
+// A random access encrypted container; chunks are encrypted in counter mode, with the counter derived from the chunk index,
+// and optionally authenticated with a per-chunk HMAC, so any byte range can be decrypted without processing the preceding data.
+
+#ifndef CEX_SEEKABLECIPHERSTREAM_H
+#define CEX_SEEKABLECIPHERSTREAM_H
+
+#include "IByteStream.h"
+#include "BlockCiphers.h"
+#include "CryptoAuthenticationFailure.h"
+#include "CTR.h"
+#include "HMAC.h"
+#include "ISymmetricKey.h"
+
+NAMESPACE_IO
+
+using Enumeration::BlockCiphers;
+using Exception::CryptoAuthenticationFailure;
+using Cipher::Symmetric::Block::Mode::CTR;
+using Mac::HMAC;
+using Key::Symmetric::ISymmetricKey;
+
+/// <summary>
+/// A random access encrypted container stream.
+/// <para>The container stores the plain-text as a sequence of fixed size chunks, each encrypted with a counter derived from its index, and optionally followed by a MAC.
+/// This class is a read only IByteStream over the plain-text; Seek is free, and Read decrypts and verifies only the chunks that overlap the requested range.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Creating a container from a file:</description>
+/// <code>
+/// SymmetricKey kp(key);
+/// FileStream inp("C://Tests//test.bin", FileStream::FileAccess::Read);
+/// FileStream out("C://Tests//test.enc", FileStream::FileAccess::ReadWrite);
+///
+/// SeekableCipherStream::Create(&amp;inp, &amp;out, kp);
+/// </code>
+/// </example>
+///
+/// <example>
+/// <description>Reading a range from the middle of the container:</description>
+/// <code>
+/// SeekableCipherStream cs(&amp;out, kp);
+/// std::vector&lt;byte&gt; range(100 * 1024);
+///
+/// cs.Seek(offset, SeekOrigin::Begin);
+/// cs.Read(range, 0, range.size());
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description><B>Container Format:</B></description>
+/// <para>The container begins with a HEADER_SIZE byte header: a four byte magic value, the format version, the block cipher, a flags byte, a reserved byte,
+/// the chunk size as a 32bit little endian integer, the plain-text length as a 64bit little endian integer, and a SALT_SIZE byte random salt.
+/// If the container is authenticated, the header is followed by a TAG_SIZE byte MAC of the header. \n
+/// The chunks follow; each is ChunkSize() bytes of cipher-text, followed by a TAG_SIZE byte MAC if the container is authenticated, and only the last chunk can be shorter.
+/// Chunk i begins at DataOffset + i * (ChunkSize + TagSize), so a byte offset is mapped to its chunk without an index table.</para>
+///
+/// <description><B>Keys and Counters:</B></description>
+/// <para>The cipher and MAC keys are derived from the master key with HKDF(SHA2-256), using the random salt, and the header fields as the info string, so every container has its own keys. \n
+/// The counter of chunk i is the first eight bytes of the derived nonce, followed by (i * ChunkSize / 16) as a 64bit big endian block counter;
+/// the counter sequences of the chunks are contiguous and never overlap, so the cipher is keyed once and a chunk only loads a new counter.
+/// A chunk MAC is HMAC(SHA2-256) over the 64bit big endian chunk index and the chunk cipher-text; a chunk can not be moved, or copied from another container, without failing authentication.</para>
+///
+/// <description><B>Implementation Notes:</B></description>
+/// <list type="bullet">
+/// <item><description>The stream does not own the container stream; the container must remain open for the lifetime of this class.</description></item>
+/// <item><description>The most recently decrypted chunk is cached, so sequential and small reads touch the container once per chunk.</description></item>
+/// <item><description>Reads of an authenticated container throw CryptoAuthenticationFailure on the first chunk that fails verification; no unverified plain-text is returned.</description></item>
+/// <item><description>An unauthenticated container provides confidentiality only; modified cipher-text decrypts to modified plain-text.</description></item>
+/// <item><description>The master key must be at least MIN_KEYSIZE bytes; the containers are created with a 256bit cipher key.</description></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>NIST <a href="http://csrc.nist.gov/publications/nistpubs/800-38a/sp800-38a.pdf">SP800-38A</a>.</description></item>
+/// <item><description>RFC <a href="http://tools.ietf.org/html/rfc5869">5869</a>: HMAC-based Extract-and-Expand Key Derivation Function (HKDF).</description></item>
+/// </list>
+/// </remarks>
+class SeekableCipherStream final : public IByteStream
+{
+private:
+
+	static const std::string CLASS_NAME;
+	static const size_t CIPHER_KEY = 32;
+	static const byte FLAG_AUTHENTICATED = 0x01;
+	static const byte FORMAT_VERSION = 1;
+	static const uint STREAM_MAGIC = 0x41525843;
+
+	std::vector<byte> m_chunkBuffer;
+	ulong m_chunkIndex;
+	size_t m_chunkLength;
+	size_t m_chunkSize;
+	IByteStream* m_containerStream;
+	std::unique_ptr<CTR> m_cipherMode;
+	ulong m_dataOffset;
+	bool m_isDestroyed;
+	std::unique_ptr<HMAC> m_macGenerator;
+	std::vector<byte> m_readBuffer;
+	ulong m_streamLength;
+	ulong m_streamPosition;
+	size_t m_tagSize;
+
+public:
+
+	//~~~Constants~~~//
+
+	/// <summary>
+	/// The default chunk size in bytes
+	/// </summary>
+	static const size_t DEF_CHUNKSIZE = 64 * 1024;
+
+	/// <summary>
+	/// The size of the container header in bytes, not including the header MAC
+	/// </summary>
+	static const size_t HEADER_SIZE = 36;
+
+	/// <summary>
+	/// The largest legal chunk size in bytes
+	/// </summary>
+	static const size_t MAX_CHUNKSIZE = 16 * 1024 * 1024;
+
+	/// <summary>
+	/// The smallest legal chunk size in bytes
+	/// </summary>
+	static const size_t MIN_CHUNKSIZE = 512;
+
+	/// <summary>
+	/// The minimum master key size in bytes
+	/// </summary>
+	static const size_t MIN_KEYSIZE = 16;
+
+	/// <summary>
+	/// The size of the random key derivation salt in bytes
+	/// </summary>
+	static const size_t SALT_SIZE = 16;
+
+	/// <summary>
+	/// The size of a MAC tag in bytes
+	/// </summary>
+	static const size_t TAG_SIZE = 32;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	SeekableCipherStream(const SeekableCipherStream&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	SeekableCipherStream& operator=(const SeekableCipherStream&) = delete;
+
+	/// <summary>
+	/// Default constructor: default is restricted, this function has been deleted
+	/// </summary>
+	SeekableCipherStream() = delete;
+
+	/// <summary>
+	/// Constructor: open an encrypted container.
+	/// <para>The header is read from the start of the container stream, the keys are derived, and the header MAC is verified.</para>
+	/// </summary>
+	///
+	/// <param name="Container">The seekable stream containing the encrypted container</param>
+	/// <param name="KeyParams">The ISymmetricKey containing the master key</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the container is not seekable, the header is invalid or truncated, or the key is too small</exception>
+	/// <exception cref="Exception::CryptoAuthenticationFailure">Thrown if the header fails authentication</exception>
+	SeekableCipherStream(IByteStream* Container, ISymmetricKey &KeyParams);
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~SeekableCipherStream() override;
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The stream can be read
+	/// </summary>
+	const bool CanRead() override;
+
+	/// <summary>
+	/// Read Only: The stream is seekable
+	/// </summary>
+	const bool CanSeek() override;
+
+	/// <summary>
+	/// Read Only: The stream can be written to; always false
+	/// </summary>
+	const bool CanWrite() override;
+
+	/// <summary>
+	/// Read Only: The plain-text size of a chunk in bytes
+	/// </summary>
+	const size_t ChunkSize();
+
+	/// <summary>
+	/// Read Only: The stream container type
+	/// </summary>
+	const StreamModes Enumeral() override;
+
+	/// <summary>
+	/// Read Only: The container chunks are authenticated
+	/// </summary>
+	const bool IsAuthenticated();
+
+	/// <summary>
+	/// Read Only: The plain-text length
+	/// </summary>
+	const ulong Length() override;
+
+	/// <summary>
+	/// Read Only: The streams class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Read Only: The streams current position within the plain-text
+	/// </summary>
+	const ulong Position() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Get the size of an encrypted container for a plain-text length
+	/// </summary>
+	///
+	/// <param name="Length">The plain-text length in bytes</param>
+	/// <param name="ChunkSize">The chunk size</param>
+	/// <param name="Authenticate">The chunks are authenticated</param>
+	///
+	/// <returns>The container length, including the header and tags</returns>
+	static ulong CalculateSize(ulong Length, size_t ChunkSize = DEF_CHUNKSIZE, bool Authenticate = true);
+
+	/// <summary>
+	/// Close the stream and erase the keys; the container stream is not closed
+	/// </summary>
+	void Close() override;
+
+	/// <summary>
+	/// Decrypt the plain-text from the current position to the end of the stream, and write it to another stream
+	/// </summary>
+	///
+	/// <param name="Destination">The destination stream</param>
+	void CopyTo(IByteStream* Destination) override;
+
+	/// <summary>
+	/// Create an encrypted container.
+	/// <para>Encrypts the input stream from its position to its end, and writes the container to the current position of the output stream.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The plain-text input stream</param>
+	/// <param name="Container">The stream that receives the container</param>
+	/// <param name="KeyParams">The ISymmetricKey containing the master key</param>
+	/// <param name="CipherType">The block cipher used in counter mode</param>
+	/// <param name="ChunkSize">The plain-text size of a chunk; must be a multiple of 16, between MIN_CHUNKSIZE and MAX_CHUNKSIZE</param>
+	/// <param name="Authenticate">Append a MAC to the header and to each chunk</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the key, cipher, or chunk size is invalid</exception>
+	static void Create(IByteStream* Input, IByteStream* Container, ISymmetricKey &KeyParams, BlockCiphers CipherType = BlockCiphers::RHX, size_t ChunkSize = DEF_CHUNKSIZE, bool Authenticate = true);
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Decrypt a range of the plain-text into an output buffer.
+	/// <para>Only the chunks that overlap the range are read from the container.</para>
+	/// </summary>
+	///
+	/// <param name="Output">The output array receiving the bytes</param>
+	/// <param name="Offset">Offset within the output array at which to begin</param>
+	/// <param name="Length">The number of bytes to read</param>
+	///
+	/// <returns>The number of bytes read</returns>
+	///
+	/// <exception cref="Exception::CryptoAuthenticationFailure">Thrown if a chunk fails authentication</exception>
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the container is truncated</exception>
+	size_t Read(std::vector<byte> &Output, size_t Offset, size_t Length) override;
+
+	/// <summary>
+	/// Read a single byte from the stream
+	/// </summary>
+	///
+	/// <returns>The read byte value</returns>
+	byte ReadByte() override;
+
+	/// <summary>
+	/// Reset the stream position to zero
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Seek to a position within the plain-text; no data is read until the next call to Read
+	/// </summary>
+	///
+	/// <param name="Offset">The offset position</param>
+	/// <param name="Origin">The starting point</param>
+	void Seek(ulong Offset, SeekOrigin Origin) override;
+
+	/// <summary>
+	/// Not supported; the stream is read only
+	/// </summary>
+	///
+	/// <param name="Length">The desired length</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown on any call</exception>
+	void SetLength(ulong Length) override;
+
+	/// <summary>
+	/// Not supported; the stream is read only
+	/// </summary>
+	///
+	/// <param name="Input">The input array to write to the stream</param>
+	/// <param name="Offset">Offset within the input array at which to begin</param>
+	/// <param name="Length">The number of bytes to write</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown on any call</exception>
+	void Write(const std::vector<byte> &Input, size_t Offset, size_t Length) override;
+
+	/// <summary>
+	/// Not supported; the stream is read only
+	/// </summary>
+	///
+	/// <param name="Value">The byte value to write</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown on any call</exception>
+	void WriteByte(byte Value) override;
+
+private:
+
+	static void DeriveKeys(ISymmetricKey &KeyParams, const std::vector<byte> &Header, CTR* Cipher, HMAC* Mac);
+	static void LoadCounter(CTR* Cipher, ulong Index, size_t ChunkSize);
+	static void TagChunk(HMAC* Mac, ulong Index, const std::vector<byte> &Input, size_t Length, std::vector<byte> &Output, size_t OutOffset);
+	void LoadChunk(ulong Index);
+};
+
+NAMESPACE_IOEND
+#endif
@@ -20,6 +20,10 @@
 #define CEX_SERPENT_H
 
 #include "CexDomain.h"
+#include "SecureVector.h"
+#if defined(__AVX512__)
+#	include "UInt512.h"
+#endif
 
 NAMESPACE_BLOCK
 
@@ -28,7 +32,7 @@ NAMESPACE_BLOCK
 /// 
 
 template<typename T>
-static void SHXDecryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Key)
+static void SHXDecryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, SecureVector<uint> &Key)
 {
 #if defined(__AVX__) || defined(__AVX2__) || defined(__AVX512__)
 
@@ -170,7 +174,7 @@ static void SHXDecryptW(const std::vector<byte> &Input, const size_t InOffset, s
 }
 
 template<typename T>
-static void SHXEncryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Key)
+static void SHXEncryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, SecureVector<uint> &Key)
 {
 #if defined(__AVX__) || defined(__AVX2__) || defined(__AVX512__)
 
@@ -793,5 +797,473 @@ static void Ib7(T &R0, T &R1, T &R2, T &R3)
 	R3 = B4;
 }
 
+#if defined(__AVX512__)
+
+//~~~AVX-512 Ternary Logic Kernels~~~//
+
+// The S-box circuits below compute each output bit with vpternlogd nodes, every node is an arbitrary boolean function of three registers.
+// The circuits were derived from the truth tables of the two-input circuits above, and replace their 17 to 24 AND, OR, XOR, NOT and copy steps with 8 or 9 instructions.
+// The output register order matches the generic circuits, so the kernels share the key schedule and the linear transform of the wide transforms.
+
+inline static void Sb0T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R1, R2, R3, 0xD9);
+	const __m512i T1 = _mm512_ternarylogic_epi32(R1, R2, R3, 0x52);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R0, T1, T0, 0xCA);
+	const __m512i T3 = _mm512_ternarylogic_epi32(R2, R3, T2, 0xB4);
+	const __m512i T4 = _mm512_ternarylogic_epi32(T3, R0, R1, 0xD3);
+	const __m512i T5 = _mm512_ternarylogic_epi32(T1, T2, T3, 0x29);
+	const __m512i T6 = _mm512_ternarylogic_epi32(T5, R0, R1, 0x96);
+	const __m512i T7 = _mm512_ternarylogic_epi32(R0, R2, R3, 0xC9);
+	const __m512i T8 = _mm512_ternarylogic_epi32(T7, R0, R1, 0xA5);
+
+	R0 = T2;
+	R1 = T4;
+	R2 = T6;
+	R3 = T8;
+}
+
+inline static void Ib0T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R1, R2, R3, 0x5B);
+	const __m512i T1 = _mm512_ternarylogic_epi32(R1, R2, R3, 0x29);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R0, T1, T0, 0xCA);
+	const __m512i T3 = _mm512_ternarylogic_epi32(R1, R2, T2, 0x87);
+	const __m512i T4 = _mm512_ternarylogic_epi32(T3, R0, T0, 0xD6);
+	const __m512i T5 = _mm512_ternarylogic_epi32(R0, R2, R3, 0x66);
+	const __m512i T6 = _mm512_ternarylogic_epi32(T5, R0, R1, 0xE1);
+	const __m512i T7 = _mm512_ternarylogic_epi32(T3, T4, T6, 0x5B);
+	const __m512i T8 = _mm512_ternarylogic_epi32(T7, R0, R2, 0xA5);
+
+	R0 = T2;
+	R1 = T4;
+	R2 = T6;
+	R3 = T8;
+}
+
+inline static void Sb1T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R0, R2, R3, 0x96);
+	const __m512i T1 = _mm512_ternarylogic_epi32(T0, R0, R1, 0xE1);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R1, R2, T0, 0x61);
+	const __m512i T3 = _mm512_ternarylogic_epi32(T2, R0, T0, 0xF1);
+	const __m512i T4 = _mm512_ternarylogic_epi32(R3, T1, T2, 0x2C);
+	const __m512i T5 = _mm512_ternarylogic_epi32(T4, R1, T0, 0xD2);
+	const __m512i T6 = _mm512_ternarylogic_epi32(R1, R3, T4, 0xB4);
+	const __m512i T7 = _mm512_ternarylogic_epi32(T6, R0, R2, 0x87);
+
+	R0 = T5;
+	R1 = T3;
+	R2 = T1;
+	R3 = T7;
+}
+
+inline static void Ib1T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R1, R2, R3, 0x2F);
+	const __m512i T1 = _mm512_ternarylogic_epi32(R1, R2, R3, 0x68);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R0, T1, T0, 0xCA);
+	const __m512i T3 = _mm512_ternarylogic_epi32(R0, R2, T0, 0xD6);
+	const __m512i T4 = _mm512_ternarylogic_epi32(T3, R0, R3, 0x61);
+	const __m512i T5 = _mm512_ternarylogic_epi32(T1, T2, T3, 0x81);
+	const __m512i T6 = _mm512_ternarylogic_epi32(T5, R0, R3, 0xA5);
+	const __m512i T7 = _mm512_ternarylogic_epi32(R1, R2, R3, 0x39);
+	const __m512i T8 = _mm512_ternarylogic_epi32(T7, R0, R1, 0xC3);
+
+	R0 = T2;
+	R1 = T4;
+	R2 = T6;
+	R3 = T8;
+}
+
+inline static void Sb2T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R0, R2, R3, 0x59);
+	const __m512i T1 = _mm512_ternarylogic_epi32(T0, R0, R1, 0xA5);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R0, R3, T1, 0x38);
+	const __m512i T3 = _mm512_ternarylogic_epi32(T2, R1, R2, 0xB4);
+	const __m512i T4 = _mm512_ternarylogic_epi32(R0, R2, T2, 0xC5);
+	const __m512i T5 = _mm512_ternarylogic_epi32(T4, R1, T0, 0xD2);
+	const __m512i T6 = _mm512_ternarylogic_epi32(R1, R2, T0, 0xAC);
+	const __m512i T7 = _mm512_ternarylogic_epi32(T6, R0, R1, 0xC3);
+
+	R0 = T1;
+	R1 = T5;
+	R2 = T3;
+	R3 = T7;
+}
+
+inline static void Ib2T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R1, R2, R3, 0xA3);
+	const __m512i T1 = _mm512_ternarylogic_epi32(T0, R0, R1, 0xC3);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R1, R2, R3, 0xB4);
+	const __m512i T3 = _mm512_ternarylogic_epi32(R1, R2, R3, 0xC6);
+	const __m512i T4 = _mm512_ternarylogic_epi32(R0, T3, T2, 0xCA);
+	const __m512i T5 = _mm512_ternarylogic_epi32(R0, T2, T3, 0xC5);
+	const __m512i T6 = _mm512_ternarylogic_epi32(T1, T4, T5, 0x39);
+	const __m512i T7 = _mm512_ternarylogic_epi32(T6, R0, R1, 0xC3);
+
+	R0 = T1;
+	R1 = T4;
+	R2 = T5;
+	R3 = T7;
+}
+
+inline static void Sb3T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R1, R2, R3, 0x92);
+	const __m512i T1 = _mm512_ternarylogic_epi32(R1, R2, R3, 0x4F);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R0, T1, T0, 0xCA);
+	const __m512i T3 = _mm512_ternarylogic_epi32(R2, T1, T2, 0xD1);
+	const __m512i T4 = _mm512_ternarylogic_epi32(T3, R0, R3, 0x96);
+	const __m512i T5 = _mm512_ternarylogic_epi32(R2, T2, T4, 0x78);
+	const __m512i T6 = _mm512_ternarylogic_epi32(T5, R1, R3, 0xB4);
+	const __m512i T7 = _mm512_ternarylogic_epi32(R1, T3, T5, 0x96);
+	const __m512i T8 = _mm512_ternarylogic_epi32(T7, R0, R3, 0xD2);
+
+	R0 = T2;
+	R1 = T8;
+	R2 = T4;
+	R3 = T6;
+}
+
+inline static void Ib3T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R1, R2, R3, 0xD3);
+	const __m512i T1 = _mm512_ternarylogic_epi32(T0, R0, R3, 0xE1);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R1, R2, T1, 0x42);
+	const __m512i T3 = _mm512_ternarylogic_epi32(T2, R0, R3, 0x96);
+	const __m512i T4 = _mm512_ternarylogic_epi32(R0, R1, T3, 0x1C);
+	const __m512i T5 = _mm512_ternarylogic_epi32(T4, R2, R3, 0xB4);
+	const __m512i T6 = _mm512_ternarylogic_epi32(R3, T1, T5, 0x97);
+	const __m512i T7 = _mm512_ternarylogic_epi32(T6, R0, R1, 0xE1);
+
+	R0 = T1;
+	R1 = T7;
+	R2 = T3;
+	R3 = T5;
+}
+
+inline static void Sb4T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R0, R1, R3, 0x8E);
+	const __m512i T1 = _mm512_ternarylogic_epi32(T0, R0, R2, 0xA5);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R1, R3, T1, 0xC6);
+	const __m512i T3 = _mm512_ternarylogic_epi32(T2, R0, R1, 0xC3);
+	const __m512i T4 = _mm512_ternarylogic_epi32(R1, R2, T0, 0x2D);
+	const __m512i T5 = _mm512_ternarylogic_epi32(T4, R0, T2, 0x87);
+	const __m512i T6 = _mm512_ternarylogic_epi32(R1, T1, T3, 0x9E);
+	const __m512i T7 = _mm512_ternarylogic_epi32(T6, R0, T1, 0xD2);
+
+	R0 = T1;
+	R1 = T5;
+	R2 = T7;
+	R3 = T3;
+}
+
+inline static void Ib4T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R0, R2, R3, 0x76);
+	const __m512i T1 = _mm512_ternarylogic_epi32(T0, R0, R1, 0xB4);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R2, R3, T1, 0xB4);
+	const __m512i T3 = _mm512_ternarylogic_epi32(T2, R0, R1, 0xD2);
+	const __m512i T4 = _mm512_ternarylogic_epi32(R0, T1, T3, 0x9A);
+	const __m512i T5 = _mm512_ternarylogic_epi32(T4, R0, R3, 0xA5);
+	const __m512i T6 = _mm512_ternarylogic_epi32(T1, T3, T5, 0xD4);
+	const __m512i T7 = _mm512_ternarylogic_epi32(T6, R0, R1, 0xC3);
+
+	R0 = T5;
+	R1 = T1;
+	R2 = T7;
+	R3 = T3;
+}
+
+inline static void Sb5T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R0, R1, R3, 0x8E);
+	const __m512i T1 = _mm512_ternarylogic_epi32(T0, R0, R2, 0xA5);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R1, R3, T1, 0x2D);
+	const __m512i T3 = _mm512_ternarylogic_epi32(T2, R0, R1, 0xC3);
+	const __m512i T4 = _mm512_ternarylogic_epi32(R3, T1, T3, 0x25);
+	const __m512i T5 = _mm512_ternarylogic_epi32(T4, R0, T1, 0xD2);
+	const __m512i T6 = _mm512_ternarylogic_epi32(R2, R3, T4, 0xAE);
+	const __m512i T7 = _mm512_ternarylogic_epi32(T6, R1, T0, 0xC7);
+
+	R0 = T1;
+	R1 = T3;
+	R2 = T5;
+	R3 = T7;
+}
+
+inline static void Ib5T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R0, R1, R3, 0x16);
+	const __m512i T1 = _mm512_ternarylogic_epi32(T0, R1, R2, 0xB4);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R0, R2, T1, 0x35);
+	const __m512i T3 = _mm512_ternarylogic_epi32(T2, R3, T0, 0x69);
+	const __m512i T4 = _mm512_ternarylogic_epi32(R0, R2, R3, 0xBC);
+	const __m512i T5 = _mm512_ternarylogic_epi32(T4, R1, T0, 0xB4);
+	const __m512i T6 = _mm512_ternarylogic_epi32(R0, R1, R2, 0x29);
+	const __m512i T7 = _mm512_ternarylogic_epi32(T6, R0, R3, 0xB4);
+
+	R0 = T1;
+	R1 = T3;
+	R2 = T5;
+	R3 = T7;
+}
+
+inline static void Sb6T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R1, R2, R3, 0x29);
+	const __m512i T1 = _mm512_ternarylogic_epi32(R1, R2, R3, 0x7A);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R0, T1, T0, 0xCA);
+	const __m512i T3 = _mm512_ternarylogic_epi32(R0, R2, R3, 0x6C);
+	const __m512i T4 = _mm512_ternarylogic_epi32(T3, R0, R1, 0xA5);
+	const __m512i T5 = _mm512_ternarylogic_epi32(R0, R3, T4, 0xD8);
+	const __m512i T6 = _mm512_ternarylogic_epi32(T5, R1, T2, 0x96);
+	const __m512i T7 = _mm512_ternarylogic_epi32(T2, T3, T6, 0xC6);
+
+	R0 = T2;
+	R1 = T4;
+	R2 = T6;
+	R3 = T7;
+}
+
+inline static void Ib6T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R1, R2, R3, 0x15);
+	const __m512i T1 = _mm512_ternarylogic_epi32(R1, R2, R3, 0xB6);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R0, T1, T0, 0xCA);
+	const __m512i T3 = _mm512_ternarylogic_epi32(R0, R2, R3, 0xA6);
+	const __m512i T4 = _mm512_ternarylogic_epi32(T3, R0, R1, 0xA5);
+	const __m512i T5 = _mm512_ternarylogic_epi32(R0, R2, R3, 0xD4);
+	const __m512i T6 = _mm512_ternarylogic_epi32(T5, R1, T2, 0x96);
+	const __m512i T7 = _mm512_ternarylogic_epi32(T2, T3, T6, 0x6C);
+
+	R0 = T2;
+	R1 = T4;
+	R2 = T7;
+	R3 = T6;
+}
+
+inline static void Sb7T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R0, R1, R2, 0x46);
+	const __m512i T1 = _mm512_ternarylogic_epi32(T0, R0, R3, 0xB4);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R1, R2, T1, 0x7E);
+	const __m512i T3 = _mm512_ternarylogic_epi32(T2, R0, R3, 0x96);
+	const __m512i T4 = _mm512_ternarylogic_epi32(R2, R3, T3, 0x34);
+	const __m512i T5 = _mm512_ternarylogic_epi32(T4, R0, R1, 0x87);
+	const __m512i T6 = _mm512_ternarylogic_epi32(R0, T1, T5, 0x16);
+	const __m512i T7 = _mm512_ternarylogic_epi32(T6, R2, R3, 0xE1);
+
+	R0 = T5;
+	R1 = T3;
+	R2 = T7;
+	R3 = T1;
+}
+
+inline static void Ib7T(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3)
+{
+	const __m512i T0 = _mm512_ternarylogic_epi32(R1, R2, R3, 0x67);
+	const __m512i T1 = _mm512_ternarylogic_epi32(R1, R2, R3, 0x38);
+	const __m512i T2 = _mm512_ternarylogic_epi32(R0, T1, T0, 0xCA);
+	const __m512i T3 = _mm512_ternarylogic_epi32(R0, R3, T0, 0x52);
+	const __m512i T4 = _mm512_ternarylogic_epi32(T3, R1, R2, 0x96);
+	const __m512i T5 = _mm512_ternarylogic_epi32(R0, R1, T4, 0xD3);
+	const __m512i T6 = _mm512_ternarylogic_epi32(T5, R3, T0, 0x97);
+	const __m512i T7 = _mm512_ternarylogic_epi32(T3, T4, T6, 0xB5);
+	const __m512i T8 = _mm512_ternarylogic_epi32(T7, R0, R1, 0xB4);
+
+	R0 = T2;
+	R1 = T4;
+	R2 = T6;
+	R3 = T8;
+}
+
+// round key mixing, the key words are broadcast from the schedule
+inline static void KeyMix512(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3, const SecureVector<uint> &Key, size_t KeyOffset)
+{
+	R0 = _mm512_xor_si512(R0, _mm512_set1_epi32(Key[KeyOffset]));
+	R1 = _mm512_xor_si512(R1, _mm512_set1_epi32(Key[KeyOffset + 1]));
+	R2 = _mm512_xor_si512(R2, _mm512_set1_epi32(Key[KeyOffset + 2]));
+	R3 = _mm512_xor_si512(R3, _mm512_set1_epi32(Key[KeyOffset + 3]));
+}
+
+// the linear transform followed by the next round key; each register is keyed as soon as its final value is known,
+// so the key mixing of R1 and R3 overlaps the remaining steps of the transform
+inline static void LinearKey512(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3, const SecureVector<uint> &Key, size_t KeyOffset)
+{
+	R0 = _mm512_rol_epi32(R0, 13);
+	R2 = _mm512_rol_epi32(R2, 3);
+	R1 = _mm512_ternarylogic_epi32(R1, R0, R2, 0x96);
+	R3 = _mm512_ternarylogic_epi32(R3, R2, _mm512_slli_epi32(R0, 3), 0x96);
+	R1 = _mm512_rol_epi32(R1, 1);
+	R3 = _mm512_rol_epi32(R3, 7);
+	R0 = _mm512_ternarylogic_epi32(R0, R1, R3, 0x96);
+	R2 = _mm512_ternarylogic_epi32(R2, R3, _mm512_slli_epi32(R1, 7), 0x96);
+	R1 = _mm512_xor_si512(R1, _mm512_set1_epi32(Key[KeyOffset + 1]));
+	R3 = _mm512_xor_si512(R3, _mm512_set1_epi32(Key[KeyOffset + 3]));
+	R0 = _mm512_xor_si512(_mm512_rol_epi32(R0, 5), _mm512_set1_epi32(Key[KeyOffset]));
+	R2 = _mm512_xor_si512(_mm512_rol_epi32(R2, 22), _mm512_set1_epi32(Key[KeyOffset + 2]));
+}
+
+// the round key followed by the inverse linear transform
+inline static void KeyInverse512(__m512i &R0, __m512i &R1, __m512i &R2, __m512i &R3, const SecureVector<uint> &Key, size_t KeyOffset)
+{
+	R2 = _mm512_ror_epi32(_mm512_xor_si512(R2, _mm512_set1_epi32(Key[KeyOffset + 2])), 22);
+	R0 = _mm512_ror_epi32(_mm512_xor_si512(R0, _mm512_set1_epi32(Key[KeyOffset])), 5);
+	R1 = _mm512_xor_si512(R1, _mm512_set1_epi32(Key[KeyOffset + 1]));
+	R3 = _mm512_xor_si512(R3, _mm512_set1_epi32(Key[KeyOffset + 3]));
+	R2 = _mm512_ternarylogic_epi32(R2, R3, _mm512_slli_epi32(R1, 7), 0x96);
+	R0 = _mm512_ternarylogic_epi32(R0, R1, R3, 0x96);
+	R3 = _mm512_ror_epi32(R3, 7);
+	R1 = _mm512_ror_epi32(R1, 1);
+	R3 = _mm512_ternarylogic_epi32(R3, R2, _mm512_slli_epi32(R0, 3), 0x96);
+	R1 = _mm512_ternarylogic_epi32(R1, R0, R2, 0x96);
+	R2 = _mm512_ror_epi32(R2, 3);
+	R0 = _mm512_ror_epi32(R0, 13);
+}
+
+static void SHXDecrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, SecureVector<uint> &Key)
+{
+	const size_t INPOFF = Numeric::UInt512::size();
+	size_t keyCtr = Key.size() - 4;
+
+	// input round
+	Numeric::UInt512 X0(Input, InOffset);
+	Numeric::UInt512 X1(Input, InOffset + INPOFF);
+	Numeric::UInt512 X2(Input, InOffset + (INPOFF * 2));
+	Numeric::UInt512 X3(Input, InOffset + (INPOFF * 3));
+	Numeric::UInt512::Transpose(X0, X1, X2, X3);
+
+	__m512i R0 = X0.zmm;
+	__m512i R1 = X1.zmm;
+	__m512i R2 = X2.zmm;
+	__m512i R3 = X3.zmm;
+
+	KeyMix512(R0, R1, R2, R3, Key, keyCtr);
+
+	// process 8 round blocks
+	do
+	{
+		Ib7T(R0, R1, R2, R3);
+		keyCtr -= 4;
+		KeyInverse512(R0, R1, R2, R3, Key, keyCtr);
+		Ib6T(R0, R1, R2, R3);
+		keyCtr -= 4;
+		KeyInverse512(R0, R1, R2, R3, Key, keyCtr);
+		Ib5T(R0, R1, R2, R3);
+		keyCtr -= 4;
+		KeyInverse512(R0, R1, R2, R3, Key, keyCtr);
+		Ib4T(R0, R1, R2, R3);
+		keyCtr -= 4;
+		KeyInverse512(R0, R1, R2, R3, Key, keyCtr);
+		Ib3T(R0, R1, R2, R3);
+		keyCtr -= 4;
+		KeyInverse512(R0, R1, R2, R3, Key, keyCtr);
+		Ib2T(R0, R1, R2, R3);
+		keyCtr -= 4;
+		KeyInverse512(R0, R1, R2, R3, Key, keyCtr);
+		Ib1T(R0, R1, R2, R3);
+		keyCtr -= 4;
+		KeyInverse512(R0, R1, R2, R3, Key, keyCtr);
+		Ib0T(R0, R1, R2, R3);
+		keyCtr -= 4;
+
+		// skip on last block
+		if (keyCtr != 0)
+		{
+			KeyInverse512(R0, R1, R2, R3, Key, keyCtr);
+		}
+	}
+	while (keyCtr != 0);
+
+	// last round
+	KeyMix512(R0, R1, R2, R3, Key, 0);
+
+	X0.zmm = R0;
+	X1.zmm = R1;
+	X2.zmm = R2;
+	X3.zmm = R3;
+	Numeric::UInt512::Transpose(X0, X1, X2, X3);
+	X0.Store(Output, OutOffset);
+	X1.Store(Output, OutOffset + INPOFF);
+	X2.Store(Output, OutOffset + (INPOFF * 2));
+	X3.Store(Output, OutOffset + (INPOFF * 3));
+}
+
+static void SHXEncrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, SecureVector<uint> &Key)
+{
+	const size_t INPOFF = Numeric::UInt512::size();
+	const size_t RNDCNT = Key.size() - 4;
+	size_t keyCtr = 0;
+
+	// input round
+	Numeric::UInt512 X0(Input, InOffset);
+	Numeric::UInt512 X1(Input, InOffset + INPOFF);
+	Numeric::UInt512 X2(Input, InOffset + (INPOFF * 2));
+	Numeric::UInt512 X3(Input, InOffset + (INPOFF * 3));
+	Numeric::UInt512::Transpose(X0, X1, X2, X3);
+
+	__m512i R0 = X0.zmm;
+	__m512i R1 = X1.zmm;
+	__m512i R2 = X2.zmm;
+	__m512i R3 = X3.zmm;
+
+	KeyMix512(R0, R1, R2, R3, Key, keyCtr);
+
+	// process 8 round blocks
+	do
+	{
+		Sb0T(R0, R1, R2, R3);
+		keyCtr += 4;
+		LinearKey512(R0, R1, R2, R3, Key, keyCtr);
+		Sb1T(R0, R1, R2, R3);
+		keyCtr += 4;
+		LinearKey512(R0, R1, R2, R3, Key, keyCtr);
+		Sb2T(R0, R1, R2, R3);
+		keyCtr += 4;
+		LinearKey512(R0, R1, R2, R3, Key, keyCtr);
+		Sb3T(R0, R1, R2, R3);
+		keyCtr += 4;
+		LinearKey512(R0, R1, R2, R3, Key, keyCtr);
+		Sb4T(R0, R1, R2, R3);
+		keyCtr += 4;
+		LinearKey512(R0, R1, R2, R3, Key, keyCtr);
+		Sb5T(R0, R1, R2, R3);
+		keyCtr += 4;
+		LinearKey512(R0, R1, R2, R3, Key, keyCtr);
+		Sb6T(R0, R1, R2, R3);
+		keyCtr += 4;
+		LinearKey512(R0, R1, R2, R3, Key, keyCtr);
+		Sb7T(R0, R1, R2, R3);
+		keyCtr += 4;
+
+		// skip on last block
+		if (keyCtr != RNDCNT)
+		{
+			LinearKey512(R0, R1, R2, R3, Key, keyCtr);
+		}
+	}
+	while (keyCtr != RNDCNT);
+
+	// last round
+	KeyMix512(R0, R1, R2, R3, Key, keyCtr);
+
+	X0.zmm = R0;
+	X1.zmm = R1;
+	X2.zmm = R2;
+	X3.zmm = R3;
+	Numeric::UInt512::Transpose(X0, X1, X2, X3);
+	X0.Store(Output, OutOffset);
+	X1.Store(Output, OutOffset + INPOFF);
+	X2.Store(Output, OutOffset + (INPOFF * 2));
+	X3.Store(Output, OutOffset + (INPOFF * 3));
+}
+
+#endif
+
 NAMESPACE_BLOCKEND
 #endif
@@ -25,7 +25,19 @@ enum class StreamModes : byte
 	/// <summary>
 	/// A SecureStream class, provides streaming encrytped memory storage
 	/// </summary>
-	SecureStream = 4
+	SecureStream = 4,
+	/// <summary>
+	/// A MappedStream class, provides memory-mapped file access
+	/// </summary>
+	MappedStream = 8,
+	/// <summary>
+	/// A DirectStream class, provides unbuffered (direct I/O) file access
+	/// </summary>
+	DirectStream = 16,
+	/// <summary>
+	/// A SeekableCipherStream class, provides random access reads of a chunked encrypted container
+	/// </summary>
+	SeekableCipherStream = 32
 };
 
 NAMESPACE_ENUMERATIONEND
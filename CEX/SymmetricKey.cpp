@@ -61,11 +61,21 @@ const std::vector<byte> SymmetricKey::Info()
 	return m_info;
 }
 
+const std::vector<byte> &SymmetricKey::InfoRef()
+{
+	return m_info;
+}
+
 const std::vector<byte> SymmetricKey::Key()
 {
 	return m_key;
 }
 
+const std::vector<byte> &SymmetricKey::KeyRef()
+{
+	return m_key;
+}
+
 const SymmetricKeySize SymmetricKey::KeySizes() 
 { 
 	return m_keySizes; 
@@ -76,6 +86,11 @@ const std::vector<byte> SymmetricKey::Nonce()
 	return m_nonce;
 }
 
+const std::vector<byte> &SymmetricKey::NonceRef()
+{
+	return m_nonce;
+}
+
 //~~~Public Functions~~~//
 
 SymmetricKey* SymmetricKey::Clone()
@@ -135,6 +150,10 @@ bool SymmetricKey::Equals(ISymmetricKey &Input)
 	return (Input.Key() == Key() && Input.Nonce() == Nonce() && Input.Info() == Info());
 }
 
+void SymmetricKey::Lock()
+{
+}
+
 MemoryStream* SymmetricKey::Serialize(SymmetricKey &KeyObj)
 {
 	size_t kLen = KeyObj.Key().size();
@@ -166,4 +185,8 @@ MemoryStream* SymmetricKey::Serialize(SymmetricKey &KeyObj)
 	return strm;
 }
 
+void SymmetricKey::Unlock()
+{
+}
+
 NAMESPACE_SYMMETRICKEYEND
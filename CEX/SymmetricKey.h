@@ -80,11 +80,21 @@ public:
 	/// </summary>
 	const std::vector<byte> Info() override;
 
+	/// <summary>
+	/// Read Only: A reference to the personalization string
+	/// </summary>
+	const std::vector<byte> &InfoRef() override;
+
 	/// <summary>
 	/// Read Only: Return a copy of the primary key
 	/// </summary>
 	const std::vector<byte> Key() override;
 
+	/// <summary>
+	/// Read Only: A reference to the primary key
+	/// </summary>
+	const std::vector<byte> &KeyRef() override;
+
 	/// <summary>
 	/// Read Only: The SymmetricKeySize containing the byte sizes of the key, nonce, and info state members
 	/// </summary>
@@ -95,6 +105,11 @@ public:
 	/// </summary>
 	const std::vector<byte> Nonce() override;
 
+	/// <summary>
+	/// Read Only: A reference to the nonce
+	/// </summary>
+	const std::vector<byte> &NonceRef() override;
+
 	//~~~Public Functions~~~//
 
 	/// <summary>
@@ -126,6 +141,11 @@ public:
 	/// <returns>Returns true if equal</returns>
 	bool Equals(ISymmetricKey &Input) override;
 
+	/// <summary>
+	/// The key state is not encrypted; this function does nothing
+	/// </summary>
+	void Lock() override;
+
 	/// <summary>
 	/// Serialize a SymmetricKey class.
 	/// <para>The caller is resposible for destroying the return stream.</para>
@@ -135,6 +155,11 @@ public:
 	/// 
 	/// <returns>A stream containing the SymmetricKey data</returns>
 	static MemoryStream* Serialize(SymmetricKey &KeyObj);
+
+	/// <summary>
+	/// The key state is not encrypted; this function does nothing
+	/// </summary>
+	void Unlock() override;
 };
 
 NAMESPACE_SYMMETRICKEYEND
@@ -0,0 +1,41 @@
+#include "SymmetricKeyView.h"
+
+NAMESPACE_SYMMETRICKEY
+
+//~~~Constructors~~~//
+
+SymmetricKeyView::SymmetricKeyView(ISymmetricKey &KeyParams)
+	:
+	m_keyParams(KeyParams)
+{
+	m_keyParams.Unlock();
+}
+
+SymmetricKeyView::~SymmetricKeyView()
+{
+	m_keyParams.Lock();
+}
+
+//~~~Accessors~~~//
+
+const std::vector<byte> &SymmetricKeyView::Info()
+{
+	return m_keyParams.InfoRef();
+}
+
+const std::vector<byte> &SymmetricKeyView::Key()
+{
+	return m_keyParams.KeyRef();
+}
+
+const SymmetricKeySize SymmetricKeyView::KeySizes()
+{
+	return m_keyParams.KeySizes();
+}
+
+const std::vector<byte> &SymmetricKeyView::Nonce()
+{
+	return m_keyParams.NonceRef();
+}
+
+NAMESPACE_SYMMETRICKEYEND
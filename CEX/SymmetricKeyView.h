@@ -0,0 +1,84 @@
+#ifndef CEX_SYMMETRICKEYVIEW_H
+#define CEX_SYMMETRICKEYVIEW_H
+
+#include "ISymmetricKey.h"
+
+NAMESPACE_SYMMETRICKEY
+
+/// <summary>
+/// A scoped, read only view of the key material held by an ISymmetricKey.
+/// <para>The key is unlocked once by the constructor and locked again by the destructor; the accessors return references into the key, no copy is made.
+/// A SymmetricSecureKey is decrypted once for the lifetime of the view, rather than on every call to its Key, Nonce and Info accessors.</para>
+/// </summary>
+/// 
+/// <example>
+/// <description>Reading the key parameters in an Initialize function:</description>
+/// <code>
+/// // the key is unlocked until kv leaves scope
+/// SymmetricKeyView kv(KeyParams);
+/// m_cprKeySize = kv.Key().size() * 8;
+/// ExpandKey(kv.Key());
+/// </code>
+/// </example>
+class SymmetricKeyView final
+{
+private:
+
+	ISymmetricKey &m_keyParams;
+
+public:
+
+	//~~~Constructors~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	SymmetricKeyView(const SymmetricKeyView&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	SymmetricKeyView& operator=(const SymmetricKeyView&) = delete;
+
+	/// <summary>
+	/// Default constructor: default is restricted, this function has been deleted
+	/// </summary>
+	SymmetricKeyView() = delete;
+
+	/// <summary>
+	/// Constructor: unlock the key for the lifetime of this view
+	/// </summary>
+	///
+	/// <param name="KeyParams">The symmetric key; must outlive the view</param>
+	explicit SymmetricKeyView(ISymmetricKey &KeyParams);
+
+	/// <summary>
+	/// Destructor: lock the key
+	/// </summary>
+	~SymmetricKeyView();
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: A reference to the personalization string
+	/// </summary>
+	const std::vector<byte> &Info();
+
+	/// <summary>
+	/// Read Only: A reference to the primary key
+	/// </summary>
+	const std::vector<byte> &Key();
+
+	/// <summary>
+	/// Read Only: The SymmetricKeySize containing the byte sizes of the key, nonce, and info state members
+	/// </summary>
+	const SymmetricKeySize KeySizes();
+
+	/// <summary>
+	/// Read Only: A reference to the nonce or initialization vector
+	/// </summary>
+	const std::vector<byte> &Nonce();
+};
+
+NAMESPACE_SYMMETRICKEYEND
+#endif
@@ -13,10 +13,14 @@ NAMESPACE_SYMMETRICKEY
 
 SymmetricSecureKey::SymmetricSecureKey(const std::vector<byte> &Key, ulong KeySalt)
 	:
+	m_infoView(0),
 	m_isDestroyed(false),
 	m_keySizes(Key.size(), 0, 0),
 	m_keySalt(0),
-	m_keyState(0)
+	m_keyState(0),
+	m_keyView(0),
+	m_nonceView(0),
+	m_unlockCount(0)
 {
 	if (Key.size() == 0)
 	{
@@ -37,10 +41,14 @@ SymmetricSecureKey::SymmetricSecureKey(const std::vector<byte> &Key, ulong KeySa
 
 SymmetricSecureKey::SymmetricSecureKey(const std::vector<byte> &Key, const std::vector<byte> &Nonce, ulong KeySalt)
 	:
+	m_infoView(0),
 	m_isDestroyed(false),
 	m_keySalt(0),
 	m_keySizes(Key.size(), Nonce.size(), 0),
-	m_keyState(0)
+	m_keyState(0),
+	m_keyView(0),
+	m_nonceView(0),
+	m_unlockCount(0)
 {
 	if (Key.size() == 0 || Nonce.size() == 0)
 	{
@@ -62,10 +70,14 @@ SymmetricSecureKey::SymmetricSecureKey(const std::vector<byte> &Key, const std::
 
 SymmetricSecureKey::SymmetricSecureKey(const std::vector<byte> &Key, const std::vector<byte> &Nonce, const std::vector<byte> &Info, ulong KeySalt)
 	:
+	m_infoView(0),
 	m_isDestroyed(false),
 	m_keySalt(0),
 	m_keySizes(Key.size(), Nonce.size(), Info.size()),
-	m_keyState(0)
+	m_keyState(0),
+	m_keyView(0),
+	m_nonceView(0),
+	m_unlockCount(0)
 {
 	if (Key.size() == 0 || Nonce.size() == 0 || Info.size() == 0)
 	{
@@ -98,11 +110,31 @@ const std::vector<byte> SymmetricSecureKey::Info()
 	return Extract(m_keySizes.KeySize() + m_keySizes.NonceSize(), m_keySizes.InfoSize());
 }
 
+const std::vector<byte> &SymmetricSecureKey::InfoRef()
+{
+	if (m_unlockCount == 0)
+	{
+		throw CryptoProcessingException("SymmetricSecureKey:InfoRef", "The key must be unlocked before it is accessed by reference!");
+	}
+
+	return m_infoView;
+}
+
 const std::vector<byte> SymmetricSecureKey::Key()
 {
 	return Extract(0, m_keySizes.KeySize());
 }
 
+const std::vector<byte> &SymmetricSecureKey::KeyRef()
+{
+	if (m_unlockCount == 0)
+	{
+		throw CryptoProcessingException("SymmetricSecureKey:KeyRef", "The key must be unlocked before it is accessed by reference!");
+	}
+
+	return m_keyView;
+}
+
 const SymmetricKeySize SymmetricSecureKey::KeySizes() 
 { 
 	return m_keySizes; 
@@ -113,6 +145,16 @@ const std::vector<byte> SymmetricSecureKey::Nonce()
 	return Extract(m_keySizes.KeySize(), m_keySizes.NonceSize());
 }
 
+const std::vector<byte> &SymmetricSecureKey::NonceRef()
+{
+	if (m_unlockCount == 0)
+	{
+		throw CryptoProcessingException("SymmetricSecureKey:NonceRef", "The key must be unlocked before it is accessed by reference!");
+	}
+
+	return m_nonceView;
+}
+
 //~~~Public Functions~~~//
 
 SymmetricSecureKey* SymmetricSecureKey::Clone()
@@ -134,6 +176,20 @@ void SymmetricSecureKey::Destroy()
 		{
 			Utility::IntUtils::ClearVector(m_keySalt);
 		}
+		if (m_keyView.size() > 0)
+		{
+			Utility::IntUtils::ClearVector(m_keyView);
+		}
+		if (m_nonceView.size() > 0)
+		{
+			Utility::IntUtils::ClearVector(m_nonceView);
+		}
+		if (m_infoView.size() > 0)
+		{
+			Utility::IntUtils::ClearVector(m_infoView);
+		}
+
+		m_unlockCount = 0;
 	}
 }
 
@@ -168,6 +224,21 @@ bool SymmetricSecureKey::Equals(ISymmetricKey &Input)
 	return (Input.Key() == Key() && Input.Nonce() == Nonce() && Input.Info() == Info());
 }
 
+void SymmetricSecureKey::Lock()
+{
+	if (m_unlockCount != 0)
+	{
+		--m_unlockCount;
+
+		if (m_unlockCount == 0)
+		{
+			Utility::IntUtils::ClearVector(m_keyView);
+			Utility::IntUtils::ClearVector(m_nonceView);
+			Utility::IntUtils::ClearVector(m_infoView);
+		}
+	}
+}
+
 MemoryStream* SymmetricSecureKey::Serialize(SymmetricSecureKey &KeyObj)
 {
 	size_t kLen = KeyObj.Key().size();
@@ -199,10 +270,49 @@ MemoryStream* SymmetricSecureKey::Serialize(SymmetricSecureKey &KeyObj)
 	return strm;
 }
 
+void SymmetricSecureKey::Unlock()
+{
+	if (m_unlockCount == 0)
+	{
+		// one decryption serves every reference accessor call until the key is locked
+		Transform();
+		m_keyView.resize(m_keySizes.KeySize());
+		m_nonceView.resize(m_keySizes.NonceSize());
+		m_infoView.resize(m_keySizes.InfoSize());
+		Utility::MemUtils::Copy(m_keyState, 0, m_keyView, 0, m_keyView.size());
+		Utility::MemUtils::Copy(m_keyState, m_keyView.size(), m_nonceView, 0, m_nonceView.size());
+		Utility::MemUtils::Copy(m_keyState, m_keyView.size() + m_nonceView.size(), m_infoView, 0, m_infoView.size());
+		Transform();
+	}
+
+	++m_unlockCount;
+}
+
 //~~~Private Functions~~~//
 
 std::vector<byte> SymmetricSecureKey::Extract(size_t Offset, size_t Length)
 {
+	if (m_unlockCount != 0)
+	{
+		// the state is already decrypted in the working copies
+		std::vector<byte> state(Length);
+
+		if (Offset < m_keyView.size())
+		{
+			Utility::MemUtils::Copy(m_keyView, 0, state, 0, Length);
+		}
+		else if (Offset < m_keyView.size() + m_nonceView.size())
+		{
+			Utility::MemUtils::Copy(m_nonceView, 0, state, 0, Length);
+		}
+		else if (Length != 0)
+		{
+			Utility::MemUtils::Copy(m_infoView, 0, state, 0, Length);
+		}
+
+		return state;
+	}
+
 	Transform();
 	std::vector<byte> state(Length);
 	Utility::MemUtils::Copy(m_keyState, Offset, state, 0, Length);
@@ -14,6 +14,7 @@ NAMESPACE_SYMMETRICKEY
 /// <description>Implementation Notes:</description>
 /// <list type="bullet">
 /// <item><description>Key arrays are encrypted when the class is instantiated with data, and decrypted when accessed through the data arrays getter property functions (Key, Nonce, and Info</description></item>
+/// <item><description>Unlock decrypts the key arrays once into working copies read through the reference accessors (KeyRef, NonceRef, and InfoRef); the copies are erased by the matching Lock</description></item>
 /// <item><description>The key material access is limited to the initializing process, user, and computer; it is not transferrable across process or machine boundaries</description></item>
 /// <item><description>Accessing the property functions from another process, user, or computer, will change the encryption key and return invalid data</description></item>
 /// <item><description>Serializing a SymmetricSecureKey returns a decrypted SymmetricKey stream, deserializing a SymmetricKey stream returns an initialized SymmetricSecureKey</description></item>
@@ -25,10 +26,14 @@ class SymmetricSecureKey final : public ISymmetricKey
 {
 private:
 
+	std::vector<byte> m_infoView;
 	bool m_isDestroyed;
 	SymmetricKeySize m_keySizes;
 	std::vector<byte> m_keyState;
 	std::vector<byte> m_keySalt;
+	std::vector<byte> m_keyView;
+	std::vector<byte> m_nonceView;
+	size_t m_unlockCount;
 
 public:
 
@@ -97,11 +102,25 @@ public:
 	/// </summary>
 	const std::vector<byte> Info() override;
 
+	/// <summary>
+	/// Read Only: A reference to the decrypted personalization string
+	/// </summary>
+	/// 
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the key is not unlocked</exception>
+	const std::vector<byte> &InfoRef() override;
+
 	/// <summary>
 	/// Read Only: Return a copy of the primary key
 	/// </summary>
 	const std::vector<byte> Key() override;
 
+	/// <summary>
+	/// Read Only: A reference to the decrypted primary key
+	/// </summary>
+	/// 
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the key is not unlocked</exception>
+	const std::vector<byte> &KeyRef() override;
+
 	/// <summary>
 	/// Read Only: The SymmetricKeySize containing the byte sizes of the key, nonce, and info state members
 	/// </summary>
@@ -112,6 +131,13 @@ public:
 	/// </summary>
 	const std::vector<byte> Nonce() override;
 
+	/// <summary>
+	/// Read Only: A reference to the decrypted nonce
+	/// </summary>
+	/// 
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the key is not unlocked</exception>
+	const std::vector<byte> &NonceRef() override;
+
 	//~~~Public Functions~~~//
 
 	/// <summary>
@@ -142,6 +168,11 @@ public:
 	/// <returns>Returns true if equal</returns>
 	bool Equals(ISymmetricKey &Input) override;
 
+	/// <summary>
+	/// Erase the decrypted working copies when the last unlock is released
+	/// </summary>
+	void Lock() override;
+
 	/// <summary>
 	/// Decrypt a SymmetricSecureKey and serialize it as a SymmetricKey stream
 	/// </summary>
@@ -151,6 +182,11 @@ public:
 	/// <returns>A stream containing the serialized SymmetricKey data</returns>
 	static MemoryStream* Serialize(SymmetricSecureKey &KeyObj);
 
+	/// <summary>
+	/// Decrypt the key state into working copies read by the reference accessors; the internal key is derived only on the first of nested calls
+	/// </summary>
+	void Unlock() override;
+
 private:
 
 	std::vector<byte> Extract(size_t Offset, size_t Length);
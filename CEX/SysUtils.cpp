@@ -49,6 +49,15 @@ std::string SysUtils::ComputerName()
 	return ret;
 }
 
+ulong SysUtils::CycleCount()
+{
+#if defined(CEX_ARCH_X86_X64)
+	return static_cast<ulong>(__rdtsc());
+#else
+	return 0;
+#endif
+}
+
 std::vector<ulong> SysUtils::DriveSpace(const std::string &Drive)
 {
 #if defined(CEX_OS_WINDOWS)
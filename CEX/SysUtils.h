@@ -46,6 +46,9 @@
 #	include <mach/mach_time.h>
 #	include <time.h>
 #endif
+#if defined(CEX_ARCH_X86_X64) && !defined(CEX_OS_WINDOWS)
+#	include <x86intrin.h>
+#endif
 #if defined(CEX_OS_POSIX)
 #	include <limits.h>
 #	include <stdio.h>
@@ -87,6 +90,14 @@ public:
 	/// <returns>A char vector</returns>
 	static std::string ComputerName();
 
+	/// <summary>
+	/// Return the processor time stamp counter.
+	/// <para>The difference between two calls is the number of reference cycles elapsed; check HasRdtsc() before use.</para>
+	/// </summary>
+	/// 
+	/// <returns>The RDTSC counter, or zero on platforms without the instruction</returns>
+	static ulong CycleCount();
+
 	/// <summary>
 	/// Return an array of free space, total bytes, and available bytes for a drive
 	/// </summary>
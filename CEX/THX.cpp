@@ -3,14 +3,13 @@
 #include "DigestFromName.h"
 #include "HKDF.h"
 #include "IntUtils.h"
-#if defined(CEX_COMPILER_MSC)
-#	if defined(__AVX512__)
-#		include "UInt512.h"
-#	elif defined(__AVX2__)
-#		include "UInt256.h"
-#	elif defined(__AVX__)
-#		include "UInt128.h"
-#	endif
+#include "SymmetricKeyView.h"
+#if defined(__AVX512__)
+#	include "UInt512.h"
+#elif defined(__AVX2__)
+#	include "UInt256.h"
+#elif defined(__AVX__)
+#	include "UInt128.h"
 #endif
 
 NAMESPACE_BLOCK
@@ -198,26 +197,91 @@ void THX::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 	Encrypt128(Input, InOffset, Output, OutOffset);
 }
 
+void THX::ExportSchedule(std::vector<byte> &Schedule)
+{
+	if (!m_isInitialized)
+	{
+		throw CryptoSymmetricCipherException("THX:ExportSchedule", "The cipher has not been initialized!");
+	}
+
+	// header: cipher type, direction, rounds, reserved, and the input key size in bits (m_cprKeySize is the key length * 8), little endian
+	Schedule.resize(SCHEDULE_HEADER + ((m_expKey.size() + m_sBox.size()) * sizeof(uint)));
+	Schedule[0] = static_cast<byte>(Enumeral());
+	Schedule[1] = m_isEncryption ? 1 : 0;
+	Schedule[2] = static_cast<byte>(m_rndCount);
+	Schedule[3] = 0;
+	Utility::IntUtils::Le32ToBytes(static_cast<uint>(m_cprKeySize), Schedule, 4);
+
+	// the round keys followed by the key dependent s-box
+	for (size_t i = 0; i < m_expKey.size(); ++i)
+	{
+		Utility::IntUtils::Le32ToBytes(m_expKey[i], Schedule, SCHEDULE_HEADER + (i * sizeof(uint)));
+	}
+
+	for (size_t i = 0; i < m_sBox.size(); ++i)
+	{
+		Utility::IntUtils::Le32ToBytes(m_sBox[i], Schedule, SCHEDULE_HEADER + ((m_expKey.size() + i) * sizeof(uint)));
+	}
+}
+
+void THX::ImportSchedule(const std::vector<byte> &Schedule)
+{
+	if (Schedule.size() < SCHEDULE_HEADER || Schedule[0] != static_cast<byte>(Enumeral()))
+	{
+		throw CryptoSymmetricCipherException("THX:ImportSchedule", "The key schedule was not exported by this cipher type!");
+	}
+
+	const size_t RNDCNT = Schedule[2];
+	const size_t KEYLEN = Schedule.size() - SCHEDULE_HEADER;
+	// the round keys are sized from the schedule length; schedules exported by earlier versions may hold fewer round keys than the header round count
+	const size_t KEYWRD = (KEYLEN / sizeof(uint)) - SBOX_SIZE;
+
+	if (Schedule[1] > 1 || Schedule[3] != 0 || RNDCNT < MIN_ROUNDS || RNDCNT > MAX_ROUNDS || KEYLEN % sizeof(uint) != 0 || 
+		KEYLEN < ((RNDCNT * 2) + 8 + SBOX_SIZE) * sizeof(uint) || KEYWRD > (MAX_ROUNDS * 2) + 8)
+	{
+		throw CryptoSymmetricCipherException("THX:ImportSchedule", "The key schedule is malformed!");
+	}
+
+	m_expKey.resize(KEYWRD);
+
+	for (size_t i = 0; i < m_expKey.size(); ++i)
+	{
+		m_expKey[i] = Utility::IntUtils::LeBytesTo32(Schedule, SCHEDULE_HEADER + (i * sizeof(uint)));
+	}
+
+	for (size_t i = 0; i < SBOX_SIZE; ++i)
+	{
+		m_sBox[i] = Utility::IntUtils::LeBytesTo32(Schedule, SCHEDULE_HEADER + ((m_expKey.size() + i) * sizeof(uint)));
+	}
+
+	m_isEncryption = (Schedule[1] == 1);
+	m_cprKeySize = Utility::IntUtils::LeBytesTo32(Schedule, 4);
+	m_rndCount = RNDCNT;
+	m_isInitialized = true;
+}
+
 void THX::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(m_legalKeySizes, KeyParams.Key().size()))
+	Key::Symmetric::SymmetricKeyView kv(KeyParams);
+
+	if (!SymmetricKeySize::Contains(m_legalKeySizes, kv.Key().size()))
 	{
 		throw CryptoSymmetricCipherException("THX:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 	}
-	if (m_kdfEngineType != Enumeration::Digests::None && KeyParams.Info().size() > m_kdfInfoMax)
+	if (m_kdfEngineType != Enumeration::Digests::None && kv.Info().size() > m_kdfInfoMax)
 	{
 		throw CryptoSymmetricCipherException("THX:Initialize", "Invalid info size! Info parameter must be no longer than DistributionCodeMax size.");
 	}
 
-	if (KeyParams.Info().size() > 0)
+	if (kv.Info().size() > 0)
 	{
-		m_kdfInfo = KeyParams.Info();
+		m_kdfInfo = kv.Info();
 	}
 
 	m_isEncryption = Encryption;
-	m_cprKeySize = KeyParams.Key().size() * 8;
+	m_cprKeySize = kv.Key().size() * 8;
 	// expand the key
-	ExpandKey(KeyParams.Key());
+	ExpandKey(kv.Key());
 
 	// load tables into L1
 #if defined(CEX_PREFETCH_THX_TABLES)
@@ -317,7 +381,7 @@ void THX::SecureExpand(const std::vector<byte> &Key)
 	std::vector<byte> sbKey(16, 0);
 	std::vector<uint> eKm(k64Cnt, 0);
 	std::vector<uint> oKm(k64Cnt, 0);
-	std::vector<uint> wK(keySize, 0);
+	SecureVector<uint> wK(keySize, 0);
 	// HKDF generator expands array 
 	Kdf::HKDF gen(m_kdfEngine.get());
 
@@ -374,7 +438,8 @@ void THX::SecureExpand(const std::vector<byte> &Key)
 
 	while (keyCtr != KEY_BITS)
 	{
-		Mix16(static_cast<uint>(keyCtr), sbKey, Key.size(), sMix);
+		// the 16 byte sbox key is mixed as a 256 bit key; the input key size would read past it for a 512 bit key
+		Mix16(static_cast<uint>(keyCtr), sbKey, sbKey.size() * 2, sMix);
 		m_sBox[keyCtr * 2] = sMix[0];
 		m_sBox[keyCtr * 2 + 1] = sMix[1];
 		m_sBox[keyCtr * 2 + 0x200] = sMix[2];
@@ -394,10 +459,8 @@ void THX::StandardExpand(const std::vector<byte> &Key)
 	std::vector<uint> eKm(kmLen, 0);
 	std::vector<uint> oKm(kmLen, 0);
 	std::vector<byte> sbKey(Key.size() == 64 ? 32 : 16, 0);
-	std::vector<uint> wK(m_rndCount * 2 + 8, 0);
-
-	// CHANGE: 512 key gets 4 extra rounds
-	m_rndCount = (Key.size() == 64) ? 20 : DEF_ROUNDS;
+	// the round count is set by the constructor; resetting it here made the schedule depend on the previous key size
+	SecureVector<uint> wK(m_rndCount * 2 + 8, 0);
 
 	for (size_t i = 0; i < k64Cnt; ++i)
 	{
@@ -480,7 +543,7 @@ void THX::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 
 void THX::Decrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
 {
-#if (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__) && defined(CEX_COMPILER_MSC)
+#if (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__)
 	THXDecryptW<Numeric::UInt128>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
 #else
 	Decrypt128(Input, InOffset, Output, OutOffset);
@@ -492,9 +555,9 @@ void THX::Decrypt512(const std::vector<byte> &Input, const size_t InOffset, std:
 
 void THX::Decrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
 {
-#if (!defined(__AVX512__)) && defined(__AVX2__) && defined(CEX_COMPILER_MSC)
+#if (!defined(__AVX512__)) && defined(__AVX2__)
 	THXDecryptW<Numeric::UInt256>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
-#elif (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__) && defined(CEX_COMPILER_MSC)
+#elif (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__)
 	THXDecryptW<Numeric::UInt128>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
 	THXDecryptW<Numeric::UInt128>(Input, InOffset + 64, Output, OutOffset + 64, m_expKey, m_sBox);
 #else
@@ -511,12 +574,12 @@ void THX::Decrypt1024(const std::vector<byte> &Input, const size_t InOffset, std
 
 void THX::Decrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
 {
-#if defined(__AVX512__) && defined(CEX_COMPILER_MSC)
+#if defined(__AVX512__)
 	THXDecryptW<Numeric::UInt512>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
-#elif (!defined(__AVX512__)) && defined(__AVX2__) && defined(CEX_COMPILER_MSC)
+#elif (!defined(__AVX512__)) && defined(__AVX2__)
 	THXDecryptW<Numeric::UInt256>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
 	THXDecryptW<Numeric::UInt256>(Input, InOffset + 128, Output, OutOffset + 128, m_expKey, m_sBox);
-#elif (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__) && defined(CEX_COMPILER_MSC)
+#elif (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__)
 	THXDecryptW<Numeric::UInt128>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
 	THXDecryptW<Numeric::UInt128>(Input, InOffset + 64, Output, OutOffset + 64, m_expKey, m_sBox);
 	THXDecryptW<Numeric::UInt128>(Input, InOffset + 128, Output, OutOffset + 128, m_expKey, m_sBox);
@@ -584,7 +647,7 @@ void THX::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 
 void THX::Encrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
 {
-#if (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__) && defined(CEX_COMPILER_MSC)
+#if (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__)
 	THXEncryptW<Numeric::UInt128>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
 #else
 	Encrypt128(Input, InOffset, Output, OutOffset);
@@ -596,9 +659,9 @@ void THX::Encrypt512(const std::vector<byte> &Input, const size_t InOffset, std:
 
 void THX::Encrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
 {
-#if (!defined(__AVX512__)) && defined(__AVX2__) && defined(CEX_COMPILER_MSC)
+#if (!defined(__AVX512__)) && defined(__AVX2__)
 	THXEncryptW<Numeric::UInt256>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
-#elif (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__) && defined(CEX_COMPILER_MSC)
+#elif (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__)
 	THXEncryptW<Numeric::UInt128>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
 	THXEncryptW<Numeric::UInt128>(Input, InOffset + 64, Output, OutOffset + 64, m_expKey, m_sBox);
 #else
@@ -615,12 +678,12 @@ void THX::Encrypt1024(const std::vector<byte> &Input, const size_t InOffset, std
 
 void THX::Encrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
 {
-#if defined(__AVX512__) && defined(CEX_COMPILER_MSC)
+#if defined(__AVX512__)
 	THXEncryptW<Numeric::UInt512>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
-#elif (!defined(__AVX512__)) && defined(__AVX2__) && defined(CEX_COMPILER_MSC)
+#elif (!defined(__AVX512__)) && defined(__AVX2__)
 	THXEncryptW<Numeric::UInt256>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
 	THXEncryptW<Numeric::UInt256>(Input, InOffset + 128, Output, OutOffset + 128, m_expKey, m_sBox);
-#elif (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__) && defined(CEX_COMPILER_MSC)
+#elif (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__)
 	THXEncryptW<Numeric::UInt128>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
 	THXEncryptW<Numeric::UInt128>(Input, InOffset + 64, Output, OutOffset + 64, m_expKey, m_sBox);
 	THXEncryptW<Numeric::UInt128>(Input, InOffset + 128, Output, OutOffset + 128, m_expKey, m_sBox);
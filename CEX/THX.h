@@ -35,6 +35,7 @@
 #define CEX_THX_H
 
 #include "IBlockCipher.h"
+#include "SecureVector.h"
 
 NAMESPACE_BLOCK
 
@@ -95,7 +96,7 @@ NAMESPACE_BLOCK
 /// <item><description>The recommended size for maximum security is 2* the digests block size; this calls HKDF Extract using full blocks of key and salt.</description></item>
 /// <item><description>Valid key sizes can be determined at run time using the <see cref="LegalKeySizes"/> property.</description></item>
 /// <item><description>The internal block size is 16 bytes wide.</description></item>
-/// <item><description>Diffusion rounds assignments are 16, 18, 20, 22, 24, 26, 28, 30 and 32, default is 16 (128-256 bit key), a 512 bit key is automatically assigned 20 rounds.</description></item>
+/// <item><description>Diffusion rounds assignments are 16, 18, 20, 22, 24, 26, 28, 30 and 32, default is 16; the standard key schedule uses the constructors rounds count for every key size.</description></item>
 /// <item><description>Valid rounds assignments can be found in the <see cref="LegalRounds"/> property.</description></item>
 /// </list>
 /// 
@@ -131,12 +132,13 @@ private:
 	static const uint SK_ROTL = 9;
 	static const uint SK_STEP = 0x02020202;
 	static const size_t SBOX_SIZE = 1024;
+	static const size_t SCHEDULE_HEADER = 8;
 	// size of state buffer and sbox subtracted parallel size calculations
 	static const size_t STATE_PRECACHED = 2048 + 4096;
 
 	size_t m_cprKeySize;
 	bool m_destroyEngine;
-	std::vector<uint> m_expKey;
+	SecureVector<uint> m_expKey;
 	bool m_isDestroyed;
 	bool m_isEncryption;
 	bool m_isInitialized;
@@ -148,7 +150,7 @@ private:
 	std::vector<SymmetricKeySize> m_legalKeySizes;
 	std::vector<size_t> m_legalRounds;
 	size_t m_rndCount;
-	std::vector<uint> m_sBox;
+	SecureVector<uint> m_sBox;
 
 public:
 
@@ -310,6 +312,27 @@ public:
 	/// <param name="OutOffset">Starting offset within the output array</param>
 	void EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
 
+	/// <summary>
+	/// Export the expanded key schedule of the initialized cipher.
+	/// <para>The schedule can be loaded into other instances of this cipher with <see cref="ImportSchedule(std::vector<byte>)"/>, so that several instances share a single key expansion.
+	/// The array holds the round keys in the clear, and should be cleared by the caller after use.</para>
+	/// </summary>
+	/// 
+	/// <param name="Schedule">The array receiving the key schedule; resized to the schedule length</param>
+	/// 
+	/// <exception cref="Exception::CryptoSymmetricCipherException">Thrown if the cipher has not been initialized</exception>
+	void ExportSchedule(std::vector<byte> &Schedule) override;
+
+	/// <summary>
+	/// Initialize the cipher with a key schedule created by <see cref="ExportSchedule(std::vector<byte>)"/>; the key is not expanded.
+	/// <para>The cipher takes the direction, rounds count and round keys of the exporting instance.</para>
+	/// </summary>
+	/// 
+	/// <param name="Schedule">The exported key schedule</param>
+	/// 
+	/// <exception cref="Exception::CryptoSymmetricCipherException">Thrown if the schedule was exported by another cipher type, or is malformed</exception>
+	void ImportSchedule(const std::vector<byte> &Schedule) override;
+
 	/// <summary>
 	/// Initialize the cipher
 	/// </summary>
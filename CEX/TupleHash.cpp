@@ -0,0 +1,202 @@
+#include "TupleHash.h"
+#include "Instrumentation.h"
+#include "IntUtils.h"
+#include "Keccak.h"
+#include "MemUtils.h"
+
+NAMESPACE_DIGEST
+
+using Utility::IntUtils;
+using Utility::MemUtils;
+
+const std::string TupleHash::CLASS_NAME("TupleHash");
+
+//~~~Constructor~~~//
+
+TupleHash::TupleHash(ShakeModes ShakeMode)
+	:
+	m_blockSize((ShakeMode == ShakeModes::SHAKE128) ? 168 : 136),
+	m_custom(0),
+	m_digestSize((ShakeMode == ShakeModes::SHAKE128) ? 32 : 64),
+	m_isDestroyed(false),
+	m_position(0),
+	m_shakeMode((ShakeMode == ShakeModes::SHAKE128 || ShakeMode == ShakeModes::SHAKE256) ? ShakeMode :
+		throw CryptoDigestException("TupleHash:Ctor", "The SHAKE mode must be SHAKE128 or SHAKE256!")),
+	m_state()
+{
+	Reset();
+}
+
+TupleHash::~TupleHash()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		IntUtils::ClearArray(m_state);
+		IntUtils::ClearVector(m_custom);
+		m_blockSize = 0;
+		m_digestSize = 0;
+		m_position = 0;
+		m_shakeMode = ShakeModes::None;
+	}
+}
+
+//~~~Accessors~~~//
+
+size_t TupleHash::BlockSize()
+{
+	return m_blockSize;
+}
+
+size_t TupleHash::DigestSize()
+{
+	return m_digestSize;
+}
+
+const std::string TupleHash::Name()
+{
+	return CLASS_NAME + ((m_shakeMode == ShakeModes::SHAKE128) ? "128" : "256");
+}
+
+const ShakeModes TupleHash::ShakeMode()
+{
+	return m_shakeMode;
+}
+
+//~~~Public Functions~~~//
+
+void TupleHash::Compute(const std::vector<std::vector<byte>> &Input, std::vector<byte> &Output)
+{
+	for (size_t i = 0; i < Input.size(); ++i)
+	{
+		Update(Input[i], 0, Input[i].size());
+	}
+
+	Finalize(Output, 0);
+}
+
+size_t TupleHash::Finalize(std::vector<byte> &Output, const size_t OutOffset)
+{
+	return Finalize(Output, OutOffset, m_digestSize);
+}
+
+size_t TupleHash::Finalize(std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+{
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, 0);
+
+	if (Output.size() - OutOffset < Length)
+	{
+		throw CryptoDigestException("TupleHash:Finalize", "The Output buffer is too short!");
+	}
+
+	std::vector<byte> enc(sizeof(ulong) + 1);
+
+	// right_encode(L), then the cSHAKE padding
+	Absorb(enc, 0, Keccak::RightEncode(enc, 0, static_cast<ulong>(Length) * 8));
+	m_state[m_position / sizeof(ulong)] ^= static_cast<ulong>(DOMAIN_CODE) << (8 * (m_position % sizeof(ulong)));
+	m_state[(m_blockSize / sizeof(ulong)) - 1] ^= 0x8000000000000000ULL;
+	Keccak::PermuteR24P1600(m_state);
+	m_position = 0;
+	Squeeze(Output, OutOffset, Length);
+	Reset();
+
+	return Length;
+}
+
+void TupleHash::Initialize(const std::vector<byte> &Customization)
+{
+	m_custom = Customization;
+	Reset();
+}
+
+void TupleHash::Reset()
+{
+	const std::string FNCNME = "TupleHash";
+	std::vector<byte> name(FNCNME.begin(), FNCNME.end());
+	std::vector<byte> pad(0);
+
+	std::memset(&m_state[0], 0, m_state.size() * sizeof(ulong));
+	m_position = 0;
+	Keccak::EncodeString(name, pad);
+	Keccak::EncodeString(m_custom, pad);
+	Keccak::BytePad(pad, m_blockSize, m_state, false);
+}
+
+void TupleHash::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	CEX_INSTRUMENT_CALL(Enumeration::InstrumentGroups::Digest, CLASS_NAME, Length);
+
+	CexAssert(Input.size() - InOffset >= Length, "The Input buffer is too short!");
+
+	std::vector<byte> enc(sizeof(ulong) + 1);
+
+	// encode_string(X): the bit length prefix, followed by the element itself
+	Absorb(enc, 0, Keccak::LeftEncode(enc, 0, static_cast<ulong>(Length) * 8));
+	Absorb(Input, InOffset, Length);
+}
+
+//~~~Private Functions~~~//
+
+void TupleHash::Absorb(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	while (Length != 0)
+	{
+		if (m_position == 0 && Length >= m_blockSize)
+		{
+			for (size_t i = 0; i < m_blockSize / sizeof(ulong); ++i)
+			{
+				m_state[i] ^= IntUtils::LeBytesTo64(Input, InOffset + (i * sizeof(ulong)));
+			}
+
+			Keccak::PermuteR24P1600(m_state);
+			InOffset += m_blockSize;
+			Length -= m_blockSize;
+		}
+		else
+		{
+			const size_t RMDSZE = IntUtils::Min(m_blockSize - m_position, Length);
+
+			for (size_t i = 0; i < RMDSZE; ++i)
+			{
+				const size_t STAPOS = m_position + i;
+				m_state[STAPOS / sizeof(ulong)] ^= static_cast<ulong>(Input[InOffset + i]) << (8 * (STAPOS % sizeof(ulong)));
+			}
+
+			m_position += RMDSZE;
+			InOffset += RMDSZE;
+			Length -= RMDSZE;
+
+			if (m_position == m_blockSize)
+			{
+				Keccak::PermuteR24P1600(m_state);
+				m_position = 0;
+			}
+		}
+	}
+}
+
+void TupleHash::Squeeze(std::vector<byte> &Output, size_t OutOffset, size_t Length)
+{
+	while (Length != 0)
+	{
+		if (m_position == m_blockSize)
+		{
+			Keccak::PermuteR24P1600(m_state);
+			m_position = 0;
+		}
+
+		const size_t RMDSZE = IntUtils::Min(m_blockSize - m_position, Length);
+
+		for (size_t i = 0; i < RMDSZE; ++i)
+		{
+			const size_t STAPOS = m_position + i;
+			Output[OutOffset + i] = static_cast<byte>(m_state[STAPOS / sizeof(ulong)] >> (8 * (STAPOS % sizeof(ulong))));
+		}
+
+		m_position += RMDSZE;
+		OutOffset += RMDSZE;
+		Length -= RMDSZE;
+	}
+}
+
+NAMESPACE_DIGESTEND
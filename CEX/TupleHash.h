@@ -0,0 +1,198 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// An implementation of the SP800-185 TupleHash function, using the cSHAKE128 and cSHAKE256 functions.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_TUPLEHASH_H
+#define CEX_TUPLEHASH_H
+
+#include "CexDomain.h"
+#include "CryptoDigestException.h"
+#include "ShakeModes.h"
+
+NAMESPACE_DIGEST
+
+using Exception::CryptoDigestException;
+using Enumeration::ShakeModes;
+
+/// <summary>
+/// An implementation of the SP800-185 TupleHash128 and TupleHash256 functions
+/// </summary>
+///
+/// <example>
+/// <description>Hashing a tuple with the Update method:</description>
+/// <code>
+/// TupleHash dgt(ShakeModes::SHAKE128);
+/// std:vector&lt;byte&gt; hash(dgt.DigestSize(), 0);
+/// // each call to Update is one element of the tuple
+/// dgt.Update(name, 0, name.size());
+/// dgt.Update(value, 0, value.size());
+/// dgt.Finalize(hash, 0);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>TupleHash hashes a sequence of strings so that the boundaries between them are part of the hash; the tuples ("ab", "c") and ("a", "bc") produce different outputs.</description></item>
+/// <item><description>Each call to the Update function is one element of the tuple; the element is encoded and absorbed directly from the input array, without an intermediate buffer.</description></item>
+/// <item><description>The ShakeModes::SHAKE128 mode is TupleHash128, with a 32 byte default output; the ShakeModes::SHAKE256 mode is TupleHash256, with a 64 byte default output.</description></item>
+/// <item><description>The requested output length is part of the hash; the Finalize(std::vector&lt;byte&gt;, size_t, size_t) overload does not return a prefix of a longer output.</description></item>
+/// <item><description>The Finalize methods reset the tuple, but keep the customization string set by Initialize.</description></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>Fips-202: The <a href="http://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf">SHA-3 Standard</a></description>.</item>
+/// <item><description>SP800-185: <a href="http://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-185.pdf">SHA-3 Derived Functions</a></description></item>
+/// </list>
+/// </remarks>
+class TupleHash final
+{
+private:
+
+	static const std::string CLASS_NAME;
+	static const byte DOMAIN_CODE = 0x04;
+	static const size_t STATE_SIZE = 25;
+
+	size_t m_blockSize;
+	std::vector<byte> m_custom;
+	size_t m_digestSize;
+	bool m_isDestroyed;
+	size_t m_position;
+	ShakeModes m_shakeMode;
+	std::array<ulong, STATE_SIZE> m_state;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	TupleHash(const TupleHash&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	TupleHash& operator=(const TupleHash&) = delete;
+
+	/// <summary>
+	/// Initialize the digest
+	/// </summary>
+	///
+	/// <param name="ShakeMode">The underlying SHAKE function; SHAKE128 for TupleHash128, or SHAKE256 for TupleHash256</param>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the SHAKE mode is not SHAKE128 or SHAKE256</exception>
+	explicit TupleHash(ShakeModes ShakeMode = ShakeModes::SHAKE128);
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~TupleHash();
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The Digests internal blocksize in bytes
+	/// </summary>
+	size_t BlockSize();
+
+	/// <summary>
+	/// Read Only: Size of returned digest in bytes
+	/// </summary>
+	size_t DigestSize();
+
+	/// <summary>
+	/// Read Only: The digests class name
+	/// </summary>
+	const std::string Name();
+
+	/// <summary>
+	/// Read Only: The underlying SHAKE function
+	/// </summary>
+	const ShakeModes ShakeMode();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Hash a tuple of strings and return the default size hash value
+	/// </summary>
+	///
+	/// <param name="Input">The tuple elements, in order</param>
+	/// <param name="Output">The hash value output array</param>
+	void Compute(const std::vector<std::vector<byte>> &Input, std::vector<byte> &Output);
+
+	/// <summary>
+	/// Perform final processing and return the default size hash value
+	/// </summary>
+	///
+	/// <param name="Output">The Hash output value array</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	///
+	/// <returns>Size of Hash value</returns>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the output buffer is too short</exception>
+	size_t Finalize(std::vector<byte> &Output, const size_t OutOffset);
+
+	/// <summary>
+	/// Perform final processing and return a hash value of any length
+	/// </summary>
+	///
+	/// <param name="Output">The output array</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	/// <param name="Length">The number of bytes to write</param>
+	///
+	/// <returns>The number of bytes written</returns>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the output buffer is too short</exception>
+	size_t Finalize(std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
+
+	/// <summary>
+	/// Set the customization string, the S parameter of TupleHash.
+	/// <para>Different customization strings produce independent hash functions; an empty string restores the default function.</para>
+	/// </summary>
+	///
+	/// <param name="Customization">The customization string</param>
+	void Initialize(const std::vector<byte> &Customization);
+
+	/// <summary>
+	/// Reset the tuple; the customization string is retained
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// Add the next element of the tuple
+	/// </summary>
+	///
+	/// <param name="Input">The Input array containing the element</param>
+	/// <param name="InOffset">The starting offset within the Input array</param>
+	/// <param name="Length">The element length in bytes; may be zero</param>
+	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length);
+
+private:
+
+	void Absorb(const std::vector<byte> &Input, size_t InOffset, size_t Length);
+	void Squeeze(std::vector<byte> &Output, size_t OutOffset, size_t Length);
+};
+
+NAMESPACE_DIGESTEND
+#endif
@@ -20,6 +20,7 @@
 #define CEX_TWOFISH_H
 
 #include "CexDomain.h"
+#include "SecureVector.h"
 
 NAMESPACE_BLOCK
 
@@ -27,8 +28,99 @@ NAMESPACE_BLOCK
 /// internal
 /// 
 
+//~~~Twofish Lookup Templates~~~//
+
+template<typename T, typename U>
+static T Fe0(const T X, const SecureVector<U> &Sbox)
+{
+	return Sbox[2 * static_cast<byte>(X)] ^ Sbox[2 * static_cast<byte>(X >> 8) + 0x001] ^ Sbox[2 * static_cast<byte>(X >> 16) + 0x200] ^ Sbox[2 * static_cast<byte>(X >> 24) + 0x201];
+}
+
+template<typename T, typename U>
+static T Fe3(const T X, const SecureVector<U> &Sbox)
+{
+	return Sbox[2 * static_cast<byte>(X) + 0x001] ^ Sbox[2 * static_cast<byte>(X >> 8) + 0x200] ^ Sbox[2 * static_cast<byte>(X >> 16) + 0x201] ^ Sbox[2 * static_cast<byte>(X >> 24)];
+}
+
+#if defined(__AVX512__)
+	// gathers the four key-dependent S-box words of every 32bit lane and combines them; byte i of a lane indexes the table at 2 * byte + Offset i
+	inline static __m512i FeGather512(const __m512i &X, const SecureVector<uint> &Sbox, int Offset0, int Offset1, int Offset2, int Offset3)
+	{
+		const __m512i MASK = _mm512_set1_epi32(0xFF);
+		const void* TBL = Sbox.data();
+		__m512i idx;
+		__m512i ret;
+
+		idx = _mm512_add_epi32(_mm512_slli_epi32(_mm512_and_si512(X, MASK), 1), _mm512_set1_epi32(Offset0));
+		ret = _mm512_i32gather_epi32(idx, TBL, 4);
+		idx = _mm512_add_epi32(_mm512_slli_epi32(_mm512_and_si512(_mm512_srli_epi32(X, 8), MASK), 1), _mm512_set1_epi32(Offset1));
+		ret = _mm512_xor_si512(ret, _mm512_i32gather_epi32(idx, TBL, 4));
+		idx = _mm512_add_epi32(_mm512_slli_epi32(_mm512_and_si512(_mm512_srli_epi32(X, 16), MASK), 1), _mm512_set1_epi32(Offset2));
+		ret = _mm512_xor_si512(ret, _mm512_i32gather_epi32(idx, TBL, 4));
+		idx = _mm512_add_epi32(_mm512_slli_epi32(_mm512_srli_epi32(X, 24), 1), _mm512_set1_epi32(Offset3));
+
+		return _mm512_xor_si512(ret, _mm512_i32gather_epi32(idx, TBL, 4));
+	}
+#elif defined(__AVX2__)
+	// gathers the four key-dependent S-box words of every 32bit lane and combines them; byte i of a lane indexes the table at 2 * byte + Offset i
+	inline static __m256i FeGather256(const __m256i &X, const SecureVector<uint> &Sbox, int Offset0, int Offset1, int Offset2, int Offset3)
+	{
+		const __m256i MASK = _mm256_set1_epi32(0xFF);
+		const int* TBL = reinterpret_cast<const int*>(Sbox.data());
+		__m256i idx;
+		__m256i ret;
+
+		idx = _mm256_add_epi32(_mm256_slli_epi32(_mm256_and_si256(X, MASK), 1), _mm256_set1_epi32(Offset0));
+		ret = _mm256_i32gather_epi32(TBL, idx, 4);
+		idx = _mm256_add_epi32(_mm256_slli_epi32(_mm256_and_si256(_mm256_srli_epi32(X, 8), MASK), 1), _mm256_set1_epi32(Offset1));
+		ret = _mm256_xor_si256(ret, _mm256_i32gather_epi32(TBL, idx, 4));
+		idx = _mm256_add_epi32(_mm256_slli_epi32(_mm256_and_si256(_mm256_srli_epi32(X, 16), MASK), 1), _mm256_set1_epi32(Offset2));
+		ret = _mm256_xor_si256(ret, _mm256_i32gather_epi32(TBL, idx, 4));
+		idx = _mm256_add_epi32(_mm256_slli_epi32(_mm256_srli_epi32(X, 24), 1), _mm256_set1_epi32(Offset3));
+
+		return _mm256_xor_si256(ret, _mm256_i32gather_epi32(TBL, idx, 4));
+	}
+#endif
+
+template<typename T, typename U>
+static T Fe0W(const T &X, const SecureVector<U> &Sbox)
+{
+#if defined(__AVX512__)
+	return T(FeGather512(X.zmm, Sbox, 0x000, 0x001, 0x200, 0x201));
+#elif defined(__AVX2__)
+	return T(FeGather256(X.ymm, Sbox, 0x000, 0x001, 0x200, 0x201));
+#elif defined(__AVX__)
+	// no gather instruction below avx2, the lanes are looked up one at a time
+	return T(
+		Fe0(static_cast<uint>(_mm_extract_epi32(X.xmm, 3)), Sbox),
+		Fe0(static_cast<uint>(_mm_extract_epi32(X.xmm, 2)), Sbox),
+		Fe0(static_cast<uint>(_mm_extract_epi32(X.xmm, 1)), Sbox),
+		Fe0(static_cast<uint>(_mm_cvtsi128_si32(X.xmm)), Sbox)
+	);
+#endif
+}
+
+template<typename T, typename U>
+static T Fe3W(const T &X, const SecureVector<U> &Sbox)
+{
+#if defined(__AVX512__)
+	return T(FeGather512(X.zmm, Sbox, 0x001, 0x200, 0x201, 0x000));
+#elif defined(__AVX2__)
+	return T(FeGather256(X.ymm, Sbox, 0x001, 0x200, 0x201, 0x000));
+#elif defined(__AVX__)
+	return T(
+		Fe3(static_cast<uint>(_mm_extract_epi32(X.xmm, 3)), Sbox),
+		Fe3(static_cast<uint>(_mm_extract_epi32(X.xmm, 2)), Sbox),
+		Fe3(static_cast<uint>(_mm_extract_epi32(X.xmm, 1)), Sbox),
+		Fe3(static_cast<uint>(_mm_cvtsi128_si32(X.xmm)), Sbox)
+	);
+#endif
+}
+
+//~~~Wide Transforms~~~//
+
 template<typename T>
-static void THXDecryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Key, std::vector<uint> &Sbox)
+static void THXDecryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, SecureVector<uint> &Key, SecureVector<uint> &Sbox)
 {
 #if defined(__AVX__) || defined(__AVX2__) || defined(__AVX512__)
 
@@ -96,7 +188,7 @@ static void THXDecryptW(const std::vector<byte> &Input, const size_t InOffset, s
 }
 
 template<typename T>
-static void THXEncryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Key, std::vector<uint> &Sbox)
+static void THXEncryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, SecureVector<uint> &Key, SecureVector<uint> &Sbox)
 {
 #if defined(__AVX__) || defined(__AVX2__) || defined(__AVX512__)
 
@@ -163,111 +255,6 @@ static void THXEncryptW(const std::vector<byte> &Input, const size_t InOffset, s
 #endif
 }
 
-//~~~Twofish Lookup Templates~~~//
-
-// only on msc
-#if defined(CEX_COMPILER_MSC)
-	template<typename T, typename U>
-	static T Fe0W(const T &X, const std::vector<U> &Sbox)
-	{
-	#if defined(__AVX512__)
-		return T(
-			Sbox[2 * X.zmm.m512i_u8[60]] ^ Sbox[2 * X.zmm.m512i_u8[61] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[62] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[63] + 0x201],
-			Sbox[2 * X.zmm.m512i_u8[56]] ^ Sbox[2 * X.zmm.m512i_u8[57] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[58] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[59] + 0x201],
-			Sbox[2 * X.zmm.m512i_u8[52]] ^ Sbox[2 * X.zmm.m512i_u8[53] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[54] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[55] + 0x201],
-			Sbox[2 * X.zmm.m512i_u8[48]] ^ Sbox[2 * X.zmm.m512i_u8[49] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[50] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[51] + 0x201],
-			Sbox[2 * X.zmm.m512i_u8[44]] ^ Sbox[2 * X.zmm.m512i_u8[45] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[46] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[47] + 0x201],
-			Sbox[2 * X.zmm.m512i_u8[40]] ^ Sbox[2 * X.zmm.m512i_u8[41] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[42] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[43] + 0x201],
-			Sbox[2 * X.zmm.m512i_u8[36]] ^ Sbox[2 * X.zmm.m512i_u8[37] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[38] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[39] + 0x201],
-			Sbox[2 * X.zmm.m512i_u8[32]] ^ Sbox[2 * X.zmm.m512i_u8[33] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[34] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[35] + 0x201]
-			Sbox[2 * X.zmm.m512i_u8[28]] ^ Sbox[2 * X.zmm.m512i_u8[29] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[30] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[31] + 0x201],
-			Sbox[2 * X.zmm.m512i_u8[24]] ^ Sbox[2 * X.zmm.m512i_u8[25] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[26] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[27] + 0x201],
-			Sbox[2 * X.zmm.m512i_u8[20]] ^ Sbox[2 * X.zmm.m512i_u8[21] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[22] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[23] + 0x201],
-			Sbox[2 * X.zmm.m512i_u8[16]] ^ Sbox[2 * X.zmm.m512i_u8[17] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[18] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[19] + 0x201],
-			Sbox[2 * X.zmm.m512i_u8[12]] ^ Sbox[2 * X.zmm.m512i_u8[13] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[14] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[15] + 0x201],
-			Sbox[2 * X.zmm.m512i_u8[8]] ^ Sbox[2 * X.zmm.m512i_u8[9] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[10] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[11] + 0x201],
-			Sbox[2 * X.zmm.m512i_u8[4]] ^ Sbox[2 * X.zmm.m512i_u8[5] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[6] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[7] + 0x201],
-			Sbox[2 * X.zmm.m512i_u8[0]] ^ Sbox[2 * X.zmm.m512i_u8[1] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[2] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[3] + 0x201]
-		);
-	#elif (!defined(__AVX512__)) && defined(__AVX2__)
-		return T(
-			Sbox[2 * X.ymm.m256i_u8[28]] ^ Sbox[2 * X.ymm.m256i_u8[29] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[30] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[31] + 0x201],
-			Sbox[2 * X.ymm.m256i_u8[24]] ^ Sbox[2 * X.ymm.m256i_u8[25] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[26] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[27] + 0x201],
-			Sbox[2 * X.ymm.m256i_u8[20]] ^ Sbox[2 * X.ymm.m256i_u8[21] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[22] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[23] + 0x201],
-			Sbox[2 * X.ymm.m256i_u8[16]] ^ Sbox[2 * X.ymm.m256i_u8[17] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[18] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[19] + 0x201],
-			Sbox[2 * X.ymm.m256i_u8[12]] ^ Sbox[2 * X.ymm.m256i_u8[13] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[14] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[15] + 0x201],
-			Sbox[2 * X.ymm.m256i_u8[8]] ^ Sbox[2 * X.ymm.m256i_u8[9] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[10] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[11] + 0x201],
-			Sbox[2 * X.ymm.m256i_u8[4]] ^ Sbox[2 * X.ymm.m256i_u8[5] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[6] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[7] + 0x201],
-			Sbox[2 * X.ymm.m256i_u8[0]] ^ Sbox[2 * X.ymm.m256i_u8[1] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[2] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[3] + 0x201]
-		);
-	#elif (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__)
-		return T(
-			Sbox[2 * X.xmm.m128i_u8[12]] ^ Sbox[2 * X.xmm.m128i_u8[13] + 0x001] ^ Sbox[2 * X.xmm.m128i_u8[14] + 0x200] ^ Sbox[2 * X.xmm.m128i_u8[15] + 0x201],
-			Sbox[2 * X.xmm.m128i_u8[8]] ^ Sbox[2 * X.xmm.m128i_u8[9] + 0x001] ^ Sbox[2 * X.xmm.m128i_u8[10] + 0x200] ^ Sbox[2 * X.xmm.m128i_u8[11] + 0x201],
-			Sbox[2 * X.xmm.m128i_u8[4]] ^ Sbox[2 * X.xmm.m128i_u8[5] + 0x001] ^ Sbox[2 * X.xmm.m128i_u8[6] + 0x200] ^ Sbox[2 * X.xmm.m128i_u8[7] + 0x201],
-			Sbox[2 * X.xmm.m128i_u8[0]] ^ Sbox[2 * X.xmm.m128i_u8[1] + 0x001] ^ Sbox[2 * X.xmm.m128i_u8[2] + 0x200] ^ Sbox[2 * X.xmm.m128i_u8[3] + 0x201]
-		);
-	#endif
-	}
-#endif
-
-#if defined(CEX_COMPILER_MSC)
-	template<typename T, typename U>
-	static T Fe3W(const T &X, const std::vector<U> &Sbox)
-	{
-	#if defined(__AVX512__)
-		return T(
-			Sbox[2 * X.zmm.m512i_u8[60] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[61] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[62] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[63]],
-			Sbox[2 * X.zmm.m512i_u8[56] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[57] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[58] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[59]],
-			Sbox[2 * X.zmm.m512i_u8[52] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[53] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[54] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[55]],
-			Sbox[2 * X.zmm.m512i_u8[48] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[49] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[50] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[51]],
-			Sbox[2 * X.zmm.m512i_u8[44] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[45] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[46] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[47]],
-			Sbox[2 * X.zmm.m512i_u8[40] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[41] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[42] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[43]],
-			Sbox[2 * X.zmm.m512i_u8[36] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[37] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[38] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[39]],
-			Sbox[2 * X.zmm.m512i_u8[32] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[33] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[34] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[35]]
-			Sbox[2 * X.zmm.m512i_u8[28] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[29] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[30] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[31]],
-			Sbox[2 * X.zmm.m512i_u8[24] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[25] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[26] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[27]],
-			Sbox[2 * X.zmm.m512i_u8[20] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[21] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[22] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[23]],
-			Sbox[2 * X.zmm.m512i_u8[16] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[17] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[18] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[19]],
-			Sbox[2 * X.zmm.m512i_u8[12] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[13] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[14] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[15]],
-			Sbox[2 * X.zmm.m512i_u8[8] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[9] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[10] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[11]],
-			Sbox[2 * X.zmm.m512i_u8[4] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[5] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[6] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[7]],
-			Sbox[2 * X.zmm.m512i_u8[0] + 0x001] ^ Sbox[2 * X.zmm.m512i_u8[1] + 0x200] ^ Sbox[2 * X.zmm.m512i_u8[2] + 0x201] ^ Sbox[2 * X.zmm.m512i_u8[3]]
-		);
-	#elif (!defined(__AVX512__)) && defined(__AVX2__)
-		return T(
-			Sbox[2 * X.ymm.m256i_u8[28] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[29] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[30] + 0x201] ^ Sbox[2 * X.ymm.m256i_u8[31]],
-			Sbox[2 * X.ymm.m256i_u8[24] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[25] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[26] + 0x201] ^ Sbox[2 * X.ymm.m256i_u8[27]],
-			Sbox[2 * X.ymm.m256i_u8[20] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[21] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[22] + 0x201] ^ Sbox[2 * X.ymm.m256i_u8[23]],
-			Sbox[2 * X.ymm.m256i_u8[16] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[17] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[18] + 0x201] ^ Sbox[2 * X.ymm.m256i_u8[19]],
-			Sbox[2 * X.ymm.m256i_u8[12] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[13] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[14] + 0x201] ^ Sbox[2 * X.ymm.m256i_u8[15]],
-			Sbox[2 * X.ymm.m256i_u8[8] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[9] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[10] + 0x201] ^ Sbox[2 * X.ymm.m256i_u8[11]],
-			Sbox[2 * X.ymm.m256i_u8[4] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[5] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[6] + 0x201] ^ Sbox[2 * X.ymm.m256i_u8[7]],
-			Sbox[2 * X.ymm.m256i_u8[0] + 0x001] ^ Sbox[2 * X.ymm.m256i_u8[1] + 0x200] ^ Sbox[2 * X.ymm.m256i_u8[2] + 0x201] ^ Sbox[2 * X.ymm.m256i_u8[3]]
-		);
-	#elif (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__)
-		return T(
-			Sbox[2 * X.xmm.m128i_u8[12] + 0x001] ^ Sbox[2 * X.xmm.m128i_u8[13] + 0x200] ^ Sbox[2 * X.xmm.m128i_u8[14] + 0x201] ^ Sbox[2 * X.xmm.m128i_u8[15]],
-			Sbox[2 * X.xmm.m128i_u8[8] + 0x001] ^ Sbox[2 * X.xmm.m128i_u8[9] + 0x200] ^ Sbox[2 * X.xmm.m128i_u8[10] + 0x201] ^ Sbox[2 * X.xmm.m128i_u8[11]],
-			Sbox[2 * X.xmm.m128i_u8[4] + 0x001] ^ Sbox[2 * X.xmm.m128i_u8[5] + 0x200] ^ Sbox[2 * X.xmm.m128i_u8[6] + 0x201] ^ Sbox[2 * X.xmm.m128i_u8[7]],
-			Sbox[2 * X.xmm.m128i_u8[0] + 0x001] ^ Sbox[2 * X.xmm.m128i_u8[1] + 0x200] ^ Sbox[2 * X.xmm.m128i_u8[2] + 0x201] ^ Sbox[2 * X.xmm.m128i_u8[3]]
-		);
-	#endif
-	}
-#endif
-
-template<typename T, typename U>
-static T Fe0(const T X, std::vector<U> &Sbox)
-{
-	return Sbox[2 * static_cast<byte>(X)] ^ Sbox[2 * static_cast<byte>(X >> 8) + 0x001] ^ Sbox[2 * static_cast<byte>(X >> 16) + 0x200] ^ Sbox[2 * static_cast<byte>(X >> 24) + 0x201];
-}
-
-template<typename T, typename U>
-static T Fe3(const T X, const std::vector<U> &Sbox)
-{
-	return Sbox[2 * static_cast<byte>(X) + 0x001] ^ Sbox[2 * static_cast<byte>(X >> 8) + 0x200] ^ Sbox[2 * static_cast<byte>(X >> 16) + 0x201] ^ Sbox[2 * static_cast<byte>(X >> 24)];
-}
-
 //~~~Twofish S-Box and Lookup Tables~~~//
 
 static const std::array<byte, 256> Q0 =
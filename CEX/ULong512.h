@@ -75,7 +75,7 @@ public:
 	/// </summary>
 	///
 	/// <param name="Z">The 512bit register</param>
-	explicit UInt128(__m512i const &Z)
+	explicit ULong512(__m512i const &Z)
 	{
 		zmm = Z;
 	}
@@ -93,7 +93,7 @@ public:
 	}
 
 	/// <summary>
-	/// Initialize with 8 * 64bit unsigned integers
+	/// Initialize with 8 * 64bit unsigned integers; X0 is loaded into the lowest lane, the order used by Store
 	/// </summary>
 	///
 	/// <param name="X0">uint64 0</param>
@@ -106,7 +106,7 @@ public:
 	/// <param name="X7">uint64 7</param>
 	explicit ULong512(ulong X0, ulong X1, ulong X2, ulong X3, ulong X4, ulong X5, ulong X6, ulong X7)
 	{
-		zmm = _mm512_set_epi64(X0, X1, X2, X3, X4, X5, X6, X7);
+		zmm = _mm512_set_epi64(X7, X6, X5, X4, X3, X2, X1, X0);
 	}
 
 	/// <summary>
@@ -147,7 +147,7 @@ public:
 	/// <param name="X7">uint64 7</param>
 	inline void Load(ulong X0, ulong X1, ulong X2, ulong X3, ulong X4, ulong X5, ulong X6, ulong X7)
 	{
-		zmm = _mm512_set_epi64(X0, X1, X2, X3, X4, X5, X6, X7);
+		zmm = _mm512_set_epi64(X7, X6, X5, X4, X3, X2, X1, X0);
 	}
 
 	/// <summary>
@@ -194,7 +194,7 @@ public:
 	/// <param name="X5">uint64 5</param>
 	/// <param name="X6">uint64 6</param>
 	/// <param name="X7">uint64 7</param>
-	inline void Store(ulong X0, ulong &X1, ulong &X2, ulong &X3, ulong &X4, ulong &X5, ulong &X6, ulong &X7) const
+	inline void Store(ulong &X0, ulong &X1, ulong &X2, ulong &X3, ulong &X4, ulong &X5, ulong &X6, ulong &X7) const
 	{
 		std::array<ulong, 8> tmp;
 
@@ -304,7 +304,7 @@ public:
 	inline static ULong512 ShiftRA(const ULong512 &Value, const int Shift)
 	{
 		CexAssert(Shift <= 64, "Shift size is too large");
-		return ULong512(_mm512_sra_epi64(Value, _mm_set1_epi64(Shift)));
+		return ULong512(_mm512_sra_epi64(Value, _mm_set1_epi64x(Shift)));
 	}
 
 	/// <summary>
@@ -318,7 +318,7 @@ public:
 	inline static ULong512 ShiftRL(const ULong512 &Value, const int Shift)
 	{
 		CexAssert(Shift <= 64, "Shift size is too large");
-		return ULong512(_mm512_srl_epi64(Value, _mm_set1_epi64(Shift)));
+		return ULong512(_mm512_srl_epi64(Value, _mm_set1_epi64x(Shift)));
 	}
 
 	/// <summary>
@@ -424,7 +424,7 @@ public:
 	/// </summary>
 	inline ULong512 operator -- ()
 	{
-		return ULong512(zmm) - ZMM1();
+		return ULong512(zmm) - ULong512::ONE();
 	}
 
 	/// <summary>
@@ -702,7 +702,7 @@ public:
 	/// </summary>
 	inline ULong512 operator ! () const
 	{
-		return ULong512(_mm512_cmpeq_epi64(zmm, _mm512_setzero_si512()));
+		return ULong512(_mm512_maskz_set1_epi64(_mm512_cmpeq_epi64_mask(zmm, _mm512_setzero_si512()), -1));
 	}
 
 	/// <summary>
@@ -1,4 +1,6 @@
 #include "AEADTest.h"
+#include "../CEX/CryptoSymmetricCipherException.h"
+#include "../CEX/CTR.h"
 #include "../CEX/EAX.h"
 #include "../CEX/GCM.h"
 #include "../CEX/GMAC.h"
@@ -8,9 +10,13 @@
 
 namespace Test
 {
+	using Cipher::Symmetric::Block::Mode::CTR;
+	using Cipher::Symmetric::Block::Mode::CTRT;
 	using Cipher::Symmetric::Block::Mode::EAX;
 	using Cipher::Symmetric::Block::Mode::GCM;
+	using Cipher::Symmetric::Block::Mode::GCMT;
 	using Cipher::Symmetric::Block::Mode::OCB;
+	using Cipher::Symmetric::Block::Mode::OCBT;
 	using Cipher::Symmetric::Block::RHX;
 	using Cipher::Symmetric::Block::IBlockCipher;
 
@@ -45,6 +51,9 @@ namespace Test
 		{
 			EAX* cipher1 = new EAX(Enumeration::BlockCiphers::Rijndael);
 
+			UnkeyedCheck(cipher1);
+			OnProgress(std::string("AEADTest: Passed EAX un-keyed nonce rejection tests.."));
+
 			for (size_t i = 0; i < EAX_TESTSIZE; ++i)
 			{
 				CompareVector(cipher1, m_key[i], m_nonce[i], m_associatedText[i], m_plainText[i], m_cipherText[i], m_expectedCode[i]);
@@ -57,6 +66,9 @@ namespace Test
 			ParallelTest(cipher1);
 			OnProgress(std::string("AEADTest: Passed EAX parallel tests.."));
 
+			NonceCheck(cipher1);
+			OnProgress(std::string("AEADTest: Passed EAX nonce re-initialization tests.."));
+
 			IncrementalCheck(cipher1);
 			OnProgress(std::string("AEADTest: Passed EAX auto incrementing tests.."));
 
@@ -64,6 +76,9 @@ namespace Test
 
 			OCB* cipher2 = new OCB(Enumeration::BlockCiphers::Rijndael);
 
+			UnkeyedCheck(cipher2);
+			OnProgress(std::string("AEADTest: Passed OCB un-keyed nonce rejection tests.."));
+
 			for (size_t i = EAX_TESTSIZE; i < EAX_TESTSIZE + OCB_TESTSIZE; ++i)
 			{
 				CompareVector(cipher2, m_key[i], m_nonce[i], m_associatedText[i], m_plainText[i], m_cipherText[i], m_expectedCode[i]);
@@ -76,6 +91,9 @@ namespace Test
 			ParallelTest(cipher2);
 			OnProgress(std::string("AEADTest: Passed OCB parallel tests.."));
 
+			NonceCheck(cipher2);
+			OnProgress(std::string("AEADTest: Passed OCB nonce re-initialization tests.."));
+
 			IncrementalCheck(cipher2);
 			OnProgress(std::string("AEADTest: Passed OCB auto incrementing tests.."));
 
@@ -83,6 +101,9 @@ namespace Test
 
 			GCM* cipher3 = new GCM(Enumeration::BlockCiphers::Rijndael);
 
+			UnkeyedCheck(cipher3);
+			OnProgress(std::string("AEADTest: Passed GCM un-keyed nonce rejection tests.."));
+
 			for (size_t i = EAX_TESTSIZE + OCB_TESTSIZE; i < EAX_TESTSIZE + OCB_TESTSIZE + GCM_TESTSIZE; ++i)
 			{
 				CompareVector(cipher3, m_key[i], m_nonce[i], m_associatedText[i], m_plainText[i], m_cipherText[i], m_expectedCode[i]);
@@ -93,11 +114,20 @@ namespace Test
 			ParallelTest(cipher3);
 			OnProgress(std::string("AEADTest: Passed GCM parallel tests.."));
 
+			NonceCheck(cipher3);
+			OnProgress(std::string("AEADTest: Passed GCM nonce re-initialization tests.."));
+
 			IncrementalCheck(cipher3);
 			OnProgress(std::string("AEADTest: Passed GCM auto incrementing tests.."));
 
 			delete cipher3;
 
+			InfoCheck();
+			OnProgress(std::string("AEADTest: Passed GCM extended cipher info known answer tests.."));
+
+			ComposedCheck();
+			OnProgress(std::string("AEADTest: Passed compile-time composed CTR, GCM and OCB equivalence tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -110,6 +140,131 @@ namespace Test
 		}
 	}
 
+	void AEADTest::ComposedCheck()
+	{
+		// the templates bound to a concrete cipher must produce the same output as the virtual adapters;
+		// both are given a standard RHX instance, the enumeration constructors would select the HKDF extended cipher
+		RHX ctrEng;
+		CTRT<RHX> ctrt(&ctrEng);
+		RHX ctrCpr;
+		CTR ctr(&ctrCpr);
+		std::vector<byte> key(32);
+		std::vector<byte> nonce(16);
+		std::vector<byte> data;
+		std::vector<byte> enc1;
+		std::vector<byte> enc2;
+		Prng::SecureRandom rng;
+
+		const size_t CTRBLK = ctr.ParallelProfile().ParallelMinimumSize() * 2;
+
+		for (size_t i = 0; i < 110; ++i)
+		{
+			// the last inputs are larger than the parallel block size, so the multi-threaded transforms are compared as well
+			if (i == 100)
+			{
+				ctrt.ParallelProfile().IsParallel() = true;
+				ctrt.ParallelProfile().ParallelBlockSize() = CTRBLK;
+				ctr.ParallelProfile().IsParallel() = true;
+				ctr.ParallelProfile().ParallelBlockSize() = CTRBLK;
+			}
+
+			const size_t DATLEN = (i < 100) ? rng.NextUInt32(1000, 1) : rng.NextUInt32(static_cast<uint>(CTRBLK * 4), static_cast<uint>(CTRBLK + 1));
+			data.resize(DATLEN);
+			enc1.resize(DATLEN);
+			enc2.resize(DATLEN);
+			rng.GetBytes(data);
+			rng.GetBytes(key);
+			rng.GetBytes(nonce);
+			Key::Symmetric::SymmetricKey kp(key, nonce);
+
+			ctrt.Initialize(true, kp);
+			ctrt.Transform(data, 0, enc1, 0, DATLEN);
+			ctr.Initialize(true, kp);
+			ctr.Transform(data, 0, enc2, 0, DATLEN);
+
+			if (enc1 != enc2)
+			{
+				throw TestException("AEADTest: The composed CTR output does not match!");
+			}
+		}
+
+		RHX gcmEng;
+		GCMT<RHX> gcmt(&gcmEng);
+		RHX gcmCpr;
+		GCM gcm(&gcmCpr);
+		ComposedCompare(gcmt, &gcm);
+
+		RHX ocbEng;
+		RHX ocbHash;
+		OCBT<RHX> ocbt(&ocbEng, &ocbHash);
+		RHX ocbCpr;
+		OCB ocb(&ocbCpr);
+		ComposedCompare(ocbt, &ocb);
+	}
+
+	template<typename T>
+	void AEADTest::ComposedCompare(T &Composed, IAeadMode* Cipher)
+	{
+		const size_t TAGLEN = Cipher->MaxTagSize();
+		std::vector<byte> assoc(16);
+		std::vector<byte> data;
+		std::vector<byte> dec;
+		std::vector<byte> enc1;
+		std::vector<byte> enc2;
+		std::vector<byte> key(32);
+		std::vector<byte> nonce(12);
+		Prng::SecureRandom rng;
+		const size_t PRLBLK = Cipher->ParallelProfile().ParallelMinimumSize() * 2;
+
+		for (size_t i = 0; i < 110; ++i)
+		{
+			// the last inputs are larger than the parallel block size, so the multi-threaded transforms are compared as well
+			if (i == 100)
+			{
+				Composed.ParallelProfile().IsParallel() = true;
+				Composed.ParallelProfile().ParallelBlockSize() = PRLBLK;
+				Cipher->ParallelProfile().IsParallel() = true;
+				Cipher->ParallelProfile().ParallelBlockSize() = PRLBLK;
+			}
+
+			const size_t DATLEN = (i < 100) ? rng.NextUInt32(1000, 1) : rng.NextUInt32(static_cast<uint>(PRLBLK * 4), static_cast<uint>(PRLBLK + 1));
+			data.resize(DATLEN);
+			enc1.resize(DATLEN + TAGLEN);
+			enc2.resize(DATLEN + TAGLEN);
+			rng.GetBytes(assoc);
+			rng.GetBytes(data);
+			rng.GetBytes(key);
+			rng.GetBytes(nonce);
+			Key::Symmetric::SymmetricKey kp(key, nonce);
+
+			Composed.Initialize(true, kp);
+			Composed.SetAssociatedData(assoc, 0, assoc.size());
+			Composed.Transform(data, 0, enc1, 0, DATLEN);
+			Composed.Finalize(enc1, DATLEN, TAGLEN);
+
+			Cipher->Initialize(true, kp);
+			Cipher->SetAssociatedData(assoc, 0, assoc.size());
+			Cipher->Transform(data, 0, enc2, 0, DATLEN);
+			Cipher->Finalize(enc2, DATLEN, TAGLEN);
+
+			if (enc1 != enc2)
+			{
+				throw TestException("AEADTest: The composed " + Cipher->Name() + " output does not match!");
+			}
+
+			// the adapter output authenticates and decrypts through the template
+			dec.resize(DATLEN);
+			Composed.Initialize(false, kp);
+			Composed.SetAssociatedData(assoc, 0, assoc.size());
+			Composed.Transform(enc2, 0, dec, 0, DATLEN);
+
+			if (!Composed.Verify(enc2, DATLEN, TAGLEN) || dec != data)
+			{
+				throw TestException("AEADTest: The composed " + Cipher->Name() + " decryption failed!");
+			}
+		}
+	}
+
 	void AEADTest::CompareVector(IAeadMode* Cipher, std::vector<byte> &Key, std::vector<byte> &Nonce, std::vector<byte> &AssociatedText, std::vector<byte> &PlainText,
 		std::vector<byte> &CipherText, std::vector<byte> &MacCode)
 	{
@@ -221,6 +376,177 @@ namespace Test
 		}
 	}
 
+	void AEADTest::InfoCheck()
+	{
+		// GCM with the HKDF extended RHX and a distribution code; the counter cipher is keyed with the Info, and the vectors
+		// were generated before that change, when the cipher kept the Info from the hash key initialization across the re-key
+		const size_t TAGLEN = 16;
+		std::vector<byte> assoc(20);
+		std::vector<byte> data(64);
+		std::vector<byte> info(16);
+		std::vector<byte> key(32);
+		std::vector<byte> nonce(12);
+		std::vector<byte> enc(data.size() + TAGLEN);
+		std::vector<std::vector<byte>> expected;
+		const std::vector<std::string> code =
+		{
+			std::string("75683F8E2E0D0494E3AB54746A7E78CAB43D53F317D079E7235140092CDF8FF109C904877285E754DB752A070A762F684107DF95312C66E20278A0559796334B8741F921CA4D0A89D668E8FE9BE622CF"),
+			std::string("2964BA448B1C339137DD6471AE121E9E2BA6172D61A6FC3C8D914C25D0E48501519E16153F38FF42DDED85F2C1844E4FE353A85D6BB48D3E656292AC3F89EC074246BDA3039F526E4376B4F659FBA623"),
+			std::string("34DCB489CB581D09D25931FB5EB02775728DCC4ED8FE7997E7B83D47F2EBFAA433A2E5ED5F8B45ADEA9CE5D1495057DEB21767B392E00B03EF3222F4E6F2976796F81D2A67980D554265C4BA920846FE")
+		};
+		HexConverter::Decode(code, 3, expected);
+
+		for (size_t i = 0; i < assoc.size(); ++i)
+		{
+			assoc[i] = static_cast<byte>(0xD0 + i);
+		}
+		for (size_t i = 0; i < data.size(); ++i)
+		{
+			data[i] = static_cast<byte>(i * 3);
+		}
+		for (size_t i = 0; i < info.size(); ++i)
+		{
+			info[i] = static_cast<byte>(0x40 + i);
+		}
+		for (size_t i = 0; i < key.size(); ++i)
+		{
+			key[i] = static_cast<byte>(i);
+		}
+		for (size_t i = 0; i < nonce.size(); ++i)
+		{
+			nonce[i] = static_cast<byte>(0xA0 + i);
+		}
+
+		std::vector<byte> nonce2 = nonce;
+		nonce2[11] ^= 1;
+		Key::Symmetric::SymmetricKey kp1(key, nonce, info);
+		Key::Symmetric::SymmetricKey kp2(std::vector<byte>(0), nonce2);
+		Key::Symmetric::SymmetricKey kp3(key, nonce);
+
+		// keyed with the info, then a nonce only initialization that keeps it, then keyed without it
+		GCM cipher1(Enumeration::BlockCiphers::RHX);
+		RHX gcmEng(Enumeration::Digests::SHA256, 22);
+		GCMT<RHX> cipher2(&gcmEng);
+		GCM cipher3(Enumeration::BlockCiphers::RHX);
+		RHX gcmEng2(Enumeration::Digests::SHA256, 22);
+		GCMT<RHX> cipher4(&gcmEng2);
+		IAeadMode* ciphers[] = { &cipher1, &cipher1, &cipher3 };
+		Key::Symmetric::SymmetricKey* keys[] = { &kp1, &kp2, &kp3 };
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			ciphers[i]->Initialize(true, *keys[i]);
+			ciphers[i]->SetAssociatedData(assoc, 0, assoc.size());
+			ciphers[i]->Transform(data, 0, enc, 0, data.size());
+			ciphers[i]->Finalize(enc, data.size(), TAGLEN);
+
+			if (enc != expected[i])
+			{
+				throw TestException("InfoCheck: The GCM output does not match the known answer!");
+			}
+
+			GCMT<RHX> &cmp = (i < 2) ? cipher2 : cipher4;
+			cmp.Initialize(true, *keys[i]);
+			cmp.SetAssociatedData(assoc, 0, assoc.size());
+			cmp.Transform(data, 0, enc, 0, data.size());
+			cmp.Finalize(enc, data.size(), TAGLEN);
+
+			if (enc != expected[i])
+			{
+				throw TestException("InfoCheck: The composed GCM output does not match the known answer!");
+			}
+		}
+	}
+
+	void AEADTest::NonceCheck(IAeadMode* Cipher)
+	{
+		Key::Symmetric::SymmetricKeySize keySize = Cipher->LegalKeySizes()[0];
+		const size_t TAGLEN = Cipher->MaxTagSize();
+		std::vector<byte> assoc(16);
+		std::vector<byte> data;
+		std::vector<byte> decData;
+		std::vector<byte> encData1;
+		std::vector<byte> encData2;
+		std::vector<byte> key(32);
+		std::vector<byte> nonce(keySize.NonceSize());
+		Prng::SecureRandom rng;
+
+		rng.GetBytes(key);
+		rng.GetBytes(nonce);
+		Key::Symmetric::SymmetricKey kp1(key, nonce);
+		Cipher->Initialize(true, kp1);
+
+		for (size_t i = 0; i < 10; ++i)
+		{
+			const size_t DATLEN = rng.NextUInt32(1000, 100);
+			data.resize(DATLEN);
+			decData.resize(DATLEN);
+			encData1.resize(DATLEN + TAGLEN);
+			encData2.resize(DATLEN + TAGLEN);
+			rng.GetBytes(assoc);
+			rng.GetBytes(data);
+			rng.GetBytes(nonce);
+
+			// the cipher keeps the key from the last full initialization, only the nonce is loaded
+			Key::Symmetric::SymmetricKey kp2(std::vector<byte>(0), nonce);
+			Cipher->Initialize(true, kp2);
+			Cipher->SetAssociatedData(assoc, 0, assoc.size());
+			Cipher->Transform(data, 0, encData1, 0, DATLEN);
+			Cipher->Finalize(encData1, DATLEN, TAGLEN);
+
+			Key::Symmetric::SymmetricKey kp3(key, nonce);
+			Cipher->Initialize(true, kp3);
+			Cipher->SetAssociatedData(assoc, 0, assoc.size());
+			Cipher->Transform(data, 0, encData2, 0, DATLEN);
+			Cipher->Finalize(encData2, DATLEN, TAGLEN);
+
+			if (encData1 != encData2)
+			{
+				throw TestException("NonceCheck: The nonce re-initialized output is not equal to the keyed output!");
+			}
+
+			// key the decryption with another nonce, then load the message nonce
+			std::vector<byte> tmpNonce(nonce.size());
+			rng.GetBytes(tmpNonce);
+			Key::Symmetric::SymmetricKey kp4(key, tmpNonce);
+			Cipher->Initialize(false, kp4);
+			Cipher->Initialize(false, kp2);
+			Cipher->SetAssociatedData(assoc, 0, assoc.size());
+			Cipher->Transform(encData1, 0, decData, 0, DATLEN);
+
+			if (!Cipher->Verify(encData1, DATLEN, TAGLEN))
+			{
+				throw TestException("NonceCheck: Tags do not match!");
+			}
+
+			if (decData != data)
+			{
+				throw TestException("NonceCheck: The nonce re-initialized decryption is not equal to the plain text!");
+			}
+
+			// the counter modes can change direction with a nonce, OCB keys its block cipher for one direction
+			rng.GetBytes(nonce);
+			Key::Symmetric::SymmetricKey kp5(std::vector<byte>(0), nonce);
+			bool isRejected = false;
+
+			try
+			{
+				Cipher->Initialize(true, kp5);
+			}
+			catch (Exception::CryptoSymmetricCipherException const &)
+			{
+				isRejected = true;
+			}
+
+			if (isRejected != (Cipher->Enumeral() == Enumeration::CipherModes::OCB))
+			{
+				throw TestException("NonceCheck: The cipher direction change was not handled!");
+			}
+
+			Cipher->Initialize(true, kp3);
+		}
+	}
+
 	void AEADTest::ParallelTest(IAeadMode* Cipher)
 	{
 		std::vector<byte> data;
@@ -343,6 +669,28 @@ namespace Test
 		}
 	}
 
+	void AEADTest::UnkeyedCheck(IAeadMode* Cipher)
+	{
+		std::vector<byte> nonce(Cipher->LegalKeySizes()[0].NonceSize(), 0x01);
+		Key::Symmetric::SymmetricKey kp(std::vector<byte>(0), nonce);
+		bool isRejected = false;
+
+		// a nonce without a key can only follow a keyed initialization
+		try
+		{
+			Cipher->Initialize(true, kp);
+		}
+		catch (Exception::CryptoSymmetricCipherException const &)
+		{
+			isRejected = true;
+		}
+
+		if (!isRejected)
+		{
+			throw TestException("UnkeyedCheck: A nonce without a key was accepted by an un-keyed mode!");
+		}
+	}
+
 	void AEADTest::Initialize()
 	{
 		/*lint -save -e417 */
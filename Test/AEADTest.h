@@ -65,12 +65,18 @@ namespace Test
 
 	private:
 
+		void ComposedCheck();
+		template<typename T>
+		void ComposedCompare(T &Composed, IAeadMode* Cipher);
 		void CompareVector(IAeadMode* Cipher, std::vector<byte> &Key, std::vector<byte> &Nonce, std::vector<byte> &AssociatedText, std::vector<byte> &PlainText, std::vector<byte> &CipherText, std::vector<byte> &MacCode);
 		void IncrementalCheck(IAeadMode* Cipher);
+		void InfoCheck();
 		void Initialize();
+		void NonceCheck(IAeadMode* Cipher);
 		void OnProgress(std::string Data);
 		void ParallelTest(IAeadMode* Cipher);
 		void StressTest(IAeadMode* Cipher);
+		void UnkeyedCheck(IAeadMode* Cipher);
 	};
 }
 
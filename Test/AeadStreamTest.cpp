@@ -0,0 +1,391 @@
+#include "AeadStreamTest.h"
+#include "../CEX/AeadStream.h"
+#include "../CEX/GCM.h"
+#include "../CEX/IntUtils.h"
+#include "../CEX/MemoryStream.h"
+#include "../CEX/SecureRandom.h"
+#include "../CEX/SymmetricKey.h"
+
+namespace Test
+{
+	using Processing::AeadStream;
+	using Enumeration::AeadModes;
+	using Enumeration::BlockCiphers;
+	using Cipher::Symmetric::Block::Mode::GCM;
+	using IO::MemoryStream;
+	using Prng::SecureRandom;
+	using Key::Symmetric::SymmetricKey;
+
+	const std::string AeadStreamTest::DESCRIPTION = "AeadStream segmented AEAD format, authentication and parallel processing tests.";
+	const std::string AeadStreamTest::FAILURE = "FAILURE! ";
+	const std::string AeadStreamTest::SUCCESS = "SUCCESS! All AeadStream tests have executed succesfully.";
+
+	AeadStreamTest::AeadStreamTest()
+		:
+		m_key(32),
+		m_prefix(AeadStream::NONCE_PREFIX),
+		m_progressEvent()
+	{
+	}
+
+	AeadStreamTest::~AeadStreamTest()
+	{
+	}
+
+	const std::string AeadStreamTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &AeadStreamTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string AeadStreamTest::Run()
+	{
+		try
+		{
+			Initialize();
+
+			FormatCheck();
+			OnProgress(std::string("AeadStreamTest: Passed stream format and segment nonce tests.."));
+			HeaderCheck();
+			OnProgress(std::string("AeadStreamTest: Passed stream header validation tests.."));
+
+			RoundTripCheck(AeadModes::EAX);
+			RoundTripCheck(AeadModes::GCM);
+			RoundTripCheck(AeadModes::OCB);
+			OnProgress(std::string("AeadStreamTest: Passed EAX, GCM and OCB round trip tests.."));
+
+			ParallelCheck(AeadModes::EAX);
+			ParallelCheck(AeadModes::GCM);
+			ParallelCheck(AeadModes::OCB);
+			OnProgress(std::string("AeadStreamTest: Passed parallel and sequential equivalence tests.."));
+
+			AuthenticationCheck(AeadModes::EAX);
+			AuthenticationCheck(AeadModes::GCM);
+			AuthenticationCheck(AeadModes::OCB);
+			OnProgress(std::string("AeadStreamTest: Passed modified, reordered, truncated and extended stream tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (std::exception const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + std::string(ex.what()));
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void AeadStreamTest::AuthenticationCheck(AeadModes ModeType)
+	{
+		const size_t SEGLEN = SEGMENT_SIZE + AeadStream::TAG_SIZE;
+		std::vector<byte> pln(SEGMENT_SIZE * 4 + 100);
+		SecureRandom rnd;
+		rnd.GetBytes(pln);
+
+		const std::vector<byte> CPT = Encrypt(ModeType, pln);
+		std::vector<std::vector<byte>> tmpCpt;
+
+		// a modified byte in the third segment
+		tmpCpt.push_back(CPT);
+		tmpCpt.back()[AeadStream::HEADER_SIZE + (2 * SEGLEN) + 10] ^= 0x01;
+		// a modified tag
+		tmpCpt.push_back(CPT);
+		tmpCpt.back()[AeadStream::HEADER_SIZE + SEGLEN - 1] ^= 0x01;
+		// a modified nonce prefix in the header
+		tmpCpt.push_back(CPT);
+		tmpCpt.back()[AeadStream::HEADER_SIZE - 1] ^= 0x01;
+		// the first two segments swapped
+		tmpCpt.push_back(CPT);
+		std::copy(CPT.begin() + AeadStream::HEADER_SIZE, CPT.begin() + AeadStream::HEADER_SIZE + SEGLEN, tmpCpt.back().begin() + AeadStream::HEADER_SIZE + SEGLEN);
+		std::copy(CPT.begin() + AeadStream::HEADER_SIZE + SEGLEN, CPT.begin() + AeadStream::HEADER_SIZE + (2 * SEGLEN), tmpCpt.back().begin() + AeadStream::HEADER_SIZE);
+		// truncated at a segment boundary, so the last remaining segment is not marked final
+		tmpCpt.push_back(std::vector<byte>(CPT.begin(), CPT.begin() + AeadStream::HEADER_SIZE + (4 * SEGLEN)));
+		// extended with a copy of a full segment, so the final segment is no longer last
+		tmpCpt.push_back(std::vector<byte>(CPT.begin(), CPT.begin() + AeadStream::HEADER_SIZE + (4 * SEGLEN)));
+		tmpCpt.back().insert(tmpCpt.back().end(), CPT.begin() + AeadStream::HEADER_SIZE, CPT.begin() + AeadStream::HEADER_SIZE + SEGLEN);
+		tmpCpt.back().insert(tmpCpt.back().end(), CPT.begin() + AeadStream::HEADER_SIZE + (4 * SEGLEN), CPT.end());
+
+		for (size_t i = 0; i < tmpCpt.size(); ++i)
+		{
+			bool isRejected = false;
+
+			try
+			{
+				Decrypt(ModeType, tmpCpt[i]);
+			}
+			catch (Exception::CryptoAuthenticationFailure const &)
+			{
+				isRejected = true;
+			}
+
+			if (!isRejected)
+			{
+				throw TestException("AuthenticationCheck: A modified stream was not rejected! -AC" + std::to_string(i + 1));
+			}
+		}
+
+		// truncated inside a tag is malformed, and rejected before any segment is processed
+		bool isRejected = false;
+
+		try
+		{
+			Decrypt(ModeType, std::vector<byte>(CPT.begin(), CPT.begin() + AeadStream::HEADER_SIZE + (4 * SEGLEN) + 8));
+		}
+		catch (Exception::CryptoProcessingException const &)
+		{
+			isRejected = true;
+		}
+
+		if (!isRejected)
+		{
+			throw TestException("AuthenticationCheck: A truncated stream was not rejected! -AC7");
+		}
+	}
+
+	std::vector<byte> AeadStreamTest::Decrypt(AeadModes ModeType, const std::vector<byte> &Input, size_t SegmentSize, size_t Degree)
+	{
+		AeadStream cpr(ModeType, BlockCiphers::Rijndael, SegmentSize);
+		SymmetricKey kp(m_key);
+
+		if (Degree != 0)
+		{
+			cpr.ParallelMaxDegree(Degree);
+		}
+
+		cpr.Initialize(false, kp);
+		MemoryStream mIn(Input);
+		MemoryStream mOut;
+		cpr.Write(&mIn, &mOut);
+
+		return mOut.ToArray();
+	}
+
+	std::vector<byte> AeadStreamTest::Encrypt(AeadModes ModeType, const std::vector<byte> &Input, size_t Degree)
+	{
+		AeadStream cpr(ModeType, BlockCiphers::Rijndael, SEGMENT_SIZE);
+		SymmetricKey kp(m_key, m_prefix);
+
+		if (Degree != 0)
+		{
+			cpr.ParallelMaxDegree(Degree);
+		}
+
+		cpr.Initialize(true, kp);
+		MemoryStream mIn(Input);
+		MemoryStream mOut;
+		cpr.Write(&mIn, &mOut);
+
+		return mOut.ToArray();
+	}
+
+	void AeadStreamTest::FormatCheck()
+	{
+		const size_t SEGLEN = SEGMENT_SIZE + AeadStream::TAG_SIZE;
+		std::vector<byte> pln(SEGMENT_SIZE * 2 + 100);
+		SecureRandom rnd;
+		rnd.GetBytes(pln);
+
+		const std::vector<byte> CPT = Encrypt(AeadModes::GCM, pln);
+
+		if (CPT.size() != AeadStream::CalculateSize(pln.size(), SEGMENT_SIZE))
+		{
+			throw TestException("FormatCheck: The stream length is incorrect! -FC1");
+		}
+
+		// magic 'CXAE', version, mode, cipher, tag size, little endian segment size, nonce prefix
+		std::vector<byte> expHdr = { 0x43, 0x58, 0x41, 0x45, 0x01, static_cast<byte>(AeadModes::GCM), static_cast<byte>(BlockCiphers::Rijndael), 0x10, 0x00, 0x04, 0x00, 0x00 };
+		expHdr.insert(expHdr.end(), m_prefix.begin(), m_prefix.end());
+
+		if (std::vector<byte>(CPT.begin(), CPT.begin() + AeadStream::HEADER_SIZE) != expHdr)
+		{
+			throw TestException("FormatCheck: The stream header is incorrect! -FC2");
+		}
+
+		// each segment is the GCM encryption of the segment, with the prefix || counter || final flag nonce and the header as associated data
+		for (size_t i = 0; i < 3; ++i)
+		{
+			const size_t PLNLEN = (i == 2) ? 100 : SEGMENT_SIZE;
+			std::vector<byte> nonce(12, 0x00);
+			std::copy(m_prefix.begin(), m_prefix.end(), nonce.begin());
+			Utility::IntUtils::Be32ToBytes(static_cast<uint>(i), nonce, AeadStream::NONCE_PREFIX);
+			nonce[11] = (i == 2) ? 0x01 : 0x00;
+
+			GCM cpr(BlockCiphers::Rijndael);
+			SymmetricKey kp(m_key, nonce);
+			std::vector<byte> expSeg(PLNLEN + AeadStream::TAG_SIZE);
+			cpr.Initialize(true, kp);
+			cpr.SetAssociatedData(expHdr, 0, expHdr.size());
+			cpr.Transform(pln, i * SEGMENT_SIZE, expSeg, 0, PLNLEN);
+			cpr.Finalize(expSeg, PLNLEN, AeadStream::TAG_SIZE);
+
+			const size_t SEGOFF = AeadStream::HEADER_SIZE + (i * SEGLEN);
+
+			if (std::vector<byte>(CPT.begin() + SEGOFF, CPT.begin() + SEGOFF + expSeg.size()) != expSeg)
+			{
+				throw TestException("FormatCheck: The segment does not match the mode output! -FC3");
+			}
+		}
+	}
+
+	void AeadStreamTest::HeaderCheck()
+	{
+		std::vector<byte> pln(100);
+		SecureRandom rnd;
+		rnd.GetBytes(pln);
+
+		const std::vector<byte> CPT = Encrypt(AeadModes::GCM, pln);
+		bool isRejected = false;
+
+		// a different segment size
+		try
+		{
+			Decrypt(AeadModes::GCM, CPT, SEGMENT_SIZE * 2);
+		}
+		catch (Exception::CryptoProcessingException const &)
+		{
+			isRejected = true;
+		}
+
+		if (!isRejected)
+		{
+			throw TestException("HeaderCheck: A stream with a different segment size was accepted! -HC1");
+		}
+
+		// a different mode
+		isRejected = false;
+
+		try
+		{
+			Decrypt(AeadModes::OCB, CPT);
+		}
+		catch (Exception::CryptoProcessingException const &)
+		{
+			isRejected = true;
+		}
+
+		if (!isRejected)
+		{
+			throw TestException("HeaderCheck: A stream with a different mode was accepted! -HC2");
+		}
+
+		// not a stream
+		isRejected = false;
+		std::vector<byte> tmpCpt = CPT;
+		tmpCpt[0] ^= 0x01;
+
+		try
+		{
+			Decrypt(AeadModes::GCM, tmpCpt);
+		}
+		catch (Exception::CryptoProcessingException const &)
+		{
+			isRejected = true;
+		}
+
+		if (!isRejected)
+		{
+			throw TestException("HeaderCheck: A stream with an invalid magic value was accepted! -HC3");
+		}
+
+		// a second stream requires a new nonce prefix
+		isRejected = false;
+		AeadStream cpr(AeadModes::GCM, BlockCiphers::Rijndael, SEGMENT_SIZE);
+		SymmetricKey kp(m_key, m_prefix);
+		cpr.Initialize(true, kp);
+		MemoryStream mIn(pln);
+		MemoryStream mOut;
+		cpr.Write(&mIn, &mOut);
+		mIn.Seek(0, IO::SeekOrigin::Begin);
+
+		try
+		{
+			cpr.Write(&mIn, &mOut);
+		}
+		catch (Exception::CryptoProcessingException const &)
+		{
+			isRejected = true;
+		}
+
+		if (!isRejected)
+		{
+			throw TestException("HeaderCheck: A second stream was written without a new initialization! -HC4");
+		}
+	}
+
+	void AeadStreamTest::Initialize()
+	{
+		SecureRandom rnd;
+		rnd.GetBytes(m_key);
+
+		// a zeroised prefix is rejected
+		do
+		{
+			rnd.GetBytes(m_prefix);
+		}
+		while (m_prefix == std::vector<byte>(AeadStream::NONCE_PREFIX, 0x00));
+	}
+
+	void AeadStreamTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	void AeadStreamTest::ParallelCheck(AeadModes ModeType)
+	{
+		std::vector<byte> pln(SEGMENT_SIZE * 21 + 7);
+		SecureRandom rnd;
+		rnd.GetBytes(pln);
+
+		// batches of 1, 4 and 8 segments produce the same stream, and decrypt with any other degree
+		const std::vector<byte> CPT1 = Encrypt(ModeType, pln, 1);
+		const std::vector<byte> CPT4 = Encrypt(ModeType, pln, 4);
+		const std::vector<byte> CPT8 = Encrypt(ModeType, pln, 8);
+
+		if (CPT1 != CPT4 || CPT1 != CPT8)
+		{
+			throw TestException("ParallelCheck: The parallel output differs from the sequential output! -PC1");
+		}
+
+		if (Decrypt(ModeType, CPT1, SEGMENT_SIZE, 8) != pln || Decrypt(ModeType, CPT8, SEGMENT_SIZE, 1) != pln || Decrypt(ModeType, CPT4, SEGMENT_SIZE, 3) != pln)
+		{
+			throw TestException("ParallelCheck: The parallel decryption is incorrect! -PC2");
+		}
+	}
+
+	void AeadStreamTest::RoundTripCheck(AeadModes ModeType)
+	{
+		const std::vector<size_t> PLNLEN = { 0, 1, SEGMENT_SIZE - 1, SEGMENT_SIZE, SEGMENT_SIZE + 1, (SEGMENT_SIZE * 5) + 17, SEGMENT_SIZE * 16 };
+		SecureRandom rnd;
+
+		for (size_t i = 0; i < PLNLEN.size(); ++i)
+		{
+			std::vector<byte> pln(PLNLEN[i]);
+
+			if (pln.size() != 0)
+			{
+				rnd.GetBytes(pln);
+			}
+
+			const std::vector<byte> CPT = Encrypt(ModeType, pln);
+
+			if (CPT.size() != AeadStream::CalculateSize(pln.size(), SEGMENT_SIZE))
+			{
+				throw TestException("RoundTripCheck: The stream length is incorrect! -RC1");
+			}
+
+			if (Decrypt(ModeType, CPT) != pln)
+			{
+				throw TestException("RoundTripCheck: The decrypted stream does not match the input! -RC2");
+			}
+		}
+	}
+}
@@ -0,0 +1,68 @@
+#ifndef CEXTEST_AEADSTREAMTEST_H
+#define CEXTEST_AEADSTREAMTEST_H
+
+#include "ITest.h"
+#include "../CEX/AeadModes.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests the AeadStream segmented AEAD processor.
+	/// <para>Checks the stream format against the underlying AEAD mode, round trips with each mode and input lengths around the segment boundaries,
+	/// that parallel and sequential processing produce the same stream, and that modified, reordered, truncated and extended streams are rejected.</para>
+	/// </summary>
+	class AeadStreamTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+		static const size_t SEGMENT_SIZE = 1024;
+
+		std::vector<byte> m_key;
+		std::vector<byte> m_prefix;
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Initialize this class
+		/// </summary>
+		AeadStreamTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~AeadStreamTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void AuthenticationCheck(Enumeration::AeadModes ModeType);
+		std::vector<byte> Decrypt(Enumeration::AeadModes ModeType, const std::vector<byte> &Input, size_t SegmentSize = SEGMENT_SIZE, size_t Degree = 0);
+		std::vector<byte> Encrypt(Enumeration::AeadModes ModeType, const std::vector<byte> &Input, size_t Degree = 0);
+		void FormatCheck();
+		void HeaderCheck();
+		void Initialize();
+		void OnProgress(std::string Data);
+		void ParallelCheck(Enumeration::AeadModes ModeType);
+		void RoundTripCheck(Enumeration::AeadModes ModeType);
+	};
+}
+
+#endif
@@ -0,0 +1,292 @@
+#include "AllocationTest.h"
+#include "../CEX/Blake512.h"
+#include "../CEX/CMAC.h"
+#include "../CEX/CTR.h"
+#include "../CEX/GCM.h"
+#include "../CEX/HMAC.h"
+#include "../CEX/Instrumentation.h"
+#include "../CEX/Keccak512.h"
+#include "../CEX/SecureRandom.h"
+#include "../CEX/SHA256.h"
+#include "../CEX/SHA512.h"
+#include "../CEX/SymmetricKey.h"
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	// the allocation counter of the calling thread; allocations are counted only while tracing is on
+	thread_local size_t allocCount = 0;
+	thread_local bool allocTrace = false;
+
+	void* CountedAlloc(size_t Size)
+	{
+		if (allocTrace)
+		{
+			++allocCount;
+		}
+
+		CEX::Common::Instrumentation::RecordAllocation(Size);
+
+		return std::malloc(Size != 0 ? Size : 1);
+	}
+}
+
+//~~~Global Allocator Hook~~~//
+
+void* operator new(size_t Size)
+{
+	void* ptr = CountedAlloc(Size);
+
+	if (ptr == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	return ptr;
+}
+
+void* operator new[](size_t Size)
+{
+	void* ptr = CountedAlloc(Size);
+
+	if (ptr == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	return ptr;
+}
+
+void* operator new(size_t Size, const std::nothrow_t &) noexcept
+{
+	return CountedAlloc(Size);
+}
+
+void* operator new[](size_t Size, const std::nothrow_t &) noexcept
+{
+	return CountedAlloc(Size);
+}
+
+void operator delete(void* Ptr) noexcept
+{
+	std::free(Ptr);
+}
+
+void operator delete[](void* Ptr) noexcept
+{
+	std::free(Ptr);
+}
+
+void operator delete(void* Ptr, size_t) noexcept
+{
+	std::free(Ptr);
+}
+
+void operator delete[](void* Ptr, size_t) noexcept
+{
+	std::free(Ptr);
+}
+
+void operator delete(void* Ptr, const std::nothrow_t &) noexcept
+{
+	std::free(Ptr);
+}
+
+void operator delete[](void* Ptr, const std::nothrow_t &) noexcept
+{
+	std::free(Ptr);
+}
+
+namespace Test
+{
+	using Mac::CMAC;
+	using Cipher::Symmetric::Block::Mode::CTR;
+	using Cipher::Symmetric::Block::Mode::GCM;
+	using Mac::HMAC;
+	using Digest::Blake512;
+	using Digest::IDigest;
+	using Digest::Keccak512;
+	using Prng::SecureRandom;
+	using Digest::SHA256;
+	using Digest::SHA512;
+	using Key::Symmetric::SymmetricKey;
+
+	const std::string AllocationTest::DESCRIPTION = "Heap allocation tests for the cipher mode, digest, MAC and random generator hot paths.";
+	const std::string AllocationTest::FAILURE = "FAILURE! ";
+	const std::string AllocationTest::SUCCESS = "SUCCESS! All Allocation tests have executed succesfully.";
+
+	AllocationTest::AllocationTest()
+		:
+		m_progressEvent()
+	{
+	}
+
+	AllocationTest::~AllocationTest()
+	{
+	}
+
+	const std::string AllocationTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &AllocationTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string AllocationTest::Run()
+	{
+		try
+		{
+			CipherModeCheck();
+			OnProgress(std::string("AllocationTest: Passed CTR and GCM Transform and Finalize allocation tests.."));
+			DigestCheck();
+			OnProgress(std::string("AllocationTest: Passed SHA2, Keccak and Blake Update and Finalize allocation tests.."));
+			MacCheck();
+			OnProgress(std::string("AllocationTest: Passed HMAC and CMAC Update and Finalize allocation tests.."));
+			PrngCheck();
+			OnProgress(std::string("AllocationTest: Passed SecureRandom Fill and GetBytes allocation tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			allocTrace = false;
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			allocTrace = false;
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void AllocationTest::Begin()
+	{
+		allocCount = 0;
+		allocTrace = true;
+	}
+
+	void AllocationTest::CipherModeCheck()
+	{
+		// an unaligned length exercises the wide, single block and partial block key stream paths
+		const size_t MSGLEN = 1024 + 7;
+		std::vector<byte> key(32, 0x01);
+		std::vector<byte> nonce(16, 0x02);
+		std::vector<byte> msg(MSGLEN, 0x03);
+		std::vector<byte> enc(MSGLEN);
+		std::vector<byte> tag(16);
+		SymmetricKey kp(key, nonce);
+		CTR ctr(Enumeration::BlockCiphers::Rijndael);
+
+		ctr.ParallelProfile().IsParallel() = false;
+		ctr.Initialize(true, kp);
+		ctr.Transform(msg, 0, enc, 0, MSGLEN);
+
+		Begin();
+		ctr.Transform(msg, 0, enc, 0, MSGLEN);
+		End("CTR:Transform");
+
+		GCM gcm(Enumeration::BlockCiphers::Rijndael);
+
+		gcm.ParallelProfile().IsParallel() = false;
+		gcm.Initialize(true, kp);
+		gcm.Transform(msg, 0, enc, 0, MSGLEN);
+		gcm.Finalize(tag, 0, tag.size());
+		gcm.Initialize(true, kp);
+
+		Begin();
+		gcm.Transform(msg, 0, enc, 0, MSGLEN);
+		gcm.Finalize(tag, 0, tag.size());
+		End("GCM:Transform");
+	}
+
+	void AllocationTest::DigestCheck()
+	{
+		std::vector<byte> msg(1000, 0x01);
+		std::vector<byte> code(64);
+		SHA256 sha256;
+		SHA512 sha512;
+		Keccak512 keccak;
+		Blake512 blake;
+		IDigest* dgts[] = { &sha256, &sha512, &keccak, &blake };
+		const char* names[] = { "SHA256:Finalize", "SHA512:Finalize", "Keccak512:Finalize", "Blake512:Finalize" };
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			dgts[i]->Update(msg, 0, msg.size());
+			dgts[i]->Finalize(code, 0);
+
+			Begin();
+			dgts[i]->Update(msg, 0, 10);
+			dgts[i]->Update(msg, 10, msg.size() - 10);
+			dgts[i]->Finalize(code, 0);
+			End(names[i]);
+		}
+	}
+
+	void AllocationTest::End(const char* Name)
+	{
+		const size_t CNT = allocCount;
+
+		allocTrace = false;
+
+		if (CNT != 0)
+		{
+			throw TestException(std::string("AllocationTest: ") + Name + " allocated " + std::to_string(CNT) + " times after initialization!");
+		}
+	}
+
+	void AllocationTest::MacCheck()
+	{
+		std::vector<byte> key(32, 0x01);
+		std::vector<byte> msg(1000, 0x02);
+		std::vector<byte> code(32);
+		SymmetricKey kp(key);
+		HMAC hmac(Enumeration::Digests::SHA256);
+
+		hmac.Initialize(kp);
+		hmac.Update(msg, 0, msg.size());
+		hmac.Finalize(code, 0);
+
+		Begin();
+		hmac.Update(msg, 0, msg.size());
+		hmac.Finalize(code, 0);
+		End("HMAC:Finalize");
+
+		CMAC cmac(Enumeration::BlockCiphers::Rijndael);
+
+		cmac.Initialize(kp);
+		cmac.Update(msg, 0, msg.size());
+		cmac.Finalize(code, 0);
+
+		Begin();
+		cmac.Update(msg, 0, msg.size());
+		cmac.Finalize(code, 0);
+		End("CMAC:Finalize");
+	}
+
+	void AllocationTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	void AllocationTest::PrngCheck()
+	{
+		std::vector<uint> otp32(64);
+		std::vector<byte> otp8(256);
+		SecureRandom rnd;
+
+		rnd.Fill(otp32, 0, otp32.size());
+		// refill the internal buffer so the counted requests are served without calling the generator
+		rnd.Reset();
+
+		Begin();
+		rnd.Fill(otp32, 8, otp32.size() - 8);
+		rnd.GetBytes(otp8, 16, otp8.size() - 16);
+		rnd.NextUInt32();
+		End("SecureRandom:GetBytes");
+	}
+}
@@ -0,0 +1,63 @@
+#ifndef CEXTEST_ALLOCATIONTEST_H
+#define CEXTEST_ALLOCATIONTEST_H
+
+#include "ITest.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests that the hot paths of initialized primitives do not allocate.
+	/// <para>The test translation unit replaces the global operator new and delete with counting versions that forward to malloc and free;
+	/// counting is enabled only on the calling thread between Begin and End, and each allocation is also reported to Instrumentation::RecordAllocation.
+	/// Every primitive is initialized and run once before counting, so one-time setup such as the instrumentation site registration is excluded.</para>
+	/// </summary>
+	class AllocationTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Tests the Transform, Update and Finalize paths for heap allocations
+		/// </summary>
+		AllocationTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~AllocationTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void Begin();
+		void CipherModeCheck();
+		void DigestCheck();
+		void End(const char* Name);
+		void MacCheck();
+		void OnProgress(std::string Data);
+		void PrngCheck();
+	};
+}
+
+#endif
@@ -0,0 +1,351 @@
+#include "BatchStreamTest.h"
+#include "../CEX/BatchStream.h"
+#include "../CEX/CTR.h"
+#include "../CEX/MemoryStream.h"
+#include "../CEX/SecureRandom.h"
+#include "../CEX/SHA256.h"
+#include "../CEX/SymmetricKey.h"
+#include "../CEX/SymmetricSecureKey.h"
+
+namespace Test
+{
+	using Processing::BatchStream;
+	using Enumeration::BlockCiphers;
+	using Cipher::Symmetric::Block::Mode::CTR;
+	using Enumeration::Digests;
+	using IO::IByteStream;
+	using IO::MemoryStream;
+	using Prng::SecureRandom;
+	using Digest::SHA256;
+	using Key::Symmetric::ISymmetricKey;
+	using Key::Symmetric::SymmetricKey;
+	using Key::Symmetric::SymmetricSecureKey;
+
+	const std::string BatchStreamTest::DESCRIPTION = "BatchStream concurrent multi-stream encryption and hashing tests.";
+	const std::string BatchStreamTest::FAILURE = "FAILURE! ";
+	const std::string BatchStreamTest::SUCCESS = "SUCCESS! All BatchStream tests have executed succesfully.";
+
+	BatchStreamTest::BatchStreamTest()
+		:
+		m_progressEvent()
+	{
+	}
+
+	BatchStreamTest::~BatchStreamTest()
+	{
+	}
+
+	const std::string BatchStreamTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &BatchStreamTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string BatchStreamTest::Run()
+	{
+		try
+		{
+			CipherCheck(1);
+			CipherCheck(4);
+			OnProgress(std::string("BatchStreamTest: Passed sequential and concurrent batch encryption tests.."));
+			SecureKeyCheck(4);
+			OnProgress(std::string("BatchStreamTest: Passed concurrent batch encryption with secure keys tests.."));
+			DigestCheck(1);
+			DigestCheck(4);
+			OnProgress(std::string("BatchStreamTest: Passed sequential and concurrent batch hashing tests.."));
+			MemoryCheck();
+			OnProgress(std::string("BatchStreamTest: Passed memory limit and batch statistics tests.."));
+			ExceptionCheck();
+			OnProgress(std::string("BatchStreamTest: Passed invalid batch rejection tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (std::exception const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + std::string(ex.what()));
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void BatchStreamTest::CipherCheck(size_t Degree)
+	{
+		// empty, single block, partial, exact and multiple slice streams, and a large stream shared by the workers
+		const std::vector<size_t> STMLEN = { 0, 1, 100, BUFFER_SIZE - 1, BUFFER_SIZE, BUFFER_SIZE + 1, (BUFFER_SIZE * 5) + 7, 3, BUFFER_SIZE * 40, 17 };
+		SecureRandom rnd;
+		std::vector<std::vector<byte>> pln(STMLEN.size());
+		std::vector<std::vector<byte>> exp(STMLEN.size());
+		std::vector<std::unique_ptr<MemoryStream>> inp(0);
+		std::vector<std::unique_ptr<MemoryStream>> out(0);
+		std::vector<std::unique_ptr<SymmetricKey>> keys(0);
+		std::vector<IByteStream*> inpPtr(0);
+		std::vector<IByteStream*> outPtr(0);
+		std::vector<ISymmetricKey*> keyPtr(0);
+
+		for (size_t i = 0; i < STMLEN.size(); ++i)
+		{
+			std::vector<byte> key(32);
+			std::vector<byte> nonce(16);
+			pln[i].resize(STMLEN[i]);
+			rnd.GetBytes(pln[i]);
+			rnd.GetBytes(key);
+			rnd.GetBytes(nonce);
+
+			if (i == STMLEN.size() - 2)
+			{
+				// the counter carries into the upper half within the large stream
+				std::fill(nonce.begin() + 8, nonce.end(), static_cast<byte>(0xFF));
+				nonce[15] = 0xF0;
+			}
+
+			keys.push_back(std::unique_ptr<SymmetricKey>(new SymmetricKey(key, nonce)));
+			inp.push_back(std::unique_ptr<MemoryStream>(new MemoryStream(pln[i])));
+			out.push_back(std::unique_ptr<MemoryStream>(new MemoryStream()));
+			inpPtr.push_back(inp.back().get());
+			outPtr.push_back(out.back().get());
+			keyPtr.push_back(keys.back().get());
+
+			// the expected output is a single counter mode pass over the stream
+			CTR cpr(BlockCiphers::Rijndael);
+			exp[i].resize(STMLEN[i]);
+			cpr.Initialize(true, *keys.back());
+
+			if (STMLEN[i] != 0)
+			{
+				cpr.Transform(pln[i], 0, exp[i], 0, STMLEN[i]);
+			}
+		}
+
+		BatchStream bs(BlockCiphers::Rijndael, BUFFER_SIZE);
+		bs.ParallelMaxDegree(Degree);
+		bs.Write(inpPtr, outPtr, keyPtr);
+
+		for (size_t i = 0; i < STMLEN.size(); ++i)
+		{
+			if (out[i]->ToArray() != exp[i])
+			{
+				throw TestException("CipherCheck: The stream output does not match the counter mode output! -CC" + std::to_string(i + 1));
+			}
+		}
+
+		// counter mode is its own inverse; decrypt the batch back to the plain-text
+		std::vector<std::unique_ptr<MemoryStream>> dec(0);
+		std::vector<IByteStream*> decPtr(0);
+
+		for (size_t i = 0; i < STMLEN.size(); ++i)
+		{
+			out[i]->Seek(0, IO::SeekOrigin::Begin);
+			dec.push_back(std::unique_ptr<MemoryStream>(new MemoryStream()));
+			decPtr.push_back(dec.back().get());
+		}
+
+		bs.Write(outPtr, decPtr, keyPtr);
+
+		for (size_t i = 0; i < STMLEN.size(); ++i)
+		{
+			if (dec[i]->ToArray() != pln[i])
+			{
+				throw TestException("CipherCheck: The decrypted stream does not match the plain-text! -CC" + std::to_string(STMLEN.size() + i + 1));
+			}
+		}
+	}
+
+	void BatchStreamTest::DigestCheck(size_t Degree)
+	{
+		const std::vector<size_t> STMLEN = { 0, 1, BUFFER_SIZE * 30, 100, BUFFER_SIZE, (BUFFER_SIZE * 3) + 5, 64, BUFFER_SIZE * 2 };
+		SecureRandom rnd;
+		std::vector<std::vector<byte>> exp(STMLEN.size());
+		std::vector<std::unique_ptr<MemoryStream>> inp(0);
+		std::vector<IByteStream*> inpPtr(0);
+
+		for (size_t i = 0; i < STMLEN.size(); ++i)
+		{
+			std::vector<byte> pln(STMLEN[i]);
+			rnd.GetBytes(pln);
+			inp.push_back(std::unique_ptr<MemoryStream>(new MemoryStream(pln)));
+			inpPtr.push_back(inp.back().get());
+
+			SHA256 dgt;
+			exp[i].resize(dgt.DigestSize());
+			dgt.Compute(pln, exp[i]);
+		}
+
+		BatchStream bs(BlockCiphers::Rijndael, BUFFER_SIZE);
+		bs.ParallelMaxDegree(Degree);
+		std::vector<std::vector<byte>> hashes = bs.Compute(inpPtr, Digests::SHA256);
+
+		// the streams are scheduled longest first, but the hashes are returned in the input order
+		for (size_t i = 0; i < STMLEN.size(); ++i)
+		{
+			if (hashes[i] != exp[i])
+			{
+				throw TestException("DigestCheck: The stream hash does not match the digest output! -DC" + std::to_string(i + 1));
+			}
+		}
+	}
+
+	void BatchStreamTest::ExceptionCheck()
+	{
+		std::vector<byte> key(32);
+		std::vector<byte> nonce(16);
+		std::vector<byte> pln(100);
+		MemoryStream mIn(pln);
+		MemoryStream mOut;
+		SymmetricKey kp(key, nonce);
+		SymmetricKey kpShort(std::vector<byte>(32), std::vector<byte>(8));
+		std::vector<IByteStream*> inpPtr(1, &mIn);
+		std::vector<IByteStream*> outPtr(1, &mOut);
+		BatchStream bs(BlockCiphers::Rijndael, BUFFER_SIZE);
+
+		// the key list is shorter than the stream list
+		try
+		{
+			bs.Write(inpPtr, outPtr, std::vector<ISymmetricKey*>(0));
+
+			throw TestException("ExceptionCheck: A batch with a missing key was accepted! -EC1");
+		}
+		catch (Exception::CryptoProcessingException const &)
+		{
+		}
+
+		// the nonce is not a full counter block
+		try
+		{
+			bs.Write(inpPtr, outPtr, std::vector<ISymmetricKey*>(1, &kpShort));
+
+			throw TestException("ExceptionCheck: A batch with an invalid nonce was accepted! -EC2");
+		}
+		catch (Exception::CryptoProcessingException const &)
+		{
+		}
+
+		// a null stream
+		try
+		{
+			bs.Compute(std::vector<IByteStream*>(1, nullptr), Digests::SHA256);
+
+			throw TestException("ExceptionCheck: A batch with a null stream was accepted! -EC3");
+		}
+		catch (Exception::CryptoProcessingException const &)
+		{
+		}
+
+		// a buffer size that is not a multiple of the block size
+		try
+		{
+			BatchStream bs2(BlockCiphers::Rijndael, BUFFER_SIZE + 1);
+
+			throw TestException("ExceptionCheck: An invalid buffer size was accepted! -EC4");
+		}
+		catch (Exception::CryptoProcessingException const &)
+		{
+		}
+	}
+
+	void BatchStreamTest::MemoryCheck()
+	{
+		// two workers, each with an input and an output buffer, fit in the memory limit
+		BatchStream bs(BlockCiphers::Rijndael, BUFFER_SIZE, BUFFER_SIZE * 5);
+		bs.ParallelMaxDegree(8);
+
+		if (bs.ParallelDegree() != 2)
+		{
+			throw TestException("MemoryCheck: The worker count does not respect the memory limit! -MC1");
+		}
+
+		const size_t STMCNT = 20;
+		SecureRandom rnd;
+		std::vector<std::unique_ptr<MemoryStream>> inp(0);
+		std::vector<IByteStream*> inpPtr(0);
+		ulong ttlLen = 0;
+
+		for (size_t i = 0; i < STMCNT; ++i)
+		{
+			std::vector<byte> pln(rnd.NextUInt32(BUFFER_SIZE * 4));
+			rnd.GetBytes(pln);
+			ttlLen += pln.size();
+			inp.push_back(std::unique_ptr<MemoryStream>(new MemoryStream(pln)));
+			inpPtr.push_back(inp.back().get());
+		}
+
+		bs.Compute(inpPtr, Digests::SHA256);
+		BatchStream::BatchStatistics stats = bs.Statistics();
+
+		if (stats.Bytes != ttlLen || stats.Streams != STMCNT || stats.Degree != 2)
+		{
+			throw TestException("MemoryCheck: The batch statistics are incorrect! -MC2");
+		}
+	}
+
+	void BatchStreamTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	void BatchStreamTest::SecureKeyCheck(size_t Degree)
+	{
+		// the slices of each stream are shared by the workers, which must not unlock the secure key concurrently
+		const size_t STMCNT = 4;
+		const size_t STMLEN = (BUFFER_SIZE * 16) + 3;
+		SecureRandom rnd;
+		std::vector<std::vector<byte>> exp(STMCNT);
+		std::vector<std::vector<byte>> key(STMCNT);
+		std::vector<std::unique_ptr<MemoryStream>> inp(0);
+		std::vector<std::unique_ptr<MemoryStream>> out(0);
+		std::vector<std::unique_ptr<SymmetricSecureKey>> keys(0);
+		std::vector<IByteStream*> inpPtr(0);
+		std::vector<IByteStream*> outPtr(0);
+		std::vector<ISymmetricKey*> keyPtr(0);
+
+		for (size_t i = 0; i < STMCNT; ++i)
+		{
+			std::vector<byte> pln(STMLEN);
+			std::vector<byte> nonce(16);
+			key[i].resize(32);
+			rnd.GetBytes(pln);
+			rnd.GetBytes(key[i]);
+			rnd.GetBytes(nonce);
+
+			keys.push_back(std::unique_ptr<SymmetricSecureKey>(new SymmetricSecureKey(key[i], nonce)));
+			inp.push_back(std::unique_ptr<MemoryStream>(new MemoryStream(pln)));
+			out.push_back(std::unique_ptr<MemoryStream>(new MemoryStream()));
+			inpPtr.push_back(inp.back().get());
+			outPtr.push_back(out.back().get());
+			keyPtr.push_back(keys.back().get());
+
+			CTR cpr(BlockCiphers::Rijndael);
+			SymmetricKey kp(key[i], nonce);
+			exp[i].resize(STMLEN);
+			cpr.Initialize(true, kp);
+			cpr.Transform(pln, 0, exp[i], 0, STMLEN);
+		}
+
+		BatchStream bs(BlockCiphers::Rijndael, BUFFER_SIZE);
+		bs.ParallelMaxDegree(Degree);
+		bs.Write(inpPtr, outPtr, keyPtr);
+
+		for (size_t i = 0; i < STMCNT; ++i)
+		{
+			if (out[i]->ToArray() != exp[i])
+			{
+				throw TestException("SecureKeyCheck: The stream output does not match the counter mode output! -SK" + std::to_string(i + 1));
+			}
+
+			// the secure key is left locked and intact
+			if (keys[i]->Key() != key[i])
+			{
+				throw TestException("SecureKeyCheck: The secure key was altered by the batch! -SK" + std::to_string(STMCNT + i + 1));
+			}
+		}
+	}
+}
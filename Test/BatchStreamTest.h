@@ -0,0 +1,62 @@
+#ifndef CEXTEST_BATCHSTREAMTEST_H
+#define CEXTEST_BATCHSTREAMTEST_H
+
+#include "ITest.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests the BatchStream concurrent multi-stream processor.
+	/// <para>Compares batches of streams, from empty to several slices long, against a single counter mode or digest instance,
+	/// checks the memory bounded worker count and batch statistics, and that invalid batches are rejected.</para>
+	/// </summary>
+	class BatchStreamTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+		static const size_t BUFFER_SIZE = 1024;
+
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Initialize this class
+		/// </summary>
+		BatchStreamTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~BatchStreamTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void CipherCheck(size_t Degree);
+		void DigestCheck(size_t Degree);
+		void ExceptionCheck();
+		void MemoryCheck();
+		void OnProgress(std::string Data);
+		void SecureKeyCheck(size_t Degree);
+	};
+}
+
+#endif
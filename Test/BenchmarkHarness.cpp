@@ -0,0 +1,1318 @@
+#include "BenchmarkHarness.h"
+#include "TestUtils.h"
+#include "../CEX/CpuDetect.h"
+#include "../CEX/DigestFromName.h"
+#include "../CEX/Instrumentation.h"
+#include "../CEX/ParallelCalibration.h"
+#include "../CEX/SymmetricKey.h"
+#include "../CEX/SysUtils.h"
+#if defined(__AVX__)
+#	include "../CEX/AHX.h"
+#endif
+#include "../CEX/RHX.h"
+#include "../CEX/SHX.h"
+#include "../CEX/THX.h"
+#include "../CEX/CBC.h"
+#include "../CEX/CTR.h"
+#include "../CEX/CTRT.h"
+#include "../CEX/ECB.h"
+#include "../CEX/ICM.h"
+#include "../CEX/EAX.h"
+#include "../CEX/GCM.h"
+#include "../CEX/GCMT.h"
+#include "../CEX/OCB.h"
+#include "../CEX/OCBT.h"
+#include "../CEX/ChaCha20.h"
+#include "../CEX/Salsa20.h"
+#include "../CEX/CMAC.h"
+#include "../CEX/HMAC.h"
+#include "../CEX/KMAC.h"
+#include "../CEX/Poly1305.h"
+#include "../CEX/IAsymmetricKeyPair.h"
+#include "../CEX/McEliece.h"
+#include "../CEX/ModuleLWE.h"
+#include "../CEX/RingLWE.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace Test
+{
+	using namespace Cipher::Symmetric::Block;
+	using namespace Cipher::Symmetric::Stream;
+	using Digest::IDigest;
+	using Enumeration::Digests;
+	using Enumeration::Macs;
+	using Key::Symmetric::SymmetricKey;
+	using Mac::IMac;
+	using Utility::SysUtils;
+	using Cipher::Asymmetric::IAsymmetricCipher;
+	using Key::Asymmetric::IAsymmetricKey;
+	using Key::Asymmetric::IAsymmetricKeyPair;
+
+	const std::string BenchmarkHarness::DESCRIPTION = "Benchmark harness: message size sweeps of the symmetric primitives, in cycles per byte and MB per second.";
+	const std::string BenchmarkHarness::FAILURE = "FAILURE! ";
+	const std::string BenchmarkHarness::MESSAGE = "COMPLETE! The benchmarks have executed succesfully.";
+
+	//~~~BenchmarkResult~~~//
+
+	BenchmarkHarness::BenchmarkResult::BenchmarkResult()
+		:
+		Name(""),
+		Group(""),
+		Size(0),
+		Iterations(0),
+		Samples(0),
+		CyclesMedian(0.0),
+		CyclesP99(0.0),
+		NsMedian(0.0),
+		NsP99(0.0),
+		Bytes(0)
+	{
+	}
+
+	double BenchmarkHarness::BenchmarkResult::CpbMedian() const
+	{
+		return (Size != 0) ? CyclesMedian / Size : 0.0;
+	}
+
+	double BenchmarkHarness::BenchmarkResult::CpbP99() const
+	{
+		return (Size != 0) ? CyclesP99 / Size : 0.0;
+	}
+
+	double BenchmarkHarness::BenchmarkResult::MBps() const
+	{
+		// bytes per nanosecond is GB per second
+		return (NsMedian != 0.0) ? (Size / NsMedian) * 1000.0 : 0.0;
+	}
+
+	double BenchmarkHarness::BenchmarkResult::OpsPerSecond() const
+	{
+		return (NsMedian != 0.0) ? 1000000000.0 / NsMedian : 0.0;
+	}
+
+	//~~~Constructor~~~//
+
+	BenchmarkHarness::BenchmarkHarness(OutputFormats Format, const std::string &OutputPath, const std::string &Filter, size_t MinSize, size_t MaxSize, size_t Samples, size_t Warmup, BenchmarkModes Mode)
+		:
+		m_entries(),
+		m_filter(Filter),
+		m_format(Format),
+		m_hasRdtsc(false),
+		m_input(0),
+		m_maxSize(MaxSize),
+		m_minSize(MinSize),
+		m_mode(Mode),
+		m_output(0),
+		m_outputPath(OutputPath),
+		m_progressEvent(),
+		m_results(0),
+		m_samples(Samples),
+		m_scaling(),
+		m_warmup(Warmup)
+	{
+		if (MinSize == 0 || MinSize > MaxSize)
+		{
+			throw TestException("BenchmarkHarness: The minimum size must be at least 1, and not exceed the maximum size!");
+		}
+		if (Samples == 0)
+		{
+			throw TestException("BenchmarkHarness: The sample count can not be zero!");
+		}
+	}
+
+	BenchmarkHarness::~BenchmarkHarness()
+	{
+	}
+
+	//~~~Accessors~~~//
+
+	const std::string BenchmarkHarness::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &BenchmarkHarness::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	const std::vector<BenchmarkHarness::BenchmarkResult> &BenchmarkHarness::Results()
+	{
+		return m_results;
+	}
+
+	//~~~Public Functions~~~//
+
+	std::string BenchmarkHarness::Run()
+	{
+		try
+		{
+			Initialize();
+			m_results.clear();
+
+			OnProgress((m_mode == BenchmarkModes::Latency) ? std::string("### BENCHMARK HARNESS: MESSAGE LATENCY ###") :
+				(m_mode == BenchmarkModes::Scaling) ? std::string("### BENCHMARK HARNESS: THREAD SCALING AND PARALLEL CALIBRATION ###") :
+				(m_mode == BenchmarkModes::Asymmetric) ? std::string("### BENCHMARK HARNESS: ASYMMETRIC OPERATIONS ###") : std::string("### BENCHMARK HARNESS ###"));
+
+			if (m_mode == BenchmarkModes::Asymmetric)
+			{
+				OnProgress(std::string("### ") + std::to_string(m_samples) + std::string(" timed operations per entry, phase counters ") +
+					(Common::Instrumentation::Enabled() ? std::string("enabled") : std::string("disabled; build with CEX_INSTRUMENTATION for the phase breakdown")));
+			}
+			else
+			{
+				OnProgress(std::string("### Message sizes from ") + ((m_mode == BenchmarkModes::Scaling) ? std::string("the parallel minimum") : std::to_string(m_minSize)) +
+					std::string(" to ") + std::to_string(m_maxSize) + std::string(" bytes, ") +
+					std::to_string(m_samples) + ((m_mode == BenchmarkModes::Latency) ? std::string(" timed messages per size") : std::string(" samples per size")));
+			}
+
+			OnProgress(m_hasRdtsc ? std::string("### Cycle counts are read from the RDTSC timer") : std::string("### RDTSC is not available, cycle counts are zero"));
+			OnProgress(std::string(""));
+
+			for (size_t i = 0; i < m_entries.size(); ++i)
+			{
+				if (!Contains(m_entries[i].Name, m_filter))
+				{
+					continue;
+				}
+
+				// the latency of a single packet is measured for the authenticated operations
+				if (m_mode == BenchmarkModes::Latency && m_entries[i].Group != "aead" && m_entries[i].Group != "mac")
+				{
+					continue;
+				}
+
+				OnProgress(std::string("***") + m_entries[i].Name + std::string("***"));
+
+				// the asymmetric operations have no message size, each entry is a single result followed by its phases
+				if (m_mode == BenchmarkModes::Asymmetric)
+				{
+					std::vector<BenchmarkResult> phases;
+					std::ostringstream line;
+					BenchmarkResult res = MeasureAsymmetric(m_entries[i], phases);
+
+					line << std::fixed << std::setprecision(0) << "  " << res.CyclesMedian << " cycles (p99 " << res.CyclesP99 << "), " <<
+						std::setprecision(1) << res.OpsPerSecond() << " ops/s, " << res.Bytes << " bytes";
+					OnProgress(line.str());
+					m_results.push_back(res);
+
+					for (size_t j = 0; j < phases.size(); ++j)
+					{
+						std::ostringstream phsLine;
+
+						phsLine << std::fixed << std::setprecision(0) << "    " << std::left << std::setw(10) << phases[j].Name.substr(phases[j].Name.rfind('/') + 1) << std::right <<
+							std::setw(12) << phases[j].CyclesMedian << " cycles, " << std::setprecision(1) <<
+							((res.CyclesMedian != 0.0) ? (phases[j].CyclesMedian / res.CyclesMedian) * 100.0 : 0.0) << "%";
+						OnProgress(phsLine.str());
+						m_results.push_back(phases[j]);
+					}
+
+					continue;
+				}
+
+				// sizes grow by a factor of 4: 16, 64, 256, 1K, 4K, 16K, 64K, 256K, 1M, 4M, 16M, 64M
+				for (size_t len = m_minSize; len <= m_maxSize; len *= 4)
+				{
+					std::ostringstream line;
+					BenchmarkResult res;
+
+					if (m_mode == BenchmarkModes::Latency)
+					{
+						res = MeasureLatency(m_entries[i], len);
+						line << std::setw(10) << len << " bytes: " << std::fixed << std::setprecision(0) << res.CyclesMedian << " cycles (p99 " << res.CyclesP99 << "), " <<
+							res.NsMedian << " ns (p99 " << res.NsP99 << ")";
+					}
+					else
+					{
+						res = Measure(m_entries[i], len);
+						line << std::setw(10) << len << " bytes: " << std::fixed << std::setprecision(2) << res.CpbMedian() << " cpb (p99 " << res.CpbP99() << "), " <<
+							std::setprecision(1) << res.MBps() << " MB/s";
+					}
+
+					OnProgress(line.str());
+					m_results.push_back(res);
+
+					if (len > m_maxSize / 4)
+					{
+						break;
+					}
+				}
+			}
+
+			for (size_t i = 0; i < m_scaling.size(); ++i)
+			{
+				if (Contains(m_scaling[i].Name, m_filter))
+				{
+					Calibrate(m_scaling[i]);
+				}
+			}
+
+			if (m_outputPath.size() != 0)
+			{
+				std::ofstream ofs(m_outputPath.c_str(), std::ios::out | std::ios::trunc);
+
+				if (!ofs.is_open())
+				{
+					throw TestException("BenchmarkHarness: The output file could not be created!");
+				}
+
+				ofs << Serialize(m_results, m_format);
+				ofs.close();
+				OnProgress(std::string("Results written to ") + m_outputPath);
+			}
+
+			return MESSAGE;
+		}
+		catch (TestException const &ex)
+		{
+			return FAILURE + " : " + ex.Message();
+		}
+		catch (std::exception const &ex)
+		{
+			return FAILURE + " : " + ex.what();
+		}
+		catch (...)
+		{
+			return FAILURE + " : Unknown Error";
+		}
+	}
+
+	size_t BenchmarkHarness::Compare(const std::string &BaselinePath, const std::string &CurrentPath, double Threshold, std::string &Report)
+	{
+		std::vector<BenchmarkResult> bse = Load(BaselinePath);
+		std::vector<BenchmarkResult> cur = Load(CurrentPath);
+		std::map<std::string, BenchmarkResult> bsm;
+		std::ostringstream rpt;
+		size_t regCnt = 0;
+
+		for (size_t i = 0; i < bse.size(); ++i)
+		{
+			bsm[bse[i].Name + "/" + std::to_string(bse[i].Size)] = bse[i];
+		}
+
+		rpt << std::left << std::setw(24) << "name" << std::right << std::setw(10) << "size" << std::setw(16) << "baseline" << std::setw(16) << "current" << std::setw(10) << "change" << std::endl;
+
+		for (size_t i = 0; i < cur.size(); ++i)
+		{
+			std::map<std::string, BenchmarkResult>::const_iterator itr = bsm.find(cur[i].Name + "/" + std::to_string(cur[i].Size));
+
+			if (itr == bsm.end())
+			{
+				rpt << std::left << std::setw(24) << cur[i].Name << std::right << std::setw(10) << cur[i].Size << "  not in baseline" << std::endl;
+				continue;
+			}
+
+			// cycles are steadier than wall time under frequency scaling, so they are preferred when both runs have them
+			const bool USECYC = itr->second.CyclesMedian > 0.0 && cur[i].CyclesMedian > 0.0;
+			const double BSEVAL = USECYC ? itr->second.CyclesMedian : itr->second.NsMedian;
+			const double CURVAL = USECYC ? cur[i].CyclesMedian : cur[i].NsMedian;
+			const double CHGPCT = (BSEVAL > 0.0) ? ((CURVAL - BSEVAL) / BSEVAL) * 100.0 : 0.0;
+
+			rpt << std::left << std::setw(24) << cur[i].Name << std::right << std::setw(10) << cur[i].Size << std::fixed << std::setprecision(1) <<
+				std::setw(13) << BSEVAL << (USECYC ? " cy" : " ns") << std::setw(13) << CURVAL << (USECYC ? " cy" : " ns") <<
+				std::setw(9) << std::showpos << CHGPCT << std::noshowpos << "%";
+
+			if (CHGPCT > Threshold)
+			{
+				rpt << "  REGRESSION";
+				++regCnt;
+			}
+
+			rpt << std::endl;
+		}
+
+		rpt << regCnt << " regression(s) above " << std::fixed << std::setprecision(1) << Threshold << "%" << std::endl;
+		Report = rpt.str();
+
+		return regCnt;
+	}
+
+	int BenchmarkHarness::Execute(const std::vector<std::string> &Arguments)
+	{
+		try
+		{
+			if (Arguments.size() != 0 && (Arguments[0] == "benchmark" || Arguments[0] == "latency" || Arguments[0] == "calibrate" || Arguments[0] == "asymmetric"))
+			{
+				const bool ASYMDE = (Arguments[0] == "asymmetric");
+				const bool CALMDE = (Arguments[0] == "calibrate");
+				const bool LATMDE = (Arguments[0] == "latency");
+				OutputFormats fmt = OutputFormats::Json;
+				std::string flt("");
+				std::string out("");
+				std::string prf(Common::ParallelCalibration::DEF_PROFILE);
+				bool prfLod = false;
+				// the asymmetric mode does not sweep, the minimum size keeps the message buffers small
+				size_t maxSze = LATMDE ? LAT_MAXSIZE : CALMDE ? CAL_MAXSIZE : ASYMDE ? DEF_MINSIZE : DEF_MAXSIZE;
+				size_t minSze = DEF_MINSIZE;
+				size_t smpCnt = LATMDE ? LAT_SAMPLES : CALMDE ? CAL_SAMPLES : ASYMDE ? ASY_SAMPLES : DEF_SAMPLES;
+				size_t wrmCnt = LATMDE ? LAT_WARMUP : CALMDE ? CAL_WARMUP : ASYMDE ? ASY_WARMUP : DEF_WARMUP;
+
+				for (size_t i = 1; i < Arguments.size(); ++i)
+				{
+					if (i + 1 == Arguments.size())
+					{
+						throw TestException("BenchmarkHarness: The option " + Arguments[i] + " requires a value!");
+					}
+
+					const std::string OPTNME = Arguments[i];
+					const std::string OPTVAL = Arguments[++i];
+
+					if (OPTNME == "--format")
+					{
+						if (OPTVAL != "json" && OPTVAL != "csv")
+						{
+							throw TestException("BenchmarkHarness: The format must be json or csv!");
+						}
+
+						fmt = (OPTVAL == "csv") ? OutputFormats::Csv : OutputFormats::Json;
+					}
+					else if (OPTNME == "--output")
+					{
+						out = OPTVAL;
+					}
+					else if (OPTNME == "--filter")
+					{
+						flt = OPTVAL;
+					}
+					else if (OPTNME == "--min-size" && !ASYMDE)
+					{
+						minSze = std::stoull(OPTVAL);
+					}
+					else if (OPTNME == "--max-size" && !ASYMDE)
+					{
+						maxSze = std::stoull(OPTVAL);
+					}
+					else if (OPTNME == "--samples")
+					{
+						smpCnt = std::stoull(OPTVAL);
+					}
+					else if (OPTNME == "--warmup")
+					{
+						wrmCnt = std::stoull(OPTVAL);
+					}
+					else if (OPTNME == "--profile" && !ASYMDE)
+					{
+						prf = OPTVAL;
+						prfLod = !CALMDE;
+					}
+					else
+					{
+						throw TestException("BenchmarkHarness: Unknown option " + OPTNME);
+					}
+				}
+
+				// a profile is only applied when it is named, the primitives otherwise keep their default parallel profiles
+				if (prfLod && !Common::ParallelCalibration::Load(prf))
+				{
+					std::cerr << "BenchmarkHarness: The calibration profile could not be read!" << std::endl;
+					return 2;
+				}
+
+				BenchmarkHarness bench(fmt, out, flt, minSze, maxSze, smpCnt, wrmCnt,
+					LATMDE ? BenchmarkModes::Latency : CALMDE ? BenchmarkModes::Scaling : ASYMDE ? BenchmarkModes::Asymmetric : BenchmarkModes::Throughput);
+				TestEventHandler handler;
+
+				// progress is only printed when the results go to a file, so the console output stays a valid document
+				if (out.size() != 0)
+				{
+					bench.Progress() += &handler;
+				}
+
+				const std::string RUNMSG = bench.Run();
+
+				if (RUNMSG.find(FAILURE) == 0)
+				{
+					std::cerr << RUNMSG << std::endl;
+					return 2;
+				}
+
+				if (out.size() == 0)
+				{
+					std::cout << Serialize(bench.Results(), fmt);
+				}
+
+				if (CALMDE)
+				{
+					if (!Common::ParallelCalibration::Save(prf))
+					{
+						std::cerr << "BenchmarkHarness: The calibration profile could not be written!" << std::endl;
+						return 2;
+					}
+
+					std::cerr << "Calibration profile written to " << prf << std::endl;
+				}
+
+				return 0;
+			}
+			else if (Arguments.size() >= 3 && Arguments[0] == "compare")
+			{
+				double thrPct = 5.0;
+				std::string rpt("");
+
+				for (size_t i = 3; i < Arguments.size(); ++i)
+				{
+					if (Arguments[i] == "--threshold" && i + 1 < Arguments.size())
+					{
+						thrPct = std::stod(Arguments[++i]);
+					}
+					else
+					{
+						throw TestException("BenchmarkHarness: Unknown option " + Arguments[i]);
+					}
+				}
+
+				const size_t REGCNT = Compare(Arguments[1], Arguments[2], thrPct, rpt);
+				std::cout << rpt;
+
+				return (REGCNT != 0) ? 1 : 0;
+			}
+
+			std::cerr << "usage: benchmark [--format json|csv] [--output path] [--filter name] [--min-size bytes] [--max-size bytes] [--samples n] [--warmup n] [--profile path]" << std::endl;
+			std::cerr << "       latency [the benchmark options]" << std::endl;
+			std::cerr << "       calibrate [--profile path] [the benchmark options]" << std::endl;
+			std::cerr << "       asymmetric [--format json|csv] [--output path] [--filter name] [--samples n] [--warmup n]" << std::endl;
+			std::cerr << "       compare baseline current [--threshold percent]" << std::endl;
+		}
+		catch (TestException const &ex)
+		{
+			std::cerr << ex.Message() << std::endl;
+		}
+		catch (std::exception const &ex)
+		{
+			std::cerr << ex.what() << std::endl;
+		}
+
+		return 2;
+	}
+
+	std::vector<BenchmarkHarness::BenchmarkResult> BenchmarkHarness::Load(const std::string &Path)
+	{
+		std::ifstream ifs(Path.c_str());
+		std::vector<BenchmarkResult> ret(0);
+		std::string line;
+		bool isJson = false;
+		bool isFirst = true;
+
+		if (!ifs.is_open())
+		{
+			throw TestException("BenchmarkHarness: The result file " + Path + " could not be opened!");
+		}
+
+		while (std::getline(ifs, line))
+		{
+			if (isFirst)
+			{
+				// a JSON document starts with a brace, a CSV file with its header row
+				isJson = line.find('{') != std::string::npos;
+				isFirst = false;
+				continue;
+			}
+
+			BenchmarkResult res;
+
+			if (isJson)
+			{
+				if (line.find("\"name\"") == std::string::npos)
+				{
+					continue;
+				}
+
+				res.Name = ReadField(line, "name");
+				res.Group = ReadField(line, "group");
+				res.Size = std::stoull(ReadField(line, "size"));
+				res.Iterations = std::stoull(ReadField(line, "iterations"));
+				res.Samples = std::stoull(ReadField(line, "samples"));
+				res.CyclesMedian = std::stod(ReadField(line, "cycles_median"));
+				res.CyclesP99 = std::stod(ReadField(line, "cycles_p99"));
+				res.NsMedian = std::stod(ReadField(line, "ns_median"));
+				res.NsP99 = std::stod(ReadField(line, "ns_p99"));
+
+				// files written before the asymmetric mode have no byte count
+				if (line.find("\"bytes\"") != std::string::npos)
+				{
+					res.Bytes = std::stoull(ReadField(line, "bytes"));
+				}
+			}
+			else
+			{
+				std::vector<std::string> cols;
+				std::istringstream iss(line);
+				std::string col;
+
+				while (std::getline(iss, col, ','))
+				{
+					cols.push_back(col);
+				}
+
+				if (cols.size() < 9)
+				{
+					continue;
+				}
+
+				res.Name = cols[0];
+				res.Group = cols[1];
+				res.Size = std::stoull(cols[2]);
+				res.Iterations = std::stoull(cols[3]);
+				res.Samples = std::stoull(cols[4]);
+				res.CyclesMedian = std::stod(cols[5]);
+				res.CyclesP99 = std::stod(cols[6]);
+				res.NsMedian = std::stod(cols[7]);
+				res.NsP99 = std::stod(cols[8]);
+
+				if (cols.size() > 13)
+				{
+					res.Bytes = std::stoull(cols[13]);
+				}
+			}
+
+			ret.push_back(res);
+		}
+
+		return ret;
+	}
+
+	std::string BenchmarkHarness::Serialize(const std::vector<BenchmarkResult> &Results, OutputFormats Format)
+	{
+		std::ostringstream oss;
+
+		oss << std::fixed << std::setprecision(3);
+
+		if (Format == OutputFormats::Csv)
+		{
+			oss << "name,group,size,iterations,samples,cycles_median,cycles_p99,ns_median,ns_p99,cpb_median,cpb_p99,mbps,ops_per_sec,bytes" << std::endl;
+
+			for (size_t i = 0; i < Results.size(); ++i)
+			{
+				const BenchmarkResult &RES = Results[i];
+
+				oss << RES.Name << "," << RES.Group << "," << RES.Size << "," << RES.Iterations << "," << RES.Samples << "," <<
+					RES.CyclesMedian << "," << RES.CyclesP99 << "," << RES.NsMedian << "," << RES.NsP99 << "," <<
+					RES.CpbMedian() << "," << RES.CpbP99() << "," << RES.MBps() << "," << RES.OpsPerSecond() << "," << RES.Bytes << std::endl;
+			}
+		}
+		else
+		{
+			// one result object per line, so the file diffs cleanly and Load can read it without a JSON parser
+			oss << "{" << std::endl;
+			oss << "  \"rdtsc\": " << (SysUtils::HasRdtsc() ? "true" : "false") << "," << std::endl;
+			oss << "  \"results\": [" << std::endl;
+
+			for (size_t i = 0; i < Results.size(); ++i)
+			{
+				const BenchmarkResult &RES = Results[i];
+
+				oss << "    {\"name\": \"" << RES.Name << "\", \"group\": \"" << RES.Group << "\", \"size\": " << RES.Size <<
+					", \"iterations\": " << RES.Iterations << ", \"samples\": " << RES.Samples <<
+					", \"cycles_median\": " << RES.CyclesMedian << ", \"cycles_p99\": " << RES.CyclesP99 <<
+					", \"ns_median\": " << RES.NsMedian << ", \"ns_p99\": " << RES.NsP99 <<
+					", \"cpb_median\": " << RES.CpbMedian() << ", \"cpb_p99\": " << RES.CpbP99() << ", \"mbps\": " << RES.MBps() <<
+					", \"ops_per_sec\": " << RES.OpsPerSecond() << ", \"bytes\": " << RES.Bytes << "}" <<
+					((i + 1 != Results.size()) ? "," : "") << std::endl;
+			}
+
+			oss << "  ]" << std::endl;
+			oss << "}" << std::endl;
+		}
+
+		return oss.str();
+	}
+
+	//~~~Private Functions~~~//
+
+	void BenchmarkHarness::AddAead()
+	{
+		// the standard 14 round cipher; the AES-NI engine is selected when the processor supports it, the same engine the template entries are bound to
+		const BlockCiphers engType = BlockCiphers::Rijndael;
+		std::vector<byte> key(32, 0x11);
+
+		// the mode is finalized after every message, and the nonce is incremented for the next one
+		std::shared_ptr<Mode::IAeadMode> eax(new Mode::EAX(engType));
+		std::shared_ptr<Mode::IAeadMode> gcm(new Mode::GCM(engType));
+		std::shared_ptr<Mode::IAeadMode> ocb(new Mode::OCB(engType));
+		std::vector<std::shared_ptr<Mode::IAeadMode>> modes = { eax, gcm, ocb };
+		const std::vector<std::string> NAMES = { "AES-EAX", "AES-GCM", "AES-OCB" };
+		const std::vector<size_t> NONCES = { 16, 12, 12 };
+
+		for (size_t i = 0; i < modes.size(); ++i)
+		{
+			std::shared_ptr<Mode::IAeadMode> mode = modes[i];
+			SymmetricKey kp(key, std::vector<byte>(NONCES[i], 0x22));
+
+			mode->ParallelProfile().IsParallel() = false;
+			mode->AutoIncrement() = true;
+			mode->Initialize(true, kp);
+
+			m_entries.push_back(BenchmarkEntry(NAMES[i], "aead", [this, mode](size_t Length)
+			{
+				mode->Transform(m_input, 0, m_output, 0, Length);
+				mode->Finalize(m_output, Length, 16);
+			}));
+		}
+	}
+
+	void BenchmarkHarness::AddAsymmetric()
+	{
+		using Enumeration::MLWEParams;
+		using Enumeration::MPKCParams;
+		using Enumeration::RLWEParams;
+
+		// every parameter set; RLWEParams::Q12289N512 has the same value as Q12289N1024, and the cipher runs the N1024 engine for both
+		const std::vector<std::function<IAsymmetricCipher*()>> CPRGEN =
+		{
+			[]() -> IAsymmetricCipher* { return new Cipher::Asymmetric::MLWE::ModuleLWE(MLWEParams::Q7681N256K2); },
+			[]() -> IAsymmetricCipher* { return new Cipher::Asymmetric::MLWE::ModuleLWE(MLWEParams::Q7681N256K3); },
+			[]() -> IAsymmetricCipher* { return new Cipher::Asymmetric::MLWE::ModuleLWE(MLWEParams::Q7681N256K4); },
+			[]() -> IAsymmetricCipher* { return new Cipher::Asymmetric::RLWE::RingLWE(RLWEParams::Q12289N1024, Enumeration::Prngs::BCR, false); },
+			[]() -> IAsymmetricCipher* { return new Cipher::Asymmetric::RLWE::RingLWE(RLWEParams::Q12289N1024, Enumeration::Prngs::BCR, true); },
+			[]() -> IAsymmetricCipher* { return new Cipher::Asymmetric::MPKC::McEliece(MPKCParams::M12T62); }
+		};
+		const std::vector<std::string> SUFFIX = { "", "", "", "", "-Parallel", "" };
+
+		for (size_t i = 0; i < CPRGEN.size(); ++i)
+		{
+			std::shared_ptr<IAsymmetricCipher> gen(CPRGEN[i]());
+			std::shared_ptr<IAsymmetricCipher> enc(CPRGEN[i]());
+			std::shared_ptr<IAsymmetricCipher> dec(CPRGEN[i]());
+			std::shared_ptr<std::vector<byte>> cpt(new std::vector<byte>(0));
+			std::shared_ptr<std::vector<byte>> sec(new std::vector<byte>(0));
+			const std::string CPRNME = gen->Name() + SUFFIX[i];
+
+			if (!Contains(CPRNME, m_filter))
+			{
+				continue;
+			}
+
+			IAsymmetricKeyPair* kp = gen->Generate();
+			// the ciphers release the keys when they are destroyed; the keys are owned by the entries that use them
+			std::shared_ptr<IAsymmetricKey> pubk(kp->PublicKey());
+			std::shared_ptr<IAsymmetricKey> prik(kp->PrivateKey());
+			const size_t KEYSZE = pubk->ToBytes().size() + prik->ToBytes().size();
+
+			delete kp;
+			enc->Initialize(true, pubk.get());
+			dec->Initialize(false, prik.get());
+			enc->Encapsulate(*cpt, *sec);
+
+			m_entries.push_back(BenchmarkEntry(CPRNME + "/generate", "asymmetric", [gen](size_t)
+			{
+				IAsymmetricKeyPair* tkp = gen->Generate();
+
+				delete tkp->PublicKey();
+				delete tkp->PrivateKey();
+				delete tkp;
+			}, KEYSZE));
+
+			m_entries.push_back(BenchmarkEntry(CPRNME + "/encapsulate", "asymmetric", [enc, pubk](size_t)
+			{
+				std::vector<byte> tcpt(0);
+				std::vector<byte> tsec(0);
+
+				enc->Encapsulate(tcpt, tsec);
+			}, cpt->size()));
+
+			m_entries.push_back(BenchmarkEntry(CPRNME + "/decapsulate", "asymmetric", [dec, prik, cpt](size_t)
+			{
+				std::vector<byte> tsec(0);
+
+				dec->Decapsulate(*cpt, tsec);
+			}, cpt->size()));
+		}
+	}
+
+	void BenchmarkHarness::AddCiphers()
+	{
+		std::vector<byte> key(32, 0x11);
+		std::vector<byte> iv(16, 0x22);
+		std::vector<byte> nonce(8, 0x22);
+		SymmetricKey kp(key, iv);
+		SymmetricKey skp(key, nonce);
+		// AES is the standard 14 round Rijndael, on the AES-NI engine when the processor supports it, as in the AES-CTR-Template entry
+		const std::vector<BlockCiphers> engTypes = { BlockCiphers::Rijndael, BlockCiphers::SHX, BlockCiphers::THX };
+		const std::vector<std::string> NAMES = { "AES-CTR", "Serpent-CTR", "Twofish-CTR" };
+
+		for (size_t i = 0; i < engTypes.size(); ++i)
+		{
+			std::shared_ptr<Mode::ICipherMode> mode(new Mode::CTR(engTypes[i]));
+
+			// the sweep measures a single core, the thread scaling is not part of the per-byte cost
+			mode->ParallelProfile().IsParallel() = false;
+			mode->Initialize(true, kp);
+
+			m_entries.push_back(BenchmarkEntry(NAMES[i], "cipher", [this, mode](size_t Length)
+			{
+				mode->Transform(m_input, 0, m_output, 0, Length);
+			}));
+		}
+
+		std::shared_ptr<IStreamCipher> chacha(new ChaCha20());
+		std::shared_ptr<IStreamCipher> salsa(new Salsa20());
+		std::vector<std::shared_ptr<IStreamCipher>> ciphers = { chacha, salsa };
+
+		for (size_t i = 0; i < ciphers.size(); ++i)
+		{
+			std::shared_ptr<IStreamCipher> cipher = ciphers[i];
+
+			cipher->ParallelProfile().IsParallel() = false;
+			cipher->Initialize(skp);
+
+			m_entries.push_back(BenchmarkEntry(cipher->Name(), "cipher", [this, cipher](size_t Length)
+			{
+				cipher->Transform(m_input, 0, m_output, 0, Length);
+			}));
+		}
+
+		// the Twofish block function alone, one block at a time against sixteen blocks through the widest compiled S-box gather path
+		std::shared_ptr<THX> twofish(new THX());
+		twofish->Initialize(true, kp);
+
+		m_entries.push_back(BenchmarkEntry("Twofish-Block-Scalar", "cipher", [this, twofish](size_t Length)
+		{
+			const size_t BLKLEN = Length - (Length % 256);
+
+			for (size_t i = 0; i < BLKLEN; i += 16)
+			{
+				twofish->EncryptBlock(m_input, i, m_output, i);
+			}
+		}));
+
+		m_entries.push_back(BenchmarkEntry("Twofish-Block-Wide", "cipher", [this, twofish](size_t Length)
+		{
+			const size_t BLKLEN = Length - (Length % 256);
+
+			for (size_t i = 0; i < BLKLEN; i += 256)
+			{
+				twofish->Transform2048(m_input, i, m_output, i);
+			}
+		}));
+	}
+
+	void BenchmarkHarness::AddComposed()
+	{
+#if defined(__AVX__)
+		Common::CpuDetect detect;
+
+		if (detect.AESNI())
+		{
+			AddComposedModes<AHX>();
+		}
+		else
+		{
+			AddComposedModes<RHX>();
+		}
+#else
+		AddComposedModes<RHX>();
+#endif
+	}
+
+	template<typename T>
+	void BenchmarkHarness::AddComposedModes()
+	{
+		// the same modes and the same standard 14 round cipher as the AES-CTR, AES-GCM and AES-OCB entries, with the engine bound at compile time;
+		// the difference at the smallest sizes is the per-call saving, and at the largest the per-byte saving
+		std::vector<byte> key(32, 0x11);
+		SymmetricKey ckp(key, std::vector<byte>(16, 0x22));
+		SymmetricKey akp(key, std::vector<byte>(12, 0x22));
+
+		std::shared_ptr<T> ctrEng(new T());
+		std::shared_ptr<Mode::CTRT<T>> ctr(new Mode::CTRT<T>(ctrEng.get()));
+		ctr->ParallelProfile().IsParallel() = false;
+		ctr->Initialize(true, ckp);
+
+		m_entries.push_back(BenchmarkEntry("AES-CTR-Template", "cipher", [this, ctrEng, ctr](size_t Length)
+		{
+			ctr->Transform(m_input, 0, m_output, 0, Length);
+		}));
+
+		std::shared_ptr<T> gcmEng(new T());
+		std::shared_ptr<Mode::GCMT<T>> gcm(new Mode::GCMT<T>(gcmEng.get()));
+		gcm->ParallelProfile().IsParallel() = false;
+		gcm->AutoIncrement() = true;
+		gcm->Initialize(true, akp);
+
+		m_entries.push_back(BenchmarkEntry("AES-GCM-Template", "aead", [this, gcmEng, gcm](size_t Length)
+		{
+			gcm->Transform(m_input, 0, m_output, 0, Length);
+			gcm->Finalize(m_output, Length, 16);
+		}));
+
+		std::shared_ptr<T> ocbEng(new T());
+		std::shared_ptr<T> ocbHash(new T());
+		std::shared_ptr<Mode::OCBT<T>> ocb(new Mode::OCBT<T>(ocbEng.get(), ocbHash.get()));
+		ocb->ParallelProfile().IsParallel() = false;
+		ocb->AutoIncrement() = true;
+		ocb->Initialize(true, akp);
+
+		m_entries.push_back(BenchmarkEntry("AES-OCB-Template", "aead", [this, ocbEng, ocbHash, ocb](size_t Length)
+		{
+			ocb->Transform(m_input, 0, m_output, 0, Length);
+			ocb->Finalize(m_output, Length, 16);
+		}));
+	}
+
+	void BenchmarkHarness::AddDigests()
+	{
+		const std::vector<Digests> DGTTPS =
+		{
+			Digests::Blake256, Digests::Blake512, Digests::Blake3, Digests::KangarooTwelve, Digests::Keccak256, Digests::Keccak512,
+			Digests::ParallelHash128, Digests::SHA256, Digests::SHA512, Digests::Skein256, Digests::Skein512
+		};
+		// fixed names, the result files are matched on them across library versions
+		const std::vector<std::string> NAMES =
+		{
+			"Blake256", "Blake512", "Blake3", "KangarooTwelve", "Keccak256", "Keccak512",
+			"ParallelHash128", "SHA256", "SHA512", "Skein256", "Skein512"
+		};
+
+		for (size_t i = 0; i < DGTTPS.size(); ++i)
+		{
+			std::shared_ptr<IDigest> dgt(Helper::DigestFromName::GetInstance(DGTTPS[i], false));
+
+			m_entries.push_back(BenchmarkEntry(NAMES[i], "digest", [this, dgt](size_t Length)
+			{
+				dgt->Update(m_input, 0, Length);
+				dgt->Finalize(m_output, 0);
+			}));
+		}
+	}
+
+	void BenchmarkHarness::AddParallel()
+	{
+		std::vector<byte> key(32, 0x11);
+		std::vector<byte> iv(16, 0x22);
+		std::vector<byte> nonce(8, 0x22);
+		SymmetricKey kp(key, iv);
+		SymmetricKey skp(key, nonce);
+		BlockCiphers aesType = BlockCiphers::RHX;
+
+#if defined(__AVX__)
+		Common::CpuDetect detect;
+
+		if (detect.AESNI())
+		{
+			aesType = BlockCiphers::AHX;
+		}
+#endif
+
+		// the modes with a multi-threaded transform; cbc is parallel in the decryption direction only
+		std::vector<std::shared_ptr<Mode::ICipherMode>> modes =
+		{
+			std::shared_ptr<Mode::ICipherMode>(new Mode::CTR(aesType)),
+			std::shared_ptr<Mode::ICipherMode>(new Mode::CTR(BlockCiphers::SHX)),
+			std::shared_ptr<Mode::ICipherMode>(new Mode::CTR(BlockCiphers::THX)),
+			std::shared_ptr<Mode::ICipherMode>(new Mode::ICM(aesType)),
+			std::shared_ptr<Mode::ICipherMode>(new Mode::ECB(aesType)),
+			std::shared_ptr<Mode::ICipherMode>(new Mode::CBC(aesType))
+		};
+
+		for (size_t i = 0; i < modes.size(); ++i)
+		{
+			std::shared_ptr<Mode::ICipherMode> mode = modes[i];
+			// the name is read before the key is set, as the primitive reads its profile entry in the constructor
+			const std::string PRMNME = mode->Name();
+
+			mode->Initialize(mode->Enumeral() != Enumeration::CipherModes::CBC, kp);
+
+			m_scaling.push_back(ScalingEntry(PRMNME,
+				[mode]() -> Common::ParallelOptions& { return mode->ParallelProfile(); },
+				[mode](size_t Degree) { mode->ParallelMaxDegree(Degree); },
+				[this, mode](size_t Length) { mode->Transform(m_input, 0, m_output, 0, Length); }));
+		}
+
+		std::vector<std::shared_ptr<IStreamCipher>> ciphers = { std::shared_ptr<IStreamCipher>(new ChaCha20()), std::shared_ptr<IStreamCipher>(new Salsa20()) };
+
+		for (size_t i = 0; i < ciphers.size(); ++i)
+		{
+			std::shared_ptr<IStreamCipher> cipher = ciphers[i];
+			const std::string PRMNME = cipher->Name();
+
+			cipher->Initialize(skp);
+
+			m_scaling.push_back(ScalingEntry(PRMNME,
+				[cipher]() -> Common::ParallelOptions& { return cipher->ParallelProfile(); },
+				[cipher](size_t Degree) { cipher->ParallelMaxDegree(Degree); },
+				[this, cipher](size_t Length) { cipher->Transform(m_input, 0, m_output, 0, Length); }));
+		}
+	}
+
+	void BenchmarkHarness::AddMacs()
+	{
+		std::vector<byte> key(32, 0x11);
+		std::shared_ptr<SymmetricKey> kp(new SymmetricKey(key));
+		std::shared_ptr<IMac> cmac(new Mac::CMAC(BlockCiphers::RHX));
+		std::shared_ptr<IMac> hmac256(new Mac::HMAC(Digests::SHA256));
+		std::shared_ptr<IMac> hmac512(new Mac::HMAC(Digests::SHA512));
+		std::shared_ptr<IMac> kmac128(new Mac::KMAC(Enumeration::ShakeModes::SHAKE128));
+		std::shared_ptr<IMac> kmac256(new Mac::KMAC(Enumeration::ShakeModes::SHAKE256));
+		std::shared_ptr<IMac> poly(new Mac::Poly1305());
+		std::vector<std::shared_ptr<IMac>> macs = { cmac, hmac256, hmac512, kmac128, kmac256, poly };
+		const std::vector<std::string> NAMES = { "CMAC-AES", "HMAC-SHA256", "HMAC-SHA512", "KMAC128", "KMAC256", "Poly1305" };
+
+		for (size_t i = 0; i < macs.size(); ++i)
+		{
+			std::shared_ptr<IMac> mac = macs[i];
+			std::shared_ptr<std::vector<byte>> code(new std::vector<byte>(mac->MacSize()));
+			// kmac squeezes the whole output array and must be keyed again after finalization, poly1305 takes a one-time key per message
+			const bool REKEY = (mac->Enumeral() == Macs::KMAC || mac->Enumeral() == Macs::Poly1305);
+
+			mac->Initialize(*kp);
+
+			m_entries.push_back(BenchmarkEntry(NAMES[i], "mac", [this, mac, code, kp, REKEY](size_t Length)
+			{
+				if (REKEY)
+				{
+					mac->Initialize(*kp);
+				}
+
+				mac->Update(m_input, 0, Length);
+				mac->Finalize(*code, 0);
+			}));
+		}
+	}
+
+	void BenchmarkHarness::Calibrate(const ScalingEntry &Entry)
+	{
+		Common::ParallelOptions &prf = Entry.Profile();
+		const size_t PRCCNT = prf.ProcessorCount() - (prf.ProcessorCount() % 2);
+		const BenchmarkEntry OPRENT(Entry.Name, "parallel", Entry.Operation);
+		std::map<size_t, double> seqNsc;
+		std::vector<size_t> dgrList;
+		double bstSpd = 0.0;
+		size_t bstDgr = 0;
+		size_t bstThr = 0;
+
+		OnProgress(std::string("***") + Entry.Name + std::string("***"));
+
+		if (PRCCNT < 2)
+		{
+			OnProgress(std::string("  A single processor core is available, the parallel profile is not calibrated"));
+			return;
+		}
+
+		// thread counts double from 2, and the processor count is always measured
+		for (size_t dgr = 2; dgr < PRCCNT; dgr *= 2)
+		{
+			dgrList.push_back(dgr);
+		}
+
+		dgrList.push_back(PRCCNT);
+
+		for (size_t i = 0; i < dgrList.size(); ++i)
+		{
+			size_t maxLen = 0;
+			double spd = 0.0;
+			size_t thr = 0;
+
+			Entry.Degree(dgrList[i]);
+
+			// sizes double from the smallest valid parallel block, so every size is aligned to it
+			for (size_t len = prf.ParallelMinimumSize(); len <= m_maxSize; len *= 2)
+			{
+				if (seqNsc.find(len) == seqNsc.end())
+				{
+					prf.IsParallel() = false;
+					BenchmarkResult seq = Measure(OPRENT, len);
+					seq.Name = Entry.Name + "/1";
+					seqNsc[len] = seq.NsMedian;
+					m_results.push_back(seq);
+				}
+
+				prf.IsParallel() = true;
+				prf.ParallelBlockSize() = len;
+				BenchmarkResult res = Measure(OPRENT, len);
+				res.Name = Entry.Name + "/" + std::to_string(dgrList[i]);
+				m_results.push_back(res);
+
+				if (thr == 0 && res.NsMedian * 100.0 < seqNsc[len] * (100 - CAL_MARGIN))
+				{
+					thr = len;
+				}
+
+				spd = (res.NsMedian != 0.0) ? seqNsc[len] / res.NsMedian : 0.0;
+				maxLen = len;
+			}
+
+			std::ostringstream line;
+			line << std::setw(4) << dgrList[i] << " threads: " << std::fixed << std::setprecision(2) << spd << "x the sequential speed at " << maxLen << " bytes, ";
+
+			if (thr != 0)
+			{
+				line << "parallel is faster from " << thr << " bytes";
+			}
+			else
+			{
+				line << "parallel is not faster at any measured size";
+			}
+
+			OnProgress(line.str());
+
+			// the thread count with the best speed-up on the largest message is retained, with its own threshold
+			if (spd > bstSpd)
+			{
+				bstSpd = spd;
+				bstDgr = dgrList[i];
+				bstThr = thr;
+			}
+		}
+
+		Common::ParallelCalibration::Store(Entry.Name, bstThr, bstDgr);
+		OnProgress(std::string("  Calibrated: threshold ") + std::to_string(bstThr) + std::string(" bytes, ") + std::to_string(bstDgr) + std::string(" threads"));
+	}
+
+	bool BenchmarkHarness::Contains(const std::string &Text, const std::string &Filter)
+	{
+		std::string txt(Text);
+		std::string flt(Filter);
+
+		std::transform(txt.begin(), txt.end(), txt.begin(), ::tolower);
+		std::transform(flt.begin(), flt.end(), flt.begin(), ::tolower);
+
+		return txt.find(flt) != std::string::npos;
+	}
+
+	void BenchmarkHarness::Initialize()
+	{
+		m_hasRdtsc = SysUtils::HasRdtsc();
+		m_entries.clear();
+		// a tag or digest is written after the message, so the output has room for the largest of them
+		m_input.resize(m_maxSize);
+		m_output.resize(m_maxSize + 128);
+		TestUtils::GetRandom(m_input);
+
+		if (m_mode == BenchmarkModes::Scaling)
+		{
+			// the table is emptied first, so the primitives under test start from the cache-size estimate rather than an earlier profile
+			Common::ParallelCalibration::Clear();
+			m_scaling.clear();
+			AddParallel();
+		}
+		else if (m_mode == BenchmarkModes::Asymmetric)
+		{
+			AddAsymmetric();
+		}
+		else
+		{
+			AddCiphers();
+			AddAead();
+			AddComposed();
+			AddDigests();
+			AddMacs();
+		}
+	}
+
+	BenchmarkHarness::BenchmarkResult BenchmarkHarness::Measure(const BenchmarkEntry &Entry, size_t Length)
+	{
+		std::vector<double> cycles(m_samples);
+		std::vector<double> nsecs(m_samples);
+		BenchmarkResult res;
+
+		// one call is timed to size the samples, so the timer resolution is small against the sample duration
+		Entry.Operation(Length);
+		const std::chrono::steady_clock::time_point CALSTR = std::chrono::steady_clock::now();
+		Entry.Operation(Length);
+		const double CALNSC = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - CALSTR).count();
+		const size_t ITRCNT = (CALNSC >= SAMPLE_TIME) ? 1 : static_cast<size_t>(SAMPLE_TIME / ((CALNSC < 1.0) ? 1.0 : CALNSC));
+
+		// the warmup brings the code and tables into cache, and lets the core reach its working frequency
+		for (size_t i = 0; i < m_warmup; ++i)
+		{
+			for (size_t j = 0; j < ITRCNT; ++j)
+			{
+				Entry.Operation(Length);
+			}
+		}
+
+		for (size_t i = 0; i < m_samples; ++i)
+		{
+			const std::chrono::steady_clock::time_point WLLSTR = std::chrono::steady_clock::now();
+			const ulong CYCSTR = m_hasRdtsc ? SysUtils::CycleCount() : 0;
+
+			for (size_t j = 0; j < ITRCNT; ++j)
+			{
+				Entry.Operation(Length);
+			}
+
+			const ulong CYCEND = m_hasRdtsc ? SysUtils::CycleCount() : 0;
+			const std::chrono::steady_clock::time_point WLLEND = std::chrono::steady_clock::now();
+
+			cycles[i] = static_cast<double>(CYCEND - CYCSTR) / ITRCNT;
+			nsecs[i] = std::chrono::duration<double, std::nano>(WLLEND - WLLSTR).count() / ITRCNT;
+		}
+
+		res.Name = Entry.Name;
+		res.Group = Entry.Group;
+		res.Size = Length;
+		res.Iterations = ITRCNT;
+		res.Samples = m_samples;
+		res.CyclesMedian = Percentile(cycles, 0.5);
+		res.CyclesP99 = Percentile(cycles, 0.99);
+		res.NsMedian = Percentile(nsecs, 0.5);
+		res.NsP99 = Percentile(nsecs, 0.99);
+
+		return res;
+	}
+
+	BenchmarkHarness::BenchmarkResult BenchmarkHarness::MeasureAsymmetric(const BenchmarkEntry &Entry, std::vector<BenchmarkResult> &Phases)
+	{
+		// the InstrumentPhases values, from MatrixExpansion to Hashing
+		const size_t PHSCNT = 5;
+		std::vector<std::vector<double>> phsCycles(PHSCNT, std::vector<double>(m_samples, 0.0));
+		std::vector<double> cycles(m_samples);
+		std::vector<double> nsecs(m_samples);
+		BenchmarkResult res;
+
+		for (size_t i = 0; i < m_warmup; ++i)
+		{
+			Entry.Operation(0);
+		}
+
+		for (size_t i = 0; i < m_samples; ++i)
+		{
+			Common::Instrumentation::Reset();
+
+			const std::chrono::steady_clock::time_point WLLSTR = std::chrono::steady_clock::now();
+			const ulong CYCSTR = m_hasRdtsc ? SysUtils::CycleCount() : 0;
+
+			Entry.Operation(0);
+
+			const ulong CYCEND = m_hasRdtsc ? SysUtils::CycleCount() : 0;
+			const std::chrono::steady_clock::time_point WLLEND = std::chrono::steady_clock::now();
+
+			cycles[i] = static_cast<double>(CYCEND - CYCSTR);
+			nsecs[i] = std::chrono::duration<double, std::nano>(WLLEND - WLLSTR).count();
+			std::vector<Common::Instrumentation::SiteRecord> recs = Common::Instrumentation::Snapshot();
+
+			// a phase is marked in several functions of the engines; its cost is the sum of their sites
+			for (size_t j = 0; j < PHSCNT; ++j)
+			{
+				const std::string PHSNME = Common::Instrumentation::PhaseName(static_cast<Enumeration::InstrumentPhases>(j));
+
+				for (size_t k = 0; k < recs.size(); ++k)
+				{
+					if (recs[k].Group == Enumeration::InstrumentGroups::Phase && recs[k].Name == PHSNME)
+					{
+						phsCycles[j][i] += static_cast<double>(recs[k].Cycles);
+					}
+				}
+			}
+		}
+
+		res.Name = Entry.Name;
+		res.Group = Entry.Group;
+		res.Iterations = 1;
+		res.Samples = m_samples;
+		res.CyclesMedian = Percentile(cycles, 0.5);
+		res.CyclesP99 = Percentile(cycles, 0.99);
+		res.NsMedian = Percentile(nsecs, 0.5);
+		res.NsP99 = Percentile(nsecs, 0.99);
+		res.Bytes = Entry.Bytes;
+		Phases.clear();
+
+		// the phases are only reported by a library built with the counters, and a phase the operation never entered is left out
+		if (Common::Instrumentation::Enabled())
+		{
+			for (size_t i = 0; i < PHSCNT; ++i)
+			{
+				BenchmarkResult phs;
+
+				phs.Name = Entry.Name + "/" + Common::Instrumentation::PhaseName(static_cast<Enumeration::InstrumentPhases>(i));
+				phs.Group = "phase";
+				phs.Iterations = 1;
+				phs.Samples = m_samples;
+				phs.CyclesMedian = Percentile(phsCycles[i], 0.5);
+				phs.CyclesP99 = Percentile(phsCycles[i], 0.99);
+
+				if (phs.CyclesP99 != 0.0)
+				{
+					Phases.push_back(phs);
+				}
+			}
+		}
+
+		return res;
+	}
+
+	BenchmarkHarness::BenchmarkResult BenchmarkHarness::MeasureLatency(const BenchmarkEntry &Entry, size_t Length)
+	{
+		std::vector<double> cycles(m_samples);
+		std::vector<double> nsecs(m_samples);
+		BenchmarkResult res;
+
+		for (size_t i = 0; i < m_warmup; ++i)
+		{
+			Entry.Operation(Length);
+		}
+
+		// every message is timed on its own, so a slow setup path shows in the tail rather than being averaged away
+		for (size_t i = 0; i < m_samples; ++i)
+		{
+			const std::chrono::steady_clock::time_point WLLSTR = std::chrono::steady_clock::now();
+			const ulong CYCSTR = m_hasRdtsc ? SysUtils::CycleCount() : 0;
+
+			Entry.Operation(Length);
+
+			const ulong CYCEND = m_hasRdtsc ? SysUtils::CycleCount() : 0;
+			const std::chrono::steady_clock::time_point WLLEND = std::chrono::steady_clock::now();
+
+			cycles[i] = static_cast<double>(CYCEND - CYCSTR);
+			nsecs[i] = std::chrono::duration<double, std::nano>(WLLEND - WLLSTR).count();
+		}
+
+		res.Name = Entry.Name;
+		res.Group = Entry.Group;
+		res.Size = Length;
+		res.Iterations = 1;
+		res.Samples = m_samples;
+		res.CyclesMedian = Percentile(cycles, 0.5);
+		res.CyclesP99 = Percentile(cycles, 0.99);
+		res.NsMedian = Percentile(nsecs, 0.5);
+		res.NsP99 = Percentile(nsecs, 0.99);
+
+		return res;
+	}
+
+	void BenchmarkHarness::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	double BenchmarkHarness::Percentile(std::vector<double> &Values, double Rank)
+	{
+		// nearest rank; with fewer than 100 samples the 99th percentile is the slowest sample
+		const size_t RNKIDX = static_cast<size_t>(std::ceil(Rank * Values.size()));
+
+		std::sort(Values.begin(), Values.end());
+
+		return Values[(RNKIDX == 0) ? 0 : RNKIDX - 1];
+	}
+
+	std::string BenchmarkHarness::ReadField(const std::string &Line, const std::string &Key)
+	{
+		const std::string FLDKEY = "\"" + Key + "\":";
+		size_t pos = Line.find(FLDKEY);
+
+		if (pos == std::string::npos)
+		{
+			throw TestException("BenchmarkHarness: The result field " + Key + " is missing!");
+		}
+
+		pos += FLDKEY.size();
+
+		while (pos < Line.size() && Line[pos] == ' ')
+		{
+			++pos;
+		}
+
+		if (pos < Line.size() && Line[pos] == '"')
+		{
+			return Line.substr(pos + 1, Line.find('"', pos + 1) - (pos + 1));
+		}
+
+		return Line.substr(pos, Line.find_first_of(",}", pos) - pos);
+	}
+}
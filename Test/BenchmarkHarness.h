@@ -0,0 +1,332 @@
+#ifndef CEXTEST_BENCHMARKHARNESS_H
+#define CEXTEST_BENCHMARKHARNESS_H
+
+#include "ITest.h"
+#include "../CEX/ParallelOptions.h"
+#include <functional>
+#include <memory>
+
+namespace Test
+{
+	/// <summary>
+	/// A non-interactive benchmark harness for regression tracking.
+	/// <para>Each primitive is measured over a sweep of message sizes from 16 bytes to 64 MB.
+	/// Every size is warmed up, then timed over several samples; the reported values are the median and 99th percentile
+	/// of the per-operation cost in RDTSC cycles and in wall-clock nanoseconds, with cycles per byte and MB per second derived from them.
+	/// Results are written as JSON or CSV, and two result files can be compared to flag regressions.</para>
+	/// <para>The latency mode times every AEAD encrypt and tag, and every MAC, as a single message from 16 bytes to 4 KB,
+	/// so the percentiles describe the per-packet cost rather than the average of a batch.</para>
+	/// <para>The calibrate mode measures the multi-threaded cipher modes and stream ciphers sequentially and at each thread count, over sizes from the
+	/// parallel minimum to 4 MB. The smallest size at which the parallel transform is clearly faster, and the thread count with the best throughput,
+	/// are written to a ParallelCalibration profile; an application applies it with ParallelCalibration::Load, and the benchmark and latency modes load it with the --profile option.</para>
+	/// <para>The asymmetric mode times key generation, encapsulation and decapsulation one operation at a time, for every ModuleLWE, RingLWE and McEliece parameter set,
+	/// and RingLWE with and without its parallel flag. Each operation reports its latency percentiles, operations per second, and the size of its keys or ciphertext.
+	/// When the library is built with CEX_INSTRUMENTATION, the cycles spent in matrix expansion, the NTT, noise sampling, packing and hashing are added as one result per phase.</para>
+	/// </summary>
+	///
+	/// <example>
+	/// <description>Command line usage, through the test executable:</description>
+	/// <code>
+	/// Test benchmark --format json --output current.json --filter AES --max-size 1048576
+	/// Test latency --format csv --output latency.csv
+	/// Test calibrate --profile cex-parallel.cfg --output scaling.json
+	/// Test asymmetric --format csv --output pqc.csv --filter ModuleLWE
+	/// Test compare baseline.json current.json --threshold 5
+	/// </code>
+	/// </example>
+	class BenchmarkHarness final : public ITest
+	{
+	public:
+
+		/// <summary>
+		/// The measurement modes
+		/// </summary>
+		enum class BenchmarkModes : byte
+		{
+			/// <summary>
+			/// Batches of operations are timed, and the per-operation cost is the batch average
+			/// </summary>
+			Throughput = 0,
+			/// <summary>
+			/// Every AEAD and MAC operation is timed on its own, each sample is one message
+			/// </summary>
+			Latency = 1,
+			/// <summary>
+			/// The parallel primitives are timed sequentially and at each thread count, and the parallel thresholds are calibrated
+			/// </summary>
+			Scaling = 2,
+			/// <summary>
+			/// Every asymmetric key generation, encapsulation and decapsulation is timed on its own
+			/// </summary>
+			Asymmetric = 3
+		};
+
+		/// <summary>
+		/// The result file formats
+		/// </summary>
+		enum class OutputFormats : byte
+		{
+			/// <summary>
+			/// Comma separated values, one row per primitive and size
+			/// </summary>
+			Csv = 0,
+			/// <summary>
+			/// A JSON document, with one result object per line
+			/// </summary>
+			Json = 1
+		};
+
+		/// <summary>
+		/// The measurements for one primitive and message size
+		/// </summary>
+		struct BenchmarkResult
+		{
+			/// <summary>
+			/// The primitive name; in the calibrate mode the name is followed by /threads, in the asymmetric mode by /operation, and /operation/phase for a phase
+			/// </summary>
+			std::string Name;
+			/// <summary>
+			/// The primitive family; cipher, aead, digest, mac, parallel, asymmetric, or phase
+			/// </summary>
+			std::string Group;
+			/// <summary>
+			/// The message size in bytes; zero for operations that are not measured per byte
+			/// </summary>
+			size_t Size;
+			/// <summary>
+			/// The number of operations timed in each sample; one in the latency mode
+			/// </summary>
+			size_t Iterations;
+			/// <summary>
+			/// The number of timed samples
+			/// </summary>
+			size_t Samples;
+			/// <summary>
+			/// The median cost of one operation in cycles
+			/// </summary>
+			double CyclesMedian;
+			/// <summary>
+			/// The 99th percentile cost of one operation in cycles
+			/// </summary>
+			double CyclesP99;
+			/// <summary>
+			/// The median cost of one operation in nanoseconds
+			/// </summary>
+			double NsMedian;
+			/// <summary>
+			/// The 99th percentile cost of one operation in nanoseconds
+			/// </summary>
+			double NsP99;
+			/// <summary>
+			/// The key or ciphertext bytes of an asymmetric operation; the public and private key sizes for key generation, the ciphertext size otherwise
+			/// </summary>
+			size_t Bytes;
+
+			BenchmarkResult();
+
+			/// <summary>
+			/// The median cost in cycles per byte
+			/// </summary>
+			double CpbMedian() const;
+
+			/// <summary>
+			/// The 99th percentile cost in cycles per byte
+			/// </summary>
+			double CpbP99() const;
+
+			/// <summary>
+			/// The median throughput in MB (10^6 bytes) per second
+			/// </summary>
+			double MBps() const;
+
+			/// <summary>
+			/// The median rate in operations per second
+			/// </summary>
+			double OpsPerSecond() const;
+		};
+
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string MESSAGE;
+		static const size_t DEF_MAXSIZE = 64 * 1024 * 1024;
+		static const size_t DEF_MINSIZE = 16;
+		static const size_t DEF_SAMPLES = 11;
+		static const size_t DEF_WARMUP = 2;
+		static const size_t LAT_MAXSIZE = 4096;
+		static const size_t LAT_SAMPLES = 10000;
+		static const size_t LAT_WARMUP = 1000;
+		static const size_t CAL_MAXSIZE = 4 * 1024 * 1024;
+		// the parallel transform must be this many percent faster than the sequential transform to set the threshold
+		static const size_t CAL_MARGIN = 10;
+		static const size_t CAL_SAMPLES = 5;
+		static const size_t CAL_WARMUP = 1;
+		static const size_t ASY_SAMPLES = 100;
+		static const size_t ASY_WARMUP = 2;
+		// the target duration of one sample in nanoseconds; fast operations are repeated to reach it
+		static const size_t SAMPLE_TIME = 10000000;
+
+		struct BenchmarkEntry
+		{
+			std::string Name;
+			std::string Group;
+			std::function<void(size_t)> Operation;
+			size_t Bytes;
+
+			BenchmarkEntry(const std::string &EntryName, const std::string &EntryGroup, std::function<void(size_t)> EntryOperation, size_t EntryBytes = 0)
+				:
+				Name(EntryName),
+				Group(EntryGroup),
+				Operation(EntryOperation),
+				Bytes(EntryBytes)
+			{
+			}
+		};
+
+		struct ScalingEntry
+		{
+			std::string Name;
+			std::function<Common::ParallelOptions&()> Profile;
+			std::function<void(size_t)> Degree;
+			std::function<void(size_t)> Operation;
+
+			ScalingEntry(const std::string &EntryName, std::function<Common::ParallelOptions&()> EntryProfile, std::function<void(size_t)> EntryDegree, std::function<void(size_t)> EntryOperation)
+				:
+				Name(EntryName),
+				Profile(EntryProfile),
+				Degree(EntryDegree),
+				Operation(EntryOperation)
+			{
+			}
+		};
+
+		std::vector<BenchmarkEntry> m_entries;
+		std::string m_filter;
+		OutputFormats m_format;
+		bool m_hasRdtsc;
+		std::vector<byte> m_input;
+		size_t m_maxSize;
+		size_t m_minSize;
+		BenchmarkModes m_mode;
+		std::vector<byte> m_output;
+		std::string m_outputPath;
+		TestEventHandler m_progressEvent;
+		std::vector<BenchmarkResult> m_results;
+		size_t m_samples;
+		std::vector<ScalingEntry> m_scaling;
+		size_t m_warmup;
+
+	public:
+
+		/// <summary>
+		/// Initialize this class
+		/// </summary>
+		///
+		/// <param name="Format">The result file format</param>
+		/// <param name="OutputPath">The result file path; an empty path writes the results to the console</param>
+		/// <param name="Filter">Only primitives whose name contains this string are measured; case insensitive, empty measures all</param>
+		/// <param name="MinSize">The smallest message size in the sweep</param>
+		/// <param name="MaxSize">The largest message size in the sweep</param>
+		/// <param name="Samples">The number of timed samples per size</param>
+		/// <param name="Warmup">The number of untimed samples run before timing each size</param>
+		/// <param name="Mode">The measurement mode; the latency mode measures only the AEAD modes and MACs, the scaling mode only the parallel ciphers,
+		/// and the asymmetric mode only the asymmetric ciphers, without a size sweep</param>
+		BenchmarkHarness(OutputFormats Format = OutputFormats::Json, const std::string &OutputPath = "", const std::string &Filter = "",
+			size_t MinSize = DEF_MINSIZE, size_t MaxSize = DEF_MAXSIZE, size_t Samples = DEF_SAMPLES, size_t Warmup = DEF_WARMUP, BenchmarkModes Mode = BenchmarkModes::Throughput);
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~BenchmarkHarness();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Get: The results of the last run
+		/// </summary>
+		const std::vector<BenchmarkResult> &Results();
+
+		/// <summary>
+		/// Run the size sweep for every selected primitive, and write the result file
+		/// </summary>
+		std::string Run() override;
+
+		/// <summary>
+		/// Compare two result files, and report the entries of the current file that are slower than the baseline.
+		/// <para>Entries are matched by name and size; cycles per operation are compared when both files have cycle counts, otherwise nanoseconds.</para>
+		/// </summary>
+		///
+		/// <param name="BaselinePath">The baseline result file, JSON or CSV</param>
+		/// <param name="CurrentPath">The current result file, JSON or CSV</param>
+		/// <param name="Threshold">The slowdown in percent above which an entry is flagged</param>
+		/// <param name="Report">Receives a line for each matched entry</param>
+		///
+		/// <returns>The number of regressions</returns>
+		static size_t Compare(const std::string &BaselinePath, const std::string &CurrentPath, double Threshold, std::string &Report);
+
+		/// <summary>
+		/// The command line entry point; parses the arguments, and runs the benchmark or compare command.
+		/// <para>benchmark [--format json|csv] [--output path] [--filter name] [--min-size bytes] [--max-size bytes] [--samples n] [--warmup n] [--profile path]<br/>
+		/// latency [the benchmark options; sizes default to 16 through 4096 bytes, and samples to 10000 messages]<br/>
+		/// calibrate [--profile path] [the benchmark options; sizes default to 4 MB, and samples to 5]<br/>
+		/// asymmetric [--format, --output, --filter, --samples and --warmup; samples default to 100 operations]<br/>
+		/// compare baseline current [--threshold percent]</para>
+		/// </summary>
+		///
+		/// <param name="Arguments">The command line arguments, without the executable name</param>
+		///
+		/// <returns>The process exit code; zero on success, one if the compare command found a regression, two for an error</returns>
+		static int Execute(const std::vector<std::string> &Arguments);
+
+		/// <summary>
+		/// Read a result file written by this class
+		/// </summary>
+		///
+		/// <param name="Path">The JSON or CSV result file</param>
+		///
+		/// <returns>The results in the file</returns>
+		static std::vector<BenchmarkResult> Load(const std::string &Path);
+
+		/// <summary>
+		/// Format a result set as a CSV or JSON document
+		/// </summary>
+		///
+		/// <param name="Results">The results to format</param>
+		/// <param name="Format">The document format</param>
+		///
+		/// <returns>The document text</returns>
+		static std::string Serialize(const std::vector<BenchmarkResult> &Results, OutputFormats Format);
+
+	private:
+
+		void AddAead();
+		void AddAsymmetric();
+		void AddCiphers();
+		void AddComposed();
+		template<typename T>
+		void AddComposedModes();
+		void AddDigests();
+		void AddMacs();
+		void AddParallel();
+		void Calibrate(const ScalingEntry &Entry);
+		static bool Contains(const std::string &Text, const std::string &Filter);
+		void Initialize();
+		BenchmarkResult Measure(const BenchmarkEntry &Entry, size_t Length);
+		BenchmarkResult MeasureAsymmetric(const BenchmarkEntry &Entry, std::vector<BenchmarkResult> &Phases);
+		BenchmarkResult MeasureLatency(const BenchmarkEntry &Entry, size_t Length);
+		void OnProgress(std::string Data);
+		static double Percentile(std::vector<double> &Values, double Rank);
+		static std::string ReadField(const std::string &Line, const std::string &Key);
+	};
+}
+
+#endif
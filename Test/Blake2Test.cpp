@@ -3,7 +3,20 @@
 #include "../CEX/CSP.h"
 #include "../CEX/Blake256.h"
 #include "../CEX/Blake512.h"
+#include "../CEX/Blake2.h"
+#include "../CEX/SecureRandom.h"
 #include "../CEX/SymmetricKey.h"
+#if defined(__AVX__)
+#	include "../CEX/UInt128.h"
+#endif
+#if defined(__AVX2__)
+#	include "../CEX/UInt256.h"
+#	include "../CEX/ULong256.h"
+#endif
+#if defined(__AVX512__)
+#	include "../CEX/UInt512.h"
+#	include "../CEX/ULong512.h"
+#endif
 #include <fstream>
 #include <string>
 
@@ -12,6 +25,8 @@ namespace Test
 	using Digest::BlakeParams;
 	using Digest::Blake256;
 	using Digest::Blake512;
+	using Digest::Blake2;
+	using Prng::SecureRandom;
 	using namespace TestFiles::Blake2Kat;
 
 	const std::string Blake2Test::DESCRIPTION = "Blake Vector KATs; tests Blake2 256/512 digests.";
@@ -59,6 +74,10 @@ namespace Test
 			OnProgress(std::string("Passed Blake2-B 512 vector tests.."));
 			Blake2BPTest();
 			OnProgress(std::string("Passed Blake2-BP 512 vector tests.."));    
+			LongMessageTest();
+			OnProgress(std::string("Passed Blake2-SP/BP multi-leaf long message tests.."));
+			WideCompressTest();
+			OnProgress(std::string("Passed Blake2-SP/BP transposed leaf compression tests.."));
 
 			return SUCCESS;
 		}
@@ -303,6 +322,58 @@ namespace Test
 		stream.close();
 	}
 
+	void Blake2Test::LongMessageTest()
+	{
+		// the message is long enough to be compressed in the transposed multi-leaf path
+		const size_t MSGLEN = 100000;
+		std::vector<byte> input(MSGLEN);
+		std::vector<byte> expect;
+
+		for (size_t i = 0; i < input.size(); ++i)
+		{
+			input[i] = static_cast<byte>((i * 31) + 7);
+		}
+
+		std::vector<byte> hash1(32);
+		std::vector<byte> hash2(32);
+		Blake256 blake2sp(true);
+
+		HexConverter::Decode(std::string("5C8F25059924A28AA00A775FED6061CA3D65087433C24B28C314C0831B9D9504"), expect);
+		blake2sp.Compute(input, hash1);
+
+		// uneven update sizes take both the buffered and unbuffered leaf paths
+		for (size_t i = 0, len = 1; i < input.size(); i += len, len = (len * 3) + 5)
+		{
+			blake2sp.Update(input, i, (input.size() - i < len) ? input.size() - i : len);
+		}
+
+		blake2sp.Finalize(hash2, 0);
+
+		if (hash1 != expect || hash2 != expect)
+		{
+			throw TestException("Blake2SPTest: Long message test has failed!");
+		}
+
+		hash1.resize(64);
+		hash2.resize(64);
+		Blake512 blake2bp(true);
+
+		HexConverter::Decode(std::string("CFFE3279A4AB026D760479F5CB208256E5EA8C5532DC543C19F6B2EBBEE35313CF94A2F4EABABD3EE673A34EBC807C3B5519A9DA42E668CD537C660450AB7420"), expect);
+		blake2bp.Compute(input, hash1);
+
+		for (size_t i = 0, len = 1; i < input.size(); i += len, len = (len * 3) + 5)
+		{
+			blake2bp.Update(input, i, (input.size() - i < len) ? input.size() - i : len);
+		}
+
+		blake2bp.Finalize(hash2, 0);
+
+		if (hash1 != expect || hash2 != expect)
+		{
+			throw TestException("Blake2BPTest: Long message test has failed!");
+		}
+	}
+
 	void Blake2Test::MacParamsTest()
 	{
 		std::vector<byte> key(64);
@@ -348,4 +419,123 @@ namespace Test
 	{
 		m_progressEvent(Data);
 	}
+
+	void Blake2Test::WideCompressTest()
+	{
+		// every register width the leaf processing can select must match the single leaf compression
+#if defined(__AVX__)
+		WideCompare512<Numeric::UInt128>();
+#endif
+#if defined(__AVX2__)
+		WideCompare512<Numeric::UInt256>();
+		WideCompare1024<Numeric::ULong256>();
+#endif
+#if defined(__AVX512__)
+		WideCompare512<Numeric::UInt512>();
+		WideCompare1024<Numeric::ULong512>();
+#endif
+	}
+
+	template<typename T>
+	void Blake2Test::WideCompare1024()
+	{
+		const size_t LNECNT = sizeof(T) / sizeof(ulong);
+		std::vector<byte> input(LNECNT * 128);
+		std::vector<ulong> iv(8);
+		// the leaves are compressed at an offset, as they are after a wider register has taken the first leaves
+		std::vector<LeafState<ulong>> state1(LNECNT + 1);
+		std::vector<LeafState<ulong>> state2(LNECNT + 1);
+		SecureRandom rnd;
+
+		for (size_t i = 0; i < 100; ++i)
+		{
+			rnd.GetBytes(input);
+
+			for (size_t j = 0; j < iv.size(); ++j)
+			{
+				iv[j] = rnd.NextUInt64();
+			}
+
+			for (size_t j = 0; j < state1.size(); ++j)
+			{
+				state1[j].F[0] = (j == LNECNT) ? ~0ULL : 0;
+				state1[j].F[1] = 0;
+				state1[j].T[0] = rnd.NextUInt64();
+				state1[j].T[1] = 0;
+
+				for (size_t k = 0; k < state1[j].H.size(); ++k)
+				{
+					state1[j].H[k] = rnd.NextUInt64();
+				}
+			}
+
+			state2 = state1;
+
+			for (size_t j = 0; j < LNECNT; ++j)
+			{
+				Blake2::Compress1024(input, j * 128, state1[j + 1], iv);
+			}
+
+			Blake2::Compress1024W<T>(input, 0, state2, 1, iv);
+
+			for (size_t j = 0; j < state1.size(); ++j)
+			{
+				if (state1[j].H != state2[j].H)
+				{
+					throw TestException("WideCompressTest: The transposed Blake2-BP compression does not match the sequential output!");
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	void Blake2Test::WideCompare512()
+	{
+		const size_t LNECNT = sizeof(T) / sizeof(uint);
+		std::vector<byte> input(LNECNT * 64);
+		std::vector<uint> iv(8);
+		std::vector<LeafState<uint>> state1(LNECNT + 1);
+		std::vector<LeafState<uint>> state2(LNECNT + 1);
+		SecureRandom rnd;
+
+		for (size_t i = 0; i < 100; ++i)
+		{
+			rnd.GetBytes(input);
+
+			for (size_t j = 0; j < iv.size(); ++j)
+			{
+				iv[j] = rnd.NextUInt32();
+			}
+
+			for (size_t j = 0; j < state1.size(); ++j)
+			{
+				state1[j].F[0] = (j == LNECNT) ? ~0U : 0;
+				state1[j].F[1] = 0;
+				state1[j].T[0] = rnd.NextUInt32();
+				state1[j].T[1] = 0;
+
+				for (size_t k = 0; k < state1[j].H.size(); ++k)
+				{
+					state1[j].H[k] = rnd.NextUInt32();
+				}
+			}
+
+			state2 = state1;
+
+			for (size_t j = 0; j < LNECNT; ++j)
+			{
+				Blake2::Compress512(input, j * 64, state1[j + 1], iv);
+			}
+
+			Blake2::Compress512W<T>(input, 0, state2, 1, iv);
+
+			for (size_t j = 0; j < state1.size(); ++j)
+			{
+				if (state1[j].H != state2[j].H)
+				{
+					throw TestException("WideCompressTest: The transposed Blake2-SP compression does not match the sequential output!");
+				}
+			}
+		}
+	}
 }
@@ -2,6 +2,7 @@
 #define _BLAKE2TEST_BLAKETEST_H
 
 #include "ITest.h"
+#include <array>
 
 namespace Test
 {
@@ -21,6 +22,14 @@ namespace Test
 		static const std::string DMK_KEY;
 		static const std::string DMK_HSH;
 
+		template<typename W>
+		struct LeafState
+		{
+			std::array<W, 2> F;
+			std::array<W, 8> H;
+			std::array<W, 2> T;
+		};
+
 		std::vector<std::vector<byte>> m_expected;
 		std::vector<std::vector<byte>> m_message;
 		TestEventHandler m_progressEvent;
@@ -58,9 +67,15 @@ namespace Test
 		void Blake2BPTest();
 		void Blake2STest();
 		void Blake2SPTest();
+		void LongMessageTest();
 		void MacParamsTest();
 		void TreeParamsTest();
 		void OnProgress(std::string Data);
+		void WideCompressTest();
+		template<typename T>
+		void WideCompare1024();
+		template<typename T>
+		void WideCompare512();
 	};
 }
 #endif
@@ -0,0 +1,282 @@
+#include "Blake3Test.h"
+#include "../CEX/Blake3.h"
+#include "../CEX/DigestFromName.h"
+#include "../CEX/SymmetricKey.h"
+
+namespace Test
+{
+	using Digest::Blake3;
+
+	const std::string Blake3Test::DESCRIPTION = "Tests the BLAKE3 digest in the hash, keyed, key derivation, and extended output modes.";
+	const std::string Blake3Test::FAILURE = "FAILURE! ";
+	const std::string Blake3Test::SUCCESS = "SUCCESS! All BLAKE3 tests have executed succesfully.";
+	const std::string Blake3Test::DERIVE_CONTEXT = "BLAKE3 2019-12-27 16:29:52 test vectors context";
+
+	Blake3Test::Blake3Test()
+		:
+		m_expected(0),
+		m_keyed(0),
+		m_derive(0),
+		m_msgLength(0),
+		m_progressEvent()
+	{
+		Initialize();
+	}
+
+	Blake3Test::~Blake3Test()
+	{
+	}
+
+	const std::string Blake3Test::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &Blake3Test::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string Blake3Test::Run()
+	{
+		try
+		{
+			Blake3* dgt = new Blake3();
+			HashTest(dgt);
+			delete dgt;
+			OnProgress(std::string("Passed BLAKE3 hash vector tests.."));
+
+			KeyedTest();
+			OnProgress(std::string("Passed BLAKE3 keyed hash vector tests.."));
+
+			DeriveTest();
+			OnProgress(std::string("Passed BLAKE3 key derivation vector tests.."));
+
+			XofTest();
+			OnProgress(std::string("Passed BLAKE3 extended output tests.."));
+
+			StreamTest();
+			OnProgress(std::string("Passed BLAKE3 long message and random update length tests.."));
+
+			ParallelTest();
+			OnProgress(std::string("Passed BLAKE3 parallel subtree hashing tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void Blake3Test::CompareVector(Blake3* Digest, std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		std::vector<byte> hash(Digest->DigestSize(), 0);
+
+		Digest->Update(Input, 0, Input.size());
+		Digest->Finalize(hash, 0);
+
+		if (Expected != hash)
+		{
+			throw TestException("Blake3Test: Expected hash is not equal!");
+		}
+
+		Digest->Compute(Input, hash);
+
+		if (Expected != hash)
+		{
+			throw TestException("Blake3Test: Expected hash is not equal!");
+		}
+	}
+
+	void Blake3Test::DeriveTest()
+	{
+		Blake3 dgt;
+
+		for (size_t i = 0; i < m_msgLength.size(); ++i)
+		{
+			std::vector<byte> input = TestUtils::PatternMessage(m_msgLength[i]);
+			// the key derivation mode is retained after finalization
+			dgt.Initialize(DERIVE_CONTEXT);
+			CompareVector(&dgt, input, m_derive[i]);
+		}
+	}
+
+	void Blake3Test::HashTest(Blake3* Digest)
+	{
+		for (size_t i = 0; i < m_msgLength.size(); ++i)
+		{
+			std::vector<byte> input = TestUtils::PatternMessage(m_msgLength[i]);
+			CompareVector(Digest, input, m_expected[i]);
+		}
+	}
+
+	void Blake3Test::Initialize()
+	{
+		/*lint -save -e417 */
+		m_msgLength = { 0, 1, 1023, 1024, 1025, 2048, 2049, 3072, 3073, 4096, 4097, 8192, 8193, 16384, 31744, 102400 };
+
+		const std::vector<std::string> expected =
+		{
+			std::string("AF1349B9F5F9A1A6A0404DEA36DCC9499BCB25C9ADC112B7CC9A93CAE41F3262"),
+			std::string("2D3ADEDFF11B61F14C886E35AFA036736DCD87A74D27B5C1510225D0F592E213"),
+			std::string("10108970EEDA3EB932BAAC1428C7A2163B0E924C9A9E25B35BBA72B28F70BD11"),
+			std::string("42214739F095A406F3FC83DEB889744AC00DF831C10DAA55189B5D121C855AF7"),
+			std::string("D00278AE47EB27B34FAECF67B4FE263F82D5412916C1FFD97C8CB7FB814B8444"),
+			std::string("E776B6028C7CD22A4D0BA182A8BF62205D2EF576467E838ED6F2529B85FBA24A"),
+			std::string("5F4D72F40D7A5F82B15CA2B2E44B1DE3C2EF86C426C95C1AF0B6879522563030"),
+			std::string("B98CB0FF3623BE03326B373DE6B9095218513E64F1EE2EDD2525C7AD1E5CFFD2"),
+			std::string("7124B49501012F81CC7F11CA069EC9226CECB8A2C850CFE644E327D22D3E1CD3"),
+			std::string("015094013F57A5277B59D8475C0501042C0B642E531B0A1C8F58D2163229E969"),
+			std::string("9B4052B38F1C5FC8B1F9FF7AC7B27CD242487B3D890D15C96A1C25B8AA0FB995"),
+			std::string("AAE792484C8EFE4F19E2CA7D371D8C467FFB10748D8A5A1AE579948F718A2A63"),
+			std::string("BAB6C09CB8CE8CF459261398D2E7AEF35700BF488116CEB94A36D0F5F1B7BC3B"),
+			std::string("F875D6646DE28985646F34EE13BE9A576FD515F76B5B0A26BB324735041DDDE4"),
+			std::string("62B6960E1A44BCC1EB1A611A8D6235B6B4B78F32E7ABC4FB4C6CDCCE94895C47"),
+			std::string("BC3E3D41A1146B069ABFFAD3C0D44860CF664390AFCE4D9661F7902E7943E085")
+		};
+		HexConverter::Decode(expected, 16, m_expected);
+
+		const std::vector<std::string> keyed =
+		{
+			std::string("73492B19995D71CDB1E9D74DECC09809EB732F1B00BC95C27CB15F9DD4D6478F"),
+			std::string("D08B45C6B127EE94F3F8527A0B82A5F80BE1695A0EAEC6022E772C0EB95A7E8B"),
+			std::string("DA1F18069871512AF22AF9F13DC005800DFD52C55F42753B5AE718086FE2EE44"),
+			std::string("F45A9249A627FDF1FCF13C0E6376F6A9A9B2056D6E1B5693A4B119A3453665F9"),
+			std::string("82223147A9B804A0C3F9A921B8D8AEE250D1A51BB76BE72152E6D5E8F27349B3"),
+			std::string("636BFA717D4F9FC3E59DA9B2E5CCE6A2B78EB70469C0FCE49DA38B5419892423"),
+			std::string("5442EEC85E3FD173DCFF07C39CD8CFF9689F17224471E655618ED728CF03B056"),
+			std::string("66315151AC08F5CDF077F76E1B5F584A4DA7B48A75036DE5729BE38DAC835FB7"),
+			std::string("66EABF3A0A1A262221EE9EED633621A5065E4E73D098277C7DE4162559EDB9B4"),
+			std::string("E8C6E859E0480C4B062457DEFD04D2F4303B6CC280A0FE080EC5C4346A171937"),
+			std::string("A3B7FE277011B5EFCDE8A33D90B0EDB88C29E73831F34D9B02AEBAB51C98E2A6"),
+			std::string("C659141D9D7E6EFAFD2F274D4307B9AB3369F058C6D03CD5BA17D4518D77BD49"),
+			std::string("C666CCF5FA240C07A9D0A6B8AE92C67668B482E7C2751FB5E1D9D7078FA9637E"),
+			std::string("8880CE020AB0459420EEE7E95F173D8A0D55C9B499D857880B0C661EB4162BAE"),
+			std::string("55253F057BCE59E7811FEA47AC0E72751CA12C40C4A5B8F3C42E54DAA5073272"),
+			std::string("AB2ECF0478E816065BA6039D8EC583CBCE8A2335EFE903E2D7313C04BA5330D2")
+		};
+		HexConverter::Decode(keyed, 16, m_keyed);
+
+		const std::vector<std::string> derive =
+		{
+			std::string("2CC39783C223154FEA8DFB7C1B1660F2AC2DCBD1C1DE8277B0B0DD39B7E50D7D"),
+			std::string("B3E2E340A117A499C6CF2398A19EE0D29CCA2BB7404C73063382693BF66CB06C"),
+			std::string("74A16C1C3D44368A86E1CA6DF64BE6A2F64CCE8F09220787450722D85725DEA5"),
+			std::string("7356CD7720D5B66B6D0697EB3177D9F8D73A4A5C5E968896EB6A689684302706"),
+			std::string("EFFAA245F065FBF82AC186839A249707C3BDDF6D3FDDA22D1B95A3C970379BCB"),
+			std::string("7B2945CB4FEF70885CC5D78A87BF6F6207DD901FF239201351FFAC04E1088A23"),
+			std::string("2EA477C5515CC3DD606512EE72BB3E0E758CFAE7232826F35FB98CA1BCBDF273"),
+			std::string("050DF97F8C2EAD654D9BB3AB8C9178EDCD902A32F8495949FEADCC1E0480C46B"),
+			std::string("72613C9EC9FF7E40F8F5C173784C532AD852E827DBA2BF85B2AB4B76F7079081"),
+			std::string("1E0D7F3DB8C414C97C6307CBDA6CD27AC3B030949DA8E23BE1A1A924AD2F25B9"),
+			std::string("ACA51029626B55FDA7117B42A7C211F8C6E9BA4FE5B7A8CA922F34299500EAD8"),
+			std::string("AD01D7AE4AD059B0D33BAA3C01319DCF8088094D0359E5FD45D6AEAA8B2D0C3D"),
+			std::string("AF1E0346E389B17C23200270A64AA4E1EAD98C61695D917DE7D5B00491C9B0F1"),
+			std::string("160E18B5878CD0DF1C3AF85EB25A0DB5344D43A6FBD7A8EF4ED98D0714C3F7E1"),
+			std::string("39772AEF80E0EBE60596361E45B061E8F417429D529171B6764468C22928E28E"),
+			std::string("4652CFF7A3F385A6103B5C260FC1593E13C778DBE608EFB092FE7EE69DF6E9C6")
+		};
+		HexConverter::Decode(derive, 16, m_derive);
+		/*lint -restore */
+	}
+
+	void Blake3Test::KeyedTest()
+	{
+		std::vector<byte> key(32);
+
+		for (size_t i = 0; i < key.size(); ++i)
+		{
+			key[i] = static_cast<byte>(i);
+		}
+
+		Key::Symmetric::SymmetricKey kp(key);
+		Blake3 dgt;
+		dgt.Initialize(kp);
+
+		for (size_t i = 0; i < m_msgLength.size(); ++i)
+		{
+			std::vector<byte> input = TestUtils::PatternMessage(m_msgLength[i]);
+			CompareVector(&dgt, input, m_keyed[i]);
+		}
+	}
+
+	void Blake3Test::ParallelTest()
+	{
+		Blake3 dgs(false);
+		Digest::IDigest* dgp = Helper::DigestFromName::GetInstance(Enumeration::Digests::Blake3, true);
+		// the subtree split does not depend on the parallel settings, so both instances produce the same hash
+		const bool ISEQL = TestUtils::DigestParallelEqual(&dgs, dgp);
+
+		delete dgp;
+
+		if (!ISEQL)
+		{
+			throw TestException("Blake3Test: Parallel hash is not equal!");
+		}
+	}
+
+	void Blake3Test::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	void Blake3Test::StreamTest()
+	{
+		// the message is long enough to be hashed as several capped subtrees
+		const size_t MSGLEN = (4 * 1024 * 1024) + 1;
+		std::vector<byte> input(MSGLEN);
+		std::vector<byte> expect;
+		std::vector<byte> hash(32);
+		Blake3 dgt;
+
+		for (size_t i = 0; i < input.size(); ++i)
+		{
+			input[i] = static_cast<byte>((i * 31) + 7);
+		}
+
+		HexConverter::Decode(std::string("089512D3816159817169980EEBFD10AB2313B1432E13E4E481ED658E61DE9AEE"), expect);
+		dgt.Compute(input, hash);
+
+		if (hash != expect)
+		{
+			throw TestException("Blake3Test: Long message hash is not equal!");
+		}
+
+		// update lengths of up to 70000 bytes cross the block, chunk, and subtree boundaries at arbitrary offsets
+		if (!TestUtils::DigestUpdateEqual(&dgt, input, 70000))
+		{
+			throw TestException("Blake3Test: Partial update hash is not equal!");
+		}
+	}
+
+	void Blake3Test::XofTest()
+	{
+		std::vector<byte> input = TestUtils::PatternMessage(1025);
+		std::vector<byte> expect;
+		std::vector<byte> output(131);
+		std::vector<byte> prefix(32);
+		Blake3 dgt;
+
+		HexConverter::Decode(std::string("D00278AE47EB27B34FAECF67B4FE263F82D5412916C1FFD97C8CB7FB814B8444F4C4A22B4B399155358A994E52BF255DE60035742EC71BD08AC275A1B51CC6BFE332B0EF84B409108CDA080E6269ED4B3E2C3F7D722AA4CDC98D16DEB554E5627BE8F955C98E1D5F9565A9194CAD0C4285F93700062D9595ADB992AE68FF12800AB67A"), expect);
+		dgt.Update(input, 0, input.size());
+		dgt.Finalize(output, 0, output.size());
+
+		if (output != expect)
+		{
+			throw TestException("Blake3Test: Extended output is not equal!");
+		}
+
+		// the default output is a prefix of the extended output
+		dgt.Compute(input, prefix);
+
+		if (!std::equal(prefix.begin(), prefix.end(), output.begin()))
+		{
+			throw TestException("Blake3Test: Extended output prefix is not equal!");
+		}
+	}
+}
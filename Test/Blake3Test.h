@@ -0,0 +1,70 @@
+#ifndef CEXTEST_BLAKE3TEST_H
+#define CEXTEST_BLAKE3TEST_H
+
+#include "ITest.h"
+#include "../CEX/Blake3.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests the BLAKE3 digest implementation using vector comparisons.
+	/// <para>Tests the hash, keyed hash, and key derivation modes with vectors generated by the BLAKE3 reference implementation:
+	/// <see href="https://github.com/BLAKE3-team/BLAKE3"/></para>
+	/// </summary>
+	class Blake3Test final : public ITest
+	{
+	private:
+
+		static const std::string DERIVE_CONTEXT;
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		std::vector<std::vector<byte>> m_expected;
+		std::vector<std::vector<byte>> m_keyed;
+		std::vector<std::vector<byte>> m_derive;
+		std::vector<size_t> m_msgLength;
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Known answer tests for the BLAKE3 digest
+		/// </summary>
+		Blake3Test();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~Blake3Test();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void CompareVector(Digest::Blake3* Digest, std::vector<byte> &Input, std::vector<byte> &Expected);
+		void DeriveTest();
+		void HashTest(Digest::Blake3* Digest);
+		void Initialize();
+		void KeyedTest();
+		void OnProgress(std::string Data);
+		void ParallelTest();
+		void StreamTest();
+		void XofTest();
+	};
+}
+
+#endif
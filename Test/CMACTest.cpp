@@ -53,6 +53,8 @@ namespace Test
 			OnProgress(std::string("Passed 256 bit key vector tests.."));
 			CompareAccess(m_keys[2]);
 			OnProgress(std::string("Passed Finalize/Compute methods output comparison.."));
+			CompareBatch(m_keys[0]);
+			OnProgress(std::string("Passed multi-message ComputeBatch output comparison.."));
 
 			return SUCCESS;
 		}
@@ -89,6 +91,47 @@ namespace Test
 		}
 	}
 
+	void CMACTest::CompareBatch(std::vector<byte> &Key)
+	{
+		const std::vector<size_t> MSGLEN = { 0, 1, 15, 16, 17, 64, 100 };
+		const size_t MSGCNT = 21;
+		Cipher::Symmetric::Block::RHX* eng = new Cipher::Symmetric::Block::RHX();
+		Mac::CMAC mac(eng);
+		SymmetricKey kp(Key);
+
+		mac.Initialize(kp);
+
+		for (size_t i = 0; i < MSGLEN.size(); ++i)
+		{
+			std::vector<byte> input(MSGLEN[i] * MSGCNT);
+			std::vector<byte> code1(mac.MacSize() * MSGCNT);
+			std::vector<byte> code2(mac.MacSize() * MSGCNT);
+
+			for (size_t j = 0; j < input.size(); ++j)
+			{
+				input[j] = static_cast<byte>(j * 7 + i);
+			}
+
+			// each message separately
+			for (size_t j = 0; j < MSGCNT; ++j)
+			{
+				mac.Update(input, j * MSGLEN[i], MSGLEN[i]);
+				mac.Finalize(code1, j * mac.MacSize());
+			}
+
+			// all messages interleaved
+			mac.ComputeBatch(input, 0, MSGLEN[i], MSGCNT, code2, 0);
+
+			if (code1 != code2)
+			{
+				delete eng;
+				throw TestException("CMAC batch output is not equal!");
+			}
+		}
+
+		delete eng;
+	}
+
 	void CMACTest::CompareVector(std::vector<byte> &Key, std::vector<byte> &Input, std::vector<byte> &Expected)
 	{
 		std::vector<byte> hash(16);
@@ -43,6 +43,8 @@ namespace Test
 			OnProgress(std::string("BCG: Passed initialization tests.."));
 			CompareOutput();
 			OnProgress(std::string("BCG: Passed output comparison tests.."));
+			CompareChunked();
+			OnProgress(std::string("BCG: Passed large request chunking tests.."));
 
 			return SUCCESS;
 		}
@@ -136,6 +138,38 @@ namespace Test
 		}
 	}
 
+	void CMGTest::CompareChunked()
+	{
+		using namespace Drbg;
+
+		std::vector<byte> iv(16, 0x01);
+		std::vector<byte> key(32, 0x02);
+
+		// a single request spanning several parallel blocks, with an unaligned remainder
+		Drbg::BCG ctd1(BlockCiphers::Rijndael, Digests::None, Providers::None);
+		ctd1.Initialize(key, iv);
+		std::vector<byte> output1((ctd1.ParallelBlockSize() * 3) + 1033);
+		ctd1.Generate(output1, 0, output1.size());
+
+		// the same output assembled from small sequential requests
+		Drbg::BCG ctd2(BlockCiphers::Rijndael, Digests::None, Providers::None);
+		ctd2.Initialize(key, iv);
+		std::vector<byte> output2(output1.size());
+		size_t prcLen = 0;
+
+		while (prcLen != output2.size())
+		{
+			const size_t RQTLEN = Utility::IntUtils::Min(SAMPLE_SIZE, output2.size() - prcLen);
+			ctd2.Generate(output2, prcLen, RQTLEN);
+			prcLen += RQTLEN;
+		}
+
+		if (output1 != output2)
+		{
+			throw TestException("BCG: Failed chunked output comparison test!");
+		}
+	}
+
 	void CMGTest::CompareOutput()
 	{
 		using namespace Cipher::Symmetric::Block;
@@ -50,6 +50,7 @@ namespace Test
 	private:
 
 		void CheckInit();
+		void CompareChunked();
 		void CompareOutput();
 		void OnProgress(std::string Data);
 		bool OrderedRuns(const std::vector<byte> &Input);
@@ -0,0 +1,344 @@
+#include "CSPTest.h"
+#include "../CEX/CSP.h"
+#include <cstring>
+#include <set>
+#include <thread>
+#if !defined(CEX_OS_WINDOWS) && !defined(CEX_OS_ANDROID)
+#	include <sys/wait.h>
+#	include <unistd.h>
+#endif
+
+namespace Test
+{
+	using Provider::CSP;
+
+	const std::string CSPTest::DESCRIPTION = "CSP entropy provider cache boundary, large request, thread and fork tests.";
+	const std::string CSPTest::FAILURE = "FAILURE! ";
+	const std::string CSPTest::SUCCESS = "SUCCESS! All CSP tests have executed succesfully.";
+
+	CSPTest::CSPTest()
+		:
+		m_progressEvent()
+	{
+	}
+
+	CSPTest::~CSPTest()
+	{
+	}
+
+	const std::string CSPTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &CSPTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string CSPTest::Run()
+	{
+		try
+		{
+			BoundaryCheck();
+			OnProgress(std::string("CSPTest: Passed thread cache boundary tests.."));
+			LargeCheck();
+			OnProgress(std::string("CSPTest: Passed requests larger than the thread cache tests.."));
+			ThreadCheck();
+			OnProgress(std::string("CSPTest: Passed concurrent thread generation tests.."));
+			ForkCheck();
+			OnProgress(std::string("CSPTest: Passed forked process cache tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (std::exception const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + std::string(ex.what()));
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void CSPTest::BoundaryCheck()
+	{
+		CSP gen;
+		std::vector<byte> prv(0);
+
+		// lengths that leave the cache position on, before, and after the boundary
+		for (size_t len : { static_cast<size_t>(1), static_cast<size_t>(17), CACHE_SIZE / 2, CACHE_SIZE - 1, static_cast<size_t>(CACHE_SIZE - 32) })
+		{
+			gen.Reset();
+
+			for (size_t i = 0; i < 3 * (CACHE_SIZE / len) + 2; ++i)
+			{
+				// guard bytes on both sides of the requested region
+				std::vector<byte> otp(len + 32, 0);
+				gen.GetBytes(otp, 16, len);
+
+				if (!IsFilled(otp, 16, len))
+				{
+					throw TestException(std::string("BoundaryCheck: The output was not filled! -CB1"));
+				}
+
+				for (size_t j = 0; j < 16; ++j)
+				{
+					if (otp[j] != 0 || otp[len + 16 + j] != 0)
+					{
+						throw TestException(std::string("BoundaryCheck: Bytes outside the request were written! -CB2"));
+					}
+				}
+
+				std::vector<byte> cur(otp.begin() + 16, otp.begin() + 16 + len);
+
+				if (len >= 16 && cur == prv)
+				{
+					throw TestException(std::string("BoundaryCheck: The cache output repeated! -CB3"));
+				}
+
+				prv = cur;
+			}
+		}
+
+		// a request that spans the boundary after Next() has left an unaligned position
+		gen.Reset();
+		std::vector<byte> otp(64);
+
+		for (size_t i = 0; i < (CACHE_SIZE / sizeof(uint)) + 5; ++i)
+		{
+			gen.Next();
+		}
+
+		for (size_t i = 0; i < CACHE_SIZE / otp.size() + 2; ++i)
+		{
+			gen.GetBytes(otp, 0, 3);
+			gen.GetBytes(otp, 3, otp.size() - 3);
+
+			if (!IsFilled(otp, 0, otp.size()))
+			{
+				throw TestException(std::string("BoundaryCheck: The output after Next was not filled! -CB4"));
+			}
+
+			std::fill(otp.begin(), otp.end(), 0);
+			gen.Next();
+		}
+	}
+
+	void CSPTest::ForkCheck()
+	{
+#if !defined(CEX_OS_WINDOWS) && !defined(CEX_OS_ANDROID)
+		const size_t OTPLEN = 64;
+		CSP gen;
+
+		for (size_t i = 0; i < 10; ++i)
+		{
+			// the parents cache holds unread output when it forks
+			gen.Reset();
+			gen.GetBytes(32);
+			int fds[2];
+
+			if (::pipe(fds) != 0)
+			{
+				throw TestException(std::string("ForkCheck: The pipe could not be created! -CF1"));
+			}
+
+			const pid_t PID = ::fork();
+
+			if (PID < 0)
+			{
+				::close(fds[0]);
+				::close(fds[1]);
+				throw TestException(std::string("ForkCheck: The process could not be forked! -CF2"));
+			}
+
+			if (PID == 0)
+			{
+				// child: the same requests the parent makes next, through the cache and Next()
+				int ret = 1;
+
+				try
+				{
+					std::vector<byte> chd(OTPLEN + sizeof(uint));
+					gen.GetBytes(chd, 0, OTPLEN);
+					uint num = gen.Next();
+					std::memcpy(chd.data() + OTPLEN, &num, sizeof(uint));
+
+					if (::write(fds[1], chd.data(), chd.size()) == static_cast<ssize_t>(chd.size()))
+					{
+						ret = 0;
+					}
+				}
+				catch (...)
+				{
+				}
+
+				::_exit(ret);
+			}
+
+			::close(fds[1]);
+			std::vector<byte> prt(OTPLEN + sizeof(uint));
+			gen.GetBytes(prt, 0, OTPLEN);
+			uint num = gen.Next();
+			std::memcpy(prt.data() + OTPLEN, &num, sizeof(uint));
+
+			std::vector<byte> chd(OTPLEN + sizeof(uint));
+			size_t rcvLen = 0;
+
+			while (rcvLen != chd.size())
+			{
+				const ssize_t RDLEN = ::read(fds[0], chd.data() + rcvLen, chd.size() - rcvLen);
+
+				if (RDLEN <= 0)
+				{
+					break;
+				}
+
+				rcvLen += static_cast<size_t>(RDLEN);
+			}
+
+			::close(fds[0]);
+			int status = 0;
+			::waitpid(PID, &status, 0);
+
+			if (rcvLen != chd.size() || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+			{
+				throw TestException(std::string("ForkCheck: The child process failed to generate! -CF3"));
+			}
+
+			if (std::memcmp(chd.data(), prt.data(), OTPLEN) == 0 || std::memcmp(chd.data() + OTPLEN, prt.data() + OTPLEN, sizeof(uint)) == 0)
+			{
+				throw TestException(std::string("ForkCheck: The child repeated the parents cached output! -CF4"));
+			}
+		}
+#endif
+	}
+
+	bool CSPTest::IsFilled(const std::vector<byte> &Output, size_t Offset, size_t Length)
+	{
+		// a run of 16 zero bytes in random output has a probability of 2^-128
+		size_t zroLen = 0;
+
+		for (size_t i = Offset; i < Offset + Length; ++i)
+		{
+			zroLen = (Output[i] == 0) ? zroLen + 1 : 0;
+
+			if (zroLen == 16)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void CSPTest::LargeCheck()
+	{
+		CSP gen;
+		std::set<std::vector<byte>> prv;
+
+		for (size_t len : { CACHE_SIZE - 1, CACHE_SIZE, CACHE_SIZE + 1, (CACHE_SIZE * 3) + 17, static_cast<size_t>(1024 * 1024) })
+		{
+			// a partly used cache, so the large request starts at an unaligned cache position
+			std::vector<byte> sml1 = gen.GetBytes(33);
+			std::vector<byte> otp(len + 32, 0);
+			gen.GetBytes(otp, 16, len);
+			std::vector<byte> sml2 = gen.GetBytes(33);
+
+			if (!IsFilled(otp, 16, len))
+			{
+				throw TestException(std::string("LargeCheck: The output was not filled! -CL1"));
+			}
+
+			for (size_t j = 0; j < 16; ++j)
+			{
+				if (otp[j] != 0 || otp[len + 16 + j] != 0)
+				{
+					throw TestException(std::string("LargeCheck: Bytes outside the request were written! -CL2"));
+				}
+			}
+
+			// the bypassed cache continues where it stopped, and never repeats
+			if (sml1 == sml2 || !prv.insert(sml1).second || !prv.insert(sml2).second)
+			{
+				throw TestException(std::string("LargeCheck: The cache output repeated around a large request! -CL3"));
+			}
+
+			// the large output does not repeat the cached output
+			std::vector<byte> hdr(otp.begin() + 16, otp.begin() + 16 + 33);
+
+			if (!prv.insert(hdr).second)
+			{
+				throw TestException(std::string("LargeCheck: The large request repeated the cached output! -CL4"));
+			}
+		}
+	}
+
+	void CSPTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	void CSPTest::ThreadCheck()
+	{
+		const size_t THDCNT = 8;
+		const size_t BLKCNT = 512;
+		const size_t BLKLEN = 32;
+		std::vector<std::vector<byte>> thdOtp(THDCNT);
+		std::vector<std::thread> thds;
+		// one flag byte per thread; a vector<bool> would share words between the threads
+		std::vector<byte> thdErr(THDCNT, 0);
+
+		for (size_t i = 0; i < THDCNT; ++i)
+		{
+			thds.push_back(std::thread([&thdOtp, &thdErr, i, BLKCNT, BLKLEN]()
+			{
+				try
+				{
+					// each thread draws through its own cache, crossing several refills
+					CSP gen;
+					thdOtp[i].resize(BLKCNT * BLKLEN);
+
+					for (size_t j = 0; j < BLKCNT; ++j)
+					{
+						gen.GetBytes(thdOtp[i], j * BLKLEN, BLKLEN);
+						gen.Next();
+					}
+				}
+				catch (...)
+				{
+					thdErr[i] = 1;
+				}
+			}));
+		}
+
+		for (size_t i = 0; i < THDCNT; ++i)
+		{
+			thds[i].join();
+		}
+
+		std::set<std::vector<byte>> blks;
+
+		for (size_t i = 0; i < THDCNT; ++i)
+		{
+			if (thdErr[i] != 0)
+			{
+				throw TestException(std::string("ThreadCheck: A generating thread failed! -CT1"));
+			}
+
+			for (size_t j = 0; j < BLKCNT; ++j)
+			{
+				std::vector<byte> blk(thdOtp[i].begin() + (j * BLKLEN), thdOtp[i].begin() + ((j + 1) * BLKLEN));
+
+				if (!IsFilled(blk, 0, blk.size()) || !blks.insert(blk).second)
+				{
+					throw TestException(std::string("ThreadCheck: The thread output is not distinct! -CT2"));
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,63 @@
+#ifndef CEXTEST_CSPTEST_H
+#define CEXTEST_CSPTEST_H
+
+#include "ITest.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests the CSP system entropy provider.
+	/// <para>Checks requests that span the per-thread cache boundary and requests larger than the cache, that concurrent threads generate distinct output,
+	/// and that a forked child process does not repeat the output its parent has cached.</para>
+	/// </summary>
+	class CSPTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+		// the size of the providers thread cache
+		static const size_t CACHE_SIZE = 4096;
+
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Tests the system entropy provider
+		/// </summary>
+		CSPTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~CSPTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void BoundaryCheck();
+		void ForkCheck();
+		static bool IsFilled(const std::vector<byte> &Output, size_t Offset, size_t Length);
+		void LargeCheck();
+		void OnProgress(std::string Data);
+		void ThreadCheck();
+	};
+}
+
+#endif
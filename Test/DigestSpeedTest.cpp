@@ -49,6 +49,16 @@ namespace Test
 			OnProgress(std::string("***The parallel Blake 512 digest***"));
 			DigestBlockLoop(Digests::Blake512, MB100, 10, true);
 
+			OnProgress(std::string("***The sequential BLAKE3 digest***"));
+			DigestBlockLoop(Digests::Blake3, MB100);
+			OnProgress(std::string("***The parallel BLAKE3 digest***"));
+			DigestBlockLoop(Digests::Blake3, MB100, 10, true);
+
+			OnProgress(std::string("***The sequential KangarooTwelve digest***"));
+			DigestBlockLoop(Digests::KangarooTwelve, MB100);
+			OnProgress(std::string("***The parallel KangarooTwelve digest***"));
+			DigestBlockLoop(Digests::KangarooTwelve, MB100, 10, true);
+
 			OnProgress(std::string("***The sequential Keccak 256 digest***"));
 			DigestBlockLoop(Digests::Keccak256, MB100);
 			OnProgress(std::string("***The parallel Keccak 256 digest***"));
@@ -64,6 +74,11 @@ namespace Test
 			OnProgress(std::string("***The parallel Keccak 1024 digest***"));
 			DigestBlockLoop(Digests::Keccak1024, MB100, 10, true);
 
+			OnProgress(std::string("***The sequential ParallelHash128 digest***"));
+			DigestBlockLoop(Digests::ParallelHash128, MB100);
+			OnProgress(std::string("***The parallel ParallelHash128 digest***"));
+			DigestBlockLoop(Digests::ParallelHash128, MB100, 10, true);
+
 			OnProgress(std::string("***The sequential SHA2 256 digest***"));
 			DigestBlockLoop(Digests::SHA256, MB100);
 			OnProgress(std::string("***The parallel SHA2 256 digest***"));
@@ -0,0 +1,132 @@
+#include "DrbgSpeedTest.h"
+#include "../CEX/BCG.h"
+#include "../CEX/CSG.h"
+#include "../CEX/HCG.h"
+#include "../CEX/SymmetricKey.h"
+
+namespace Test
+{
+	const std::string DrbgSpeedTest::DESCRIPTION = "DRBG Speed Tests.";
+	const std::string DrbgSpeedTest::FAILURE = "FAILURE! ";
+	const std::string DrbgSpeedTest::MESSAGE = "COMPLETE! Speed tests have executed succesfully.";
+
+	DrbgSpeedTest::DrbgSpeedTest()
+		:
+		m_progressEvent()
+	{
+	}
+
+	DrbgSpeedTest::~DrbgSpeedTest()
+	{
+	}
+
+	const std::string DrbgSpeedTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &DrbgSpeedTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string DrbgSpeedTest::Run()
+	{
+		using namespace Enumeration;
+
+		try
+		{
+			OnProgress(std::string("### DRBG Speed Tests: 10 loops * 100MB, 10MB requests ###"));
+
+			OnProgress(std::string("***The parallel BCG generator using Rijndael***"));
+			Drbg::BCG* bcg = new Drbg::BCG(BlockCiphers::Rijndael, Digests::None, Providers::None);
+			GeneratorLoop(bcg, DATA_SIZE);
+			delete bcg;
+
+			OnProgress(std::string("***The sequential BCG generator using Rijndael***"));
+			bcg = new Drbg::BCG(BlockCiphers::Rijndael, Digests::None, Providers::None);
+			bcg->ParallelProfile().IsParallel() = false;
+			GeneratorLoop(bcg, DATA_SIZE);
+			delete bcg;
+
+			OnProgress(std::string("***The CSG generator using SHAKE256***"));
+			Drbg::CSG* csg = new Drbg::CSG(ShakeModes::SHAKE256, Providers::None, false);
+			GeneratorLoop(csg, DATA_SIZE);
+			delete csg;
+
+			OnProgress(std::string("***The vectorized CSG generator using SHAKE256***"));
+			csg = new Drbg::CSG(ShakeModes::SHAKE256, Providers::None, true);
+			GeneratorLoop(csg, DATA_SIZE);
+			delete csg;
+
+			OnProgress(std::string("***The HCG generator using SHA256***"));
+			Drbg::HCG* hcg = new Drbg::HCG(Digests::SHA256, Providers::None);
+			GeneratorLoop(hcg, DATA_SIZE);
+			delete hcg;
+
+			return MESSAGE;
+		}
+		catch (std::exception const &ex)
+		{
+			return FAILURE + " : " + ex.what();
+		}
+		catch (...)
+		{
+			return FAILURE + " : Unknown Error";
+		}
+	}
+
+	void DrbgSpeedTest::GeneratorLoop(Drbg::IDrbg* Generator, size_t SampleSize, size_t Loops)
+	{
+		std::vector<byte> key(Generator->LegalKeySizes()[1].KeySize());
+		std::vector<byte> nonce(Generator->LegalKeySizes()[1].NonceSize());
+		std::vector<byte> buffer(REQUEST_SIZE);
+
+		TestUtils::GetRandom(key);
+		TestUtils::GetRandom(nonce);
+		Key::Symmetric::SymmetricKey kp(key, nonce);
+		Generator->Initialize(kp);
+
+		uint64_t start = TestUtils::GetTimeMs64();
+
+		for (size_t i = 0; i < Loops; ++i)
+		{
+			size_t counter = 0;
+			uint64_t lstart = TestUtils::GetTimeMs64();
+
+			while (counter < SampleSize)
+			{
+				Generator->Generate(buffer, 0, buffer.size());
+				counter += buffer.size();
+			}
+
+			std::string calc = TestUtils::ToString((TestUtils::GetTimeMs64() - lstart) / 1000.0);
+			OnProgress(calc);
+		}
+
+		uint64_t dur = TestUtils::GetTimeMs64() - start;
+		uint64_t len = Loops * SampleSize;
+		uint64_t rate = GetBytesPerSecond(dur, len);
+		std::string glen = TestUtils::ToString(len / GB1);
+		std::string gbps = TestUtils::ToString((double)rate / GB1);
+		std::string mbps = TestUtils::ToString((rate / MB1));
+		std::string secs = TestUtils::ToString((double)dur / 1000.0);
+		std::string resp = std::string(glen + "GB in " + secs + " seconds, avg. " + mbps + " MB per Second (" + gbps + " GB/s)");
+
+		OnProgress(resp);
+		OnProgress(std::string(""));
+	}
+
+	uint64_t DrbgSpeedTest::GetBytesPerSecond(uint64_t DurationTicks, uint64_t DataSize)
+	{
+		double sec = (double)DurationTicks / 1000.0;
+		double sze = (double)DataSize;
+
+		return (sec == 0.0) ? 0 : (uint64_t)(sze / sec);
+	}
+
+	void DrbgSpeedTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
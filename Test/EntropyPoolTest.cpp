@@ -0,0 +1,338 @@
+#include "EntropyPoolTest.h"
+#include "../CEX/EntropyPool.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#if !defined(CEX_OS_WINDOWS) && !defined(CEX_OS_ANDROID)
+#	include <sys/wait.h>
+#	include <unistd.h>
+#endif
+
+namespace Test
+{
+	using Provider::EntropyPool;
+
+	const std::string EntropyPoolTest::DESCRIPTION = "Entropy pool seeding, extraction, background refresh and failure tests.";
+	const std::string EntropyPoolTest::FAILURE = "FAILURE! ";
+	const std::string EntropyPoolTest::SUCCESS = "SUCCESS! All EntropyPool tests have executed succesfully.";
+
+	EntropyPoolTest::EntropyPoolTest()
+		:
+		m_progressEvent()
+	{
+	}
+
+	EntropyPoolTest::~EntropyPoolTest()
+	{
+	}
+
+	const std::string EntropyPoolTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &EntropyPoolTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string EntropyPoolTest::Run()
+	{
+		try
+		{
+			SeedCheck();
+			OnProgress(std::string("EntropyPoolTest: Passed pool seeding tests.."));
+			ExtractionCheck();
+			OnProgress(std::string("EntropyPoolTest: Passed pool extraction tests.."));
+			RefreshCheck();
+			OnProgress(std::string("EntropyPoolTest: Passed background refresh and counter tests.."));
+			FailureCheck();
+			OnProgress(std::string("EntropyPoolTest: Passed collector failure tests.."));
+			DestructionCheck();
+			OnProgress(std::string("EntropyPoolTest: Passed destruction while running tests.."));
+			ForkCheck();
+			OnProgress(std::string("EntropyPoolTest: Passed forked process restart and destruction tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (std::exception const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + std::string(ex.what()));
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void EntropyPoolTest::DestructionCheck()
+	{
+		std::atomic<bool> isCollecting(false);
+
+		{
+			// a slow collector, so the pool is destroyed while its thread is collecting
+			EntropyPool pool([&isCollecting]()
+			{
+				isCollecting = true;
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+				return std::vector<byte>(32, 0x55);
+			}, 1);
+
+			std::vector<byte> otp(32);
+			pool.Extract(otp);
+			isCollecting = false;
+
+			for (size_t i = 0; i < 100 && !isCollecting; ++i)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			}
+
+			if (!isCollecting)
+			{
+				throw TestException("DestructionCheck: The refresh thread was not started! -DC1");
+			}
+		}
+
+		// a pool that was never started, and one destroyed directly after starting
+		{
+			EntropyPool pool([]() { return std::vector<byte>(32, 0x55); }, 1);
+		}
+		{
+			EntropyPool pool([]() { return std::vector<byte>(32, 0x55); }, 1);
+			std::vector<byte> otp(32);
+			pool.Extract(otp);
+		}
+	}
+
+	void EntropyPoolTest::ExtractionCheck()
+	{
+		// lengths within a block, on a block boundary and across several blocks
+		const std::vector<size_t> OTPLEN = { 1, 63, 64, 65, 128, 1000 };
+		EntropyPool pool([]() { return std::vector<byte>(32, 0x55); }, 60000);
+
+		for (size_t i = 0; i < OTPLEN.size(); ++i)
+		{
+			std::vector<byte> otp1(OTPLEN[i], 0);
+			std::vector<byte> otp2(OTPLEN[i], 0);
+
+			pool.Extract(otp1);
+			pool.Extract(otp2);
+
+			// the pool is ratcheted after every block, the same collection never repeats an output
+			if (otp1 == otp2)
+			{
+				throw TestException("ExtractionCheck: The pool output is repeating! -EC1");
+			}
+
+			if (OTPLEN[i] >= 16 && (otp1 == std::vector<byte>(OTPLEN[i], 0) || otp2 == std::vector<byte>(OTPLEN[i], 0)))
+			{
+				throw TestException("ExtractionCheck: The output was not filled! -EC2");
+			}
+		}
+
+		std::vector<byte> otp(0);
+		pool.Extract(otp);
+	}
+
+	void EntropyPoolTest::FailureCheck()
+	{
+		// a collector that always fails leaves the pool unseeded
+		{
+			EntropyPool pool([]() -> std::vector<byte> { throw std::runtime_error("collector failure"); }, 60000);
+			std::vector<byte> otp(32);
+
+			try
+			{
+				pool.Extract(otp);
+
+				throw TestException("FailureCheck: An unseeded pool was extracted! -FC1");
+			}
+			catch (Exception::CryptoRandomException const &)
+			{
+			}
+
+			if (pool.IsSeeded() || pool.RefreshFailures() != 1 || pool.RefreshCount() != 0)
+			{
+				throw TestException("FailureCheck: The failure counters are incorrect! -FC2");
+			}
+		}
+
+		// a failing collection after the pool is seeded is counted, and the pool remains usable
+		{
+			std::atomic<size_t> calls(0);
+			EntropyPool pool([&calls]() -> std::vector<byte>
+			{
+				if (++calls % 2 == 0)
+				{
+					throw std::runtime_error("collector failure");
+				}
+
+				return std::vector<byte>(32, 0x55);
+			}, 60000);
+
+			std::vector<byte> otp(32);
+
+			if (!pool.Refresh() || pool.Refresh() || !pool.Refresh())
+			{
+				throw TestException("FailureCheck: The refresh result is incorrect! -FC3");
+			}
+
+			if (!pool.IsSeeded() || pool.RefreshCount() != 2 || pool.RefreshFailures() != 1)
+			{
+				throw TestException("FailureCheck: The failure counters are incorrect! -FC4");
+			}
+
+			pool.Extract(otp);
+		}
+	}
+
+	void EntropyPoolTest::ForkCheck()
+	{
+#if !defined(CEX_OS_WINDOWS) && !defined(CEX_OS_ANDROID)
+		// a short interval, so the parents refresh thread is often waiting on its signal or collecting when the process forks
+		std::unique_ptr<EntropyPool> pool(new EntropyPool([]()
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+
+			return std::vector<byte>(32, 0x55);
+		}, 1));
+
+		std::vector<byte> otp(32);
+		pool->Extract(otp);
+
+		for (size_t i = 0; i < 20; ++i)
+		{
+			const pid_t PID = ::fork();
+
+			if (PID < 0)
+			{
+				throw TestException("ForkCheck: The process could not be forked! -FK1");
+			}
+
+			if (PID == 0)
+			{
+				// a child that deadlocks is ended by the alarm, and reported by the parent
+				::alarm(10);
+				int ret = 0;
+
+				try
+				{
+					// the extraction starts a refresh thread in the child, which must refresh the pool, and stop when the pool is destroyed
+					pool->Extract(otp);
+					const ulong RFHCNT = pool->RefreshCount();
+
+					for (size_t j = 0; j < 200 && pool->RefreshCount() == RFHCNT; ++j)
+					{
+						std::this_thread::sleep_for(std::chrono::milliseconds(1));
+					}
+
+					ret = (pool->RefreshCount() != RFHCNT) ? 0 : 1;
+					pool.reset();
+				}
+				catch (...)
+				{
+					ret = 2;
+				}
+
+				::_exit(ret);
+			}
+
+			int status = 0;
+
+			if (::waitpid(PID, &status, 0) != PID || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+			{
+				throw TestException("ForkCheck: The pool failed or deadlocked in the forked process! -FK2");
+			}
+
+			pool->Extract(otp);
+		}
+#endif
+	}
+
+	void EntropyPoolTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	void EntropyPoolTest::RefreshCheck()
+	{
+		std::atomic<size_t> calls(0);
+		EntropyPool pool([&calls]()
+		{
+			++calls;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+			return std::vector<byte>(32, static_cast<byte>(calls));
+		}, 5);
+
+		std::vector<byte> otp(32);
+		pool.Extract(otp);
+
+		// the background thread refreshes the pool at the interval
+		for (size_t i = 0; i < 200 && pool.RefreshCount() < 4; ++i)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+
+		if (pool.RefreshCount() < 4)
+		{
+			throw TestException("RefreshCheck: The pool was not refreshed by the background thread! -RC1");
+		}
+
+		// refreshes on the calling thread and the background thread update the counters concurrently
+		for (size_t i = 0; i < 20; ++i)
+		{
+			pool.Refresh();
+		}
+
+		if (pool.RefreshFailures() != 0 || pool.RefreshLatency() == 0 || pool.RefreshLatencyMax() < pool.RefreshLatency())
+		{
+			throw TestException("RefreshCheck: The latency counters are incorrect! -RC2");
+		}
+
+		if (pool.Age() > 1000)
+		{
+			throw TestException("RefreshCheck: The pool age is incorrect! -RC3");
+		}
+	}
+
+	void EntropyPoolTest::SeedCheck()
+	{
+		std::atomic<size_t> calls(0);
+		EntropyPool pool([&calls]()
+		{
+			++calls;
+
+			return std::vector<byte>(32, 0x55);
+		}, 60000);
+
+		if (pool.IsSeeded() || pool.RefreshCount() != 0 || pool.Age() != 0)
+		{
+			throw TestException("SeedCheck: The pool state is incorrect before the first extraction! -SC1");
+		}
+
+		// the first extraction seeds the pool on the calling thread
+		std::vector<byte> otp(32);
+		pool.Extract(otp);
+
+		if (!pool.IsSeeded() || pool.RefreshCount() != 1 || calls != 1)
+		{
+			throw TestException("SeedCheck: The pool was not seeded by the first extraction! -SC2");
+		}
+
+		// later extractions do not wait on a collection
+		pool.Extract(otp);
+
+		if (calls != 1)
+		{
+			throw TestException("SeedCheck: An extraction ran the collector! -SC3");
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef CEXTEST_ENTROPYPOOLTEST_H
+#define CEXTEST_ENTROPYPOOLTEST_H
+
+#include "ITest.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests the EntropyPool class.
+	/// <para>Checks that the pool is seeded by the first extraction, that extractions of any length are filled and distinct, that the background thread refreshes the pool
+	/// and maintains the health counters, that collector failures are counted and an unseeded pool refuses to extract, and that a pool can be destroyed while its thread is collecting.</para>
+	/// </summary>
+	class EntropyPoolTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Tests the entropy pool
+		/// </summary>
+		EntropyPoolTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~EntropyPoolTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void DestructionCheck();
+		void ExtractionCheck();
+		void FailureCheck();
+		void ForkCheck();
+		void OnProgress(std::string Data);
+		void RefreshCheck();
+		void SeedCheck();
+	};
+}
+
+#endif
@@ -61,6 +61,8 @@ namespace Test
 			OnProgress(std::string("SHX: Passed SHX Monte Carlo tests.."));
 			THXMonteCarlo();
 			OnProgress(std::string("THX: Passed THX Monte Carlo tests.."));
+			ScheduleExport();
+			OnProgress(std::string("HXCipherTest: Passed key schedule export and import tests.."));
 
 			return SUCCESS;
 		}
@@ -548,4 +550,125 @@ namespace Test
 			}
 		}
 	}
+
+	void HXCipherTest::ScheduleCompare(IBlockCipher* Engine, IBlockCipher* Clone, IBlockCipher* Other, std::vector<byte> &Material)
+	{
+		std::vector<byte> inpBytes(16, 0);
+		std::vector<byte> outBytes(16, 0);
+		std::vector<byte> otpBytes(16, 0);
+		std::vector<byte> schedule(0);
+		Key::Symmetric::SymmetricKey k(Material);
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			const bool ENCRYPT = (i == 0);
+
+			Engine->Initialize(ENCRYPT, k);
+			Engine->ExportSchedule(schedule);
+			Clone->ImportSchedule(schedule);
+
+			if (Clone->IsEncryption() != ENCRYPT || Clone->Rounds() != Engine->Rounds())
+			{
+				throw TestException("ScheduleExport: The imported cipher state is invalid! -SC1");
+			}
+
+			// the header records the input key size in bits
+			if (Utility::IntUtils::LeBytesTo32(schedule, 4) != Material.size() * 8 || Clone->Name() != Engine->Name())
+			{
+				throw TestException("ScheduleExport: The schedule key size is invalid! -SC5");
+			}
+
+			for (size_t j = 0; j != 100; ++j)
+			{
+				Engine->Transform(inpBytes, 0, outBytes, 0);
+				Clone->Transform(inpBytes, 0, otpBytes, 0);
+
+				if (outBytes != otpBytes)
+				{
+					throw TestException("ScheduleExport: The imported cipher output is not equal! -SC2");
+				}
+
+				inpBytes = outBytes;
+			}
+
+			// the schedule must be rejected by a different cipher type
+			try
+			{
+				Other->ImportSchedule(schedule);
+				throw TestException("ScheduleExport: The schedule was imported by another cipher type! -SC3");
+			}
+			catch (Exception::CryptoSymmetricCipherException const &)
+			{
+			}
+
+			// and a truncated schedule by the same type
+			schedule.resize(schedule.size() - sizeof(uint));
+
+			try
+			{
+				Clone->ImportSchedule(schedule);
+				throw TestException("ScheduleExport: A truncated schedule was imported! -SC4");
+			}
+			catch (Exception::CryptoSymmetricCipherException const &)
+			{
+			}
+		}
+	}
+
+	void HXCipherTest::ScheduleExport()
+	{
+		Common::CpuDetect detect;
+
+#if defined(__AVX__)
+		if (detect.AESNI())
+		{
+			AHX* cpr = new AHX(Digests::SHA512, 22);
+			AHX* cln = new AHX(Digests::SHA512, 22);
+			RHX* oth = new RHX();
+			ScheduleCompare(cpr, cln, oth, m_key);
+			delete cpr;
+			delete cln;
+			delete oth;
+		}
+#endif
+
+		// hkdf extended key schedules; a schedule is imported by an instance that is also hkdf extended
+		{
+			RHX* cpr = new RHX(Digests::SHA512, 22);
+			RHX* cln = new RHX(Digests::SHA512, 22);
+			SHX* oth = new SHX();
+			ScheduleCompare(cpr, cln, oth, m_key);
+			delete cpr;
+			delete cln;
+			delete oth;
+		}
+		{
+			SHX* cpr = new SHX(Digests::SHA512, 40);
+			SHX* cln = new SHX(Digests::SHA512, 40);
+			THX* oth = new THX();
+			ScheduleCompare(cpr, cln, oth, m_key);
+			delete cpr;
+			delete cln;
+			delete oth;
+		}
+		{
+			THX* cpr = new THX(Digests::SHA512, 20);
+			THX* cln = new THX(Digests::SHA512, 20);
+			RHX* oth = new RHX();
+			ScheduleCompare(cpr, cln, oth, m_key);
+			delete cpr;
+			delete cln;
+			delete oth;
+		}
+		// standard 512 bit key schedule
+		{
+			THX* cpr = new THX(Digests::None, 20);
+			THX* cln = new THX();
+			SHX* oth = new SHX();
+			ScheduleCompare(cpr, cln, oth, m_key2);
+			delete cpr;
+			delete cln;
+			delete oth;
+		}
+	}
 }
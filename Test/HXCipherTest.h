@@ -2,6 +2,7 @@
 #define CEXTEST_HXCIPHERTEST_H
 
 #include "ITest.h"
+#include "../CEX/IBlockCipher.h"
 
 namespace Test
 {
@@ -56,6 +57,8 @@ namespace Test
 
 		void Initialize();
 		void OnProgress(std::string Data);
+		void ScheduleCompare(Cipher::Symmetric::Block::IBlockCipher* Engine, Cipher::Symmetric::Block::IBlockCipher* Clone, Cipher::Symmetric::Block::IBlockCipher* Other, std::vector<byte> &Material);
+		void ScheduleExport();
 #if defined(__AVX__)
 		void AHXMonteCarlo();
 #endif
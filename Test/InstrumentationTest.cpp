@@ -0,0 +1,338 @@
+#include "InstrumentationTest.h"
+#include "../CEX/CSG.h"
+#include "../CEX/CTR.h"
+#include "../CEX/ModuleLWE.h"
+#include "../CEX/SHA256.h"
+#include "../CEX/SymmetricKey.h"
+#include <thread>
+
+namespace Test
+{
+	using Common::Instrumentation;
+	using Cipher::Symmetric::Block::Mode::CTR;
+	using Drbg::CSG;
+	using Enumeration::InstrumentGroups;
+	using Enumeration::InstrumentPhases;
+	using Digest::SHA256;
+
+	const std::string InstrumentationTest::DESCRIPTION = "Instrumentation counter, path mark, thread folding and export tests.";
+	const std::string InstrumentationTest::FAILURE = "FAILURE! ";
+	const std::string InstrumentationTest::SUCCESS = "SUCCESS! All Instrumentation tests have executed succesfully.";
+
+	InstrumentationTest::InstrumentationTest()
+		:
+		m_progressEvent()
+	{
+	}
+
+	InstrumentationTest::~InstrumentationTest()
+	{
+	}
+
+	const std::string InstrumentationTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &InstrumentationTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string InstrumentationTest::Run()
+	{
+		try
+		{
+			if (!Instrumentation::Enabled())
+			{
+				DisabledTest();
+				OnProgress(std::string("InstrumentationTest: The library is built without CEX_INSTRUMENTATION; passed the empty counter tests.."));
+
+				return SUCCESS;
+			}
+
+			CounterTest();
+			OnProgress(std::string("InstrumentationTest: Passed call and byte counter tests.."));
+			PathTest();
+			OnProgress(std::string("InstrumentationTest: Passed parallel, SIMD and reseed path mark tests.."));
+			ThreadTest();
+			OnProgress(std::string("InstrumentationTest: Passed exited thread folding tests.."));
+			PhaseTest();
+			OnProgress(std::string("InstrumentationTest: Passed asymmetric phase step tests.."));
+			AllocationTest();
+			OnProgress(std::string("InstrumentationTest: Passed allocation attribution tests.."));
+			ExportTest();
+			OnProgress(std::string("InstrumentationTest: Passed metrics export tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void InstrumentationTest::AllocationTest()
+	{
+		Instrumentation::Reset();
+		// an allocation outside a timed call is not attributed
+		Instrumentation::RecordAllocation(32);
+
+		{
+			Instrumentation::CallScope scope(Instrumentation::Register(InstrumentGroups::Digest, "InstrumentationTest", "AllocationTest"), 0);
+			Instrumentation::RecordAllocation(64);
+			Instrumentation::RecordAllocation(128);
+		}
+
+		Instrumentation::SiteRecord rec = Find("InstrumentationTest", "AllocationTest");
+
+		if (rec.Calls != 1 || rec.Allocations != 2 || rec.AllocatedBytes != 192)
+		{
+			throw TestException("AllocationTest: The allocations were not attributed to the enclosing call!");
+		}
+	}
+
+	void InstrumentationTest::CounterTest()
+	{
+		std::vector<byte> msg(1000);
+		std::vector<byte> code(32);
+		SHA256 dgt;
+
+		Instrumentation::Reset();
+		dgt.Update(msg, 0, 10);
+		dgt.Update(msg, 0, 100);
+		dgt.Update(msg, 0, 1000);
+		dgt.Finalize(code, 0);
+
+		Instrumentation::SiteRecord upd = Find("SHA256", "Update");
+		Instrumentation::SiteRecord fnl = Find("SHA256", "Finalize");
+
+		if (upd.Group != InstrumentGroups::Digest || upd.Calls != 3 || upd.Bytes != 1110)
+		{
+			throw TestException("CounterTest: The Update counters are incorrect!");
+		}
+		if (fnl.Calls != 1 || fnl.Bytes != 0)
+		{
+			throw TestException("CounterTest: The Finalize counters are incorrect!");
+		}
+		if (upd.Cycles == 0 || upd.ParallelCalls != 0)
+		{
+			throw TestException("CounterTest: The Update timer or path counters are incorrect!");
+		}
+
+		Instrumentation::Reset();
+
+		if (Find("SHA256", "Update").Calls != 0)
+		{
+			throw TestException("CounterTest: The counters were not reset!");
+		}
+	}
+
+	void InstrumentationTest::DisabledTest()
+	{
+		std::vector<byte> msg(1000);
+		std::vector<byte> code(32);
+		SHA256 dgt;
+
+		dgt.Update(msg, 0, msg.size());
+		dgt.Finalize(code, 0);
+
+		if (Instrumentation::Snapshot().size() != 0)
+		{
+			throw TestException("DisabledTest: A call site was registered in an uninstrumented build!");
+		}
+	}
+
+	void InstrumentationTest::ExportTest()
+	{
+		std::vector<byte> msg(100);
+		std::vector<byte> code(32);
+		SHA256 dgt;
+
+		Instrumentation::Reset();
+		dgt.Update(msg, 0, msg.size());
+		dgt.Update(msg, 0, msg.size());
+		dgt.Finalize(code, 0);
+
+		const std::string TXT = Instrumentation::Export();
+
+		if (TXT.find("# TYPE cex_calls_total counter\n") == std::string::npos ||
+			TXT.find("# TYPE cex_simd_width_bits gauge\n") == std::string::npos)
+		{
+			throw TestException("ExportTest: The metric type lines are missing!");
+		}
+		if (TXT.find("cex_calls_total{group=\"digest\",primitive=\"SHA256\",function=\"Update\"} 2\n") == std::string::npos ||
+			TXT.find("cex_bytes_total{group=\"digest\",primitive=\"SHA256\",function=\"Update\"} 200\n") == std::string::npos)
+		{
+			throw TestException("ExportTest: The exported counters are incorrect!");
+		}
+		// sites without calls are omitted
+		if (TXT.find("AllocationTest") != std::string::npos)
+		{
+			throw TestException("ExportTest: An idle call site was exported!");
+		}
+	}
+
+	Instrumentation::SiteRecord InstrumentationTest::Find(const std::string &Name, const std::string &Function)
+	{
+		std::vector<Instrumentation::SiteRecord> recs = Instrumentation::Snapshot();
+
+		for (size_t i = 0; i < recs.size(); ++i)
+		{
+			if (recs[i].Name == Name && recs[i].Function == Function)
+			{
+				return recs[i];
+			}
+		}
+
+		return Instrumentation::SiteRecord();
+	}
+
+	void InstrumentationTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	void InstrumentationTest::PathTest()
+	{
+		std::vector<byte> key(32, 0x01);
+		std::vector<byte> nonce(16, 0x02);
+		Key::Symmetric::SymmetricKey kp(key, nonce);
+		CTR cpr(Enumeration::BlockCiphers::Rijndael);
+
+		cpr.Initialize(true, kp);
+
+		const size_t PRLBLK = cpr.ParallelProfile().ParallelBlockSize();
+		std::vector<byte> msg(PRLBLK);
+		std::vector<byte> enc(PRLBLK);
+
+		Instrumentation::Reset();
+		cpr.ParallelProfile().IsParallel() = true;
+		cpr.Transform(msg, 0, enc, 0, PRLBLK);
+		cpr.ParallelProfile().IsParallel() = false;
+		cpr.Transform(msg, 0, enc, 0, PRLBLK);
+
+		Instrumentation::SiteRecord rec = Find("CTR", "Transform");
+
+		if (rec.Group != InstrumentGroups::CipherMode || rec.Calls != 2 || rec.Bytes != 2 * PRLBLK)
+		{
+			throw TestException("PathTest: The Transform counters are incorrect!");
+		}
+		if (rec.ParallelCalls != 1)
+		{
+			throw TestException("PathTest: The parallel path was not counted once!");
+		}
+#if defined(__AVX__)
+		// the sequential call generates the key stream with the widest compiled vector path
+		if (rec.SimdWidth == 0)
+		{
+			throw TestException("PathTest: The SIMD width was not recorded!");
+		}
+#endif
+
+		std::vector<byte> seed(32, 0x03);
+		std::vector<byte> otp(64);
+		CSG gen(Enumeration::ShakeModes::SHAKE256, Enumeration::Providers::None);
+
+		gen.Initialize(seed);
+		gen.Update(seed);
+		gen.Generate(otp, 0, otp.size());
+
+		if (Find("CSG", "Update").Reseeds != 1 || Find("CSG", "Generate").Bytes != otp.size())
+		{
+			throw TestException("PathTest: The generator counters are incorrect!");
+		}
+	}
+
+	void InstrumentationTest::PhaseTest()
+	{
+		const std::string HSHNME = Instrumentation::PhaseName(InstrumentPhases::Hashing);
+		const std::string PCKNME = Instrumentation::PhaseName(InstrumentPhases::Packing);
+		std::vector<byte> msg(64 * 1024);
+		std::vector<byte> code(32);
+
+		Instrumentation::Reset();
+
+		{
+			Instrumentation::CallScope outer(Instrumentation::Register(InstrumentGroups::Phase, PCKNME, "PhaseTest"), 0, true);
+
+			{
+				// the nested step does the work, and is excluded from the enclosing step
+				Instrumentation::CallScope inner(Instrumentation::Register(InstrumentGroups::Phase, HSHNME, "PhaseTest"), 0, true);
+				SHA256 dgt;
+
+				dgt.Update(msg, 0, msg.size());
+				dgt.Finalize(code, 0);
+			}
+		}
+
+		Instrumentation::SiteRecord pck = Find(PCKNME, "PhaseTest");
+		Instrumentation::SiteRecord hsh = Find(HSHNME, "PhaseTest");
+
+		if (pck.Group != InstrumentGroups::Phase || pck.Calls != 1 || hsh.Calls != 1)
+		{
+			throw TestException("PhaseTest: The phase counters are incorrect!");
+		}
+		if (hsh.Cycles == 0 || pck.Cycles >= hsh.Cycles)
+		{
+			throw TestException("PhaseTest: The nested phase step was not excluded from the enclosing step!");
+		}
+		// a non-phase call nested in a phase step is included in the step
+		if (Find("SHA256", "Update").Cycles > hsh.Cycles)
+		{
+			throw TestException("PhaseTest: The nested digest call was excluded from the phase step!");
+		}
+
+		Cipher::Asymmetric::MLWE::ModuleLWE cpr(Enumeration::MLWEParams::Q7681N256K2);
+		Key::Asymmetric::IAsymmetricKeyPair* kp = cpr.Generate();
+
+		delete kp->PublicKey();
+		delete kp->PrivateKey();
+		delete kp;
+
+		if (Find(Instrumentation::PhaseName(InstrumentPhases::MatrixExpansion), "GenerateMatrix").Calls == 0)
+		{
+			throw TestException("PhaseTest: The key generation phases were not counted!");
+		}
+	}
+
+	void InstrumentationTest::ThreadTest()
+	{
+		const size_t THDCNT = 2;
+		const size_t UPDCNT = 5;
+		std::vector<std::thread> thds;
+
+		Instrumentation::Reset();
+
+		for (size_t i = 0; i < THDCNT; ++i)
+		{
+			thds.push_back(std::thread([UPDCNT]()
+			{
+				std::vector<byte> msg(64);
+				SHA256 dgt;
+
+				for (size_t j = 0; j < UPDCNT; ++j)
+				{
+					dgt.Update(msg, 0, msg.size());
+				}
+			}));
+		}
+
+		for (size_t i = 0; i < thds.size(); ++i)
+		{
+			thds[i].join();
+		}
+
+		// the exited threads folded their counts into the process totals
+		Instrumentation::SiteRecord rec = Find("SHA256", "Update");
+
+		if (rec.Calls != THDCNT * UPDCNT || rec.Bytes != THDCNT * UPDCNT * 64)
+		{
+			throw TestException("ThreadTest: The thread counters were not folded into the totals!");
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#ifndef CEXTEST_INSTRUMENTATIONTEST_H
+#define CEXTEST_INSTRUMENTATIONTEST_H
+
+#include "ITest.h"
+#include "../CEX/Instrumentation.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests the boundary instrumentation counters.
+	/// <para>When the library is built with CEX_INSTRUMENTATION, checks the call and byte counts of a digest, the path marks of a cipher mode and a generator,
+	/// the folding of exited thread counters, allocation attribution, and the exported metrics text; otherwise checks that no site is counted.</para>
+	/// </summary>
+	class InstrumentationTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Tests the instrumentation counters and export
+		/// </summary>
+		InstrumentationTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~InstrumentationTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void AllocationTest();
+		void CounterTest();
+		void DisabledTest();
+		void ExportTest();
+		Common::Instrumentation::SiteRecord Find(const std::string &Name, const std::string &Function);
+		void OnProgress(std::string Data);
+		void PathTest();
+		void PhaseTest();
+		void ThreadTest();
+	};
+}
+
+#endif
@@ -52,6 +52,9 @@ namespace Test
 
 			OnProgress(std::string("KMACTest: Passed KMAC-256 known answer vector tests.."));
 
+			LongKeyTest();
+			OnProgress(std::string("KMACTest: Passed KMAC long key and customization string tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -128,6 +131,49 @@ namespace Test
 		/*lint -restore */
 	}
 
+	void KMACTest::LongKeyTest()
+	{
+		// a key and customization string longer than the rate are padded over several blocks
+		std::vector<byte> key(200);
+		std::vector<byte> custom(150);
+		std::vector<byte> exp128;
+		std::vector<byte> exp256;
+		std::vector<byte> output1(32);
+		std::vector<byte> output2(64);
+
+		for (size_t i = 0; i < key.size(); ++i)
+		{
+			key[i] = static_cast<byte>(i);
+		}
+
+		for (size_t i = 0; i < custom.size(); ++i)
+		{
+			custom[i] = static_cast<byte>((i * 7) + 3);
+		}
+
+		HexConverter::Decode(std::string("B23125B69DF026397027799B0A21BC085702B02D0FA74A71AC5A7DC3AA26CDB9"), exp128);
+		HexConverter::Decode(std::string("2FD1DA2FED123B5BF2BA5DEA18D9F490B249A33E5D6B12D7C1F0B19BFA677B31F63D1C2D9CD5717B713626BAB05B00B6B182F40F48D90C633DA3E929DEB003BE"), exp256);
+
+		SymmetricKey kp(key, custom);
+		KMAC gen1(Enumeration::ShakeModes::SHAKE128);
+		gen1.Initialize(kp);
+		gen1.Compute(m_message[1], output1);
+
+		if (output1 != exp128)
+		{
+			throw TestException("KMACTest: long key return code is not equal!");
+		}
+
+		KMAC gen2(Enumeration::ShakeModes::SHAKE256);
+		gen2.Initialize(kp);
+		gen2.Compute(m_message[1], output2);
+
+		if (output2 != exp256)
+		{
+			throw TestException("KMACTest: long key return code is not equal!");
+		}
+	}
+
 	void KMACTest::OnProgress(std::string Data)
 	{
 		m_progressEvent(Data);
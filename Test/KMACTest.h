@@ -58,6 +58,7 @@ namespace Test
 
 		void CompareVector(Mac::IMac* Generator, std::vector<byte> &Key, std::vector<byte> &Input, std::vector<byte> &Expected);
 		void Initialize();
+		void LongKeyTest();
 		void OnProgress(std::string Data);
 	};
 }
@@ -0,0 +1,227 @@
+#include "KangarooTwelveTest.h"
+#include "../CEX/DigestFromName.h"
+#include "../CEX/KangarooTwelve.h"
+
+namespace Test
+{
+	using Digest::KangarooTwelve;
+
+	const std::string KangarooTwelveTest::DESCRIPTION = "Tests the KangarooTwelve digest in the hash, customized hash, and extended output modes.";
+	const std::string KangarooTwelveTest::FAILURE = "FAILURE! ";
+	const std::string KangarooTwelveTest::SUCCESS = "SUCCESS! All KangarooTwelve tests have executed succesfully.";
+
+	KangarooTwelveTest::KangarooTwelveTest()
+		:
+		m_customLength(0),
+		m_customized(0),
+		m_expected(0),
+		m_msgLength(0),
+		m_progressEvent()
+	{
+		Initialize();
+	}
+
+	KangarooTwelveTest::~KangarooTwelveTest()
+	{
+	}
+
+	const std::string KangarooTwelveTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &KangarooTwelveTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string KangarooTwelveTest::Run()
+	{
+		try
+		{
+			KangarooTwelve* dgt = new KangarooTwelve();
+			HashTest(dgt);
+			delete dgt;
+			OnProgress(std::string("Passed KangarooTwelve hash vector tests.."));
+
+			CustomTest();
+			OnProgress(std::string("Passed KangarooTwelve customized hash vector tests.."));
+
+			XofTest();
+			OnProgress(std::string("Passed KangarooTwelve extended output tests.."));
+
+			StreamTest();
+			OnProgress(std::string("Passed KangarooTwelve long message and random update length tests.."));
+
+			ParallelTest();
+			OnProgress(std::string("Passed KangarooTwelve parallel chunk hashing tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void KangarooTwelveTest::CompareVector(KangarooTwelve* Digest, std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		std::vector<byte> hash(Digest->DigestSize(), 0);
+
+		Digest->Update(Input, 0, Input.size());
+		Digest->Finalize(hash, 0);
+
+		if (Expected != hash)
+		{
+			throw TestException("KangarooTwelveTest: Expected hash is not equal!");
+		}
+
+		Digest->Compute(Input, hash);
+
+		if (Expected != hash)
+		{
+			throw TestException("KangarooTwelveTest: Expected hash is not equal!");
+		}
+	}
+
+	void KangarooTwelveTest::CustomTest()
+	{
+		KangarooTwelve dgt;
+		// the customization string is retained after finalization
+		dgt.Initialize(TestUtils::PatternMessage(41));
+
+		for (size_t i = 0; i < m_customLength.size(); ++i)
+		{
+			std::vector<byte> input = TestUtils::PatternMessage(m_customLength[i]);
+			CompareVector(&dgt, input, m_customized[i]);
+		}
+	}
+
+	void KangarooTwelveTest::HashTest(KangarooTwelve* Digest)
+	{
+		for (size_t i = 0; i < m_msgLength.size(); ++i)
+		{
+			std::vector<byte> input = TestUtils::PatternMessage(m_msgLength[i]);
+			CompareVector(Digest, input, m_expected[i]);
+		}
+	}
+
+	void KangarooTwelveTest::Initialize()
+	{
+		/*lint -save -e417 */
+		// the powers of 17 are the RFC 9861 vectors, the others cross the chunk boundaries and fill the SIMD lanes
+		m_msgLength = { 0, 1, 17, 289, 4913, 8191, 8192, 8193, 16384, 16385, 40960, 65536, 83521, 1419857 };
+
+		const std::vector<std::string> expected =
+		{
+			std::string("1AC2D450FC3B4205D19DA7BFCA1B37513C0803577AC7167F06FE2CE1F0EF39E5"),
+			std::string("2BDA92450E8B147F8A7CB629E784A058EFCA7CF7D8218E02D345DFAA65244A1F"),
+			std::string("6BF75FA2239198DB4772E36478F8E19B0F371205F6A9A93A273F51DF37122888"),
+			std::string("0C315EBCDEDBF61426DE7DCF8FB725D1E74675D7F5327A5067F367B108ECB67C"),
+			std::string("CB552E2EC77D9910701D578B457DDF772C12E322E4EE7FE417F92C758F0D59D0"),
+			std::string("1B577636F723643E990CC7D6A659837436FD6A103626600EB8301CD1DBE553D6"),
+			std::string("48F256F6772F9EDFB6A8B661EC92DC93B95EBD05A08A17B39AE3490870C926C3"),
+			std::string("BB66FE72EAEA5179418D5295EE1344854D8AD7F3FA17EFCB467EC152341284CF"),
+			std::string("82778F7F7234C83352E76837B721FBDBB5270B88010D84FA5AB0B61EC8CE0956"),
+			std::string("5F8D2B943922B451842B4E82740D02369E2D5F9F33C5123509A53B955FE177B2"),
+			std::string("9DABFDD231CEBD91759EC9B4389C72B35080E4974ADC8716E44F16F347759509"),
+			std::string("26FBD1CA564B32EC52F0B4D9A562039AA75EAA1DE7498B07D3B9C6D9A3614706"),
+			std::string("8701045E22205345FF4DDA05555CBB5C3AF1A771C2B89BAEF37DB43D9998B9FE"),
+			std::string("844D610933B1B9963CBDEB5AE3B6B05CC7CBD67CEEDF883EB678A0A8E0371682")
+		};
+		HexConverter::Decode(expected, 14, m_expected);
+
+		// with a 41 byte customization string, 8150 bytes is the longest message that fits a single chunk
+		m_customLength = { 0, 1, 8150, 8151, 8192, 100000 };
+
+		const std::vector<std::string> customized =
+		{
+			std::string("76F06E60FBA37414E0DC56D9D1E5D03B2D38C672B70C8C51D2E00A4FA959F1AA"),
+			std::string("8234D8630D549449DCA134F63793C219C6D60A3EA53F7881C8042C226EA17E1E"),
+			std::string("93C10CD5A1B205A0A3AE0056A85DA2FFBE67E236409B3963013DFA0C51819E09"),
+			std::string("E17AB2091E7BA4069A0A15F44E6BCA4B73CDE65A874FF66021752AA65D8C550B"),
+			std::string("091ED4E214616E37469209E2A7B7F58AB6299BED21DD419E0FF20AF46F51BE35"),
+			std::string("676C714C290716B7E3DB5674AF514AE8C421A3628001F80F97C528E10B6F8B57")
+		};
+		HexConverter::Decode(customized, 6, m_customized);
+		/*lint -restore */
+	}
+
+	void KangarooTwelveTest::ParallelTest()
+	{
+		KangarooTwelve dgs(false);
+		Digest::IDigest* dgp = Helper::DigestFromName::GetInstance(Enumeration::Digests::KangarooTwelve, true);
+		// the chunk tree does not depend on the parallel settings, so both instances produce the same hash
+		const bool ISEQL = TestUtils::DigestParallelEqual(&dgs, dgp);
+
+		delete dgp;
+
+		if (!ISEQL)
+		{
+			throw TestException("KangarooTwelveTest: Parallel hash is not equal!");
+		}
+	}
+
+	void KangarooTwelveTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	void KangarooTwelveTest::StreamTest()
+	{
+		const size_t MSGLEN = (4 * 1024 * 1024) + 1;
+		std::vector<byte> input(MSGLEN);
+		std::vector<byte> expect;
+		std::vector<byte> hash(32);
+		KangarooTwelve dgt;
+
+		for (size_t i = 0; i < input.size(); ++i)
+		{
+			input[i] = static_cast<byte>((i * 31) + 7);
+		}
+
+		HexConverter::Decode(std::string("A8629C93ACF25E70490E3719E7B84B1B53941D106E545ED7187D2D26BA67F220"), expect);
+		dgt.Compute(input, hash);
+
+		if (hash != expect)
+		{
+			throw TestException("KangarooTwelveTest: Long message hash is not equal!");
+		}
+
+		// update lengths of up to three chunks cross the block and chunk boundaries at arbitrary offsets
+		if (!TestUtils::DigestUpdateEqual(&dgt, input, (3 * 8192) + 1))
+		{
+			throw TestException("KangarooTwelveTest: Partial update hash is not equal!");
+		}
+	}
+
+	void KangarooTwelveTest::XofTest()
+	{
+		// the last 32 bytes of a 10032 byte output of the empty message, from RFC 9861
+		std::vector<byte> input(0);
+		std::vector<byte> expect;
+		std::vector<byte> output(10032);
+		std::vector<byte> prefix(32);
+		KangarooTwelve dgt;
+
+		HexConverter::Decode(std::string("E8DC563642F7228C84684C898405D3A834799158C079B12880277A1D28E2FF6D"), expect);
+		dgt.Finalize(output, 0, output.size());
+
+		if (!std::equal(expect.begin(), expect.end(), output.end() - expect.size()))
+		{
+			throw TestException("KangarooTwelveTest: Extended output is not equal!");
+		}
+
+		// the default output is a prefix of the extended output
+		dgt.Compute(input, prefix);
+
+		if (!std::equal(prefix.begin(), prefix.end(), output.begin()))
+		{
+			throw TestException("KangarooTwelveTest: Extended output prefix is not equal!");
+		}
+	}
+}
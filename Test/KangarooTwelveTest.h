@@ -0,0 +1,68 @@
+#ifndef CEXTEST_KANGAROOTWELVETEST_H
+#define CEXTEST_KANGAROOTWELVETEST_H
+
+#include "ITest.h"
+#include "../CEX/KangarooTwelve.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests the KangarooTwelve digest implementation using vector comparisons.
+	/// <para>Tests the hash and customized hash modes with the RFC 9861 test vectors, and vectors generated by the XKCP implementation across the chunk boundaries:
+	/// <see href="https://www.rfc-editor.org/rfc/rfc9861"/></para>
+	/// </summary>
+	class KangarooTwelveTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		std::vector<size_t> m_customLength;
+		std::vector<std::vector<byte>> m_customized;
+		std::vector<std::vector<byte>> m_expected;
+		std::vector<size_t> m_msgLength;
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Known answer tests for the KangarooTwelve digest
+		/// </summary>
+		KangarooTwelveTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~KangarooTwelveTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void CompareVector(Digest::KangarooTwelve* Digest, std::vector<byte> &Input, std::vector<byte> &Expected);
+		void CustomTest();
+		void HashTest(Digest::KangarooTwelve* Digest);
+		void Initialize();
+		void OnProgress(std::string Data);
+		void ParallelTest();
+		void StreamTest();
+		void XofTest();
+	};
+}
+
+#endif
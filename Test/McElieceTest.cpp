@@ -51,6 +51,8 @@ namespace Test
 			OnProgress(std::string("McElieceTest: Passed encryption and decryption stress tests.."));
 			SerializationCompare();
 			OnProgress(std::string("McElieceTest: Passed key serialization tests.."));
+			PrivateKeyRoundTrip();
+			OnProgress(std::string("McElieceTest: Passed private key round trip test.."));
 
 			return SUCCESS;
 		}
@@ -191,6 +193,50 @@ namespace Test
 		delete pubK1;
 	}
 
+	void McElieceTest::PrivateKeyRoundTrip()
+	{
+		std::vector<byte> cpt(0);
+		std::vector<byte> sec1(0);
+		std::vector<byte> sec2(0);
+
+		McEliece cpr(Enumeration::MPKCParams::M12T62, m_rngPtr);
+		IAsymmetricKeyPair* kp = cpr.Generate();
+		MPKCPrivateKey* priK1 = (MPKCPrivateKey*)kp->PrivateKey();
+		const std::vector<byte> S1 = priK1->S();
+		std::vector<byte> skey = priK1->ToBytes();
+
+		// serializing the key must not change it
+		if (priK1->S() != S1)
+		{
+			throw TestException("McElieceTest: Private key serialization has modified the key!");
+		}
+
+		MPKCPrivateKey priK2(skey);
+
+		if (priK2.S() != S1 || priK2.ToBytes() != skey)
+		{
+			throw TestException("McElieceTest: Private key round trip test has failed!");
+		}
+
+		// the restored key decapsulates the secret of the original key pair
+		cpr.Initialize(true, kp->PublicKey());
+		cpr.Encapsulate(cpt, sec1);
+
+		McEliece cpr2(Enumeration::MPKCParams::M12T62, m_rngPtr);
+		cpr2.Initialize(false, &priK2);
+		cpr2.Decapsulate(cpt, sec2);
+
+		if (sec1 != sec2)
+		{
+			throw TestException("McElieceTest: Decapsulation with the restored private key has failed!");
+		}
+
+		IAsymmetricKey* pubK1 = kp->PublicKey();
+		delete kp;
+		delete priK1;
+		delete pubK1;
+	}
+
 	void McElieceTest::StressLoop()
 	{
 		std::vector<byte> enc;
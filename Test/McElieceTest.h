@@ -55,6 +55,7 @@ namespace Test
 		void OnProgress(std::string Data);
 		void StressLoop();
 		void SerializationCompare();
+		void PrivateKeyRoundTrip();
 	};
 }
 
@@ -0,0 +1,203 @@
+#include "ParallelHashTest.h"
+#include "../CEX/DigestFromName.h"
+#include "../CEX/SecureRandom.h"
+
+namespace Test
+{
+	using Digest::ParallelHash;
+	using Enumeration::ShakeModes;
+
+	const std::string ParallelHashTest::DESCRIPTION = "SP800-185 Test Vectors for ParallelHash128 and ParallelHash256.";
+	const std::string ParallelHashTest::FAILURE = "FAILURE! ";
+	const std::string ParallelHashTest::SUCCESS = "SUCCESS! All ParallelHash tests have executed succesfully.";
+
+	ParallelHashTest::ParallelHashTest()
+		:
+		m_custom(0),
+		m_expected(0),
+		m_msgLength(0),
+		m_sample(0),
+		m_progressEvent()
+	{
+		Initialize();
+	}
+
+	ParallelHashTest::~ParallelHashTest()
+	{
+	}
+
+	const std::string ParallelHashTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &ParallelHashTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string ParallelHashTest::Run()
+	{
+		try
+		{
+			SampleTest();
+			OnProgress(std::string("ParallelHashTest: Passed ParallelHash NIST sample vector tests.."));
+
+			HashTest(ShakeModes::SHAKE128, 4);
+			OnProgress(std::string("ParallelHashTest: Passed ParallelHash128 known answer vector tests.."));
+
+			HashTest(ShakeModes::SHAKE256, 13);
+			OnProgress(std::string("ParallelHashTest: Passed ParallelHash256 known answer vector tests.."));
+
+			StreamTest();
+			OnProgress(std::string("ParallelHashTest: Passed ParallelHash random update length tests.."));
+
+			ParallelTest();
+			OnProgress(std::string("ParallelHashTest: Passed ParallelHash parallel leaf hashing tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void ParallelHashTest::CompareVector(ParallelHash* Digest, std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		std::vector<byte> hash(Digest->DigestSize(), 0);
+
+		Digest->Update(Input, 0, Input.size());
+		Digest->Finalize(hash, 0);
+
+		if (Expected != hash)
+		{
+			throw TestException("ParallelHashTest: Expected hash is not equal!");
+		}
+
+		Digest->Compute(Input, hash);
+
+		if (Expected != hash)
+		{
+			throw TestException("ParallelHashTest: Expected hash is not equal!");
+		}
+	}
+
+	void ParallelHashTest::HashTest(ShakeModes ShakeMode, size_t Index)
+	{
+		ParallelHash dgt(ShakeMode);
+
+		for (size_t i = 0; i < m_msgLength.size(); ++i)
+		{
+			std::vector<byte> input = TestUtils::PatternMessage(m_msgLength[i]);
+			CompareVector(&dgt, input, m_expected[Index + i]);
+		}
+
+		// the customization string is retained after finalization
+		std::vector<byte> input = TestUtils::PatternMessage(100000);
+		dgt.Initialize(TestUtils::PatternMessage(41));
+		CompareVector(&dgt, input, m_expected[Index + m_msgLength.size()]);
+		CompareVector(&dgt, input, m_expected[Index + m_msgLength.size()]);
+	}
+
+	void ParallelHashTest::Initialize()
+	{
+		/*lint -save -e417 */
+		HexConverter::Decode(std::string("000102030405060710111213141516172021222324252627"), m_sample);
+
+		const std::vector<std::string> custom =
+		{
+			std::string(""),
+			std::string("506172616C6C656C2044617461")
+		};
+		HexConverter::Decode(custom, 2, m_custom);
+
+		// whole and partial leaves, eight whole leaves that fill the widest SIMD lanes, and enough leaves for several passes
+		m_msgLength = { 0, 1, 8191, 8192, 8193, 40960, 65536, 300000 };
+
+		const std::vector<std::string> expected =
+		{
+			// NIST samples 1 and 2 of ParallelHash128, and samples 4 and 5 of ParallelHash256
+			std::string("BA8DC1D1D979331D3F813603C67F72609AB5E44B94A0B8F9AF46514454A2B4F5"),
+			std::string("FC484DCB3F84DCEEDC353438151BEE58157D6EFED0445A81F165E495795B7206"),
+			std::string("BC1EF124DA34495E948EAD207DD9842235DA432D2BBC54B4C110E64C451105531B7F2A3E0CE055C02805E7C2DE1FB746AF97A1DD01F43B824E31B87612410429"),
+			std::string("CDF15289B54F6212B4BC270528B49526006DD9B54E2B6ADD1EF6900DDA3963BB33A72491F236969CA8AFAEA29C682D47A393C065B38E29FAE651A2091C833110"),
+			// ParallelHash128 with an 8192 byte leaf
+			std::string("C7B32E3B071F7FB9C58054C93C2F35E0D8051A270D6C0136EF849232C96CD1C5"),
+			std::string("69A7A9ED1CF716F744A1047F7BA896F3DBADD81B22040C3C9660CDE12F934848"),
+			std::string("678020237713859800DBDD1CF1BE09FB71CDB6502C1B3AEAE9B9F9A03A3E94C9"),
+			std::string("ED294645BC17F5AA4A193F1FC6F0849A7B4E7D585971289793BC6A2FE7565527"),
+			std::string("E44E93DABD59044E800747ACCE1B2F480B2F4A53E250164900C9CC6FAF8D2CCB"),
+			std::string("2C5F5DF8658A5E2EEC85EE6B744DC9C4C06D26693F6609DF3B439D94BF281EB6"),
+			std::string("7A4DB3B18BE5E8A12CBF528D7DA836B5D289892B0B6E7F9905C8097BE6AB9AD7"),
+			std::string("A73310CA24DC8653FDE9B5FCB88EA648561C664B1C9AE372108AE1500BF0EA78"),
+			std::string("427E0B8E25C723E4469647B05AB5C218E61A057647101352C6372C2AA3ACE286"),
+			// ParallelHash256 with an 8192 byte leaf
+			std::string("FE94D54EC0A5083A8880B4B4102BA049708ED8D2FD83F489FA5490BA9BF994AB35D8DAA2340BBDB9B7B010851DF783C7954AF215F8EBC5FE3A206602077CB384"),
+			std::string("0530A1F21D614AF373B4727734ADE8A7C34EF158ABBACFC1728B117E72F4384C85AC2F037B2AE96C0F2C039E4CF51027113947976ECF0063155D38B78A06713F"),
+			std::string("39085EEA3DEAC608461D372F594116C6EAAD82804E2331FB33E46D5E2A8AE65C2050E49D95BF643A1138CE3DAF9C1685F3768C3284C2A6543D09F4A5D828CAD3"),
+			std::string("D6FE11D0FF10BE5CE9D84E9D91769D1FC9C2E7C0D309A1E376D113EAFD020645D1E3E5D5347A3BA7147EFAEAE366C8298BC64098357005B6EA79437BD79337C5"),
+			std::string("E4F3F7112A0375DFD6316A762AAC724583A38971BB9DC97EA5FFD7041B20832A837E929E01710882B970729157AD1693933CE7522780E511298FC75D3A15B57D"),
+			std::string("080439C2690A51385100249292E7BD8F8EB638308EF0A6198DA79C408FBA66014B4A787E5A6DD59163E2AD77F302181136E4DB716DA4EF0D4EA62C34245E4F17"),
+			std::string("AFF1DE214A8E187C275EBD111E27FFF3037BE74A960A1F05516125BB33207A25741F77EBDA4191160BBA74A60E1F0ADC546DF1A57F7BACC57367918A6EE9027A"),
+			std::string("42E9568B7B5A07F4ADA2A82FA9CE9303C042FACD8DAC67E0E22D1F6C2EFB7ACBA9548C321887B7BE062816F4D783061ADD1F0BAFD1610DB98F84A1E74AEBB892"),
+			std::string("C30ECBA29BAB79562D1C85D80C0D82269D56B065B835AB06F04744C65F5DEB941483837F9FA43A2ECF2F514AE1A77C798709B4A86F1A4521871843ADF1262FD2")
+		};
+		HexConverter::Decode(expected, 22, m_expected);
+		/*lint -restore */
+	}
+
+	void ParallelHashTest::ParallelTest()
+	{
+		ParallelHash dgs(ShakeModes::SHAKE128, false);
+		Digest::IDigest* dgp = Helper::DigestFromName::GetInstance(Enumeration::Digests::ParallelHash128, true);
+		// the leaf size alone defines the hash, so the parallel and sequential outputs are the same
+		const bool ISEQL = TestUtils::DigestParallelEqual(&dgs, dgp);
+
+		delete dgp;
+
+		if (!ISEQL)
+		{
+			throw TestException("ParallelHashTest: Parallel hash is not equal!");
+		}
+	}
+
+	void ParallelHashTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	void ParallelHashTest::SampleTest()
+	{
+		// the NIST samples use an 8 byte leaf
+		ParallelHash dgt1(ShakeModes::SHAKE128, false, 8);
+		ParallelHash dgt2(ShakeModes::SHAKE256, false, 8);
+
+		for (size_t i = 0; i < m_custom.size(); ++i)
+		{
+			dgt1.Initialize(m_custom[i]);
+			CompareVector(&dgt1, m_sample, m_expected[i]);
+			dgt2.Initialize(m_custom[i]);
+			CompareVector(&dgt2, m_sample, m_expected[2 + i]);
+		}
+	}
+
+	void ParallelHashTest::StreamTest()
+	{
+		std::vector<byte> input(1024 * 1024);
+		Prng::SecureRandom rnd;
+		ParallelHash dgt;
+
+		rnd.GetBytes(input);
+
+		// update lengths of up to three leaves cross the block and leaf boundaries at arbitrary offsets
+		if (!TestUtils::DigestUpdateEqual(&dgt, input, (3 * 8192) + 1))
+		{
+			throw TestException("ParallelHashTest: Partial update hash is not equal!");
+		}
+	}
+}
@@ -0,0 +1,67 @@
+#ifndef CEXTEST_PARALLELHASHTEST_H
+#define CEXTEST_PARALLELHASHTEST_H
+
+#include "ITest.h"
+#include "../CEX/ParallelHash.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests the SP800-185 ParallelHash digest implementation using vector comparisons.
+	/// <para>Tests ParallelHash128 and ParallelHash256 with the NIST sample vectors, and vectors generated by a reference implementation across the leaf boundaries:
+	/// <see href="https://csrc.nist.gov/projects/cryptographic-standards-and-guidelines/example-values"/></para>
+	/// </summary>
+	class ParallelHashTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		std::vector<std::vector<byte>> m_custom;
+		std::vector<std::vector<byte>> m_expected;
+		std::vector<size_t> m_msgLength;
+		std::vector<byte> m_sample;
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Known answer tests for the ParallelHash digest
+		/// </summary>
+		ParallelHashTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~ParallelHashTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void CompareVector(Digest::ParallelHash* Digest, std::vector<byte> &Input, std::vector<byte> &Expected);
+		void HashTest(Enumeration::ShakeModes ShakeMode, size_t Index);
+		void Initialize();
+		void OnProgress(std::string Data);
+		void ParallelTest();
+		void SampleTest();
+		void StreamTest();
+	};
+}
+
+#endif
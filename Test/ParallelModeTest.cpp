@@ -11,12 +11,15 @@
 #include "../CEX/CTR.h"
 #include "../CEX/ECB.h"
 #include "../CEX/ICM.h"
+#include "../CEX/IntUtils.h"
+#include "../CEX/ParallelCalibration.h"
 #include "../CEX/ParallelUtils.h"
 #include "../CEX/RHX.h"
 #include "../CEX/SecureRandom.h"
 #include "../CEX/SHX.h"
 #include "../CEX/THX.h"
 #include "../CEX/Salsa20.h"
+#include <cstdio>
 
 //#define STAT_INP // internal testing
 
@@ -116,6 +119,11 @@ namespace Test
 			delete eng2;
 			delete eng2b;
 
+			RHX* eng4 = new RHX();
+			CompareCbcBatch(eng4);
+			delete eng4;
+			OnProgress(std::string("ParallelModeTest: RHX Passed CBC multi-message encryption Integrity tests.."));
+
 			THX* eng3 = new THX();
 			CompareBcrSimd(eng3);
 			OnProgress(std::string("ParallelModeTest: THX Passed Twofish Monte Carlo KAT test.."));
@@ -139,10 +147,14 @@ namespace Test
 
 			OnProgress(std::string(""));
 
+			CompareCounterCarry();
+			OnProgress(std::string("ParallelModeTest: Passed CTR/ICM SIMD counter carry tests.."));
 			CompareParallelLoop();
 			OnProgress(std::string("ParallelModeTest: Passed CBC/CFB/CTR/ICM Parallel encryption and decryption looping Integrity tests.."));
 			CompareParallelOutput();
 			OnProgress(std::string("ParallelModeTest: Passed CBC/CFB/CTR/ICM Parallel output encryption and decryption tests.."));
+			CompareCalibration();
+			OnProgress(std::string("ParallelModeTest: Passed parallel calibration profile tests.."));
 
 			return SUCCESS;
 		}
@@ -526,6 +538,118 @@ namespace Test
 		}
 	}
 
+	void ParallelModeTest::CompareCalibration()
+	{
+		const std::string PRFPTH = "parallel-calibration.tmp";
+		CTR* cpr1 = new CTR(BlockCiphers::Rijndael);
+		const std::string CPRNME = cpr1->Name();
+		const size_t PRLTHR = cpr1->ParallelProfile().ParallelMinimumSize() * 4;
+		delete cpr1;
+
+		// a degree of zero keeps the default thread count, so the threshold is already aligned
+		Common::ParallelCalibration::Clear();
+		Common::ParallelCalibration::Store(CPRNME, PRLTHR, 0);
+		Common::ParallelCalibration::Store("ChaCha20", 0, 0);
+
+		if (!Common::ParallelCalibration::Save(PRFPTH))
+		{
+			throw TestException("CompareCalibration: The calibration profile could not be written!");
+		}
+
+		Common::ParallelCalibration::Clear();
+		size_t prlDgr = 0;
+		size_t prlThr = 0;
+
+		// the saved profile is not applied until it is loaded
+		if (Common::ParallelCalibration::Find(CPRNME, prlThr, prlDgr))
+		{
+			throw TestException("CompareCalibration: The calibration profile was applied before it was loaded!");
+		}
+
+		if (!Common::ParallelCalibration::Load(PRFPTH))
+		{
+			throw TestException("CompareCalibration: The calibration profile could not be read!");
+		}
+
+		std::remove(PRFPTH.c_str());
+
+		if (!Common::ParallelCalibration::Find(CPRNME, prlThr, prlDgr) || prlThr != PRLTHR || prlDgr != 0)
+		{
+			throw TestException("CompareCalibration: The calibration profile entry is not equal!");
+		}
+
+		if (m_processorCount > 1)
+		{
+			CTR* cpr2 = new CTR(BlockCiphers::Rijndael);
+			ChaCha20* stm1 = new ChaCha20();
+			const bool CPRCAL = (cpr2->ParallelProfile().IsParallel() && cpr2->ParallelBlockSize() == PRLTHR && cpr2->ParallelProfile().IsDefault());
+			const bool STMCAL = !stm1->ParallelProfile().IsParallel();
+			delete cpr2;
+			delete stm1;
+
+			if (!CPRCAL || !STMCAL)
+			{
+				throw TestException("CompareCalibration: The calibrated parallel profile was not applied!");
+			}
+		}
+
+		Common::ParallelCalibration::Clear();
+	}
+
+	void ParallelModeTest::CompareCbcBatch(IBlockCipher* Engine)
+	{
+		std::vector<byte> data;
+		std::vector<byte> enc1;
+		std::vector<byte> enc2;
+		std::vector<byte> key(32);
+		std::vector<byte> iv(16);
+		std::vector<byte> ivs;
+		Prng::SecureRandom rng;
+
+		GetBytes(32, key);
+		Key::Symmetric::SymmetricKey keyParam(key, iv);
+		Mode::CBC cipher(Engine);
+
+		// compare interleaved encryption to each message encrypted separately
+		for (size_t i = 0; i < TEST_LOOPS; ++i)
+		{
+			const size_t MSGCNT = (size_t)rng.NextUInt32(37, 1);
+			const size_t MSGLEN = (size_t)rng.NextUInt32(16, 1) * cipher.BlockSize();
+
+			data.resize(MSGCNT * MSGLEN);
+			enc1.resize(MSGCNT * MSGLEN);
+			enc2.resize(MSGCNT * MSGLEN);
+			ivs.resize(MSGCNT * cipher.BlockSize());
+			rng.GetBytes(data);
+			rng.GetBytes(ivs);
+
+			for (size_t j = 0; j < MSGCNT; ++j)
+			{
+				Utility::MemUtils::Copy(ivs, j * cipher.BlockSize(), iv, 0, iv.size());
+				Key::Symmetric::SymmetricKey msgParam(key, iv);
+				cipher.Initialize(true, msgParam);
+				cipher.Transform(data, j * MSGLEN, enc1, j * MSGLEN, MSGLEN);
+			}
+
+			cipher.Initialize(true, keyParam);
+			cipher.EncryptBatch(data, 0, enc2, 0, ivs, MSGLEN, MSGCNT);
+
+			if (enc1 != enc2)
+			{
+				throw TestException("ParallelModeTest: Failed CBC multi-message encryption test!");
+			}
+
+			// the vectors are returned as the final cipher-text block of each message
+			for (size_t j = 0; j < MSGCNT; ++j)
+			{
+				if (!std::equal(ivs.begin() + (j * cipher.BlockSize()), ivs.begin() + ((j + 1) * cipher.BlockSize()), enc1.begin() + ((j + 1) * MSGLEN) - cipher.BlockSize()))
+				{
+					throw TestException("ParallelModeTest: Failed CBC multi-message chaining vector test!");
+				}
+			}
+		}
+	}
+
 	void ParallelModeTest::CompareCbcDecrypt(IBlockCipher* Engine1, IBlockCipher* Engine2)
 	{
 		std::vector<byte> data;
@@ -619,6 +743,71 @@ namespace Test
 		}
 	}
 
+	void ParallelModeTest::CompareCounterCarry()
+	{
+		const size_t BLKCNT = 64;
+		std::vector<byte> data(BLKCNT * 16, 0);
+		std::vector<byte> enc(BLKCNT * 16);
+		std::vector<byte> exp(BLKCNT * 16);
+		std::vector<byte> key(32);
+		std::vector<byte> iv(16, 0xFF);
+		std::vector<byte> tmpCtr(16);
+		std::vector<ulong> leCtr(2);
+		RHX* eng = new RHX();
+
+		GetBytes(32, key);
+
+		// big endian: the low 64bit word wraps after 16 blocks
+		iv[0] = 0x01;
+		iv[15] = 0xF0;
+		Key::Symmetric::SymmetricKey keyParam1(key, iv);
+		eng->Initialize(true, keyParam1);
+		tmpCtr = iv;
+
+		for (size_t i = 0; i < BLKCNT; ++i)
+		{
+			eng->EncryptBlock(tmpCtr, 0, exp, i * 16);
+			Utility::IntUtils::BeIncrement8(tmpCtr);
+		}
+
+		Mode::CTR cipher1(eng);
+		cipher1.ParallelProfile().IsParallel() = false;
+		cipher1.Initialize(true, keyParam1);
+		cipher1.Transform(data, 0, enc, 0, data.size());
+
+		if (enc != exp)
+		{
+			throw TestException("CompareCounterCarry: CTR counter carry output is not equal!");
+		}
+
+		// little endian: the low word is the first 8 bytes
+		std::fill(iv.begin(), iv.end(), static_cast<byte>(0xFF));
+		iv[0] = 0xF0;
+		iv[15] = 0x01;
+		Key::Symmetric::SymmetricKey keyParam2(key, iv);
+		eng->Initialize(true, keyParam2);
+		Utility::MemUtils::COPY128(iv, 0, leCtr, 0);
+
+		for (size_t i = 0; i < BLKCNT; ++i)
+		{
+			Utility::MemUtils::COPY128(leCtr, 0, tmpCtr, 0);
+			eng->EncryptBlock(tmpCtr, 0, exp, i * 16);
+			Utility::IntUtils::LeIncrementW(leCtr);
+		}
+
+		Mode::ICM cipher2(eng);
+		cipher2.ParallelProfile().IsParallel() = false;
+		cipher2.Initialize(true, keyParam2);
+		cipher2.Transform(data, 0, enc, 0, data.size());
+
+		if (enc != exp)
+		{
+			throw TestException("CompareCounterCarry: ICM counter carry output is not equal!");
+		}
+
+		delete eng;
+	}
+
 	void ParallelModeTest::CompareParallelLoop()
 	{
 		Prng::SecureRandom rng;
@@ -1252,7 +1441,8 @@ namespace Test
 			enc2.resize(smpSze);
 #endif
 			Key::Symmetric::SymmetricKey keyParam(key, iv);
-			Engine->ParallelProfile().ParallelBlockSize() = Engine->ParallelProfile().ParallelMinimumSize() * Engine->ParallelProfile().ProcessorCount();
+			// the parallel block size is the threshold of the parallel transform, so every sample at least the minimum size is processed in parallel
+			Engine->ParallelProfile().ParallelBlockSize() = Engine->ParallelProfile().ParallelMinimumSize();
 
 			// sequential
 			Engine->Initialize(keyParam);
@@ -76,6 +76,12 @@ namespace Test
 		void CompareBcrSimd(IBlockCipher* Engine);
 		// Looping integrity tests, compares CBC Decrypt multi-threaded/SIMD with sequentially generated output
 		void CompareCbcDecrypt(IBlockCipher* Engine1, IBlockCipher* Engine2);
+		// Saves and loads a calibration profile, and checks that a calibrated threshold is applied to new ciphers
+		void CompareCalibration();
+		// Looping integrity tests, compares CBC interleaved multi-message encryption with per-message output
+		void CompareCbcBatch(IBlockCipher* Engine);
+		// Compares CTR and ICM output with counters that carry across the 64bit word boundary, to a block-wise scalar increment
+		void CompareCounterCarry();
 		// Looping CBC/CFB/CTR integrity tests, compares sequential to parallel output
 		void CompareParallelLoop();
 		// Compares CBC/CFB/CTR output check, compares output across each block access method 
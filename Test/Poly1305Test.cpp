@@ -47,6 +47,9 @@ namespace Test
 
 			OnProgress(std::string("Poly1305Test: Passed Poly1305-AES known answer vector tests.."));
 
+			Poly1305AESRekey(SEQLEN);
+			OnProgress(std::string("Poly1305Test: Passed Poly1305-AES key reuse and re-key tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -91,6 +94,32 @@ namespace Test
 		}
 	}
 
+	void Poly1305Test::Poly1305AESRekey(size_t Offset)
+	{
+		// one instance across the vectors; each key is used twice, so the cipher schedule is both reused and replaced
+		Mac::Poly1305 gen(Enumeration::BlockCiphers::Rijndael);
+		std::vector<byte> code(16);
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			for (size_t j = Offset; j < m_key.size(); ++j)
+			{
+				for (size_t k = 0; k < 2; ++k)
+				{
+					Key::Symmetric::SymmetricKey kp(m_key[j], m_nonce[j - Offset]);
+					gen.Initialize(kp);
+					gen.Update(m_plainText[j], 0, m_plainText[j].size());
+					gen.Finalize(code, 0);
+
+					if (m_expectedCode[j] != code)
+					{
+						throw TestException("Poly1305AESRekey: Tags do not match!");
+					}
+				}
+			}
+		}
+	}
+
 	void Poly1305Test::Initialize()
 	{
 		/*lint -save -e146 */
@@ -59,6 +59,7 @@ namespace Test
 		void OnProgress(std::string Data);
 		void Poly1305Compare(std::vector<byte> &Key, std::vector<byte> &PlainText, std::vector<byte> &MacCode);
 		void Poly1305AESCompare(std::vector<byte> &Key, std::vector<byte> &Nonce, std::vector<byte> &PlainText, std::vector<byte> &MacCode);
+		void Poly1305AESRekey(size_t Offset);
 	};
 }
 
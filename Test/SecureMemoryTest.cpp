@@ -0,0 +1,328 @@
+#include "SecureMemoryTest.h"
+#include "../CEX/CMAC.h"
+#include "../CEX/RHX.h"
+#include "../CEX/SecureVector.h"
+#include "../CEX/SHX.h"
+#include "../CEX/SymmetricKey.h"
+#include "../CEX/THX.h"
+#include <thread>
+
+namespace Test
+{
+	using Mac::CMAC;
+	using Cipher::Symmetric::Block::RHX;
+	using Common::SecureMemoryPool;
+	using Cipher::Symmetric::Block::SHX;
+	using Key::Symmetric::SymmetricKey;
+	using Cipher::Symmetric::Block::THX;
+
+	const std::string SecureMemoryTest::DESCRIPTION = "Secure memory pool allocation, wiping, reuse and key schedule tests.";
+	const std::string SecureMemoryTest::FAILURE = "FAILURE! ";
+	const std::string SecureMemoryTest::SUCCESS = "SUCCESS! All SecureMemory tests have executed succesfully.";
+
+	SecureMemoryTest::SecureMemoryTest()
+		:
+		m_progressEvent()
+	{
+	}
+
+	SecureMemoryTest::~SecureMemoryTest()
+	{
+	}
+
+	const std::string SecureMemoryTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &SecureMemoryTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string SecureMemoryTest::Run()
+	{
+		try
+		{
+			AllocationCheck();
+			OnProgress(std::string("SecureMemoryTest: Passed zeroed and aligned allocation tests.."));
+			ReuseCheck();
+			OnProgress(std::string("SecureMemoryTest: Passed slot wiping and reuse tests.."));
+			LargeCheck();
+			OnProgress(std::string("SecureMemoryTest: Passed large allocation tests.."));
+			ThreadCheck();
+			OnProgress(std::string("SecureMemoryTest: Passed concurrent allocation tests.."));
+			KeyScheduleCheck();
+			OnProgress(std::string("SecureMemoryTest: Passed secure key schedule known answer tests.."));
+
+			if (SecureMemoryPool::Statistics().UnlockedBytes != 0)
+			{
+				OnProgress(std::string("SecureMemoryTest: The process locked memory limit was reached; some arenas are not page-locked.."));
+			}
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void SecureMemoryTest::AllocationCheck()
+	{
+		const size_t INUSE = SecureMemoryPool::Statistics().SlotsInUse;
+
+		for (size_t i = 1; i <= SecureMemoryPool::MAX_SLOT; i += 7)
+		{
+			byte* ptr = static_cast<byte*>(SecureMemoryPool::Allocate(i));
+
+			if (ptr == nullptr)
+			{
+				throw TestException("AllocationCheck: The pool could not allocate!");
+			}
+
+			// slots are aligned to their class size, up to 64 bytes
+			if (SecureMemoryPool::IsProtected() && reinterpret_cast<size_t>(ptr) % (i < 64 ? SecureMemoryPool::MIN_SLOT : 64) != 0)
+			{
+				throw TestException("AllocationCheck: The allocation is not aligned!");
+			}
+
+			for (size_t j = 0; j < i; ++j)
+			{
+				if (ptr[j] != 0)
+				{
+					throw TestException("AllocationCheck: The allocation is not zeroed!");
+				}
+			}
+
+			SecureMemoryPool::Deallocate(ptr, i);
+		}
+
+		if (SecureMemoryPool::Statistics().SlotsInUse != INUSE)
+		{
+			throw TestException("AllocationCheck: The slots were not returned to the pool!");
+		}
+	}
+
+	void SecureMemoryTest::KeyScheduleCheck()
+	{
+		const size_t INUSE = SecureMemoryPool::Statistics().SlotsInUse;
+		std::vector<byte> key;
+		std::vector<byte> msg;
+		std::vector<byte> exp;
+
+		// FIPS 197 C.3: AES-256
+		HexConverter::Decode("000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F", key);
+		HexConverter::Decode("00112233445566778899AABBCCDDEEFF", msg);
+		HexConverter::Decode("8EA2B7CA516745BFEAFC49904B496089", exp);
+
+		{
+			std::vector<byte> enc(16);
+			std::vector<byte> dec(16);
+			SymmetricKey kp(key);
+			RHX cpr;
+
+			cpr.Initialize(true, kp);
+			cpr.Transform(msg, enc);
+
+			if (enc != exp)
+			{
+				throw TestException("KeyScheduleCheck: The RHX secure key schedule output is incorrect!");
+			}
+
+			cpr.Initialize(false, kp);
+			cpr.Transform(enc, dec);
+
+			if (dec != msg)
+			{
+				throw TestException("KeyScheduleCheck: The RHX secure key schedule decryption is incorrect!");
+			}
+		}
+
+		// the schedules are re-keyed and destroyed repeatedly, so any slot not returned shows in the counters
+		for (size_t i = 0; i < 100; ++i)
+		{
+			std::vector<byte> enc(16);
+			std::vector<byte> dec(16);
+			SymmetricKey kp(key);
+			SHX spx;
+			THX tfx;
+
+			spx.Initialize(true, kp);
+			spx.Transform(msg, enc);
+			spx.Initialize(false, kp);
+			spx.Transform(enc, dec);
+
+			if (dec != msg)
+			{
+				throw TestException("KeyScheduleCheck: The SHX secure key schedule round trip failed!");
+			}
+
+			tfx.Initialize(true, kp);
+			tfx.Transform(msg, enc);
+			tfx.Initialize(false, kp);
+			tfx.Transform(enc, dec);
+
+			if (dec != msg)
+			{
+				throw TestException("KeyScheduleCheck: The THX secure key schedule round trip failed!");
+			}
+		}
+
+		// RFC 4493 examples 1 and 2; the empty message uses the second subkey, the full block the first
+		{
+			std::vector<byte> mkey;
+			std::vector<byte> code(16);
+			HexConverter::Decode("2B7E151628AED2A6ABF7158809CF4F3C", mkey);
+			HexConverter::Decode("6BC1BEE22E409F96E93D7E117393172A", msg);
+			SymmetricKey kp(mkey);
+			CMAC mac(Enumeration::BlockCiphers::Rijndael);
+
+			mac.Initialize(kp);
+			mac.Finalize(code, 0);
+			HexConverter::Decode("BB1D6929E95937287FA37D129B756746", exp);
+
+			if (code != exp)
+			{
+				throw TestException("KeyScheduleCheck: The CMAC secure subkey output is incorrect!");
+			}
+
+			mac.Update(msg, 0, msg.size());
+			mac.Finalize(code, 0);
+			HexConverter::Decode("070A16B46B4D4144F79BDD9DD04A287C", exp);
+
+			if (code != exp)
+			{
+				throw TestException("KeyScheduleCheck: The CMAC secure subkey output is incorrect!");
+			}
+		}
+
+		if (SecureMemoryPool::Statistics().SlotsInUse != INUSE)
+		{
+			throw TestException("KeyScheduleCheck: The key schedules were not returned to the pool!");
+		}
+	}
+
+	void SecureMemoryTest::LargeCheck()
+	{
+		const size_t LRGLEN = SecureMemoryPool::MAX_SLOT * 4 + 1;
+		const size_t INUSE = SecureMemoryPool::Statistics().LargeInUse;
+
+		{
+			SecureVector<byte> lrg(LRGLEN);
+
+			if (SecureMemoryPool::Statistics().LargeInUse != INUSE + 1)
+			{
+				throw TestException("LargeCheck: The large allocation was not mapped individually!");
+			}
+
+			for (size_t i = 0; i < lrg.size(); ++i)
+			{
+				if (lrg[i] != 0)
+				{
+					throw TestException("LargeCheck: The large allocation is not zeroed!");
+				}
+
+				lrg[i] = static_cast<byte>(i);
+			}
+		}
+
+		if (SecureMemoryPool::Statistics().LargeInUse != INUSE)
+		{
+			throw TestException("LargeCheck: The large allocation was not released!");
+		}
+	}
+
+	void SecureMemoryTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	void SecureMemoryTest::ReuseCheck()
+	{
+		const size_t SLTLEN = 100;
+		byte* ptr1 = static_cast<byte*>(SecureMemoryPool::Allocate(SLTLEN));
+
+		std::memset(ptr1, 0xFF, SLTLEN);
+		SecureMemoryPool::Deallocate(ptr1, SLTLEN);
+
+		// the free lists are last in first out, so the same slot is handed back, wiped
+		byte* ptr2 = static_cast<byte*>(SecureMemoryPool::Allocate(SLTLEN));
+
+		if (ptr2 != ptr1)
+		{
+			throw TestException("ReuseCheck: The freed slot was not reused!");
+		}
+
+		for (size_t i = 0; i < SLTLEN; ++i)
+		{
+			if (ptr2[i] != 0)
+			{
+				throw TestException("ReuseCheck: The freed slot was not wiped!");
+			}
+		}
+
+		SecureMemoryPool::Deallocate(ptr2, SLTLEN);
+	}
+
+	void SecureMemoryTest::ThreadCheck()
+	{
+		const size_t THDCNT = 4;
+		const size_t ALCCNT = 1000;
+		const size_t INUSE = SecureMemoryPool::Statistics().SlotsInUse;
+		std::vector<std::thread> thds;
+		std::vector<size_t> errs(THDCNT, 0);
+
+		for (size_t i = 0; i < THDCNT; ++i)
+		{
+			thds.push_back(std::thread([i, ALCCNT, &errs]()
+			{
+				std::vector<SecureVector<byte>> keys;
+
+				for (size_t j = 0; j < ALCCNT; ++j)
+				{
+					keys.push_back(SecureVector<byte>(16 + (j % 256), static_cast<byte>(i)));
+
+					// release every other key, so the free lists are exercised while other threads allocate
+					if (j % 2 == 1)
+					{
+						keys.erase(keys.begin());
+					}
+				}
+
+				for (size_t j = 0; j < keys.size(); ++j)
+				{
+					for (size_t k = 0; k < keys[j].size(); ++k)
+					{
+						if (keys[j][k] != static_cast<byte>(i))
+						{
+							++errs[i];
+						}
+					}
+				}
+			}));
+		}
+
+		for (size_t i = 0; i < thds.size(); ++i)
+		{
+			thds[i].join();
+		}
+
+		for (size_t i = 0; i < THDCNT; ++i)
+		{
+			if (errs[i] != 0)
+			{
+				throw TestException("ThreadCheck: A key was overwritten by another thread!");
+			}
+		}
+
+		if (SecureMemoryPool::Statistics().SlotsInUse != INUSE)
+		{
+			throw TestException("ThreadCheck: The slots were not returned to the pool!");
+		}
+	}
+}
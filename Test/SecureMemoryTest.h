@@ -0,0 +1,61 @@
+#ifndef CEXTEST_SECUREMEMORYTEST_H
+#define CEXTEST_SECUREMEMORYTEST_H
+
+#include "ITest.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests the SecureMemoryPool and the SecureVector container.
+	/// <para>Checks that allocations are zeroed and aligned, that freed slots are wiped and reused, that large requests are mapped and released individually,
+	/// that concurrent threads can share the pool, and that ciphers and MACs using secure key schedules still match their known answers.</para>
+	/// </summary>
+	class SecureMemoryTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Tests the secure memory pool and allocator
+		/// </summary>
+		SecureMemoryTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~SecureMemoryTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void AllocationCheck();
+		void KeyScheduleCheck();
+		void LargeCheck();
+		void OnProgress(std::string Data);
+		void ReuseCheck();
+		void ThreadCheck();
+	};
+}
+
+#endif
@@ -0,0 +1,396 @@
+#include "SeekableCipherStreamTest.h"
+#include "../CEX/CTR.h"
+#include "../CEX/HKDF.h"
+#include "../CEX/HMAC.h"
+#include "../CEX/IntUtils.h"
+#include "../CEX/MemoryStream.h"
+#include "../CEX/SecureRandom.h"
+#include "../CEX/SeekableCipherStream.h"
+#include "../CEX/SymmetricKey.h"
+
+namespace Test
+{
+	using Enumeration::BlockCiphers;
+	using Cipher::Symmetric::Block::Mode::CTR;
+	using Enumeration::Digests;
+	using Kdf::HKDF;
+	using Mac::HMAC;
+	using IO::MemoryStream;
+	using IO::SeekableCipherStream;
+	using IO::SeekOrigin;
+	using Prng::SecureRandom;
+	using Key::Symmetric::SymmetricKey;
+
+	const std::string SeekableCipherStreamTest::DESCRIPTION = "SeekableCipherStream random access container format, range read and authentication tests.";
+	const std::string SeekableCipherStreamTest::FAILURE = "FAILURE! ";
+	const std::string SeekableCipherStreamTest::SUCCESS = "SUCCESS! All SeekableCipherStream tests have executed succesfully.";
+
+	SeekableCipherStreamTest::SeekableCipherStreamTest()
+		:
+		m_key(32),
+		m_progressEvent()
+	{
+	}
+
+	SeekableCipherStreamTest::~SeekableCipherStreamTest()
+	{
+	}
+
+	const std::string SeekableCipherStreamTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &SeekableCipherStreamTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string SeekableCipherStreamTest::Run()
+	{
+		try
+		{
+			SecureRandom rnd;
+			rnd.GetBytes(m_key);
+
+			FormatCheck();
+			OnProgress(std::string("SeekableCipherStreamTest: Passed container format and chunk counter tests.."));
+			RandomAccessCheck(true);
+			OnProgress(std::string("SeekableCipherStreamTest: Passed authenticated random range read tests.."));
+			RandomAccessCheck(false);
+			OnProgress(std::string("SeekableCipherStreamTest: Passed unauthenticated random range read tests.."));
+			AuthenticationCheck();
+			OnProgress(std::string("SeekableCipherStreamTest: Passed modified, moved and truncated chunk tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (std::exception const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + std::string(ex.what()));
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void SeekableCipherStreamTest::AuthenticationCheck()
+	{
+		const size_t DATOFF = SeekableCipherStream::HEADER_SIZE + SeekableCipherStream::TAG_SIZE;
+		const size_t CHKLEN = CHUNK_SIZE + SeekableCipherStream::TAG_SIZE;
+		std::vector<byte> pln(CHUNK_SIZE * 4 + 100);
+		std::vector<byte> otp(CHUNK_SIZE);
+		SecureRandom rnd;
+		rnd.GetBytes(pln);
+
+		const std::vector<byte> CPT = Create(pln);
+		SymmetricKey kp(m_key);
+
+		// a modified byte in the second chunk fails only the reads that touch that chunk
+		{
+			std::vector<byte> tmpCpt = CPT;
+			tmpCpt[DATOFF + CHKLEN + 10] ^= 0x01;
+			MemoryStream mCnt(tmpCpt);
+			SeekableCipherStream cs(&mCnt, kp);
+
+			cs.Seek(CHUNK_SIZE * 3, SeekOrigin::Begin);
+			cs.Read(otp, 0, otp.size());
+
+			if (std::vector<byte>(pln.begin() + (CHUNK_SIZE * 3), pln.begin() + (CHUNK_SIZE * 4)) != otp)
+			{
+				throw TestException("AuthenticationCheck: An unmodified chunk was not decrypted! -AA1");
+			}
+
+			bool isRejected = false;
+
+			try
+			{
+				cs.Seek(CHUNK_SIZE - 10, SeekOrigin::Begin);
+				cs.Read(otp, 0, 20);
+			}
+			catch (Exception::CryptoAuthenticationFailure const &)
+			{
+				isRejected = true;
+			}
+
+			if (!isRejected)
+			{
+				throw TestException("AuthenticationCheck: A modified chunk was not rejected! -AA2");
+			}
+		}
+
+		std::vector<std::vector<byte>> tmpCpt;
+
+		// a modified chunk tag
+		tmpCpt.push_back(CPT);
+		tmpCpt.back()[DATOFF + CHKLEN - 1] ^= 0x01;
+		// the first two chunks swapped
+		tmpCpt.push_back(CPT);
+		std::copy(CPT.begin() + DATOFF, CPT.begin() + DATOFF + CHKLEN, tmpCpt.back().begin() + DATOFF + CHKLEN);
+		std::copy(CPT.begin() + DATOFF + CHKLEN, CPT.begin() + DATOFF + (2 * CHKLEN), tmpCpt.back().begin() + DATOFF);
+		// the first chunk copied from another container encrypted with the same key
+		tmpCpt.push_back(CPT);
+		{
+			const std::vector<byte> OTHCPT = Create(pln);
+			std::copy(OTHCPT.begin() + DATOFF, OTHCPT.begin() + DATOFF + CHKLEN, tmpCpt.back().begin() + DATOFF);
+		}
+
+		for (size_t i = 0; i < tmpCpt.size(); ++i)
+		{
+			MemoryStream mCnt(tmpCpt[i]);
+			SeekableCipherStream cs(&mCnt, kp);
+			bool isRejected = false;
+
+			try
+			{
+				cs.Read(otp, 0, otp.size());
+			}
+			catch (Exception::CryptoAuthenticationFailure const &)
+			{
+				isRejected = true;
+			}
+
+			if (!isRejected)
+			{
+				throw TestException("AuthenticationCheck: A modified container was not rejected! -AB" + std::to_string(i + 1));
+			}
+		}
+
+		// a modified header, or the wrong key, fails when the container is opened
+		tmpCpt.clear();
+		tmpCpt.push_back(CPT);
+		// the plain-text length
+		tmpCpt.back()[12] ^= 0x01;
+		tmpCpt.push_back(CPT);
+		// the salt
+		tmpCpt.back()[SeekableCipherStream::HEADER_SIZE - 1] ^= 0x01;
+
+		for (size_t i = 0; i < tmpCpt.size() + 1; ++i)
+		{
+			std::vector<byte> key = m_key;
+			bool isRejected = false;
+
+			if (i == tmpCpt.size())
+			{
+				key[0] ^= 0x01;
+			}
+
+			try
+			{
+				MemoryStream mCnt(i == tmpCpt.size() ? CPT : tmpCpt[i]);
+				SymmetricKey kp2(key);
+				SeekableCipherStream cs(&mCnt, kp2);
+			}
+			catch (Exception::CryptoAuthenticationFailure const &)
+			{
+				isRejected = true;
+			}
+
+			if (!isRejected)
+			{
+				throw TestException("AuthenticationCheck: A modified header or wrong key was not rejected! -AC" + std::to_string(i + 1));
+			}
+		}
+
+		// truncated inside the last chunk
+		{
+			MemoryStream mCnt(std::vector<byte>(CPT.begin(), CPT.end() - 8));
+			SeekableCipherStream cs(&mCnt, kp);
+			bool isRejected = false;
+
+			try
+			{
+				cs.Seek(10, SeekOrigin::End);
+				cs.Read(otp, 0, 10);
+			}
+			catch (Exception::CryptoProcessingException const &)
+			{
+				isRejected = true;
+			}
+
+			if (!isRejected)
+			{
+				throw TestException("AuthenticationCheck: A truncated container was not rejected! -AD1");
+			}
+		}
+	}
+
+	std::vector<byte> SeekableCipherStreamTest::Create(const std::vector<byte> &Input, bool Authenticate)
+	{
+		SymmetricKey kp(m_key);
+		MemoryStream mIn(Input);
+		MemoryStream mOut;
+
+		SeekableCipherStream::Create(&mIn, &mOut, kp, BlockCiphers::Rijndael, CHUNK_SIZE, Authenticate);
+
+		return mOut.ToArray();
+	}
+
+	void SeekableCipherStreamTest::FormatCheck()
+	{
+		const size_t DATOFF = SeekableCipherStream::HEADER_SIZE + SeekableCipherStream::TAG_SIZE;
+		const size_t CHKLEN = CHUNK_SIZE + SeekableCipherStream::TAG_SIZE;
+		std::vector<byte> pln(CHUNK_SIZE * 3 + 100);
+		SecureRandom rnd;
+		rnd.GetBytes(pln);
+
+		const std::vector<byte> CPT = Create(pln);
+
+		if (CPT.size() != SeekableCipherStream::CalculateSize(pln.size(), CHUNK_SIZE))
+		{
+			throw TestException("FormatCheck: The container length is incorrect! -FC1");
+		}
+
+		// magic 'CXRA', version, cipher, flags, reserved, little endian chunk size and plain-text length
+		std::vector<byte> expHdr = { 0x43, 0x58, 0x52, 0x41, 0x01, static_cast<byte>(BlockCiphers::Rijndael), 0x01, 0x00, 0x00, 0x04, 0x00, 0x00 };
+		expHdr.resize(20);
+		Utility::IntUtils::Le64ToBytes(static_cast<ulong>(pln.size()), expHdr, 12);
+
+		if (std::vector<byte>(CPT.begin(), CPT.begin() + expHdr.size()) != expHdr)
+		{
+			throw TestException("FormatCheck: The container header is incorrect! -FC2");
+		}
+
+		// the keys are HKDF(SHA256) output, with the salt, and the header fields as the info string
+		const std::vector<byte> HDR(CPT.begin(), CPT.begin() + SeekableCipherStream::HEADER_SIZE);
+		std::vector<byte> prk(32 + 16 + 32);
+		HKDF kdf(Digests::SHA256);
+		kdf.Initialize(m_key, std::vector<byte>(HDR.begin() + 20, HDR.end()), expHdr);
+		kdf.Generate(prk, 0, prk.size());
+
+		const std::vector<byte> CPRKEY(prk.begin(), prk.begin() + 32);
+		const std::vector<byte> MACKEY(prk.begin() + 48, prk.end());
+		std::vector<byte> nonce(prk.begin() + 32, prk.begin() + 48);
+		std::vector<byte> code(SeekableCipherStream::TAG_SIZE);
+		SymmetricKey mkp(MACKEY);
+		HMAC mac(Digests::SHA256);
+		mac.Initialize(mkp);
+		mac.Update(HDR, 0, HDR.size());
+		mac.Finalize(code, 0);
+
+		if (std::vector<byte>(CPT.begin() + SeekableCipherStream::HEADER_SIZE, CPT.begin() + DATOFF) != code)
+		{
+			throw TestException("FormatCheck: The header tag is incorrect! -FC3");
+		}
+
+		// each chunk is the counter mode encryption of the chunk, starting at block index i * ChunkSize / 16, followed by HMAC(index || cipher-text)
+		for (size_t i = 0; i < 4; ++i)
+		{
+			const size_t PLNLEN = (i == 3) ? 100 : CHUNK_SIZE;
+			const size_t CHKOFF = DATOFF + (i * CHKLEN);
+			std::vector<byte> expChk(PLNLEN);
+			std::vector<byte> idx(8);
+
+			Utility::IntUtils::Be64ToBytes(static_cast<ulong>(i * (CHUNK_SIZE / 16)), nonce, 8);
+			CTR cpr(BlockCiphers::Rijndael);
+			SymmetricKey kp(CPRKEY, nonce);
+			cpr.Initialize(true, kp);
+			cpr.Transform(pln, i * CHUNK_SIZE, expChk, 0, PLNLEN);
+
+			if (std::vector<byte>(CPT.begin() + CHKOFF, CPT.begin() + CHKOFF + PLNLEN) != expChk)
+			{
+				throw TestException("FormatCheck: The chunk does not match the counter mode output! -FC4");
+			}
+
+			Utility::IntUtils::Be64ToBytes(static_cast<ulong>(i), idx, 0);
+			mac.Update(idx, 0, idx.size());
+			mac.Update(expChk, 0, expChk.size());
+			mac.Finalize(code, 0);
+
+			if (std::vector<byte>(CPT.begin() + CHKOFF + PLNLEN, CPT.begin() + CHKOFF + PLNLEN + code.size()) != code)
+			{
+				throw TestException("FormatCheck: The chunk tag is incorrect! -FC5");
+			}
+		}
+
+		// two containers of the same data and key use different salts and keys
+		if (Create(pln) == CPT)
+		{
+			throw TestException("FormatCheck: The container salt is not random! -FC6");
+		}
+	}
+
+	void SeekableCipherStreamTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	void SeekableCipherStreamTest::RandomAccessCheck(bool Authenticate)
+	{
+		SecureRandom rnd;
+		SymmetricKey kp(m_key);
+
+		// an empty container
+		{
+			const std::vector<byte> CPT = Create(std::vector<byte>(0), Authenticate);
+			MemoryStream mCnt(CPT);
+			SeekableCipherStream cs(&mCnt, kp);
+			std::vector<byte> otp(16);
+
+			if (CPT.size() != SeekableCipherStream::CalculateSize(0, CHUNK_SIZE, Authenticate) || cs.Length() != 0 || cs.Read(otp, 0, otp.size()) != 0)
+			{
+				throw TestException("RandomAccessCheck: The empty container is incorrect! -RA1");
+			}
+		}
+
+		std::vector<byte> pln(CHUNK_SIZE * 10 + 77);
+		rnd.GetBytes(pln);
+
+		const std::vector<byte> CPT = Create(pln, Authenticate);
+		MemoryStream mCnt(CPT);
+		SeekableCipherStream cs(&mCnt, kp);
+
+		if (cs.Length() != pln.size() || cs.IsAuthenticated() != Authenticate || cs.ChunkSize() != CHUNK_SIZE)
+		{
+			throw TestException("RandomAccessCheck: The container properties are incorrect! -RA2");
+		}
+
+		// random ranges, including ranges inside a chunk, spanning several chunks, and crossing the end of the stream
+		for (size_t i = 0; i < 200; ++i)
+		{
+			const size_t POS = rnd.NextUInt32(static_cast<uint>(pln.size()));
+			const size_t LEN = rnd.NextUInt32(static_cast<uint>(CHUNK_SIZE * 3), 1);
+			const size_t EXPLEN = Utility::IntUtils::Min(LEN, pln.size() - POS);
+			std::vector<byte> otp(LEN + 3);
+
+			cs.Seek(POS, SeekOrigin::Begin);
+
+			if (cs.Read(otp, 3, LEN) != EXPLEN || cs.Position() != POS + EXPLEN)
+			{
+				throw TestException("RandomAccessCheck: The range read length is incorrect! -RA3");
+			}
+			if (std::vector<byte>(otp.begin() + 3, otp.begin() + 3 + EXPLEN) != std::vector<byte>(pln.begin() + POS, pln.begin() + POS + EXPLEN))
+			{
+				throw TestException("RandomAccessCheck: The range read output is incorrect! -RA4");
+			}
+		}
+
+		cs.Seek(1, SeekOrigin::End);
+
+		if (cs.ReadByte() != pln[pln.size() - 1])
+		{
+			throw TestException("RandomAccessCheck: The read byte is incorrect! -RA5");
+		}
+
+		cs.Seek(CHUNK_SIZE * 2, SeekOrigin::Begin);
+		cs.Seek(CHUNK_SIZE + 5, SeekOrigin::Current);
+
+		if (cs.ReadByte() != pln[(CHUNK_SIZE * 3) + 5])
+		{
+			throw TestException("RandomAccessCheck: The relative seek is incorrect! -RA6");
+		}
+
+		MemoryStream mOut;
+		cs.Reset();
+		cs.CopyTo(&mOut);
+
+		if (mOut.ToArray() != pln)
+		{
+			throw TestException("RandomAccessCheck: The copied stream is incorrect! -RA7");
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef CEXTEST_SEEKABLECIPHERSTREAMTEST_H
+#define CEXTEST_SEEKABLECIPHERSTREAMTEST_H
+
+#include "ITest.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests the SeekableCipherStream random access encrypted container.
+	/// <para>Checks the container format against the underlying counter mode and MAC, random range reads against the plain-text,
+	/// that modified, moved and truncated chunks are rejected only by the reads that touch them, and unauthenticated containers.</para>
+	/// </summary>
+	class SeekableCipherStreamTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+		static const size_t CHUNK_SIZE = 1024;
+
+		std::vector<byte> m_key;
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Initialize this class
+		/// </summary>
+		SeekableCipherStreamTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~SeekableCipherStreamTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void AuthenticationCheck();
+		std::vector<byte> Create(const std::vector<byte> &Input, bool Authenticate = true);
+		void FormatCheck();
+		void OnProgress(std::string Data);
+		void RandomAccessCheck(bool Authenticate);
+	};
+}
+
+#endif
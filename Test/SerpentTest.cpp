@@ -2,6 +2,7 @@
 #include "../CEX/CTR.h"
 #include "../CEX/SHX.h"
 #include "../CEX/IntUtils.h"
+#include "../CEX/SecureRandom.h"
 
 namespace Test
 {
@@ -39,6 +40,15 @@ namespace Test
 
 			CompareOutput();
 
+			SHX* eng = new SHX();
+			CompareWide(eng);
+			delete eng;
+			// the extended cipher runs the wide transforms over more rounds
+			eng = new SHX(Enumeration::Digests::SHA512, 40);
+			CompareWide(eng);
+			delete eng;
+			OnProgress(std::string("SerpentTest: Passed 512, 1024 and 2048 bit parallel transform tests.."));
+
 			std::vector<byte> cip(16, 0);
 			std::vector<byte> key(16, 0);
 			std::vector<byte> pln(16, 0);
@@ -338,6 +348,72 @@ namespace Test
 		}
 	}
 
+	void SerpentTest::CompareWide(Cipher::Symmetric::Block::IBlockCipher* Cipher)
+	{
+		for (size_t i = 0; i < Cipher->LegalKeySizes().size(); ++i)
+		{
+			Key::Symmetric::SymmetricKeySize ks = Cipher->LegalKeySizes()[i];
+			std::vector<byte> key(ks.KeySize());
+			Prng::SecureRandom rnd;
+			rnd.GetBytes(key);
+			Key::Symmetric::SymmetricKey k(key);
+
+			Cipher->Initialize(true, k);
+			// Transform512, Transform1024 and Transform2048 process 4, 8 and 16 blocks
+			CompareWide(Cipher, 4);
+			CompareWide(Cipher, 8);
+			CompareWide(Cipher, 16);
+
+			Cipher->Initialize(false, k);
+			CompareWide(Cipher, 4);
+			CompareWide(Cipher, 8);
+			CompareWide(Cipher, 16);
+		}
+	}
+
+	void SerpentTest::CompareWide(Cipher::Symmetric::Block::IBlockCipher* Cipher, size_t Blocks)
+	{
+		const size_t BLKSZE = Cipher->BlockSize();
+		// an offset on both arrays, so that the wide loads and stores are not aligned
+		const size_t INPOFT = 3;
+		const size_t OUTOFT = 5;
+		std::vector<byte> inBytes(INPOFT + (Blocks * BLKSZE));
+		std::vector<byte> outBytes(OUTOFT + (Blocks * BLKSZE), 0);
+		std::vector<byte> expBytes(OUTOFT + (Blocks * BLKSZE), 0);
+		Prng::SecureRandom rnd;
+		rnd.GetBytes(inBytes);
+
+		for (size_t i = 0; i < Blocks; ++i)
+		{
+			if (Cipher->IsEncryption())
+			{
+				Cipher->EncryptBlock(inBytes, INPOFT + (i * BLKSZE), expBytes, OUTOFT + (i * BLKSZE));
+			}
+			else
+			{
+				Cipher->DecryptBlock(inBytes, INPOFT + (i * BLKSZE), expBytes, OUTOFT + (i * BLKSZE));
+			}
+		}
+
+		if (Blocks == 4)
+		{
+			Cipher->Transform512(inBytes, INPOFT, outBytes, OUTOFT);
+		}
+		else if (Blocks == 8)
+		{
+			Cipher->Transform1024(inBytes, INPOFT, outBytes, OUTOFT);
+		}
+		else
+		{
+			Cipher->Transform2048(inBytes, INPOFT, outBytes, OUTOFT);
+		}
+
+		if (outBytes != expBytes)
+		{
+			throw TestException("Serpent Wide: Arrays are not equal!");
+		}
+	}
+
 	void SerpentTest::OnProgress(std::string Data)
 	{
 		m_progressEvent(Data);
@@ -2,6 +2,7 @@
 #define CEXTEST_SERPENTTEST_H
 
 #include "ITest.h"
+#include "../CEX/IBlockCipher.h"
 
 namespace Test
 {
@@ -55,6 +56,8 @@ namespace Test
 		void CompareMonteCarlo(std::vector<byte> &Key, std::vector<byte> &Input, std::vector<byte> &Output, size_t Count = 100);
 		void CompareOutput();
 		void CompareVector(std::vector<byte> &Key, std::vector<byte> &Input, std::vector<byte> &Output);
+		void CompareWide(Cipher::Symmetric::Block::IBlockCipher* Cipher);
+		void CompareWide(Cipher::Symmetric::Block::IBlockCipher* Cipher, size_t Blocks);
 		void OnProgress(std::string Data);
     };
 }
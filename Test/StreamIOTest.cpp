@@ -0,0 +1,577 @@
+#include "StreamIOTest.h"
+#include "../CEX/SecureRandom.h"
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+#	include "../CEX/DirectStream.h"
+#	include "../CEX/MappedStream.h"
+#endif
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#if defined(CEX_OS_LINUX)
+#	include <unistd.h>
+#endif
+
+namespace Test
+{
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	using IO::DirectStream;
+	using IO::MappedStream;
+	using IO::SeekOrigin;
+#endif
+
+	const std::string StreamIOTest::DESCRIPTION = "MappedStream and DirectStream round trip, seek, length and close tests.";
+	const std::string StreamIOTest::FAILURE = "FAILURE! ";
+	const std::string StreamIOTest::SUCCESS = "SUCCESS! All file stream tests have executed succesfully.";
+	const std::string StreamIOTest::TEMP_FILE = "StreamIOTest.tmp";
+
+	StreamIOTest::StreamIOTest()
+		:
+		m_progressEvent()
+	{
+	}
+
+	StreamIOTest::~StreamIOTest()
+	{
+	}
+
+	const std::string StreamIOTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &StreamIOTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string StreamIOTest::Run()
+	{
+		try
+		{
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+			MappedRoundTripCheck();
+			OnProgress(std::string("StreamIOTest: Passed MappedStream write, close and reopen tests.."));
+			MappedSeekCheck();
+			OnProgress(std::string("StreamIOTest: Passed MappedStream seek and overwrite tests.."));
+			MappedLengthCheck();
+			OnProgress(std::string("StreamIOTest: Passed MappedStream length growth and reduction tests.."));
+			MappedViewCheck();
+			OnProgress(std::string("StreamIOTest: Passed MappedStream view tests.."));
+			DirectRoundTripCheck();
+			OnProgress(std::string("StreamIOTest: Passed DirectStream unaligned write, close and reopen tests.."));
+			DirectSeekCheck();
+			OnProgress(std::string("StreamIOTest: Passed DirectStream seek tests.."));
+			DirectLengthCheck();
+			OnProgress(std::string("StreamIOTest: Passed DirectStream length growth, reduction and reset tests.."));
+			DirectCloseCheck();
+			OnProgress(std::string("StreamIOTest: Passed DirectStream close failure tests.."));
+#else
+			OnProgress(std::string("MappedStream and DirectStream are not supported on this platform."));
+#endif
+			std::remove(TEMP_FILE.c_str());
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			std::remove(TEMP_FILE.c_str());
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (std::exception const &ex)
+		{
+			std::remove(TEMP_FILE.c_str());
+			throw TestException(FAILURE + std::string(" : ") + std::string(ex.what()));
+		}
+		catch (...)
+		{
+			std::remove(TEMP_FILE.c_str());
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	void StreamIOTest::DirectCloseCheck()
+	{
+#	if defined(CEX_OS_LINUX)
+		// every write to /dev/full fails, so the buffered tail can only fail in Close
+		if (::access("/dev/full", W_OK) != 0)
+		{
+			return;
+		}
+
+		std::vector<byte> smp(TAIL_SIZE);
+		TestUtils::GetRandom(smp);
+
+		DirectStream* wstm = new DirectStream("/dev/full", DirectStream::FileAccess::Write);
+		wstm->Write(smp, 0, smp.size());
+		bool isThrown = false;
+
+		try
+		{
+			wstm->Close();
+		}
+		catch (Exception::CryptoProcessingException const &)
+		{
+			isThrown = true;
+		}
+
+		delete wstm;
+
+		if (!isThrown)
+		{
+			throw TestException(std::string("DirectCloseCheck: A failed final write was not reported by Close! -DC1"));
+		}
+
+		// the finalizer suppresses the same failure
+		wstm = new DirectStream("/dev/full", DirectStream::FileAccess::Write);
+		wstm->Write(smp, 0, smp.size());
+		delete wstm;
+#	endif
+	}
+
+	void StreamIOTest::DirectLengthCheck()
+	{
+		const size_t GRWLEN = 9000;
+		const size_t SHRLEN = 77;
+		std::vector<byte> smp(TAIL_SIZE);
+		TestUtils::GetRandom(smp);
+
+		DirectStream* wstm = new DirectStream(TEMP_FILE, DirectStream::FileAccess::Write);
+		wstm->Write(smp, 0, smp.size());
+		wstm->SetLength(TAIL_SIZE + GRWLEN);
+
+		if (wstm->Length() != TAIL_SIZE + GRWLEN || wstm->Position() != TAIL_SIZE + GRWLEN)
+		{
+			throw TestException(std::string("DirectLengthCheck: The grown length is incorrect! -DL1"));
+		}
+
+		// the stream is shortened within the current buffer, and written past the new end
+		wstm->SetLength(TAIL_SIZE + GRWLEN - SHRLEN);
+		wstm->Write(smp, 0, SHRLEN * 2);
+		wstm->Close();
+		delete wstm;
+
+		std::vector<byte> exp(smp);
+		exp.resize(TAIL_SIZE + GRWLEN - SHRLEN, 0);
+		exp.insert(exp.end(), smp.begin(), smp.begin() + (SHRLEN * 2));
+		std::vector<byte> otp = ReadFile(TEMP_FILE);
+
+		if (otp != exp)
+		{
+			throw TestException(std::string("DirectLengthCheck: The grown and shortened file is incorrect! -DL2"));
+		}
+
+		// a reset write stream truncates the file
+		wstm = new DirectStream(TEMP_FILE, DirectStream::FileAccess::Write);
+		wstm->Write(smp, 0, smp.size());
+		wstm->Reset();
+
+		if (wstm->Length() != 0 || wstm->Position() != 0)
+		{
+			throw TestException(std::string("DirectLengthCheck: The reset stream is not empty! -DL3"));
+		}
+
+		wstm->Write(smp, SHRLEN, SHRLEN);
+		wstm->Close();
+		delete wstm;
+
+		exp.assign(smp.begin() + SHRLEN, smp.begin() + (SHRLEN * 2));
+		otp = ReadFile(TEMP_FILE);
+
+		if (otp != exp)
+		{
+			throw TestException(std::string("DirectLengthCheck: The reset stream wrote an incorrect file! -DL4"));
+		}
+	}
+
+	void StreamIOTest::DirectRoundTripCheck()
+	{
+		// odd chunk sizes cross every buffer and sector boundary
+		const std::vector<size_t> CHKLEN = { 1, 17, 4095, 4097, 333, 8192, 5000 };
+		// the default buffer, and a two sector buffer that is flushed many times
+		const std::vector<size_t> BUFLEN = { 1024 * 1024, 8192 };
+		std::vector<byte> smp(TAIL_SIZE * 4);
+		TestUtils::GetRandom(smp);
+
+		for (size_t i = 0; i < BUFLEN.size(); ++i)
+		{
+			for (size_t tlen = TAIL_SIZE; tlen <= smp.size(); tlen += TAIL_SIZE)
+			{
+				DirectStream* wstm = new DirectStream(TEMP_FILE, DirectStream::FileAccess::Write, BUFLEN[i]);
+				size_t prcLen = 0;
+				size_t j = 0;
+
+				while (prcLen != tlen)
+				{
+					const size_t WRTLEN = std::min(CHKLEN[j % CHKLEN.size()], tlen - prcLen);
+					wstm->Write(smp, prcLen, WRTLEN);
+					prcLen += WRTLEN;
+					++j;
+				}
+
+				wstm->Close();
+				delete wstm;
+
+				std::vector<byte> exp(smp.begin(), smp.begin() + tlen);
+
+				if (ReadFile(TEMP_FILE) != exp)
+				{
+					throw TestException(std::string("DirectRoundTripCheck: The closed file is not trimmed to the written data! -DR1"));
+				}
+
+				DirectStream* rstm = new DirectStream(TEMP_FILE, DirectStream::FileAccess::Read, BUFLEN[i]);
+
+				if (rstm->Length() != tlen)
+				{
+					throw TestException(std::string("DirectRoundTripCheck: The reopened file length is incorrect! -DR2"));
+				}
+
+				std::vector<byte> otp(tlen);
+				prcLen = 0;
+				j = 0;
+
+				while (prcLen != tlen)
+				{
+					const size_t RDLEN = std::min(CHKLEN[(j + 3) % CHKLEN.size()], tlen - prcLen);
+
+					if (rstm->Read(otp, prcLen, RDLEN) != RDLEN)
+					{
+						throw TestException(std::string("DirectRoundTripCheck: The read returned too few bytes! -DR3"));
+					}
+
+					prcLen += RDLEN;
+					++j;
+				}
+
+				// reads at the end of the file return nothing
+				if (rstm->Read(otp, 0, 1) != 0)
+				{
+					throw TestException(std::string("DirectRoundTripCheck: A read past the end returned data! -DR4"));
+				}
+
+				delete rstm;
+
+				if (otp != exp)
+				{
+					throw TestException(std::string("DirectRoundTripCheck: The read data is not equal to the written data! -DR5"));
+				}
+			}
+		}
+	}
+
+	void StreamIOTest::DirectSeekCheck()
+	{
+		Prng::SecureRandom rng;
+		std::vector<byte> smp(TAIL_SIZE * 2);
+		TestUtils::GetRandom(smp);
+
+		DirectStream* wstm = new DirectStream(TEMP_FILE, DirectStream::FileAccess::Write);
+		wstm->Write(smp, 0, smp.size());
+		wstm->Close();
+		delete wstm;
+
+		// a small buffer, so most seeks leave the buffered region
+		DirectStream* rstm = new DirectStream(TEMP_FILE, DirectStream::FileAccess::Read, 8192);
+		std::vector<byte> otp(64);
+		std::vector<byte> exp(64);
+
+		for (size_t i = 0; i < 100; ++i)
+		{
+			ulong pos = static_cast<ulong>(rng.NextUInt32() % (smp.size() - otp.size()));
+
+			if (i % 3 == 0)
+			{
+				rstm->Seek(pos, SeekOrigin::Begin);
+			}
+			else if (i % 3 == 1)
+			{
+				rstm->Seek(smp.size() - pos, SeekOrigin::End);
+			}
+			else
+			{
+				rstm->Seek(0, SeekOrigin::Begin);
+				rstm->Seek(pos, SeekOrigin::Current);
+			}
+
+			if (rstm->Position() != pos)
+			{
+				throw TestException(std::string("DirectSeekCheck: The stream position is incorrect! -DS1"));
+			}
+
+			rstm->Read(otp, 0, otp.size());
+			std::memcpy(exp.data(), smp.data() + pos, exp.size());
+
+			if (otp != exp || rstm->ReadByte() != smp[pos + otp.size()])
+			{
+				throw TestException(std::string("DirectSeekCheck: The data read after a seek is incorrect! -DS2"));
+			}
+		}
+
+		rstm->Reset();
+
+		if (rstm->Position() != 0 || rstm->ReadByte() != smp[0])
+		{
+			throw TestException(std::string("DirectSeekCheck: The reset read stream is not at the start! -DS3"));
+		}
+
+		delete rstm;
+	}
+
+	void StreamIOTest::MappedLengthCheck()
+	{
+		const size_t GRWLEN = 9000;
+		const size_t SHRLEN = 4096 + 77;
+		std::vector<byte> smp(TAIL_SIZE);
+		TestUtils::GetRandom(smp);
+
+		MappedStream* wstm = new MappedStream(TEMP_FILE, MappedStream::FileAccess::Write);
+		wstm->Write(smp, 0, smp.size());
+
+		// growth inside the mapping reserve, and past it
+		for (ulong len : { static_cast<ulong>(TAIL_SIZE + GRWLEN), static_cast<ulong>(TAIL_SIZE + (1024 * 1024 * 3)) })
+		{
+			wstm->SetLength(len);
+
+			if (wstm->Length() != len || wstm->Position() != TAIL_SIZE)
+			{
+				throw TestException(std::string("MappedLengthCheck: The grown length is incorrect! -ML1"));
+			}
+
+			const byte* ptr = wstm->View(TAIL_SIZE, static_cast<size_t>(len - TAIL_SIZE));
+
+			for (size_t i = 0; i < len - TAIL_SIZE; ++i)
+			{
+				if (ptr[i] != 0)
+				{
+					throw TestException(std::string("MappedLengthCheck: The grown region is not zeroed! -ML2"));
+				}
+			}
+		}
+
+		// shortening moves the position to the new end
+		wstm->Seek(0, SeekOrigin::End);
+		wstm->SetLength(TAIL_SIZE - SHRLEN);
+
+		if (wstm->Length() != TAIL_SIZE - SHRLEN || wstm->Position() != TAIL_SIZE - SHRLEN)
+		{
+			throw TestException(std::string("MappedLengthCheck: The shortened length is incorrect! -ML3"));
+		}
+
+		// the removed data does not reappear when the stream grows again
+		wstm->SetLength(TAIL_SIZE);
+		wstm->Close();
+		delete wstm;
+
+		std::vector<byte> exp(smp.begin(), smp.begin() + (TAIL_SIZE - SHRLEN));
+		exp.resize(TAIL_SIZE, 0);
+
+		if (ReadFile(TEMP_FILE) != exp)
+		{
+			throw TestException(std::string("MappedLengthCheck: The closed file is incorrect! -ML4"));
+		}
+
+		// a stream shortened to nothing leaves an empty file
+		wstm = new MappedStream(TEMP_FILE, MappedStream::FileAccess::ReadWrite);
+		wstm->SetLength(0);
+		wstm->Close();
+		delete wstm;
+
+		if (!ReadFile(TEMP_FILE).empty())
+		{
+			throw TestException(std::string("MappedLengthCheck: The emptied file is not empty! -ML5"));
+		}
+	}
+
+	void StreamIOTest::MappedRoundTripCheck()
+	{
+		const std::vector<size_t> CHKLEN = { 1, 17, 4095, 4097, 333, 8192, 5000 };
+		// larger than the initial mapping, so the stream is remapped while it is written
+		std::vector<byte> smp((1024 * 1024 * 2) + TAIL_SIZE);
+		TestUtils::GetRandom(smp);
+
+		for (size_t tlen : { static_cast<size_t>(TAIL_SIZE), smp.size() })
+		{
+			MappedStream* wstm = new MappedStream(TEMP_FILE, MappedStream::FileAccess::Write);
+			size_t prcLen = 0;
+			size_t i = 0;
+
+			while (prcLen != tlen)
+			{
+				const size_t WRTLEN = std::min(CHKLEN[i % CHKLEN.size()], tlen - prcLen);
+				wstm->Write(smp, prcLen, WRTLEN);
+				prcLen += WRTLEN;
+				++i;
+			}
+
+			// a write stream can be read back before it is closed
+			std::vector<byte> otp(tlen);
+			wstm->Seek(0, SeekOrigin::Begin);
+
+			if (wstm->Read(otp, 0, otp.size()) != tlen || !std::equal(otp.begin(), otp.end(), smp.begin()))
+			{
+				throw TestException(std::string("MappedRoundTripCheck: The write stream read back incorrect data! -MR1"));
+			}
+
+			wstm->Close();
+			delete wstm;
+
+			std::vector<byte> exp(smp.begin(), smp.begin() + tlen);
+
+			if (ReadFile(TEMP_FILE) != exp)
+			{
+				throw TestException(std::string("MappedRoundTripCheck: The closed file is not trimmed to the written data! -MR2"));
+			}
+
+			MappedStream* rstm = new MappedStream(TEMP_FILE, MappedStream::FileAccess::Read);
+
+			if (rstm->Length() != tlen)
+			{
+				throw TestException(std::string("MappedRoundTripCheck: The reopened file length is incorrect! -MR3"));
+			}
+
+			std::fill(otp.begin(), otp.end(), 0);
+			prcLen = 0;
+			i = 0;
+
+			while (prcLen != tlen)
+			{
+				const size_t RDLEN = std::min(CHKLEN[(i + 3) % CHKLEN.size()], tlen - prcLen);
+				prcLen += rstm->Read(otp, prcLen, RDLEN);
+				++i;
+			}
+
+			if (rstm->Read(otp, 0, 1) != 0)
+			{
+				throw TestException(std::string("MappedRoundTripCheck: A read past the end returned data! -MR4"));
+			}
+
+			delete rstm;
+
+			if (otp != exp)
+			{
+				throw TestException(std::string("MappedRoundTripCheck: The read data is not equal to the written data! -MR5"));
+			}
+		}
+	}
+
+	void StreamIOTest::MappedSeekCheck()
+	{
+		Prng::SecureRandom rng;
+		std::vector<byte> smp(TAIL_SIZE * 2);
+		std::vector<byte> upd(64);
+		TestUtils::GetRandom(smp);
+		TestUtils::GetRandom(upd);
+
+		MappedStream* wstm = new MappedStream(TEMP_FILE, MappedStream::FileAccess::Write);
+		wstm->Write(smp, 0, smp.size());
+		wstm->Close();
+		delete wstm;
+
+		// overwrite regions in place through each seek origin
+		MappedStream* stm = new MappedStream(TEMP_FILE, MappedStream::FileAccess::ReadWrite);
+		std::vector<byte> otp(upd.size());
+
+		for (size_t i = 0; i < 30; ++i)
+		{
+			ulong pos = static_cast<ulong>(rng.NextUInt32() % (smp.size() - upd.size()));
+
+			if (i % 3 == 0)
+			{
+				stm->Seek(pos, SeekOrigin::Begin);
+			}
+			else if (i % 3 == 1)
+			{
+				stm->Seek(smp.size() - pos, SeekOrigin::End);
+			}
+			else
+			{
+				stm->Seek(0, SeekOrigin::Begin);
+				stm->Seek(pos, SeekOrigin::Current);
+			}
+
+			if (stm->Position() != pos)
+			{
+				throw TestException(std::string("MappedSeekCheck: The stream position is incorrect! -MS1"));
+			}
+
+			upd[0] = static_cast<byte>(i);
+			stm->Write(upd, 0, upd.size());
+			std::memcpy(smp.data() + pos, upd.data(), upd.size());
+			stm->Seek(pos, SeekOrigin::Begin);
+			stm->Read(otp, 0, otp.size());
+
+			if (otp != upd)
+			{
+				throw TestException(std::string("MappedSeekCheck: The data read after a seek is incorrect! -MS2"));
+			}
+		}
+
+		if (stm->Length() != smp.size())
+		{
+			throw TestException(std::string("MappedSeekCheck: An overwrite changed the stream length! -MS3"));
+		}
+
+		stm->Close();
+		delete stm;
+
+		if (ReadFile(TEMP_FILE) != smp)
+		{
+			throw TestException(std::string("MappedSeekCheck: The overwritten file is incorrect! -MS4"));
+		}
+	}
+
+	void StreamIOTest::MappedViewCheck()
+	{
+		Prng::SecureRandom rng;
+		std::vector<byte> smp(TAIL_SIZE);
+		TestUtils::GetRandom(smp);
+
+		MappedStream* wstm = new MappedStream(TEMP_FILE, MappedStream::FileAccess::Write);
+		wstm->Write(smp, 0, smp.size());
+
+		// the view of a write stream sees the written data before it is flushed
+		if (std::memcmp(wstm->View(0, smp.size()), smp.data(), smp.size()) != 0)
+		{
+			throw TestException(std::string("MappedViewCheck: The write stream view is incorrect! -MV1"));
+		}
+
+		wstm->Close();
+		delete wstm;
+
+		MappedStream* rstm = new MappedStream(TEMP_FILE, MappedStream::FileAccess::Read);
+
+		for (size_t i = 0; i < 100; ++i)
+		{
+			const size_t OFFSET = rng.NextUInt32() % smp.size();
+			const size_t LENGTH = rng.NextUInt32() % (smp.size() - OFFSET + 1);
+
+			if (std::memcmp(rstm->View(OFFSET, LENGTH), smp.data() + OFFSET, LENGTH) != 0)
+			{
+				throw TestException(std::string("MappedViewCheck: The read stream view is incorrect! -MV2"));
+			}
+		}
+
+		// the view does not move the stream position
+		if (rstm->Position() != 0)
+		{
+			throw TestException(std::string("MappedViewCheck: The view changed the stream position! -MV3"));
+		}
+
+		delete rstm;
+	}
+#endif
+
+	void StreamIOTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	std::vector<byte> StreamIOTest::ReadFile(const std::string &FileName)
+	{
+		// read through the standard library, independent of the streams under test
+		std::ifstream ifs(FileName, std::ios::binary);
+
+		return std::vector<byte>((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+	}
+}
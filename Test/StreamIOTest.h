@@ -0,0 +1,68 @@
+#ifndef CEXTEST_STREAMIOTEST_H
+#define CEXTEST_STREAMIOTEST_H
+
+#include "ITest.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests the MappedStream and DirectStream file streams.
+	/// <para>Checks write and read round trips with unaligned chunks, seeking from each origin, growing and shrinking the stream length,
+	/// unaligned tail writes that are closed and reopened, the zero-copy mapped views, and that an explicit Close reports a failed final write.</para>
+	/// </summary>
+	class StreamIOTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+		static const std::string TEMP_FILE;
+		// three sectors and an unaligned tail
+		static const size_t TAIL_SIZE = (4096 * 3) + 123;
+
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Tests the memory-mapped and unbuffered file streams
+		/// </summary>
+		StreamIOTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~StreamIOTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void DirectCloseCheck();
+		void DirectLengthCheck();
+		void DirectRoundTripCheck();
+		void DirectSeekCheck();
+		void MappedLengthCheck();
+		void MappedRoundTripCheck();
+		void MappedSeekCheck();
+		void MappedViewCheck();
+		void OnProgress(std::string Data);
+		static std::vector<byte> ReadFile(const std::string &FileName);
+	};
+}
+
+#endif
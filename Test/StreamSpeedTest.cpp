@@ -0,0 +1,220 @@
+#include "StreamSpeedTest.h"
+#include "../CEX/FileStream.h"
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+#	include "../CEX/DirectStream.h"
+#	include "../CEX/MappedStream.h"
+#endif
+#include <cstdio>
+#include <cstring>
+
+namespace Test
+{
+	using IO::FileStream;
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	using IO::DirectStream;
+	using IO::MappedStream;
+#endif
+
+	const std::string StreamSpeedTest::DESCRIPTION = "File Stream Speed Tests.";
+	const std::string StreamSpeedTest::FAILURE = "FAILURE! ";
+	const std::string StreamSpeedTest::MESSAGE = "COMPLETE! Speed tests have executed succesfully.";
+	const std::string StreamSpeedTest::TEMP_FILE = "StreamSpeedTest.tmp";
+
+	StreamSpeedTest::StreamSpeedTest()
+		:
+		m_sample(IO_SIZE),
+		m_progressEvent()
+	{
+	}
+
+	StreamSpeedTest::~StreamSpeedTest()
+	{
+	}
+
+	const std::string StreamSpeedTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &StreamSpeedTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string StreamSpeedTest::Run()
+	{
+		try
+		{
+			TestUtils::GetRandom(m_sample);
+
+			OnProgress(std::string("### File Stream Speed Tests: 5 loops * 100MB, write then read ###"));
+			OnProgress(std::string("### Read timings of buffered streams include page cache hits"));
+			OnProgress(std::string(""));
+
+			OnProgress(std::string("***FileStream: std::fstream***"));
+			FileStreamLoop();
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+			OnProgress(std::string("***MappedStream: memory-mapped file***"));
+			MappedStreamLoop();
+			OnProgress(std::string("***DirectStream: unbuffered aligned io***"));
+			DirectStreamLoop();
+#else
+			OnProgress(std::string("MappedStream and DirectStream are not supported on this platform."));
+#endif
+			std::remove(TEMP_FILE.c_str());
+
+			return MESSAGE;
+		}
+		catch (TestException const &ex)
+		{
+			std::remove(TEMP_FILE.c_str());
+			throw TestException(FAILURE + " : " + ex.Message());
+		}
+		catch (std::exception const &ex)
+		{
+			std::remove(TEMP_FILE.c_str());
+			return FAILURE + " : " + ex.what();
+		}
+		catch (...)
+		{
+			std::remove(TEMP_FILE.c_str());
+			return FAILURE + " : Unknown Error";
+		}
+	}
+
+	void StreamSpeedTest::FileStreamLoop()
+	{
+		uint64_t rdur = 0;
+		uint64_t wdur = 0;
+
+		for (size_t i = 0; i < DEF_ITERATIONS; ++i)
+		{
+			FileStream* wstm = new FileStream(TEMP_FILE, FileStream::FileAccess::Write, FileStream::FileModes::Truncate);
+			WriteLoop(wstm, wdur);
+			delete wstm;
+
+			FileStream* rstm = new FileStream(TEMP_FILE, FileStream::FileAccess::Read, FileStream::FileModes::Binary);
+			ReadLoop(rstm, rdur);
+			delete rstm;
+		}
+
+		Report(wdur, rdur);
+	}
+
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+	void StreamSpeedTest::DirectStreamLoop()
+	{
+		uint64_t rdur = 0;
+		uint64_t wdur = 0;
+		bool isDirect = true;
+
+		for (size_t i = 0; i < DEF_ITERATIONS; ++i)
+		{
+			DirectStream* wstm = new DirectStream(TEMP_FILE, DirectStream::FileAccess::Write);
+			isDirect = wstm->IsDirect();
+			WriteLoop(wstm, wdur);
+			delete wstm;
+
+			DirectStream* rstm = new DirectStream(TEMP_FILE, DirectStream::FileAccess::Read);
+			ReadLoop(rstm, rdur);
+			delete rstm;
+		}
+
+		if (!isDirect)
+		{
+			OnProgress(std::string("The file system does not support O_DIRECT, the buffered fallback was measured."));
+		}
+
+		Report(wdur, rdur);
+	}
+
+	void StreamSpeedTest::MappedStreamLoop()
+	{
+		uint64_t rdur = 0;
+		uint64_t wdur = 0;
+
+		for (size_t i = 0; i < DEF_ITERATIONS; ++i)
+		{
+			MappedStream* wstm = new MappedStream(TEMP_FILE, MappedStream::FileAccess::Write);
+			WriteLoop(wstm, wdur);
+			delete wstm;
+
+			MappedStream* rstm = new MappedStream(TEMP_FILE, MappedStream::FileAccess::Read);
+			ReadLoop(rstm, rdur);
+			delete rstm;
+		}
+
+		Report(wdur, rdur);
+	}
+#endif
+
+	uint64_t StreamSpeedTest::GetBytesPerSecond(uint64_t DurationTicks, uint64_t DataSize)
+	{
+		double sec = (double)DurationTicks / 1000.0;
+		double sze = (double)DataSize;
+
+		return (sec == 0.0) ? 0 : (uint64_t)(sze / sec);
+	}
+
+	void StreamSpeedTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	void StreamSpeedTest::ReadLoop(IO::IByteStream* Stream, uint64_t &Duration)
+	{
+		std::vector<byte> buffer(IO_SIZE);
+		size_t counter = 0;
+
+		if (Stream->Length() != DATA_SIZE)
+		{
+			throw TestException(std::string("ReadLoop: The file length is invalid! -SR1"));
+		}
+
+		uint64_t start = TestUtils::GetTimeMs64();
+
+		while (counter < DATA_SIZE)
+		{
+			const size_t RDLEN = Stream->Read(buffer, 0, buffer.size());
+
+			if (RDLEN == 0 || std::memcmp(buffer.data(), m_sample.data(), RDLEN) != 0)
+			{
+				throw TestException(std::string("ReadLoop: The file data is invalid! -SR2"));
+			}
+
+			counter += RDLEN;
+		}
+
+		Duration += TestUtils::GetTimeMs64() - start;
+	}
+
+	void StreamSpeedTest::Report(uint64_t WriteTime, uint64_t ReadTime)
+	{
+		const uint64_t LEN = DEF_ITERATIONS * DATA_SIZE;
+		std::string wmbs = TestUtils::ToString(GetBytesPerSecond(WriteTime, LEN) / MB1);
+		std::string rmbs = TestUtils::ToString(GetBytesPerSecond(ReadTime, LEN) / MB1);
+		std::string wsec = TestUtils::ToString((double)WriteTime / 1000.0);
+		std::string rsec = TestUtils::ToString((double)ReadTime / 1000.0);
+
+		OnProgress(std::string("Write: " + wsec + " seconds, avg. " + wmbs + " MB per Second"));
+		OnProgress(std::string("Read: " + rsec + " seconds, avg. " + rmbs + " MB per Second"));
+		OnProgress(std::string(""));
+	}
+
+	void StreamSpeedTest::WriteLoop(IO::IByteStream* Stream, uint64_t &Duration)
+	{
+		size_t counter = 0;
+		uint64_t start = TestUtils::GetTimeMs64();
+
+		while (counter < DATA_SIZE)
+		{
+			const size_t WRTLEN = (DATA_SIZE - counter < m_sample.size()) ? static_cast<size_t>(DATA_SIZE - counter) : m_sample.size();
+			Stream->Write(m_sample, 0, WRTLEN);
+			counter += WRTLEN;
+		}
+
+		// the close is timed; it flushes the tail of every stream type
+		Stream->Close();
+		Duration += TestUtils::GetTimeMs64() - start;
+	}
+}
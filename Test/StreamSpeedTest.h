@@ -0,0 +1,72 @@
+#ifndef CEXTEST_STREAMSPEEDTEST_H
+#define CEXTEST_STREAMSPEEDTEST_H
+
+#include "ITest.h"
+#include "../CEX/IByteStream.h"
+
+namespace Test
+{
+	/// <summary>
+	/// File Stream Speed Tests; compares FileStream, MappedStream and DirectStream throughput
+	/// </summary>
+	class StreamSpeedTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string MESSAGE;
+		static const std::string TEMP_FILE;
+		static const uint64_t KB1 = 1000;
+		static const uint64_t MB1 = KB1 * 1000;
+		static const uint64_t MB100 = MB1 * 100;
+		static const uint64_t DATA_SIZE = MB100;
+		static const uint64_t DEF_ITERATIONS = 5;
+		static const size_t IO_SIZE = 1024 * 1024;
+
+		std::vector<byte> m_sample;
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Initialize this class
+		/// </summary>
+		StreamSpeedTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~StreamSpeedTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void FileStreamLoop();
+		static uint64_t GetBytesPerSecond(uint64_t DurationTicks, uint64_t DataSize);
+#if defined(CEX_OS_POSIX) || defined(CEX_OS_LINUX)
+		void DirectStreamLoop();
+		void MappedStreamLoop();
+#endif
+		void OnProgress(std::string Data);
+		void ReadLoop(IO::IByteStream* Stream, uint64_t &Duration);
+		void Report(uint64_t WriteTime, uint64_t ReadTime);
+		void WriteLoop(IO::IByteStream* Stream, uint64_t &Duration);
+	};
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include "../CEX/CSP.h"
 #include "../CEX/MemoryStream.h"
 #include "../CEX/SymmetricKeyGenerator.h"
+#include "../CEX/SymmetricKeyView.h"
 
 namespace Test
 {
@@ -40,6 +41,8 @@ namespace Test
 			OnProgress(std::string("SymmetricKeyTest: Passed initialization tests.."));
 			CheckAccess();
 			OnProgress(std::string("SymmetricKeyTest: Passed output comparison tests.."));
+			CheckView();
+			OnProgress(std::string("SymmetricKeyTest: Passed scoped key view tests.."));
 			CompareSerial();
 			OnProgress(std::string("SymmetricKeyTest: Passed key serialization tests.."));
 
@@ -165,6 +168,72 @@ namespace Test
 		}
 	}
 
+	void SymmetricKeyTest::CheckView()
+	{
+		Provider::CSP rnd;
+		std::vector<byte> key = rnd.GetBytes(32);
+		std::vector<byte> iv = rnd.GetBytes(16);
+		std::vector<byte> info = rnd.GetBytes(64);
+
+		// the plain key view references the key members
+		SymmetricKey symKey(key, iv, info);
+
+		{
+			SymmetricKeyView kv(symKey);
+
+			if (kv.Key() != key || kv.Nonce() != iv || kv.Info() != info)
+			{
+				throw TestException("CheckView: The symmetric key view is invalid!");
+			}
+			if (&kv.Key() != &symKey.KeyRef())
+			{
+				throw TestException("CheckView: The symmetric key view is not a reference!");
+			}
+		}
+
+		SymmetricSecureKey secKey(key, iv, info);
+
+		// nested views share one decryption
+		{
+			SymmetricKeyView kv1(secKey);
+			const std::vector<byte> &keyRef = kv1.Key();
+
+			{
+				SymmetricKeyView kv2(secKey);
+
+				if (kv2.Key() != key || kv2.Nonce() != iv || kv2.Info() != info)
+				{
+					throw TestException("CheckView: The secure key view is invalid!");
+				}
+				if (&kv2.Key() != &keyRef)
+				{
+					throw TestException("CheckView: The nested secure key view is not shared!");
+				}
+			}
+
+			// the outer view is still unlocked, and the copying accessors still work
+			if (kv1.Key() != key || secKey.Nonce() != iv || secKey.Info() != info)
+			{
+				throw TestException("CheckView: The secure key view was locked by the nested view!");
+			}
+		}
+
+		// the reference accessors are closed outside of a view
+		try
+		{
+			secKey.KeyRef();
+			throw TestException("CheckView: The secure key was accessed while locked!");
+		}
+		catch (Exception::CryptoProcessingException const &)
+		{
+		}
+
+		if (secKey.Key() != key || secKey.Nonce() != iv || secKey.Info() != info)
+		{
+			throw TestException("CheckView: The secure key state is invalid after locking!");
+		}
+	}
+
 	void SymmetricKeyTest::CompareSerial()
 	{
 		SymmetricKeySize keySize(64, 16, 64);
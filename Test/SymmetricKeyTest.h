@@ -52,6 +52,7 @@ namespace Test
 
 		void CheckAccess();
 		void CheckInit();
+		void CheckView();
 		void CompareSerial();
 		void OnProgress(std::string Data);
 	};
@@ -125,10 +125,15 @@
 #include "../Test/TestFiles.h"
 #include "../Test/TestUtils.h"
 #include "../Test/AEADTest.h"
+#include "../Test/AeadStreamTest.h"
+#include "../Test/AllocationTest.h"
 #include "../Test/AesAvsTest.h"
 #include "../Test/AesFipsTest.h"
 #include "../Test/AsymmetricSpeedTest.h"
+#include "../Test/BatchStreamTest.h"
+#include "../Test/BenchmarkHarness.h"
 #include "../Test/Blake2Test.h"
+#include "../Test/Blake3Test.h"
 #include "../Test/ChaChaTest.h"
 #include "../Test/CipherModeTest.h"
 #include "../Test/CipherSpeedTest.h"
@@ -137,9 +142,13 @@
 #include "../Test/ConsoleUtils.h"
 #include "../Test/CMGTest.h"
 #include "../Test/CSGTest.h"
+#include "../Test/CSPTest.h"
 #include "../Test/DigestSpeedTest.h"
+#include "../Test/DrbgSpeedTest.h"
 #include "../Test/DigestStreamTest.h"
+#include "../Test/EntropyPoolTest.h"
 #include "../Test/GMACTest.h"
+#include "../Test/KangarooTwelveTest.h"
 #include "../Test/KDF2Test.h"
 #include "../Test/KeccakTest.h"
 #include "../Test/KMACTest.h"
@@ -147,12 +156,14 @@
 #include "../Test/HMACTest.h"
 #include "../Test/HMGTest.h"
 #include "../Test/HXCipherTest.h"
+#include "../Test/InstrumentationTest.h"
 #include "../Test/ITest.h"
 #include "../Test/MacStreamTest.h"
 #include "../Test/McElieceTest.h"
 #include "../Test/MemUtilsTest.h"
 #include "../Test/ModuleLWETest.h"
 #include "../Test/PaddingTest.h"
+#include "../Test/ParallelHashTest.h"
 #include "../Test/ParallelModeTest.h"
 #include "../Test/PBKDF2Test.h"
 #include "../Test/Poly1305Test.h"
@@ -162,15 +173,20 @@
 #include "../Test/RingLWETest.h"
 #include "../Test/SalsaTest.h"
 #include "../Test/SCRYPTTest.h"
+#include "../Test/SecureMemoryTest.h"
 #include "../Test/SecureStreamTest.h"
+#include "../Test/SeekableCipherStreamTest.h"
 #include "../Test/SerpentTest.h"
 #include "../Test/Sha2Test.h"
 #include "../Test/SimdSpeedTest.h"
 #include "../Test/SimdWrapperTest.h"
 #include "../Test/SHAKETest.h"
 #include "../Test/SkeinTest.h"
+#include "../Test/StreamIOTest.h"
+#include "../Test/StreamSpeedTest.h"
 #include "../Test/SymmetricKeyGeneratorTest.h"
 #include "../Test/SymmetricKeyTest.h"
+#include "../Test/TupleHashTest.h"
 #include "../Test/TwofishTest.h"
 #include "../Test/UtilityTest.h"
 
@@ -295,8 +311,14 @@ void RunTest(Test::ITest* Test)
 	}
 }
 
-int main()
+int main(int argc, char* argv[])
 {
+	if (argc > 1)
+	{
+		// the command line runs the benchmark harness without console prompts, for scripts and regression tracking
+		return BenchmarkHarness::Execute(std::vector<std::string>(argv + 1, argv + argc));
+	}
+
 	ConsoleUtils::SizeConsole();
 	PrintTitle();
 
@@ -442,13 +464,21 @@ int main()
 			RunTest(new SalsaTest());
 			PrintHeader("TESTING CRYPTOGRAPHIC STREAM PROCESSORS");
 			RunTest(new CipherStreamTest());
+			RunTest(new AeadStreamTest());
+			RunTest(new SeekableCipherStreamTest());
+			RunTest(new BatchStreamTest());
 			RunTest(new DigestStreamTest());
 			RunTest(new MacStreamTest());
+			RunTest(new StreamIOTest());
 			PrintHeader("TESTING CRYPTOGRAPHIC HASH GENERATORS");
 			RunTest(new Blake2Test());
+			RunTest(new Blake3Test());
+			RunTest(new KangarooTwelveTest());
 			RunTest(new KeccakTest());
+			RunTest(new ParallelHashTest());
 			RunTest(new SHA2Test());
 			RunTest(new SkeinTest());
+			RunTest(new TupleHashTest());
 			PrintHeader("TESTING MESSAGE AUTHENTICATION CODE GENERATORS");
 			RunTest(new CMACTest());
 			RunTest(new GMACTest());
@@ -457,6 +487,8 @@ int main()
 			RunTest(new Poly1305Test());
 			PrintHeader("TESTING PSEUDO RANDOM NUMBER GENERATORS");
 			RunTest(new PrngTest());
+			RunTest(new EntropyPoolTest());
+			RunTest(new CSPTest());
 			PrintHeader("TESTING KEY DERIVATION FUNCTIONS");
 			RunTest(new HKDFTest());
 			RunTest(new KDF2Test());
@@ -473,9 +505,12 @@ int main()
 			RunTest(new SymmetricKeyTest());
 			PrintHeader("TESTING VECTORIZED MEMORY FUNCTIONS");
 			RunTest(new MemUtilsTest());
+			RunTest(new SecureMemoryTest());
 			RunTest(new SimdWrapperTest());
 			PrintHeader("TESTING UTILITY CLASS FUNCTIONS");
 			RunTest(new UtilityTest());
+			RunTest(new InstrumentationTest());
+			RunTest(new AllocationTest());
 			PrintHeader("TESTING ASYMMETRIC CIPHERS");
 			RunTest(new RingLWETest());
 			RunTest(new McElieceTest());
@@ -521,6 +556,26 @@ int main()
 		}
 		ConsoleUtils::WriteLine("");
 
+		if (CanTest("Press 'Y' then Enter to run File Stream Speed Tests, any other key to cancel: "))
+		{
+			RunTest(new StreamSpeedTest());
+		}
+		else
+		{
+			ConsoleUtils::WriteLine("File Stream Speed tests were Cancelled..");
+		}
+		ConsoleUtils::WriteLine("");
+
+		if (CanTest("Press 'Y' then Enter to run DRBG Speed Tests, any other key to cancel: "))
+		{
+			RunTest(new DrbgSpeedTest());
+		}
+		else
+		{
+			ConsoleUtils::WriteLine("DRBG Speed tests were Cancelled..");
+		}
+		ConsoleUtils::WriteLine("");
+
 		if (CanTest("Press 'Y' then Enter to run Asymmetric Cipher Speed Tests, any other key to cancel: "))
 		{
 			RunTest(new AsymmetricSpeedTest());
@@ -70,6 +70,63 @@ namespace Test
 		return true;
 	}
 
+	bool TestUtils::DigestParallelEqual(CEX::Digest::IDigest* Sequential, CEX::Digest::IDigest* Parallel)
+	{
+		const uint MINLEN = static_cast<uint>(Parallel->ParallelProfile().ParallelMinimumSize() * 2);
+		const uint MAXLEN = MINLEN * 32;
+		std::vector<byte> hash1(Sequential->DigestSize());
+		std::vector<byte> hash2(Parallel->DigestSize());
+		CEX::Prng::SecureRandom rnd;
+
+		for (size_t i = 0; i < 10; ++i)
+		{
+			std::vector<byte> input(rnd.NextUInt32(MAXLEN, MINLEN));
+			rnd.GetBytes(input);
+
+			Sequential->Compute(input, hash1);
+			Parallel->Compute(input, hash2);
+
+			if (hash1 != hash2)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool TestUtils::DigestUpdateEqual(CEX::Digest::IDigest* Digest, const std::vector<byte> &Input, size_t MaxUpdate)
+	{
+		std::vector<byte> hash1(Digest->DigestSize());
+		std::vector<byte> hash2(Digest->DigestSize());
+		CEX::Prng::SecureRandom rnd;
+
+		for (size_t i = 0; i < 10; ++i)
+		{
+			const size_t MSGLEN = rnd.NextUInt32(static_cast<uint>(Input.size()), 1);
+			std::vector<byte> msg(Input.begin(), Input.begin() + MSGLEN);
+			size_t offset = 0;
+
+			Digest->Compute(msg, hash1);
+
+			while (offset != MSGLEN)
+			{
+				const size_t PRTLEN = std::min(static_cast<size_t>(rnd.NextUInt32(static_cast<uint>(MaxUpdate), 1)), MSGLEN - offset);
+				Digest->Update(msg, offset, PRTLEN);
+				offset += PRTLEN;
+			}
+
+			Digest->Finalize(hash2, 0);
+
+			if (hash1 != hash2)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	uint64_t TestUtils::GetTimeMs64()
 	{
 #if defined(_WIN32)
@@ -252,6 +309,18 @@ namespace Test
 		}
 	}
 
+	std::vector<byte> TestUtils::PatternMessage(size_t Length)
+	{
+		std::vector<byte> msg(Length);
+
+		for (size_t i = 0; i < Length; ++i)
+		{
+			msg[i] = static_cast<byte>(i % 251);
+		}
+
+		return msg;
+	}
+
 	bool TestUtils::Read(const std::string &FilePath, std::string &Contents)
 	{
 		bool status = false;
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include "../CEX/IDigest.h"
 #include "../CEX/SecureRandom.h"
 #include "../CEX/SymmetricKey.h"
 
@@ -204,10 +205,16 @@ namespace Test
 		static double ChiSquare(std::vector<byte> &Input);
 		static void CopyVector(const std::vector<int> &SrcArray, size_t SrcIndex, std::vector<int> &DstArray, size_t DstIndex, size_t Length);
 		static bool IsEqual(std::vector<byte> &A, std::vector<byte> &B);
+		// hashes random messages of 2 to 64 times the parallel minimum size with both digests; returns false if an output differs
+		static bool DigestParallelEqual(CEX::Digest::IDigest* Sequential, CEX::Digest::IDigest* Parallel);
+		// hashes random length prefixes of the input in one call, and again in random length updates of up to MaxUpdate bytes; returns false if an output differs
+		static bool DigestUpdateEqual(CEX::Digest::IDigest* Digest, const std::vector<byte> &Input, size_t MaxUpdate);
 		static uint64_t GetTimeMs64();
 		static SymmetricKey* GetRandomKey(size_t KeySize, size_t IvSize);
 		static void GetRandom(std::vector<byte> &Data);
 
+		// the ptn(n) message of the BLAKE3 and KangarooTwelve test vectors: the byte values 0 to 250, repeated
+		static std::vector<byte> PatternMessage(size_t Length);
 		static bool Read(const std::string &FilePath, std::string &Contents);
 		static std::vector<byte> Reduce(std::vector<byte> Seed);
 		static void Reverse(std::vector<byte> &Data);
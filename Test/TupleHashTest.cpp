@@ -0,0 +1,165 @@
+#include "TupleHashTest.h"
+
+namespace Test
+{
+	using Digest::TupleHash;
+	using Enumeration::ShakeModes;
+
+	const std::string TupleHashTest::DESCRIPTION = "SP800-185 Test Vectors for TupleHash128 and TupleHash256.";
+	const std::string TupleHashTest::FAILURE = "FAILURE! ";
+	const std::string TupleHashTest::SUCCESS = "SUCCESS! All TupleHash tests have executed succesfully.";
+
+	TupleHashTest::TupleHashTest()
+		:
+		m_custom(0),
+		m_expected(0),
+		m_tuple(0),
+		m_progressEvent()
+	{
+		Initialize();
+	}
+
+	TupleHashTest::~TupleHashTest()
+	{
+	}
+
+	const std::string TupleHashTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &TupleHashTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string TupleHashTest::Run()
+	{
+		try
+		{
+			std::vector<std::vector<byte>> tpl2(m_tuple.begin(), m_tuple.begin() + 2);
+
+			TupleHash* dgt1 = new TupleHash(ShakeModes::SHAKE128);
+			CompareVector(dgt1, tpl2, m_custom[0], m_expected[0]);
+			CompareVector(dgt1, tpl2, m_custom[1], m_expected[1]);
+			CompareVector(dgt1, m_tuple, m_custom[1], m_expected[2]);
+			delete dgt1;
+			OnProgress(std::string("TupleHashTest: Passed TupleHash128 known answer vector tests.."));
+
+			TupleHash* dgt2 = new TupleHash(ShakeModes::SHAKE256);
+			CompareVector(dgt2, tpl2, m_custom[0], m_expected[3]);
+			CompareVector(dgt2, tpl2, m_custom[1], m_expected[4]);
+			CompareVector(dgt2, m_tuple, m_custom[1], m_expected[5]);
+			delete dgt2;
+			OnProgress(std::string("TupleHashTest: Passed TupleHash256 known answer vector tests.."));
+
+			BoundaryTest();
+			OnProgress(std::string("TupleHashTest: Passed TupleHash empty and multi-block element tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void TupleHashTest::BoundaryTest()
+	{
+		// an empty element, and elements and a customization string longer than the rate
+		std::vector<std::vector<byte>> tuple = { TestUtils::PatternMessage(500), TestUtils::PatternMessage(0), TestUtils::PatternMessage(200) };
+		std::vector<byte> custom = TestUtils::PatternMessage(300);
+		TupleHash dgt1(ShakeModes::SHAKE128);
+		TupleHash dgt2(ShakeModes::SHAKE256);
+
+		CompareVector(&dgt1, tuple, custom, m_expected[6]);
+		CompareVector(&dgt2, tuple, custom, m_expected[7]);
+
+		// moving the boundary between two elements changes the hash
+		std::vector<std::vector<byte>> split1 = { TestUtils::PatternMessage(2), TestUtils::PatternMessage(1) };
+		std::vector<std::vector<byte>> split2 = { TestUtils::PatternMessage(1), TestUtils::PatternMessage(2) };
+		std::vector<byte> hash1(dgt1.DigestSize());
+		std::vector<byte> hash2(dgt1.DigestSize());
+
+		split2[1][0] = 1;
+		split2[1][1] = 0;
+		dgt1.Initialize(std::vector<byte>(0));
+		dgt1.Compute(split1, hash1);
+		dgt1.Compute(split2, hash2);
+
+		if (hash1 == hash2)
+		{
+			throw TestException("TupleHashTest: Tuple element boundaries are not encoded!");
+		}
+	}
+
+	void TupleHashTest::CompareVector(TupleHash* Digest, std::vector<std::vector<byte>> &Tuple, std::vector<byte> &Custom, std::vector<byte> &Expected)
+	{
+		std::vector<byte> hash(Digest->DigestSize(), 0);
+
+		Digest->Initialize(Custom);
+
+		for (size_t i = 0; i < Tuple.size(); ++i)
+		{
+			Digest->Update(Tuple[i], 0, Tuple[i].size());
+		}
+
+		Digest->Finalize(hash, 0);
+
+		if (Expected != hash)
+		{
+			throw TestException("TupleHashTest: Expected hash is not equal!");
+		}
+
+		Digest->Compute(Tuple, hash);
+
+		if (Expected != hash)
+		{
+			throw TestException("TupleHashTest: Expected hash is not equal!");
+		}
+	}
+
+	void TupleHashTest::Initialize()
+	{
+		/*lint -save -e417 */
+		const std::vector<std::string> custom =
+		{
+			std::string(""),
+			std::string("4D79205475706C6520417070")
+		};
+		HexConverter::Decode(custom, 2, m_custom);
+
+		const std::vector<std::string> tuple =
+		{
+			std::string("000102"),
+			std::string("101112131415"),
+			std::string("202122232425262728")
+		};
+		HexConverter::Decode(tuple, 3, m_tuple);
+
+		const std::vector<std::string> expected =
+		{
+			// NIST samples 1 to 3 of TupleHash128, and samples 4 to 6 of TupleHash256
+			std::string("C5D8786C1AFB9B82111AB34B65B2C0048FA64E6D48E263264CE1707D3FFC8ED1"),
+			std::string("75CDB20FF4DB1154E841D758E24160C54BAE86EB8C13E7F5F40EB35588E96DFB"),
+			std::string("E60F202C89A2631EDA8D4C588CA5FD07F39E5151998DECCF973ADB3804BB6E84"),
+			std::string("CFB7058CACA5E668F81A12A20A2195CE97A925F1DBA3E7449A56F82201EC607311AC2696B1AB5EA2352DF1423BDE7BD4BB78C9AED1A853C78672F9EB23BBE194"),
+			std::string("147C2191D5ED7EFD98DBD96D7AB5A11692576F5FE2A5065F3E33DE6BBA9F3AA1C4E9A068A289C61C95AAB30AEE1E410B0B607DE3620E24A4E3BF9852A1D4367E"),
+			std::string("45000BE63F9B6BFD89F54717670F69A9BC763591A4F05C50D68891A744BCC6E7D6D5B5E82C018DA999ED35B0BB49C9678E526ABD8E85C13ED254021DB9E790CE"),
+			// multi-block elements and customization string
+			std::string("5615BEB99C867B784A505D087CB9207EB7A7219010684AC41F5F4DF442DBE870"),
+			std::string("B871E6BF2969223C6DFE8AE964E3D422737E808E4FD4177E86610F5A72D8EDE5CE98EA2F9A3B2C51F5CFC5ADCA8D4D476F550A9A0610F1CF21D27AEA39D0C32C")
+		};
+		HexConverter::Decode(expected, 8, m_expected);
+		/*lint -restore */
+	}
+
+	void TupleHashTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
@@ -0,0 +1,63 @@
+#ifndef CEXTEST_TUPLEHASHTEST_H
+#define CEXTEST_TUPLEHASHTEST_H
+
+#include "ITest.h"
+#include "../CEX/TupleHash.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests the SP800-185 TupleHash implementation using vector comparisons.
+	/// <para>Tests TupleHash128 and TupleHash256 with the NIST sample vectors, and vectors with empty and multi-block elements:
+	/// <see href="https://csrc.nist.gov/projects/cryptographic-standards-and-guidelines/example-values"/></para>
+	/// </summary>
+	class TupleHashTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		std::vector<std::vector<byte>> m_custom;
+		std::vector<std::vector<byte>> m_expected;
+		std::vector<std::vector<byte>> m_tuple;
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Known answer tests for the TupleHash function
+		/// </summary>
+		TupleHashTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~TupleHashTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void BoundaryTest();
+		void CompareVector(Digest::TupleHash* Digest, std::vector<std::vector<byte>> &Tuple, std::vector<byte> &Custom, std::vector<byte> &Expected);
+		void Initialize();
+		void OnProgress(std::string Data);
+	};
+}
+
+#endif
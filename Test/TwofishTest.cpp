@@ -1,4 +1,7 @@
 #include "TwofishTest.h"
+#include "../CEX/CTR.h"
+#include "../CEX/ICM.h"
+#include "../CEX/SecureRandom.h"
 #include "../CEX/THX.h"
 
 namespace Test
@@ -128,6 +131,32 @@ namespace Test
 			CompareMonteCarlo(key, m_plainText, output, false);
 			OnProgress(std::string("TwofishTest: Passed 10,000 round 256 bit key Monte Carlo decryption test.."));
 
+			// the wide transforms and the counter modes, for every round count of the standard and extended ciphers
+			THX* eng = new THX();
+			std::vector<size_t> rnds = eng->LegalRounds();
+			delete eng;
+
+			for (size_t i = 0; i < rnds.size(); ++i)
+			{
+				eng = new THX(Enumeration::Digests::None, static_cast<uint>(rnds[i]));
+				CompareWide(eng);
+				CompareCounter(eng);
+				delete eng;
+			}
+
+			eng = new THX(Enumeration::Digests::SHA256);
+			rnds = eng->LegalRounds();
+			delete eng;
+
+			for (size_t i = 0; i < rnds.size(); ++i)
+			{
+				eng = new THX(Enumeration::Digests::SHA256, static_cast<uint>(rnds[i]));
+				CompareWide(eng);
+				CompareCounter(eng);
+				delete eng;
+			}
+			OnProgress(std::string("TwofishTest: Passed 512, 1024 and 2048 bit parallel transform and CTR/ICM tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -140,6 +169,78 @@ namespace Test
 		}
 	}
 
+	void TwofishTest::CompareCounter(Cipher::Symmetric::Block::IBlockCipher* Cipher)
+	{
+		for (size_t i = 0; i < Cipher->LegalKeySizes().size(); ++i)
+		{
+			Key::Symmetric::SymmetricKeySize ks = Cipher->LegalKeySizes()[i];
+			std::vector<byte> key(ks.KeySize());
+			std::vector<byte> nonce(Cipher->BlockSize());
+			Prng::SecureRandom rnd;
+			rnd.GetBytes(key);
+			// counter bytes near the carry, so the staggered wide counters wrap
+			std::memset(nonce.data(), 0xFF, nonce.size());
+			nonce[0] = static_cast<byte>(rnd.NextUInt32());
+			Key::Symmetric::SymmetricKey k(key, nonce);
+
+			for (size_t j = 0; j < 2; ++j)
+			{
+				Cipher::Symmetric::Block::Mode::ICipherMode* cpr;
+
+				if (j == 0)
+				{
+					cpr = new Cipher::Symmetric::Block::Mode::CTR(Cipher);
+				}
+				else
+				{
+					cpr = new Cipher::Symmetric::Block::Mode::ICM(Cipher);
+				}
+
+				const size_t BLKSZE = cpr->BlockSize();
+				const size_t PRLBLK = cpr->ParallelProfile().ParallelMinimumSize() * 2;
+				// wide blocks, the parallel threshold, and an unaligned tail
+				const size_t MSGLEN = (PRLBLK * 2) + (BLKSZE * 3) + 7;
+				std::vector<byte> inBytes(MSGLEN);
+				std::vector<byte> expBytes(MSGLEN);
+				std::vector<byte> outBytes(MSGLEN);
+				rnd.GetBytes(inBytes);
+
+				// the reference: one block per call, so each block is processed by EncryptBlock
+				cpr->Initialize(true, k);
+				cpr->ParallelProfile().IsParallel() = false;
+
+				for (size_t l = 0; l < MSGLEN; l += BLKSZE)
+				{
+					cpr->Transform(inBytes, l, expBytes, l, std::min(BLKSZE, MSGLEN - l));
+				}
+
+				// sequential, through the wide transforms
+				cpr->Initialize(true, k);
+				cpr->ParallelProfile().IsParallel() = false;
+				cpr->Transform(inBytes, 0, outBytes, 0, MSGLEN);
+
+				if (outBytes != expBytes)
+				{
+					throw TestException("Twofish Counter: Sequential wide output is not equal!");
+				}
+
+				// parallel, over the wide transforms
+				std::fill(outBytes.begin(), outBytes.end(), 0);
+				cpr->Initialize(true, k);
+				cpr->ParallelProfile().IsParallel() = true;
+				cpr->ParallelProfile().ParallelBlockSize() = PRLBLK;
+				cpr->Transform(inBytes, 0, outBytes, 0, MSGLEN);
+
+				if (outBytes != expBytes)
+				{
+					throw TestException("Twofish Counter: Parallel output is not equal!");
+				}
+
+				delete cpr;
+			}
+		}
+	}
+
 	void TwofishTest::CompareMonteCarlo(std::vector<byte> &Key, std::vector<byte> &Input, std::vector<byte> &Output, bool Encrypt, size_t Count)
 	{
 		std::vector<byte> outBytes(Input.size(), 0);
@@ -183,6 +284,72 @@ namespace Test
 		}
 	}
 
+	void TwofishTest::CompareWide(Cipher::Symmetric::Block::IBlockCipher* Cipher)
+	{
+		for (size_t i = 0; i < Cipher->LegalKeySizes().size(); ++i)
+		{
+			Key::Symmetric::SymmetricKeySize ks = Cipher->LegalKeySizes()[i];
+			std::vector<byte> key(ks.KeySize());
+			Prng::SecureRandom rnd;
+			rnd.GetBytes(key);
+			Key::Symmetric::SymmetricKey k(key);
+
+			Cipher->Initialize(true, k);
+			// Transform512, Transform1024 and Transform2048 process 4, 8 and 16 blocks
+			CompareWide(Cipher, 4);
+			CompareWide(Cipher, 8);
+			CompareWide(Cipher, 16);
+
+			Cipher->Initialize(false, k);
+			CompareWide(Cipher, 4);
+			CompareWide(Cipher, 8);
+			CompareWide(Cipher, 16);
+		}
+	}
+
+	void TwofishTest::CompareWide(Cipher::Symmetric::Block::IBlockCipher* Cipher, size_t Blocks)
+	{
+		const size_t BLKSZE = Cipher->BlockSize();
+		// an offset on both arrays, so that the wide gathers and stores are not aligned
+		const size_t INPOFT = 3;
+		const size_t OUTOFT = 5;
+		std::vector<byte> inBytes(INPOFT + (Blocks * BLKSZE));
+		std::vector<byte> outBytes(OUTOFT + (Blocks * BLKSZE), 0);
+		std::vector<byte> expBytes(OUTOFT + (Blocks * BLKSZE), 0);
+		Prng::SecureRandom rnd;
+		rnd.GetBytes(inBytes);
+
+		for (size_t i = 0; i < Blocks; ++i)
+		{
+			if (Cipher->IsEncryption())
+			{
+				Cipher->EncryptBlock(inBytes, INPOFT + (i * BLKSZE), expBytes, OUTOFT + (i * BLKSZE));
+			}
+			else
+			{
+				Cipher->DecryptBlock(inBytes, INPOFT + (i * BLKSZE), expBytes, OUTOFT + (i * BLKSZE));
+			}
+		}
+
+		if (Blocks == 4)
+		{
+			Cipher->Transform512(inBytes, INPOFT, outBytes, OUTOFT);
+		}
+		else if (Blocks == 8)
+		{
+			Cipher->Transform1024(inBytes, INPOFT, outBytes, OUTOFT);
+		}
+		else
+		{
+			Cipher->Transform2048(inBytes, INPOFT, outBytes, OUTOFT);
+		}
+
+		if (outBytes != expBytes)
+		{
+			throw TestException("Twofish Wide: Arrays are not equal!");
+		}
+	}
+
 	void TwofishTest::Initialize()
 	{
 		HexConverter::Decode(std::string("00000000000000000000000000000000"), m_plainText);
@@ -2,6 +2,7 @@
 #define CEXTEST_TWOFISHTEST_H
 
 #include "ITest.h"
+#include "../CEX/IBlockCipher.h"
 
 namespace Test
 {
@@ -50,8 +51,11 @@ namespace Test
 
     private:
 
+		void CompareCounter(Cipher::Symmetric::Block::IBlockCipher* Cipher);
 		void CompareMonteCarlo(std::vector<byte> &Key, std::vector<byte> &Input, std::vector<byte> &Output, bool Encrypt = true, size_t Count = 10000);
 		void CompareVector(std::vector<byte> &Key, std::vector<byte> &Input, std::vector<byte> &Output);
+		void CompareWide(Cipher::Symmetric::Block::IBlockCipher* Cipher);
+		void CompareWide(Cipher::Symmetric::Block::IBlockCipher* Cipher, size_t Blocks);
 		void Initialize();
 		void OnProgress(std::string Data);
     };